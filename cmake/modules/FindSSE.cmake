@@ -29,6 +29,7 @@ option(ENABLE_AVX    "Enable compile-time AVX support."    ON)
 option(ENABLE_AVX2   "Enable compile-time AVX2 support."   ON)
 option(ENABLE_FMA    "Enable compile-time FMA support."    ON)
 option(ENABLE_AVX512 "Enable compile-time AVX512 support." ON)
+option(ENABLE_PCLMUL "Enable compile-time PCLMULQDQ support." ON)
 
 if (ENABLE_SSE)
     #
@@ -52,6 +53,31 @@ if (ENABLE_SSE)
     if (HAVE_SSE)        
         message(STATUS "SSE4.1 is enabled - target CPU must support it")
     endif()
+
+    if (HAVE_SSE AND ENABLE_PCLMUL)
+
+        #
+        # Check compiler for carry-less multiplication intrinsics
+        #
+        if (CMAKE_COMPILER_IS_GNUCC OR (CMAKE_C_COMPILER_ID MATCHES "Clang") OR (CMAKE_CXX_COMPILER_ID MATCHES "Clang"))
+            set(CMAKE_REQUIRED_FLAGS "-msse4.1 -mpclmul")
+            check_c_source_runs("
+            #include <immintrin.h>
+
+            int main()
+            {
+              __m128i a = _mm_set_epi64x(0, 3);
+              __m128i b = _mm_set_epi64x(0, 3);
+              __m128i c = _mm_clmulepi64_si128(a, b, 0x00);
+              return (_mm_cvtsi128_si32(c) == 5) ? 0 : -1;
+            }"
+                    HAVE_PCLMUL)
+        endif()
+
+        if (HAVE_PCLMUL)
+            message(STATUS "PCLMULQDQ is enabled - target CPU must support it")
+        endif()
+    endif()
     
     if (ENABLE_AVX)
 
@@ -188,6 +214,24 @@ if (ENABLE_SSE)
         if (HAVE_AVX512)
             message(STATUS "AVX512 is enabled - target CPU must support it")
         endif()
+
+        if (HAVE_AVX512 AND HAVE_PCLMUL)
+            set(CMAKE_REQUIRED_FLAGS "-mavx512f -mavx512bw -mpclmul -mvpclmulqdq")
+            check_c_source_runs("
+            #include <immintrin.h>
+
+            int main()
+            {
+              __m512i a = _mm512_set1_epi64(3);
+              __m512i c = _mm512_clmulepi64_epi128(a, a, 0x00);
+              return (_mm_cvtsi128_si32(_mm512_castsi512_si128(c)) == 5) ? 0 : -1;
+            }"
+                    HAVE_VPCLMUL)
+        endif()
+
+        if (HAVE_VPCLMUL)
+            message(STATUS "VPCLMULQDQ is enabled - target CPU must support it")
+        endif()
     elseif (${GCC_ARCH} MATCHES "native" AND CMAKE_CXX_COMPILER_ID MATCHES "GNU")
         # When GCC flag -march=native and the CPU supports AVX512 (skylake-avx512 architecture), GCC uses AVX512 instructions
         # automatically, independently of the rest of flags.
@@ -207,4 +251,4 @@ if (ENABLE_SSE)
 
 endif()
 
-mark_as_advanced(HAVE_SSE, HAVE_AVX, HAVE_AVX2, HAVE_FMA, HAVE_AVX512)
+mark_as_advanced(HAVE_SSE, HAVE_AVX, HAVE_AVX2, HAVE_FMA, HAVE_AVX512, HAVE_PCLMUL, HAVE_VPCLMUL)
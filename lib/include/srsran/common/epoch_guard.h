@@ -0,0 +1,100 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_EPOCH_GUARD_H
+#define SRSRAN_EPOCH_GUARD_H
+
+#include "srsran/adt/move_callback.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Epoch based reclamation of objects shared between threads.
+ * Readers access the shared objects inside read sections, which only mark the epoch they started in and never block.
+ * The writer unlinks an object, so that later read sections can't reach it, and then retires it. The object is deleted
+ * once all the read sections that started before it was retired are over.
+ * Read sections can be started from any thread and nested. The writer side (retire, reclaim and synchronize) must be
+ * called from a single thread.
+ */
+class epoch_domain
+{
+public:
+  /// Maximum number of read sections in course at the same time
+  static const size_t max_readers = 128;
+
+  epoch_domain() = default;
+  epoch_domain(const epoch_domain&) = delete;
+  epoch_domain& operator=(const epoch_domain&) = delete;
+  ~epoch_domain();
+
+  /// Starts a read section and returns the reader slot that marks it
+  size_t enter();
+  void   exit(size_t slot);
+
+  /// Defers the deletion of an object until no read section can see it. The object must be unlinked beforehand
+  void retire(move_callback<void()> deleter);
+  /// Deletes the retired objects that no read section can see anymore. Returns the number of objects left
+  size_t reclaim();
+  /// Waits for the read sections in course to finish and deletes all retired objects
+  void synchronize();
+
+  size_t nof_retired() const { return retired.size(); }
+
+private:
+  struct reader_slot {
+    std::atomic<uint64_t> epoch{0}; ///< epoch of the read section in course, 0 if free
+    char                  padding[64 - sizeof(std::atomic<uint64_t>)];
+  };
+  struct retired_obj {
+    uint64_t              epoch;
+    move_callback<void()> deleter;
+  };
+
+  uint64_t min_active_epoch() const;
+
+  std::atomic<uint64_t>                global_epoch{1};
+  std::array<reader_slot, max_readers> slots;
+  std::vector<retired_obj>             retired;
+};
+
+// Read section of an epoch_domain that ends on exit
+class epoch_read_guard
+{
+public:
+  epoch_read_guard(epoch_domain& domain_) : domain(&domain_), slot(domain_.enter()) {}
+  epoch_read_guard(const epoch_read_guard&) = delete;
+  epoch_read_guard(epoch_read_guard&&)      = delete;
+  epoch_read_guard& operator=(const epoch_read_guard&) = delete;
+  epoch_read_guard& operator=(epoch_read_guard&&) = delete;
+  ~epoch_read_guard() { domain->exit(slot); }
+
+private:
+  epoch_domain* domain;
+  size_t        slot;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_EPOCH_GUARD_H
@@ -298,6 +298,27 @@ public:
     return nof_timers_running_;
   }
 
+  /// Number of step_all() calls until the next running timer expires, looking at most max_tics ahead.
+  /// Returns max_tics if no timer expires earlier. The cost is O(max_tics) wheel slots, so keep the horizon short.
+  uint32_t nof_tics_to_next_expiry(uint32_t max_tics) const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (nof_timers_running_ == 0) {
+      return max_tics;
+    }
+    uint32_t cur_time_local = cur_time.load(std::memory_order_relaxed);
+    uint32_t horizon        = std::min(max_tics, static_cast<uint32_t>(WHEEL_SIZE));
+    for (uint32_t tics = 1; tics <= horizon; ++tics) {
+      for (const timer_impl& timer : time_wheel[(cur_time_local + tics) & WHEEL_MASK]) {
+        // Timers longer than the wheel share the slot with earlier ones, so check the absolute timeout
+        if (decode_timeout(timer.state.load(std::memory_order_relaxed)) - cur_time_local == tics) {
+          return tics;
+        }
+      }
+    }
+    return max_tics;
+  }
+
   constexpr static uint32_t max_timer_duration() { return MAX_TIMER_DURATION; }
 
   template <typename F>
@@ -56,13 +56,8 @@ const char* __tsan_default_suppressions()
       // backtrace
       "race:libusb*\n"
       "race:libuhd*\n"
-      // Lock order inversion issues in these functions, ignore it as it uses rw locks in read mode
-      "deadlock:srsenb::mac::rlc_buffer_state\n"
-      "deadlock:srsenb::mac::snr_info\n"
-      "deadlock:srsenb::mac::ack_info\n"
-      "deadlock:srsenb::mac::cqi_info\n"
-      "deadlock:srsenb::rlc::rb_is_um\n"
-      "deadlock:srsenb::mac::sr_detected\n";
+      // Lock order inversion issues in this function, ignore it as it uses rw locks in read mode
+      "deadlock:srsenb::rlc::rb_is_um\n";
 }
 
 #ifdef __cplusplus
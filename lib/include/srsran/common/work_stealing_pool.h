@@ -0,0 +1,282 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         work_stealing_pool.h
+ *  Description:  Task executor with one Chase-Lev deque per worker. Workers
+ *                pop their own deque in LIFO order and steal from the other
+ *                workers of the same priority class in FIFO order when idle.
+ *  Reference:    D. Chase and Y. Lev, "Dynamic Circular Work-Stealing Deque"
+ *                N. M. Le et al., "Correct and Efficient Work-Stealing for
+ *                Weak Memory Models"
+ *****************************************************************************/
+
+#ifndef SRSRAN_WORK_STEALING_POOL_H
+#define SRSRAN_WORK_STEALING_POOL_H
+
+#include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/move_callback.h"
+#include "srsran/common/threads.h"
+#include "srsran/srslog/srslog.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Bounded single-owner work-stealing deque of pointers. Only the owner thread can push and pop at the bottom, any
+ * thread can steal from the top.
+ */
+template <typename T>
+class work_stealing_deque
+{
+public:
+  explicit work_stealing_deque(uint32_t capacity_pow2) :
+    mask((int64_t(1) << capacity_pow2) - 1), buffer(new std::atomic<T*>[size_t(1) << capacity_pow2])
+  {
+  }
+  work_stealing_deque(const work_stealing_deque&) = delete;
+  work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+  /// Owner only. Returns false if the deque is full
+  bool push(T* item)
+  {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    if (b - t > mask) {
+      return false;
+    }
+    buffer[b & mask].store(item, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// Owner only. Returns nullptr if the deque is empty
+  T* pop()
+  {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+      // Empty
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    T* item = buffer[b & mask].load(std::memory_order_relaxed);
+    if (t == b) {
+      // Last item, race against thieves
+      if (not top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  /// Any thread. Returns nullptr if the deque is empty or the item was taken by another thread
+  T* steal()
+  {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b) {
+      return nullptr;
+    }
+
+    T* item = buffer[t & mask].load(std::memory_order_relaxed);
+    if (not top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return item;
+  }
+
+  bool empty() const
+  {
+    return top.load(std::memory_order_relaxed) >= bottom.load(std::memory_order_relaxed);
+  }
+
+private:
+  // Top and bottom are kept in different cache lines, thieves only write the top
+  std::atomic<int64_t>               top = {0};
+  char                               padding[64 - sizeof(std::atomic<int64_t>)];
+  std::atomic<int64_t>               bottom = {0};
+  const int64_t                      mask;
+  std::unique_ptr<std::atomic<T*>[]> buffer;
+};
+
+/**
+ * Work-stealing task executor. Workers are split in priority classes, each with its own thread priority and CPU
+ * affinity, so background tasks never delay real-time ones. Tasks pushed from a worker go to its own deque, tasks
+ * pushed from any other thread go to the class injection queue. Idle workers spin for a while and then sleep.
+ *
+ * Tasks are stored in nodes preallocated at construction, so pushing and running a task does not allocate as long as
+ * the task capture fits in the task_t buffer. Tasks can be pushed in a task_group, a thread waiting for a group
+ * executes pending tasks of the same class meanwhile.
+ */
+class work_stealing_pool
+{
+public:
+  using task_t = srsran::move_callback<void()>;
+
+  enum class task_priority { realtime = 0, background, nof_priorities };
+
+  /// Workers of a priority class. The mask follows srsran::thread, 255 means no affinity
+  struct worker_group_cfg_t {
+    uint32_t    nof_workers = 0;
+    int32_t     prio        = -1;
+    uint32_t    mask        = 255;
+    std::string name        = "WSWORKER";
+  };
+
+  struct args_t {
+    worker_group_cfg_t realtime       = {1, -1, 255, "WSRT"};
+    worker_group_cfg_t background     = {0, -1, 255, "WSBG"};
+    uint32_t           deque_size_log = 12;   ///< Each worker deque holds 2^deque_size_log tasks
+    uint32_t           nof_task_nodes = 8192; ///< Maximum number of tasks pending or running at the same time
+    uint32_t           spin_count     = 2000; ///< Number of idle polls before a worker sleeps
+  };
+
+  /**
+   * @brief Tracks a set of pushed tasks, the group must outlive the tasks pushed with it
+   */
+  class task_group
+  {
+  private:
+    friend class work_stealing_pool;
+    std::atomic<uint32_t> pending = {0}; ///< Number of tasks not completed yet
+  };
+
+  explicit work_stealing_pool(const args_t& args);
+  work_stealing_pool(const work_stealing_pool&) = delete;
+  work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+  ~work_stealing_pool();
+
+  /**
+   * @brief Stops and joins all workers. Pending tasks of a group are executed by the calling thread, so no thread waits
+   * forever for them, the rest of pending tasks are discarded
+   */
+  void stop();
+
+  /**
+   * @brief Pushes a task for execution by the workers of the given priority class
+   * @return True if the task was queued, false if the pool is stopped, the class has no workers or there are no free
+   * task nodes. The task is left untouched when false is returned
+   */
+  bool push_task(task_t&& task, task_priority priority = task_priority::realtime);
+
+  /**
+   * @brief Pushes a task of a group, the task can be queued even if the class has no workers because the threads
+   * waiting for the group execute it
+   * @return True if the task was queued, false if the pool is stopped or there are no free task nodes. The task is left
+   * untouched when false is returned
+   */
+  bool push_task(task_group& group, task_t&& task, task_priority priority = task_priority::realtime);
+
+  /**
+   * @brief Waits for all the tasks of a group to complete, executing pending tasks of the same class meanwhile
+   */
+  void wait(task_group& group, task_priority priority = task_priority::realtime);
+
+  uint32_t nof_workers(task_priority priority) const;
+
+private:
+  struct task_node_t {
+    task_t       task;
+    task_group*  group     = nullptr;
+    task_node_t* next_free = nullptr;
+  };
+
+  class worker_t;
+
+  struct priority_class_t {
+    std::vector<std::unique_ptr<worker_t> > workers;
+    std::mutex                              mutex; ///< Protects injector and sleeping workers
+    std::condition_variable                 cvar;
+    dyn_circular_buffer<task_node_t*>       injector;
+    std::atomic<uint32_t>                   injector_size = {0};
+    std::atomic<uint32_t>                   nof_sleeping  = {0};
+
+    void         push_injector(task_node_t* t);
+    task_node_t* pop_injector();
+    task_node_t* steal(const worker_t* thief, uint32_t& seed);
+    bool         has_work() const;
+    void         wake_one();
+  };
+
+  class worker_t : public srsran::thread
+  {
+  public:
+    worker_t(work_stealing_pool& pool_,
+             priority_class_t&   cls_,
+             uint32_t            id_,
+             const std::string&  name,
+             uint32_t            deque_size_log);
+    void run_thread() override;
+
+    work_stealing_pool&              pool;
+    priority_class_t&                cls;
+    work_stealing_deque<task_node_t> deque;
+    task_node_t*                     free_cache      = nullptr; ///< Task nodes only used by this worker
+    uint32_t                         free_cache_size = 0;
+
+  private:
+    task_node_t* find_task();
+    void         sleep();
+
+    uint32_t id;
+    uint32_t steal_seed;
+  };
+
+  void         push_node(task_node_t* node, task_priority priority);
+  task_node_t* alloc_node();
+  void         free_node(task_node_t* node);
+  void         run_task(task_node_t* node);
+
+  /// Worker running in the calling thread if it belongs to this pool, nullptr otherwise
+  worker_t* get_current_worker() const;
+
+  /// Worker running in the calling thread, nullptr if the caller is not a worker of any pool
+  static thread_local worker_t* current_worker;
+
+  srslog::basic_logger&                                                 logger;
+  uint32_t                                                              spin_count = 0;
+  std::atomic<bool>                                                     running    = {true};
+  std::array<priority_class_t, (size_t)task_priority::nof_priorities> classes;
+
+  std::unique_ptr<task_node_t[]> nodes;
+  std::mutex                     free_mutex;          ///< Protects the shared list of free task nodes
+  task_node_t*                   free_list = nullptr; ///< Task nodes not cached by any worker
+  std::mutex                     done_mutex;
+  std::condition_variable        done_cvar; ///< Signals the threads waiting for a group that a group completed
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_WORK_STEALING_POOL_H
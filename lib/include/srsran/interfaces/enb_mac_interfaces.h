@@ -35,6 +35,7 @@ struct mac_args_t {
   uint32_t                      nof_prealloc_ues; ///< Number of UE resources to pre-allocate at eNB startup
   uint32_t                      max_nof_kos;
   int                           rlf_min_ul_snr_estim;
+  bool                          pusch_8bit_decoder; ///< PUSCH decoder LLR width, used for the Rx softbuffers
 };
 
 /* Interface PHY -> MAC */
@@ -24,6 +24,7 @@
 
 #include "srsran/asn1/gtpc_ies.h"
 #include "srsran/common/common.h"
+#include "srsran/common/timers.h"
 #include <netinet/sctp.h>
 #include <queue>
 
@@ -94,15 +95,8 @@ public:
 class mme_interface_nas // NAS -> MME
 {
 public:
-  virtual bool add_nas_timer(int timer_fd, enum nas_timer_type type, uint64_t imsi) = 0;
-  virtual bool is_nas_timer_running(enum nas_timer_type type, uint64_t imsi)        = 0;
-  virtual bool remove_nas_timer(enum nas_timer_type type, uint64_t imsi)            = 0;
-};
-
-class s1ap_interface_mme // MME -> S1AP
-{
-public:
-  virtual bool expire_nas_timer(enum nas_timer_type type, uint64_t imsi) = 0;
+  /// NAS timers run in the MME thread, with a tick of 1 ms
+  virtual srsran::unique_timer get_unique_timer() = 0;
 };
 
 /*******************
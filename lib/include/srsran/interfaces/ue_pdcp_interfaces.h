@@ -82,6 +82,13 @@ public:
   virtual bool is_registered()         = 0;
   virtual bool start_service_request() = 0;
   virtual void write_sdu(uint32_t eps_bearer_id, srsran::unique_byte_buffer_t sdu) = 0;
+  ///< Push several SDUs of the same EPS bearer at once. Stacks that can hand them over in one go override this
+  virtual void write_sdu_batch(uint32_t eps_bearer_id, srsran::unique_byte_buffer_t* sdus, uint32_t nof_sdus)
+  {
+    for (uint32_t i = 0; i < nof_sdus; i++) {
+      write_sdu(eps_bearer_id, std::move(sdus[i]));
+    }
+  }
   ///< Allow GW to query if a radio bearer for a given EPS bearer ID is currently active
   virtual bool has_active_radio_bearer(uint32_t eps_bearer_id) = 0;
 };
@@ -70,6 +70,7 @@ struct phy_args_t {
 
   uint32_t    nof_lte_carriers             = 1;
   uint32_t    nof_nr_carriers              = 0;
+  uint32_t    nof_ue                       = 1; ///< UE stacks sharing the EUTRA PHY, each one with its own RNTI
   uint32_t    nr_max_nof_prb               = 52;
   uint32_t    nof_rx_ant                   = 1;
   std::string equalizer_mode               = "mmse";
@@ -105,7 +106,9 @@ struct phy_args_t {
   float       force_ul_amplitude           = 0.0f;
   bool        detect_cp                    = false;
 
-  bool nr_store_pdsch_ko = false;
+  bool     nr_store_pdsch_ko   = false;
+  bool     nr_pdsch_early_stop = false;
+  uint32_t nr_pdsch_abort_its  = 0;
 
   float    in_sync_rsrp_dbm_th    = -130.0f;
   float    in_sync_snr_db_th      = 1.0f;
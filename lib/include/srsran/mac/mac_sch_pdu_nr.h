@@ -22,6 +22,7 @@
 #ifndef SRSRAN_MAC_SCH_PDU_NR_H
 #define SRSRAN_MAC_SCH_PDU_NR_H
 
+#include "srsran/adt/bounded_vector.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/common.h"
 #include "srsran/config.h"
@@ -91,8 +92,8 @@ public:
   lcg_bsr_t            get_sbsr() const;
   static const uint8_t max_num_lcg_lbsr = 8;
   struct lbsr_t {
-    uint8_t                bitmap; // the first octet of LBSR and Long Trunc BSR
-    std::vector<lcg_bsr_t> list;   // one entry for each reported LCG
+    uint8_t                                             bitmap; // the first octet of LBSR and Long Trunc BSR
+    srsran::bounded_vector<lcg_bsr_t, max_num_lcg_lbsr> list;   // one entry for each reported LCG
   };
   lbsr_t get_lbsr() const;
 
@@ -83,6 +83,58 @@ SRSRAN_API void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, ui
 
 SRSRAN_API void srsran_sequence_apply_bit(const uint8_t* in, uint8_t* out, uint32_t length, uint32_t seed);
 
+/**
+ * @brief Direct-mapped cache of packed sequences indexed by seed.
+ *
+ * Scrambling sequences depend on the RNTI, the slot and the cell, so the same few seeds repeat every frame. The cache
+ * keeps the packed sequence of the last seed mapped to every entry and applies it without regenerating it.
+ * Sequences longer than max_len bypass the cache.
+ */
+typedef struct SRSRAN_API {
+  uint32_t  nof_entries;
+  uint32_t  max_len;
+  uint32_t  words_per_entry;
+  uint32_t* seed;
+  uint32_t* len; ///< Number of cached bits, 0 if the entry is empty
+  uint32_t* c;   ///< Packed sequences, bit n of word w is c(32w + n)
+  uint64_t  nof_hits;
+  uint64_t  nof_misses;
+} srsran_sequence_cache_t;
+
+SRSRAN_API int srsran_sequence_cache_init(srsran_sequence_cache_t* q, uint32_t nof_entries, uint32_t max_len);
+
+SRSRAN_API void srsran_sequence_cache_free(srsran_sequence_cache_t* q);
+
+SRSRAN_API void srsran_sequence_cache_apply_f(srsran_sequence_cache_t* q,
+                                              const float*             in,
+                                              float*                   out,
+                                              uint32_t                 length,
+                                              uint32_t                 seed);
+
+SRSRAN_API void srsran_sequence_cache_apply_s(srsran_sequence_cache_t* q,
+                                              const int16_t*           in,
+                                              int16_t*                 out,
+                                              uint32_t                 length,
+                                              uint32_t                 seed);
+
+SRSRAN_API void srsran_sequence_cache_apply_c(srsran_sequence_cache_t* q,
+                                              const int8_t*            in,
+                                              int8_t*                  out,
+                                              uint32_t                 length,
+                                              uint32_t                 seed);
+
+SRSRAN_API void srsran_sequence_cache_apply_bit(srsran_sequence_cache_t* q,
+                                                const uint8_t*           in,
+                                                uint8_t*                 out,
+                                                uint32_t                 length,
+                                                uint32_t                 seed);
+
+SRSRAN_API void srsran_sequence_cache_apply_packed(srsran_sequence_cache_t* q,
+                                                   const uint8_t*           in,
+                                                   uint8_t*                 out,
+                                                   uint32_t                 length,
+                                                   uint32_t                 seed);
+
 SRSRAN_API int srsran_sequence_pbch(srsran_sequence_t* seq, srsran_cp_t cp, uint32_t cell_id);
 
 SRSRAN_API int srsran_sequence_pcfich(srsran_sequence_t* seq, uint32_t nslot, uint32_t cell_id);
@@ -82,6 +82,25 @@ SRSRAN_API int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
                                       int                idist,
                                       int                odist);
 
+/**
+ * @brief Creates a guru complex DFT plan that runs a two-dimensional batch of transforms, for instance, all the OFDM
+ * symbols of a slot for several antenna ports, in a single call.
+ *
+ * The inner batch (how_many, idist, odist) is typically the OFDM symbols and the outer batch (nof_batch, ibatch_dist,
+ * obatch_dist) the antenna ports. All distances are given in complex samples.
+ */
+SRSRAN_API int srsran_dft_plan_guru_batch_c(srsran_dft_plan_t* plan,
+                                            int                dft_points,
+                                            srsran_dft_dir_t   dir,
+                                            cf_t*              in_buffer,
+                                            cf_t*              out_buffer,
+                                            int                how_many,
+                                            int                idist,
+                                            int                odist,
+                                            int                nof_batch,
+                                            int                ibatch_dist,
+                                            int                obatch_dist);
+
 SRSRAN_API int srsran_dft_plan_r(srsran_dft_plan_t* plan, int dft_points, srsran_dft_dir_t dir);
 
 SRSRAN_API int srsran_dft_replan(srsran_dft_plan_t* plan, const int new_dft_points);
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_OFDM_BATCH_H
+#define SRSRAN_OFDM_BATCH_H
+
+/**********************************************************************************************
+ *  File:         ofdm_batch.h
+ *
+ *  Description:  Batched OFDM demodulator.
+ *                Demodulates all the OFDM symbols of a subframe (or NR slot) for all the antenna
+ *                ports with a single persistent DFT plan per slot, and fuses the FFT shift, DFT
+ *                window compensation, phase compensation and normalization in the copy to the
+ *                resource grid. Optionally, antenna ports are spread over coworker threads.
+ *
+ *  Reference:    3GPP TS 36.211 version 10.0.0 Release 10 Sec. 6
+ *********************************************************************************************/
+
+#include "srsran/config.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/dft/dft.h"
+
+#define SRSRAN_OFDM_BATCH_MAX_COWORKERS (SRSRAN_MAX_PORTS - 1)
+
+/**
+ * @struct srsran_ofdm_batch_cfg_t
+ * Batched OFDM demodulator configuration. The structure must be initialised to all zeros before being filled.
+ */
+typedef struct SRSRAN_API {
+  // Compulsory parameters
+  uint32_t    nof_prb;                      ///< Number of Resource Blocks
+  uint32_t    nof_ports;                    ///< Number of receive antenna ports
+  cf_t*       out_buffer[SRSRAN_MAX_PORTS]; ///< Resource grid output buffer pointer for each port
+  srsran_cp_t cp;                           ///< Cyclic prefix type
+
+  // Optional parameters
+  bool     normalize;             ///< Normalization flag, it divides the output by square root of the symbol size
+  float    freq_shift_f;          ///< Frequency shift, normalised by sampling rate (used in UL)
+  float    rx_window_offset;      ///< DFT Window offset in CP portion (0-1)
+  uint32_t symbol_sz;             ///< Symbol size, forces a given symbol size for the number of PRB
+  bool     keep_dc;               ///< If true, it does not remove the DC
+  double   phase_compensation_hz; ///< Carrier frequency in Hz for phase compensation, set to 0 to disable
+  uint32_t nof_coworkers;         ///< Number of extra threads the antenna ports are spread over, 0 for none
+} srsran_ofdm_batch_cfg_t;
+
+/**
+ * @struct srsran_ofdm_batch_t
+ * Batched OFDM demodulator object
+ */
+typedef struct SRSRAN_API {
+  srsran_ofdm_batch_cfg_t cfg;
+  uint32_t                nof_symbols;
+  uint32_t                nof_re;
+  uint32_t                slot_sz;
+  uint32_t                sf_sz;
+  uint32_t                dc;
+  uint32_t                window_offset_n;
+  cf_t*                   in_buffer;            ///< Time domain samples, sf_sz samples for each port
+  cf_t*                   tmp;                  ///< DFT output, symbol_sz samples per symbol and port
+  cf_t*                   shift_buffer;         ///< Frequency shift sequence, NULL if not used
+  cf_t*                   window_offset_buffer; ///< DFT window offset compensation, NULL if not used
+  srsran_dft_plan_t       plan_sf[SRSRAN_NOF_SLOTS_PER_SF];                     ///< All symbols and ports of a slot
+  srsran_dft_plan_t       plan_port[SRSRAN_MAX_PORTS][SRSRAN_NOF_SLOTS_PER_SF]; ///< Per port, only with coworkers
+  cf_t                    scale[SRSRAN_MAX_NSYMB * SRSRAN_NOF_SLOTS_PER_SF];     ///< Phase and normalization
+  bool                    scale_enable;
+  void*                   coworkers[SRSRAN_OFDM_BATCH_MAX_COWORKERS];
+} srsran_ofdm_batch_t;
+
+/**
+ * @brief Initialises the batched OFDM demodulator. The DFT plans are created once and persist until the object is
+ * freed, so this function must not be called in the real-time path.
+ *
+ * @param q Batched OFDM object
+ * @param cfg Configuration
+ * @return SRSRAN_SUCCESS if the initialization is successful, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ofdm_rx_batch_init(srsran_ofdm_batch_t* q, const srsran_ofdm_batch_cfg_t* cfg);
+
+SRSRAN_API void srsran_ofdm_rx_batch_free(srsran_ofdm_batch_t* q);
+
+/**
+ * @brief Gets the time domain input buffer for a given port. The caller (typically the radio) must write a
+ * subframe worth of samples in it before calling srsran_ofdm_rx_batch_sf().
+ *
+ * @return Pointer to the port buffer, NULL if the port is out of range
+ */
+SRSRAN_API cf_t* srsran_ofdm_rx_batch_get_buffer(srsran_ofdm_batch_t* q, uint32_t port);
+
+/**
+ * @brief Demodulates one subframe for all the configured ports, writing the resource grids in the output buffers
+ */
+SRSRAN_API void srsran_ofdm_rx_batch_sf(srsran_ofdm_batch_t* q);
+
+#endif // SRSRAN_OFDM_BATCH_H
@@ -52,6 +52,9 @@ SRSRAN_API void srsran_block_encode(const uint8_t* input, uint32_t input_len, ui
 /**
  * @brief Decodes 16-bit signed data using Reed–Muller code block channel coding.
  *
+ * @remark Maximum likelihood decoder. Words of more than 6 bits are decoded with a Fast Hadamard Transform, shorter
+ * words by correlating with all the possible sequences
+ *
  * @param[in] llr Provides received LLRs
  * @param[in] nof_llr number of available LLRs
  * @param[out] data Data destination to store unpacked received bits
@@ -63,6 +66,9 @@ SRSRAN_API int32_t srsran_block_decode_i16(const int16_t* llr, uint32_t nof_llr,
 /**
  * @brief Decodes 8-bit signed data using Reed–Muller code block channel coding.
  *
+ * @remark Maximum likelihood decoder. Words of more than 6 bits are decoded with a Fast Hadamard Transform, shorter
+ * words by correlating with all the possible sequences
+ *
  * @param[in] llr Provides received LLRs
  * @param[in] nof_llr number of available LLRs
  * @param[out] data Data destination to store unpacked received bits
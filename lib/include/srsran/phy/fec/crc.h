@@ -44,6 +44,16 @@ typedef struct SRSRAN_API {
   uint64_t crcmask;
   uint64_t crchighbit;
   uint32_t srsran_crc_out;
+
+  // Carry-less multiplication folding constants, the polynomial is scaled to degree 32
+  uint64_t clmul_p32;  ///< Polynomial times x^(32 - order), including the x^32 term
+  uint64_t clmul_mu;   ///< Barrett constant floor(x^64 / P32)
+  uint64_t clmul_k64;  ///< x^64 mod P32
+  uint64_t clmul_k96;  ///< x^96 mod P32
+  uint64_t clmul_k128; ///< x^128 mod P32
+  uint64_t clmul_k192; ///< x^192 mod P32
+  uint64_t clmul_k512; ///< x^512 mod P32
+  uint64_t clmul_k576; ///< x^576 mod P32
 } srsran_crc_t;
 
 SRSRAN_API int srsran_crc_init(srsran_crc_t* h, uint32_t srsran_crc_poly, int srsran_crc_order);
@@ -78,6 +88,27 @@ static inline uint64_t srsran_crc_checksum_get(srsran_crc_t* h)
   return (h->crcinit & h->crcmask);
 }
 
+/**
+ * @brief Feeds packed bytes (MSB first) to the running checksum, the checksum is started with srsran_crc_set_init()
+ *
+ * Long inputs are folded with carry-less multiplications (PCLMULQDQ, VPCLMULQDQ) when available.
+ *
+ * @param h CRC object
+ * @param data Packed data
+ * @param nof_bytes Number of bytes
+ */
+SRSRAN_API void srsran_crc_checksum_put_bytes(srsran_crc_t* h, const uint8_t* data, uint32_t nof_bytes);
+
+/**
+ * @brief Feeds unpacked bits (one bit per byte) to the running checksum, any number of bits. Consecutive calls give the
+ * same checksum as a single call over the concatenated bits, so the CRC can be computed while the bits are produced
+ *
+ * @param h CRC object
+ * @param bits Unpacked bits
+ * @param nof_bits Number of bits
+ */
+SRSRAN_API void srsran_crc_checksum_put_bits(srsran_crc_t* h, const uint8_t* bits, uint32_t nof_bits);
+
 SRSRAN_API uint32_t srsran_crc_checksum_byte(srsran_crc_t* h, const uint8_t* data, int len);
 
 SRSRAN_API uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len);
@@ -55,13 +55,25 @@ typedef enum {
  * \brief Describes the LDPC decoder configuration arguments.
  */
 typedef struct {
-  srsran_ldpc_decoder_type_t type;         /*!< \brief Type of LDPC decoder. */
-  srsran_basegraph_t         bg;           /*!< \brief The desired base graph (BG1 or BG2). */
-  uint16_t                   ls;           /*!< \brief The desired lifting size. */
-  float                      scaling_fctr; /*!< \brief Scaling factor of the normalized min-sum algorithm.*/
-  uint32_t                   max_nof_iter; /*!< \brief Maximum number of iterations, set to 0 for default value. */
+  srsran_ldpc_decoder_type_t type;             /*!< \brief Type of LDPC decoder. */
+  srsran_basegraph_t         bg;               /*!< \brief The desired base graph (BG1 or BG2). */
+  uint16_t                   ls;               /*!< \brief The desired lifting size. */
+  float                      scaling_fctr;     /*!< \brief Scaling factor of the normalized min-sum algorithm.*/
+  uint32_t                   max_nof_iter;     /*!< \brief Maximum number of iterations, set to 0 for default value. */
+  bool                       syndrome_check;   /*!< \brief Stops once all the parity checks are satisfied. */
+  uint32_t                   early_abort_iter; /*!< \brief Iterations without progress before giving up, 0 disables. */
 } srsran_ldpc_decoder_args_t;
 
+/*!
+ * \brief Reasons why the decoding of a codeword stops.
+ */
+typedef enum {
+  SRSRAN_LDPC_DECODER_STOP_MAX_ITER = 0, /*!< \brief The maximum number of iterations was reached. */
+  SRSRAN_LDPC_DECODER_STOP_CRC,          /*!< \brief The CRC matched. */
+  SRSRAN_LDPC_DECODER_STOP_SYNDROME,     /*!< \brief All parity checks are satisfied. */
+  SRSRAN_LDPC_DECODER_STOP_ABORT,        /*!< \brief The decoder was not converging. */
+} srsran_ldpc_decoder_stop_t;
+
 /*!
  * \brief Describes an LDPC decoder.
  */
@@ -82,6 +94,14 @@ typedef struct SRSRAN_API {
 
   float scaling_fctr; /*!< \brief Scaling factor for the normalized min-sum algorithm. */
 
+  bool     syndrome_check;   /*!< \brief Enables the syndrome-based early stop. */
+  uint32_t early_abort_iter; /*!< \brief Iterations without progress before giving up, 0 if disabled. */
+  uint8_t* hard_bits;        /*!< \brief Hard decisions of the codeword bits, used by the syndrome check. */
+  uint8_t* syndrome;         /*!< \brief Parity checks of a single layer, used by the syndrome check. */
+
+  uint32_t                   last_nof_iter; /*!< \brief Number of iterations used by the last decoded codeword. */
+  srsran_ldpc_decoder_stop_t last_stop;     /*!< \brief Reason why the decoding of the last codeword stopped. */
+
   void (*free)(void*); /*!< \brief Pointer to a "destructor". */
 
   int (*decode_f)(void*,
@@ -171,7 +191,8 @@ srsran_ldpc_decoder_decode_c(srsran_ldpc_decoder_t* q, const int8_t* llrs, uint8
  *    operation.
  * \param[in] cdwd_rm_length The number of bits forming the codeword (after rate matching).
  * \param[in,out] crc Code-block CRC object for early stop. Set for NULL to disable check
- * \return -1 if an error occurred, the number of used iterations, and 0 if CRC is provided and did not match
+ * \return -1 if an error occurred, the number of used iterations, and 0 if CRC is provided and did not match. The number
+ * of iterations and the reason why the decoding stopped are kept in \a q->last_nof_iter and \a q->last_stop.
  */
 SRSRAN_API int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
                                                 const int8_t*          llrs,
@@ -32,25 +32,51 @@
 #define SRSRAN_SOFTBUFFER_H
 
 #include "srsran/config.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Pool of code block buffers shared by the soft-buffers of many HARQ processes. A pooled soft-buffer only holds
+ * code block buffers between the start of a transport block, when as many as its TBS needs are bound, and its
+ * release, so the memory follows the number of active HARQ processes instead of the number of UEs. The pool grows in
+ * batches on demand, never shrinks, and is thread-safe.
+ */
+typedef struct SRSRAN_API {
+  bool            is_rx;
+  bool            llr_is_8bit; ///< Rx only, code blocks store saturated 8-bit LLR instead of 16-bit
+  uint32_t        cb_size;     ///< Soft bits per code block
+  uint32_t        block_size;  ///< Bytes per code block buffer
+  uint32_t        batch_size;  ///< Code block buffers allocated each time the pool runs out
+  uint32_t        nof_blocks;
+  uint32_t        nof_free;
+  uint32_t        max_in_use; ///< Highest number of code block buffers bound at the same time
+  uint8_t**       free_list;
+  uint8_t**       batches;
+  uint32_t        nof_batches;
+  pthread_mutex_t mutex;
+} srsran_softbuffer_pool_t;
+
 typedef struct SRSRAN_API {
-  uint32_t  max_cb;
-  uint32_t  max_cb_size;
-  int16_t** buffer_f;
-  uint8_t** data;
-  bool*     cb_crc;
-  bool      tb_crc;
+  uint32_t                  max_cb;
+  uint32_t                  max_cb_size;
+  int16_t**                 buffer_f;
+  uint8_t**                 data;
+  bool*                     cb_crc;
+  bool                      tb_crc;
+  srsran_softbuffer_pool_t* pool; ///< Code block buffers are bound on demand from this pool if not NULL
 } srsran_softbuffer_rx_t;
 
 typedef struct SRSRAN_API {
-  uint32_t  max_cb;
-  uint32_t  max_cb_size;
-  uint8_t** buffer_b;
+  uint32_t                  max_cb;
+  uint32_t                  max_cb_size;
+  uint8_t**                 buffer_b;
+  srsran_softbuffer_pool_t* pool; ///< Code block buffers are bound on demand from this pool if not NULL
 } srsran_softbuffer_tx_t;
 
 #define SOFTBUFFER_SIZE 18600
@@ -104,6 +130,53 @@ SRSRAN_API void srsran_softbuffer_tx_reset_cb(srsran_softbuffer_tx_t* q, uint32_
 
 SRSRAN_API void srsran_softbuffer_tx_free(srsran_softbuffer_tx_t* p);
 
+/**
+ * @brief Initialises a pool of code block buffers
+ * @param q The pool pointer
+ * @param is_rx True for Rx soft-buffers (LLR and decoded bits), false for Tx soft-buffers (encoded bits)
+ * @param cb_size The code block size, in soft bits
+ * @param llr_is_8bit Rx only, stores 8-bit LLR. The decoder using the soft-buffers must then work with 8-bit LLR
+ * @param batch_size Number of code block buffers allocated at once when the pool runs out
+ * @return SRSRAN_SUCCESS if the pool is initialised successfully, otherwise SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_softbuffer_pool_init(srsran_softbuffer_pool_t* q,
+                                           bool                      is_rx,
+                                           uint32_t                  cb_size,
+                                           bool                      llr_is_8bit,
+                                           uint32_t                  batch_size);
+
+/**
+ * @brief Frees the pool. All the soft-buffers using it must have been freed before
+ */
+SRSRAN_API void srsran_softbuffer_pool_free(srsran_softbuffer_pool_t* q);
+
+/**
+ * @brief Number of code block buffers currently bound to soft-buffers
+ */
+SRSRAN_API uint32_t srsran_softbuffer_pool_nof_in_use(srsran_softbuffer_pool_t* q);
+
+/**
+ * @brief Bytes allocated by the pool
+ */
+SRSRAN_API size_t srsran_softbuffer_pool_nof_bytes(srsran_softbuffer_pool_t* q);
+
+/**
+ * @brief Initialises an Rx soft-buffer whose code block buffers come from a pool. No code block buffer is bound until
+ * srsran_softbuffer_rx_reset_tbs() or srsran_softbuffer_rx_reset_cb() is called for a new transport block, and
+ * srsran_softbuffer_rx_reset() returns them all to the pool.
+ * @param q The Rx soft-buffer pointer
+ * @param pool The Rx pool, it must outlive the soft-buffer
+ * @param max_cb The maximum number of code blocks
+ * @return SRSRAN_SUCCESS if the soft-buffer is initialised successfully, otherwise SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_softbuffer_rx_init_pool(srsran_softbuffer_rx_t* q, srsran_softbuffer_pool_t* pool, uint32_t max_cb);
+
+/**
+ * @brief Initialises a Tx soft-buffer whose code block buffers come from a pool, see srsran_softbuffer_rx_init_pool().
+ * Bound Tx code block buffers are not cleared, the encoder overwrites them on every new transmission.
+ */
+SRSRAN_API int srsran_softbuffer_tx_init_pool(srsran_softbuffer_tx_t* q, srsran_softbuffer_pool_t* pool, uint32_t max_cb);
+
 #ifdef __cplusplus
 }
 #endif
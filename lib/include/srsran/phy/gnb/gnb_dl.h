@@ -37,8 +37,18 @@ typedef struct SRSRAN_API {
   uint32_t                    nof_max_prb; ///< Maximum number of allocated RB
   double                      srate_hz;    ///< Fix sampling rate, set to 0 for minimum to fit nof_max_prb
   srsran_subcarrier_spacing_t scs;
+  uint32_t                    nof_pdsch_lanes; ///< Number of extra PDSCH lanes for concurrent encoding, 0 for none
 } srsran_gnb_dl_args_t;
 
+/**
+ * @brief PDSCH encoding lane. It holds the state required for encoding a PDSCH transmission concurrently with other
+ * lanes of the same gNb DL object. All lanes share the resource grid, so concurrent transmissions must not overlap.
+ */
+typedef struct SRSRAN_API {
+  srsran_pdsch_nr_t pdsch;
+  srsran_dmrs_sch_t dmrs;
+} srsran_gnb_dl_pdsch_lane_t;
+
 typedef struct SRSRAN_API {
   float                 srate_hz;
   uint32_t              symbol_sz;
@@ -53,6 +63,9 @@ typedef struct SRSRAN_API {
   srsran_pdsch_nr_t pdsch;
   srsran_dmrs_sch_t dmrs;
 
+  srsran_gnb_dl_pdsch_lane_t* pdsch_lanes;     ///< Extra PDSCH lanes, lane 0 is pdsch and dmrs above
+  uint32_t                    nof_pdsch_lanes; ///< Number of extra PDSCH lanes
+
   srsran_dci_nr_t   dci; ///< Stores DCI configuration
   srsran_pdcch_nr_t pdcch;
   srsran_ssb_t      ssb;
@@ -87,11 +100,33 @@ SRSRAN_API int srsran_gnb_dl_pdsch_put(srsran_gnb_dl_t*           q,
                                        const srsran_sch_cfg_nr_t* cfg,
                                        uint8_t*                   data[SRSRAN_MAX_TB]);
 
+/**
+ * @brief Encodes and maps a PDSCH transmission using a given lane. Different lanes can be used concurrently from
+ * different threads as long as the transmissions do not overlap in the resource grid.
+ *
+ * @param q gNb DL object
+ * @param lane_idx Lane index, 0 is the default lane used by srsran_gnb_dl_pdsch_put()
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_gnb_dl_pdsch_put_lane(srsran_gnb_dl_t*           q,
+                                            uint32_t                   lane_idx,
+                                            const srsran_slot_cfg_t*   slot,
+                                            const srsran_sch_cfg_nr_t* cfg,
+                                            uint8_t*                   data[SRSRAN_MAX_TB]);
+
+SRSRAN_API uint32_t srsran_gnb_dl_nof_pdsch_lanes(const srsran_gnb_dl_t* q);
+
 SRSRAN_API float srsran_gnb_dl_get_maximum_signal_power_dBfs(uint32_t nof_prb);
 
 SRSRAN_API int
 srsran_gnb_dl_pdsch_info(const srsran_gnb_dl_t* q, const srsran_sch_cfg_nr_t* cfg, char* str, uint32_t str_len);
 
+SRSRAN_API int srsran_gnb_dl_pdsch_lane_info(const srsran_gnb_dl_t*     q,
+                                             uint32_t                   lane_idx,
+                                             const srsran_sch_cfg_nr_t* cfg,
+                                             char*                      str,
+                                             uint32_t                   str_len);
+
 SRSRAN_API int
 srsran_gnb_dl_pdcch_dl_info(const srsran_gnb_dl_t* q, const srsran_dci_dl_nr_t* dci, char* str, uint32_t str_len);
 
@@ -32,8 +32,19 @@ typedef struct SRSRAN_API {
   srsran_pucch_nr_args_t pucch;
   float                  pusch_min_snr_dB; ///< Minimum SNR threshold to decode PUSCH, set to 0 for default value
   uint32_t               nof_max_prb;
+  uint32_t               nof_pusch_lanes; ///< Number of extra PUSCH lanes for concurrent decoding, 0 for none
 } srsran_gnb_ul_args_t;
 
+/**
+ * @brief PUSCH decoding lane. It holds the state required for estimating the channel and decoding a PUSCH transmission
+ * concurrently with other lanes of the same gNb UL object. All lanes read from the same resource grid.
+ */
+typedef struct SRSRAN_API {
+  srsran_pusch_nr_t     pusch;
+  srsran_dmrs_sch_t     dmrs;
+  srsran_chest_dl_res_t chest;
+} srsran_gnb_ul_pusch_lane_t;
+
 typedef struct SRSRAN_API {
   uint32_t            max_prb;
   srsran_carrier_nr_t carrier;
@@ -47,6 +58,9 @@ typedef struct SRSRAN_API {
   srsran_chest_dl_res_t chest_pusch;
   srsran_chest_ul_res_t chest_pucch;
   float                 pusch_min_snr_dB; ///< Minimum measured DMRS SNR, below this threshold PUSCH is not decoded
+
+  srsran_gnb_ul_pusch_lane_t* pusch_lanes;     ///< Extra PUSCH lanes, lane 0 is pusch, dmrs and chest_pusch above
+  uint32_t                    nof_pusch_lanes; ///< Number of extra PUSCH lanes
 } srsran_gnb_ul_t;
 
 SRSRAN_API int srsran_gnb_ul_init(srsran_gnb_ul_t* q, cf_t* input, const srsran_gnb_ul_args_t* args);
@@ -63,6 +77,25 @@ SRSRAN_API int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
                                        const srsran_sch_grant_nr_t* grant,
                                        srsran_pusch_res_nr_t*       data);
 
+/**
+ * @brief Estimates the channel and decodes a PUSCH transmission using a given lane. Different lanes can be used
+ * concurrently from different threads once the resource grid has been demodulated.
+ *
+ * @param q gNb UL object
+ * @param lane_idx Lane index, 0 is the default lane used by srsran_gnb_ul_get_pusch()
+ * @param csi Provides the DMRS based channel state information of the lane, ignored if NULL
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_gnb_ul_get_pusch_lane(srsran_gnb_ul_t*               q,
+                                            uint32_t                       lane_idx,
+                                            const srsran_slot_cfg_t*       slot_cfg,
+                                            const srsran_sch_cfg_nr_t*     cfg,
+                                            const srsran_sch_grant_nr_t*   grant,
+                                            srsran_pusch_res_nr_t*         data,
+                                            srsran_csi_trs_measurements_t* csi);
+
+SRSRAN_API uint32_t srsran_gnb_ul_nof_pusch_lanes(const srsran_gnb_ul_t* q);
+
 SRSRAN_API int srsran_gnb_ul_get_pucch(srsran_gnb_ul_t*                    q,
                                        const srsran_slot_cfg_t*            slot_cfg,
                                        const srsran_pucch_nr_common_cfg_t* cfg,
@@ -84,4 +117,11 @@ SRSRAN_API uint32_t srsran_gnb_ul_pusch_info(srsran_gnb_ul_t*             q,
                                              char*                        str,
                                              uint32_t                     str_len);
 
+SRSRAN_API uint32_t srsran_gnb_ul_pusch_lane_info(srsran_gnb_ul_t*             q,
+                                                  uint32_t                     lane_idx,
+                                                  const srsran_sch_cfg_nr_t*   cfg,
+                                                  const srsran_pusch_res_nr_t* res,
+                                                  char*                        str,
+                                                  uint32_t                     str_len);
+
 #endif // SRSRAN_GNB_UL_H
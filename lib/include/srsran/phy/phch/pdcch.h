@@ -47,6 +47,19 @@
 
 typedef enum SRSRAN_API { SEARCH_UE, SEARCH_COMMON } srsran_pdcch_search_mode_t;
 
+#define SRSRAN_PDCCH_MAX_DECODED_CANDIDATES 128
+
+/* Candidate decoded in the current subframe. The decoder output does not depend on the RNTI, so it is reused by all
+ * the searches of a candidate with the same location and payload size */
+typedef struct SRSRAN_API {
+  uint32_t ncce;
+  uint32_t L;
+  uint32_t nof_bits;
+  bool     skipped;
+  uint16_t crc_rem;
+  uint8_t  payload[SRSRAN_DCI_MAX_BITS];
+} srsran_pdcch_candidate_t;
+
 /* PDCCH object */
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
@@ -73,6 +86,12 @@ typedef struct SRSRAN_API {
   srsran_viterbi_t     decoder;
   srsran_crc_t         crc;
 
+  /* candidates decoded since the last call to srsran_pdcch_extract_llr() */
+  srsran_pdcch_candidate_t candidates[SRSRAN_PDCCH_MAX_DECODED_CANDIDATES];
+  uint32_t                 nof_candidates;
+  uint32_t                 nof_decoded;
+  uint32_t                 nof_reused;
+
 } srsran_pdcch_t;
 
 SRSRAN_API int srsran_pdcch_init_ue(srsran_pdcch_t* q, uint32_t max_prb, uint32_t nof_rx_antennas);
@@ -100,7 +119,8 @@ SRSRAN_API int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
                                         srsran_chest_dl_res_t* channel,
                                         cf_t*                  sf_symbols[SRSRAN_MAX_PORTS]);
 
-/* Decoding functions: Try to decode a DCI message after calling srsran_pdcch_extract_llr */
+/* Decoding functions: Try to decode a DCI message after calling srsran_pdcch_extract_llr. Each location and message
+ * size is decoded once per subframe, further searches of the same candidate reuse the decoded bits */
 SRSRAN_API int
 srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg);
 
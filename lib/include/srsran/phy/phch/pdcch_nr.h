@@ -37,6 +37,7 @@
 #include "srsran/phy/fec/polar/polar_code.h"
 #include "srsran/phy/fec/polar/polar_decoder.h"
 #include "srsran/phy/fec/polar/polar_encoder.h"
+#include "srsran/phy/fec/polar/polar_interleaver.h"
 #include "srsran/phy/fec/polar/polar_rm.h"
 #include "srsran/phy/modem/evm.h"
 #include "srsran/phy/modem/modem_table.h"
@@ -50,6 +51,20 @@ typedef struct {
   bool measure_time;
 } srsran_pdcch_nr_args_t;
 
+/**
+ * @brief Candidate decoded in the current slot. The polar decoder output does not depend on the RNTI when the
+ * scrambling does not, so it is reused by the searches of other RNTI, search spaces and formats of the same size
+ */
+typedef struct SRSRAN_API {
+  uint32_t coreset_id;
+  uint32_t L;
+  uint32_t ncce;
+  uint32_t K;
+  uint32_t c_init;
+  float    evm;
+  uint8_t  c[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL]; ///< Message bits before the RNTI de-scrambling of the CRC
+} srsran_pdcch_nr_candidate_t;
+
 /**
  * @brief PDCCH Attributes and objects required to encode/decode NR PDCCH
  */
@@ -74,6 +89,12 @@ typedef struct SRSRAN_API {
   uint32_t               K;
   uint32_t               M;
   uint32_t               E;
+
+  srsran_pdcch_nr_candidate_t* candidates;     // Candidates decoded in the current slot
+  bool                         candidates_en;  // Set by srsran_pdcch_nr_new_slot()
+  uint32_t                     nof_candidates; // Number of candidates decoded in the current slot
+  uint32_t                     nof_decoded;    // Number of polar decodes since initialization
+  uint32_t                     nof_reused;     // Number of decodes avoided since initialization
 } srsran_pdcch_nr_t;
 
 /**
@@ -135,6 +156,14 @@ SRSRAN_API void srsran_pdcch_nr_free(srsran_pdcch_nr_t* q);
 SRSRAN_API int
 srsran_pdcch_nr_set_carrier(srsran_pdcch_nr_t* q, const srsran_carrier_nr_t* carrier, const srsran_coreset_t* coreset);
 
+/**
+ * @brief Discards the candidates decoded in the previous slot. Once it has been called, every candidate is decoded only
+ * once in the slot and the following searches of the same candidate skip the demodulation and the polar decoder
+ * @note It shall be called for every slot after the resource grid is updated
+ * @param[in,out] q PDCCH decoder object
+ */
+SRSRAN_API void srsran_pdcch_nr_new_slot(srsran_pdcch_nr_t* q);
+
 SRSRAN_API int srsran_pdcch_nr_encode(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_msg, cf_t* slot_symbols);
 
 /**
@@ -45,13 +45,20 @@
 #define SRSRAN_SCH_NR_MAX_NOF_CB_LDPC                                                                                  \
   ((SRSRAN_SLOT_MAX_NOF_BITS_NR + (SRSRAN_LDPC_MAX_LEN_CB - 1)) / SRSRAN_LDPC_MAX_LEN_CB)
 
+/**
+ * @brief Number of bins of the LDPC iteration histogram, the last one accounts for all the larger iteration counts
+ */
+#define SRSRAN_SCH_NR_ITER_HIST_SIZE 16
+
 /**
  * @brief Groups NR-PUSCH data for reception
  */
 typedef struct {
-  uint8_t* payload;  ///< SCH payload
-  bool     crc;      ///< CRC match
-  float    avg_iter; ///< Average iterations
+  uint8_t* payload;                                 ///< SCH payload
+  bool     crc;                                     ///< CRC match
+  float    avg_iter;                                ///< Average iterations
+  uint32_t iter_hist[SRSRAN_SCH_NR_ITER_HIST_SIZE]; ///< Decoded code blocks per number of iterations, minus one
+  uint32_t nof_cb_aborted;                          ///< Code blocks given up before the maximum number of iterations
 } srsran_sch_tb_res_nr_t;
 
 typedef struct SRSRAN_API {
@@ -85,7 +92,9 @@ typedef struct SRSRAN_API {
   bool     disable_simd;
   bool     decoder_use_flooded;
   float    decoder_scaling_factor;
-  uint32_t max_nof_iter; ///< Maximum number of LDPC iterations
+  uint32_t max_nof_iter;             ///< Maximum number of LDPC iterations
+  bool     decoder_early_stop;       ///< Enables the LDPC syndrome check and early abort, the CRC check is always used
+  uint32_t decoder_early_abort_iter; ///< LDPC iterations without progress before giving up, 0 for default
 } srsran_sch_nr_args_t;
 
 /**
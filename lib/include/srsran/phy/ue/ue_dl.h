@@ -125,6 +125,32 @@ typedef struct SRSRAN_API {
   float                 snr_to_cqi_offset;
 } srsran_ue_dl_cfg_t;
 
+// Per-RNTI context for decoding several UEs from the same processed subframe (FFT and channel estimation run once)
+typedef struct SRSRAN_API {
+  uint16_t            rnti;    // RNTI of the DL DCI search, SRSRAN_INVALID_RNTI skips it
+  uint16_t            ul_rnti; // RNTI of the UL DCI search, SRSRAN_INVALID_RNTI skips it
+  srsran_ue_dl_cfg_t* cfg;
+  srsran_pdsch_cfg_t* pdsch_cfg; // Provides the softbuffers and receives the decoded grant, &cfg->cfg.pdsch if NULL
+  uint8_t*            data[SRSRAN_MAX_CODEWORDS];
+
+  // Optional grant handler, replaces the default DCI conversion, RV derivation and softbuffer reset. It shall fill the
+  // grant, the softbuffers and the RV of pdsch_cfg and the payload buffers in data, and disable the TBs that must not
+  // be decoded (e.g. HARQ duplicates). Returns SRSRAN_SUCCESS or SRSRAN_ERROR
+  int (*new_grant)(void*               arg,
+                   srsran_dl_sf_cfg_t* sf,
+                   srsran_dci_dl_t*    dci_dl,
+                   srsran_pdsch_cfg_t* pdsch_cfg,
+                   uint8_t*            data[SRSRAN_MAX_CODEWORDS]);
+  void* new_grant_arg;
+
+  // Results of the last call to srsran_ue_dl_find_and_decode_multi()
+  srsran_dci_dl_t dci_dl[SRSRAN_MAX_DCI_MSG];
+  int             nof_dci_dl;
+  srsran_dci_ul_t dci_ul[SRSRAN_MAX_DCI_MSG];
+  int             nof_dci_ul;
+  bool            acks[SRSRAN_MAX_CODEWORDS];
+} srsran_ue_dl_user_t;
+
 typedef struct {
   uint32_t v_dai_dl;
   uint32_t n_cce;
@@ -242,6 +268,14 @@ SRSRAN_API int srsran_ue_dl_find_and_decode(srsran_ue_dl_t*     q,
                                             uint8_t*            data[SRSRAN_MAX_CODEWORDS],
                                             bool                acks[SRSRAN_MAX_CODEWORDS]);
 
+/* Runs the FFT and channel estimation once and then searches the DL/UL DCI and decodes the PDSCH of every user. The
+ * first user configuration is used for the cell-common processing. In TDD without a known configuration, the PHICH mi
+ * value is blindly searched as in srsran_ue_dl_find_and_decode(). Returns the number of users with a DL grant */
+SRSRAN_API int srsran_ue_dl_find_and_decode_multi(srsran_ue_dl_t*      q,
+                                                  srsran_dl_sf_cfg_t*  sf,
+                                                  srsran_ue_dl_user_t* users,
+                                                  uint32_t             nof_users);
+
 SRSRAN_API void srsran_ue_dl_save_signal(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_pdsch_cfg_t* pdsch_cfg);
 
 #endif // SRSRAN_UE_DL_H
@@ -78,6 +78,10 @@ SRSRAN_API int srsran_ringbuffer_read_timed_block(srsran_ringbuffer_t* q, void*
 // read samples from the buffer, convert them from uint16_t to cplx float and get the conjugate
 SRSRAN_API int srsran_ringbuffer_read_convert_conj(srsran_ringbuffer_t* q, cf_t* dst_ptr, float norm, int nof_samples);
 
+// read samples from the buffer, blocking for timeout_ms milliseconds, and convert them from int16_t to cplx float
+SRSRAN_API int
+srsran_ringbuffer_read_convert_timed(srsran_ringbuffer_t* q, cf_t* dst_ptr, float norm, int nof_samples, int32_t timeout_ms);
+
 SRSRAN_API int srsran_ringbuffer_read_block(srsran_ringbuffer_t* q, void** p, int nof_bytes, int32_t timeout_ms);
 
 SRSRAN_API void srsran_ringbuffer_stop(srsran_ringbuffer_t* q);
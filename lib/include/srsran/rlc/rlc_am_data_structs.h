@@ -25,6 +25,7 @@
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/intrusive_list.h"
+#include "srsran/adt/pool/mem_pool.h"
 #include "srsran/common/buffer_pool.h"
 #include <array>
 #include <list>
@@ -241,6 +242,10 @@ struct rlc_ringbuffer_t : public rlc_ringbuffer_base<T> {
 
   bool has_sn(uint32_t sn) const override { return window.contains(sn); }
 
+  // Iteration follows the slot order, not the SN order
+  typename static_circular_map<uint32_t, T, WINDOW_SIZE>::iterator begin() { return window.begin(); }
+  typename static_circular_map<uint32_t, T, WINDOW_SIZE>::iterator end() { return window.end(); }
+
   // Return the sum data bytes of all active PDUs (check PDU is non-null)
   uint32_t get_buffered_bytes()
   {
@@ -257,6 +262,233 @@ private:
   srsran::static_circular_map<uint32_t, T, WINDOW_SIZE> window;
 };
 
+/// Pool of nodes shared by all the segment lists of an RLC entity. Released nodes are cached and handed out again, so
+/// that segmentation and reassembly stop allocating once the pool holds as many nodes as there are segments in flight.
+/// Not thread-safe, it is protected by the same lock as the lists that draw from it.
+template <typename T>
+class rlc_segment_pool
+{
+public:
+  struct node : public intrusive_double_linked_list_element<> {
+    template <typename... Args>
+    explicit node(Args&&... args) : value(std::forward<Args>(args)...)
+    {}
+    T value;
+  };
+
+  rlc_segment_pool()                        = default;
+  rlc_segment_pool(const rlc_segment_pool&) = delete;
+  rlc_segment_pool& operator=(const rlc_segment_pool&) = delete;
+
+  template <typename... Args>
+  node* make(Args&&... args)
+  {
+    if (pool.capacity() == 0) {
+      nof_allocs++;
+    }
+    return new (pool.allocate_node(sizeof(node))) node(std::forward<Args>(args)...);
+  }
+  void release(node* n)
+  {
+    n->~node();
+    pool.deallocate_node(n);
+  }
+  void reserve(size_t nof_nodes)
+  {
+    pool.reserve(nof_nodes);
+    nof_allocs += nof_nodes;
+  }
+
+  /// Number of nodes taken from the heap since the pool was created
+  size_t nof_allocations() const { return nof_allocs; }
+  /// Number of released nodes ready for reuse
+  size_t nof_cached() const { return pool.capacity(); }
+
+private:
+  big_obj_pool<node> pool;
+  size_t             nof_allocs = 0;
+};
+
+/// Doubly linked list of RLC segments whose nodes come from a rlc_segment_pool. It offers the subset of std::list
+/// used by the RLC entities. The pool must be set before the first insertion and must outlive the list.
+template <typename T>
+class rlc_segment_list
+{
+  using pool_t = rlc_segment_pool<T>;
+  using node_t = typename pool_t::node;
+  using elem_t = intrusive_double_linked_list_element<>;
+
+  template <typename U>
+  class iterator_impl
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = U;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = U*;
+    using reference         = U&;
+
+    iterator_impl() = default;
+    explicit iterator_impl(elem_t* e) : ptr(e) {}
+    // Allow iterator -> const_iterator conversion
+    template <typename V, typename std::enable_if<std::is_same<const V, U>::value, int>::type = 0>
+    iterator_impl(const iterator_impl<V>& other) : ptr(other.ptr)
+    {}
+
+    U& operator*() const { return static_cast<node_t*>(ptr)->value; }
+    U* operator->() const { return &static_cast<node_t*>(ptr)->value; }
+
+    iterator_impl& operator++()
+    {
+      ptr = ptr->next_node;
+      return *this;
+    }
+    iterator_impl operator++(int)
+    {
+      iterator_impl tmp = *this;
+      ptr               = ptr->next_node;
+      return tmp;
+    }
+
+    bool operator==(const iterator_impl& other) const { return ptr == other.ptr; }
+    bool operator!=(const iterator_impl& other) const { return ptr != other.ptr; }
+
+  private:
+    friend class rlc_segment_list<T>;
+    template <typename V>
+    friend class iterator_impl;
+
+    elem_t* ptr = nullptr;
+  };
+
+public:
+  using iterator       = iterator_impl<T>;
+  using const_iterator = iterator_impl<const T>;
+
+  explicit rlc_segment_list(pool_t* pool_ = nullptr) : pool(pool_) {}
+  rlc_segment_list(const rlc_segment_list&) = delete;
+  rlc_segment_list(rlc_segment_list&& other) noexcept :
+    pool(other.pool), head(other.head), tail(other.tail), count(other.count)
+  {
+    other.head  = nullptr;
+    other.tail  = nullptr;
+    other.count = 0;
+  }
+  rlc_segment_list& operator=(const rlc_segment_list&) = delete;
+  rlc_segment_list& operator=(rlc_segment_list&& other) noexcept
+  {
+    if (this != &other) {
+      clear();
+      pool        = other.pool;
+      head        = other.head;
+      tail        = other.tail;
+      count       = other.count;
+      other.head  = nullptr;
+      other.tail  = nullptr;
+      other.count = 0;
+    }
+    return *this;
+  }
+  ~rlc_segment_list() { clear(); }
+
+  void set_pool(pool_t* pool_)
+  {
+    srsran_assert(empty() or pool == pool_, "Segment list can only change pool while empty");
+    pool = pool_;
+  }
+
+  bool   empty() const { return count == 0; }
+  size_t size() const { return count; }
+
+  T&       front() { return static_cast<node_t*>(head)->value; }
+  const T& front() const { return static_cast<const node_t*>(head)->value; }
+  T&       back() { return static_cast<node_t*>(tail)->value; }
+  const T& back() const { return static_cast<const node_t*>(tail)->value; }
+
+  iterator       begin() { return iterator(head); }
+  iterator       end() { return iterator(nullptr); }
+  const_iterator begin() const { return const_iterator(head); }
+  const_iterator end() const { return const_iterator(nullptr); }
+
+  template <typename... Args>
+  T& emplace_back(Args&&... args)
+  {
+    return *emplace(end(), std::forward<Args>(args)...);
+  }
+  void push_back(T&& value) { emplace(end(), std::move(value)); }
+  void push_back(const T& value) { emplace(end(), value); }
+
+  /// Insert before pos and return an iterator to the new element
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args)
+  {
+    srsran_assert(pool != nullptr, "Segment list used without a pool");
+    elem_t* n = pool->make(std::forward<Args>(args)...);
+    elem_t* p = pos.ptr;
+    if (p == nullptr) {
+      n->prev_node = tail;
+      n->next_node = nullptr;
+      if (tail != nullptr) {
+        tail->next_node = n;
+      } else {
+        head = n;
+      }
+      tail = n;
+    } else {
+      n->prev_node = p->prev_node;
+      n->next_node = p;
+      if (p->prev_node != nullptr) {
+        p->prev_node->next_node = n;
+      } else {
+        head = n;
+      }
+      p->prev_node = n;
+    }
+    count++;
+    return iterator(n);
+  }
+  iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+  iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+
+  /// Remove the element at pos and return an iterator to the next one
+  iterator erase(const_iterator pos)
+  {
+    elem_t* n    = pos.ptr;
+    elem_t* next = n->next_node;
+    if (n->prev_node != nullptr) {
+      n->prev_node->next_node = next;
+    } else {
+      head = next;
+    }
+    if (next != nullptr) {
+      next->prev_node = n->prev_node;
+    } else {
+      tail = n->prev_node;
+    }
+    count--;
+    pool->release(static_cast<node_t*>(n));
+    return iterator(next);
+  }
+  void pop_front() { erase(begin()); }
+
+  void clear()
+  {
+    while (head != nullptr) {
+      elem_t* next = head->next_node;
+      pool->release(static_cast<node_t*>(head));
+      head = next;
+    }
+    tail  = nullptr;
+    count = 0;
+  }
+
+private:
+  pool_t* pool  = nullptr;
+  elem_t* head  = nullptr;
+  elem_t* tail  = nullptr;
+  size_t  count = 0;
+};
+
 template <typename HeaderType>
 struct buffered_pdcp_pdu_list {
 public:
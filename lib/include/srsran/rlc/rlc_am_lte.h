@@ -221,8 +221,9 @@ private:
   std::mutex mutex;
 
   // Rx windows
-  rlc_ringbuffer_t<rlc_amd_rx_pdu, RLC_AM_WINDOW_SIZE> rx_window;
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>        rx_segments;
+  rlc_segment_pool<rlc_amd_rx_pdu>                                rx_segment_pool; // must outlive rx_segments
+  rlc_ringbuffer_t<rlc_amd_rx_pdu, RLC_AM_WINDOW_SIZE>            rx_window;
+  rlc_ringbuffer_t<rlc_amd_rx_pdu_segments_t, RLC_AM_WINDOW_SIZE> rx_segments;
 
   bool              poll_received = false;
   std::atomic<bool> do_status     = {false}; // light-weight access from Tx entity
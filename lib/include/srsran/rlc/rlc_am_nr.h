@@ -90,7 +90,7 @@ struct rlc_amd_tx_pdu_nr {
     uint32_t so          = 0;
     uint32_t payload_len = 0;
   };
-  std::list<pdu_segment> segment_list;
+  rlc_segment_list<pdu_segment> segment_list;
   explicit rlc_amd_tx_pdu_nr(uint32_t sn) : rlc_sn(sn) {}
 };
 
@@ -161,6 +161,7 @@ private:
    * Ref: 3GPP TS 38.322 version 16.2.0 Section 7.1
    ***************************************************************************/
   struct rlc_am_nr_tx_state_t                              st = {};
+  rlc_segment_pool<rlc_amd_tx_pdu_nr::pdu_segment>         tx_segment_pool; // must outlive tx_window
   std::unique_ptr<rlc_ringbuffer_base<rlc_amd_tx_pdu_nr> > tx_window;
 
   // Queues, buffers and container
@@ -24,19 +24,22 @@
 
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
+#include "srsran/rlc/rlc_am_data_structs.h"
 #include "srsran/rlc/rlc_um_base.h"
 #include "srsran/upper/byte_buffer_queue.h"
-#include <map>
 #include <mutex>
 #include <pthread.h>
 #include <queue>
 
 namespace srsran {
 
-typedef struct {
+struct rlc_umd_pdu_t {
   rlc_umd_pdu_header_t header;
   unique_byte_buffer_t buf;
-} rlc_umd_pdu_t;
+
+  rlc_umd_pdu_t() = default;
+  explicit rlc_umd_pdu_t(uint32_t /* sn */) {}
+};
 
 class rlc_um_lte : public rlc_um_base
 {
@@ -95,8 +98,9 @@ private:
   private:
     void reset();
 
-    // Rx window
-    std::map<uint32_t, rlc_umd_pdu_t> rx_window;
+    // Rx window, indexed by SN. Sized to the SN modulus in configure(), as a PDU above vr_uh may be stored before
+    // the SNs below it have been reassembled
+    std::unique_ptr<rlc_ringbuffer_base<rlc_umd_pdu_t> > rx_window;
 
     // RX SDU buffers
     uint32_t vr_ur_in_rx_sdu = 0;
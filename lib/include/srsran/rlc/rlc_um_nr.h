@@ -25,9 +25,9 @@
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/interfaces/ue_interfaces.h"
+#include "srsran/rlc/rlc_am_data_structs.h"
 #include "srsran/rlc/rlc_um_base.h"
 #include "srsran/upper/byte_buffer_queue.h"
-#include <map>
 #include <mutex>
 #include <pthread.h>
 #include <queue>
@@ -116,15 +116,21 @@ private:
     uint32_t mod            = 0; // Rx counter modulus
 
     // Rx window
-    typedef struct {
-      std::map<uint32_t, rlc_umd_pdu_nr_t> segments; // Map of segments with SO as key
-      unique_byte_buffer_t                 sdu;
-      uint32_t                             next_expected_so;
-      uint32_t                             total_sdu_length;
-    } rlc_umd_pdu_segments_nr_t;
-    std::map<uint32_t, rlc_umd_pdu_segments_nr_t> rx_window;
+    struct rlc_umd_pdu_segments_nr_t {
+      rlc_segment_list<rlc_umd_pdu_nr_t> segments; // List of segments sorted by SO
+      unique_byte_buffer_t               sdu;
+      uint32_t                           next_expected_so = 0;
+      uint32_t                           total_sdu_length = 0;
+
+      rlc_umd_pdu_segments_nr_t() = default;
+      explicit rlc_umd_pdu_segments_nr_t(uint32_t /* sn */) {}
+    };
+    rlc_segment_pool<rlc_umd_pdu_nr_t> rx_segment_pool; // must outlive rx_window
+    // Indexed by SN and sized to the SN modulus in configure()
+    std::unique_ptr<rlc_ringbuffer_base<rlc_umd_pdu_segments_nr_t> > rx_window;
 
     void update_total_sdu_length(rlc_umd_pdu_segments_nr_t& pdu_segments, const rlc_umd_pdu_nr_t& rx_pdu);
+    void insert_segment(rlc_umd_pdu_segments_nr_t& pdu_segments, rlc_umd_pdu_nr_t&& rx_pdu);
 
     // TS 38.322 Sec. 7.3
     srsran::timer_handler::unique_timer reassembly_timer; // to detect loss of RLC PDUs at lower layers
@@ -66,6 +66,7 @@ extern "C" {
 #include "srsran/phy/dft/dft.h"
 #include "srsran/phy/dft/dft_precoding.h"
 #include "srsran/phy/dft/ofdm.h"
+#include "srsran/phy/dft/ofdm_batch.h"
 #include "srsran/phy/fec/cbsegm.h"
 #include "srsran/phy/fec/convolutional/convcoder.h"
 #include "srsran/phy/fec/convolutional/rm_conv.h"
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_PDCP_H
 #define SRSRAN_PDCP_H
 
+#include "srsran/adt/circular_map.h"
 #include "srsran/common/common.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/interfaces/ue_pdcp_interfaces.h"
@@ -85,8 +86,11 @@ private:
   srsran::task_sched_handle  task_sched;
   srslog::basic_logger&      logger;
 
-  using pdcp_map_t = std::map<uint16_t, std::unique_ptr<pdcp_entity_base> >;
-  pdcp_map_t pdcp_array, pdcp_array_mrb;
+  // Entities indexed directly by LCID, valid_lcid()/valid_mch_lcid() keep the LCID within bounds
+  using pdcp_map_t     = static_circular_map<uint16_t, std::unique_ptr<pdcp_entity_base>, SRSRAN_N_RADIO_BEARERS>;
+  using pdcp_mrb_map_t = static_circular_map<uint16_t, std::unique_ptr<pdcp_entity_base>, SRSRAN_N_MCH_LCIDS>;
+  pdcp_map_t     pdcp_array;
+  pdcp_mrb_map_t pdcp_array_mrb;
 
   // cache valid lcids to be checked from separate thread
   std::mutex         cache_mutex;
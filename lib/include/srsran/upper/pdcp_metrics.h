@@ -34,6 +34,10 @@ typedef struct {
   uint64_t num_tx_pdu_bytes;
   uint64_t num_rx_pdu_bytes;
 
+  // SDU metrics since the last metrics report
+  uint64_t num_tx_sdu_bytes; //< Bytes of the SDUs received from upper layers
+  uint64_t num_rx_sdu_bytes; //< Bytes of the SDUs delivered to upper layers
+
   // ACK specific metrics (requires RLC AM)
   uint64_t num_tx_acked_bytes;         //< Cumulative number of bytes that the PDCP knows to be acknowledged
   uint64_t tx_notification_latency_ms; //< Average time in ms from PDU delivery to RLC to ACK notification from RLC
@@ -42,6 +46,7 @@ typedef struct {
 } pdcp_bearer_metrics_t;
 
 typedef struct {
+  uint16_t              rnti; //< Only set by the eNB, which reports the metrics of all its UEs
   pdcp_bearer_metrics_t bearer[SRSRAN_N_RADIO_BEARERS];
 } pdcp_metrics_t;
 
@@ -0,0 +1,100 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/epoch_guard.h"
+#include <algorithm>
+#include <thread>
+
+namespace srsran {
+
+epoch_domain::~epoch_domain()
+{
+  synchronize();
+}
+
+size_t epoch_domain::enter()
+{
+  // Each thread starts looking from the slot it took last, so readers seldom compete for a slot
+  static thread_local size_t hint = std::hash<std::thread::id>{}(std::this_thread::get_id()) % max_readers;
+
+  // Taking the slot with an older epoch only delays the reclamation. The slot is taken before any shared object is
+  // read, so either the writer sees the slot taken, or the reader doesn't see the objects unlinked by the writer
+  uint64_t epoch = global_epoch.load();
+  while (true) {
+    for (size_t i = 0; i < max_readers; ++i) {
+      size_t   idx  = (hint + i) % max_readers;
+      uint64_t free = 0;
+      if (slots[idx].epoch.compare_exchange_strong(free, epoch)) {
+        hint = idx;
+        return idx;
+      }
+    }
+  }
+}
+
+void epoch_domain::exit(size_t slot)
+{
+  slots[slot].epoch.store(0, std::memory_order_release);
+}
+
+void epoch_domain::retire(move_callback<void()> deleter)
+{
+  // Read sections starting from now on get a newer epoch, so they can't see the object
+  retired.push_back(retired_obj{global_epoch.fetch_add(1), std::move(deleter)});
+}
+
+size_t epoch_domain::reclaim()
+{
+  // Objects are retired in order of epoch
+  uint64_t min_epoch = min_active_epoch();
+  auto     it        = retired.begin();
+  for (; it != retired.end() and it->epoch < min_epoch; ++it) {
+    it->deleter();
+  }
+  retired.erase(retired.begin(), it);
+  return retired.size();
+}
+
+void epoch_domain::synchronize()
+{
+  uint64_t epoch = global_epoch.fetch_add(1);
+  while (min_active_epoch() <= epoch) {
+    std::this_thread::yield();
+  }
+  for (retired_obj& obj : retired) {
+    obj.deleter();
+  }
+  retired.clear();
+}
+
+uint64_t epoch_domain::min_active_epoch() const
+{
+  uint64_t min_epoch = UINT64_MAX;
+  for (const reader_slot& slot : slots) {
+    uint64_t epoch = slot.epoch.load();
+    if (epoch != 0) {
+      min_epoch = std::min(min_epoch, epoch);
+    }
+  }
+  return min_epoch;
+}
+
+} // namespace srsran
@@ -0,0 +1,428 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/thread_pool.h"
+#include "srsran/common/work_stealing_pool.h"
+#include "srsran/config.h"
+#include "srsran/support/srsran_test.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <set>
+#include <thread>
+
+using bench_clock = std::chrono::steady_clock;
+
+static uint32_t nof_bench_tasks = 100000;
+static uint32_t nof_bench_pings = 10000;
+static uint32_t nof_workers     = 4;
+
+static const uint32_t max_bench_tasks_in_flight = 4096;
+static const double   max_bench_drain_s         = 10.0;
+
+static void test_deque_sequential()
+{
+  srsran::work_stealing_deque<uint32_t> q(2);
+  uint32_t                              items[5] = {0, 1, 2, 3, 4};
+
+  TESTASSERT(q.empty());
+  TESTASSERT(q.pop() == nullptr);
+  TESTASSERT(q.steal() == nullptr);
+
+  for (uint32_t i = 0; i < 4; i++) {
+    TESTASSERT(q.push(&items[i]));
+  }
+  TESTASSERT(not q.push(&items[4]));
+
+  // Owner takes the newest, thieves the oldest
+  TESTASSERT(q.pop() == &items[3]);
+  TESTASSERT(q.steal() == &items[0]);
+  TESTASSERT(q.steal() == &items[1]);
+  TESTASSERT(q.pop() == &items[2]);
+  TESTASSERT(q.empty());
+
+  // Wrap around
+  for (uint32_t i = 0; i < 4; i++) {
+    TESTASSERT(q.push(&items[i]));
+  }
+  for (uint32_t i = 0; i < 4; i++) {
+    TESTASSERT(q.steal() == &items[i]);
+  }
+  TESTASSERT(q.empty());
+}
+
+static void test_deque_concurrent()
+{
+  const uint32_t nof_items   = 200000;
+  const uint32_t nof_thieves = 3;
+
+  srsran::work_stealing_deque<uint32_t> q(8);
+  std::vector<uint32_t>                 items(nof_items);
+  std::vector<std::atomic<uint32_t> >   taken(nof_items);
+  std::atomic<bool>                     done = {false};
+
+  auto take = [&taken, &items](uint32_t* item) { taken[item - items.data()].fetch_add(1); };
+
+  std::vector<std::thread> thieves;
+  for (uint32_t i = 0; i < nof_thieves; i++) {
+    thieves.emplace_back([&q, &done, &take]() {
+      while (not done.load() or not q.empty()) {
+        uint32_t* item = q.steal();
+        if (item != nullptr) {
+          take(item);
+        }
+      }
+    });
+  }
+
+  // The owner pushes all items and pops every other one
+  for (uint32_t i = 0; i < nof_items; i++) {
+    while (not q.push(&items[i])) {
+      uint32_t* item = q.pop();
+      if (item != nullptr) {
+        take(item);
+      }
+    }
+    if (i % 2 == 0) {
+      uint32_t* item = q.pop();
+      if (item != nullptr) {
+        take(item);
+      }
+    }
+  }
+  done = true;
+  for (std::thread& t : thieves) {
+    t.join();
+  }
+
+  // Each item must be taken exactly once
+  for (uint32_t i = 0; i < nof_items; i++) {
+    TESTASSERT_EQ(1, taken[i].load());
+  }
+}
+
+/// Each task spawns two children until the given depth, the total number of tasks is 2^(depth + 1) - 1
+static void spawn_tree(srsran::work_stealing_pool& pool, std::atomic<uint32_t>& count, uint32_t depth)
+{
+  count++;
+  if (depth == 0) {
+    return;
+  }
+  for (uint32_t i = 0; i < 2; i++) {
+    pool.push_task([&pool, &count, depth]() { spawn_tree(pool, count, depth - 1); });
+  }
+}
+
+template <typename Cond>
+static void wait_for(Cond cond)
+{
+  while (not cond()) {
+    std::this_thread::yield();
+  }
+}
+
+/// Like wait_for(), but gives up after the given time. Returns whether the condition was met
+template <typename Cond>
+static bool wait_for(Cond cond, double timeout_s)
+{
+  bench_clock::time_point deadline =
+      bench_clock::now() + std::chrono::duration_cast<bench_clock::duration>(std::chrono::duration<double>(timeout_s));
+  while (not cond()) {
+    if (bench_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+static void test_pool_nested_tasks()
+{
+  const uint32_t depth = 14;
+
+  srsran::work_stealing_pool::args_t args;
+  args.realtime.nof_workers = nof_workers;
+  args.nof_task_nodes       = 1U << (depth + 1U);
+  srsran::work_stealing_pool pool(args);
+
+  std::atomic<uint32_t> count = {0};
+  pool.push_task([&pool, &count]() { spawn_tree(pool, count, depth); });
+
+  wait_for([&count]() { return count.load() == (1U << (depth + 1)) - 1; });
+  pool.stop();
+  bool pushed = pool.push_task([]() {});
+  TESTASSERT(not pushed);
+}
+
+static void test_pool_priority_classes()
+{
+  srsran::work_stealing_pool::args_t args;
+  args.realtime.nof_workers   = 2;
+  args.background.nof_workers = 2;
+  srsran::work_stealing_pool pool(args);
+
+  std::mutex                 mutex;
+  std::set<std::thread::id>  rt_threads, bg_threads;
+  std::atomic<uint32_t>      count    = {0};
+  const uint32_t             nof_jobs = 1000;
+
+  for (uint32_t i = 0; i < nof_jobs; i++) {
+    pool.push_task([&]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      rt_threads.insert(std::this_thread::get_id());
+      count++;
+    });
+    pool.push_task(
+        [&]() {
+          std::lock_guard<std::mutex> lock(mutex);
+          bg_threads.insert(std::this_thread::get_id());
+          count++;
+        },
+        srsran::work_stealing_pool::task_priority::background);
+  }
+  wait_for([&count, nof_jobs]() { return count.load() == 2 * nof_jobs; });
+  pool.stop();
+
+  // Real-time and background tasks never share a worker
+  TESTASSERT(rt_threads.size() <= 2 and bg_threads.size() <= 2);
+  for (const std::thread::id& id : rt_threads) {
+    TESTASSERT(bg_threads.count(id) == 0);
+  }
+}
+
+static void test_pool_task_group()
+{
+  srsran::work_stealing_pool::args_t args;
+  args.realtime.nof_workers = nof_workers;
+  srsran::work_stealing_pool pool(args);
+
+  // The waiter returns once every task of its group ran, whoever ran them
+  const uint32_t                        nof_tasks = 1000;
+  std::vector<uint32_t>                 results(nof_tasks);
+  srsran::work_stealing_pool::task_group group;
+  for (uint32_t i = 0; i < nof_tasks; i++) {
+    uint32_t* r      = &results[i];
+    bool      pushed = pool.push_task(group, [r, i]() { *r = i + 1; });
+    TESTASSERT(pushed);
+  }
+  pool.wait(group);
+  for (uint32_t i = 0; i < nof_tasks; i++) {
+    TESTASSERT_EQ(i + 1, results[i]);
+  }
+  pool.stop();
+}
+
+static void test_pool_task_group_no_workers()
+{
+  srsran::work_stealing_pool::args_t args;
+  args.realtime.nof_workers = 0;
+  args.nof_task_nodes       = 4;
+  srsran::work_stealing_pool pool(args);
+
+  // Without workers only group tasks are accepted, the waiter runs them sequentially
+  uint32_t count  = 0;
+  bool     pushed = pool.push_task([&count]() { count++; });
+  TESTASSERT(not pushed);
+
+  srsran::work_stealing_pool::task_group group;
+  for (uint32_t i = 0; i < 4; i++) {
+    pushed = pool.push_task(group, [&count]() { count++; });
+    TESTASSERT(pushed);
+  }
+
+  // All the task nodes are in use
+  pushed = pool.push_task(group, [&count]() { count++; });
+  TESTASSERT(not pushed);
+  TESTASSERT_EQ(0, count);
+
+  pool.wait(group);
+  TESTASSERT_EQ(4, count);
+
+  // The nodes are released when the tasks complete
+  for (uint32_t i = 0; i < 4; i++) {
+    pushed = pool.push_task(group, [&count]() { count++; });
+    TESTASSERT(pushed);
+  }
+  pool.wait(group);
+  TESTASSERT_EQ(8, count);
+}
+
+struct bench_result_t {
+  double   latency_avg_us  = 0.0;
+  double   latency_max_us  = 0.0;
+  double   throughput_mtps = 0.0;
+  uint32_t nof_rejected    = 0; ///< Tasks the pool refused to take
+  uint32_t nof_lost        = 0; ///< Tasks the pool took but never ran
+};
+
+/// State written by the benchmark tasks. It is shared with them so that a task that runs late never touches a
+/// finished stack frame
+struct bench_state_t {
+  std::atomic<int64_t>  start_ns   = {0};
+  std::atomic<int64_t>  elapsed_ns = {-1};
+  std::atomic<uint32_t> count      = {0};
+};
+
+/// Measures the time from push to execution of one task at a time and the time to run many tiny tasks. "push"
+/// returns false when the pool rejects the task. Only the tasks that actually ran count for the throughput
+template <typename PushFn>
+static bench_result_t bench_tasks(PushFn push)
+{
+  bench_result_t                 ret;
+  std::shared_ptr<bench_state_t> st = std::make_shared<bench_state_t>();
+
+  // Dispatch latency, one task in flight
+  double   sum_us    = 0.0;
+  uint32_t nof_pings = 0;
+  for (uint32_t i = 0; i < nof_bench_pings; i++) {
+    st->elapsed_ns = -1;
+    st->start_ns   = bench_clock::now().time_since_epoch().count();
+    if (not push([st]() { st->elapsed_ns = bench_clock::now().time_since_epoch().count() - st->start_ns.load(); })) {
+      ret.nof_rejected++;
+      continue;
+    }
+    if (not wait_for([&st]() { return st->elapsed_ns.load() >= 0; }, max_bench_drain_s)) {
+      ret.nof_lost++;
+      break;
+    }
+    double us          = (double)st->elapsed_ns.load() * bench_clock::period::num / bench_clock::period::den * 1e6;
+    sum_us += us;
+    ret.latency_max_us = std::max(ret.latency_max_us, us);
+    nof_pings++;
+  }
+  ret.latency_avg_us = nof_pings > 0 ? sum_us / nof_pings : 0.0;
+
+  // Throughput, many tasks in flight
+  uint32_t                nof_pushed = 0;
+  bench_clock::time_point t0         = bench_clock::now();
+  for (uint32_t i = 0; i < nof_bench_tasks; i++) {
+    // Bound the tasks in flight, task_thread_pool drops tasks when its queue is full
+    wait_for([&st, nof_pushed]() {
+      return nof_pushed - st->count.load(std::memory_order_relaxed) < max_bench_tasks_in_flight;
+    });
+    if (push([st]() { st->count.fetch_add(1, std::memory_order_relaxed); })) {
+      nof_pushed++;
+    } else {
+      ret.nof_rejected++;
+    }
+  }
+  // task_thread_pool does not report the tasks it drops, they show up as lost
+  wait_for([&st, nof_pushed]() { return st->count.load() == nof_pushed; }, max_bench_drain_s);
+  double   elapsed_s  = std::chrono::duration<double>(bench_clock::now() - t0).count();
+  uint32_t nof_done   = st->count.load();
+  ret.nof_lost += nof_pushed - nof_done;
+  ret.throughput_mtps = nof_done / elapsed_s / 1e6;
+
+  return ret;
+}
+
+class bench_worker : public srsran::thread_pool::worker
+{
+public:
+  srsran::move_callback<void()> task;
+
+protected:
+  void work_imp() override { task(); }
+};
+
+static bench_result_t bench_thread_pool()
+{
+  srsran::thread_pool                          pool(nof_workers);
+  std::vector<std::unique_ptr<bench_worker> > workers;
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    workers.emplace_back(new bench_worker);
+    pool.init_worker(i, workers.back().get());
+  }
+
+  uint32_t       tti = 0;
+  bench_result_t ret = bench_tasks([&pool, &tti](auto&& task) {
+    bench_worker* w = (bench_worker*)pool.wait_worker(tti++);
+    w->task         = std::move(task);
+    pool.start_worker(w);
+    return true;
+  });
+  pool.stop();
+  return ret;
+}
+
+static bench_result_t bench_task_thread_pool()
+{
+  srsran::task_thread_pool pool(nof_workers);
+  bench_result_t           ret = bench_tasks([&pool](auto&& task) {
+    pool.push_task(std::move(task));
+    return true;
+  });
+  pool.stop();
+  return ret;
+}
+
+static bench_result_t bench_work_stealing_pool()
+{
+  srsran::work_stealing_pool::args_t args;
+  args.realtime.nof_workers = nof_workers;
+  srsran::work_stealing_pool pool(args);
+  bench_result_t ret = bench_tasks([&pool](auto&& task) { return pool.push_task(std::move(task)); });
+  pool.stop();
+  return ret;
+}
+
+/// Prints one row of the benchmark table. Returns false if the pool rejected or lost any task
+static bool print_bench(const char* name, const bench_result_t& r)
+{
+  printf("  | %20s | %12.2f | %12.2f | %12.3f | %12d |\n",
+         name,
+         r.latency_avg_us,
+         r.latency_max_us,
+         r.throughput_mtps,
+         r.nof_rejected + r.nof_lost);
+  return r.nof_rejected + r.nof_lost == 0;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  if (argc > 1) {
+    nof_bench_tasks = (uint32_t)strtol(argv[1], nullptr, 10);
+  }
+  if (argc > 2) {
+    nof_workers = (uint32_t)strtol(argv[2], nullptr, 10);
+  }
+
+  test_deque_sequential();
+  test_deque_concurrent();
+  test_pool_nested_tasks();
+  test_pool_priority_classes();
+  test_pool_task_group();
+  test_pool_task_group_no_workers();
+
+  printf("Task dispatch with %d workers, %d pings and %d tasks:\n", nof_workers, nof_bench_pings, nof_bench_tasks);
+  printf("  +----------------------+--------------+--------------+--------------+--------------+\n");
+  printf("  | %20s | %12s | %12s | %12s | %12s |\n", "Pool", "Lat avg (us)", "Lat max (us)", "Mtasks/s", "Failed");
+  printf("  +----------------------+--------------+--------------+--------------+--------------+\n");
+  bool ok = print_bench("thread_pool", bench_thread_pool());
+  ok &= print_bench("task_thread_pool", bench_task_thread_pool());
+  ok &= print_bench("work_stealing_pool", bench_work_stealing_pool());
+  printf("  +----------------------+--------------+--------------+--------------+--------------+\n");
+
+  srslog::flush();
+  return ok ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+}
@@ -0,0 +1,417 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/work_stealing_pool.h"
+#include <thread>
+
+namespace srsran {
+
+/// Number of task nodes moved at once between a worker cache and the shared free list
+static const uint32_t node_batch_size = 32;
+
+thread_local work_stealing_pool::worker_t* work_stealing_pool::current_worker = nullptr;
+
+work_stealing_pool::work_stealing_pool(const args_t& args) :
+  logger(srslog::fetch_basic_logger("POOL")), spin_count(args.spin_count), nodes(new task_node_t[args.nof_task_nodes])
+{
+  const worker_group_cfg_t* groups[] = {&args.realtime, &args.background};
+
+  // All the task nodes start in the shared free list, an injector can hold all of them
+  for (uint32_t i = 0; i < args.nof_task_nodes; i++) {
+    nodes[i].next_free = free_list;
+    free_list          = &nodes[i];
+  }
+  for (priority_class_t& cls : classes) {
+    cls.injector.set_size(args.nof_task_nodes);
+  }
+
+  // Create all the workers before starting any, stealing iterates the workers of the class
+  for (uint32_t c = 0; c < (uint32_t)task_priority::nof_priorities; c++) {
+    for (uint32_t i = 0; i < groups[c]->nof_workers; i++) {
+      classes[c].workers.emplace_back(
+          new worker_t(*this, classes[c], i, groups[c]->name + std::to_string(i), args.deque_size_log));
+    }
+  }
+
+  for (uint32_t c = 0; c < (uint32_t)task_priority::nof_priorities; c++) {
+    for (std::unique_ptr<worker_t>& w : classes[c].workers) {
+      if (groups[c]->mask == 255) {
+        w->start(groups[c]->prio);
+      } else {
+        w->start_cpu_mask(groups[c]->prio, groups[c]->mask);
+      }
+    }
+  }
+}
+
+work_stealing_pool::~work_stealing_pool()
+{
+  stop();
+}
+
+void work_stealing_pool::stop()
+{
+  if (not running.exchange(false)) {
+    return;
+  }
+
+  for (priority_class_t& cls : classes) {
+    {
+      std::lock_guard<std::mutex> lock(cls.mutex);
+      cls.cvar.notify_all();
+    }
+    for (std::unique_ptr<worker_t>& w : cls.workers) {
+      w->wait_thread_finish();
+    }
+  }
+
+  // Run the pending tasks somebody waits for and discard the rest
+  auto flush = [this](task_node_t* t) {
+    if (t->group != nullptr) {
+      run_task(t);
+    } else {
+      free_node(t);
+    }
+  };
+  for (priority_class_t& cls : classes) {
+    for (std::unique_ptr<worker_t>& w : cls.workers) {
+      for (task_node_t* t = w->deque.steal(); t != nullptr; t = w->deque.steal()) {
+        flush(t);
+      }
+    }
+    for (task_node_t* t = cls.pop_injector(); t != nullptr; t = cls.pop_injector()) {
+      flush(t);
+    }
+  }
+}
+
+bool work_stealing_pool::push_task(task_t&& task, task_priority priority)
+{
+  if (not running.load(std::memory_order_relaxed) or classes[(size_t)priority].workers.empty()) {
+    logger.error("Cannot push task, the pool is stopped or it has no workers for the priority class");
+    return false;
+  }
+
+  task_node_t* node = alloc_node();
+  if (node == nullptr) {
+    return false;
+  }
+  node->task  = std::move(task);
+  node->group = nullptr;
+  push_node(node, priority);
+  return true;
+}
+
+bool work_stealing_pool::push_task(task_group& group, task_t&& task, task_priority priority)
+{
+  if (not running.load(std::memory_order_relaxed)) {
+    logger.error("Cannot push task, the pool is stopped");
+    return false;
+  }
+
+  task_node_t* node = alloc_node();
+  if (node == nullptr) {
+    return false;
+  }
+  node->task  = std::move(task);
+  node->group = &group;
+  group.pending.fetch_add(1, std::memory_order_relaxed);
+  push_node(node, priority);
+  return true;
+}
+
+void work_stealing_pool::push_node(task_node_t* node, task_priority priority)
+{
+  priority_class_t& cls = classes[(size_t)priority];
+
+  // Tasks pushed by a worker of the same class go to its own deque, they are likely to use the same data
+  worker_t* w = get_current_worker();
+  if (w == nullptr or &w->cls != &cls or not w->deque.push(node)) {
+    cls.push_injector(node);
+  }
+
+  // Pairs with the fence in worker_t::sleep(), either the sleeping worker sees the task or the task sees the worker
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (cls.nof_sleeping.load(std::memory_order_relaxed) > 0) {
+    cls.wake_one();
+  }
+}
+
+void work_stealing_pool::wait(task_group& group, task_priority priority)
+{
+  priority_class_t& cls  = classes[(size_t)priority];
+  worker_t*         w    = get_current_worker();
+  uint32_t          seed = 1;
+
+  while (group.pending.load(std::memory_order_acquire) > 0) {
+    // Help with the pending tasks rather than sleeping, they may belong to another group
+    task_node_t* t = nullptr;
+    if (w != nullptr and &w->cls == &cls) {
+      t = w->deque.pop();
+    }
+    if (t == nullptr) {
+      t = cls.pop_injector();
+    }
+    if (t == nullptr) {
+      t = cls.steal(w, seed);
+    }
+    if (t != nullptr) {
+      run_task(t);
+      continue;
+    }
+
+    // The remaining tasks of the group are being executed by other threads
+    std::unique_lock<std::mutex> lock(done_mutex);
+    if (group.pending.load(std::memory_order_acquire) > 0 and not cls.has_work()) {
+      done_cvar.wait(lock);
+    }
+  }
+}
+
+uint32_t work_stealing_pool::nof_workers(task_priority priority) const
+{
+  return (uint32_t)classes[(size_t)priority].workers.size();
+}
+
+work_stealing_pool::task_node_t* work_stealing_pool::alloc_node()
+{
+  // Workers take nodes from their own cache, refilled from the shared list in batches
+  worker_t* w = get_current_worker();
+  if (w != nullptr and w->free_cache != nullptr) {
+    task_node_t* node = w->free_cache;
+    w->free_cache     = node->next_free;
+    w->free_cache_size--;
+    return node;
+  }
+
+  std::lock_guard<std::mutex> lock(free_mutex);
+  if (free_list == nullptr) {
+    logger.error("Cannot push task, all the task nodes are in use");
+    return nullptr;
+  }
+  task_node_t* node = free_list;
+  free_list         = node->next_free;
+  for (uint32_t i = 1; w != nullptr and i < node_batch_size and free_list != nullptr; i++) {
+    task_node_t* cached = free_list;
+    free_list           = cached->next_free;
+    cached->next_free   = w->free_cache;
+    w->free_cache       = cached;
+    w->free_cache_size++;
+  }
+  return node;
+}
+
+void work_stealing_pool::free_node(task_node_t* node)
+{
+  // Release the task capture now rather than when the node is reused
+  node->task  = task_t{};
+  node->group = nullptr;
+
+  worker_t* w = get_current_worker();
+  if (w != nullptr) {
+    node->next_free = w->free_cache;
+    w->free_cache   = node;
+    w->free_cache_size++;
+    if (w->free_cache_size < 2 * node_batch_size) {
+      return;
+    }
+
+    // Give a batch back, the nodes of tasks pushed from outside the pool are freed by the workers
+    std::lock_guard<std::mutex> lock(free_mutex);
+    for (uint32_t i = 0; i < node_batch_size; i++) {
+      task_node_t* returned = w->free_cache;
+      w->free_cache         = returned->next_free;
+      returned->next_free   = free_list;
+      free_list             = returned;
+    }
+    w->free_cache_size -= node_batch_size;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(free_mutex);
+  node->next_free = free_list;
+  free_list       = node;
+}
+
+void work_stealing_pool::run_task(task_node_t* node)
+{
+  node->task();
+
+  task_group* group = node->group;
+  free_node(node);
+
+  // The group may be destroyed by its waiter as soon as the pending count reaches zero
+  if (group != nullptr and group->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    std::lock_guard<std::mutex> lock(done_mutex);
+    done_cvar.notify_all();
+  }
+}
+
+work_stealing_pool::worker_t* work_stealing_pool::get_current_worker() const
+{
+  return (current_worker != nullptr and &current_worker->pool == this) ? current_worker : nullptr;
+}
+
+void work_stealing_pool::priority_class_t::push_injector(task_node_t* t)
+{
+  // There are as many injector slots as task nodes, so it never overflows
+  std::lock_guard<std::mutex> lock(mutex);
+  injector.push(t);
+  injector_size.fetch_add(1, std::memory_order_relaxed);
+}
+
+work_stealing_pool::task_node_t* work_stealing_pool::priority_class_t::pop_injector()
+{
+  if (injector_size.load(std::memory_order_relaxed) == 0) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if (injector.empty()) {
+    return nullptr;
+  }
+  task_node_t* t = injector.top();
+  injector.pop();
+  injector_size.fetch_sub(1, std::memory_order_relaxed);
+  return t;
+}
+
+work_stealing_pool::task_node_t* work_stealing_pool::priority_class_t::steal(const worker_t* thief, uint32_t& seed)
+{
+  // Steal the oldest task of another worker, starting from a pseudo-random victim
+  uint32_t nof_workers = (uint32_t)workers.size();
+  if (nof_workers == 0) {
+    return nullptr;
+  }
+  seed           = seed * 1103515245U + 12345U;
+  uint32_t start = (seed >> 16U) % nof_workers;
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    worker_t* victim = workers[(start + i) % nof_workers].get();
+    if (victim == thief) {
+      continue;
+    }
+    task_node_t* t = victim->deque.steal();
+    if (t != nullptr) {
+      return t;
+    }
+  }
+  return nullptr;
+}
+
+bool work_stealing_pool::priority_class_t::has_work() const
+{
+  if (injector_size.load(std::memory_order_relaxed) > 0) {
+    return true;
+  }
+  for (const std::unique_ptr<worker_t>& w : workers) {
+    if (not w->deque.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void work_stealing_pool::priority_class_t::wake_one()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  cvar.notify_one();
+}
+
+work_stealing_pool::worker_t::worker_t(work_stealing_pool& pool_,
+                                       priority_class_t&   cls_,
+                                       uint32_t            id_,
+                                       const std::string&  name,
+                                       uint32_t            deque_size_log) :
+  srsran::thread(name), pool(pool_), cls(cls_), deque(deque_size_log), id(id_), steal_seed(id_ + 1)
+{
+  // Do nothing
+}
+
+work_stealing_pool::task_node_t* work_stealing_pool::worker_t::find_task()
+{
+  // Own deque first, newest task first
+  task_node_t* t = deque.pop();
+  if (t != nullptr) {
+    return t;
+  }
+
+  // Then tasks pushed from outside the pool
+  t = cls.pop_injector();
+  if (t != nullptr) {
+    return t;
+  }
+
+  // Finally, steal from the other workers
+  return cls.steal(this, steal_seed);
+}
+
+void work_stealing_pool::worker_t::sleep()
+{
+  std::unique_lock<std::mutex> lock(cls.mutex);
+  cls.nof_sleeping.fetch_add(1, std::memory_order_relaxed);
+
+  // Pairs with the fence in push_node()
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (not cls.has_work() and pool.running.load(std::memory_order_relaxed)) {
+    cls.cvar.wait(lock);
+  }
+  cls.nof_sleeping.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void work_stealing_pool::worker_t::run_thread()
+{
+  current_worker = this;
+
+  uint32_t idle_count = 0;
+  while (pool.running.load(std::memory_order_relaxed)) {
+    task_node_t* t = find_task();
+    if (t != nullptr) {
+      idle_count = 0;
+      pool.run_task(t);
+      continue;
+    }
+
+    // Spin for a while before sleeping, waking up a thread is far slower than polling. Yield so that spinning does
+    // not starve the producers when there are more threads than cores
+    if (++idle_count < pool.spin_count) {
+      std::this_thread::yield();
+      continue;
+    }
+    idle_count = 0;
+    sleep();
+  }
+
+  // Hand the cached task nodes back before the thread exits
+  {
+    std::lock_guard<std::mutex> lock(pool.free_mutex);
+    while (free_cache != nullptr) {
+      task_node_t* returned = free_cache;
+      free_cache            = returned->next_free;
+      returned->next_free   = pool.free_list;
+      pool.free_list        = returned;
+    }
+    free_cache_size = 0;
+  }
+
+  current_worker = nullptr;
+}
+
+} // namespace srsran
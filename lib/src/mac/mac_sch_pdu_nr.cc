@@ -297,7 +297,6 @@ mac_sch_subpdu_nr::lcg_bsr_t mac_sch_subpdu_nr::get_sbsr() const
 mac_sch_subpdu_nr::lbsr_t mac_sch_subpdu_nr::get_lbsr() const
 {
   lbsr_t lbsr = {};
-  lbsr.list.reserve(mac_sch_subpdu_nr::max_num_lcg_lbsr);
 
   if (parent->is_ulsch() && (lcid == LONG_BSR || lcid == LONG_TRUNC_BSR)) {
     const uint8_t* ptr = sdu.ptr();
@@ -651,8 +651,8 @@ int mac_ul_sch_pdu_unpack_and_pack_test4()
   TESTASSERT(subpdu.get_lcid() == mac_sch_subpdu_nr::LONG_BSR);
   lbsr = subpdu.get_lbsr();
   TESTASSERT(lbsr.list.size() == 1);
-  TESTASSERT(lbsr.list.at(0).lcg_id == 7);
-  TESTASSERT(lbsr.list.at(0).buffer_size == 0xab);
+  TESTASSERT(lbsr.list[0].lcg_id == 7);
+  TESTASSERT(lbsr.list[0].buffer_size == 0xab);
 
   // 3nd TV
   pdu.init_rx(true);
@@ -666,10 +666,10 @@ int mac_ul_sch_pdu_unpack_and_pack_test4()
   TESTASSERT(subpdu.get_lcid() == mac_sch_subpdu_nr::LONG_BSR);
   lbsr = subpdu.get_lbsr();
   TESTASSERT(lbsr.list.size() == 2);
-  TESTASSERT(lbsr.list.at(0).lcg_id == 0);
-  TESTASSERT(lbsr.list.at(0).buffer_size == 0xab);
-  TESTASSERT(lbsr.list.at(1).lcg_id == 7);
-  TESTASSERT(lbsr.list.at(1).buffer_size == 0xcd);
+  TESTASSERT(lbsr.list[0].lcg_id == 0);
+  TESTASSERT(lbsr.list[0].buffer_size == 0xab);
+  TESTASSERT(lbsr.list[1].lcg_id == 7);
+  TESTASSERT(lbsr.list[1].buffer_size == 0xcd);
 
   return SRSRAN_SUCCESS;
 }
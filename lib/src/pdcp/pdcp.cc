@@ -58,7 +58,7 @@ void pdcp::reestablish()
 void pdcp::reestablish(uint32_t lcid)
 {
   if (valid_lcid(lcid)) {
-    pdcp_array.at(lcid)->reestablish();
+    pdcp_array[lcid]->reestablish();
   }
 }
 
@@ -75,7 +75,7 @@ void pdcp::reset()
 void pdcp::set_enabled(uint32_t lcid, bool enabled)
 {
   if (valid_lcid(lcid)) {
-    pdcp_array.at(lcid)->set_enabled(enabled);
+    pdcp_array[lcid]->set_enabled(enabled);
   } else {
     logger.warning("LCID %d doesn't exist while setting enabled", lcid);
   }
@@ -95,7 +95,7 @@ bool pdcp::is_lcid_enabled(uint32_t lcid)
 void pdcp::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu, int sn)
 {
   if (valid_lcid(lcid)) {
-    pdcp_array.at(lcid)->write_sdu(std::move(sdu), sn);
+    pdcp_array[lcid]->write_sdu(std::move(sdu), sn);
   } else {
     logger.warning("LCID %d doesn't exist. Deallocating SDU", lcid);
   }
@@ -104,12 +104,17 @@ void pdcp::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu, int sn)
 void pdcp::write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu)
 {
   if (valid_mch_lcid(lcid)) {
-    pdcp_array_mrb.at(lcid)->write_sdu(std::move(sdu));
+    pdcp_array_mrb[lcid]->write_sdu(std::move(sdu));
   }
 }
 
 int pdcp::add_bearer(uint32_t lcid, const pdcp_config_t& cfg)
 {
+  if (lcid >= SRSRAN_N_RADIO_BEARERS) {
+    logger.error("Can not add PDCP entity - invalid LCID %d", lcid);
+    return SRSRAN_ERROR;
+  }
+
   if (valid_lcid(lcid)) {
     return pdcp_array[lcid]->configure(cfg) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
   }
@@ -128,7 +133,7 @@ int pdcp::add_bearer(uint32_t lcid, const pdcp_config_t& cfg)
     return SRSRAN_ERROR;
   }
 
-  if (not pdcp_array.insert(std::make_pair(lcid, std::move(entity))).second) {
+  if (not pdcp_array.insert(lcid, std::move(entity)).has_value()) {
     logger.error("Error inserting PDCP entity in to array.");
     return SRSRAN_ERROR;
   }
@@ -149,15 +154,20 @@ int pdcp::add_bearer(uint32_t lcid, const pdcp_config_t& cfg)
 
 void pdcp::add_bearer_mrb(uint32_t lcid, const pdcp_config_t& cfg)
 {
+  if (lcid >= SRSRAN_N_MCH_LCIDS) {
+    logger.error("Can not add PDCP MRB entity - invalid LCID %d", lcid);
+    return;
+  }
+
   if (not valid_mch_lcid(lcid)) {
-    std::unique_ptr<pdcp_entity_lte> entity;
+    std::unique_ptr<pdcp_entity_base> entity;
     entity.reset(new pdcp_entity_lte{rlc, rrc, gw, task_sched, logger, lcid});
     if (not entity->configure(cfg)) {
       logger.error("Can not configure PDCP entity");
       return;
     }
 
-    if (not pdcp_array_mrb.insert(std::make_pair(lcid, std::move(entity))).second) {
+    if (not pdcp_array_mrb.insert(lcid, std::move(entity)).has_value()) {
       logger.error("Error inserting PDCP entity in to array.");
       return;
     }
@@ -185,12 +195,12 @@ void pdcp::del_bearer(uint32_t lcid)
 void pdcp::change_lcid(uint32_t old_lcid, uint32_t new_lcid)
 {
   // make sure old LCID exists and new LCID is still free
-  if (valid_lcid(old_lcid) && not valid_lcid(new_lcid)) {
+  if (valid_lcid(old_lcid) && new_lcid < SRSRAN_N_RADIO_BEARERS && not valid_lcid(new_lcid)) {
     // insert old PDCP entity into new LCID
     std::lock_guard<std::mutex>       lock(cache_mutex);
     auto                              it          = pdcp_array.find(old_lcid);
     std::unique_ptr<pdcp_entity_base> pdcp_entity = std::move(it->second);
-    if (not pdcp_array.insert(std::make_pair(new_lcid, std::move(pdcp_entity))).second) {
+    if (not pdcp_array.insert(new_lcid, std::move(pdcp_entity)).has_value()) {
       logger.error("Error inserting PDCP entity into array.");
       return;
     }
@@ -210,7 +220,7 @@ void pdcp::change_lcid(uint32_t old_lcid, uint32_t new_lcid)
 void pdcp::config_security(uint32_t lcid, const as_security_config_t& sec_cfg)
 {
   if (valid_lcid(lcid)) {
-    pdcp_array.at(lcid)->config_security(sec_cfg);
+    pdcp_array[lcid]->config_security(sec_cfg);
   }
 }
 
@@ -224,21 +234,21 @@ void pdcp::config_security_all(const as_security_config_t& sec_cfg)
 void pdcp::enable_integrity(uint32_t lcid, srsran_direction_t direction)
 {
   if (valid_lcid(lcid)) {
-    pdcp_array.at(lcid)->enable_integrity(direction);
+    pdcp_array[lcid]->enable_integrity(direction);
   }
 }
 
 void pdcp::enable_encryption(uint32_t lcid, srsran_direction_t direction)
 {
   if (valid_lcid(lcid)) {
-    pdcp_array.at(lcid)->enable_encryption(direction);
+    pdcp_array[lcid]->enable_encryption(direction);
   }
 }
 
 void pdcp::enable_security_timed(uint32_t lcid, srsran_direction_t direction, uint32_t sn)
 {
   if (valid_lcid(lcid)) {
-    pdcp_array.at(lcid)->enable_security_timed(direction, sn);
+    pdcp_array[lcid]->enable_security_timed(direction, sn);
   }
 }
 
@@ -252,7 +262,7 @@ void pdcp::send_status_report()
 void pdcp::send_status_report(uint32_t lcid)
 {
   if (valid_lcid(lcid)) {
-    pdcp_array.at(lcid)->send_status_report();
+    pdcp_array[lcid]->send_status_report();
   }
 }
 
@@ -288,7 +298,7 @@ std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp::get_buffered_pdus(uint32_
 void pdcp::write_pdu(uint32_t lcid, unique_byte_buffer_t pdu)
 {
   if (valid_lcid(lcid)) {
-    pdcp_array.at(lcid)->write_pdu(std::move(pdu));
+    pdcp_array[lcid]->write_pdu(std::move(pdu));
   } else {
     logger.warning("Dropping PDU, lcid=%d doesnt exists", lcid);
   }
@@ -321,7 +331,7 @@ void pdcp::write_pdu_mch(uint32_t lcid, unique_byte_buffer_t sdu)
 void pdcp::notify_delivery(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns)
 {
   if (valid_lcid(lcid)) {
-    pdcp_array.at(lcid)->notify_delivery(pdcp_sns);
+    pdcp_array[lcid]->notify_delivery(pdcp_sns);
   } else {
     logger.warning("Could not notify delivery: lcid=%d, nof_sn=%ld.", lcid, pdcp_sns.size());
   }
@@ -330,7 +340,7 @@ void pdcp::notify_delivery(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns)
 void pdcp::notify_failure(uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
   if (valid_lcid(lcid)) {
-    pdcp_array.at(lcid)->notify_failure(pdcp_sns);
+    pdcp_array[lcid]->notify_failure(pdcp_sns);
   } else {
     logger.warning("Could not notify failure: lcid=%d, nof_sn=%ld.", lcid, pdcp_sns.size());
   }
@@ -189,6 +189,7 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     enable_security_tx_sn = -1;
   }
 
+  metrics.num_tx_sdu_bytes += sdu->N_bytes;
   write_data_header(sdu, tx_count);
 
   // Append MAC (SRBs only)
@@ -363,6 +364,7 @@ void pdcp_entity_lte::handle_srb_pdu(srsran::unique_byte_buffer_t pdu)
   }
 
   // Pass to upper layers
+  metrics.num_rx_sdu_bytes += pdu->N_bytes;
   rrc->write_pdu(lcid, std::move(pdu));
 }
 
@@ -390,6 +392,7 @@ void pdcp_entity_lte::handle_um_drb_pdu(srsran::unique_byte_buffer_t pdu)
   }
 
   // Pass to upper layers
+  metrics.num_rx_sdu_bytes += pdu->N_bytes;
   gw->write_pdu(lcid, std::move(pdu));
 }
 
@@ -454,6 +457,7 @@ void pdcp_entity_lte::handle_am_drb_pdu(srsran::unique_byte_buffer_t pdu)
   update_rx_counts_queue(count);
 
   // Pass to upper layers
+  metrics.num_rx_sdu_bytes += pdu->N_bytes;
   gw->write_pdu(lcid, std::move(pdu));
 }
 
@@ -866,8 +870,10 @@ pdcp_bearer_metrics_t pdcp_entity_lte::get_metrics()
 
 void pdcp_entity_lte::reset_metrics()
 {
-  // Only reset metrics that have are snapshots, leave the incremental ones untouched.
+  // Only reset metrics that are snapshots or per report, leave the incremental ones untouched.
   metrics.tx_notification_latency_ms = 0;
+  metrics.num_tx_sdu_bytes           = 0;
+  metrics.num_rx_sdu_bytes           = 0;
 }
 
 /****************************************************************************
@@ -180,37 +180,224 @@ static uint32_t sequence_get_x2_init(uint32_t seed)
   return x2;
 }
 
-static void sequence_gen_LTE_pr(uint8_t* pr, uint32_t len, uint32_t seed)
+/**
+ * Steps the X1 sequence nbits at once (nbits must not exceed 28)
+ * @param state 32 bit current state
+ * @param nbits number of bits to step
+ * @return new 32 bit state
+ */
+static inline uint32_t sequence_step_x1(uint32_t state, uint32_t nbits)
 {
-  int      n  = 0;
-  uint32_t x1 = sequence_x1_init;           // X1 initial state is fix
-  uint32_t x2 = sequence_get_x2_init(seed); // loads x2 initial state
+  uint32_t f = state ^ (state >> 3U);
+  f          = (f & ((1U << nbits) - 1U)) << (SEQUENCE_SEED_LEN - nbits);
+  return (state >> nbits) ^ f;
+}
 
-  // Parallel stage
-  if (len >= SEQUENCE_PAR_BITS) {
-    for (; n < len - (SEQUENCE_PAR_BITS - 1); n += SEQUENCE_PAR_BITS) {
-      // XOR x1 and x2
-      uint32_t c = (uint32_t)(x1 ^ x2);
+/**
+ * Steps the X2 sequence nbits at once (nbits must not exceed 28)
+ * @param state 32 bit current state
+ * @param nbits number of bits to step
+ * @return new 32 bit state
+ */
+static inline uint32_t sequence_step_x2(uint32_t state, uint32_t nbits)
+{
+  uint32_t f = state ^ (state >> 1U) ^ (state >> 2U) ^ (state >> 3U);
+  f          = (f & ((1U << nbits) - 1U)) << (SEQUENCE_SEED_LEN - nbits);
+  return (state >> nbits) ^ f;
+}
 
-      // Save state
-      for (uint32_t i = 0; i < SEQUENCE_PAR_BITS; i++) {
-        pr[n + i] = (uint8_t)((c >> i) & 1U);
-      }
+/**
+ * Packed sequence generation
+ * --------------------------
+ *
+ * Squaring a polynomial over GF(2) spreads its taps, p(D)^2 = p(D^2). Squaring the x1 and x2 polynomials five times
+ * gives the recurrences:
+ *     x1(n + 992) = x1(n + 96) ^ x1(n)
+ *     x2(n + 992) = x2(n + 96) ^ x2(n + 64) ^ x2(n + 32) ^ x2(n)
+ *
+ * All taps are multiple of 8 bits and the closest one is 896 bits (112 bytes) behind. Once 992 bits of history are
+ * available, the following bits are produced by XOR-ing whole bytes, 512 bits at a time with AVX512 or 256 bits at a
+ * time with AVX2.
+ *
+ * The history itself is seeded with 256 bits from the state steps and completed with the recurrences of the polynomials
+ * squared three times, which only reach 248 bits (31 bytes) back:
+ *     x1(n + 248) = x1(n + 24) ^ x1(n)
+ *     x2(n + 248) = x2(n + 24) ^ x2(n + 16) ^ x2(n + 8) ^ x2(n)
+ *
+ * Seeding still costs about as much as generating 1000 bits with the state steps, so it only pays off for long
+ * sequences.
+ */
+#define SEQUENCE_SEED_BYTES (32U)
+#define SEQUENCE_HIST_BYTES (124U)
+#define SEQUENCE_BLOCK_WORDS (256U)
+#define SEQUENCE_FAST_MIN_WORDS (64U)
+
+static inline uint32_t sequence_load_u32(const uint8_t* ptr)
+{
+  return (uint32_t)ptr[0] | ((uint32_t)ptr[1] << 8U) | ((uint32_t)ptr[2] << 16U) | ((uint32_t)ptr[3] << 24U);
+}
+
+static void sequence_gen_hist_bytes(uint8_t* x1, uint8_t* x2)
+{
+  uint32_t i = SEQUENCE_SEED_BYTES;
+
+  // The closest tap is 28 bytes behind, 8 bytes can be produced at once
+  for (; i + 8 <= SEQUENCE_HIST_BYTES; i += 8) {
+    uint64_t a, b, c, d;
+    memcpy(&a, x1 + i - 31, 8);
+    memcpy(&b, x1 + i - 28, 8);
+    a ^= b;
+    memcpy(x1 + i, &a, 8);
+
+    memcpy(&a, x2 + i - 31, 8);
+    memcpy(&b, x2 + i - 30, 8);
+    memcpy(&c, x2 + i - 29, 8);
+    memcpy(&d, x2 + i - 28, 8);
+    a ^= b ^ c ^ d;
+    memcpy(x2 + i, &a, 8);
+  }
+
+  for (; i < SEQUENCE_HIST_BYTES; i++) {
+    x1[i] = x1[i - 31] ^ x1[i - 28];
+    x2[i] = x2[i - 31] ^ x2[i - 30] ^ x2[i - 29] ^ x2[i - 28];
+  }
+}
+
+static void sequence_gen_bytes(uint8_t* x1, uint8_t* x2, uint32_t start, uint32_t end)
+{
+  uint32_t i = start;
+
+#ifdef LV_HAVE_AVX512
+  for (; i + 64 <= end; i += 64) {
+    __m512i a = _mm512_loadu_si512((const void*)(x1 + i - 124));
+    __m512i b = _mm512_loadu_si512((const void*)(x1 + i - 112));
+    _mm512_storeu_si512((void*)(x1 + i), _mm512_xor_si512(a, b));
+
+    a = _mm512_xor_si512(_mm512_loadu_si512((const void*)(x2 + i - 124)),
+                         _mm512_loadu_si512((const void*)(x2 + i - 120)));
+    b = _mm512_xor_si512(_mm512_loadu_si512((const void*)(x2 + i - 116)),
+                         _mm512_loadu_si512((const void*)(x2 + i - 112)));
+    _mm512_storeu_si512((void*)(x2 + i), _mm512_xor_si512(a, b));
+  }
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX2
+  for (; i + 32 <= end; i += 32) {
+    __m256i a = _mm256_loadu_si256((const __m256i*)(x1 + i - 124));
+    __m256i b = _mm256_loadu_si256((const __m256i*)(x1 + i - 112));
+    _mm256_storeu_si256((__m256i*)(x1 + i), _mm256_xor_si256(a, b));
+
+    a = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(x2 + i - 124)),
+                         _mm256_loadu_si256((const __m256i*)(x2 + i - 120)));
+    b = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(x2 + i - 116)),
+                         _mm256_loadu_si256((const __m256i*)(x2 + i - 112)));
+    _mm256_storeu_si256((__m256i*)(x2 + i), _mm256_xor_si256(a, b));
+  }
+#endif /* LV_HAVE_AVX2 */
+
+  for (; i < end; i++) {
+    x1[i] = x1[i - 124] ^ x1[i - 112];
+    x2[i] = x2[i - 124] ^ x2[i - 120] ^ x2[i - 116] ^ x2[i - 112];
+  }
+}
+
+/**
+ * Generates nof_words packed words (bit n of word w is c(32w + n)) from the 16-fold recurrence, and advances the state
+ * by 32 * nof_words bits
+ */
+static void sequence_state_gen_words_fast(srsran_sequence_state_t* s, uint32_t* c, uint32_t nof_words)
+{
+  // History plus the generated words plus the 31 bits that make the next state
+  uint8_t x1[SEQUENCE_HIST_BYTES + SEQUENCE_BLOCK_WORDS * 4 + 4];
+  uint8_t x2[SEQUENCE_HIST_BYTES + SEQUENCE_BLOCK_WORDS * 4 + 4];
+
+  // Seed the history with the next 992 bits of each register
+  for (uint32_t i = 0; i < SEQUENCE_SEED_BYTES; i += 2) {
+    x1[i]     = (uint8_t)(s->x1 & 0xffU);
+    x1[i + 1] = (uint8_t)((s->x1 >> 8U) & 0xffU);
+    x2[i]     = (uint8_t)(s->x2 & 0xffU);
+    x2[i + 1] = (uint8_t)((s->x2 >> 8U) & 0xffU);
+    s->x1     = sequence_step_x1(s->x1, 16);
+    s->x2     = sequence_step_x2(s->x2, 16);
+  }
+  sequence_gen_hist_bytes(x1, x2);
+
+  uint32_t nof_bytes = nof_words * 4;
+  sequence_gen_bytes(x1, x2, SEQUENCE_HIST_BYTES, nof_bytes + 4);
+
+  for (uint32_t w = 0; w < nof_words; w++) {
+    c[w] = sequence_load_u32(&x1[4 * w]) ^ sequence_load_u32(&x2[4 * w]);
+  }
+
+  s->x1 = sequence_load_u32(&x1[nof_bytes]) & (uint32_t)INT32_MAX;
+  s->x2 = sequence_load_u32(&x2[nof_bytes]) & (uint32_t)INT32_MAX;
+}
+
+/**
+ * Advances the state by up to 31 bits
+ */
+static inline void sequence_state_step(srsran_sequence_state_t* s, uint32_t nbits)
+{
+  if (nbits > SEQUENCE_PAR_BITS) {
+    s->x1 = sequence_gen_LTE_pr_memless_step_par_x1(s->x1);
+    s->x2 = sequence_gen_LTE_pr_memless_step_par_x2(s->x2);
+    nbits -= SEQUENCE_PAR_BITS;
+  }
+  if (nbits > 0) {
+    s->x1 = sequence_step_x1(s->x1, nbits);
+    s->x2 = sequence_step_x2(s->x2, nbits);
+  }
+}
 
-      // Parallel step
-      x1 = sequence_gen_LTE_pr_memless_step_par_x1(x1);
-      x2 = sequence_gen_LTE_pr_memless_step_par_x2(x2);
+/**
+ * Generates the packed words covering the next nof_bits bits, up to SEQUENCE_BLOCK_WORDS words, and advances the state
+ * by the number of bits covered. The last word is partial when nof_bits is not a multiple of 32.
+ * @return the number of generated words
+ */
+static uint32_t sequence_state_gen_words(srsran_sequence_state_t* s, uint32_t* c, uint32_t nof_bits)
+{
+  uint32_t nof_words = SRSRAN_MIN(nof_bits / 32, SEQUENCE_BLOCK_WORDS);
+
+  if (nof_words >= SEQUENCE_FAST_MIN_WORDS) {
+    sequence_state_gen_words_fast(s, c, nof_words);
+  } else {
+    for (uint32_t w = 0; w < nof_words; w++) {
+      uint32_t lsb = (s->x1 ^ s->x2) & 0xffffU;
+      s->x1        = sequence_step_x1(s->x1, 16);
+      s->x2        = sequence_step_x2(s->x2, 16);
+      uint32_t msb = (s->x1 ^ s->x2) & 0xffffU;
+      s->x1        = sequence_step_x1(s->x1, 16);
+      s->x2        = sequence_step_x2(s->x2, 16);
+      c[w]         = lsb | (msb << 16U);
     }
   }
 
-  // Single step
-  for (; n < len; n++) {
-    // Save current state
-    pr[n] = (uint8_t)((x1 ^ x2) & 1U);
+  // The state holds the next 31 bits, enough for the partial word
+  uint32_t rem = nof_bits - nof_words * 32;
+  if (nof_words < SEQUENCE_BLOCK_WORDS && rem > 0) {
+    c[nof_words++] = s->x1 ^ s->x2;
+    sequence_state_step(s, rem);
+  }
+
+  return nof_words;
+}
+
+static void sequence_gen_LTE_pr(uint8_t* pr, uint32_t len, uint32_t seed)
+{
+  srsran_sequence_state_t s = {};
+  srsran_sequence_state_init(&s, seed);
 
-    // Single step
-    x1 = sequence_gen_LTE_pr_memless_step_x1(x1);
-    x2 = sequence_gen_LTE_pr_memless_step_x2(x2);
+  uint32_t c[SEQUENCE_BLOCK_WORDS];
+  uint32_t i = 0;
+  while (i < len) {
+    uint32_t nof_words = sequence_state_gen_words(&s, c, len - i);
+    for (uint32_t w = 0; w < nof_words; w++) {
+      uint32_t n = SRSRAN_MIN(32, len - i);
+      for (uint32_t j = 0; j < n; j++) {
+        pr[i + j] = (uint8_t)((c[w] >> j) & 1U);
+      }
+      i += n;
+    }
   }
 }
 
@@ -228,107 +415,370 @@ void srsran_sequence_state_init(srsran_sequence_state_t* s, uint32_t seed)
     memcpy(&(DST), &temp_u32, 4);                                                                                      \
   } while (false)
 
-void srsran_sequence_state_gen_f(srsran_sequence_state_t* s, float value, float* out, uint32_t length)
+/*
+ * Word kernels: apply the n (up to 32) sequence bits held in c to n consecutive elements
+ */
+static inline void sequence_word_gen_f(uint32_t c, float value, float* out, uint32_t n)
 {
-  uint32_t i = 0;
+  uint32_t j = 0;
+#ifdef LV_HAVE_AVX2
+  for (; j + 8 <= n; j += 8) {
+    // Moves each of the 8 bits of interest to the sign
+    __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(c >> j), _mm256_setr_epi32(31, 30, 29, 28, 27, 26, 25, 24));
+    mask         = _mm256_and_si256(mask, _mm256_set1_epi32(0x80000000));
+
+    _mm256_storeu_ps(out + j, _mm256_xor_ps(_mm256_castsi256_ps(mask), _mm256_set1_ps(value)));
+  }
+#endif /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  for (; j + 4 <= n; j += 4) {
+    // Preloads bits of interest in the 4 LSB
+    __m128i mask = _mm_set1_epi32(c >> j);
 
-  if (length >= SEQUENCE_PAR_BITS) {
-    for (; i < length - (SEQUENCE_PAR_BITS - 1); i += SEQUENCE_PAR_BITS) {
-      uint32_t c = (uint32_t)(s->x1 ^ s->x2);
+    // Masks each bit
+    mask = _mm_and_si128(mask, _mm_setr_epi32(1, 2, 4, 8));
+
+    // Get non zero mask
+    mask = _mm_cmpgt_epi32(mask, _mm_set1_epi32(0));
 
-      uint32_t j = 0;
+    // And with MSB
+    mask = _mm_and_si128(mask, (__m128i)_mm_set1_ps(-0.0F));
+
+    // Load input
+    __m128 v = _mm_set1_ps(value);
+
+    // Loads input and perform sign XOR
+    v = _mm_xor_ps((__m128)mask, v);
+
+    _mm_storeu_ps(out + j, v);
+  }
+#endif /* LV_HAVE_SSE */
+  for (; j < n; j++) {
+    FLOAT_U32_XOR(out[j], value, (c << (31U - j)) & 0x80000000);
+  }
+}
+
+static inline void sequence_word_apply_f(uint32_t c, const float* in, float* out, uint32_t n)
+{
+  uint32_t j = 0;
+#ifdef LV_HAVE_AVX2
+  for (; j + 8 <= n; j += 8) {
+    // Moves each of the 8 bits of interest to the sign
+    __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(c >> j), _mm256_setr_epi32(31, 30, 29, 28, 27, 26, 25, 24));
+    mask         = _mm256_and_si256(mask, _mm256_set1_epi32(0x80000000));
+
+    _mm256_storeu_ps(out + j, _mm256_xor_ps(_mm256_castsi256_ps(mask), _mm256_loadu_ps(in + j)));
+  }
+#endif /* LV_HAVE_AVX2 */
 #ifdef LV_HAVE_SSE
-      for (; j < SEQUENCE_PAR_BITS - 3; j += 4) {
-        // Preloads bits of interest in the 4 LSB
-        __m128i mask = _mm_set1_epi32(c >> j);
+  for (; j + 4 <= n; j += 4) {
+    // Preloads bits of interest in the 4 LSB
+    __m128i mask = _mm_set1_epi32(c >> j);
 
-        // Masks each bit
-        mask = _mm_and_si128(mask, _mm_setr_epi32(1, 2, 4, 8));
+    // Masks each bit
+    mask = _mm_and_si128(mask, _mm_setr_epi32(1, 2, 4, 8));
 
-        // Get non zero mask
-        mask = _mm_cmpgt_epi32(mask, _mm_set1_epi32(0));
+    // Get non zero mask
+    mask = _mm_cmpgt_epi32(mask, _mm_set1_epi32(0));
 
-        // And with MSB
-        mask = _mm_and_si128(mask, (__m128i)_mm_set1_ps(-0.0F));
+    // And with MSB
+    mask = _mm_and_si128(mask, (__m128i)_mm_set1_ps(-0.0F));
 
-        // Load input
-        __m128 v = _mm_set1_ps(value);
+    // Load input
+    __m128 v = _mm_loadu_ps(in + j);
 
-        // Loads input and perform sign XOR
-        v = _mm_xor_ps((__m128)mask, v);
+    // Loads input and perform sign XOR
+    v = _mm_xor_ps((__m128)mask, v);
 
-        _mm_storeu_ps(out + i + j, v);
-      }
-#endif
-      // Finish the parallel bits with generic code
-      for (; j < SEQUENCE_PAR_BITS; j++) {
-        FLOAT_U32_XOR(out[i + j], value, (c << (31U - j)) & 0x80000000);
-      }
+    _mm_storeu_ps(out + j, v);
+  }
+#endif /* LV_HAVE_SSE */
+  for (; j < n; j++) {
+    FLOAT_U32_XOR(out[j], in[j], (c << (31U - j)) & 0x80000000);
+  }
+}
 
-      // Step sequences
-      s->x1 = sequence_gen_LTE_pr_memless_step_par_x1(s->x1);
-      s->x2 = sequence_gen_LTE_pr_memless_step_par_x2(s->x2);
-    }
+static inline void sequence_word_apply_s(uint32_t c, const int16_t* in, int16_t* out, uint32_t n)
+{
+  uint32_t j = 0;
+#ifdef LV_HAVE_AVX2
+  for (; j + 16 <= n; j += 16) {
+    // Get the mask of the 16 bits of interest
+    const __m256i bits = _mm256_setr_epi16(0x0001,
+                                           0x0002,
+                                           0x0004,
+                                           0x0008,
+                                           0x0010,
+                                           0x0020,
+                                           0x0040,
+                                           0x0080,
+                                           0x0100,
+                                           0x0200,
+                                           0x0400,
+                                           0x0800,
+                                           0x1000,
+                                           0x2000,
+                                           0x4000,
+                                           (short)0x8000);
+    __m256i       mask = _mm256_cmpeq_epi16(_mm256_and_si256(_mm256_set1_epi16((short)(c >> j)), bits), bits);
+
+    // Negate where the mask is set, (v ^ -1) - (-1) = -v
+    __m256i v = _mm256_loadu_si256((const __m256i*)(in + j));
+    v         = _mm256_sub_epi16(_mm256_xor_si256(v, mask), mask);
+
+    _mm256_storeu_si256((__m256i*)(out + j), v);
   }
+#endif /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  for (; j + 8 <= n; j += 8) {
+    // Preloads bits of interest in the 8 LSB
+    __m128i mask = _mm_set1_epi16((c >> j) & 0xff);
 
-  for (; i < length; i++) {
-    FLOAT_U32_XOR(out[i], value, (s->x1 ^ s->x2) << 31U);
+    // Masks each bit
+    mask = _mm_and_si128(mask, _mm_setr_epi16(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80));
 
-    // Step sequences
-    s->x1 = sequence_gen_LTE_pr_memless_step_x1(s->x1);
-    s->x2 = sequence_gen_LTE_pr_memless_step_x2(s->x2);
+    // Get non zero mask
+    mask = _mm_cmpgt_epi16(mask, _mm_set1_epi16(0));
+
+    // Load input
+    __m128i v = _mm_loadu_si128((__m128i*)(in + j));
+
+    // Negate
+    v = _mm_xor_si128(v, mask);
+
+    // Add one
+    mask = _mm_and_si128(mask, _mm_set1_epi16(1));
+    v    = _mm_add_epi16(v, mask);
+
+    _mm_storeu_si128((__m128i*)(out + j), v);
+  }
+#endif /* LV_HAVE_SSE */
+  for (; j < n; j++) {
+    out[j] = ((c >> j) & 1U) ? -in[j] : in[j];
   }
 }
 
-void srsran_sequence_state_apply_f(srsran_sequence_state_t* s, const float* in, float* out, uint32_t length)
+#ifdef LV_HAVE_SSE
+/**
+ * Expands the 16 bits of c starting at bit j into a byte mask, 0xff where the bit is set
+ */
+static inline __m128i sequence_word_mask_epi8(uint32_t c, uint32_t j)
 {
-  uint32_t i = 0;
+  // Preloads bits of interest in the 16 LSB
+  __m128i mask = _mm_set1_epi32(c >> j);
+  mask         = _mm_shuffle_epi8(mask, _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1));
 
-  if (length >= SEQUENCE_PAR_BITS) {
-    for (; i < length - (SEQUENCE_PAR_BITS - 1); i += SEQUENCE_PAR_BITS) {
-      uint32_t c = (uint32_t)(s->x1 ^ s->x2);
+  // Masks each bit
+  mask = _mm_and_si128(mask, _mm_set_epi64x(0x8040201008040201, 0x8040201008040201));
+
+  // Get non zero mask
+  return _mm_cmpeq_epi8(mask, _mm_set_epi64x(0x8040201008040201, 0x8040201008040201));
+}
+#endif /* LV_HAVE_SSE */
 
-      uint32_t j = 0;
+static inline void sequence_word_apply_c(uint32_t c, const int8_t* in, int8_t* out, uint32_t n)
+{
+  uint32_t j = 0;
 #ifdef LV_HAVE_SSE
-      for (; j < SEQUENCE_PAR_BITS - 3; j += 4) {
-        // Preloads bits of interest in the 4 LSB
-        __m128i mask = _mm_set1_epi32(c >> j);
+  for (; j + 16 <= n; j += 16) {
+    __m128i mask = sequence_word_mask_epi8(c, j);
 
-        // Masks each bit
-        mask = _mm_and_si128(mask, _mm_setr_epi32(1, 2, 4, 8));
+    // Load input
+    __m128i v = _mm_loadu_si128((__m128i*)(in + j));
 
-        // Get non zero mask
-        mask = _mm_cmpgt_epi32(mask, _mm_set1_epi32(0));
+    // Negate
+    v = _mm_xor_si128(mask, v);
 
-        // And with MSB
-        mask = _mm_and_si128(mask, (__m128i)_mm_set1_ps(-0.0F));
+    // Add one
+    mask = _mm_and_si128(mask, _mm_set1_epi8(1));
+    v    = _mm_add_epi8(v, mask);
 
-        // Load input
-        __m128 v = _mm_loadu_ps(in + i + j);
+    _mm_storeu_si128((__m128i*)(out + j), v);
+  }
+#endif /* LV_HAVE_SSE */
+  for (; j < n; j++) {
+    out[j] = ((c >> j) & 1U) ? -in[j] : in[j];
+  }
+}
 
-        // Loads input and perform sign XOR
-        v = _mm_xor_ps((__m128)mask, v);
+static inline void sequence_word_apply_bit(uint32_t c, const uint8_t* in, uint8_t* out, uint32_t n)
+{
+  uint32_t j = 0;
+#ifdef LV_HAVE_SSE
+  for (; j + 16 <= n; j += 16) {
+    // Reduce to 1s and 0s
+    __m128i mask = _mm_and_si128(sequence_word_mask_epi8(c, j), _mm_set1_epi8(1));
 
-        _mm_storeu_ps(out + i + j, v);
-      }
-#endif // LV_HAVE_SSE
-      // Finish the parallel bits with generic code
-      for (; j < SEQUENCE_PAR_BITS; j++) {
-        FLOAT_U32_XOR(out[i + j], in[i + j], (c << (31U - j)) & 0x80000000);
-      }
+    // Load input
+    __m128i v = _mm_loadu_si128((__m128i*)(in + j));
 
-      // Step sequences
-      s->x1 = sequence_gen_LTE_pr_memless_step_par_x1(s->x1);
-      s->x2 = sequence_gen_LTE_pr_memless_step_par_x2(s->x2);
-    }
+    // Apply XOR
+    v = _mm_xor_si128(mask, v);
+
+    _mm_storeu_si128((__m128i*)(out + j), v);
   }
+#endif /* LV_HAVE_SSE */
+  for (; j < n; j++) {
+    out[j] = in[j] ^ ((c >> j) & 1U);
+  }
+}
 
-  for (; i < length; i++) {
-    FLOAT_U32_XOR(out[i], in[i], (s->x1 ^ s->x2) << 31U);
+static const uint8_t sequence_reverse_lut[256] = {
+    0b00000000, 0b10000000, 0b01000000, 0b11000000, 0b00100000, 0b10100000, 0b01100000, 0b11100000, 0b00010000,
+    0b10010000, 0b01010000, 0b11010000, 0b00110000, 0b10110000, 0b01110000, 0b11110000, 0b00001000, 0b10001000,
+    0b01001000, 0b11001000, 0b00101000, 0b10101000, 0b01101000, 0b11101000, 0b00011000, 0b10011000, 0b01011000,
+    0b11011000, 0b00111000, 0b10111000, 0b01111000, 0b11111000, 0b00000100, 0b10000100, 0b01000100, 0b11000100,
+    0b00100100, 0b10100100, 0b01100100, 0b11100100, 0b00010100, 0b10010100, 0b01010100, 0b11010100, 0b00110100,
+    0b10110100, 0b01110100, 0b11110100, 0b00001100, 0b10001100, 0b01001100, 0b11001100, 0b00101100, 0b10101100,
+    0b01101100, 0b11101100, 0b00011100, 0b10011100, 0b01011100, 0b11011100, 0b00111100, 0b10111100, 0b01111100,
+    0b11111100, 0b00000010, 0b10000010, 0b01000010, 0b11000010, 0b00100010, 0b10100010, 0b01100010, 0b11100010,
+    0b00010010, 0b10010010, 0b01010010, 0b11010010, 0b00110010, 0b10110010, 0b01110010, 0b11110010, 0b00001010,
+    0b10001010, 0b01001010, 0b11001010, 0b00101010, 0b10101010, 0b01101010, 0b11101010, 0b00011010, 0b10011010,
+    0b01011010, 0b11011010, 0b00111010, 0b10111010, 0b01111010, 0b11111010, 0b00000110, 0b10000110, 0b01000110,
+    0b11000110, 0b00100110, 0b10100110, 0b01100110, 0b11100110, 0b00010110, 0b10010110, 0b01010110, 0b11010110,
+    0b00110110, 0b10110110, 0b01110110, 0b11110110, 0b00001110, 0b10001110, 0b01001110, 0b11001110, 0b00101110,
+    0b10101110, 0b01101110, 0b11101110, 0b00011110, 0b10011110, 0b01011110, 0b11011110, 0b00111110, 0b10111110,
+    0b01111110, 0b11111110, 0b00000001, 0b10000001, 0b01000001, 0b11000001, 0b00100001, 0b10100001, 0b01100001,
+    0b11100001, 0b00010001, 0b10010001, 0b01010001, 0b11010001, 0b00110001, 0b10110001, 0b01110001, 0b11110001,
+    0b00001001, 0b10001001, 0b01001001, 0b11001001, 0b00101001, 0b10101001, 0b01101001, 0b11101001, 0b00011001,
+    0b10011001, 0b01011001, 0b11011001, 0b00111001, 0b10111001, 0b01111001, 0b11111001, 0b00000101, 0b10000101,
+    0b01000101, 0b11000101, 0b00100101, 0b10100101, 0b01100101, 0b11100101, 0b00010101, 0b10010101, 0b01010101,
+    0b11010101, 0b00110101, 0b10110101, 0b01110101, 0b11110101, 0b00001101, 0b10001101, 0b01001101, 0b11001101,
+    0b00101101, 0b10101101, 0b01101101, 0b11101101, 0b00011101, 0b10011101, 0b01011101, 0b11011101, 0b00111101,
+    0b10111101, 0b01111101, 0b11111101, 0b00000011, 0b10000011, 0b01000011, 0b11000011, 0b00100011, 0b10100011,
+    0b01100011, 0b11100011, 0b00010011, 0b10010011, 0b01010011, 0b11010011, 0b00110011, 0b10110011, 0b01110011,
+    0b11110011, 0b00001011, 0b10001011, 0b01001011, 0b11001011, 0b00101011, 0b10101011, 0b01101011, 0b11101011,
+    0b00011011, 0b10011011, 0b01011011, 0b11011011, 0b00111011, 0b10111011, 0b01111011, 0b11111011, 0b00000111,
+    0b10000111, 0b01000111, 0b11000111, 0b00100111, 0b10100111, 0b01100111, 0b11100111, 0b00010111, 0b10010111,
+    0b01010111, 0b11010111, 0b00110111, 0b10110111, 0b01110111, 0b11110111, 0b00001111, 0b10001111, 0b01001111,
+    0b11001111, 0b00101111, 0b10101111, 0b01101111, 0b11101111, 0b00011111, 0b10011111, 0b01011111, 0b11011111,
+    0b00111111, 0b10111111, 0b01111111, 0b11111111,
+};
 
-    // Step sequences
-    s->x1 = sequence_gen_LTE_pr_memless_step_x1(s->x1);
-    s->x2 = sequence_gen_LTE_pr_memless_step_x2(s->x2);
+/**
+ * Applies the n (up to 32) bits held in c to packed (MSB first) bytes. A trailing partial byte only has its leading
+ * bits modified
+ */
+static inline void sequence_word_apply_packed(uint32_t c, const uint8_t* in, uint8_t* out, uint32_t n)
+{
+  uint32_t k = 0;
+  for (; k < n / 8; k++) {
+    out[k] = in[k] ^ sequence_reverse_lut[(c >> (8U * k)) & 255U];
+  }
+  uint32_t rem8 = n % 8;
+  if (rem8 != 0) {
+    out[k] = in[k] ^ sequence_reverse_lut[(c >> (8U * k)) & ((1U << rem8) - 1U) & 255U];
+  }
+}
+
+/*
+ * Block kernels: apply length sequence bits held in the packed words c. Full words go through the kernels with a
+ * constant size so that the inner loops are unrolled
+ */
+static void sequence_words_gen_f(const uint32_t* c, float value, float* out, uint32_t length)
+{
+  uint32_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    sequence_word_gen_f(c[i / 32], value, out + i, 32);
+  }
+  if (i < length) {
+    sequence_word_gen_f(c[i / 32], value, out + i, length - i);
+  }
+}
+
+static void sequence_words_apply_f(const uint32_t* c, const float* in, float* out, uint32_t length)
+{
+  uint32_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    sequence_word_apply_f(c[i / 32], in + i, out + i, 32);
+  }
+  if (i < length) {
+    sequence_word_apply_f(c[i / 32], in + i, out + i, length - i);
+  }
+}
+
+static void sequence_words_apply_s(const uint32_t* c, const int16_t* in, int16_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    sequence_word_apply_s(c[i / 32], in + i, out + i, 32);
+  }
+  if (i < length) {
+    sequence_word_apply_s(c[i / 32], in + i, out + i, length - i);
+  }
+}
+
+static void sequence_words_apply_c(const uint32_t* c, const int8_t* in, int8_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    sequence_word_apply_c(c[i / 32], in + i, out + i, 32);
+  }
+  if (i < length) {
+    sequence_word_apply_c(c[i / 32], in + i, out + i, length - i);
+  }
+}
+
+static void sequence_words_apply_bit(const uint32_t* c, const uint8_t* in, uint8_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    sequence_word_apply_bit(c[i / 32], in + i, out + i, 32);
+  }
+  if (i < length) {
+    sequence_word_apply_bit(c[i / 32], in + i, out + i, length - i);
+  }
+}
+
+static void sequence_words_apply_packed(const uint32_t* c, const uint8_t* in, uint8_t* out, uint32_t length)
+{
+  uint32_t i = 0;
+#ifdef LV_HAVE_SSE
+  // In little endian the words are the sequence bytes in order, LSB first. Reverse 16 of them at once by nibbles
+  const uint8_t* c_bytes = (const uint8_t*)c;
+  const __m128i  rev_lut = _mm_setr_epi8(0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf);
+  const __m128i  nibble  = _mm_set1_epi8(0x0f);
+  for (; i + 128 <= length; i += 128) {
+    __m128i v  = _mm_loadu_si128((const __m128i*)(c_bytes + i / 8));
+    __m128i lo = _mm_shuffle_epi8(rev_lut, _mm_and_si128(v, nibble));
+    __m128i hi = _mm_shuffle_epi8(rev_lut, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+    v          = _mm_or_si128(_mm_slli_epi16(lo, 4), hi);
+
+    // Apply XOR
+    v = _mm_xor_si128(v, _mm_loadu_si128((const __m128i*)(in + i / 8)));
+
+    _mm_storeu_si128((__m128i*)(out + i / 8), v);
+  }
+#endif /* LV_HAVE_SSE */
+  for (; i + 32 <= length; i += 32) {
+    sequence_word_apply_packed(c[i / 32], in + i / 8, out + i / 8, 32);
+  }
+  if (i < length) {
+    sequence_word_apply_packed(c[i / 32], in + i / 8, out + i / 8, length - i);
+  }
+}
+
+void srsran_sequence_state_gen_f(srsran_sequence_state_t* s, float value, float* out, uint32_t length)
+{
+  uint32_t c[SEQUENCE_BLOCK_WORDS];
+  uint32_t i = 0;
+  while (i < length) {
+    uint32_t nof_words = sequence_state_gen_words(s, c, length - i);
+    uint32_t n         = SRSRAN_MIN(nof_words * 32, length - i);
+    sequence_words_gen_f(c, value, out + i, n);
+    i += n;
+  }
+}
+
+void srsran_sequence_state_apply_f(srsran_sequence_state_t* s, const float* in, float* out, uint32_t length)
+{
+  uint32_t c[SEQUENCE_BLOCK_WORDS];
+  uint32_t i = 0;
+  while (i < length) {
+    uint32_t nof_words = sequence_state_gen_words(s, c, length - i);
+    uint32_t n         = SRSRAN_MIN(nof_words * 32, length - i);
+    sequence_words_apply_f(c, in + i, out + i, n);
+    i += n;
   }
 }
 
@@ -506,114 +956,28 @@ void srsran_sequence_apply_f(const float* in, float* out, uint32_t length, uint3
 
 void srsran_sequence_apply_s(const int16_t* in, int16_t* out, uint32_t length, uint32_t seed)
 {
-  const int16_t s[2] = {+1, -1};
-  uint32_t      x1   = sequence_x1_init;           // X1 initial state is fix
-  uint32_t      x2   = sequence_get_x2_init(seed); // loads x2 initial state
+  srsran_sequence_state_t s = {};
+  srsran_sequence_state_init(&s, seed);
 
+  uint32_t c[SEQUENCE_BLOCK_WORDS];
   uint32_t i = 0;
-
-  if (length >= SEQUENCE_PAR_BITS) {
-    for (; i < length - (SEQUENCE_PAR_BITS - 1); i += SEQUENCE_PAR_BITS) {
-      uint32_t c = (uint32_t)(x1 ^ x2);
-
-      uint32_t j = 0;
-#ifdef LV_HAVE_SSE
-      for (; j < SEQUENCE_PAR_BITS - 7; j += 8) {
-        // Preloads bits of interest in the 8 LSB
-        __m128i mask = _mm_set1_epi16((c >> j) & 0xff);
-
-        // Masks each bit
-        mask = _mm_and_si128(mask, _mm_setr_epi16(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80));
-
-        // Get non zero mask
-        mask = _mm_cmpgt_epi16(mask, _mm_set1_epi16(0));
-
-        // Load input
-        __m128i v = _mm_loadu_si128((__m128i*)(in + i + j));
-
-        // Negate
-        v = _mm_xor_si128(v, mask);
-
-        // Add one
-        mask = _mm_and_si128(mask, _mm_set1_epi16(1));
-        v    = _mm_add_epi16(v, mask);
-
-        _mm_storeu_si128((__m128i*)(out + i + j), v);
-      }
-#endif // LV_HAVE_SSE
-      for (; j < SEQUENCE_PAR_BITS; j++) {
-        out[i + j] = in[i + j] * s[(c >> j) & 1U];
-      }
-
-      // Step sequences
-      x1 = sequence_gen_LTE_pr_memless_step_par_x1(x1);
-      x2 = sequence_gen_LTE_pr_memless_step_par_x2(x2);
-    }
-  }
-
-  for (; i < length; i++) {
-    out[i] = in[i] * s[(x1 ^ x2) & 1U];
-
-    // Step sequences
-    x1 = sequence_gen_LTE_pr_memless_step_x1(x1);
-    x2 = sequence_gen_LTE_pr_memless_step_x2(x2);
+  while (i < length) {
+    uint32_t nof_words = sequence_state_gen_words(&s, c, length - i);
+    uint32_t n         = SRSRAN_MIN(nof_words * 32, length - i);
+    sequence_words_apply_s(c, in + i, out + i, n);
+    i += n;
   }
 }
 
 void srsran_sequence_state_apply_c(srsran_sequence_state_t* s, const int8_t* in, int8_t* out, uint32_t length)
 {
+  uint32_t c[SEQUENCE_BLOCK_WORDS];
   uint32_t i = 0;
-
-  if (length >= SEQUENCE_PAR_BITS) {
-    for (; i < length - (SEQUENCE_PAR_BITS - 1); i += SEQUENCE_PAR_BITS) {
-      uint32_t c = (uint32_t)(s->x1 ^ s->x2);
-
-      uint32_t j = 0;
-#ifdef LV_HAVE_SSE
-      if (SEQUENCE_PAR_BITS >= 16) {
-        // Preloads bits of interest in the 16 LSB
-        __m128i mask = _mm_set1_epi32(c);
-        mask         = _mm_shuffle_epi8(mask, _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1));
-
-        // Masks each bit
-        // mask = _mm_and_si128( mask, _mm_set_epi64x(0x0102040810204080, 0x0102040810204080));
-        mask = _mm_and_si128(mask, _mm_set_epi64x(0x8040201008040201, 0x8040201008040201));
-
-        // Get non zero mask
-        mask = _mm_cmpeq_epi8(mask, _mm_set_epi64x(0x8040201008040201, 0x8040201008040201));
-
-        // Load input
-        __m128i v = _mm_loadu_si128((__m128i*)(in + i + j));
-
-        // Negate
-        v = _mm_xor_si128(mask, v);
-
-        // Add one
-        mask = _mm_and_si128(mask, _mm_set1_epi8(1));
-        v    = _mm_add_epi8(v, mask);
-
-        _mm_storeu_si128((__m128i*)(out + i + j), v);
-
-        // Increment bit counter `j`
-        j += 16;
-      }
-#endif
-      for (; j < SEQUENCE_PAR_BITS; j++) {
-        out[i + j] = in[i + j] * (((c >> j) & 1U) ? -1 : +1);
-      }
-
-      // Step sequences
-      s->x1 = sequence_gen_LTE_pr_memless_step_par_x1(s->x1);
-      s->x2 = sequence_gen_LTE_pr_memless_step_par_x2(s->x2);
-    }
-  }
-
-  for (; i < length; i++) {
-    out[i] = in[i] * (((s->x1 ^ s->x2) & 1U) ? -1 : +1);
-
-    // Step sequences
-    s->x1 = sequence_gen_LTE_pr_memless_step_x1(s->x1);
-    s->x2 = sequence_gen_LTE_pr_memless_step_x2(s->x2);
+  while (i < length) {
+    uint32_t nof_words = sequence_state_gen_words(s, c, length - i);
+    uint32_t n         = SRSRAN_MIN(nof_words * 32, length - i);
+    sequence_words_apply_c(c, in + i, out + i, n);
+    i += n;
   }
 }
 
@@ -626,57 +990,13 @@ void srsran_sequence_apply_c(const int8_t* in, int8_t* out, uint32_t length, uin
 
 void srsran_sequence_state_apply_bit(srsran_sequence_state_t* s, const uint8_t* in, uint8_t* out, uint32_t length)
 {
+  uint32_t c[SEQUENCE_BLOCK_WORDS];
   uint32_t i = 0;
-
-  if (length >= SEQUENCE_PAR_BITS) {
-    for (; i < length - (SEQUENCE_PAR_BITS - 1); i += SEQUENCE_PAR_BITS) {
-      uint32_t c = (uint32_t)(s->x1 ^ s->x2);
-
-      uint32_t j = 0;
-#ifdef LV_HAVE_SSE
-      if (SEQUENCE_PAR_BITS >= 16) {
-        // Preloads bits of interest in the 16 LSB
-        __m128i mask = _mm_set1_epi32(c);
-        mask         = _mm_shuffle_epi8(mask, _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1));
-
-        // Masks each bit
-        // mask = _mm_and_si128( mask, _mm_set_epi64x(0x0102040810204080, 0x0102040810204080));
-        mask = _mm_and_si128(mask, _mm_set_epi64x(0x8040201008040201, 0x8040201008040201));
-
-        // Get non zero mask
-        mask = _mm_cmpeq_epi8(mask, _mm_set_epi64x(0x8040201008040201, 0x8040201008040201));
-
-        // Reduce to 1s and 0s
-        mask = _mm_and_si128(mask, _mm_set1_epi8(1));
-
-        // Load input
-        __m128i v = _mm_loadu_si128((__m128i*)(in + i + j));
-
-        // Apply XOR
-        v = _mm_xor_si128(mask, v);
-
-        _mm_storeu_si128((__m128i*)(out + i + j), v);
-
-        // Increment bit counter `j`
-        j += 16;
-      }
-#endif
-      for (; j < SEQUENCE_PAR_BITS; j++) {
-        out[i + j] = in[i + j] ^ ((c >> j) & 1U);
-      }
-
-      // Step sequences
-      s->x1 = sequence_gen_LTE_pr_memless_step_par_x1(s->x1);
-      s->x2 = sequence_gen_LTE_pr_memless_step_par_x2(s->x2);
-    }
-  }
-
-  for (; i < length; i++) {
-    out[i] = in[i] ^ ((s->x1 ^ s->x2) & 1U);
-
-    // Step sequences
-    s->x1 = sequence_gen_LTE_pr_memless_step_x1(s->x1);
-    s->x2 = sequence_gen_LTE_pr_memless_step_x2(s->x2);
+  while (i < length) {
+    uint32_t nof_words = sequence_state_gen_words(s, c, length - i);
+    uint32_t n         = SRSRAN_MIN(nof_words * 32, length - i);
+    sequence_words_apply_bit(c, in + i, out + i, n);
+    i += n;
   }
 }
 
@@ -689,111 +1009,162 @@ void srsran_sequence_apply_bit(const uint8_t* in, uint8_t* out, uint32_t length,
 
 void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t length, uint32_t seed)
 {
-  uint32_t x1 = sequence_x1_init;           // X1 initial state is fix
-  uint32_t x2 = sequence_get_x2_init(seed); // loads x2 initial state
-
-  const uint8_t reverse_lut[256] = {
-      0b00000000, 0b10000000, 0b01000000, 0b11000000, 0b00100000, 0b10100000, 0b01100000, 0b11100000, 0b00010000,
-      0b10010000, 0b01010000, 0b11010000, 0b00110000, 0b10110000, 0b01110000, 0b11110000, 0b00001000, 0b10001000,
-      0b01001000, 0b11001000, 0b00101000, 0b10101000, 0b01101000, 0b11101000, 0b00011000, 0b10011000, 0b01011000,
-      0b11011000, 0b00111000, 0b10111000, 0b01111000, 0b11111000, 0b00000100, 0b10000100, 0b01000100, 0b11000100,
-      0b00100100, 0b10100100, 0b01100100, 0b11100100, 0b00010100, 0b10010100, 0b01010100, 0b11010100, 0b00110100,
-      0b10110100, 0b01110100, 0b11110100, 0b00001100, 0b10001100, 0b01001100, 0b11001100, 0b00101100, 0b10101100,
-      0b01101100, 0b11101100, 0b00011100, 0b10011100, 0b01011100, 0b11011100, 0b00111100, 0b10111100, 0b01111100,
-      0b11111100, 0b00000010, 0b10000010, 0b01000010, 0b11000010, 0b00100010, 0b10100010, 0b01100010, 0b11100010,
-      0b00010010, 0b10010010, 0b01010010, 0b11010010, 0b00110010, 0b10110010, 0b01110010, 0b11110010, 0b00001010,
-      0b10001010, 0b01001010, 0b11001010, 0b00101010, 0b10101010, 0b01101010, 0b11101010, 0b00011010, 0b10011010,
-      0b01011010, 0b11011010, 0b00111010, 0b10111010, 0b01111010, 0b11111010, 0b00000110, 0b10000110, 0b01000110,
-      0b11000110, 0b00100110, 0b10100110, 0b01100110, 0b11100110, 0b00010110, 0b10010110, 0b01010110, 0b11010110,
-      0b00110110, 0b10110110, 0b01110110, 0b11110110, 0b00001110, 0b10001110, 0b01001110, 0b11001110, 0b00101110,
-      0b10101110, 0b01101110, 0b11101110, 0b00011110, 0b10011110, 0b01011110, 0b11011110, 0b00111110, 0b10111110,
-      0b01111110, 0b11111110, 0b00000001, 0b10000001, 0b01000001, 0b11000001, 0b00100001, 0b10100001, 0b01100001,
-      0b11100001, 0b00010001, 0b10010001, 0b01010001, 0b11010001, 0b00110001, 0b10110001, 0b01110001, 0b11110001,
-      0b00001001, 0b10001001, 0b01001001, 0b11001001, 0b00101001, 0b10101001, 0b01101001, 0b11101001, 0b00011001,
-      0b10011001, 0b01011001, 0b11011001, 0b00111001, 0b10111001, 0b01111001, 0b11111001, 0b00000101, 0b10000101,
-      0b01000101, 0b11000101, 0b00100101, 0b10100101, 0b01100101, 0b11100101, 0b00010101, 0b10010101, 0b01010101,
-      0b11010101, 0b00110101, 0b10110101, 0b01110101, 0b11110101, 0b00001101, 0b10001101, 0b01001101, 0b11001101,
-      0b00101101, 0b10101101, 0b01101101, 0b11101101, 0b00011101, 0b10011101, 0b01011101, 0b11011101, 0b00111101,
-      0b10111101, 0b01111101, 0b11111101, 0b00000011, 0b10000011, 0b01000011, 0b11000011, 0b00100011, 0b10100011,
-      0b01100011, 0b11100011, 0b00010011, 0b10010011, 0b01010011, 0b11010011, 0b00110011, 0b10110011, 0b01110011,
-      0b11110011, 0b00001011, 0b10001011, 0b01001011, 0b11001011, 0b00101011, 0b10101011, 0b01101011, 0b11101011,
-      0b00011011, 0b10011011, 0b01011011, 0b11011011, 0b00111011, 0b10111011, 0b01111011, 0b11111011, 0b00000111,
-      0b10000111, 0b01000111, 0b11000111, 0b00100111, 0b10100111, 0b01100111, 0b11100111, 0b00010111, 0b10010111,
-      0b01010111, 0b11010111, 0b00110111, 0b10110111, 0b01110111, 0b11110111, 0b00001111, 0b10001111, 0b01001111,
-      0b11001111, 0b00101111, 0b10101111, 0b01101111, 0b11101111, 0b00011111, 0b10011111, 0b01011111, 0b11011111,
-      0b00111111, 0b10111111, 0b01111111, 0b11111111,
-  };
+  srsran_sequence_state_t s = {};
+  srsran_sequence_state_init(&s, seed);
 
+  uint32_t c[SEQUENCE_BLOCK_WORDS];
   uint32_t i = 0;
-#if SEQUENCE_PAR_BITS % 8 != 0
-  uint64_t buffer = 0;
-  uint32_t count  = 0;
+  while (i < length) {
+    uint32_t nof_words = sequence_state_gen_words(&s, c, length - i);
+    uint32_t n         = SRSRAN_MIN(nof_words * 32, length - i);
+    sequence_words_apply_packed(c, in + i / 8, out + i / 8, n);
+    i += n;
+  }
+}
 
-  for (; i < length / 8; i++) {
-    // Generate sequence bits
-    while (count < 8) {
-      uint32_t c = (uint32_t)(x1 ^ x2);
-      buffer     = buffer | ((SEQUENCE_MASK & c) << count);
+/*
+ * Sequence cache
+ */
+int srsran_sequence_cache_init(srsran_sequence_cache_t* q, uint32_t nof_entries, uint32_t max_len)
+{
+  if (q == NULL || nof_entries == 0 || max_len == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-      // Step sequences
-      x1 = sequence_gen_LTE_pr_memless_step_par_x1(x1);
-      x2 = sequence_gen_LTE_pr_memless_step_par_x2(x2);
+  SRSRAN_MEM_ZERO(q, srsran_sequence_cache_t, 1);
+  q->nof_entries     = nof_entries;
+  q->max_len         = max_len;
+  q->words_per_entry = SRSRAN_CEIL(max_len, 32);
+
+  q->seed = srsran_vec_u32_malloc(nof_entries);
+  q->len  = srsran_vec_u32_malloc(nof_entries);
+  q->c    = srsran_vec_u32_malloc(nof_entries * q->words_per_entry);
+  if (q->seed == NULL || q->len == NULL || q->c == NULL) {
+    ERROR("Error allocating sequence cache");
+    srsran_sequence_cache_free(q);
+    return SRSRAN_ERROR;
+  }
+  srsran_vec_u32_zero(q->len, nof_entries);
 
-      // Increase count
-      count += SEQUENCE_PAR_BITS;
-    }
+  return SRSRAN_SUCCESS;
+}
 
-    // Apply XOR
-    out[i] = in[i] ^ reverse_lut[buffer & 255UL];
-    buffer = buffer >> 8UL;
-    count -= 8;
+void srsran_sequence_cache_free(srsran_sequence_cache_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+  if (q->seed) {
+    free(q->seed);
   }
+  if (q->len) {
+    free(q->len);
+  }
+  if (q->c) {
+    free(q->c);
+  }
+  SRSRAN_MEM_ZERO(q, srsran_sequence_cache_t, 1);
+}
 
-  // Process spare bits
-  uint32_t rem8 = length % 8;
-  if (rem8 != 0) {
-    // Generate sequence bits
-    while (count < rem8) {
-      uint32_t c = (uint32_t)(x1 ^ x2);
-      buffer     = buffer | ((SEQUENCE_MASK & c) << count);
+/**
+ * Returns the packed words of the sequence for the given seed, covering at least length bits. The entry is regenerated
+ * on a miss. Returns NULL if the length does not fit in an entry
+ */
+static const uint32_t* sequence_cache_get(srsran_sequence_cache_t* q, uint32_t length, uint32_t seed)
+{
+  if (q == NULL || q->c == NULL || length > q->max_len) {
+    return NULL;
+  }
 
-      // Step sequences
-      x1 = sequence_gen_LTE_pr_memless_step_par_x1(x1);
-      x2 = sequence_gen_LTE_pr_memless_step_par_x2(x2);
+  // Seeds differ in the RNTI and slot bits, spread them over the entries
+  uint32_t  idx = (uint32_t)(((uint64_t)seed * 2654435761ULL) >> 16U) % q->nof_entries;
+  uint32_t* c   = &q->c[idx * q->words_per_entry];
 
-      // Increase count
-      count += SEQUENCE_PAR_BITS;
-    }
+  if (q->len[idx] != 0 && q->seed[idx] == seed && q->len[idx] >= length) {
+    q->nof_hits++;
+    return c;
+  }
+  q->nof_misses++;
+
+  srsran_sequence_state_t s = {};
+  srsran_sequence_state_init(&s, seed);
+  uint32_t nof_bits = SRSRAN_CEIL(length, 32) * 32;
+  uint32_t i        = 0;
+  while (i < nof_bits) {
+    i += 32 * sequence_state_gen_words(&s, &c[i / 32], nof_bits - i);
+  }
+  q->seed[idx] = seed;
+  q->len[idx]  = nof_bits;
+
+  return c;
+}
 
-    out[i] = in[i] ^ reverse_lut[buffer & ((1U << rem8) - 1U) & 255U];
+void srsran_sequence_cache_apply_f(srsran_sequence_cache_t* q,
+                                   const float*             in,
+                                   float*                   out,
+                                   uint32_t                 length,
+                                   uint32_t                 seed)
+{
+  const uint32_t* c = sequence_cache_get(q, length, seed);
+  if (c == NULL) {
+    srsran_sequence_apply_f(in, out, length, seed);
+    return;
   }
-#else  // SEQUENCE_PAR_BITS % 8 == 0
-  while (i < (length / 8 - (SEQUENCE_PAR_BITS - 1) / 8)) {
-    uint32_t c = (uint32_t)(x1 ^ x2);
+  sequence_words_apply_f(c, in, out, length);
+}
 
-    for (uint32_t j = 0; j < SEQUENCE_PAR_BITS / 8; j++) {
-      out[i] = in[i] ^ reverse_lut[c & 255U];
-      c      = c >> 8U;
-      i++;
-    }
+void srsran_sequence_cache_apply_s(srsran_sequence_cache_t* q,
+                                   const int16_t*           in,
+                                   int16_t*                 out,
+                                   uint32_t                 length,
+                                   uint32_t                 seed)
+{
+  const uint32_t* c = sequence_cache_get(q, length, seed);
+  if (c == NULL) {
+    srsran_sequence_apply_s(in, out, length, seed);
+    return;
+  }
+  sequence_words_apply_s(c, in, out, length);
+}
 
-    // Step sequences
-    x1 = sequence_gen_LTE_pr_memless_step_par_x1(x1);
-    x2 = sequence_gen_LTE_pr_memless_step_par_x2(x2);
+void srsran_sequence_cache_apply_c(srsran_sequence_cache_t* q,
+                                   const int8_t*            in,
+                                   int8_t*                  out,
+                                   uint32_t                 length,
+                                   uint32_t                 seed)
+{
+  const uint32_t* c = sequence_cache_get(q, length, seed);
+  if (c == NULL) {
+    srsran_sequence_apply_c(in, out, length, seed);
+    return;
   }
+  sequence_words_apply_c(c, in, out, length);
+}
 
-  // Process spare bytes
-  uint32_t c = (uint32_t)(x1 ^ x2);
-  while (i < length / 8) {
-    out[i] = in[i] ^ reverse_lut[c & 255U];
-    c      = c >> 8U;
-    i++;
+void srsran_sequence_cache_apply_bit(srsran_sequence_cache_t* q,
+                                     const uint8_t*           in,
+                                     uint8_t*                 out,
+                                     uint32_t                 length,
+                                     uint32_t                 seed)
+{
+  const uint32_t* c = sequence_cache_get(q, length, seed);
+  if (c == NULL) {
+    srsran_sequence_apply_bit(in, out, length, seed);
+    return;
   }
+  sequence_words_apply_bit(c, in, out, length);
+}
 
-  // Process spare bits
-  uint32_t rem8 = length % 8;
-  if (rem8 != 0) {
-    out[i] = in[i] ^ reverse_lut[c & ((1U << rem8) - 1U) & 255U];
+void srsran_sequence_cache_apply_packed(srsran_sequence_cache_t* q,
+                                        const uint8_t*           in,
+                                        uint8_t*                 out,
+                                        uint32_t                 length,
+                                        uint32_t                 seed)
+{
+  const uint32_t* c = sequence_cache_get(q, length, seed);
+  if (c == NULL) {
+    srsran_sequence_apply_packed(in, out, length, seed);
+    return;
   }
-#endif // SEQUENCE_PAR_BITS % 8 == 0
+  sequence_words_apply_packed(c, in, out, length);
 }
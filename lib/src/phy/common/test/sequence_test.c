@@ -43,6 +43,11 @@ static int8_t  ones_char[Nc + MAX_SEQ_LEN + 31];
 static uint8_t ones_packed[(MAX_SEQ_LEN * 7) / 8];
 static uint8_t ones_unpacked[MAX_SEQ_LEN];
 
+static srsran_sequence_cache_t cache = {};
+static float                   cache_float[MAX_SEQ_LEN];
+static int8_t                  cache_char[MAX_SEQ_LEN];
+static uint8_t                 cache_packed[MAX_SEQ_LEN / 8];
+
 static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t length, uint32_t repetitions)
 {
   int            ret                      = SRSRAN_SUCCESS;
@@ -53,6 +58,7 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
   uint64_t       interval_xor_char_us     = 0;
   uint64_t       interval_xor_unpacked_us = 0;
   uint64_t       interval_xor_packed_us   = 0;
+  uint64_t       interval_cache_float_us  = 0;
 
   gettimeofday(&t[1], NULL);
 
@@ -178,7 +184,44 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
     ret = SRSRAN_ERROR;
   }
 
-  printf("%08x; %8d; %8.1f; %8.1f; %8.1f; %8.1f; %8.1f; %8.1f; %8c\n",
+  // Test the state is carried over between calls, splitting at a non-word boundary
+  uint32_t                split = (length * 3) / 7;
+  srsran_sequence_state_t state = {};
+  srsran_sequence_state_init(&state, seed);
+  srsran_sequence_state_apply_c(&state, ones_char, cache_char, split);
+  srsran_sequence_state_apply_c(&state, ones_char + split, cache_char + split, length - split);
+  if (memcmp(c_char, cache_char, length * sizeof(int8_t)) != 0) {
+    ERROR("Unmatched split c_char");
+    ret = SRSRAN_ERROR;
+  }
+
+  // Test the cache, the first call misses and fills the entry
+  srsran_sequence_cache_apply_c(&cache, ones_char, cache_char, length, seed);
+  srsran_sequence_cache_apply_packed(&cache, ones_packed, cache_packed, length, seed);
+  if (memcmp(c_char, cache_char, length * sizeof(int8_t)) != 0) {
+    ERROR("Unmatched cache c_char");
+    ret = SRSRAN_ERROR;
+  }
+  if (memcmp(c_packed_gold, cache_packed, (length + 7) / 8) != 0) {
+    ERROR("Unmatched cache c_packed");
+    ret = SRSRAN_ERROR;
+  }
+
+  // Test in-place Float XOR from the cache
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < repetitions; r++) {
+    srsran_sequence_cache_apply_f(&cache, ones_float, cache_float, length, seed);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  interval_cache_float_us = t->tv_sec * 1000000UL + t->tv_usec;
+
+  if (memcmp(c_float, cache_float, length * sizeof(float)) != 0) {
+    ERROR("Unmatched cache c_float");
+    ret = SRSRAN_ERROR;
+  }
+
+  printf("%08x; %8d; %8.1f; %8.1f; %8.1f; %8.1f; %8.1f; %8.1f; %8.1f; %8c\n",
          seed,
          length,
          (double)(length * repetitions) / (double)interval_gen_us,
@@ -187,9 +230,10 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
          (double)(length * repetitions) / (double)interval_xor_char_us,
          (double)(length * repetitions) / (double)interval_xor_unpacked_us,
          (double)(length * repetitions) / (double)interval_xor_packed_us,
+         (double)(length * repetitions) / (double)interval_cache_float_us,
          ret == SRSRAN_SUCCESS ? 'y' : 'n');
 
-  return SRSRAN_SUCCESS;
+  return ret;
 }
 
 int main(int argc, char** argv)
@@ -198,6 +242,7 @@ int main(int argc, char** argv)
   uint32_t min_length  = 16;
   uint32_t max_length  = MAX_SEQ_LEN;
 
+  int               ret        = SRSRAN_SUCCESS;
   srsran_sequence_t sequence   = {};
   srsran_random_t   random_gen = srsran_random_init(0);
 
@@ -218,7 +263,13 @@ int main(int argc, char** argv)
     return SRSRAN_ERROR;
   }
 
-  printf("%8s; %8s; %8s; %8s; %8s; %8s; %8s; %8s; %8s;\n",
+  // Initialise sequence cache
+  if (srsran_sequence_cache_init(&cache, 16, max_length) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error initializing sequence cache\n");
+    return SRSRAN_ERROR;
+  }
+
+  printf("%8s; %8s; %8s; %8s; %8s; %8s; %8s; %8s; %8s; %8s;\n",
          "seed",
          "length",
          "GEN",
@@ -227,15 +278,20 @@ int main(int argc, char** argv)
          "XOR 8",
          "XOR Unpack",
          "XOR Pack",
+         "Cache PS",
          "Passed");
 
   for (uint32_t length = min_length; length <= max_length; length = (length * 5) / 4) {
-    test_sequence(&sequence, (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX), length, repetitions);
+    uint32_t seed = (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX);
+    if (test_sequence(&sequence, seed, length, repetitions) != SRSRAN_SUCCESS) {
+      ret = SRSRAN_ERROR;
+    }
   }
 
   // Free sequence object
   srsran_sequence_free(&sequence);
+  srsran_sequence_cache_free(&cache);
   srsran_random_free(random_gen);
 
-  return SRSRAN_SUCCESS;
+  return ret;
 }
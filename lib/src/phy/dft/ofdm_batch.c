@@ -0,0 +1,424 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/dft/ofdm_batch.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+typedef struct {
+  /* Thread identifier: they must set before thread creation */
+  pthread_t            pthread;
+  uint32_t             id;
+  srsran_ofdm_batch_t* q;
+
+  /* Semaphores */
+  sem_t start;
+  sem_t finish;
+
+  /* Thread flags */
+  bool quit;
+} ofdm_batch_coworker_t;
+
+static inline uint32_t ofdm_batch_cp_len(srsran_cp_t cp, uint32_t symbol_idx, uint32_t symbol_sz)
+{
+  return SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(symbol_idx, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+}
+
+static inline cf_t* ofdm_batch_tmp(srsran_ofdm_batch_t* q, uint32_t port, uint32_t slot)
+{
+  return q->tmp + (port * SRSRAN_NOF_SLOTS_PER_SF + slot) * q->nof_symbols * q->cfg.symbol_sz;
+}
+
+static void ofdm_batch_set_scale(srsran_ofdm_batch_t* q)
+{
+  uint32_t symbol_sz   = q->cfg.symbol_sz;
+  uint32_t nof_symbols = q->nof_symbols * SRSRAN_NOF_SLOTS_PER_SF;
+  float    norm        = q->cfg.normalize ? 1.0f / sqrtf((float)symbol_sz) : 1.0f;
+  double   srate_hz    = symbol_sz * 15e3; //< Assume 15kHz subcarrier spacing, same as srsran_ofdm_t
+
+  bool     phase_compensation = isnormal(q->cfg.phase_compensation_hz) && isnormal(srate_hz);
+  uint32_t count              = 0;
+  for (uint32_t l = 0; l < nof_symbols; l++) {
+    q->scale[l] = norm;
+
+    if (phase_compensation) {
+      // Advance CP and calculate the symbol start time
+      count += ofdm_batch_cp_len(q->cfg.cp, l % q->nof_symbols, symbol_sz);
+      double t_start   = (double)count / srate_hz;
+      double phase_rad = -2.0 * M_PI * q->cfg.phase_compensation_hz * t_start;
+
+      // The receiver applies the conjugate of the transmitter compensation, merged with the normalization
+      q->scale[l] *= conjf((cf_t)cexp(I * phase_rad));
+      count += symbol_sz;
+    }
+  }
+
+  q->scale_enable = q->cfg.normalize || phase_compensation;
+}
+
+static int ofdm_batch_set_freq_shift(srsran_ofdm_batch_t* q)
+{
+  if (!isnormal(q->cfg.freq_shift_f)) {
+    return SRSRAN_SUCCESS;
+  }
+
+  q->shift_buffer = srsran_vec_cf_malloc(q->sf_sz);
+  if (q->shift_buffer == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  cf_t*    ptr       = q->shift_buffer;
+  for (uint32_t n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
+    for (uint32_t i = 0; i < q->nof_symbols; i++) {
+      uint32_t cplen = ofdm_batch_cp_len(q->cfg.cp, i, symbol_sz);
+      for (uint32_t t = 0; t < symbol_sz + cplen; t++) {
+        ptr[t] = cexpf(I * 2 * M_PI * ((float)t - (float)cplen) * q->cfg.freq_shift_f / symbol_sz);
+      }
+      ptr += symbol_sz + cplen;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Extracts the useful subcarriers of every symbol in a slot and applies, in the same pass, the DFT window offset
+ * compensation, the phase compensation and the normalization.
+ */
+static void ofdm_batch_rx_slot_post(srsran_ofdm_batch_t* q, uint32_t port, uint32_t slot)
+{
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  uint32_t    half      = q->nof_re / 2;
+  const cf_t* tmp       = ofdm_batch_tmp(q, port, slot);
+  cf_t*       output    = q->cfg.out_buffer[port] + slot * q->nof_symbols * q->nof_re;
+  const cf_t* scale     = &q->scale[slot * q->nof_symbols];
+
+  for (uint32_t i = 0; i < q->nof_symbols; i++) {
+    const cf_t* neg = tmp + symbol_sz - half;
+    const cf_t* pos = tmp + q->dc;
+
+    if (q->window_offset_buffer) {
+      srsran_vec_prod_ccc(neg, q->window_offset_buffer + symbol_sz - half, output, half);
+      srsran_vec_prod_ccc(pos, q->window_offset_buffer + q->dc, output + half, half);
+      if (q->scale_enable) {
+        srsran_vec_sc_prod_ccc(output, scale[i], output, q->nof_re);
+      }
+    } else if (q->scale_enable) {
+      srsran_vec_sc_prod_ccc(neg, scale[i], output, half);
+      srsran_vec_sc_prod_ccc(pos, scale[i], output + half, half);
+    } else {
+      srsran_vec_cf_copy(output, neg, half);
+      srsran_vec_cf_copy(output + half, pos, half);
+    }
+
+    tmp += symbol_sz;
+    output += q->nof_re;
+  }
+}
+
+static void ofdm_batch_rx_port(srsran_ofdm_batch_t* q, uint32_t port)
+{
+  if (q->shift_buffer) {
+    cf_t* input = q->in_buffer + port * q->sf_sz;
+    srsran_vec_prod_ccc(input, q->shift_buffer, input, q->sf_sz);
+  }
+
+  for (uint32_t slot = 0; slot < SRSRAN_NOF_SLOTS_PER_SF; slot++) {
+    srsran_dft_run_guru_c(&q->plan_port[port][slot]);
+    ofdm_batch_rx_slot_post(q, port, slot);
+  }
+}
+
+static void ofdm_batch_rx_ports(srsran_ofdm_batch_t* q, uint32_t worker_id)
+{
+  for (uint32_t port = worker_id; port < q->cfg.nof_ports; port += q->cfg.nof_coworkers + 1) {
+    ofdm_batch_rx_port(q, port);
+  }
+}
+
+static void* ofdm_batch_coworker_thread(void* arg)
+{
+  ofdm_batch_coworker_t* h = (ofdm_batch_coworker_t*)arg;
+
+  sem_wait(&h->start);
+  while (!h->quit) {
+    ofdm_batch_rx_ports(h->q, h->id);
+
+    /* Post finish semaphore */
+    sem_post(&h->finish);
+
+    /* Wait for next loop */
+    sem_wait(&h->start);
+  }
+  sem_post(&h->finish);
+
+  pthread_exit(NULL);
+  return h;
+}
+
+static void ofdm_batch_coworker_free(srsran_ofdm_batch_t* q, uint32_t i)
+{
+  ofdm_batch_coworker_t* h = (ofdm_batch_coworker_t*)q->coworkers[i];
+  if (h == NULL) {
+    return;
+  }
+
+  /* Stop thread */
+  h->quit = true;
+  sem_post(&h->start);
+  pthread_join(h->pthread, NULL);
+
+  sem_destroy(&h->start);
+  sem_destroy(&h->finish);
+  free(h);
+  q->coworkers[i] = NULL;
+}
+
+static int ofdm_batch_coworker_init(srsran_ofdm_batch_t* q, uint32_t i)
+{
+  ofdm_batch_coworker_t* h = calloc(1, sizeof(ofdm_batch_coworker_t));
+  if (h == NULL) {
+    ERROR("Allocating coworker");
+    return SRSRAN_ERROR;
+  }
+
+  h->q  = q;
+  h->id = i + 1;
+
+  if (sem_init(&h->start, 0, 0) || sem_init(&h->finish, 0, 0)) {
+    ERROR("Creating semaphore");
+    free(h);
+    return SRSRAN_ERROR;
+  }
+
+  if (pthread_create(&h->pthread, NULL, ofdm_batch_coworker_thread, (void*)h)) {
+    ERROR("Creating coworker thread");
+    sem_destroy(&h->start);
+    sem_destroy(&h->finish);
+    free(h);
+    return SRSRAN_ERROR;
+  }
+
+  q->coworkers[i] = h;
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_ofdm_rx_batch_init(srsran_ofdm_batch_t* q, const srsran_ofdm_batch_cfg_t* cfg)
+{
+  if (q == NULL || cfg == NULL || cfg->nof_ports == 0 || cfg->nof_ports > SRSRAN_MAX_PORTS) {
+    ERROR("Error, invalid inputs");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_ofdm_batch_t, 1);
+  q->cfg = *cfg;
+
+  // If the symbol size is not given, calculate in function of the number of resource blocks
+  if (q->cfg.symbol_sz == 0) {
+    int symbol_sz_err = srsran_symbol_sz(q->cfg.nof_prb);
+    if (symbol_sz_err <= SRSRAN_SUCCESS) {
+      ERROR("Invalid number of PRB %d", q->cfg.nof_prb);
+      return SRSRAN_ERROR;
+    }
+    q->cfg.symbol_sz = (uint32_t)symbol_sz_err;
+  }
+
+  // Do not spawn more threads than ports
+  q->cfg.nof_coworkers = SRSRAN_MIN(q->cfg.nof_coworkers, q->cfg.nof_ports - 1);
+
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  srsran_cp_t cp        = q->cfg.cp;
+  q->nof_symbols        = SRSRAN_CP_NSYMB(cp);
+  q->nof_re             = q->cfg.nof_prb * SRSRAN_NRE;
+  q->slot_sz            = (uint32_t)SRSRAN_SLOT_LEN(symbol_sz);
+  q->sf_sz              = (uint32_t)SRSRAN_SF_LEN(symbol_sz);
+  q->dc                 = ((!q->cfg.keep_dc) && (!isnormal(q->cfg.freq_shift_f))) ? 1 : 0;
+
+  uint32_t tmp_port_sz = SRSRAN_NOF_SLOTS_PER_SF * q->nof_symbols * symbol_sz;
+  q->in_buffer         = srsran_vec_cf_malloc(q->cfg.nof_ports * q->sf_sz);
+  q->tmp               = srsran_vec_cf_malloc(q->cfg.nof_ports * tmp_port_sz);
+  if (q->in_buffer == NULL || q->tmp == NULL) {
+    ERROR("Error allocating buffers");
+    goto clean_exit;
+  }
+  srsran_vec_cf_zero(q->in_buffer, q->cfg.nof_ports * q->sf_sz);
+  srsran_vec_cf_zero(q->tmp, q->cfg.nof_ports * tmp_port_sz);
+
+  uint32_t cp1 = ofdm_batch_cp_len(cp, 0, symbol_sz);
+  uint32_t cp2 = ofdm_batch_cp_len(cp, 1, symbol_sz);
+
+  // Slides DFT window a fraction of cyclic prefix
+  if (isnormal(q->cfg.rx_window_offset)) {
+    float offset            = SRSRAN_MIN(1.0f, SRSRAN_MAX(0.0f, q->cfg.rx_window_offset));
+    q->window_offset_n      = (uint32_t)roundf((float)cp2 * offset);
+    q->window_offset_buffer = srsran_vec_cf_malloc(symbol_sz);
+    if (q->window_offset_buffer == NULL) {
+      ERROR("Error allocating buffers");
+      goto clean_exit;
+    }
+    for (uint32_t i = 0; i < symbol_sz; i++) {
+      q->window_offset_buffer[i] = cexpf(I * M_PI * 2.0f * (float)q->window_offset_n * (float)i / (float)symbol_sz);
+    }
+  }
+
+  if (ofdm_batch_set_freq_shift(q) < SRSRAN_SUCCESS) {
+    ERROR("Error allocating frequency shift buffer");
+    goto clean_exit;
+  }
+
+  ofdm_batch_set_scale(q);
+
+  for (uint32_t slot = 0; slot < SRSRAN_NOF_SLOTS_PER_SF; slot++) {
+    cf_t* in = q->in_buffer + cp1 + slot * q->slot_sz - q->window_offset_n;
+
+    if (q->cfg.nof_coworkers == 0) {
+      // A single plan covers all the symbols of the slot for all the ports
+      if (srsran_dft_plan_guru_batch_c(&q->plan_sf[slot],
+                                       symbol_sz,
+                                       SRSRAN_DFT_FORWARD,
+                                       in,
+                                       ofdm_batch_tmp(q, 0, slot),
+                                       q->nof_symbols,
+                                       symbol_sz + cp2,
+                                       symbol_sz,
+                                       q->cfg.nof_ports,
+                                       q->sf_sz,
+                                       tmp_port_sz)) {
+        ERROR("Creating batched DFT plan (%d)", slot);
+        goto clean_exit;
+      }
+      continue;
+    }
+
+    // Otherwise, each port has its own plan so they can be executed from different threads
+    for (uint32_t port = 0; port < q->cfg.nof_ports; port++) {
+      if (srsran_dft_plan_guru_c(&q->plan_port[port][slot],
+                                 symbol_sz,
+                                 SRSRAN_DFT_FORWARD,
+                                 in + port * q->sf_sz,
+                                 ofdm_batch_tmp(q, port, slot),
+                                 1,
+                                 1,
+                                 q->nof_symbols,
+                                 symbol_sz + cp2,
+                                 symbol_sz)) {
+        ERROR("Creating port DFT plan (%d, %d)", port, slot);
+        goto clean_exit;
+      }
+    }
+  }
+
+  for (uint32_t i = 0; i < q->cfg.nof_coworkers; i++) {
+    if (ofdm_batch_coworker_init(q, i) < SRSRAN_SUCCESS) {
+      goto clean_exit;
+    }
+  }
+
+  DEBUG("Init batched FFT symbol_sz=%d, nof_symbols=%d, nof_ports=%d, nof_coworkers=%d",
+        symbol_sz,
+        q->nof_symbols,
+        q->cfg.nof_ports,
+        q->cfg.nof_coworkers);
+
+  return SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_ofdm_rx_batch_free(q);
+  return SRSRAN_ERROR;
+}
+
+void srsran_ofdm_rx_batch_free(srsran_ofdm_batch_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < SRSRAN_OFDM_BATCH_MAX_COWORKERS; i++) {
+    ofdm_batch_coworker_free(q, i);
+  }
+
+  for (uint32_t slot = 0; slot < SRSRAN_NOF_SLOTS_PER_SF; slot++) {
+    srsran_dft_plan_free(&q->plan_sf[slot]);
+    for (uint32_t port = 0; port < SRSRAN_MAX_PORTS; port++) {
+      srsran_dft_plan_free(&q->plan_port[port][slot]);
+    }
+  }
+
+  if (q->in_buffer) {
+    free(q->in_buffer);
+  }
+  if (q->tmp) {
+    free(q->tmp);
+  }
+  if (q->shift_buffer) {
+    free(q->shift_buffer);
+  }
+  if (q->window_offset_buffer) {
+    free(q->window_offset_buffer);
+  }
+  SRSRAN_MEM_ZERO(q, srsran_ofdm_batch_t, 1);
+}
+
+cf_t* srsran_ofdm_rx_batch_get_buffer(srsran_ofdm_batch_t* q, uint32_t port)
+{
+  if (q == NULL || port >= q->cfg.nof_ports) {
+    return NULL;
+  }
+  return q->in_buffer + port * q->sf_sz;
+}
+
+void srsran_ofdm_rx_batch_sf(srsran_ofdm_batch_t* q)
+{
+  if (q->cfg.nof_coworkers == 0) {
+    if (q->shift_buffer) {
+      for (uint32_t port = 0; port < q->cfg.nof_ports; port++) {
+        cf_t* input = q->in_buffer + port * q->sf_sz;
+        srsran_vec_prod_ccc(input, q->shift_buffer, input, q->sf_sz);
+      }
+    }
+
+    for (uint32_t slot = 0; slot < SRSRAN_NOF_SLOTS_PER_SF; slot++) {
+      srsran_dft_run_guru_c(&q->plan_sf[slot]);
+      for (uint32_t port = 0; port < q->cfg.nof_ports; port++) {
+        ofdm_batch_rx_slot_post(q, port, slot);
+      }
+    }
+    return;
+  }
+
+  // Start coworkers, process the first share of ports in this thread and wait for the rest
+  for (uint32_t i = 0; i < q->cfg.nof_coworkers; i++) {
+    sem_post(&((ofdm_batch_coworker_t*)q->coworkers[i])->start);
+  }
+
+  ofdm_batch_rx_ports(q, 0);
+
+  for (uint32_t i = 0; i < q->cfg.nof_coworkers; i++) {
+    sem_wait(&((ofdm_batch_coworker_t*)q->coworkers[i])->finish);
+  }
+}
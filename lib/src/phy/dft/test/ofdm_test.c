@@ -36,6 +36,8 @@ static float       rx_window_offset      = 0.5f;
 static float       freq_shift_f          = 0.0f;
 static double      phase_compensation_hz = 0.0;
 static uint32_t    force_symbol_sz       = 0;
+static uint32_t    batch_nof_ports       = 0;
+static uint32_t    batch_nof_coworkers   = 0;
 static double      elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
 {
   if (ts_end->tv_usec > ts_start->tv_usec) {
@@ -57,12 +59,14 @@ static void usage(char* prog)
   printf("\t-o rx window offset (portion of CP length) [Default %.1f]\n", rx_window_offset);
   printf("\t-s frequency shift (normalised with sampling rate) [Default %.1f]\n", freq_shift_f);
   printf("\t-p Phase compensation carrier frequency in Hz [Default %.1f]\n", phase_compensation_hz);
+  printf("\t-a Number of ports for the batched receiver, 0 for disabling it [Default %d]\n", batch_nof_ports);
+  printf("\t-t Number of batched receiver coworker threads [Default %d]\n", batch_nof_coworkers);
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "Nnerosp")) != -1) {
+  while ((opt = getopt(argc, argv, "Nnerospat")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (int)strtol(argv[optind], NULL, 10);
@@ -85,6 +89,12 @@ static void parse_args(int argc, char** argv)
       case 'p':
         phase_compensation_hz = strtod(argv[optind], NULL);
         break;
+      case 'a':
+        batch_nof_ports = SRSRAN_MIN(SRSRAN_MAX_PORTS, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 't':
+        batch_nof_coworkers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -97,6 +107,7 @@ int main(int argc, char** argv)
   srsran_random_t random_gen = srsran_random_init(0);
   struct timeval  start, end;
   srsran_ofdm_t   fft = {}, ifft = {};
+  srsran_ofdm_batch_t fft_batch = {};
   cf_t *          input, *outfft, *outifft;
   float           mse;
   uint32_t        n_prb, max_prb;
@@ -165,6 +176,37 @@ int main(int argc, char** argv)
     gettimeofday(&end, NULL);
     printf(" Tx@%.1fMsps", (float)(sf_len * nof_repetitions) / elapsed_us(&start, &end));
 
+    // Prepare batched Rx, every port receives the same signal. The input must be copied before the legacy Rx as it
+    // applies the frequency shift in-place
+    cf_t* outbatch[SRSRAN_MAX_PORTS] = {};
+    if (batch_nof_ports > 0) {
+      srsran_ofdm_batch_cfg_t batch_cfg = {};
+      batch_cfg.nof_prb                 = n_prb;
+      batch_cfg.nof_ports               = batch_nof_ports;
+      batch_cfg.cp                      = cp;
+      batch_cfg.normalize               = true;
+      batch_cfg.freq_shift_f            = -freq_shift_f;
+      batch_cfg.rx_window_offset        = rx_window_offset;
+      batch_cfg.symbol_sz               = symbol_sz;
+      batch_cfg.phase_compensation_hz   = phase_compensation_hz;
+      batch_cfg.nof_coworkers           = batch_nof_coworkers;
+      for (uint32_t p = 0; p < batch_nof_ports; p++) {
+        outbatch[p] = srsran_vec_cf_malloc(n_re);
+        if (!outbatch[p]) {
+          perror("malloc");
+          exit(-1);
+        }
+        batch_cfg.out_buffer[p] = outbatch[p];
+      }
+      if (srsran_ofdm_rx_batch_init(&fft_batch, &batch_cfg)) {
+        ERROR("Error initializing batched FFT");
+        exit(-1);
+      }
+      for (uint32_t p = 0; p < batch_nof_ports; p++) {
+        srsran_vec_cf_copy(srsran_ofdm_rx_batch_get_buffer(&fft_batch, p), outifft, sf_len);
+      }
+    }
+
     // Execute Rx
     gettimeofday(&start, NULL);
     for (uint32_t i = 0; i < nof_repetitions; i++) {
@@ -177,13 +219,40 @@ int main(int argc, char** argv)
     srsran_vec_sub_ccc(input, outfft, outfft, n_re);
     mse = sqrtf(srsran_vec_avg_power_cf(outfft, n_re));
 
-    printf(" MSE=%.6f\n", mse);
+    printf(" MSE=%.6f", mse);
 
     if (mse >= 0.0001) {
-      printf("MSE too large\n");
+      printf("\nMSE too large\n");
       exit(-1);
     }
 
+    // Execute batched Rx, the throughput accounts for all ports
+    if (batch_nof_ports > 0) {
+      gettimeofday(&start, NULL);
+      for (uint32_t i = 0; i < nof_repetitions; i++) {
+        srsran_ofdm_rx_batch_sf(&fft_batch);
+      }
+      gettimeofday(&end, NULL);
+      printf(" Rx-batch(%dx)@%.1fMsps",
+             batch_nof_ports,
+             (double)(sf_len * nof_repetitions * batch_nof_ports) / elapsed_us(&start, &end));
+
+      for (uint32_t p = 0; p < batch_nof_ports; p++) {
+        srsran_vec_sub_ccc(input, outbatch[p], outbatch[p], n_re);
+        mse = SRSRAN_MAX(mse, sqrtf(srsran_vec_avg_power_cf(outbatch[p], n_re)));
+        free(outbatch[p]);
+      }
+      srsran_ofdm_rx_batch_free(&fft_batch);
+
+      printf(" MSE-batch=%.6f", mse);
+
+      if (mse >= 0.0001) {
+        printf("\nMSE too large\n");
+        exit(-1);
+      }
+    }
+    printf("\n");
+
     srsran_ofdm_rx_free(&fft);
     srsran_ofdm_tx_free(&ifft);
 
@@ -21,14 +21,19 @@
 
 #include "srsran/phy/fec/block/block.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 
-// The following MACRO enables/disables LUT for the decoder
+// The following MACRO enables/disables LUT for the encoder and the exhaustive search decoder
 #define USE_LUT 1
 
 // The following type is used for selecting the algorithm precision
 typedef int16_t block_llr_t;
 
+// Words up to this number of bits are decoded by exhaustive search, longer words with the Fast Hadamard Transform.
+// Below it, correlating with all the 2^N sequences is cheaper than the transform of 32 LLRs
+#define BLOCK_EXHAUSTIVE_MAX_NOF_BITS 6U
+
 /// Table 5.2.2.6.4-1: Basis sequence for (32, O) code compressed in uint16_t types
 static const uint64_t M_basis_seq_b[SRSRAN_FEC_BLOCK_SIZE] = {
     0b10000000011, 0b11000000111, 0b11101001001, 0b10100001101, 0b10010001111, 0b10111010011, 0b11101010101,
@@ -56,8 +61,8 @@ static inline uint8_t encode_M_basis_seq_u16(uint16_t w, uint32_t bit_idx)
 // Encoded unpacked table
 static uint8_t block_unpacked_lut[1U << SRSRAN_FEC_BLOCK_MAX_NOF_BITS][SRSRAN_FEC_BLOCK_SIZE];
 
-// LLR signed table
-static block_llr_t block_llr_lut[1U << SRSRAN_FEC_BLOCK_MAX_NOF_BITS][SRSRAN_FEC_BLOCK_SIZE];
+// LLR signed table, only for the words short enough to be decoded by exhaustive search
+static block_llr_t block_llr_lut[1U << BLOCK_EXHAUSTIVE_MAX_NOF_BITS][SRSRAN_FEC_BLOCK_SIZE];
 
 // Initialization function, as the table is read-only after initialization, it can be initialised from constructor
 __attribute__((constructor)) static void srsran_block_init()
@@ -69,7 +74,9 @@ __attribute__((constructor)) static void srsran_block_init()
       block_unpacked_lut[word][i] = e;
 
       // Encoded LLR
-      block_llr_lut[word][i] = (block_llr_t)e * 2 - 1;
+      if (word < (1U << BLOCK_EXHAUSTIVE_MAX_NOF_BITS)) {
+        block_llr_lut[word][i] = (block_llr_t)e * 2 - 1;
+      }
     }
   }
 }
@@ -110,13 +117,55 @@ void srsran_block_encode(const uint8_t* input, uint32_t input_len, uint8_t* outp
 #endif // USE_LUT
 }
 
-static int32_t block_decode(const block_llr_t* llr, uint8_t* data, uint32_t data_len)
+/*
+ * Maximum likelihood decoding with the Fast Hadamard Transform
+ *
+ * Column 0 of the basis sequence table is all ones, and columns 1 to 5 take all 32 possible values across the rows,
+ * like a first order Reed-Muller code. The remaining columns 6 to 10 are treated as masks. For a guess w = (m, a, s),
+ * where m selects the mask columns, a the columns 1 to 5 and s the column 0, the correlation is:
+ *
+ *   corr(w) = (-1)^(s + 1) * sum_x llr[row(x)] * (-1)^(m·u(x)) * (-1)^(a·x)
+ *
+ * where row(x) is the row whose columns 1 to 5 are x and u(x) its mask columns. For every mask m, the correlation
+ * against all the guesses a is the Walsh-Hadamard transform of the masked LLRs, which takes 5 * 32 additions instead
+ * of 32 * 32 products. The sign of each transform output selects s.
+ */
+#define BLOCK_FHT_NOF_LIN_BITS 5U
+#define BLOCK_FHT_SIZE (1U << BLOCK_FHT_NOF_LIN_BITS)
+#define BLOCK_FHT_NOF_MASK_BITS (SRSRAN_FEC_BLOCK_MAX_NOF_BITS - 1 - BLOCK_FHT_NOF_LIN_BITS)
+#define BLOCK_FHT_NOF_MASKS (1U << BLOCK_FHT_NOF_MASK_BITS)
+
+// Row of the basis sequence table for each value of the columns 1 to 5
+static uint8_t block_fht_row[BLOCK_FHT_SIZE];
+
+#if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_I_SIZE
+// Sign of each row for every mask, in transform order, as +1 and -1 factors for applying several masks at once
+static srsran_simd_aligned float block_fht_mask_sign[BLOCK_FHT_SIZE][BLOCK_FHT_NOF_MASKS];
+#else  /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_I_SIZE */
+// Mask parity of each row, in transform order. Bit m is set if applying mask m flips the sign of the LLR
+static uint32_t block_fht_mask_parity[BLOCK_FHT_SIZE];
+#endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_I_SIZE */
+
+__attribute__((constructor)) static void srsran_block_fht_init()
 {
-  int32_t  max_corr = 0; //< Stores maximum correlation
-  uint32_t max_data = 0; //< Stores the word for maximum correlation
+  for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_SIZE; i++) {
+    uint32_t x = (M_basis_seq_b[i] >> 1U) & (BLOCK_FHT_SIZE - 1);
 
-  // Limit data to maximum
-  data_len = SRSRAN_MIN(data_len, SRSRAN_FEC_BLOCK_MAX_NOF_BITS);
+    block_fht_row[x] = (uint8_t)i;
+    for (uint32_t m = 0; m < BLOCK_FHT_NOF_MASKS; m++) {
+      uint32_t parity = encode_M_basis_seq_u16((uint16_t)(m << (1U + BLOCK_FHT_NOF_LIN_BITS)), i);
+#if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_I_SIZE
+      block_fht_mask_sign[x][m] = parity ? -1.0f : +1.0f;
+#else  /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_I_SIZE */
+      block_fht_mask_parity[x] |= parity << m;
+#endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_I_SIZE */
+    }
+  }
+}
+
+static int32_t block_decode_exhaustive(const block_llr_t* llr, uint32_t data_len, uint32_t* max_data)
+{
+  int32_t max_corr = 0; //< Stores maximum correlation
 
   // Brute force all possible sequences
   uint16_t max_guess = (1U << data_len); //< Maximum guess bit combination (excluded)
@@ -137,11 +186,140 @@ static int32_t block_decode(const block_llr_t* llr, uint8_t* data, uint32_t data
 
     // Take decision
     if (corr > max_corr) {
-      max_corr = corr;
-      max_data = guess;
+      max_corr  = corr;
+      *max_data = guess;
+    }
+  }
+
+  return max_corr;
+}
+
+#if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_I_SIZE
+// Transforms up to SRSRAN_SIMD_F_SIZE masks at once, one per lane, starting from mask m0. The LLR sums are below 2^24,
+// so float arithmetic is exact
+static void
+block_fht_decode_simd(const int32_t* llr, uint32_t m0, uint32_t nof_masks, int32_t* max_corr, uint32_t* max_data)
+{
+  simd_f_t z[BLOCK_FHT_SIZE];
+
+  for (uint32_t x = 0; x < BLOCK_FHT_SIZE; x++) {
+    z[x] = srsran_simd_f_mul(srsran_simd_f_set1((float)llr[x]), srsran_simd_f_load(&block_fht_mask_sign[x][m0]));
+  }
+
+  for (uint32_t h = 1; h < BLOCK_FHT_SIZE; h <<= 1U) {
+    for (uint32_t j = 0; j < BLOCK_FHT_SIZE; j += 2 * h) {
+      for (uint32_t k = j; k < j + h; k++) {
+        simd_f_t a = z[k];
+        simd_f_t b = z[k + h];
+        z[k]       = srsran_simd_f_add(a, b);
+        z[k + h]   = srsran_simd_f_sub(a, b);
+      }
     }
   }
 
+  // Keep, for every mask, the first guess with the largest magnitude
+  simd_f_t best   = srsran_simd_f_zero();
+  simd_f_t best_t = srsran_simd_f_zero();
+  simd_f_t best_a = srsran_simd_f_zero();
+  for (uint32_t a = 0; a < BLOCK_FHT_SIZE; a++) {
+    simd_f_t   abs_t = srsran_simd_f_abs(z[a]);
+    simd_sel_t gt    = srsran_simd_f_max(abs_t, best);
+    best             = srsran_simd_f_select(best, abs_t, gt);
+    best_t           = srsran_simd_f_select(best_t, z[a], gt);
+    best_a           = srsran_simd_f_select(best_a, srsran_simd_f_set1((float)a), gt);
+  }
+
+  srsran_simd_aligned float best_v[SRSRAN_SIMD_F_SIZE];
+  srsran_simd_aligned float best_t_v[SRSRAN_SIMD_F_SIZE];
+  srsran_simd_aligned float best_a_v[SRSRAN_SIMD_F_SIZE];
+  srsran_simd_f_store(best_v, best);
+  srsran_simd_f_store(best_t_v, best_t);
+  srsran_simd_f_store(best_a_v, best_a);
+
+  // Lanes above nof_masks hold masks that are not part of the code
+  for (uint32_t i = 0; i < SRSRAN_MIN(nof_masks, SRSRAN_SIMD_F_SIZE); i++) {
+    int32_t corr = (int32_t)best_v[i];
+    if (corr > *max_corr) {
+      *max_corr = corr;
+      *max_data = ((m0 + i) << (1U + BLOCK_FHT_NOF_LIN_BITS)) | ((uint32_t)best_a_v[i] << 1U) |
+                  (best_t_v[i] > 0 ? 1U : 0U);
+    }
+  }
+}
+#else  /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_I_SIZE */
+// Transforms a single mask
+static void block_fht_decode_mask(const int32_t* llr, uint32_t m, int32_t* max_corr, uint32_t* max_data)
+{
+  int32_t z[BLOCK_FHT_SIZE];
+
+  for (uint32_t x = 0; x < BLOCK_FHT_SIZE; x++) {
+    z[x] = ((block_fht_mask_parity[x] >> m) & 1U) ? -llr[x] : llr[x];
+  }
+
+  for (uint32_t h = 1; h < BLOCK_FHT_SIZE; h <<= 1U) {
+    for (uint32_t j = 0; j < BLOCK_FHT_SIZE; j += 2 * h) {
+      for (uint32_t k = j; k < j + h; k++) {
+        int32_t a = z[k];
+        int32_t b = z[k + h];
+        z[k]      = a + b;
+        z[k + h]  = a - b;
+      }
+    }
+  }
+
+  for (uint32_t a = 0; a < BLOCK_FHT_SIZE; a++) {
+    // Column 0 set gives correlation +t, otherwise -t
+    int32_t t    = z[a];
+    int32_t corr = (t > 0) ? t : -t;
+    if (corr > *max_corr) {
+      *max_corr = corr;
+      *max_data = (m << (1U + BLOCK_FHT_NOF_LIN_BITS)) | (a << 1U) | (t > 0 ? 1U : 0U);
+    }
+  }
+}
+#endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_I_SIZE */
+
+static int32_t block_decode_fht(const block_llr_t* llr, uint32_t data_len, uint32_t* max_data)
+{
+  int32_t  max_corr  = 0;
+  uint32_t nof_masks = 1U << (data_len - 1 - BLOCK_FHT_NOF_LIN_BITS);
+
+  // Reorder the LLRs in transform order
+  int32_t llr_x[BLOCK_FHT_SIZE];
+  for (uint32_t x = 0; x < BLOCK_FHT_SIZE; x++) {
+    llr_x[x] = (int32_t)llr[block_fht_row[x]];
+  }
+
+  // The masks are visited in increasing order, and the guesses within a mask too, so that ties keep the lowest guess
+  // like the exhaustive search does
+#if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_I_SIZE
+  for (uint32_t m = 0; m < nof_masks; m += SRSRAN_SIMD_F_SIZE) {
+    block_fht_decode_simd(llr_x, m, nof_masks - m, &max_corr, max_data);
+  }
+#else  /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_I_SIZE */
+  for (uint32_t m = 0; m < nof_masks; m++) {
+    block_fht_decode_mask(llr_x, m, &max_corr, max_data);
+  }
+#endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_I_SIZE */
+
+  return max_corr;
+}
+
+static int32_t block_decode(const block_llr_t* llr, uint8_t* data, uint32_t data_len)
+{
+  int32_t  max_corr = 0; //< Stores maximum correlation
+  uint32_t max_data = 0; //< Stores the word for maximum correlation
+
+  // Limit data to maximum
+  data_len = SRSRAN_MIN(data_len, SRSRAN_FEC_BLOCK_MAX_NOF_BITS);
+
+  // Both decoders are maximum likelihood and keep the lowest word on ties, so they give the same result
+  if (data_len <= BLOCK_EXHAUSTIVE_MAX_NOF_BITS) {
+    max_corr = block_decode_exhaustive(llr, data_len, &max_data);
+  } else {
+    max_corr = block_decode_fht(llr, data_len, &max_data);
+  }
+
   // Bit unpack (reversed)
   for (uint32_t i = 0; i < data_len; i++) {
     data[i] = (uint8_t)((max_data >> i) & 1U);
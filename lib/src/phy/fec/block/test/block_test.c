@@ -36,6 +36,9 @@ static uint32_t        E               = SRSRAN_FEC_BLOCK_SIZE;
 static uint32_t        A               = 100;
 static srsran_random_t random_gen      = NULL;
 
+// Encoded LLR sequences for every possible word, used by the exhaustive search reference
+static int16_t ref_llr_lut[1U << SRSRAN_FEC_BLOCK_MAX_NOF_BITS][SRSRAN_FEC_BLOCK_SIZE];
+
 void usage(char* prog)
 {
   printf("Usage: %s [Rv]\n", prog);
@@ -130,10 +133,127 @@ int test(uint32_t block_size)
   return SRSRAN_SUCCESS;
 }
 
+static void ref_init()
+{
+  uint8_t word[SRSRAN_FEC_BLOCK_MAX_NOF_BITS];
+  uint8_t encoded[SRSRAN_FEC_BLOCK_SIZE];
+  for (uint32_t w = 0; w < (1U << SRSRAN_FEC_BLOCK_MAX_NOF_BITS); w++) {
+    for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_MAX_NOF_BITS; i++) {
+      word[i] = (w >> i) & 1U;
+    }
+    srsran_block_encode(word, SRSRAN_FEC_BLOCK_MAX_NOF_BITS, encoded, SRSRAN_FEC_BLOCK_SIZE);
+    for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_SIZE; i++) {
+      ref_llr_lut[w][i] = (int16_t)(encoded[i] * 2 - 1);
+    }
+  }
+}
+
+// Exhaustive search maximum likelihood decoder, correlates the LLRs with every possible sequence
+static int32_t ref_decode_i16(const int16_t* llr, uint32_t nof_llr, uint8_t* data, uint32_t data_len)
+{
+  int16_t llr_acc[SRSRAN_FEC_BLOCK_SIZE] = {};
+  for (uint32_t i = 0; i < nof_llr; i++) {
+    llr_acc[i % SRSRAN_FEC_BLOCK_SIZE] += llr[i];
+  }
+
+  int32_t  max_corr = 0;
+  uint32_t max_data = 0;
+  for (uint32_t guess = 0; guess < (1U << data_len); guess++) {
+    int32_t corr = 0;
+    for (uint32_t i = 0; i < SRSRAN_FEC_BLOCK_SIZE; i++) {
+      corr += llr_acc[i] * ref_llr_lut[guess][i];
+    }
+    if (corr > max_corr) {
+      max_corr = corr;
+      max_data = guess;
+    }
+  }
+
+  for (uint32_t i = 0; i < data_len; i++) {
+    data[i] = (uint8_t)((max_data >> i) & 1U);
+  }
+  return max_corr;
+}
+
+// Decodes noisy LLRs with the library decoder and the exhaustive search, results must be identical
+int test_noisy(uint32_t block_size)
+{
+  struct timeval t[3]                               = {};
+  uint8_t        tx[SRSRAN_FEC_BLOCK_MAX_NOF_BITS]  = {};
+  uint8_t        encoded[4 * SRSRAN_FEC_BLOCK_SIZE] = {};
+  int32_t        ret                                = SRSRAN_ERROR;
+  uint32_t       nof_words                          = SRSRAN_MAX(nof_repetitions, 1000);
+  int16_t*       llr_i16                            = srsran_vec_i16_malloc(nof_words * E);
+  int8_t*        llr_i8                             = srsran_vec_i8_malloc(nof_words * E);
+  uint8_t*       rx                                 = srsran_vec_u8_malloc(nof_words * block_size);
+  uint8_t*       rx_ref                             = srsran_vec_u8_malloc(nof_words * block_size);
+  int32_t*       corr                               = SRSRAN_MEM_ALLOC(int32_t, nof_words);
+  int32_t*       corr_ref                           = SRSRAN_MEM_ALLOC(int32_t, nof_words);
+  if (!llr_i16 || !llr_i8 || !rx || !rx_ref || !corr || !corr_ref) {
+    goto clean_exit;
+  }
+
+  // The noise is stronger than the signal, so that the decoder makes errors and ties happen
+  int32_t amplitude = (int32_t)A / 4;
+  for (uint32_t w = 0; w < nof_words; w++) {
+    for (uint32_t i = 0; i < block_size; i++) {
+      tx[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
+    }
+    srsran_block_encode(tx, block_size, encoded, E);
+    for (uint32_t i = 0; i < E; i++) {
+      int32_t llr = ((encoded[i] == 0) ? -amplitude : +amplitude) +
+                    srsran_random_uniform_int_dist(random_gen, -2 * amplitude, 2 * amplitude);
+      llr_i16[w * E + i] = (int16_t)llr;
+      llr_i8[w * E + i]  = (int8_t)llr;
+    }
+  }
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t w = 0; w < nof_words; w++) {
+    corr[w] = srsran_block_decode_i16(&llr_i16[w * E], E, &rx[w * block_size], block_size);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t t_decode_us = t[0].tv_sec * 1000000 + t[0].tv_usec;
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t w = 0; w < nof_words; w++) {
+    corr_ref[w] = ref_decode_i16(&llr_i16[w * E], E, &rx_ref[w * block_size], block_size);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t t_ref_us = t[0].tv_sec * 1000000 + t[0].tv_usec;
+
+  for (uint32_t w = 0; w < nof_words; w++) {
+    TESTASSERT(corr[w] == corr_ref[w]);
+    TESTASSERT(memcmp(&rx[w * block_size], &rx_ref[w * block_size], block_size) == 0);
+
+    // The 8 bit decoder gives the same result, as the LLRs fit in 8 bit
+    TESTASSERT(srsran_block_decode_i8(&llr_i8[w * E], E, &rx[w * block_size], block_size) == corr_ref[w]);
+    TESTASSERT(memcmp(&rx[w * block_size], &rx_ref[w * block_size], block_size) == 0);
+  }
+
+  printf("Block size %2d: FHT decoder %.2f Mdecodes/s; exhaustive search %.2f Mdecodes/s\n",
+         block_size,
+         nof_words / (double)SRSRAN_MAX(t_decode_us, 1),
+         nof_words / (double)SRSRAN_MAX(t_ref_us, 1));
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  free(llr_i16);
+  free(llr_i8);
+  free(rx);
+  free(rx_ref);
+  free(corr);
+  free(corr_ref);
+  return ret;
+}
+
 int main(int argc, char** argv)
 {
   parse_args(argc, argv);
   random_gen = srsran_random_init(seed);
+  ref_init();
 
   for (uint32_t block_size = 3; block_size <= SRSRAN_FEC_BLOCK_MAX_NOF_BITS; block_size++) {
     if (test(block_size) < SRSRAN_SUCCESS) {
@@ -141,5 +261,11 @@ int main(int argc, char** argv)
     }
   }
 
+  for (uint32_t block_size = 1; block_size <= SRSRAN_FEC_BLOCK_MAX_NOF_BITS; block_size++) {
+    if (test_noisy(block_size) < SRSRAN_SUCCESS) {
+      break;
+    }
+  }
+
   srsran_random_free(random_gen);
 }
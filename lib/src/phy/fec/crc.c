@@ -22,6 +22,8 @@
 #include "srsran/phy/fec/crc.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <string.h>
 
 #ifdef LV_HAVE_SSE
 #include <immintrin.h>
@@ -47,17 +49,44 @@ static void gen_crc_table(srsran_crc_t* h)
   }
 }
 
-uint64_t reversecrcbit(uint32_t crc, int nbits, srsran_crc_t* h)
+/**
+ * Computes x^k mod P32, where P32 is a degree 32 polynomial including the x^32 term
+ */
+static uint64_t crc_clmul_xk_mod(uint64_t p32, uint32_t k)
+{
+  uint64_t r = 1;
+  for (uint32_t i = 0; i < k; i++) {
+    r <<= 1U;
+    if (r & (1ULL << 32U)) {
+      r ^= p32;
+    }
+  }
+  return r;
+}
+
+static void gen_crc_clmul_constants(srsran_crc_t* h)
 {
-  uint64_t m, rmask = 0x1;
+  // Scaling the polynomial to degree 32 gives the checksum scaled by x^(32 - order) for every order
+  uint64_t p32 = ((uint64_t)h->polynom & (h->crcmask | h->crchighbit << 1U)) << (32U - h->order);
+  h->clmul_p32 = p32;
 
-  for (m = 0; m < nbits; m++) {
-    if ((rmask & crc) == 0x01)
-      crc = (crc ^ h->polynom) >> 1;
-    else
-      crc = crc >> 1;
+  // Barrett constant, polynomial division of x^64 by P32
+  uint64_t mu  = 1ULL << 32U;
+  uint64_t rem = (p32 & 0xffffffffULL) << 32U;
+  for (int i = 63; i >= 32; i--) {
+    if ((rem >> (uint32_t)i) & 1U) {
+      mu |= 1ULL << (uint32_t)(i - 32);
+      rem ^= p32 << (uint32_t)(i - 32);
+    }
   }
-  return (crc & h->crcmask);
+  h->clmul_mu = mu;
+
+  h->clmul_k64  = crc_clmul_xk_mod(p32, 64);
+  h->clmul_k96  = crc_clmul_xk_mod(p32, 96);
+  h->clmul_k128 = crc_clmul_xk_mod(p32, 128);
+  h->clmul_k192 = crc_clmul_xk_mod(p32, 192);
+  h->clmul_k512 = crc_clmul_xk_mod(p32, 512);
+  h->clmul_k576 = crc_clmul_xk_mod(p32, 576);
 }
 
 int srsran_crc_set_init(srsran_crc_t* crc_par, uint64_t crc_init_value)
@@ -89,75 +118,224 @@ int srsran_crc_init(srsran_crc_t* h, uint32_t crc_poly, int crc_order)
   // generate lookup table
   gen_crc_table(h);
 
+  // generate folding constants
+  gen_crc_clmul_constants(h);
+
   return 0;
 }
 
-uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len)
+#ifdef LV_HAVE_PCLMUL
+/*
+ * Carry-less multiplication folding
+ * ---------------------------------
+ *
+ * The data is taken in 128 bit blocks, the first byte being the most significant. A block X = H * x^64 + L followed by
+ * the block B is congruent modulo P32 with:
+ *     H * (x^192 mod P32) + L * (x^128 mod P32) + B
+ *
+ * which is at most 128 bit long again. Folding four independent blocks 512 bits ahead keeps the multiplier busy. The
+ * last block is multiplied by x^32, reduced to 64 bits and then to 32 bits with a Barrett reduction.
+ */
+static inline __m128i crc_clmul_load(const uint8_t* data)
 {
-  int      i, k, len8, res8, a = 0;
-  uint32_t crc = 0;
-  uint8_t* pter;
+  const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data), reverse);
+}
 
-  srsran_crc_set_init(h, 0);
+static inline __m128i crc_clmul_fold(__m128i x, __m128i k)
+{
+  return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00));
+}
 
-  // Pack bits into bytes
-  len8 = (len >> 3);
-  res8 = (len - (len8 << 3));
-  if (res8 > 0) {
-    a = 1;
+/**
+ * Updates the degree 32 scaled register reg32 with nof_blocks blocks of 16 bytes (at least one)
+ */
+static uint32_t crc_clmul_update(const srsran_crc_t* h, uint32_t reg32, const uint8_t* data, uint32_t nof_blocks)
+{
+  const __m128i k128 = _mm_set_epi64x((long long)h->clmul_k192, (long long)h->clmul_k128);
+  const __m128i k512 = _mm_set_epi64x((long long)h->clmul_k576, (long long)h->clmul_k512);
+
+  // The running register is added to the 32 most significant bits of the first block
+  __m128i x = _mm_xor_si128(crc_clmul_load(data), _mm_slli_si128(_mm_cvtsi32_si128((int)reg32), 12));
+  data += 16;
+  nof_blocks--;
+
+#ifdef LV_HAVE_VPCLMUL
+  if (nof_blocks >= 15) {
+    const __m512i reverse = _mm512_broadcast_i32x4(_mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+    const __m512i k       = _mm512_broadcast_i32x4(k512);
+
+    // The first lane holds x, the other three the following blocks
+    __m512i acc = _mm512_shuffle_epi8(_mm512_loadu_si512((const void*)(data - 16)), reverse);
+    acc         = _mm512_inserti32x4(acc, x, 0);
+    data += 48;
+    nof_blocks -= 3;
+
+    for (; nof_blocks >= 4; nof_blocks -= 4) {
+      __m512i b = _mm512_shuffle_epi8(_mm512_loadu_si512((const void*)data), reverse);
+      acc       = _mm512_ternarylogic_epi64(
+          _mm512_clmulepi64_epi128(acc, k, 0x11), _mm512_clmulepi64_epi128(acc, k, 0x00), b, 0x96);
+      data += 64;
+    }
+
+    // Fold the lanes into a single block
+    x = _mm512_castsi512_si128(acc);
+    x = _mm_xor_si128(crc_clmul_fold(x, k128), _mm512_extracti32x4_epi32(acc, 1));
+    x = _mm_xor_si128(crc_clmul_fold(x, k128), _mm512_extracti32x4_epi32(acc, 2));
+    x = _mm_xor_si128(crc_clmul_fold(x, k128), _mm512_extracti32x4_epi32(acc, 3));
   }
+#endif /* LV_HAVE_VPCLMUL */
 
-  // Calculate CRC
-  for (i = 0; i < len8 + a; i++) {
-    pter = (uint8_t*)(data + 8 * i);
-    uint8_t byte;
-    if (i == len8) {
-      byte = 0x00;
-      for (k = 0; k < res8; k++) {
-        byte |= ((uint8_t) * (pter + k)) << (7 - k);
-      }
-    } else {
+  if (nof_blocks >= 7) {
+    __m128i x1 = crc_clmul_load(data);
+    __m128i x2 = crc_clmul_load(data + 16);
+    __m128i x3 = crc_clmul_load(data + 32);
+    data += 48;
+    nof_blocks -= 3;
+
+    for (; nof_blocks >= 4; nof_blocks -= 4) {
+      x  = _mm_xor_si128(crc_clmul_fold(x, k512), crc_clmul_load(data));
+      x1 = _mm_xor_si128(crc_clmul_fold(x1, k512), crc_clmul_load(data + 16));
+      x2 = _mm_xor_si128(crc_clmul_fold(x2, k512), crc_clmul_load(data + 32));
+      x3 = _mm_xor_si128(crc_clmul_fold(x3, k512), crc_clmul_load(data + 48));
+      data += 64;
+    }
+
+    x = _mm_xor_si128(crc_clmul_fold(x, k128), x1);
+    x = _mm_xor_si128(crc_clmul_fold(x, k128), x2);
+    x = _mm_xor_si128(crc_clmul_fold(x, k128), x3);
+  }
+
+  for (; nof_blocks > 0; nof_blocks--) {
+    x = _mm_xor_si128(crc_clmul_fold(x, k128), crc_clmul_load(data));
+    data += 16;
+  }
+
+  // x * x^32 = H * x^96 + L * x^32, at most 96 bits
+  const __m128i kr = _mm_set_epi64x((long long)h->clmul_k96, (long long)h->clmul_k64);
+  __m128i       y  = _mm_xor_si128(_mm_clmulepi64_si128(x, kr, 0x11), _mm_slli_si128(_mm_move_epi64(x), 4));
+
+  // Fold the upper 32 bits, at most 64 bits
+  __m128i z = _mm_xor_si128(_mm_clmulepi64_si128(_mm_srli_si128(y, 8), kr, 0x00), _mm_move_epi64(y));
+
+  // Barrett reduction, q = floor(floor(z / x^32) * mu / x^32) and crc = z + q * P32
+  const __m128i mp = _mm_set_epi64x((long long)h->clmul_p32, (long long)h->clmul_mu);
+  __m128i       q  = _mm_srli_epi64(_mm_clmulepi64_si128(_mm_srli_epi64(z, 32), mp, 0x00), 32);
+  z                = _mm_xor_si128(z, _mm_clmulepi64_si128(q, mp, 0x10));
+
+  return (uint32_t)_mm_cvtsi128_si32(z);
+}
+#endif /* LV_HAVE_PCLMUL */
+
+void srsran_crc_checksum_put_bytes(srsran_crc_t* h, const uint8_t* data, uint32_t nof_bytes)
+{
+  uint32_t i = 0;
+
+#ifdef LV_HAVE_PCLMUL
+  // Below a few blocks the table is as fast as setting the folding up
+  if (nof_bytes >= 64) {
+    uint32_t shift = 32U - (uint32_t)h->order;
+    uint32_t reg32 = crc_clmul_update(h, (uint32_t)(h->crcinit << shift), data, nof_bytes / 16);
+    h->crcinit     = (uint64_t)(reg32 >> shift);
+    i              = nof_bytes & ~15U;
+  }
+#endif /* LV_HAVE_PCLMUL */
+
+  for (; i < nof_bytes; i++) {
+    srsran_crc_checksum_put_byte(h, data[i]);
+  }
+}
+
+/**
+ * Packs nof_bytes * 8 unpacked bits, MSB first
+ */
+static void crc_pack_bits(const uint8_t* bits, uint8_t* bytes, uint32_t nof_bytes)
+{
+  uint32_t i = 0;
+#ifdef LV_HAVE_AVX2
+  for (; i + 4 <= nof_bytes; i += 4) {
+    // Get 32 bits
+    __m256i mask = _mm256_cmpgt_epi8(_mm256_loadu_si256((const __m256i*)&bits[8 * i]), _mm256_setzero_si256());
+
+    // Reverse every 8 bits
+    mask = _mm256_shuffle_epi8(mask,
+                               _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                                7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8));
+
+    // Get mask and write
+    uint32_t word = (uint32_t)_mm256_movemask_epi8(mask);
+    memcpy(&bytes[i], &word, 4);
+  }
+#endif /* LV_HAVE_AVX2 */
 #ifdef LV_HAVE_SSE
-      // Get 8 Bit
-      __m64 mask = _mm_cmpgt_pi8(*((__m64*)pter), _mm_set1_pi8(0));
+  for (; i + 2 <= nof_bytes; i += 2) {
+    // Get 16 bits
+    __m128i mask = _mm_cmpgt_epi8(_mm_loadu_si128((const __m128i*)&bits[8 * i]), _mm_setzero_si128());
 
-      // Reverse
-      mask = _mm_shuffle_pi8(mask, _mm_set_pi8(0, 1, 2, 3, 4, 5, 6, 7));
+    // Reverse every 8 bits
+    mask = _mm_shuffle_epi8(mask, _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8));
 
-      // Get mask and write
-      byte = (uint8_t)_mm_movemask_pi8(mask);
-#else  /* LV_HAVE_SSE */
-      byte = (uint8_t)(srsran_bit_pack(&pter, 8) & 0xFF);
+    // Get mask and write
+    uint16_t word = (uint16_t)_mm_movemask_epi8(mask);
+    memcpy(&bytes[i], &word, 2);
+  }
 #endif /* LV_HAVE_SSE */
+  for (; i < nof_bytes; i++) {
+    uint8_t byte = 0;
+    for (uint32_t k = 0; k < 8; k++) {
+      byte |= (uint8_t)((bits[8 * i + k] > 0) << (7U - k));
     }
-    srsran_crc_checksum_put_byte(h, byte);
+    bytes[i] = byte;
   }
-  crc = (uint32_t)srsran_crc_checksum_get(h);
+}
+
+// Number of bits packed at once by srsran_crc_checksum_put_bits()
+#define CRC_PACK_BYTES 512
+
+void srsran_crc_checksum_put_bits(srsran_crc_t* h, const uint8_t* bits, uint32_t nof_bits)
+{
+  uint8_t  bytes[CRC_PACK_BYTES];
+  uint32_t nof_bytes = nof_bits / 8;
 
-  // Reverse CRC res8 positions
-  if (a == 1) {
-    crc = reversecrcbit(crc, 8 - res8, h);
+  // Whole bytes
+  for (uint32_t i = 0; i < nof_bytes; i += CRC_PACK_BYTES) {
+    uint32_t n = SRSRAN_MIN(CRC_PACK_BYTES, nof_bytes - i);
+    crc_pack_bits(&bits[8 * i], bytes, n);
+    srsran_crc_checksum_put_bytes(h, bytes, n);
   }
 
+  // Spare bits, one at a time
+  uint64_t crc = h->crcinit;
+  for (uint32_t i = 8 * nof_bytes; i < nof_bits; i++) {
+    bool feedback = ((crc & h->crchighbit) != 0) != (bits[i] > 0);
+    crc           = (crc << 1U) & h->crcmask;
+    if (feedback) {
+      crc ^= (uint64_t)h->polynom & h->crcmask;
+    }
+  }
+  h->crcinit = crc;
+}
+
+uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len)
+{
+  srsran_crc_set_init(h, 0);
+
+  // Calculate CRC
+  srsran_crc_checksum_put_bits(h, data, (uint32_t)len);
+
   // Return CRC value
-  return crc;
+  return (uint32_t)srsran_crc_checksum_get(h);
 }
 
 // len is multiple of 8
 uint32_t srsran_crc_checksum_byte(srsran_crc_t* h, const uint8_t* data, int len)
 {
-  int      i;
-  uint32_t crc = 0;
-
   srsran_crc_set_init(h, 0);
 
   // Calculate CRC
-  for (i = 0; i < len / 8; i++) {
-    srsran_crc_checksum_put_byte(h, data[i]);
-  }
-  crc = (uint32_t)srsran_crc_checksum_get(h);
+  srsran_crc_checksum_put_bytes(h, data, (uint32_t)len / 8);
 
-  return crc;
+  return (uint32_t)srsran_crc_checksum_get(h);
 }
 
 uint32_t srsran_crc_attach_byte(srsran_crc_t* h, uint8_t* data, int len)
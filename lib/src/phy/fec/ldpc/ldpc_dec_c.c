@@ -329,16 +329,18 @@ int extract_ldpc_message_c(void* p, uint8_t* message, uint16_t liftK)
 
   struct ldpc_regs_c* vp = p;
 
+  int ret = 0;
+
   for (int i = 0; i < liftK; i++) {
     float soft_bit = vp->soft_bits[i];
+    // Undecided bits are set to one and invalidate the message
     if (soft_bit == 0) {
-      memset(message, 1, liftK);
-      return -1;
+      ret = -1;
     }
-    message[i] = (soft_bit < 0);
+    message[i] = (soft_bit <= 0);
   }
 
-  return 0;
+  return ret;
 }
 
 void inner_var_to_check_c(const int8_t* x, const int8_t* y, int8_t* z, const uint8_t clip, const uint32_t len)
@@ -393,20 +393,13 @@ int extract_ldpc_message_c_avx2(void* p, uint8_t* message, uint16_t liftK)
 
   struct ldpc_regs_c_avx2* vp = p;
 
-  int j = 0;
-
+  // Undecided bits are set to one and invalidate the message
+  int nof_null = 0;
   for (int i = 0; i < liftK / vp->ls; i++) {
-    for (j = 0; j < vp->ls; j++) {
-      int8_t soft_bit = vp->soft_bits.c[i * SRSRAN_AVX2_B_SIZE + j];
-      if (soft_bit == 0) {
-        memset(message, 1, liftK);
-        return -1;
-      }
-      message[i * vp->ls + j] = (soft_bit < 0);
-    }
+    nof_null += fec_avx2_hard_decision_null_c(&vp->soft_bits.c[i * SRSRAN_AVX2_B_SIZE], &message[i * vp->ls], vp->ls);
   }
 
-  return 0;
+  return (nof_null > 0) ? -1 : 0;
 }
 
 static void
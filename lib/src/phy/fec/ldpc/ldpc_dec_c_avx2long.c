@@ -460,23 +460,13 @@ int extract_ldpc_message_c_avx2long(void* p, uint8_t* message, uint16_t liftK)
 
   struct ldpc_regs_c_avx2long* vp = p;
 
-  int j = 0;
-  int k = 0;
-
+  // Undecided bits are set to one and invalidate the message
+  int nof_null = 0;
   for (int i = 0; i < liftK / vp->ls; i++) {
-    for (j = 0; j < vp->n_subnodes; j++) {
-      for (k = 0; (k < SRSRAN_AVX2_B_SIZE) && (j * SRSRAN_AVX2_B_SIZE + k < vp->ls); k++) {
-        int8_t soft_bit = vp->soft_bits[i * vp->n_subnodes + j].c[k];
-        if (soft_bit == 0) {
-          memset(message, 1, liftK);
-          return -1;
-        }
-        message[i * vp->ls + j * SRSRAN_AVX2_B_SIZE + k] = (soft_bit < 0);
-      }
-    }
+    nof_null += fec_avx2_hard_decision_null_c(vp->soft_bits[i * vp->n_subnodes].c, &message[i * vp->ls], vp->ls);
   }
 
-  return 0;
+  return (nof_null > 0) ? -1 : 0;
 }
 
 static void
@@ -238,21 +238,16 @@ int extract_ldpc_message_c_avx512(void* p, uint8_t* message, uint16_t liftK)
   if (p == NULL) {
     return -1;
   }
+
   struct ldpc_regs_c_avx512* vp = p;
 
-  int ini = 0;
-  for (int i = 0; i < liftK; i = i + vp->ls) {
-    for (int j = 0; j < vp->ls; j++) {
-      if (vp->soft_bits.c[ini + j] == 0) {
-        memset(message, 1, liftK);
-        return -1;
-      }
-    }
-    fec_avx512_hard_decision_c(&vp->soft_bits.c[ini], &message[i], vp->ls);
-    ini = ini + SRSRAN_AVX512_B_SIZE;
+  // Undecided bits are set to one and invalidate the message
+  int nof_null = 0;
+  for (int i = 0; i < liftK / vp->ls; i++) {
+    nof_null += fec_avx512_hard_decision_null_c(&vp->soft_bits.c[i * SRSRAN_AVX512_B_SIZE], &message[i * vp->ls], vp->ls);
   }
 
-  return 0;
+  return (nof_null > 0) ? -1 : 0;
 }
 
 int update_ldpc_var_to_check_c_avx512(void* p, int i_layer)
@@ -30,6 +30,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "../utils_avx2.h"
 #include "../utils_avx512.h"
@@ -41,6 +42,106 @@
 
 #define LDPC_DECODER_DEFAULT_MAX_NOF_ITER 10 /*!< \brief Default maximum number of iterations of the BP algorithm. */
 
+/*!
+ * \brief Tracks the convergence of the decoder along the iterations.
+ */
+typedef struct {
+  uint32_t best_weight; /*!< \brief Lowest number of unsatisfied parity checks so far. */
+  uint32_t nof_stalled; /*!< \brief Number of consecutive iterations that did not lower best_weight. */
+} ldpc_decoder_progress_t;
+
+/*! Returns the number of unsatisfied parity checks of the first n_layers layers for the bits in q->hard_bits. */
+static uint32_t ldpc_decoder_syndrome_weight(srsran_ldpc_decoder_t* q, uint8_t n_layers)
+{
+  uint16_t ls     = q->ls;
+  uint32_t n_vars = q->bgK + n_layers;
+  uint32_t weight = 0;
+
+  for (uint32_t i_layer = 0; i_layer < n_layers; i_layer++) {
+    const uint16_t* this_pcm = q->pcm + i_layer * q->bgN;
+
+    srsran_vec_u8_zero(q->syndrome, ls);
+    for (uint32_t i_var = 0; i_var < n_vars; i_var++) {
+      uint16_t shift = this_pcm[i_var];
+      if (shift == NO_CNCT) {
+        continue;
+      }
+
+      // The i-th check node of the layer is connected to the bit (i + shift) % ls of the variable node
+      const uint8_t* bits = q->hard_bits + i_var * ls;
+      uint16_t       n    = ls - shift;
+      srsran_vec_xor_bbb(q->syndrome, bits + shift, q->syndrome, n);
+      srsran_vec_xor_bbb(q->syndrome + n, bits, q->syndrome + n, shift);
+    }
+
+    // Checks are either 0 or 1, count them 8 at a time
+    uint16_t i = 0;
+    for (; i + 8 <= ls; i += 8) {
+      uint64_t checks;
+      memcpy(&checks, q->syndrome + i, sizeof(checks));
+      weight += (uint32_t)__builtin_popcountll(checks);
+    }
+    for (; i < ls; i++) {
+      weight += q->syndrome[i];
+    }
+  }
+
+  return weight;
+}
+
+/*!
+ * Checks the current hard decisions after an iteration. Returns true if the decoding must stop and, in that case, sets
+ * q->last_stop and writes the decoded message.
+ */
+static bool ldpc_decoder_early_stop(srsran_ldpc_decoder_t* q,
+                                    int (*extract)(void*, uint8_t*, uint16_t),
+                                    uint8_t*                 message,
+                                    uint8_t                  n_layers,
+                                    srsran_crc_t*            crc,
+                                    ldpc_decoder_progress_t* progress)
+{
+  // With a CRC, only the message bits need to be decided, as in the decoding loop without early stop
+  if (crc != NULL) {
+    if (extract(q->ptr, message, q->liftK) == 0 && srsran_crc_match(crc, message, q->liftK - crc->order)) {
+      q->last_stop = SRSRAN_LDPC_DECODER_STOP_CRC;
+      return true;
+    }
+  }
+
+  // The CRC is a stronger check than the syndrome, which is only used without it
+  bool syndrome_stop = q->syndrome_check && crc == NULL;
+  if (!syndrome_stop && q->early_abort_iter == 0) {
+    return false;
+  }
+
+  // Undecided bits (null soft bits) are set to one, the codeword is only valid if there are none of them
+  bool     decided = extract(q->ptr, q->hard_bits, (q->bgK + n_layers) * q->ls) == 0;
+  uint32_t weight  = ldpc_decoder_syndrome_weight(q, n_layers);
+
+  if (syndrome_stop && decided && weight == 0) {
+    // The hard decisions are a codeword, further iterations would only make it more reliable
+    q->last_stop = SRSRAN_LDPC_DECODER_STOP_SYNDROME;
+  } else if (q->early_abort_iter > 0) {
+    if (weight < progress->best_weight) {
+      progress->best_weight = weight;
+      progress->nof_stalled = 0;
+    } else {
+      progress->nof_stalled++;
+    }
+
+    if (progress->nof_stalled >= q->early_abort_iter) {
+      q->last_stop = SRSRAN_LDPC_DECODER_STOP_ABORT;
+    }
+  }
+
+  if (q->last_stop == SRSRAN_LDPC_DECODER_STOP_MAX_ITER) {
+    return false;
+  }
+
+  memcpy(message, q->hard_bits, q->liftK);
+  return true;
+}
+
 #define LDPC_DECODER_TEMPLATE(LLR_TYPE, SUFFIX)                                                                        \
   static int decode_##SUFFIX(                                                                                          \
       void* o, const LLR_TYPE* llrs, uint8_t* message, uint32_t cdwd_rm_length, srsran_crc_t* crc)                     \
@@ -72,6 +173,10 @@
     /* the first two variable nodes from the final codeword.*/                                                         \
     uint8_t n_layers = cdwd_rm_length / q->ls - q->bgK + 2;                                                            \
                                                                                                                        \
+    ldpc_decoder_progress_t progress      = {UINT32_MAX, 0};                                                           \
+    bool                    early_stop_en = q->syndrome_check || q->early_abort_iter > 0;                              \
+    q->last_stop                          = SRSRAN_LDPC_DECODER_STOP_MAX_ITER;                                         \
+                                                                                                                       \
     for (int i_iteration = 0; i_iteration < q->max_nof_iter; i_iteration++) {                                          \
       for (int i_layer = 0; i_layer < n_layers; i_layer++) {                                                           \
         update_ldpc_var_to_check_##SUFFIX(q->ptr, i_layer);                                                            \
@@ -84,17 +189,32 @@
         update_ldpc_soft_bits_##SUFFIX(q->ptr, i_layer, these_var_indices);                                            \
       }                                                                                                                \
                                                                                                                        \
+      q->last_nof_iter = i_iteration + 1;                                                                              \
+                                                                                                                       \
+      if (early_stop_en) {                                                                                             \
+        if (ldpc_decoder_early_stop(q, extract_ldpc_message_##SUFFIX, message, n_layers, crc, &progress)) {            \
+          break;                                                                                                       \
+        }                                                                                                              \
+        continue;                                                                                                      \
+      }                                                                                                                \
+                                                                                                                       \
       if (crc != NULL) {                                                                                               \
         if (extract_ldpc_message_##SUFFIX(q->ptr, message, q->liftK) < 0) {                                            \
           continue;                                                                                                    \
         }                                                                                                              \
                                                                                                                        \
         if (srsran_crc_match(crc, message, q->liftK - crc->order)) {                                                   \
+          q->last_stop = SRSRAN_LDPC_DECODER_STOP_CRC;                                                                 \
           return i_iteration + 1;                                                                                      \
         }                                                                                                              \
       }                                                                                                                \
     }                                                                                                                  \
                                                                                                                        \
+    /* The message has already been extracted if the decoding stopped early */                                         \
+    if (q->last_stop != SRSRAN_LDPC_DECODER_STOP_MAX_ITER) {                                                           \
+      return (crc != NULL && q->last_stop != SRSRAN_LDPC_DECODER_STOP_CRC) ? 0 : (int)q->last_nof_iter;                \
+    }                                                                                                                  \
+                                                                                                                       \
     /* If reached here, and CRC is being checked, it has failed */                                                     \
     if (crc != NULL) {                                                                                                 \
       return 0;                                                                                                        \
@@ -135,6 +255,10 @@
     /* the first two variable nodes from the final codeword.*/                                                         \
     uint8_t n_layers = cdwd_rm_length / q->ls - q->bgK + 2;                                                            \
                                                                                                                        \
+    ldpc_decoder_progress_t progress      = {UINT32_MAX, 0};                                                           \
+    bool                    early_stop_en = q->syndrome_check || q->early_abort_iter > 0;                              \
+    q->last_stop                          = SRSRAN_LDPC_DECODER_STOP_MAX_ITER;                                         \
+                                                                                                                       \
     for (int i_iteration = 0; i_iteration < 2 * q->max_nof_iter; i_iteration++) {                                      \
       for (int i_layer = 0; i_layer < n_layers; i_layer++) {                                                           \
         update_ldpc_var_to_check_##SUFFIX(q->ptr, i_layer);                                                            \
@@ -149,15 +273,30 @@
                                                                                                                        \
       update_ldpc_soft_bits_##SUFFIX(q->ptr, q->var_indices);                                                          \
                                                                                                                        \
+      q->last_nof_iter = i_iteration + 1;                                                                              \
+                                                                                                                       \
+      if (early_stop_en) {                                                                                             \
+        if (ldpc_decoder_early_stop(q, extract_ldpc_message_##SUFFIX, message, n_layers, crc, &progress)) {            \
+          break;                                                                                                       \
+        }                                                                                                              \
+        continue;                                                                                                      \
+      }                                                                                                                \
+                                                                                                                       \
       if (crc != NULL) {                                                                                               \
         extract_ldpc_message_##SUFFIX(q->ptr, message, q->liftK);                                                      \
                                                                                                                        \
         if (srsran_crc_match(crc, message, q->liftK - crc->order)) {                                                   \
+          q->last_stop = SRSRAN_LDPC_DECODER_STOP_CRC;                                                                 \
           return i_iteration + 1;                                                                                      \
         }                                                                                                              \
       }                                                                                                                \
     }                                                                                                                  \
                                                                                                                        \
+    /* The message has already been extracted if the decoding stopped early */                                         \
+    if (q->last_stop != SRSRAN_LDPC_DECODER_STOP_MAX_ITER) {                                                           \
+      return (crc != NULL && q->last_stop != SRSRAN_LDPC_DECODER_STOP_CRC) ? 0 : (int)q->last_nof_iter;                \
+    }                                                                                                                  \
+                                                                                                                       \
     /* If reached here, and CRC is being checked, it has failed */                                                     \
     if (crc != NULL) {                                                                                                 \
       return 0;                                                                                                        \
@@ -608,6 +747,19 @@ int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder
   }
   q->scaling_fctr = scaling_fctr;
 
+  q->syndrome_check   = args->syndrome_check;
+  q->early_abort_iter = args->early_abort_iter;
+  q->hard_bits        = srsran_vec_u8_malloc(q->liftN);
+  q->syndrome         = srsran_vec_u8_malloc(q->ls);
+  if (!q->hard_bits || !q->syndrome) {
+    perror("malloc");
+    free(q->hard_bits);
+    free(q->syndrome);
+    free(q->var_indices);
+    free(q->pcm);
+    return -1;
+  }
+
   switch (type) {
     case SRSRAN_LDPC_DECODER_F:
       return init_f(q);
@@ -653,6 +805,12 @@ void srsran_ldpc_decoder_free(srsran_ldpc_decoder_t* q)
   if (q->free) {
     q->free(q);
   }
+  if (q->hard_bits) {
+    free(q->hard_bits);
+  }
+  if (q->syndrome) {
+    free(q->syndrome);
+  }
   bzero(q, sizeof(srsran_ldpc_decoder_t));
 }
 
@@ -40,6 +40,10 @@
 
 #include "srsran/phy/utils/debug.h"
 
+#ifdef LV_HAVE_SSE
+#include <immintrin.h>
+#endif // LV_HAVE_SSE
+
 //#define debug
 /*!
  * \brief Look-up table: k0 indices
@@ -87,24 +91,21 @@ struct pRM_tx {
  * \brief Describes an rate dematcher (float version).
  */
 struct pRM_rx_f {
-  float*    tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-  uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
+  float* tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
 };
 
 /*!
  * \brief Describes an rate dematcher (short version).
  */
 struct pRM_rx_s {
-  int16_t*  tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-  uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
+  int16_t* tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
 };
 
 /*!
  * \brief Describes an rate dematcher (char version).
  */
 struct pRM_rx_c {
-  int8_t*   tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-  uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
+  int8_t* tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
 };
 
 /*!
@@ -192,6 +193,108 @@ static void bit_selection_rm_tx(const uint8_t* input,
   } // while
 }
 
+/*!
+ * Computes the length of the next contiguous run of the circular buffer, starting at *icwd, that does not contain
+ * filler bits. It advances *icwd past the filler bits and wraps it around Ncb if required.
+ */
+static inline uint32_t bit_selection_rm_rx_run(uint32_t*      icwd,
+                                               const uint32_t remaining,
+                                               const uint32_t ini_exclude,
+                                               const uint32_t end_exclude,
+                                               const uint32_t Ncb)
+{
+  for (;;) {
+    if (*icwd >= Ncb) {
+      *icwd = 0;
+    } else if (*icwd >= ini_exclude && *icwd < end_exclude) { // avoid filler bits
+      *icwd = end_exclude;
+    } else {
+      break;
+    }
+  }
+
+  uint32_t stop = (*icwd < ini_exclude) ? SRSRAN_MIN(ini_exclude, Ncb) : Ncb;
+  return SRSRAN_MIN(stop - *icwd, remaining);
+}
+
+/*!
+ * Adds len soft bits to the ones already in the buffer (int16_t), saturating to +/- infinity15.
+ */
+static void bit_selection_rm_rx_combine_s(const int16_t* input, int16_t* output, const uint32_t len)
+{
+  // Messages use a 15-bit quantization. Soft bits use the remaining bit to denote infinity.
+  const int16_t infinity15 = (1U << 14U) - 1;
+  uint32_t      i          = 0;
+
+#ifdef LV_HAVE_AVX2
+  const __m256i max256 = _mm256_set1_epi16(infinity15);
+  const __m256i min256 = _mm256_set1_epi16(-infinity15);
+  for (; i + 16 <= len; i += 16) {
+    __m256i a = _mm256_loadu_si256((const __m256i*)&input[i]);
+    __m256i b = _mm256_loadu_si256((__m256i*)&output[i]);
+    __m256i c = _mm256_min_epi16(_mm256_max_epi16(_mm256_adds_epi16(a, b), min256), max256);
+    _mm256_storeu_si256((__m256i*)&output[i], c);
+  }
+#endif // LV_HAVE_AVX2
+
+#ifdef LV_HAVE_SSE
+  const __m128i max128 = _mm_set1_epi16(infinity15);
+  const __m128i min128 = _mm_set1_epi16(-infinity15);
+  for (; i + 8 <= len; i += 8) {
+    __m128i a = _mm_loadu_si128((const __m128i*)&input[i]);
+    __m128i b = _mm_loadu_si128((__m128i*)&output[i]);
+    __m128i c = _mm_min_epi16(_mm_max_epi16(_mm_adds_epi16(a, b), min128), max128);
+    _mm_storeu_si128((__m128i*)&output[i], c);
+  }
+#endif // LV_HAVE_SSE
+
+  for (; i < len; i++) {
+    long tmp  = (long)output[i] + input[i];
+    tmp       = SRSRAN_MIN(tmp, infinity15);
+    tmp       = SRSRAN_MAX(tmp, -infinity15);
+    output[i] = (int16_t)tmp;
+  }
+}
+
+/*!
+ * Adds len soft bits to the ones already in the buffer (int8_t), saturating to +/- infinity7.
+ */
+static void bit_selection_rm_rx_combine_c(const int8_t* input, int8_t* output, const uint32_t len)
+{
+  // Messages use a 7-bit quantization. Soft bits use the remaining bit to denote infinity.
+  const int8_t infinity7 = (1U << 6U) - 1;
+  uint32_t     i         = 0;
+
+#ifdef LV_HAVE_AVX2
+  const __m256i max256 = _mm256_set1_epi8(infinity7);
+  const __m256i min256 = _mm256_set1_epi8(-infinity7);
+  for (; i + 32 <= len; i += 32) {
+    __m256i a = _mm256_loadu_si256((const __m256i*)&input[i]);
+    __m256i b = _mm256_loadu_si256((__m256i*)&output[i]);
+    __m256i c = _mm256_min_epi8(_mm256_max_epi8(_mm256_adds_epi8(a, b), min256), max256);
+    _mm256_storeu_si256((__m256i*)&output[i], c);
+  }
+#endif // LV_HAVE_AVX2
+
+#ifdef LV_HAVE_SSE
+  const __m128i max128 = _mm_set1_epi8(infinity7);
+  const __m128i min128 = _mm_set1_epi8(-infinity7);
+  for (; i + 16 <= len; i += 16) {
+    __m128i a = _mm_loadu_si128((const __m128i*)&input[i]);
+    __m128i b = _mm_loadu_si128((__m128i*)&output[i]);
+    __m128i c = _mm_min_epi8(_mm_max_epi8(_mm_adds_epi8(a, b), min128), max128);
+    _mm_storeu_si128((__m128i*)&output[i], c);
+  }
+#endif // LV_HAVE_SSE
+
+  for (; i < len; i++) {
+    long tmp  = (long)output[i] + input[i];
+    tmp       = SRSRAN_MIN(tmp, infinity7);
+    tmp       = SRSRAN_MAX(tmp, -infinity7);
+    output[i] = (int8_t)tmp;
+  }
+}
+
 /*!
  * Undoes bit selection for the rate-dematching block.
  * The output has the codeword length N. It inserts filler bits as INFINITY symbols
@@ -199,72 +302,49 @@ static void bit_selection_rm_tx(const uint8_t* input,
  * missing symbol. Repeated symbols are added.
  * The input memory *output shall be either initialized to all zeros or to the
  * result of previous redundancy versions is available.
+ * The soft bits are combined with the buffer in contiguous runs of the circular buffer.
  */
 static void bit_selection_rm_rx(const float*   input,
                                 const uint32_t in_len,
                                 float*         output,
-                                uint32_t*      indices,
                                 const uint32_t ini_exclude,
                                 const uint32_t end_exclude,
                                 const uint32_t k0,
                                 const uint32_t Ncb)
 {
-  uint32_t E = in_len;
-
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
-
   // set filler bits to INFINITY
   for (uint32_t i = ini_exclude; i < end_exclude; i++) {
     output[i] = INFINITY;
   }
 
   // Add soft bits, in case of repetition
-  for (uint32_t i = 0; i < E; i++) {
-    output[indices[i]] = output[indices[i]] + input[i];
+  uint32_t k    = 0;
+  uint32_t icwd = k0;
+  while (k < in_len) {
+    uint32_t len = bit_selection_rm_rx_run(&icwd, in_len - k, ini_exclude, end_exclude, Ncb);
+    srsran_vec_sum_fff(&output[icwd], &input[k], &output[icwd], len);
+    k += len;
+    icwd += len;
   }
 }
 
 /*!
- * Undoes bit selection for the rate-dematching block.
+ * Undoes bit selection for the rate-dematching block (int16_t).
  * The output has the codeword length N. It inserts filler bits as INFINITY symbols
  * (to indicate very reliable 0 bit), and set to 0 (completely unknown bit) all
  * missing symbol. Repeated symbols are added.
  * The input memory *output shall be either initialized to all zeros or to the
  * result of previous redundancy versions is available.
+ * The soft bits are combined with the buffer in contiguous runs of the circular buffer.
  */
 static void bit_selection_rm_rx_s(const int16_t* input,
                                   const uint32_t in_len,
                                   int16_t*       output,
-                                  uint32_t*      indices,
                                   const uint32_t ini_exclude,
                                   const uint32_t end_exclude,
                                   const uint32_t k0,
                                   const uint32_t Ncb)
 {
-  uint32_t E = in_len;
-
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
-
   // set filler bits to INFINITY
   const long infinity16 = (1U << 15U) - 1; // Max positive value in 16-bit representation
   for (uint32_t i = ini_exclude; i < end_exclude; i++) {
@@ -272,19 +352,14 @@ static void bit_selection_rm_rx_s(const int16_t* input,
   }
 
   // Add soft bits, in case of repetition
-  const int16_t infinity15 =
-      (1U << 14U) - 1; // Messages use a 15-bit quantization. Soft bits use the remaining bit to denote infinity.
   // input is assume to be quantized from -infinity15 to infinity15. Only filler bits can be infinity16
-  long tmp = 0;
-  for (uint32_t i = 0; i < E; i++) {
-    tmp = (long)output[indices[i]] + input[i];
-    if (tmp > infinity15) {
-      tmp = infinity15;
-    }
-    if (tmp < -infinity15) {
-      tmp = -infinity15;
-    }
-    output[indices[i]] = (int16_t)tmp;
+  uint32_t k    = 0;
+  uint32_t icwd = k0;
+  while (k < in_len) {
+    uint32_t len = bit_selection_rm_rx_run(&icwd, in_len - k, ini_exclude, end_exclude, Ncb);
+    bit_selection_rm_rx_combine_s(&input[k], &output[icwd], len);
+    k += len;
+    icwd += len;
   }
 }
 
@@ -295,30 +370,16 @@ static void bit_selection_rm_rx_s(const int16_t* input,
  * missing symbol. Repeated symbols are added.
  * The input memory *output shall be either initialized to all zeros or to the
  * result of previous redundancy versions is available.
+ * The soft bits are combined with the buffer in contiguous runs of the circular buffer.
  */
 static void bit_selection_rm_rx_c(const int8_t*  input,
                                   const uint32_t in_len,
                                   int8_t*        output,
-                                  uint32_t*      indices,
                                   const uint32_t ini_exclude,
                                   const uint32_t end_exclude,
                                   const uint32_t k0,
                                   const uint32_t Ncb)
 {
-  uint32_t E = in_len;
-
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
-
   // set filler bits to INFINITY
   const long infinity8 = (1U << 7U) - 1; // Max positive value in 8-bit representation
   for (uint32_t i = ini_exclude; i < end_exclude; i++) {
@@ -326,19 +387,14 @@ static void bit_selection_rm_rx_c(const int8_t*  input,
   }
 
   // Add soft bits, in case of repetition
-  const int16_t infinity7 =
-      (1U << 6U) - 1; // Messages use a 15-bit quantization. Soft bits use the remaining bit to denote infinity.
-  // input is assume to be quantized from -infinity15 to infinity15. Only filler bits can be infinity16
-  long tmp = 0;
-  for (uint32_t i = 0; i < E; i++) {
-    tmp = (long)output[indices[i]] + input[i];
-    if (tmp > infinity7) {
-      tmp = infinity7;
-    }
-    if (tmp < -infinity7) {
-      tmp = -infinity7;
-    }
-    output[indices[i]] = (int8_t)tmp;
+  // input is assume to be quantized from -infinity7 to infinity7. Only filler bits can be infinity8
+  uint32_t k    = 0;
+  uint32_t icwd = k0;
+  while (k < in_len) {
+    uint32_t len = bit_selection_rm_rx_run(&icwd, in_len - k, ini_exclude, end_exclude, Ncb);
+    bit_selection_rm_rx_combine_c(&input[k], &output[icwd], len);
+    k += len;
+    icwd += len;
   }
 }
 
@@ -360,20 +416,128 @@ bit_interleaver_rm_tx(const uint8_t* input, uint8_t* output, const uint32_t in_o
 }
 
 /*!
- * Bit deinterleaver (float)
+ * Generates a bit deinterleaver with a fixed number of rows, so that the compiler can unroll the inner loop.
  */
-static void
-bit_interleaver_rm_rx(const float* input, float* output, const uint32_t in_out_len, const uint32_t mod_order)
+#define BIT_INTERLEAVER_RM_RX_ROWS(SUFFIX, TYPE)                                                                      \
+  static inline void bit_interleaver_rm_rx_rows##SUFFIX(                                                              \
+      const TYPE* input, TYPE* output, const uint32_t j0, const uint32_t cols, const uint32_t rows)                   \
+  {                                                                                                                    \
+    for (uint32_t j = j0; j < cols; j++) {                                                                             \
+      for (uint32_t i = 0; i < rows; i++) {                                                                            \
+        output[i * cols + j] = input[j * rows + i];                                                                    \
+      }                                                                                                                \
+    }                                                                                                                  \
+  }                                                                                                                    \
+                                                                                                                       \
+  static void bit_interleaver_rm_rx_tail##SUFFIX(                                                                      \
+      const TYPE* input, TYPE* output, const uint32_t j0, const uint32_t cols, const uint32_t rows)                   \
+  {                                                                                                                    \
+    switch (rows) {                                                                                                    \
+      case 2:                                                                                                          \
+        bit_interleaver_rm_rx_rows##SUFFIX(input, output, j0, cols, 2);                                                \
+        break;                                                                                                         \
+      case 4:                                                                                                          \
+        bit_interleaver_rm_rx_rows##SUFFIX(input, output, j0, cols, 4);                                                \
+        break;                                                                                                         \
+      case 6:                                                                                                          \
+        bit_interleaver_rm_rx_rows##SUFFIX(input, output, j0, cols, 6);                                                \
+        break;                                                                                                         \
+      case 8:                                                                                                          \
+        bit_interleaver_rm_rx_rows##SUFFIX(input, output, j0, cols, 8);                                                \
+        break;                                                                                                         \
+      default:                                                                                                         \
+        bit_interleaver_rm_rx_rows##SUFFIX(input, output, j0, cols, rows);                                             \
+    }                                                                                                                  \
+  }
+
+BIT_INTERLEAVER_RM_RX_ROWS(_f, float)
+BIT_INTERLEAVER_RM_RX_ROWS(_s, int16_t)
+BIT_INTERLEAVER_RM_RX_ROWS(_c, int8_t)
+
+#ifdef LV_HAVE_SSE
+/*!
+ * Bit deinterleaver kernel (int8_t), 16 columns at a time. Every register holds a pair of consecutive symbols
+ * (2 * rows soft bits), shuffled so that the 16-bit word i contains the i-th soft bit of both symbols. An 8x8
+ * transpose of 16-bit words then leaves 16 consecutive soft bits of row i in register i.
+ * Returns the number of processed columns.
+ */
+static uint32_t bit_interleaver_rm_rx_c_sse(const int8_t* input, int8_t* output, const uint32_t cols, const uint32_t rows)
 {
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
+  static const int8_t pair_shuffle[4][16] = {
+      {0, 2, 1, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+      {0, 4, 1, 5, 2, 6, 3, 7, -1, -1, -1, -1, -1, -1, -1, -1},
+      {0, 6, 1, 7, 2, 8, 3, 9, 4, 10, 5, 11, -1, -1, -1, -1},
+      {0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15},
+  };
+
+  if (rows < 2 || rows > 8 || (rows % 2) != 0) {
+    return 0;
+  }
+
+  const __m128i shuffle = _mm_loadu_si128((const __m128i*)pair_shuffle[rows / 2 - 1]);
+  const uint32_t len     = cols * rows;
+
+  uint32_t j = 0;
+  // The last load of a block reads up to 16 - 2 * rows soft bits past the block, keep it within the input
+  for (; (j + 16) * rows + 16 <= len; j += 16) {
+    const int8_t* in = &input[j * rows];
+
+    __m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&in[0 * rows]), shuffle);
+    __m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&in[2 * rows]), shuffle);
+    __m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&in[4 * rows]), shuffle);
+    __m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&in[6 * rows]), shuffle);
+    __m128i w4 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&in[8 * rows]), shuffle);
+    __m128i w5 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&in[10 * rows]), shuffle);
+    __m128i w6 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&in[12 * rows]), shuffle);
+    __m128i w7 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&in[14 * rows]), shuffle);
+
+    // 8x8 transpose of 16-bit words
+    __m128i a0 = _mm_unpacklo_epi16(w0, w1);
+    __m128i a1 = _mm_unpackhi_epi16(w0, w1);
+    __m128i a2 = _mm_unpacklo_epi16(w2, w3);
+    __m128i a3 = _mm_unpackhi_epi16(w2, w3);
+    __m128i a4 = _mm_unpacklo_epi16(w4, w5);
+    __m128i a5 = _mm_unpackhi_epi16(w4, w5);
+    __m128i a6 = _mm_unpacklo_epi16(w6, w7);
+    __m128i a7 = _mm_unpackhi_epi16(w6, w7);
+
+    __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+    __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+    __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+    __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+    __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+    __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+    __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+    __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+
+    __m128i r[8];
+    r[0] = _mm_unpacklo_epi64(b0, b4);
+    r[1] = _mm_unpackhi_epi64(b0, b4);
+    r[2] = _mm_unpacklo_epi64(b1, b5);
+    r[3] = _mm_unpackhi_epi64(b1, b5);
+    r[4] = _mm_unpacklo_epi64(b2, b6);
+    r[5] = _mm_unpackhi_epi64(b2, b6);
+    r[6] = _mm_unpacklo_epi64(b3, b7);
+    r[7] = _mm_unpackhi_epi64(b3, b7);
+
     for (uint32_t i = 0; i < rows; i++) {
-      output[i * cols + j] = input[j * rows + i];
+      _mm_storeu_si128((__m128i*)&output[i * cols + j], r[i]);
     }
   }
+
+  return j;
+}
+#endif // LV_HAVE_SSE
+
+/*!
+ * Bit deinterleaver (float)
+ */
+static void
+bit_interleaver_rm_rx(const float* input, float* output, const uint32_t in_out_len, const uint32_t mod_order)
+{
+  uint32_t rows = mod_order;
+  uint32_t cols = in_out_len / rows;
+  bit_interleaver_rm_rx_tail_f(input, output, 0, cols, rows);
 }
 
 /*!
@@ -382,32 +546,26 @@ bit_interleaver_rm_rx(const float* input, float* output, const uint32_t in_out_l
 static void
 bit_interleaver_rm_rx_s(const int16_t* input, int16_t* output, const uint32_t in_out_len, const uint32_t mod_order)
 {
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
-    for (uint32_t i = 0; i < rows; i++) {
-      output[i * cols + j] = input[j * rows + i];
-    }
-  }
+  uint32_t rows = mod_order;
+  uint32_t cols = in_out_len / rows;
+  bit_interleaver_rm_rx_tail_s(input, output, 0, cols, rows);
 }
 
 /*!
- * Bit deinterleaver (short)
+ * Bit deinterleaver (char)
  */
 static void
 bit_interleaver_rm_rx_c(const int8_t* input, int8_t* output, const uint32_t in_out_len, const uint32_t mod_order)
 {
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
-    for (uint32_t i = 0; i < rows; i++) {
-      output[i * cols + j] = input[j * rows + i];
-    }
-  }
+  uint32_t rows = mod_order;
+  uint32_t cols = in_out_len / rows;
+  uint32_t j    = 0;
+
+#ifdef LV_HAVE_SSE
+  j = bit_interleaver_rm_rx_c_sse(input, output, cols, rows);
+#endif // LV_HAVE_SSE
+
+  bit_interleaver_rm_rx_tail_c(input, output, j, cols, rows);
 }
 
 int srsran_ldpc_rm_tx_init(srsran_ldpc_rm_t* p)
@@ -452,12 +610,6 @@ int srsran_ldpc_rm_rx_init_f(srsran_ldpc_rm_t* p)
     free(pp);
     return -1;
   }
-
-  if ((pp->indices = srsran_vec_u32_malloc(MAXE)) == NULL) {
-    free(pp->tmp_rm_symbol);
-    free(pp);
-    return -1;
-  }
   return 0;
 }
 
@@ -481,12 +633,6 @@ int srsran_ldpc_rm_rx_init_s(srsran_ldpc_rm_t* p)
     return -1;
   }
 
-  if ((pp->indices = srsran_vec_u32_malloc(MAXE)) == NULL) {
-    free(pp->tmp_rm_symbol);
-    free(pp);
-    return -1;
-  }
-
   return 0;
 }
 int srsran_ldpc_rm_rx_init_c(srsran_ldpc_rm_t* p)
@@ -509,12 +655,6 @@ int srsran_ldpc_rm_rx_init_c(srsran_ldpc_rm_t* p)
     return -1;
   }
 
-  if ((pp->indices = srsran_vec_u32_malloc(MAXE)) == NULL) {
-    free(pp->tmp_rm_symbol);
-    free(pp);
-    return -1;
-  }
-
   return 0;
 }
 
@@ -539,9 +679,6 @@ void srsran_ldpc_rm_rx_free_f(srsran_ldpc_rm_t* q)
       if (qq->tmp_rm_symbol != NULL) {
         free(qq->tmp_rm_symbol);
       }
-      if (qq->indices != NULL) {
-        free(qq->indices);
-      }
       free(qq);
     }
   }
@@ -555,9 +692,6 @@ void srsran_ldpc_rm_rx_free_s(srsran_ldpc_rm_t* q)
       if (qq->tmp_rm_symbol != NULL) {
         free(qq->tmp_rm_symbol);
       }
-      if (qq->indices != NULL) {
-        free(qq->indices);
-      }
       free(qq);
     }
   }
@@ -571,9 +705,6 @@ void srsran_ldpc_rm_rx_free_c(srsran_ldpc_rm_t* q)
       if (qq->tmp_rm_symbol != NULL) {
         free(qq->tmp_rm_symbol);
       }
-      if (qq->indices != NULL) {
-        free(qq->indices);
-      }
       free(qq);
     }
   }
@@ -627,15 +758,14 @@ int srsran_ldpc_rm_rx_f(srsran_ldpc_rm_t*        q,
 
   struct pRM_rx_f* pp            = q->ptr;
   float*           tmp_rm_symbol = pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
   uint32_t         end_exclude   = q->K - 2 * q->ls;
   uint32_t         ini_exclude   = end_exclude - q->F;
 
   if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+    bit_selection_rm_rx(input, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb);
   } else {
     bit_interleaver_rm_rx(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+    bit_selection_rm_rx(tmp_rm_symbol, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb);
   }
   return 0;
 }
@@ -658,15 +788,14 @@ int srsran_ldpc_rm_rx_s(srsran_ldpc_rm_t*        q,
 
   struct pRM_rx_f* pp            = q->ptr;
   int16_t*         tmp_rm_symbol = (int16_t*)pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
   uint32_t         end_exclude   = q->K - 2 * q->ls;
   uint32_t         ini_exclude   = end_exclude - q->F;
 
   if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx_s(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+    bit_selection_rm_rx_s(input, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb);
   } else {
     bit_interleaver_rm_rx_s(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx_s(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+    bit_selection_rm_rx_s(tmp_rm_symbol, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb);
   }
 
   return 0;
@@ -690,15 +819,14 @@ int srsran_ldpc_rm_rx_c(srsran_ldpc_rm_t*        q,
 
   struct pRM_rx_c* pp            = q->ptr;
   int8_t*          tmp_rm_symbol = pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
   uint32_t         end_exclude   = q->K - 2 * q->ls;
   uint32_t         ini_exclude   = end_exclude - q->F;
 
   if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx_c(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+    bit_selection_rm_rx_c(input, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb);
   } else {
     bit_interleaver_rm_rx_c(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx_c(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
+    bit_selection_rm_rx_c(tmp_rm_symbol, q->E, output, ini_exclude, end_exclude, q->k0, q->Ncb);
   }
 
   // Return the number of useful LLR
@@ -47,6 +47,8 @@
  *  - **-B \<number\>** Number of codewords in a batch.(Default 100).
  *  - **-N \<number\>** Max number of simulated batches.(Default 10000).
  *  - **-E \<number\>** Minimum number of errors for a significant simulation.(Default 100).
+ *  - **-S** Enable the syndrome-based early stop of the decoders.
+ *  - **-A \<number\>** Early abort after this number of iterations without progress (Default 0, disabled).
  */
 
 #include <math.h>
@@ -70,17 +72,19 @@ static int                finalK;           /*!< \brief Number of uncoded bits (
 static int                finalN;           /*!< \brief Number of coded bits (codeword length). */
 static float              snr = 0;          /*!< \brief Signal-to-Noise Ratio [dB]. */
 
-static int batch_size  = 100;   /*!< \brief Number of codewords in a batch. */
-static int max_n_batch = 10000; /*!< \brief Max number of simulated batches. */
-static int req_errors  = 100;   /*!< \brief Minimum number of errors for a significant simulation. */
-#define MS_SF 0.75f             /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
+static int      batch_size       = 100;   /*!< \brief Number of codewords in a batch. */
+static int      max_n_batch      = 10000; /*!< \brief Max number of simulated batches. */
+static int      req_errors       = 100;   /*!< \brief Minimum number of errors for a significant simulation. */
+static bool     syndrome_check   = false; /*!< \brief Syndrome-based early stop. */
+static uint32_t early_abort_iter = 0;     /*!< \brief Iterations without progress before giving up (0 disabled). */
+#define MS_SF 0.75f /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
 
 /*!
  * \brief Prints test help when wrong parameter is passed as input.
  */
 void usage(char* prog)
 {
-  printf("Usage: %s [-bX] [-lX] [-eX] [-sX] [-BX]\n", prog);
+  printf("Usage: %s [-bX] [-lX] [-eX] [-sX] [-BX] [-NX] [-EX] [-S] [-AX]\n", prog);
   printf("\t-b Base Graph [(1 or 2) Default %d]\n", base_graph + 1);
   printf("\t-l Lifting Size [Default %d]\n", lift_size);
   printf("\t-e Word length after rate matching [Default %d (no rate matching, only filler-bits are extracted)]\n",
@@ -88,6 +92,8 @@ void usage(char* prog)
   printf("\t-B Number of codewords in a batch. [Default %d]\n", batch_size);
   printf("\t-N Max number of simulated batches. [Default %d]\n", max_n_batch);
   printf("\t-E Minimum number of errors for a significant simulation. [Default %d]\n", req_errors);
+  printf("\t-S Enable syndrome-based early stop. [Default %s]\n", syndrome_check ? "enabled" : "disabled");
+  printf("\t-A Early abort after this number of iterations without progress. [Default %d]\n", early_abort_iter);
 }
 
 /*!
@@ -96,7 +102,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt = 0;
-  while ((opt = getopt(argc, argv, "b:l:e:s:B:N:E:")) != -1) {
+  while ((opt = getopt(argc, argv, "b:l:e:s:B:N:E:SA:")) != -1) {
     switch (opt) {
       case 'b':
         base_graph = (int)strtol(optarg, NULL, 10) - 1;
@@ -119,6 +125,12 @@ void parse_args(int argc, char** argv)
       case 'E':
         req_errors = (int)strtol(optarg, NULL, 10);
         break;
+      case 'S':
+        syndrome_check = true;
+        break;
+      case 'A':
+        early_abort_iter = (uint32_t)strtol(optarg, NULL, 10);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -182,6 +194,8 @@ int main(int argc, char** argv)
   decoder_args.bg                         = base_graph;
   decoder_args.ls                         = lift_size;
   decoder_args.scaling_fctr               = MS_SF;
+  decoder_args.syndrome_check             = syndrome_check;
+  decoder_args.early_abort_iter           = early_abort_iter;
 
   // create an LDPC decoder (float)
   srsran_ldpc_decoder_t decoder_f;
@@ -309,6 +323,7 @@ int main(int argc, char** argv)
   int            n_error_words_s          = 0;
   int            n_error_words_c          = 0;
   int            n_error_words_c_flood    = 0;
+  uint64_t       nof_iter_c               = 0;
 
 #ifdef LV_HAVE_AVX2
   double elapsed_time_dec_avx       = 0;
@@ -445,6 +460,7 @@ int main(int argc, char** argv)
     gettimeofday(&t[1], NULL);
     for (j = 0; j < batch_size; j++) {
       srsran_ldpc_decoder_decode_c(&decoder_c, symbols_c + j * finalN, messages_sim_c + j * finalK, n_useful_symbols);
+      nof_iter_c += decoder_c.last_nof_iter;
     }
     gettimeofday(&t[2], NULL);
     get_time_interval(t);
@@ -582,6 +598,7 @@ int main(int argc, char** argv)
   print_decoder("FLOATING POINT", i_batch, n_error_words_f, elapsed_time_dec_f);
   print_decoder("FIXED POINT (16 bits)", i_batch, n_error_words_s, elapsed_time_dec_s);
   print_decoder("FIXED POINT (8 bits)", i_batch, n_error_words_c, elapsed_time_dec_c);
+  printf("Average number of iterations:\n  %.2f\n", (double)nof_iter_c / (i_batch * batch_size));
   print_decoder("FIXED POINT (8 bits, flooded scheduling)", i_batch, n_error_words_c_flood, elapsed_time_dec_c_flood);
 
 #ifdef LV_HAVE_AVX2
@@ -38,12 +38,14 @@
  *  - **-r \<number\>** Redundancy version {0-3}.
  *  - **-m \<number\>** Modulation type BPSK = 0, QPSK =1, QAM16 = 2, QAM64 = 3, QAM256 = 4.
  *  - **-M \<number\>** Limited buffer size.
+ *  - **-n \<number\>** Number of rate-dematcher runs in the throughput benchmark (Default 100, 0 to skip it).
  */
 
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/time.h>
 #include <unistd.h>
 
 #include "srsran/phy/fec/ldpc/ldpc_common.h"
@@ -61,6 +63,7 @@ static uint32_t           E          = 0;   /*!< \brief Rate-matched codeword si
 static uint8_t            rv         = 0;   /*!< \brief Redundancy version {0-3}. */
 static srsran_mod_t       mod_type = SRSRAN_MOD_QPSK; /*!< \brief Modulation type: BPSK, QPSK, QAM16, QAM64, QAM256. */
 static uint32_t           Nref     = 0;               /*!< \brief Limited buffer size.*/
+static uint32_t           nof_reps = 100;             /*!< \brief Number of rate-dematcher benchmark runs. */
 
 static uint32_t N = 0; /*!< \brief Codeblock size (including punctured and filler bits). */
 static uint32_t K = 0; /*!< \brief Codeword size. */
@@ -70,7 +73,7 @@ static uint32_t K = 0; /*!< \brief Codeword size. */
  */
 void usage(char* prog)
 {
-  printf("Usage: %s [-bX] [-lX] [-eX] [-fX] [-rX] [-mX] [-MX]\n", prog);
+  printf("Usage: %s [-bX] [-lX] [-eX] [-fX] [-rX] [-mX] [-MX] [-nX]\n", prog);
   printf("\t-b Base Graph [(1 or 2) Default %d]\n", base_graph + 1);
   printf("\t-l Lifting Size [Default %d]\n", lift_size);
   printf("\t-e Word length after rate matching [Default %d (no rate matching i.e. E = N - F)]\n", E);
@@ -78,6 +81,7 @@ void usage(char* prog)
   printf("\t-r Redundancy version (rv) [Default %d]\n", rv);
   printf("\t-m Modulation_type BPSK=0, QPSK=1, 16QAM=2, 64QAM=3, 256QAM = 4 [Default %d]\n", mod_type);
   printf("\t-M Limited buffer size (Nref) [Default = %d (normal buffer Nref = N)]\n", Nref);
+  printf("\t-n Number of rate-dematcher benchmark runs [Default %d]\n", nof_reps);
 }
 
 /*!
@@ -86,7 +90,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt = 0;
-  while ((opt = getopt(argc, argv, "b:l:e:f:r:m:M:")) != -1) {
+  while ((opt = getopt(argc, argv, "b:l:e:f:r:m:M:n:")) != -1) {
     switch (opt) {
       case 'b':
         base_graph = (uint32_t)strtol(optarg, NULL, 10) - 1;
@@ -109,6 +113,9 @@ void parse_args(int argc, char** argv)
       case 'M':
         Nref = (uint32_t)strtol(optarg, NULL, 10);
         break;
+      case 'n':
+        nof_reps = (uint32_t)strtol(optarg, NULL, 10);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -338,6 +345,43 @@ int main(int argc, char** argv)
 
   } // codeblocks r
 
+  // Rate-dematcher throughput, soft-combining every run into the same HARQ buffer
+  if (nof_reps > 0) {
+    struct timeval t[3];
+    double         elapsed_time_f = 0;
+    double         elapsed_time_s = 0;
+    double         elapsed_time_c = 0;
+
+    gettimeofday(&t[1], NULL);
+    for (i = 0; i < nof_reps; i++) {
+      srsran_ldpc_rm_rx_f(&rm_rx, rm_symbols, unrm_symbols, E, F, base_graph, lift_size, rv, mod_type, Nref);
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    elapsed_time_f = t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+    gettimeofday(&t[1], NULL);
+    for (i = 0; i < nof_reps; i++) {
+      srsran_ldpc_rm_rx_s(&rm_rx_s, rm_symbols_s, unrm_symbols_s, E, F, base_graph, lift_size, rv, mod_type, Nref);
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    elapsed_time_s = t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+    gettimeofday(&t[1], NULL);
+    for (i = 0; i < nof_reps; i++) {
+      srsran_ldpc_rm_rx_c(&rm_rx_c, rm_symbols_c, unrm_symbols_c, E, F, base_graph, lift_size, rv, mod_type, Nref);
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    elapsed_time_c = t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+    printf("\nRate-dematcher throughput (%d runs of E = %d soft bits):\n", nof_reps, E);
+    printf("  float   -> %.2f Msoft bits/s\n", (double)nof_reps * E / elapsed_time_f / 1e6);
+    printf("  int16_t -> %.2f Msoft bits/s\n", (double)nof_reps * E / elapsed_time_s / 1e6);
+    printf("  int8_t  -> %.2f Msoft bits/s\n", (double)nof_reps * E / elapsed_time_c / 1e6);
+  }
+
   free(unrm_symbols);
   free(unrm_symbols_s);
   free(unrm_symbols_c);
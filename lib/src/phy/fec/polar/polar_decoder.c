@@ -39,10 +39,12 @@
 
 #include "polar_decoder_ssc_c.h"
 #include "polar_decoder_ssc_c_avx2.h"
+#include "polar_decoder_ssc_c_avx512.h"
 #include "polar_decoder_ssc_f.h"
 #include "polar_decoder_ssc_s.h"
 #include "srsran/phy/fec/polar/polar_decoder.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
 
 /*! SSC Polar decoder with float LLR inputs. */
 static int decode_ssc_f(void*           o,
@@ -114,6 +116,51 @@ static int decode_ssc_c_avx2(void*           o,
 }
 #endif // LV_HAVE_AVX2
 
+#ifdef LV_HAVE_AVX512
+/*! SSC Polar decoder AVX512 with int8_t LLR inputs . */
+static int decode_ssc_c_avx512(void*           o,
+                               const int8_t*   symbols,
+                               uint8_t*        data,
+                               const uint8_t   n,
+                               const uint16_t* frozen_set,
+                               const uint16_t  frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  if (init_polar_decoder_ssc_c_avx512(q->ptr, &symbols, 1, n, frozen_set, frozen_set_size) < 0) {
+    return -1;
+  }
+
+  return polar_decoder_ssc_c_avx512(q->ptr, &data);
+}
+
+/*! SSC Polar decoder AVX512 with int8_t LLR inputs, decoding one codeword per 8-bit lane. */
+static int decode_ssc_c_avx512_multi(void*           o,
+                                     const int8_t**  symbols,
+                                     uint8_t**       data,
+                                     uint32_t        nof_codewords,
+                                     const uint8_t   n,
+                                     const uint16_t* frozen_set,
+                                     const uint16_t  frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  for (uint32_t i = 0; i < nof_codewords; i += POLAR_DECODER_SSC_C_AVX512_MAX_LANES) {
+    uint32_t nof_lanes = SRSRAN_MIN(nof_codewords - i, POLAR_DECODER_SSC_C_AVX512_MAX_LANES);
+
+    if (init_polar_decoder_ssc_c_avx512(q->ptr, &symbols[i], nof_lanes, n, frozen_set, frozen_set_size) < 0) {
+      return -1;
+    }
+
+    if (polar_decoder_ssc_c_avx512(q->ptr, &data[i]) < 0) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
+#endif // LV_HAVE_AVX512
+
 /*! Destructor of a (float) SSC polar decoder. */
 static void free_ssc_f(void* o)
 {
@@ -144,6 +191,15 @@ static void free_ssc_c_avx2(void* o)
 }
 #endif
 
+#ifdef LV_HAVE_AVX512
+/*! Destructor of a (int8_t, avx512) SSC polar decoder. */
+static void free_ssc_c_avx512(void* o)
+{
+  srsran_polar_decoder_t* q = o;
+  delete_polar_decoder_ssc_c_avx512(q->ptr);
+}
+#endif
+
 /*! Initializes a polar decoder structure to use the SSC polar decoder algorithm with float LLR inputs. */
 static int init_ssc_f(srsran_polar_decoder_t* q)
 {
@@ -203,9 +259,28 @@ static int init_ssc_c_avx2(srsran_polar_decoder_t* q)
 }
 #endif
 
+#ifdef LV_HAVE_AVX512
+/*! Initializes a polar decoder structure to use the SSC polar decoder algorithm with uint8_t LLR inputs and AVX512
+ * instructions. */
+static int init_ssc_c_avx512(srsran_polar_decoder_t* q)
+{
+  q->decode_c       = decode_ssc_c_avx512;
+  q->decode_c_multi = decode_ssc_c_avx512_multi;
+  q->free           = free_ssc_c_avx512;
+
+  if ((q->ptr = create_polar_decoder_ssc_c_avx512(q->nMax)) == NULL) {
+    ERROR("create_polar_decoder_ssc_c_avx512 failed");
+    free_ssc_c_avx512(q);
+    return -1;
+  }
+  return 0;
+}
+#endif
+
 int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_type_t type, const uint8_t nMax)
 {
-  q->nMax = nMax;
+  q->nMax           = nMax;
+  q->decode_c_multi = NULL;
   switch (type) {
     case SRSRAN_POLAR_DECODER_SSC_F:
       return init_ssc_f(q);
@@ -216,6 +291,10 @@ int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_ty
 #ifdef LV_HAVE_AVX2
     case SRSRAN_POLAR_DECODER_SSC_C_AVX2:
       return init_ssc_c_avx2(q);
+#endif
+#ifdef LV_HAVE_AVX512
+    case SRSRAN_POLAR_DECODER_SSC_C_AVX512:
+      return init_ssc_c_avx512(q);
 #endif
     default:
       ERROR("Decoder not implemented");
@@ -273,3 +352,28 @@ int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
 
   return -1;
 }
+
+int srsran_polar_decoder_decode_c_multi(srsran_polar_decoder_t* q,
+                                        const int8_t**          llr,
+                                        uint8_t**               data_decoded,
+                                        uint32_t                nof_codewords,
+                                        const uint8_t           n,
+                                        const uint16_t*         frozen_set,
+                                        const uint16_t          frozen_set_size)
+{
+  if (q->nMax < n) {
+    return -1;
+  }
+
+  if (q->decode_c_multi != NULL) {
+    return q->decode_c_multi(q, llr, data_decoded, nof_codewords, n, frozen_set, frozen_set_size);
+  }
+
+  for (uint32_t i = 0; i < nof_codewords; i++) {
+    if (q->decode_c(q, llr[i], data_decoded[i], n, frozen_set, frozen_set_size) < 0) {
+      return -1;
+    }
+  }
+
+  return 0;
+}
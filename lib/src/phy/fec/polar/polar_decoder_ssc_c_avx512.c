@@ -0,0 +1,340 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_ssc_c_avx512.c
+ * \brief Definition of the SSC polar decoder inner functions working with
+ * 8-bit integer-valued LLRs and AVX512 instructions.
+ *
+ * All buffers store the values of the codewords decoded in parallel interleaved: the LLR (or bit) at position
+ * \f$i\f$ of lane \f$l\f$ is at \f$i \cdot L + l\f$, where \f$L\f$ is the number of lanes. Hence, the function f,
+ * function g and XOR operations of the SSC algorithm on \f$len\f$ positions become vector operations on
+ * \f$len \cdot L\f$ contiguous values, regardless of the number of lanes.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#include "polar_decoder_ssc_c_avx512.h"
+#include "polar_decoder_vector_avx512.h"
+#include "srsran/phy/fec/polar/polar_code.h"
+#include "srsran/phy/utils/vector.h"
+
+#ifdef LV_HAVE_AVX512
+
+/*!
+ * \brief Describes the state of a AVX512 SSC polar decoder
+ */
+struct StateAVX512 {
+  uint8_t  stage;   /*!< \brief Current stage [0 - code_size_log] of the decoding algorithm. */
+  uint16_t bit_pos; /*!< \brief position of the next bit to be estimated in est_bit buffer. */
+};
+
+/*!
+ * \brief Describes an SSC polar decoder (8-bit, AVX512 version).
+ */
+struct pSSC_c_avx512 {
+  int8_t*            llr_buffer;         /*!< \brief LLR buffer of all stages. */
+  int8_t*            llr0[NMAX_LOG + 1]; /*!< \brief Pointers to the upper half of LLRs values at all stages. */
+  int8_t*            llr1[NMAX_LOG + 1]; /*!< \brief Pointers to the lower half of LLRs values at all stages. */
+  uint8_t*           est_bit;            /*!< \brief Pointers to the temporary estimated bits. */
+  uint32_t           nof_lanes;          /*!< \brief Number of codewords being decoded. */
+  struct Params*     param;              /*!< \brief Pointer to a Params structure. */
+  struct StateAVX512 state;              /*!< \brief Decoder state. */
+  void*              tmp_node_type;      /*!< \brief Pointer to a Tmp_node_type. */
+};
+
+/*!
+ * Switches between the different types of node (::RATE_1, ::RATE_0, ::RATE_R) for the SSC algorithm, for all lanes
+ * at once. See the AVX2 version for details.
+ */
+static void simplified_node(struct pSSC_c_avx512* p);
+
+void delete_polar_decoder_ssc_c_avx512(void* p)
+{
+  struct pSSC_c_avx512* pp = p;
+
+  if (p != NULL) {
+    if (pp->llr_buffer) {
+      free(pp->llr_buffer);
+    }
+    if (pp->param) {
+      if (pp->param->node_type) {
+        if (pp->param->node_type[0]) {
+          free(pp->param->node_type[0]);
+        }
+        free(pp->param->node_type);
+      }
+      if (pp->param->code_stage_size) {
+        free(pp->param->code_stage_size);
+      }
+      free(pp->param);
+    }
+    if (pp->est_bit) {
+      free(pp->est_bit);
+    }
+    if (pp->tmp_node_type) {
+      delete_tmp_node_type(pp->tmp_node_type);
+    }
+    free(pp);
+  }
+}
+
+void* create_polar_decoder_ssc_c_avx512(const uint8_t nMax)
+{
+  struct pSSC_c_avx512* pp = SRSRAN_MEM_ALLOC(struct pSSC_c_avx512, 1);
+  if (pp == NULL) {
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(pp, struct pSSC_c_avx512, 1);
+
+  // algorithm constants/parameters
+  if ((pp->param = SRSRAN_MEM_ALLOC(struct Params, 1)) == NULL) {
+    delete_polar_decoder_ssc_c_avx512(pp);
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(pp->param, struct Params, 1);
+
+  if ((pp->param->code_stage_size = srsran_vec_u16_malloc(nMax + 1)) == NULL) {
+    delete_polar_decoder_ssc_c_avx512(pp);
+    return NULL;
+  }
+
+  pp->param->code_stage_size[0] = 1;
+  for (uint8_t i = 1; i < nMax + 1; i++) {
+    pp->param->code_stage_size[i] = 2 * pp->param->code_stage_size[i - 1];
+  }
+
+  // estimated bits of all lanes
+  pp->est_bit = srsran_vec_u8_malloc(pp->param->code_stage_size[nMax] * POLAR_DECODER_SSC_C_AVX512_MAX_LANES);
+  if (pp->est_bit == NULL) {
+    delete_polar_decoder_ssc_c_avx512(pp);
+    return NULL;
+  }
+
+  // LLRs of all stages and lanes. Every stage starts at a 512-bit boundary
+  uint32_t llr_all_stages = (1U << (nMax + 1U)) * POLAR_DECODER_SSC_C_AVX512_MAX_LANES;
+  llr_all_stages += (nMax + 1) * SRSRAN_AVX512_B_SIZE;
+  if ((pp->llr_buffer = srsran_vec_i8_malloc(llr_all_stages)) == NULL) {
+    delete_polar_decoder_ssc_c_avx512(pp);
+    return NULL;
+  }
+
+  // allocate memory for node type pointers, one per stage.
+  if ((pp->param->node_type = SRSRAN_MEM_ALLOC(uint8_t*, nMax + 1)) == NULL) {
+    delete_polar_decoder_ssc_c_avx512(pp);
+    return NULL;
+  }
+
+  // Stage s has 2^(N-s) nodes s=0,...,N.
+  if ((pp->param->node_type[0] = srsran_vec_u8_malloc(1U << (nMax + 1U))) == NULL) {
+    delete_polar_decoder_ssc_c_avx512(pp);
+    return NULL;
+  }
+  for (uint8_t s = 1; s < nMax + 1; s++) {
+    pp->param->node_type[s] = pp->param->node_type[s - 1] + pp->param->code_stage_size[nMax - s + 1];
+  }
+
+  // memory allocation to compute node_type
+  if ((pp->tmp_node_type = create_tmp_node_type(nMax)) == NULL) {
+    delete_polar_decoder_ssc_c_avx512(pp);
+    return NULL;
+  }
+
+  return pp;
+}
+
+int init_polar_decoder_ssc_c_avx512(void*           p,
+                                    const int8_t**  input_llr,
+                                    uint32_t        nof_codewords,
+                                    const uint8_t   code_size_log,
+                                    const uint16_t* frozen_set,
+                                    const uint16_t  frozen_set_size)
+{
+  struct pSSC_c_avx512* pp = p;
+
+  if (p == NULL || input_llr == NULL || nof_codewords == 0 || nof_codewords > POLAR_DECODER_SSC_C_AVX512_MAX_LANES) {
+    return -1;
+  }
+
+  pp->nof_lanes            = nof_codewords;
+  pp->param->code_size_log = code_size_log;
+  uint16_t code_size       = pp->param->code_stage_size[code_size_log];
+
+  // Place the stages for the current number of lanes. Node at stage s holds 2^s positions
+  int8_t* ptr = pp->llr_buffer;
+  for (uint8_t s = 0; s < code_size_log + 1; s++) {
+    uint32_t stage_len = pp->param->code_stage_size[s] * nof_codewords;
+    pp->llr0[s]        = ptr;
+    pp->llr1[s]        = ptr + stage_len / 2;
+    ptr += SRSRAN_CEIL(stage_len, SRSRAN_AVX512_B_SIZE) * SRSRAN_AVX512_B_SIZE;
+  }
+
+  // Initializes LLR buffer for the last stage/level with the interleaved input LLRs
+  int8_t* llr = pp->llr0[code_size_log];
+  if (nof_codewords == 1) {
+    srsran_vec_i8_copy(llr, input_llr[0], code_size);
+  } else {
+    for (uint32_t l = 0; l < nof_codewords; l++) {
+      const int8_t* in = input_llr[l];
+      for (uint16_t i = 0; i < code_size; i++) {
+        llr[i * nof_codewords + l] = in[i];
+      }
+    }
+  }
+
+  // Initializes the state of the decoding tree
+  pp->state.stage   = code_size_log + 1; // start from the only one node at the last stage + 1.
+  pp->state.bit_pos = 0;
+
+  // frozen_set
+  pp->param->frozen_set_size = frozen_set_size;
+
+  // computes the node types for the decoding tree, common to all lanes
+  compute_node_type(pp->tmp_node_type, pp->param->node_type, frozen_set, code_size_log, frozen_set_size);
+
+  return 0;
+}
+
+/*!
+ * Polar encodes the estimated bits of all lanes in place. The polar transform is applied with XOR butterflies on
+ * positions, that is, on vectors of nof_lanes values.
+ */
+static void polar_encode_lanes(uint8_t* x, uint8_t code_size_log, uint32_t nof_lanes)
+{
+  uint32_t code_size = 1U << code_size_log;
+  for (uint32_t s = code_size_log; s > 0; s--) {
+    uint32_t stage_size      = 1U << s;
+    uint32_t stage_half_size = stage_size / 2;
+    uint32_t half_len        = stage_half_size * nof_lanes;
+
+    // Short butterflies would waste most of a vector, they are better served by plain loops
+    if (half_len < SRSRAN_AVX512_B_SIZE) {
+      for (uint32_t b = 0; b < code_size * nof_lanes; b += 2 * half_len) {
+        for (uint32_t i = b; i < b + half_len; i++) {
+          x[i] ^= x[i + half_len];
+        }
+      }
+      continue;
+    }
+
+    for (uint32_t b = 0; b < code_size; b += stage_size) {
+      uint8_t* x0 = x + b * nof_lanes;
+      srsran_vec_xor_bbb_avx512(x0, x0 + half_len, x0, half_len);
+    }
+  }
+}
+
+int polar_decoder_ssc_c_avx512(void* p, uint8_t** data_decoded)
+{
+  if (p == NULL || data_decoded == NULL) {
+    return -1;
+  }
+
+  struct pSSC_c_avx512* pp            = p;
+  uint32_t              nof_lanes     = pp->nof_lanes;
+  uint8_t               code_size_log = pp->param->code_size_log;
+  uint16_t              code_size     = pp->param->code_stage_size[code_size_log];
+
+  simplified_node(pp);
+
+  // est_bit contains the coded bits. To obtain the messages, they are encoded again
+  polar_encode_lanes(pp->est_bit, code_size_log, nof_lanes);
+
+  // transform {0,-128} into {0, 1}
+  srsran_vec_sign_to_bit_c_avx512(pp->est_bit, code_size * nof_lanes);
+
+  // De-interleave lanes
+  if (nof_lanes == 1) {
+    srsran_vec_u8_copy(data_decoded[0], pp->est_bit, code_size);
+  } else {
+    for (uint32_t l = 0; l < nof_lanes; l++) {
+      uint8_t* out = data_decoded[l];
+      for (uint16_t i = 0; i < code_size; i++) {
+        out[i] = pp->est_bit[i * nof_lanes + l];
+      }
+    }
+  }
+
+  return 0;
+}
+
+static void simplified_node(struct pSSC_c_avx512* p)
+{
+  struct pSSC_c_avx512* pp = p;
+
+  pp->state.stage--; // to child node.
+
+  uint32_t nof_lanes = pp->nof_lanes;
+  uint8_t  stage     = pp->state.stage;
+  uint16_t bit_pos   = pp->state.bit_pos >> stage;
+  uint8_t* estbits0  = NULL;
+  uint8_t* estbits1  = NULL;
+
+  uint16_t stage_size      = pp->param->code_stage_size[stage];
+  uint16_t stage_half_size = 0;
+
+  switch (pp->param->node_type[stage][bit_pos]) {
+    case RATE_1:
+      srsran_vec_hard_bit_cc_avx512(
+          pp->llr0[stage], pp->est_bit + pp->state.bit_pos * nof_lanes, stage_size * nof_lanes);
+
+      pp->state.bit_pos = pp->state.bit_pos + stage_size;
+      break;
+
+    case RATE_0:
+      srsran_vec_u8_zero(pp->est_bit + pp->state.bit_pos * nof_lanes, stage_size * nof_lanes);
+
+      pp->state.bit_pos = pp->state.bit_pos + stage_size;
+      break;
+
+    case RATE_R:
+      stage_half_size = pp->param->code_stage_size[stage - 1];
+
+      srsran_vec_function_f_ccc_avx512(
+          pp->llr0[stage], pp->llr1[stage], pp->llr0[stage - 1], stage_half_size * nof_lanes);
+
+      // move to the child node to the left (up) of the tree.
+      simplified_node(pp);
+
+      estbits0 = pp->est_bit + (pp->state.bit_pos - stage_half_size) * nof_lanes;
+      srsran_vec_function_g_bccc_avx512(
+          estbits0, pp->llr0[stage], pp->llr1[stage], pp->llr0[stage - 1], stage_half_size * nof_lanes);
+
+      // move to the child node to the right (down) of the tree.
+      simplified_node(pp);
+
+      estbits0 = pp->est_bit + (pp->state.bit_pos - stage_size) * nof_lanes;
+      estbits1 = estbits0 + stage_half_size * nof_lanes;
+      srsran_vec_xor_bbb_avx512(estbits0, estbits1, estbits0, stage_half_size * nof_lanes);
+
+      break;
+
+    default:
+      printf("ERROR: wrong node type %d\n", pp->param->node_type[stage][bit_pos]);
+      exit(-1);
+      break;
+  }
+
+  pp->state.stage++; // to parent node.
+}
+
+#endif // LV_HAVE_AVX512
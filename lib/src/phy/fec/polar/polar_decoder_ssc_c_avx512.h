@@ -0,0 +1,88 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_ssc_c_avx512.h
+ * \brief Declaration of the SSC polar decoder inner functions working with
+ * 8-bit integer-valued LLRs and AVX512 instructions.
+ *
+ * The decoder runs up to \ref POLAR_DECODER_SSC_C_AVX512_MAX_LANES codewords of the same polar code in parallel
+ * (inter-frame decoding). The LLRs of all codewords are interleaved, so that every LLR position holds one value per
+ * codeword (lane) and the decoding tree is traversed only once for all of them.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#ifndef POLAR_DECODER_SSC_C_AVX512_H
+#define POLAR_DECODER_SSC_C_AVX512_H
+
+#include "polar_decoder_ssc_all.h"
+#include "../utils_avx512.h"
+
+/*!
+ * \brief Maximum number of codewords decoded in parallel.
+ */
+#define POLAR_DECODER_SSC_C_AVX512_MAX_LANES SRSRAN_AVX512_B_SIZE
+
+/*!
+ * Creates an SSC polar decoder structure of type pSSC_c_avx512, and allocates memory for the decoding buffers.
+ *
+ * \param[in] nMax \f$log_2\f$ of the number of bits in the codeword.
+ * \return A pointer to a pSSC_c_avx512 structure if the function executes correctly, NULL otherwise.
+ */
+void* create_polar_decoder_ssc_c_avx512(uint8_t nMax);
+
+/*!
+ * The (8-bit, avx512) polar decoder SSC "destructor": it frees all the resources allocated to the decoder.
+ *
+ * \param[in, out] p A pointer to the dismantled decoder.
+ */
+void delete_polar_decoder_ssc_c_avx512(void* p);
+
+/*!
+ * Initializes an (8-bit, avx512) SSC polar decoder before processing a batch of codewords.
+ *
+ * \param[in, out] p A void pointer used to declare a pSSC_c_avx512 structure.
+ * \param[in] llr LLRs of the new codewords, one pointer per codeword.
+ * \param[in] nof_codewords Number of codewords, from 1 to \ref POLAR_DECODER_SSC_C_AVX512_MAX_LANES.
+ * \param[in] code_size_log \f$log_2\f$ of the number of bits in the codeword.
+ * \param[in] frozen_set The position of the frozen bits in the codeword.
+ * \param[in] frozen_set_size Number of frozen bits.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int init_polar_decoder_ssc_c_avx512(void*           p,
+                                    const int8_t**  llr,
+                                    uint32_t        nof_codewords,
+                                    const uint8_t   code_size_log,
+                                    const uint16_t* frozen_set,
+                                    const uint16_t  frozen_set_size);
+
+/*!
+ * Decodes the data messages of the codewords given to init_polar_decoder_ssc_c_avx512().
+ *
+ * \param[in] p A pointer to the desired decoder.
+ * \param[out] data The decoded messages, one pointer per codeword.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int polar_decoder_ssc_c_avx512(void* p, uint8_t** data);
+
+#endif // POLAR_DECODER_SSC_C_AVX512_H
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_vector_avx512.c
+ * \brief Definition of the polar decoder vectorizable functions using AVX512 instructions.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#include "polar_decoder_vector_avx512.h"
+#include "../utils_avx512.h"
+#include <stdint.h>
+
+#ifdef LV_HAVE_AVX512
+
+#include <immintrin.h>
+
+// General remarks
+// We replace bits by {0, 128} (uint8_t) or {0, -128} (int8_t)
+// AVX512 has no sign instruction, the sign changes are masked negations instead
+
+/*!
+ * Returns the mask of the elements [i, len) that fit in a 512-bit register.
+ */
+static inline __mmask64 tail_mask(uint32_t i, uint32_t len)
+{
+  uint32_t n = len - i;
+  return (n >= SRSRAN_AVX512_B_SIZE) ? (__mmask64)UINT64_MAX : (((__mmask64)1U << n) - 1U);
+}
+
+void srsran_vec_function_f_ccc_avx512(const int8_t* x, const int8_t* y, int8_t* z, const uint32_t len)
+{
+  const __m512i MZERO = _mm512_setzero_si512();
+
+  for (uint32_t i = 0; i < len; i += SRSRAN_AVX512_B_SIZE) {
+    __mmask64 mask = tail_mask(i, len);
+    __m512i   m_x  = _mm512_maskz_loadu_epi8(mask, &x[i]);
+    __m512i   m_y  = _mm512_maskz_loadu_epi8(mask, &y[i]);
+
+    // The result is negative if the signs of x and y differ. It is zero if either x or y is zero
+    __mmask64 m_neg             = _mm512_movepi8_mask(_mm512_xor_si512(m_x, m_y));
+    __m512i   m_min_abs_x_abs_y = _mm512_min_epi8(_mm512_abs_epi8(m_x), _mm512_abs_epi8(m_y));
+    __m512i   m_z               = _mm512_mask_sub_epi8(m_min_abs_x_abs_y, m_neg, MZERO, m_min_abs_x_abs_y);
+
+    _mm512_mask_storeu_epi8(&z[i], mask, m_z);
+  }
+}
+
+void srsran_vec_function_g_bccc_avx512(const uint8_t* b,
+                                       const int8_t*  x,
+                                       const int8_t*  y,
+                                       int8_t*        z,
+                                       const uint32_t len)
+{
+  const __m512i MZERO    = _mm512_setzero_si512();
+  const __m512i M_NEG127 = _mm512_set1_epi8(-127);
+
+  for (uint32_t i = 0; i < len; i += SRSRAN_AVX512_B_SIZE) {
+    __mmask64 mask = tail_mask(i, len);
+    __m512i   m_x  = _mm512_maskz_loadu_epi8(mask, &x[i]);
+    __m512i   m_y  = _mm512_maskz_loadu_epi8(mask, &y[i]);
+    __m512i   m_b  = _mm512_maskz_loadu_epi8(mask, &b[i]);
+
+    __m512i m_sign_x = _mm512_mask_sub_epi8(m_x, _mm512_movepi8_mask(m_b), MZERO, m_x);
+    __m512i m_z      = _mm512_adds_epi8(m_sign_x, m_y);
+    __m512i m_sz     = _mm512_max_epi8(M_NEG127, m_z);
+
+    _mm512_mask_storeu_epi8(&z[i], mask, m_sz);
+  }
+}
+
+void srsran_vec_xor_bbb_avx512(const uint8_t* x, const uint8_t* y, uint8_t* z, const uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i += SRSRAN_AVX512_B_SIZE) {
+    __mmask64 mask = tail_mask(i, len);
+    __m512i   m_x  = _mm512_maskz_loadu_epi8(mask, &x[i]);
+    __m512i   m_y  = _mm512_maskz_loadu_epi8(mask, &y[i]);
+
+    _mm512_mask_storeu_epi8(&z[i], mask, _mm512_xor_si512(m_x, m_y));
+  }
+}
+
+void srsran_vec_hard_bit_cc_avx512(const int8_t* x, uint8_t* z, const uint32_t len)
+{
+  const __m512i M_MSB_MASK = _mm512_set1_epi8(-128);
+
+  for (uint32_t i = 0; i < len; i += SRSRAN_AVX512_B_SIZE) {
+    __mmask64 mask = tail_mask(i, len);
+    __m512i   m_x  = _mm512_maskz_loadu_epi8(mask, &x[i]);
+
+    _mm512_mask_storeu_epi8(&z[i], mask, _mm512_and_si512(m_x, M_MSB_MASK));
+  }
+}
+
+void srsran_vec_sign_to_bit_c_avx512(uint8_t* x, const uint32_t len)
+{
+  const __m512i M_1 = _mm512_set1_epi8(1);
+
+  for (uint32_t i = 0; i < len; i += SRSRAN_AVX512_B_SIZE) {
+    __mmask64 mask = tail_mask(i, len);
+    __m512i   m_x  = _mm512_maskz_loadu_epi8(mask, &x[i]);
+
+    // {0, 128} -> {0, 1}
+    __m512i m_z = _mm512_and_si512(_mm512_srli_epi16(m_x, 7), M_1);
+
+    _mm512_mask_storeu_epi8(&x[i], mask, m_z);
+  }
+}
+#endif // LV_HAVE_AVX512
@@ -0,0 +1,83 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_vector_avx512.h
+ * \brief Declaration of the 8-bit AVX512 polar decoder vectorizable functions.
+ *
+ * Unlike their AVX2 counterparts, the functions use masked loads and stores for the last elements. Hence, they
+ * neither read nor write out of the given vectors, whatever their length.
+ *
+ * \copyright Software Radio Systems Limited
+ *
+ */
+
+#ifndef POLAR_VECTOR_FUNCTIONS_AVX512_H
+#define POLAR_VECTOR_FUNCTIONS_AVX512_H
+#include "srsran/config.h"
+#include <stdint.h>
+
+/*!
+ * Transforms input uint8_t bits represented by {0, 128} to {0, 1} with AVX512 instructions.
+ * \param[in, out] x A pointer to a vector of uint8_t.
+ * \param[in] len Length of vector x.
+ */
+SRSRAN_API void srsran_vec_sign_to_bit_c_avx512(uint8_t* x, uint32_t len);
+
+/*!
+ * Computes \f$ z = sign(x) \times sign(y) \times \min(abs(x), abs(y)) \f$ elementwise
+ * (box-plus operator) with AVX512 instructions.
+ * \param[in] x A pointer to a vector of int8_t.
+ * \param[in] y A pointer to a vector of int8_t.
+ * \param[out] z A pointer to a vector of int8_t.
+ * \param[in] len Length of vectors x, y and z.
+ */
+SRSRAN_API void srsran_vec_function_f_ccc_avx512(const int8_t* x, const int8_t* y, int8_t* z, uint32_t len);
+
+/*!
+ * Returns \f$ z = x + y \f$ if \f$ (b = 0) \f$ and \f$ z= -x + y \f$ if \f$ (b = 128)\f$ with AVX512 instructions.
+ * \param[in] b A pointer to a vectors of uint8_t with 0's and 128's.
+ * \param[in] x A pointer to a vector of int8_t.
+ * \param[in] y A pointer to a vector of int8_t.
+ * \param[out] z A pointer to a vector of int8_t.
+ * \param[in] len Length of vectors b, x, y and z.
+ */
+SRSRAN_API void
+srsran_vec_function_g_bccc_avx512(const uint8_t* b, const int8_t* x, const int8_t* y, int8_t* z, uint32_t len);
+
+/*!
+ * Computes \f$ z = x \oplus y \f$ elementwise with AVX512 instructions.
+ * \param[in] x A pointer to a vector of uint8_t.
+ * \param[in] y A pointer to a vector of uint8_t.
+ * \param[out] z A pointer to a vector of uint8_t.
+ * \param[in] len Length of vectors x, y and z.
+ */
+SRSRAN_API void srsran_vec_xor_bbb_avx512(const uint8_t* x, const uint8_t* y, uint8_t* z, uint32_t len);
+
+/*!
+ * Returns 128 if \f$ (x < 0) \f$ and 0 if \f$ (x >= 0) \f$ with AVX512 instructions.
+ * \param[in] x A pointer to a vector of int8_t.
+ * \param[out] z A pointer to a vector of uint8_t with 0's and 128's.
+ * \param[in] len Length of vectors x and z.
+ */
+SRSRAN_API void srsran_vec_hard_bit_cc_avx512(const int8_t* x, uint8_t* z, uint32_t len);
+
+#endif // POLAR_VECTOR_FUNCTIONS_AVX512_H
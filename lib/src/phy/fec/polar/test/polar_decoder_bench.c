@@ -0,0 +1,313 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_bench.c
+ * \brief Throughput benchmark of the 8-bit polar decoders.
+ *
+ * For each code size of a list of PBCH, PDCCH and UCI configurations, a batch of random messages is encoded,
+ * rate-matched, optionally sent over an AWGN channel, rate-dematched and decoded by every available 8-bit decoder:
+ * the generic one, the AVX2 one and the AVX512 one, with one codeword at a time and with all the codewords of the
+ * batch in parallel lanes. The multi-codeword output must match the single-codeword one, and the transmitted messages
+ * in the noiseless case. The throughput of each decoder is reported in codewords per second.
+ *
+ * Synopsis: **polar_decoder_bench [options]**
+ *
+ * Options:
+ *
+ *  - <b>-c \<number\></b> Number of codewords in a batch [Default 64].
+ *  - <b>-r \<number\></b> Number of repetitions of each batch [Default 10].
+ *  - <b>-s \<number\></b> SNR [dB, Default 101] -- Use 101 for noiseless.
+ *
+ */
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/fec/polar/polar_chanalloc.h"
+#include "srsran/phy/fec/polar/polar_code.h"
+#include "srsran/phy/fec/polar/polar_decoder.h"
+#include "srsran/phy/fec/polar/polar_encoder.h"
+#include "srsran/phy/fec/polar/polar_rm.h"
+#include "srsran/phy/utils/bit.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define MAX_NOF_CODEWORDS 256 /*!< \brief Max number of codewords in a batch. */
+
+static uint32_t nof_codewords   = 64;  /*!< \brief Number of codewords in a batch. */
+static uint32_t nof_repetitions = 10;  /*!< \brief Number of times each batch is decoded. */
+static double   snr_db          = 101; /*!< \brief SNR in dB (101 for no noise). */
+
+/*!
+ * \brief Code configuration under test.
+ */
+typedef struct {
+  const char* name;
+  uint16_t    K;
+  uint16_t    E;
+  uint8_t     nMax;
+  uint8_t     bil;
+} bench_cfg_t;
+
+static const bench_cfg_t bench_cfgs[] = {{"PBCH", 56, 864, 9, 0},
+                                         {"PDCCH", 40, 108, 9, 0},
+                                         {"PDCCH", 64, 432, 9, 0},
+                                         {"PDCCH", 164, 864, 9, 0},
+                                         {"UCI", 32, 256, 10, 1},
+                                         {"UCI", 128, 1024, 10, 1},
+                                         {"UCI", 512, 2048, 10, 1}};
+
+/*!
+ * \brief Decoder under test.
+ */
+typedef struct {
+  const char*                 name;
+  srsran_polar_decoder_type_t type;
+  bool                        multi;
+} bench_dec_t;
+
+static const bench_dec_t bench_decs[] = {{"C", SRSRAN_POLAR_DECODER_SSC_C, false},
+#ifdef LV_HAVE_AVX2
+                                         {"C_AVX2", SRSRAN_POLAR_DECODER_SSC_C_AVX2, false},
+#endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_AVX512
+                                         {"C_AVX512", SRSRAN_POLAR_DECODER_SSC_C_AVX512, false},
+                                         {"C_AVX512_MULTI", SRSRAN_POLAR_DECODER_SSC_C_AVX512, true},
+#endif // LV_HAVE_AVX512
+};
+
+#define NOF_BENCH_CFGS (sizeof(bench_cfgs) / sizeof(bench_cfg_t))
+#define NOF_BENCH_DECS (sizeof(bench_decs) / sizeof(bench_dec_t))
+
+static srsran_random_t random_gen = NULL;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [-cX] [-rX] [-sX]\n", prog);
+  printf("\t-c Number of codewords in a batch [Default %d, max %d]\n", nof_codewords, MAX_NOF_CODEWORDS);
+  printf("\t-r Number of repetitions [Default %d]\n", nof_repetitions);
+  printf("\t-s SNR [dB, Default %.2f dB] -- Use 101 for noiseless\n", snr_db);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "c:r:s:")) != -1) {
+    switch (opt) {
+      case 'c':
+        nof_codewords = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'r':
+        nof_repetitions = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        snr_db = strtof(optarg, NULL);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static int bench_run(const bench_cfg_t* cfg)
+{
+  int                    ret = SRSRAN_ERROR;
+  srsran_polar_code_t    code;
+  srsran_polar_encoder_t enc;
+  srsran_polar_rm_t      rm_tx;
+  srsran_polar_rm_t      rm_rx;
+  srsran_polar_decoder_t dec;
+  const int8_t*          llr_ptr[MAX_NOF_CODEWORDS];
+  uint8_t*               data_ptr[MAX_NOF_CODEWORDS];
+  uint8_t*               data_ref     = NULL;
+  uint32_t               N            = 1U << cfg->nMax;
+  uint32_t               K            = cfg->K;
+  uint32_t               E            = cfg->E;
+  uint8_t*               data_tx      = srsran_vec_u8_malloc(K * nof_codewords);
+  uint8_t*               data_rx      = srsran_vec_u8_malloc(K * nof_codewords);
+  uint8_t*               input_enc    = srsran_vec_u8_malloc(N * nof_codewords);
+  uint8_t*               output_enc   = srsran_vec_u8_malloc(N * nof_codewords);
+  uint8_t*               rm_codeword  = srsran_vec_u8_malloc(E * nof_codewords);
+  float*                 rm_llr       = srsran_vec_f_malloc(E * nof_codewords);
+  int8_t*                rm_llr_c     = srsran_vec_i8_malloc(E * nof_codewords);
+  int8_t*                llr_c        = srsran_vec_i8_malloc(N * nof_codewords);
+  uint8_t*               output_dec   = srsran_vec_u8_malloc(N * nof_codewords);
+  uint8_t*               output_first = srsran_vec_u8_malloc(N * nof_codewords);
+
+  srsran_polar_code_init(&code);
+  srsran_polar_encoder_init(&enc, SRSRAN_POLAR_ENCODER_PIPELINED, cfg->nMax);
+  srsran_polar_rm_tx_init(&rm_tx);
+  srsran_polar_rm_rx_init_c(&rm_rx);
+
+  if (!data_tx || !data_rx || !input_enc || !output_enc || !rm_codeword || !rm_llr || !rm_llr_c || !llr_c ||
+      !output_dec || !output_first) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  if (srsran_polar_code_get(&code, K, E, cfg->nMax) < SRSRAN_SUCCESS) {
+    ERROR("Error getting polar code K=%d E=%d nMax=%d", K, E, cfg->nMax);
+    goto clean_exit;
+  }
+
+  // Encode random messages
+  for (uint32_t i = 0; i < nof_codewords; i++) {
+    for (uint32_t j = 0; j < K; j++) {
+      data_tx[i * K + j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
+    }
+    srsran_polar_chanalloc_tx(
+        data_tx + i * K, input_enc + i * code.N, code.N, code.K, code.nPC, code.K_set, code.PC_set);
+    srsran_polar_encoder_encode(&enc, input_enc + i * code.N, output_enc + i * code.N, code.n);
+    srsran_polar_rm_tx(&rm_tx, output_enc + i * code.N, rm_codeword + i * E, code.n, E, K, cfg->bil);
+  }
+
+  for (uint32_t j = 0; j < E * nof_codewords; j++) {
+    rm_llr[j] = rm_codeword[j] ? -1 : 1;
+  }
+
+  // Add noise and quantize, the same way as polar_chain_test does
+  if (snr_db == 101) {
+    srsran_vec_quant_fc(rm_llr, rm_llr_c, 32, 0, 127, E * nof_codewords);
+  } else {
+    float var = srsran_convert_dB_to_power(-snr_db);
+    srsran_ch_awgn_f(rm_llr, rm_llr, var, E * nof_codewords);
+    srsran_vec_quant_fc(rm_llr, rm_llr_c, 127 * var / 20 / (1 / var + 2), 0, 127, E * nof_codewords);
+  }
+
+  for (uint32_t i = 0; i < nof_codewords; i++) {
+    srsran_polar_rm_rx_c(&rm_rx, rm_llr_c + i * E, llr_c + i * code.N, E, code.n, K, cfg->bil);
+    llr_ptr[i]  = llr_c + i * code.N;
+    data_ptr[i] = output_dec + i * code.N;
+  }
+
+  printf("%-6s K=%-4d E=%-5d N=%-5d", cfg->name, K, E, code.N);
+
+  for (uint32_t d = 0; d < NOF_BENCH_DECS; d++) {
+    const bench_dec_t* bench_dec = &bench_decs[d];
+
+    if (srsran_polar_decoder_init(&dec, bench_dec->type, cfg->nMax) < SRSRAN_SUCCESS) {
+      ERROR("Error initialising decoder %s", bench_dec->name);
+      goto clean_exit;
+    }
+
+    srsran_vec_u8_zero(output_dec, N * nof_codewords);
+
+    struct timeval t[3];
+    gettimeofday(&t[1], NULL);
+    for (uint32_t r = 0; r < nof_repetitions; r++) {
+      if (bench_dec->multi) {
+        srsran_polar_decoder_decode_c_multi(
+            &dec, llr_ptr, data_ptr, nof_codewords, code.n, code.F_set, code.F_set_size);
+      } else {
+        for (uint32_t i = 0; i < nof_codewords; i++) {
+          srsran_polar_decoder_decode_c(&dec, llr_ptr[i], data_ptr[i], code.n, code.F_set, code.F_set_size);
+        }
+      }
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    double elapsed_s = t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+    srsran_polar_decoder_free(&dec);
+
+    printf("  %s: %.0f cw/s", bench_dec->name, (double)nof_codewords * nof_repetitions / elapsed_s);
+
+    // The multi-codeword decoder is bit-exact with the single-codeword one
+    if (bench_dec->multi && data_ref != NULL && memcmp(data_ref, output_dec, N * nof_codewords) != 0) {
+      printf("\n");
+      ERROR("Decoder %s output does not match the single codeword output", bench_dec->name);
+      goto clean_exit;
+    }
+    if (!bench_dec->multi) {
+      srsran_vec_u8_copy(output_first, output_dec, N * nof_codewords);
+      data_ref = output_first;
+    }
+
+    // Without noise, all decoders recover the transmitted messages
+    if (snr_db == 101) {
+      for (uint32_t i = 0; i < nof_codewords; i++) {
+        srsran_polar_chanalloc_rx(output_dec + i * code.N, data_rx + i * K, code.K, code.nPC, code.K_set, code.PC_set);
+        if (srsran_bit_diff(data_tx + i * K, data_rx + i * K, K) != 0) {
+          printf("\n");
+          ERROR("Decoder %s failed to decode codeword %d", bench_dec->name, i);
+          goto clean_exit;
+        }
+      }
+    }
+  }
+  printf("\n");
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_polar_code_free(&code);
+  srsran_polar_encoder_free(&enc);
+  srsran_polar_rm_tx_free(&rm_tx);
+  srsran_polar_rm_rx_free_c(&rm_rx);
+  free(data_tx);
+  free(data_rx);
+  free(input_enc);
+  free(output_enc);
+  free(rm_codeword);
+  free(rm_llr);
+  free(rm_llr_c);
+  free(llr_c);
+  free(output_dec);
+  free(output_first);
+
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  if (nof_codewords == 0 || nof_codewords > MAX_NOF_CODEWORDS) {
+    ERROR("Invalid number of codewords %d", nof_codewords);
+    return SRSRAN_ERROR;
+  }
+
+  random_gen = srsran_random_init(0);
+
+  for (uint32_t c = 0; c < NOF_BENCH_CFGS; c++) {
+    if (bench_run(&bench_cfgs[c]) < SRSRAN_SUCCESS) {
+      goto clean_exit;
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random_gen);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+
+  return ret;
+}
@@ -29,10 +29,161 @@
 #include "srsran/phy/fec/softbuffer.h"
 #include "srsran/phy/fec/turbo/turbodecoder_gen.h"
 #include "srsran/phy/phch/ra.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 
 #define MAX_PDSCH_RE(cp) (2 * SRSRAN_CP_NSYMB(cp) * 12)
 
+static uint32_t softbuffer_pool_llr_size(const srsran_softbuffer_pool_t* q)
+{
+  return q->cb_size * (q->llr_is_8bit ? sizeof(int8_t) : sizeof(int16_t));
+}
+
+int srsran_softbuffer_pool_init(srsran_softbuffer_pool_t* q,
+                                bool                      is_rx,
+                                uint32_t                  cb_size,
+                                bool                      llr_is_8bit,
+                                uint32_t                  batch_size)
+{
+  if (q == NULL || cb_size == 0 || batch_size == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_softbuffer_pool_t, 1);
+  q->is_rx       = is_rx;
+  q->llr_is_8bit = is_rx && llr_is_8bit;
+  q->cb_size     = cb_size;
+  q->batch_size  = batch_size;
+
+  // Rx blocks hold the LLR followed by the decoded bits, Tx blocks the encoded bits. Keep every block SIMD aligned
+  uint32_t size = is_rx ? softbuffer_pool_llr_size(q) + cb_size / 8 : cb_size;
+  q->block_size = SRSRAN_CEIL(size, SRSRAN_SIMD_BIT_ALIGN / 8) * (SRSRAN_SIMD_BIT_ALIGN / 8);
+
+  if (pthread_mutex_init(&q->mutex, NULL)) {
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_softbuffer_pool_free(srsran_softbuffer_pool_t* q)
+{
+  if (q == NULL || q->block_size == 0) {
+    return;
+  }
+
+  if (q->nof_free != q->nof_blocks) {
+    ERROR("Freeing soft-buffer pool with %d code block buffers in use", q->nof_blocks - q->nof_free);
+  }
+
+  for (uint32_t i = 0; i < q->nof_batches; i++) {
+    free(q->batches[i]);
+  }
+  if (q->batches) {
+    free(q->batches);
+  }
+  if (q->free_list) {
+    free(q->free_list);
+  }
+  pthread_mutex_destroy(&q->mutex);
+
+  SRSRAN_MEM_ZERO(q, srsran_softbuffer_pool_t, 1);
+}
+
+uint32_t srsran_softbuffer_pool_nof_in_use(srsran_softbuffer_pool_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  uint32_t ret = q->nof_blocks - q->nof_free;
+  pthread_mutex_unlock(&q->mutex);
+  return ret;
+}
+
+size_t srsran_softbuffer_pool_nof_bytes(srsran_softbuffer_pool_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  size_t ret = (size_t)q->nof_blocks * q->block_size;
+  pthread_mutex_unlock(&q->mutex);
+  return ret;
+}
+
+// Adds a batch of blocks to the free list, called with the mutex locked
+static int softbuffer_pool_grow(srsran_softbuffer_pool_t* q)
+{
+  uint8_t** batches   = realloc(q->batches, sizeof(uint8_t*) * (q->nof_batches + 1));
+  uint8_t** free_list = realloc(q->free_list, sizeof(uint8_t*) * (q->nof_blocks + q->batch_size));
+  if (batches != NULL) {
+    q->batches = batches;
+  }
+  if (free_list != NULL) {
+    q->free_list = free_list;
+  }
+  if (batches == NULL || free_list == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  uint8_t* batch = srsran_vec_u8_malloc(q->block_size * q->batch_size);
+  if (batch == NULL) {
+    return SRSRAN_ERROR;
+  }
+  q->batches[q->nof_batches++] = batch;
+
+  for (uint32_t i = 0; i < q->batch_size; i++) {
+    q->free_list[q->nof_free++] = &batch[(size_t)i * q->block_size];
+  }
+  q->nof_blocks += q->batch_size;
+
+  return SRSRAN_SUCCESS;
+}
+
+// Binds or releases blocks so that blocks[0..nof_cb-1] are bound and the rest are NULL. Returns the number bound
+static uint32_t softbuffer_pool_bind(srsran_softbuffer_pool_t* q, uint8_t** blocks, uint32_t max_cb, uint32_t nof_cb)
+{
+  uint32_t i = 0;
+
+  pthread_mutex_lock(&q->mutex);
+  for (; i < nof_cb && blocks[i] != NULL; i++) {
+  }
+  for (; i < nof_cb; i++) {
+    if (q->nof_free == 0 && softbuffer_pool_grow(q) < SRSRAN_SUCCESS) {
+      ERROR("Error allocating soft-buffer pool batch of %d code blocks", q->batch_size);
+      break;
+    }
+    blocks[i] = q->free_list[--q->nof_free];
+  }
+  q->max_in_use = SRSRAN_MAX(q->max_in_use, q->nof_blocks - q->nof_free);
+  uint32_t nof_bound = i;
+
+  for (i = nof_bound; i < max_cb && blocks[i] != NULL; i++) {
+    q->free_list[q->nof_free++] = blocks[i];
+    blocks[i]                   = NULL;
+  }
+  pthread_mutex_unlock(&q->mutex);
+
+  return nof_bound;
+}
+
+static void softbuffer_rx_bind(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
+{
+  srsran_softbuffer_pool_t* pool = q->pool;
+
+  // The LLR pointer of each code block is also the base of its block, the decoded bits follow the LLR
+  nof_cb = softbuffer_pool_bind(pool, (uint8_t**)q->buffer_f, q->max_cb, nof_cb);
+  for (uint32_t i = 0; i < q->max_cb; i++) {
+    if (i < nof_cb) {
+      q->data[i] = (uint8_t*)q->buffer_f[i] + softbuffer_pool_llr_size(pool);
+      srsran_vec_u8_zero((uint8_t*)q->buffer_f[i], softbuffer_pool_llr_size(pool) + pool->cb_size / 8);
+    } else {
+      q->data[i] = NULL;
+    }
+  }
+}
+
+static void softbuffer_tx_bind(srsran_softbuffer_tx_t* q, uint32_t nof_cb)
+{
+  softbuffer_pool_bind(q->pool, q->buffer_b, q->max_cb, nof_cb);
+}
+
 int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof_prb)
 {
   int ret = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
@@ -109,9 +260,42 @@ clean_exit:
   return ret;
 }
 
+int srsran_softbuffer_rx_init_pool(srsran_softbuffer_rx_t* q, srsran_softbuffer_pool_t* pool, uint32_t max_cb)
+{
+  if (q == NULL || pool == NULL || !pool->is_rx) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_softbuffer_rx_t, 1);
+  q->max_cb      = max_cb;
+  q->max_cb_size = pool->cb_size;
+
+  // Allocate the pointer arrays only, they stay NULL until bound
+  q->buffer_f = SRSRAN_MEM_ALLOC(int16_t*, q->max_cb);
+  q->data     = SRSRAN_MEM_ALLOC(uint8_t*, q->max_cb);
+  q->cb_crc   = SRSRAN_MEM_ALLOC(bool, q->max_cb);
+  if (!q->buffer_f || !q->data || !q->cb_crc) {
+    perror("malloc");
+    srsran_softbuffer_rx_free(q);
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(q->buffer_f, int16_t*, q->max_cb);
+  SRSRAN_MEM_ZERO(q->data, uint8_t*, q->max_cb);
+  q->pool = pool;
+
+  srsran_softbuffer_rx_reset(q);
+
+  return SRSRAN_SUCCESS;
+}
+
 void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
 {
   if (q) {
+    // Pooled code block buffers go back to the pool, the pointer arrays are freed below
+    if (q->pool) {
+      softbuffer_rx_bind(q, 0);
+      q->pool = NULL;
+    }
     if (q->buffer_f) {
       for (uint32_t i = 0; i < q->max_cb; i++) {
         if (q->buffer_f[i]) {
@@ -144,12 +328,15 @@ void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs)
 
 void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* q)
 {
-  srsran_softbuffer_rx_reset_cb(q, q->max_cb);
+  // The number of code blocks of the next transport block is not known yet, pooled soft-buffers release them all
+  srsran_softbuffer_rx_reset_cb(q, q->pool ? 0 : q->max_cb);
 }
 
 void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
 {
-  if (q->buffer_f) {
+  if (q->pool) {
+    softbuffer_rx_bind(q, SRSRAN_MIN(nof_cb, q->max_cb));
+  } else if (q->buffer_f) {
     if (nof_cb > q->max_cb) {
       nof_cb = q->max_cb;
     }
@@ -224,9 +411,35 @@ int srsran_softbuffer_tx_init_guru(srsran_softbuffer_tx_t* q, uint32_t max_cb, u
   return SRSRAN_SUCCESS;
 }
 
+int srsran_softbuffer_tx_init_pool(srsran_softbuffer_tx_t* q, srsran_softbuffer_pool_t* pool, uint32_t max_cb)
+{
+  if (q == NULL || pool == NULL || pool->is_rx) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_softbuffer_tx_t, 1);
+  q->max_cb      = max_cb;
+  q->max_cb_size = pool->cb_size;
+
+  // Allocate the pointer array only, it stays NULL until bound
+  q->buffer_b = SRSRAN_MEM_ALLOC(uint8_t*, q->max_cb);
+  if (!q->buffer_b) {
+    perror("malloc");
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(q->buffer_b, uint8_t*, q->max_cb);
+  q->pool = pool;
+
+  return SRSRAN_SUCCESS;
+}
+
 void srsran_softbuffer_tx_free(srsran_softbuffer_tx_t* q)
 {
   if (q) {
+    if (q->pool) {
+      softbuffer_tx_bind(q, 0);
+      q->pool = NULL;
+    }
     if (q->buffer_b) {
       for (uint32_t i = 0; i < q->max_cb; i++) {
         if (q->buffer_b[i]) {
@@ -247,12 +460,14 @@ void srsran_softbuffer_tx_reset_tbs(srsran_softbuffer_tx_t* q, uint32_t tbs)
 
 void srsran_softbuffer_tx_reset(srsran_softbuffer_tx_t* q)
 {
-  srsran_softbuffer_tx_reset_cb(q, q->max_cb);
+  srsran_softbuffer_tx_reset_cb(q, q->pool ? 0 : q->max_cb);
 }
 
 void srsran_softbuffer_tx_reset_cb(srsran_softbuffer_tx_t* q, uint32_t nof_cb)
 {
-  if (q->buffer_b) {
+  if (q->pool) {
+    softbuffer_tx_bind(q, SRSRAN_MIN(nof_cb, q->max_cb));
+  } else if (q->buffer_b) {
     if (nof_cb > q->max_cb) {
       nof_cb = q->max_cb;
     }
@@ -24,6 +24,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
+#include <sys/time.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -33,6 +34,7 @@
 int      num_bits = 5001, crc_length = 24;
 uint32_t crc_poly = 0x1864CFB;
 uint32_t seed     = 1;
+uint32_t nof_reps = 1000;
 
 void usage(char* prog)
 {
@@ -41,13 +43,14 @@ void usage(char* prog)
   printf("\t-l crc_length [Default %d]\n", crc_length);
   printf("\t-p crc_poly (Hex) [Default 0x%x]\n", crc_poly);
   printf("\t-s seed [Default 0=time]\n");
+  printf("\t-r number of benchmark repetitions [Default %d]\n", nof_reps);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "nlpsv")) != -1) {
+  while ((opt = getopt(argc, argv, "nlpsrv")) != -1) {
     switch (opt) {
       case 'n':
         num_bits = (int)strtol(argv[optind], NULL, 10);
@@ -61,6 +64,9 @@ void parse_args(int argc, char** argv)
       case 's':
         seed = (uint32_t)strtoul(argv[optind], NULL, 0);
         break;
+      case 'r':
+        nof_reps = (uint32_t)strtoul(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -71,6 +77,82 @@ void parse_args(int argc, char** argv)
   }
 }
 
+// Bit-serial checksum, used as reference
+static uint32_t crc_reference(const uint8_t* bits, uint32_t nof_bits)
+{
+  uint64_t mask = ((uint64_t)1 << crc_length) - 1;
+  uint64_t crc  = 0;
+  for (uint32_t i = 0; i < nof_bits; i++) {
+    bool feedback = ((crc >> (crc_length - 1)) & 1) != bits[i];
+    crc           = (crc << 1) & mask;
+    if (feedback) {
+      crc ^= crc_poly & mask;
+    }
+  }
+  return (uint32_t)crc;
+}
+
+// Checks the unpacked, packed and incremental checksums against the reference for every length up to num_bits
+static int test_crc_engines(srsran_crc_t* crc_p, const uint8_t* data, uint8_t* data_packed)
+{
+  srsran_bit_pack_vector((uint8_t*)data, data_packed, num_bits);
+
+  for (uint32_t len = 0; len <= (uint32_t)num_bits; len += (len < 256) ? 1 : 61) {
+    uint32_t expected = crc_reference(data, len);
+
+    if (srsran_crc_checksum(crc_p, (uint8_t*)data, len) != expected) {
+      ERROR("Unpacked checksum mismatch for %d bits", len);
+      return SRSRAN_ERROR;
+    }
+
+    if (len % 8 == 0 && srsran_crc_checksum_byte(crc_p, data_packed, len) != expected) {
+      ERROR("Packed checksum mismatch for %d bits", len);
+      return SRSRAN_ERROR;
+    }
+
+    // Split at an arbitrary point, not multiple of 8
+    uint32_t split = (len * 5) / 7;
+    srsran_crc_set_init(crc_p, 0);
+    srsran_crc_checksum_put_bits(crc_p, data, split);
+    srsran_crc_checksum_put_bits(crc_p, data + split, len - split);
+    if ((uint32_t)srsran_crc_checksum_get(crc_p) != expected) {
+      ERROR("Incremental checksum mismatch for %d bits split at %d", len, split);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static void benchmark_crc(srsran_crc_t* crc_p, uint8_t* data, const uint8_t* data_packed)
+{
+  struct timeval t[3] = {};
+  uint32_t       len8 = ((uint32_t)num_bits / 8) * 8;
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < nof_reps; r++) {
+    srsran_crc_checksum(crc_p, data, num_bits);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t unpacked_us = t[0].tv_sec * 1000000UL + t[0].tv_usec;
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < nof_reps; r++) {
+    srsran_crc_checksum_byte(crc_p, data_packed, len8);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t packed_us = t[0].tv_sec * 1000000UL + t[0].tv_usec;
+
+  printf("CRC%d (0x%x) %d bits: unpacked %.1f Mbps; packed %.1f Mbps\n",
+         crc_length,
+         crc_poly,
+         num_bits,
+         (double)num_bits * nof_reps / (double)SRSRAN_MAX(unpacked_us, 1),
+         (double)len8 * nof_reps / (double)SRSRAN_MAX(packed_us, 1));
+}
+
 int main(int argc, char** argv)
 {
   int          i;
@@ -111,6 +193,19 @@ int main(int argc, char** argv)
 
   INFO("checksum=%x", crc_word);
 
+  // Check the engines against the bit-serial reference
+  uint8_t* data_packed = srsran_vec_u8_malloc(num_bits / 8 + 1);
+  if (!data_packed) {
+    perror("malloc");
+    exit(-1);
+  }
+  if (test_crc_engines(&crc_p, data, data_packed) != SRSRAN_SUCCESS) {
+    exit(-1);
+  }
+
+  benchmark_crc(&crc_p, data, data_packed);
+
+  free(data_packed);
   free(data);
 
   // check if generated word is as expected
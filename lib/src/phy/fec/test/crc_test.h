@@ -36,6 +36,7 @@ static expected_word_t expected_words[] = {
 
     {5001, 24, SRSRAN_LTE_CRC24A, 1, 0x1C5C97}, // LTE CRC24A (36.212 Sec 5.1.1)
     {5001, 24, SRSRAN_LTE_CRC24B, 1, 0x36D1F0}, // LTE CRC24B
+    {5001, 24, SRSRAN_LTE_CRC24C, 1, 0x87CFA4}, // NR CRC24C
     {5001, 16, SRSRAN_LTE_CRC16, 1, 0x7FF4},    // LTE CRC16: 0x7FF4
     {5001, 8, SRSRAN_LTE_CRC8, 1, 0xF0},        // LTE CRC8 0xF8
     {30, 11, SRSRAN_LTE_CRC11, 1, 0x114},       // NR CRC11 0x114
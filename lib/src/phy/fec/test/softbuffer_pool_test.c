@@ -0,0 +1,355 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Compares the memory footprint and the cost of a TTI of the classic per-HARQ soft-buffers (16-bit LLR, sized for the
+ * largest TBS) against the pooled soft-buffers (8-bit LLR, code blocks bound for the actual TBS while the HARQ process
+ * is active) for an increasing number of UEs.
+ */
+
+#include <linux/perf_event.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+
+#define NOF_HARQ 8
+#define NOF_PRB 100
+
+static uint32_t nof_tti     = 200;
+static uint32_t max_nof_ue  = 128;
+static uint32_t tbs_bits    = 24496; // 4 code blocks
+static uint32_t active_rate = 4;     // Each UE is scheduled one out of active_rate TTIs
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [ntuav]\n", prog);
+  printf("\t-n number of TTI [Default %d]\n", nof_tti);
+  printf("\t-u maximum number of UEs [Default %d]\n", max_nof_ue);
+  printf("\t-t TBS in bits [Default %d]\n", tbs_bits);
+  printf("\t-a a UE is scheduled once every this number of TTI [Default %d]\n", active_rate);
+  printf("\t-v increase verbosity\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "ntuav")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_tti = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'u':
+        max_nof_ue = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        tbs_bits = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'a':
+        active_rate = SRSRAN_MAX((uint32_t)strtol(argv[optind], NULL, 10), 1);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// Resident set size in bytes, 0 if not available
+static size_t get_rss(void)
+{
+  size_t size = 0, resident = 0;
+  FILE*  f    = fopen("/proc/self/statm", "r");
+  if (f == NULL) {
+    return 0;
+  }
+  if (fscanf(f, "%zu %zu", &size, &resident) != 2) {
+    resident = 0;
+  }
+  fclose(f);
+  return resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+// Last level cache counters, the file descriptors are -1 if the kernel does not allow them
+typedef struct {
+  int fd_ref;
+  int fd_miss;
+} llc_counters_t;
+
+static int llc_open(uint64_t config)
+{
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type           = PERF_TYPE_HARDWARE;
+  attr.size           = sizeof(attr);
+  attr.config         = config;
+  attr.disabled       = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv     = 1;
+  return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void llc_start(llc_counters_t* c)
+{
+  c->fd_ref  = llc_open(PERF_COUNT_HW_CACHE_REFERENCES);
+  c->fd_miss = llc_open(PERF_COUNT_HW_CACHE_MISSES);
+  if (c->fd_ref >= 0 && c->fd_miss >= 0) {
+    ioctl(c->fd_ref, PERF_EVENT_IOC_RESET, 0);
+    ioctl(c->fd_miss, PERF_EVENT_IOC_RESET, 0);
+    ioctl(c->fd_ref, PERF_EVENT_IOC_ENABLE, 0);
+    ioctl(c->fd_miss, PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+// Returns the miss rate in percent, or a negative value if not available
+static double llc_stop(llc_counters_t* c)
+{
+  double   rate = -1.0;
+  uint64_t ref = 0, miss = 0;
+  if (c->fd_ref >= 0 && c->fd_miss >= 0) {
+    ioctl(c->fd_ref, PERF_EVENT_IOC_DISABLE, 0);
+    ioctl(c->fd_miss, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(c->fd_ref, &ref, sizeof(ref)) == sizeof(ref) && read(c->fd_miss, &miss, sizeof(miss)) == sizeof(miss) &&
+        ref > 0) {
+      rate = 100.0 * (double)miss / (double)ref;
+    }
+  }
+  if (c->fd_ref >= 0) {
+    close(c->fd_ref);
+  }
+  if (c->fd_miss >= 0) {
+    close(c->fd_miss);
+  }
+  return rate;
+}
+
+// Combines a retransmission into the bound code blocks of a soft-buffer, as the turbo decoder does
+static void combine(srsran_softbuffer_rx_t* sb, bool llr_is_8bit, uint32_t nof_cb, const int8_t* llr, uint32_t cb_len)
+{
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    if (llr_is_8bit) {
+      int8_t* w = (int8_t*)sb->buffer_f[i];
+      for (uint32_t j = 0; j < cb_len; j++) {
+        int32_t v = (int32_t)w[j] + llr[j];
+        w[j]      = (int8_t)SRSRAN_MAX(SRSRAN_MIN(v, INT8_MAX), INT8_MIN);
+      }
+    } else {
+      int16_t* w = sb->buffer_f[i];
+      for (uint32_t j = 0; j < cb_len; j++) {
+        int32_t v = (int32_t)w[j] + llr[j];
+        w[j]      = (int16_t)SRSRAN_MAX(SRSRAN_MIN(v, INT16_MAX), INT16_MIN);
+      }
+    }
+  }
+}
+
+typedef struct {
+  size_t rss;
+  double ns_per_tti;
+  double llc_miss_rate;
+  size_t pool_bytes;
+} result_t;
+
+static int run(uint32_t nof_ue, bool pooled, const int8_t* llr, uint32_t cb_len, uint32_t nof_cb, result_t* res)
+{
+  int                      ret  = SRSRAN_ERROR;
+  srsran_softbuffer_pool_t pool = {0};
+  srsran_softbuffer_rx_t*  sb   = SRSRAN_MEM_ALLOC(srsran_softbuffer_rx_t, nof_ue * NOF_HARQ);
+  uint32_t                 max_cb =
+      (uint32_t)srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, NOF_PRB) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
+  if (sb == NULL) {
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(sb, srsran_softbuffer_rx_t, nof_ue * NOF_HARQ);
+
+  size_t rss0 = get_rss();
+  if (pooled && srsran_softbuffer_pool_init(&pool, true, SOFTBUFFER_SIZE, true, max_cb) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+  for (uint32_t i = 0; i < nof_ue * NOF_HARQ; i++) {
+    int r = pooled ? srsran_softbuffer_rx_init_pool(&sb[i], &pool, max_cb) : srsran_softbuffer_rx_init(&sb[i], NOF_PRB);
+    if (r < SRSRAN_SUCCESS) {
+      goto clean_exit;
+    }
+  }
+
+  llc_counters_t llc = {0};
+  struct timeval t[3];
+  gettimeofday(&t[1], NULL);
+  llc_start(&llc);
+  for (uint32_t tti = 0; tti < nof_tti; tti++) {
+    for (uint32_t ue = 0; ue < nof_ue; ue++) {
+      if ((tti + ue) % active_rate != 0) {
+        continue;
+      }
+      srsran_softbuffer_rx_t* b = &sb[ue * NOF_HARQ + tti % NOF_HARQ];
+
+      // New transmission, then a retransmission combined on top, then released as the CRC is OK
+      srsran_softbuffer_rx_reset_tbs(b, tbs_bits);
+      combine(b, pooled, nof_cb, llr, cb_len);
+      combine(b, pooled, nof_cb, llr, cb_len);
+      if (pooled) {
+        srsran_softbuffer_rx_reset(b);
+      }
+    }
+  }
+  res->llc_miss_rate = llc_stop(&llc);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  res->ns_per_tti = (t[0].tv_sec * 1e9 + t[0].tv_usec * 1e3) / nof_tti;
+  res->rss        = get_rss() - rss0;
+  res->pool_bytes = pooled ? srsran_softbuffer_pool_nof_bytes(&pool) : 0;
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  for (uint32_t i = 0; i < nof_ue * NOF_HARQ; i++) {
+    srsran_softbuffer_rx_free(&sb[i]);
+  }
+  free(sb);
+  srsran_softbuffer_pool_free(&pool);
+
+  // Give the memory back so the next run starts from the same resident size
+  malloc_trim(0);
+  return ret;
+}
+
+// Checks the code blocks are bound for the TBS, zeroed, released and sized for 8-bit LLR
+static int test_pool(void)
+{
+  int                      ret  = SRSRAN_ERROR;
+  srsran_softbuffer_pool_t pool = {0};
+  srsran_softbuffer_rx_t   sb[2];
+  SRSRAN_MEM_ZERO(sb, srsran_softbuffer_rx_t, 2);
+
+  if (srsran_softbuffer_pool_init(&pool, true, SOFTBUFFER_SIZE, true, 4) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  if (pool.block_size < SOFTBUFFER_SIZE + SOFTBUFFER_SIZE / 8 || pool.block_size >= 2 * SOFTBUFFER_SIZE) {
+    ERROR("Unexpected 8-bit code block size %d", pool.block_size);
+    goto clean_exit;
+  }
+  for (uint32_t i = 0; i < 2; i++) {
+    if (srsran_softbuffer_rx_init_pool(&sb[i], &pool, 13) < SRSRAN_SUCCESS) {
+      goto clean_exit;
+    }
+  }
+  if (srsran_softbuffer_pool_nof_in_use(&pool) != 0) {
+    ERROR("Code blocks bound before any transmission");
+    goto clean_exit;
+  }
+
+  srsran_softbuffer_rx_reset_cb(&sb[0], 5);
+  srsran_softbuffer_rx_reset_cb(&sb[1], 20);
+  if (srsran_softbuffer_pool_nof_in_use(&pool) != 5 + 13 || sb[1].buffer_f[12] == NULL || sb[0].buffer_f[5] != NULL) {
+    ERROR("Wrong number of bound code blocks %d", srsran_softbuffer_pool_nof_in_use(&pool));
+    goto clean_exit;
+  }
+
+  // Dirty a code block and check a new transport block finds it cleared
+  memset(sb[0].buffer_f[0], 0x55, SOFTBUFFER_SIZE);
+  srsran_softbuffer_rx_reset(&sb[0]);
+  srsran_softbuffer_rx_reset_cb(&sb[0], 1);
+  for (uint32_t i = 0; i < SOFTBUFFER_SIZE; i++) {
+    if (((int8_t*)sb[0].buffer_f[0])[i] != 0) {
+      ERROR("Code block not cleared at %d", i);
+      goto clean_exit;
+    }
+  }
+
+  srsran_softbuffer_rx_reset(&sb[0]);
+  srsran_softbuffer_rx_reset(&sb[1]);
+  if (srsran_softbuffer_pool_nof_in_use(&pool) != 0) {
+    ERROR("Code blocks not released");
+    goto clean_exit;
+  }
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_softbuffer_rx_free(&sb[0]);
+  srsran_softbuffer_rx_free(&sb[1]);
+  srsran_softbuffer_pool_free(&pool);
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  int              ret    = SRSRAN_ERROR;
+  srsran_random_t  random = srsran_random_init(0x1234);
+  srsran_cbsegm_t  cbsegm = {0};
+  int8_t*          llr    = srsran_vec_i8_malloc(3 * SRSRAN_TCOD_MAX_LEN_CB + 12);
+  const uint32_t   ue_count[] = {1, 8, 32, 128};
+
+  parse_args(argc, argv);
+
+  if (llr == NULL || srsran_cbsegm(&cbsegm, tbs_bits) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+  uint32_t cb_len = 3 * cbsegm.K1 + 12;
+  for (uint32_t i = 0; i < cb_len; i++) {
+    llr[i] = (int8_t)srsran_random_uniform_int_dist(random, -16, 16);
+  }
+
+  if (test_pool() < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  printf("%-6s %-7s %12s %12s %12s %10s\n", "UEs", "buffers", "RSS (kB)", "pool (kB)", "ns/TTI", "LLC miss");
+  for (uint32_t i = 0; i < sizeof(ue_count) / sizeof(ue_count[0]) && ue_count[i] <= max_nof_ue; i++) {
+    for (uint32_t pooled = 0; pooled < 2; pooled++) {
+      result_t res = {0};
+      if (run(ue_count[i], pooled, llr, cb_len, cbsegm.C, &res) < SRSRAN_SUCCESS) {
+        ERROR("Error running %d UEs", ue_count[i]);
+        goto clean_exit;
+      }
+      char miss[16] = "n/a";
+      if (res.llc_miss_rate >= 0.0) {
+        snprintf(miss, sizeof(miss), "%.1f%%", res.llc_miss_rate);
+      }
+      printf("%-6d %-7s %12zu %12zu %12.0f %10s\n",
+             ue_count[i],
+             pooled ? "pooled" : "classic",
+             res.rss / 1024,
+             res.pool_bytes / 1024,
+             res.ns_per_tti,
+             miss);
+    }
+  }
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (llr) {
+    free(llr);
+  }
+  srsran_random_free(random);
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -35,4 +35,29 @@
 #define SRSRAN_AVX2_B_SIZE 32    /*!< \brief Number of packed bytes in an AVX2 instruction. */
 #define SRSRAN_AVX2_B_SIZE_LOG 5 /*!< \brief \f$\log_2\f$ of \ref SRSRAN_AVX2_B_SIZE. */
 
+#ifdef LV_HAVE_AVX2
+
+#include <immintrin.h>
+
+/*!
+ * Hard decision of nof_llr LLR, null LLR are decided as one. Returns the number of null LLR.
+ */
+static inline int fec_avx2_hard_decision_null_c(const int8_t* llr, uint8_t* message, int nof_llr)
+{
+  int nof_null = 0;
+  int k        = 0;
+  for (; k < nof_llr - (SRSRAN_AVX2_B_SIZE - 1); k += SRSRAN_AVX2_B_SIZE) {
+    __m256i x = _mm256_loadu_si256((__m256i*)&llr[k]);
+    __m256i m = _mm256_cmpgt_epi8(_mm256_set1_epi8(1), x);
+    _mm256_storeu_si256((__m256i*)&message[k], _mm256_and_si256(m, _mm256_set1_epi8(1)));
+    nof_null += __builtin_popcount((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, _mm256_setzero_si256())));
+  }
+  for (; k < nof_llr; k++) {
+    message[k] = (llr[k] <= 0);
+    nof_null += (llr[k] == 0);
+  }
+  return nof_null;
+}
+#endif // LV_HAVE_AVX2
+
 #endif // SRSRAN_UTILS_AVX2_H
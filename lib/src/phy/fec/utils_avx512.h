@@ -50,6 +50,26 @@ static inline void fec_avx512_hard_decision_c(const int8_t* llr, uint8_t* messag
     message[k] = (llr[k] < 0);
   }
 }
+
+/*!
+ * Hard decision of nof_llr LLR, null LLR are decided as one. Returns the number of null LLR.
+ */
+static inline int fec_avx512_hard_decision_null_c(const int8_t* llr, uint8_t* message, int nof_llr)
+{
+  int nof_null = 0;
+  int k        = 0;
+  for (; k < nof_llr - (SRSRAN_AVX512_B_SIZE - 1); k += SRSRAN_AVX512_B_SIZE) {
+    __m512i   x    = _mm512_loadu_si512((__m512i*)&llr[k]);
+    __mmask64 mask = _mm512_cmpgt_epi8_mask(x, _mm512_set1_epi8(0));
+    _mm512_storeu_si512((__m512i*)&message[k], _mm512_mask_blend_epi8(mask, _mm512_set1_epi8(1), _mm512_set1_epi8(0)));
+    nof_null += __builtin_popcountll(_mm512_cmpeq_epi8_mask(x, _mm512_setzero_si512()));
+  }
+  for (; k < nof_llr; k++) {
+    message[k] = (llr[k] <= 0);
+    nof_null += (llr[k] == 0);
+  }
+  return nof_null;
+}
 #endif // LV_HAVE_AVX512
 
 #endif // SRSRAN_UTILS_AVX512_H
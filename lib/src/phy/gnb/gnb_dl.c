@@ -48,6 +48,35 @@ static int gnb_dl_alloc_prb(srsran_gnb_dl_t* q, uint32_t new_nof_prb)
   return SRSRAN_SUCCESS;
 }
 
+static int gnb_dl_init_pdsch_lanes(srsran_gnb_dl_t* q, const srsran_gnb_dl_args_t* args)
+{
+  if (args->nof_pdsch_lanes == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  q->pdsch_lanes = SRSRAN_MEM_ALLOC(srsran_gnb_dl_pdsch_lane_t, args->nof_pdsch_lanes);
+  if (q->pdsch_lanes == NULL) {
+    ERROR("Malloc");
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(q->pdsch_lanes, srsran_gnb_dl_pdsch_lane_t, args->nof_pdsch_lanes);
+  q->nof_pdsch_lanes = args->nof_pdsch_lanes;
+
+  for (uint32_t i = 0; i < q->nof_pdsch_lanes; i++) {
+    if (srsran_pdsch_nr_init_enb(&q->pdsch_lanes[i].pdsch, &args->pdsch) < SRSRAN_SUCCESS) {
+      ERROR("Error PDSCH lane %d", i);
+      return SRSRAN_ERROR;
+    }
+
+    if (srsran_dmrs_sch_init(&q->pdsch_lanes[i].dmrs, false) < SRSRAN_SUCCESS) {
+      ERROR("Error DMRS lane %d", i);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_gnb_dl_init(srsran_gnb_dl_t* q, cf_t* output[SRSRAN_MAX_PORTS], const srsran_gnb_dl_args_t* args)
 {
   if (!q || !output || !args) {
@@ -98,6 +127,10 @@ int srsran_gnb_dl_init(srsran_gnb_dl_t* q, cf_t* output[SRSRAN_MAX_PORTS], const
     return SRSRAN_ERROR;
   }
 
+  if (gnb_dl_init_pdsch_lanes(q, args) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   if (srsran_pdcch_nr_init_tx(&q->pdcch, &args->pdcch) < SRSRAN_SUCCESS) {
     ERROR("Error PDCCH");
     return SRSRAN_ERROR;
@@ -132,6 +165,14 @@ void srsran_gnb_dl_free(srsran_gnb_dl_t* q)
   srsran_pdsch_nr_free(&q->pdsch);
   srsran_dmrs_sch_free(&q->dmrs);
 
+  if (q->pdsch_lanes != NULL) {
+    for (uint32_t i = 0; i < q->nof_pdsch_lanes; i++) {
+      srsran_pdsch_nr_free(&q->pdsch_lanes[i].pdsch);
+      srsran_dmrs_sch_free(&q->pdsch_lanes[i].dmrs);
+    }
+    free(q->pdsch_lanes);
+  }
+
   srsran_pdcch_nr_free(&q->pdcch);
   srsran_ssb_free(&q->ssb);
 
@@ -149,6 +190,17 @@ int srsran_gnb_dl_set_carrier(srsran_gnb_dl_t* q, const srsran_carrier_nr_t* car
     return SRSRAN_ERROR;
   }
 
+  for (uint32_t i = 0; i < q->nof_pdsch_lanes; i++) {
+    if (srsran_pdsch_nr_set_carrier(&q->pdsch_lanes[i].pdsch, carrier) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    if (srsran_dmrs_sch_set_carrier(&q->pdsch_lanes[i].dmrs, carrier) < SRSRAN_SUCCESS) {
+      ERROR("Error DMRS lane %d", i);
+      return SRSRAN_ERROR;
+    }
+  }
+
   if (gnb_dl_alloc_prb(q, carrier->nof_prb) < SRSRAN_SUCCESS) {
     ERROR("Error allocating");
     return SRSRAN_ERROR;
@@ -333,23 +385,64 @@ int srsran_gnb_dl_pdsch_put(srsran_gnb_dl_t*           q,
                             const srsran_sch_cfg_nr_t* cfg,
                             uint8_t*                   data[SRSRAN_MAX_TB])
 {
-  if (srsran_dmrs_sch_put_sf(&q->dmrs, slot, cfg, &cfg->grant, q->sf_symbols[0]) < SRSRAN_SUCCESS) {
+  return srsran_gnb_dl_pdsch_put_lane(q, 0, slot, cfg, data);
+}
+
+int srsran_gnb_dl_pdsch_put_lane(srsran_gnb_dl_t*           q,
+                                 uint32_t                   lane_idx,
+                                 const srsran_slot_cfg_t*   slot,
+                                 const srsran_sch_cfg_nr_t* cfg,
+                                 uint8_t*                   data[SRSRAN_MAX_TB])
+{
+  if (q == NULL || lane_idx > q->nof_pdsch_lanes) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  srsran_pdsch_nr_t* pdsch = (lane_idx == 0) ? &q->pdsch : &q->pdsch_lanes[lane_idx - 1].pdsch;
+  srsran_dmrs_sch_t* dmrs  = (lane_idx == 0) ? &q->dmrs : &q->pdsch_lanes[lane_idx - 1].dmrs;
+
+  if (srsran_dmrs_sch_put_sf(dmrs, slot, cfg, &cfg->grant, q->sf_symbols[0]) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
-  if (srsran_pdsch_nr_encode(&q->pdsch, cfg, &cfg->grant, data, q->sf_symbols) < SRSRAN_SUCCESS) {
+  if (srsran_pdsch_nr_encode(pdsch, cfg, &cfg->grant, data, q->sf_symbols) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   return SRSRAN_SUCCESS;
 }
 
+uint32_t srsran_gnb_dl_nof_pdsch_lanes(const srsran_gnb_dl_t* q)
+{
+  if (q == NULL) {
+    return 0;
+  }
+
+  // Count the default lane too
+  return q->nof_pdsch_lanes + 1;
+}
+
 int srsran_gnb_dl_pdsch_info(const srsran_gnb_dl_t* q, const srsran_sch_cfg_nr_t* cfg, char* str, uint32_t str_len)
 {
+  return srsran_gnb_dl_pdsch_lane_info(q, 0, cfg, str, str_len);
+}
+
+int srsran_gnb_dl_pdsch_lane_info(const srsran_gnb_dl_t*     q,
+                                  uint32_t                   lane_idx,
+                                  const srsran_sch_cfg_nr_t* cfg,
+                                  char*                      str,
+                                  uint32_t                   str_len)
+{
+  if (q == NULL || lane_idx > q->nof_pdsch_lanes) {
+    return 0;
+  }
+
+  const srsran_pdsch_nr_t* pdsch = (lane_idx == 0) ? &q->pdsch : &q->pdsch_lanes[lane_idx - 1].pdsch;
+
   int len = 0;
 
   // Append PDSCH info
-  len += srsran_pdsch_nr_tx_info(&q->pdsch, cfg, &cfg->grant, &str[len], str_len - len);
+  len += srsran_pdsch_nr_tx_info(pdsch, cfg, &cfg->grant, &str[len], str_len - len);
 
   return len;
 }
@@ -44,6 +44,13 @@ static int gnb_ul_alloc_prb(srsran_gnb_ul_t* q, uint32_t new_nof_prb)
       return SRSRAN_ERROR;
     }
 
+    for (uint32_t i = 0; i < q->nof_pusch_lanes; i++) {
+      srsran_chest_dl_res_free(&q->pusch_lanes[i].chest);
+      if (srsran_chest_dl_res_init(&q->pusch_lanes[i].chest, q->max_prb) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+
     srsran_chest_ul_res_free(&q->chest_pucch);
     if (srsran_chest_ul_res_init(&q->chest_pucch, q->max_prb) < SRSRAN_SUCCESS) {
       return SRSRAN_ERROR;
@@ -63,12 +70,44 @@ static int gnb_ul_alloc_prb(srsran_gnb_ul_t* q, uint32_t new_nof_prb)
   return SRSRAN_SUCCESS;
 }
 
+static int gnb_ul_init_pusch_lanes(srsran_gnb_ul_t* q, const srsran_gnb_ul_args_t* args)
+{
+  if (args->nof_pusch_lanes == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  q->pusch_lanes = SRSRAN_MEM_ALLOC(srsran_gnb_ul_pusch_lane_t, args->nof_pusch_lanes);
+  if (q->pusch_lanes == NULL) {
+    ERROR("Malloc");
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(q->pusch_lanes, srsran_gnb_ul_pusch_lane_t, args->nof_pusch_lanes);
+  q->nof_pusch_lanes = args->nof_pusch_lanes;
+
+  for (uint32_t i = 0; i < q->nof_pusch_lanes; i++) {
+    if (srsran_pusch_nr_init_gnb(&q->pusch_lanes[i].pusch, &args->pusch) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    if (srsran_dmrs_sch_init(&q->pusch_lanes[i].dmrs, true) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_gnb_ul_init(srsran_gnb_ul_t* q, cf_t* input, const srsran_gnb_ul_args_t* args)
 {
   if (q == NULL || args == NULL) {
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
+  // Lanes must be created before allocating the resources that depend on the number of PRB
+  if (gnb_ul_init_pusch_lanes(q, args) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   if (gnb_ul_alloc_prb(q, args->nof_max_prb) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
@@ -119,6 +158,15 @@ void srsran_gnb_ul_free(srsran_gnb_ul_t* q)
   srsran_chest_dl_res_free(&q->chest_pusch);
   srsran_chest_ul_res_free(&q->chest_pucch);
 
+  if (q->pusch_lanes != NULL) {
+    for (uint32_t i = 0; i < q->nof_pusch_lanes; i++) {
+      srsran_pusch_nr_free(&q->pusch_lanes[i].pusch);
+      srsran_dmrs_sch_free(&q->pusch_lanes[i].dmrs);
+      srsran_chest_dl_res_free(&q->pusch_lanes[i].chest);
+    }
+    free(q->pusch_lanes);
+  }
+
   if (q->sf_symbols[0] != NULL) {
     free(q->sf_symbols[0]);
   }
@@ -150,6 +198,16 @@ int srsran_gnb_ul_set_carrier(srsran_gnb_ul_t* q, const srsran_carrier_nr_t* car
     return SRSRAN_ERROR;
   }
 
+  for (uint32_t i = 0; i < q->nof_pusch_lanes; i++) {
+    if (srsran_pusch_nr_set_carrier(&q->pusch_lanes[i].pusch, carrier) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    if (srsran_dmrs_sch_set_carrier(&q->pusch_lanes[i].dmrs, carrier) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
   srsran_ofdm_cfg_t ofdm_cfg     = {};
   ofdm_cfg.nof_prb               = carrier->nof_prb;
   ofdm_cfg.rx_window_offset      = GNB_UL_NR_FFT_WINDOW_OFFSET;
@@ -181,16 +239,35 @@ int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
                             const srsran_sch_grant_nr_t* grant,
                             srsran_pusch_res_nr_t*       data)
 {
-  if (q == NULL || cfg == NULL || grant == NULL || data == NULL) {
+  return srsran_gnb_ul_get_pusch_lane(q, 0, slot_cfg, cfg, grant, data, NULL);
+}
+
+int srsran_gnb_ul_get_pusch_lane(srsran_gnb_ul_t*               q,
+                                 uint32_t                       lane_idx,
+                                 const srsran_slot_cfg_t*       slot_cfg,
+                                 const srsran_sch_cfg_nr_t*     cfg,
+                                 const srsran_sch_grant_nr_t*   grant,
+                                 srsran_pusch_res_nr_t*         data,
+                                 srsran_csi_trs_measurements_t* csi)
+{
+  if (q == NULL || cfg == NULL || grant == NULL || data == NULL || lane_idx > q->nof_pusch_lanes) {
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
-  if (srsran_dmrs_sch_estimate(&q->dmrs, slot_cfg, cfg, grant, q->sf_symbols[0], &q->chest_pusch) < SRSRAN_SUCCESS) {
+  srsran_pusch_nr_t*     pusch = (lane_idx == 0) ? &q->pusch : &q->pusch_lanes[lane_idx - 1].pusch;
+  srsran_dmrs_sch_t*     dmrs  = (lane_idx == 0) ? &q->dmrs : &q->pusch_lanes[lane_idx - 1].dmrs;
+  srsran_chest_dl_res_t* chest = (lane_idx == 0) ? &q->chest_pusch : &q->pusch_lanes[lane_idx - 1].chest;
+
+  if (srsran_dmrs_sch_estimate(dmrs, slot_cfg, cfg, grant, q->sf_symbols[0], chest) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
+  if (csi != NULL) {
+    *csi = dmrs->csi;
+  }
+
   // Check PUSCH DMRS minimum SNR and abort PUSCH decoding if it is below the threshold
-  if (q->dmrs.csi.snr_dB < q->pusch_min_snr_dB) {
+  if (dmrs->csi.snr_dB < q->pusch_min_snr_dB) {
     // Set PUSCH data as not decoded
     data->tb[0].crc      = false;
     data->tb[0].avg_iter = NAN;
@@ -198,13 +275,23 @@ int srsran_gnb_ul_get_pusch(srsran_gnb_ul_t*             q,
     return SRSRAN_SUCCESS;
   }
 
-  if (srsran_pusch_nr_decode(&q->pusch, cfg, grant, &q->chest_pusch, q->sf_symbols, data) < SRSRAN_SUCCESS) {
+  if (srsran_pusch_nr_decode(pusch, cfg, grant, chest, q->sf_symbols, data) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
   return SRSRAN_SUCCESS;
 }
 
+uint32_t srsran_gnb_ul_nof_pusch_lanes(const srsran_gnb_ul_t* q)
+{
+  if (q == NULL) {
+    return 0;
+  }
+
+  // Count the default lane too
+  return q->nof_pusch_lanes + 1;
+}
+
 static int gnb_ul_decode_pucch_format1(srsran_gnb_ul_t*                    q,
                                        const srsran_slot_cfg_t*            slot_cfg,
                                        const srsran_pucch_nr_common_cfg_t* cfg,
@@ -356,16 +443,29 @@ uint32_t srsran_gnb_ul_pusch_info(srsran_gnb_ul_t*             q,
                                   char*                        str,
                                   uint32_t                     str_len)
 {
-  if (q == NULL || cfg == NULL || res == NULL) {
+  return srsran_gnb_ul_pusch_lane_info(q, 0, cfg, res, str, str_len);
+}
+
+uint32_t srsran_gnb_ul_pusch_lane_info(srsran_gnb_ul_t*             q,
+                                       uint32_t                     lane_idx,
+                                       const srsran_sch_cfg_nr_t*   cfg,
+                                       const srsran_pusch_res_nr_t* res,
+                                       char*                        str,
+                                       uint32_t                     str_len)
+{
+  if (q == NULL || cfg == NULL || res == NULL || lane_idx > q->nof_pusch_lanes) {
     return 0;
   }
 
+  const srsran_pusch_nr_t* pusch = (lane_idx == 0) ? &q->pusch : &q->pusch_lanes[lane_idx - 1].pusch;
+  const srsran_dmrs_sch_t* dmrs  = (lane_idx == 0) ? &q->dmrs : &q->pusch_lanes[lane_idx - 1].dmrs;
+
   uint32_t len = 0;
 
-  len += srsran_pusch_nr_rx_info(&q->pusch, cfg, &cfg->grant, res, str, str_len - len);
+  len += srsran_pusch_nr_rx_info(pusch, cfg, &cfg->grant, res, str, str_len - len);
 
   // Append channel estimator info
-  len += srsran_csi_meas_info_short(&q->dmrs.csi, &str[len], str_len - len);
+  len += srsran_csi_meas_info_short(&dmrs->csi, &str[len], str_len - len);
 
   return len;
 }
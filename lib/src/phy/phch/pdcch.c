@@ -369,9 +369,44 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
   }
 }
 
+static srsran_pdcch_candidate_t*
+pdcch_candidate_find(srsran_pdcch_t* q, const srsran_dci_location_t* location, uint32_t nof_bits)
+{
+  for (uint32_t i = 0; i < q->nof_candidates; i++) {
+    srsran_pdcch_candidate_t* cand = &q->candidates[i];
+    if (cand->ncce == location->ncce && cand->L == location->L && cand->nof_bits == nof_bits) {
+      return cand;
+    }
+  }
+  return NULL;
+}
+
+static void pdcch_candidate_save(srsran_pdcch_t*              q,
+                                 const srsran_dci_location_t* location,
+                                 uint32_t                     nof_bits,
+                                 bool                         skipped,
+                                 const uint8_t*               payload,
+                                 uint16_t                     crc_rem)
+{
+  // If the table is full, the candidate is decoded again the next time it is searched
+  if (q->nof_candidates >= SRSRAN_PDCCH_MAX_DECODED_CANDIDATES) {
+    return;
+  }
+  srsran_pdcch_candidate_t* cand = &q->candidates[q->nof_candidates++];
+  cand->ncce                     = location->ncce;
+  cand->L                        = location->L;
+  cand->nof_bits                 = nof_bits;
+  cand->skipped                  = skipped;
+  cand->crc_rem                  = crc_rem;
+  if (!skipped) {
+    srsran_vec_u8_copy(cand->payload, payload, nof_bits);
+  }
+}
+
 /** Tries to decode a DCI message from the LLRs stored in the srsran_pdcch_t structure by the function
  * srsran_pdcch_extract_llr(). This function can be called multiple times.
- * The location to search for is obtained from msg.
+ * The location to search for is obtained from msg. A location is decoded only once per subframe for each message
+ * size, the searches of other RNTIs or formats of the same size reuse the decoded bits.
  * The decoded message is stored in msg and the CRC remainder in msg->rnti
  *
  */
@@ -387,6 +422,21 @@ int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dc
       uint32_t nof_bits = srsran_dci_format_sizeof(&q->cell, sf, dci_cfg, msg->format);
       uint32_t e_bits   = PDCCH_FORMAT_NOF_BITS(msg->location.L);
 
+      // Look for the candidate in the ones already decoded in this subframe
+      srsran_pdcch_candidate_t* cand = pdcch_candidate_find(q, &msg->location, nof_bits);
+      if (cand != NULL) {
+        q->nof_reused++;
+        if (!cand->skipped) {
+          srsran_vec_u8_copy(msg->payload, cand->payload, nof_bits);
+          msg->rnti     = cand->crc_rem;
+          msg->nof_bits = nof_bits;
+          if (msg->format == SRSRAN_DCI_FORMAT0 || msg->format == SRSRAN_DCI_FORMAT1A) {
+            msg->format = (msg->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSRAN_DCI_FORMAT0 : SRSRAN_DCI_FORMAT1A;
+          }
+        }
+        return ret;
+      }
+
       // Compute absolute mean of the LLRs
       double mean = 0;
       for (int i = 0; i < e_bits; i++) {
@@ -395,9 +445,11 @@ int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dc
       mean /= e_bits;
 
       if (mean > 0.3f) {
+        q->nof_decoded++;
         ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
         if (ret == SRSRAN_SUCCESS) {
           msg->nof_bits = nof_bits;
+          pdcch_candidate_save(q, &msg->location, nof_bits, false, msg->payload, msg->rnti);
           // Check format differentiation
           if (msg->format == SRSRAN_DCI_FORMAT0 || msg->format == SRSRAN_DCI_FORMAT1A) {
             msg->format = (msg->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSRAN_DCI_FORMAT0 : SRSRAN_DCI_FORMAT1A;
@@ -413,6 +465,7 @@ int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dc
              mean,
              msg->rnti);
       } else {
+        pdcch_candidate_save(q, &msg->location, nof_bits, true, NULL, 0);
         INFO("Skipping DCI:  nCCE=%d, L=%d, msg_len=%d, mean=%f", msg->location.ncce, msg->location.L, nof_bits, mean);
       }
     }
@@ -462,6 +515,7 @@ int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
     nof_symbols     = e_bits / 2;
     ret             = SRSRAN_ERROR;
     srsran_vec_f_zero(q->llr, q->max_bits);
+    q->nof_candidates = 0;
 
     DEBUG("Extracting LLRs: E: %d, SF: %d, CFI: %d", e_bits, sf->tti % 10, sf->cfi);
 
@@ -31,6 +31,11 @@
 
 #define PDCCH_NR_POLAR_RM_IBIL 0
 
+/**
+ * Maximum number of candidates kept by the decoder in a slot, enough for the candidates of several UE
+ */
+#define PDCCH_NR_MAX_DECODED_CANDIDATES (4 * SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR)
+
 #define PDCCH_INFO_TX(...) INFO("PDCCH Tx: " __VA_ARGS__)
 #define PDCCH_INFO_RX(...) INFO("PDCCH Rx: " __VA_ARGS__)
 #define PDCCH_DEBUG_RX(...) DEBUG("PDCCH Rx: " __VA_ARGS__)
@@ -246,6 +251,11 @@ int srsran_pdcch_nr_init_rx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
     q->evm_buffer = srsran_evm_buffer_alloc(SRSRAN_PDCCH_MAX_RE * 2);
   }
 
+  q->candidates = SRSRAN_MEM_ALLOC(srsran_pdcch_nr_candidate_t, PDCCH_NR_MAX_DECODED_CANDIDATES);
+  if (q->candidates == NULL) {
+    return SRSRAN_ERROR;
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -291,6 +301,10 @@ void srsran_pdcch_nr_free(srsran_pdcch_nr_t* q)
     srsran_evm_free(q->evm_buffer);
   }
 
+  if (q->candidates) {
+    free(q->candidates);
+  }
+
   SRSRAN_MEM_ZERO(q, srsran_pdcch_nr_t, 1);
 }
 
@@ -569,6 +583,96 @@ int srsran_pdcch_nr_encode(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_
   return SRSRAN_SUCCESS;
 }
 
+void srsran_pdcch_nr_new_slot(srsran_pdcch_nr_t* q)
+{
+  if (q == NULL || q->candidates == NULL) {
+    return;
+  }
+
+  q->candidates_en  = true;
+  q->nof_candidates = 0;
+}
+
+static srsran_pdcch_nr_candidate_t*
+pdcch_nr_candidate_find(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_msg, uint32_t c_init)
+{
+  if (!q->candidates_en) {
+    return NULL;
+  }
+
+  for (uint32_t i = 0; i < q->nof_candidates; i++) {
+    srsran_pdcch_nr_candidate_t* cand = &q->candidates[i];
+    if (cand->coreset_id == q->coreset.id && cand->L == dci_msg->ctx.location.L &&
+        cand->ncce == dci_msg->ctx.location.ncce && cand->K == q->K && cand->c_init == c_init) {
+      return cand;
+    }
+  }
+
+  return NULL;
+}
+
+static void
+pdcch_nr_candidate_save(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_msg, uint32_t c_init, float evm)
+{
+  // If the table is full, the candidate is decoded again the next time it is searched
+  if (!q->candidates_en || q->nof_candidates >= PDCCH_NR_MAX_DECODED_CANDIDATES) {
+    return;
+  }
+
+  srsran_pdcch_nr_candidate_t* cand = &q->candidates[q->nof_candidates++];
+  cand->coreset_id                  = q->coreset.id;
+  cand->L                           = dci_msg->ctx.location.L;
+  cand->ncce                        = dci_msg->ctx.location.ncce;
+  cand->K                           = q->K;
+  cand->c_init                      = c_init;
+  cand->evm                         = evm;
+  srsran_vec_u8_copy(cand->c, &q->c[24], q->K);
+}
+
+// De-scrambles the CRC of the decoded bits with the RNTI, checks it and copies the message
+static int
+pdcch_nr_decode_crc(srsran_pdcch_nr_t* q, srsran_dci_msg_nr_t* dci_msg, srsran_pdcch_nr_res_t* res, struct timeval* t)
+{
+  // The decoded bits have an offset of 24 bits
+  uint8_t* c = &q->c[24];
+
+  // Unpack RNTI
+  uint8_t  unpacked_rnti[16] = {};
+  uint8_t* ptr               = unpacked_rnti;
+  srsran_bit_unpack(dci_msg->ctx.rnti, &ptr, 16);
+
+  // De-Scramble CRC with RNTI
+  srsran_vec_xor_bbb(unpacked_rnti, &c[q->K - 16], &c[q->K - 16], 16);
+
+  // Check CRC
+  ptr                = &c[q->K - 24];
+  uint32_t checksum1 = srsran_crc_checksum(&q->crc24c, q->c, q->K);
+  uint32_t checksum2 = srsran_bit_pack(&ptr, 24);
+  res->crc           = checksum1 == checksum2;
+
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+    PDCCH_INFO_RX("CRC={%06x, %06x}; msg=", checksum1, checksum2);
+    srsran_vec_fprint_hex(stdout, c, dci_msg->nof_bits);
+  }
+
+  // Copy DCI message
+  srsran_vec_u8_copy(dci_msg->payload, c, dci_msg->nof_bits);
+
+  if (q->meas_time_en) {
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    q->meas_time_us = (uint32_t)t[0].tv_usec;
+  }
+
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+    char str[128] = {};
+    srsran_pdcch_nr_info(q, res, str, sizeof(str));
+    PDCCH_INFO_RX("%s", str);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
                            cf_t*                   slot_symbols,
                            srsran_dmrs_pdcch_ce_t* ce,
@@ -595,6 +699,17 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
     return SRSRAN_ERROR;
   }
 
+  // Skip the demodulation and decoding if the candidate was already decoded in this slot
+  uint32_t                     c_init = pdcch_nr_c_init(q, dci_msg);
+  srsran_pdcch_nr_candidate_t* cand   = pdcch_nr_candidate_find(q, dci_msg, c_init);
+  if (cand != NULL) {
+    q->nof_reused++;
+    srsran_vec_u8_copy(&q->c[24], cand->c, q->K);
+    res->evm = cand->evm;
+    return pdcch_nr_decode_crc(q, dci_msg, res, t);
+  }
+  q->nof_decoded++;
+
   // Get polar code
   if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
@@ -640,7 +755,7 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
   }
 
   // Descrambling
-  srsran_sequence_apply_c(llr, llr, q->E, pdcch_nr_c_init(q, dci_msg));
+  srsran_sequence_apply_c(llr, llr, q->E, c_init);
 
   // Un-rate matching
   int8_t* d = (int8_t*)q->d;
@@ -679,41 +794,9 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
     srsran_vec_fprint_hex(stdout, c, q->K);
   }
 
-  // Unpack RNTI
-  uint8_t  unpacked_rnti[16] = {};
-  uint8_t* ptr               = unpacked_rnti;
-  srsran_bit_unpack(dci_msg->ctx.rnti, &ptr, 16);
-
-  // De-Scramble CRC with RNTI
-  srsran_vec_xor_bbb(unpacked_rnti, &c[q->K - 16], &c[q->K - 16], 16);
+  pdcch_nr_candidate_save(q, dci_msg, c_init, res->evm);
 
-  // Check CRC
-  ptr                = &c[q->K - 24];
-  uint32_t checksum1 = srsran_crc_checksum(&q->crc24c, q->c, q->K);
-  uint32_t checksum2 = srsran_bit_pack(&ptr, 24);
-  res->crc           = checksum1 == checksum2;
-
-  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-    PDCCH_INFO_RX("CRC={%06x, %06x}; msg=", checksum1, checksum2);
-    srsran_vec_fprint_hex(stdout, c, dci_msg->nof_bits);
-  }
-
-  // Copy DCI message
-  srsran_vec_u8_copy(dci_msg->payload, c, dci_msg->nof_bits);
-
-  if (q->meas_time_en) {
-    gettimeofday(&t[2], NULL);
-    get_time_interval(t);
-    q->meas_time_us = (uint32_t)t[0].tv_usec;
-  }
-
-  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-    char str[128] = {};
-    srsran_pdcch_nr_info(q, res, str, sizeof(str));
-    PDCCH_INFO_RX("%s", str);
-  }
-
-  return SRSRAN_SUCCESS;
+  return pdcch_nr_decode_crc(q, dci_msg, res, t);
 }
 
 uint32_t srsran_pdcch_nr_info(const srsran_pdcch_nr_t* q, const srsran_pdcch_nr_res_t* res, char* str, uint32_t str_len)
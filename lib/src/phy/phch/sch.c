@@ -262,6 +262,12 @@ static int encode_tb_off(srsran_sch_t*           q,
       return SRSRAN_ERROR;
     }
 
+    // Pooled soft-buffers only have the code blocks bound by the last reset
+    if (cb_segm->C > 0 && softbuffer->buffer_b[cb_segm->C - 1] == NULL) {
+      ERROR("Error soft buffer has no buffer bound for CB %d", cb_segm->C - 1);
+      return SRSRAN_ERROR;
+    }
+
     if (Qm == 0) {
       ERROR("Invalid Qm");
       return SRSRAN_ERROR;
@@ -544,6 +550,16 @@ static int decode_tb(srsran_sch_t*           q,
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
+  // Pooled soft-buffers only have the code blocks bound by the last reset, and may only fit 8-bit LLR
+  if (cb_segm->C > 0 && softbuffer->buffer_f[cb_segm->C - 1] == NULL) {
+    fprintf(stderr, "Error soft buffer has no buffer bound for CB %d\n", cb_segm->C - 1);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  if (softbuffer->pool != NULL && softbuffer->pool->llr_is_8bit && !q->llr_is_8bit) {
+    fprintf(stderr, "Error soft buffer stores 8-bit LLR but the decoder uses 16-bit\n");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
   // Process Codeblocks
   bool cb_crc_ok = decode_tb_cb(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data);
 
@@ -1141,6 +1157,14 @@ int srsran_ulsch_decode(srsran_sch_t*       q,
 
   cfg->K_segm = cb_segm.C1 * cb_segm.K1 + cb_segm.C2 * cb_segm.K2;
 
+  // UCI decoding and the deinterleaver work with 16-bit LLR, widen the 8-bit ones in place starting from the end
+  if (q->llr_is_8bit) {
+    const int8_t* q_bits_b = (const int8_t*)q_bits;
+    for (uint32_t i = nb_q; i > 0; i--) {
+      q_bits[i - 1] = q_bits_b[i - 1];
+    }
+  }
+
   // Decode RI/HARQ values
   if ((ret = uci_decode_ri_ack(q, cfg, q_bits, c_seq, uci_data)) < 0) {
     ERROR("Error decoding RI/HARQ bits");
@@ -1187,7 +1211,16 @@ int srsran_ulsch_decode(srsran_sch_t*       q,
   // Decode ULSCH
   if (cb_segm.tbs > 0) {
     uint32_t G = nb_q / Qm - Q_prime_ri - Q_prime_cqi;
-    ret        = decode_tb(q, cfg->softbuffers.rx, &cb_segm, Qm, cfg->grant.tb.rv, G * Qm, &g_bits[e_offset], data);
+
+    // The 8-bit decoder reads 8-bit LLR, narrow them back in place. They were 8-bit values to start with
+    if (q->llr_is_8bit) {
+      int8_t* e_bits_b = (int8_t*)&g_bits[e_offset];
+      for (uint32_t i = 0; i < G * Qm; i++) {
+        e_bits_b[i] = (int8_t)g_bits[e_offset + i];
+      }
+    }
+
+    ret = decode_tb(q, cfg->softbuffers.rx, &cb_segm, Qm, cfg->grant.tb.rv, G * Qm, &g_bits[e_offset], data);
   }
   return ret;
 }
@@ -306,6 +306,9 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
   // and MCS indexes for all possible MCS tables
   float scaling_factor = isnormal(args->decoder_scaling_factor) ? args->decoder_scaling_factor : 0.8f;
 
+  // Blocks whose syndrome weight has not improved for a few iterations hardly ever converge
+  uint32_t early_abort_iter = (args->decoder_early_abort_iter > 0) ? args->decoder_early_abort_iter : 4;
+
   // Iterate over all possible lifting sizes
   for (uint16_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
     uint8_t ls_index = get_ls_index(ls);
@@ -323,6 +326,8 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
     decoder_args.ls                         = ls;
     decoder_args.scaling_fctr               = scaling_factor;
     decoder_args.max_nof_iter               = args->max_nof_iter;
+    decoder_args.syndrome_check             = args->decoder_early_stop;
+    decoder_args.early_abort_iter           = args->decoder_early_stop ? early_abort_iter : 0;
 
     q->decoder_bg1[ls] = SRSRAN_MEM_ALLOC(srsran_ldpc_decoder_t, 1);
     if (!q->decoder_bg1[ls]) {
@@ -577,6 +582,9 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
   int8_t*  input_ptr    = e_bits;
   uint32_t nof_iter_sum = 0;
 
+  srsran_vec_u32_zero(res->iter_hist, SRSRAN_SCH_NR_ITER_HIST_SIZE);
+  res->nof_cb_aborted = 0;
+
   srsran_sch_nr_tb_info_t cfg = {};
   if (srsran_sch_nr_fill_tb_info(&q->carrier, sch_cfg, tb, &cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
@@ -668,8 +676,12 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     }
 
     // Compute number of iterations
-    uint32_t n_iter_cb = (ret == 0) ? decoder->max_nof_iter : (uint32_t)ret;
+    uint32_t n_iter_cb = decoder->last_nof_iter;
     nof_iter_sum += n_iter_cb;
+    res->iter_hist[SRSRAN_MIN(n_iter_cb, SRSRAN_SCH_NR_ITER_HIST_SIZE) - 1]++;
+    if (decoder->last_stop == SRSRAN_LDPC_DECODER_STOP_ABORT) {
+      res->nof_cb_aborted++;
+    }
 
     // Check if CB is all zeros
     uint32_t cb_len = cfg.Kp - cfg.L_cb;
@@ -709,6 +721,9 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
   uint32_t checksum2  = 0;
   uint8_t* output_ptr = res->payload;
 
+  // The TB CRC is computed while the code blocks are appended
+  srsran_crc_set_init(crc_tb, 0);
+
   for (uint32_t r = 0; r < cfg.C; r++) {
     uint32_t cb_len = cfg.Kp - cfg.L_cb;
 
@@ -721,6 +736,10 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     srsran_vec_u8_copy(output_ptr, tb->softbuffer.rx->data[r], cb_len / 8);
     output_ptr += cb_len / 8;
 
+    if (cfg.C > 1) {
+      srsran_crc_checksum_put_bytes(crc_tb, tb->softbuffer.rx->data[r], cb_len / 8);
+    }
+
     // Compute TB CRC for last block
     if (cfg.C > 1 && r == cfg.C - 1) {
       uint8_t  tb_crc_unpacked[24] = {};
@@ -736,7 +755,7 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     res->crc = true;
   } else {
     // More than one
-    uint32_t checksum1 = srsran_crc_checksum_byte(crc_tb, res->payload, tb->tbs);
+    uint32_t checksum1 = (uint32_t)srsran_crc_checksum_get(crc_tb);
     res->crc           = (checksum1 == checksum2);
     SCH_INFO_RX("TB: TBS=%d; CRC={%06x, %06x}", tb->tbs, checksum1, checksum2);
   }
@@ -802,6 +821,9 @@ int srsran_sch_nr_tb_info(const srsran_sch_tb_t* tb, const srsran_sch_tb_res_nr_
 
     if (res != NULL) {
       len = srsran_print_check(str, str_len, len, "CRC=%s iter=%.1f ", res->crc ? "OK" : "KO", res->avg_iter);
+      if (res->nof_cb_aborted > 0) {
+        len = srsran_print_check(str, str_len, len, "aborted=%d ", res->nof_cb_aborted);
+      }
     }
   }
 
@@ -29,6 +29,9 @@ static srsran_carrier_nr_t carrier = SRSRAN_DEFAULT_CARRIER_NR;
 static uint16_t rnti        = 0x1234;
 static bool     fast_sweep  = true;
 static bool     interleaved = false;
+static uint32_t nof_ue      = 8;
+
+#define TEST_MULTI_UE_MAX_DCI 32
 
 typedef struct {
   uint64_t time_us;
@@ -68,19 +71,173 @@ static int test(srsran_pdcch_nr_t*      tx,
   return SRSRAN_SUCCESS;
 }
 
+/*
+ * Blind search of several UE in the same slot. Every UE receives a DCI with aggregation level 2 in its UE-specific
+ * search space and searches all its candidates. The decoder is run once per candidate and slot, the rest of the
+ * searches only check the CRC with their RNTI.
+ */
+static int test_multi_ue(srsran_pdcch_nr_t*      tx,
+                         srsran_pdcch_nr_t*      rx,
+                         cf_t*                   grid,
+                         uint32_t                grid_sz,
+                         srsran_dmrs_pdcch_ce_t* ce,
+                         srsran_random_t         rand_gen)
+{
+  if (nof_ue == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  srsran_coreset_t coreset = {};
+  coreset.duration         = 2;
+  for (uint32_t i = 0; i < SRSRAN_MIN(SRSRAN_CORESET_FREQ_DOMAIN_RES_SIZE, carrier.nof_prb / 6); i++) {
+    coreset.freq_resources[i] = true;
+  }
+  uint32_t nof_cce = srsran_coreset_get_bw(&coreset) * coreset.duration / 6;
+
+  srsran_search_space_t search_space = {};
+  search_space.type                  = srsran_search_space_type_ue;
+  for (uint32_t L = 0; L < SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR; L++) {
+    search_space.nof_candidates[L] = SRSRAN_MIN(2, srsran_pdcch_nr_max_candidates_coreset(&coreset, L));
+  }
+
+  srsran_dci_cfg_nr_t dci_cfg = {};
+  dci_cfg.bwp_dl_initial_bw   = carrier.nof_prb;
+  dci_cfg.bwp_dl_active_bw    = carrier.nof_prb;
+  dci_cfg.bwp_ul_initial_bw   = carrier.nof_prb;
+  dci_cfg.bwp_ul_active_bw    = carrier.nof_prb;
+  dci_cfg.monitor_0_0_and_1_0 = true;
+  srsran_dci_nr_t dci         = {};
+  TESTASSERT(srsran_dci_nr_set_cfg(&dci, &dci_cfg) == SRSRAN_SUCCESS);
+  uint32_t nof_bits = srsran_dci_nr_size(&dci, search_space.type, srsran_dci_format_nr_1_0);
+
+  TESTASSERT(srsran_pdcch_nr_set_carrier(tx, &carrier, &coreset) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_pdcch_nr_set_carrier(rx, &carrier, &coreset) == SRSRAN_SUCCESS);
+
+  struct timeval t[3]         = {};
+  uint64_t       t_search_us  = 0;
+  uint64_t       nof_searches = 0;
+  uint64_t       nof_tx       = 0;
+  uint32_t       nof_decoded  = rx->nof_decoded;
+  uint32_t       nof_reused   = rx->nof_reused;
+  uint32_t       nof_slots    = SRSRAN_NSLOTS_PER_FRAME_NR(carrier.scs);
+
+  for (uint32_t slot_idx = 0; slot_idx < nof_slots; slot_idx++) {
+    srsran_vec_cf_zero(grid, grid_sz);
+
+    // Transmit a DCI to every UE with a free candidate of aggregation level 2
+    srsran_dci_msg_nr_t dci_tx[TEST_MULTI_UE_MAX_DCI]                                           = {};
+    bool                dci_found[TEST_MULTI_UE_MAX_DCI]                                        = {};
+    bool                cce_used[SRSRAN_CORESET_FREQ_DOMAIN_RES_SIZE * SRSRAN_CORESET_DURATION_MAX] = {};
+    uint32_t            nof_dci                                                                     = 0;
+    for (uint32_t ue = 0; ue < nof_ue && nof_dci < TEST_MULTI_UE_MAX_DCI; ue++) {
+      uint16_t ue_rnti                                              = (uint16_t)(rnti + ue);
+      uint32_t locations[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR] = {};
+      int      n = srsran_pdcch_nr_locations_coreset(&coreset, &search_space, ue_rnti, 2, slot_idx, locations);
+      TESTASSERT(n >= SRSRAN_SUCCESS);
+      for (int i = 0; i < n; i++) {
+        if (cce_used[locations[i]]) {
+          continue;
+        }
+        for (uint32_t j = 0; j < 4; j++) {
+          cce_used[locations[i] + j] = true;
+        }
+
+        srsran_dci_msg_nr_t* msg = &dci_tx[nof_dci++];
+        msg->ctx.format          = srsran_dci_format_nr_1_0;
+        msg->ctx.rnti_type       = srsran_rnti_type_c;
+        msg->ctx.rnti            = ue_rnti;
+        msg->ctx.ss_type         = search_space.type;
+        msg->ctx.location.L      = 2;
+        msg->ctx.location.ncce   = locations[i];
+        msg->nof_bits            = nof_bits;
+        for (uint32_t j = 0; j < nof_bits; j++) {
+          msg->payload[j] = srsran_random_uniform_int_dist(rand_gen, 0, 1);
+        }
+        TESTASSERT(srsran_pdcch_nr_encode(tx, msg, grid) == SRSRAN_SUCCESS);
+        break;
+      }
+    }
+    nof_tx += nof_dci;
+
+    // Blind search of every UE
+    gettimeofday(&t[1], NULL);
+    srsran_pdcch_nr_new_slot(rx);
+    for (uint32_t ue = 0; ue < nof_ue; ue++) {
+      uint16_t ue_rnti = (uint16_t)(rnti + ue);
+      for (uint32_t L = 0; L < SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR; L++) {
+        uint32_t locations[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR] = {};
+        int      n = srsran_pdcch_nr_locations_coreset(&coreset, &search_space, ue_rnti, L, slot_idx, locations);
+        TESTASSERT(n >= SRSRAN_SUCCESS);
+
+        ce->nof_re    = (SRSRAN_NRE - 3) * 6 * (1U << L);
+        ce->noise_var = 0.0f;
+        for (uint32_t i = 0; i < ce->nof_re; i++) {
+          ce->ce[i] = 1.0f;
+        }
+
+        for (int i = 0; i < n; i++) {
+          srsran_pdcch_nr_res_t res        = {};
+          srsran_dci_msg_nr_t   dci_msg_rx = {};
+          dci_msg_rx.ctx.format            = srsran_dci_format_nr_1_0;
+          dci_msg_rx.ctx.rnti_type         = srsran_rnti_type_c;
+          dci_msg_rx.ctx.rnti              = ue_rnti;
+          dci_msg_rx.ctx.ss_type           = search_space.type;
+          dci_msg_rx.ctx.location.L        = L;
+          dci_msg_rx.ctx.location.ncce     = locations[i];
+          dci_msg_rx.nof_bits              = nof_bits;
+          TESTASSERT(srsran_pdcch_nr_decode(rx, grid, ce, &dci_msg_rx, &res) == SRSRAN_SUCCESS);
+          nof_searches++;
+
+          if (!res.crc) {
+            continue;
+          }
+          for (uint32_t j = 0; j < nof_dci; j++) {
+            if (dci_tx[j].ctx.rnti == ue_rnti && dci_tx[j].ctx.location.L == L &&
+                dci_tx[j].ctx.location.ncce == locations[i]) {
+              TESTASSERT(memcmp(dci_tx[j].payload, dci_msg_rx.payload, nof_bits) == 0);
+              dci_found[j] = true;
+            }
+          }
+        }
+      }
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    t_search_us += (uint64_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+
+    // Every transmitted DCI must be found by its UE
+    for (uint32_t j = 0; j < nof_dci; j++) {
+      TESTASSERT(dci_found[j]);
+    }
+  }
+
+  printf("Multi-UE search - %d UE, %d CCE - %.1f DCI/slot; %.1f searches/slot; %.1f decodes/slot; %.1f reused/slot; "
+         "%.1f usec/slot;\n",
+         nof_ue,
+         nof_cce,
+         (double)nof_tx / (double)nof_slots,
+         (double)nof_searches / (double)nof_slots,
+         (double)(rx->nof_decoded - nof_decoded) / (double)nof_slots,
+         (double)(rx->nof_reused - nof_reused) / (double)nof_slots,
+         (double)t_search_us / (double)nof_slots);
+
+  return SRSRAN_SUCCESS;
+}
+
 static void usage(char* prog)
 {
-  printf("Usage: %s [pFIv] \n", prog);
+  printf("Usage: %s [pFIUv] \n", prog);
   printf("\t-p Number of carrier PRB [Default %d]\n", carrier.nof_prb);
   printf("\t-F Fast CORESET frequency resource sweeping [Default %s]\n", fast_sweep ? "Enabled" : "Disabled");
   printf("\t-I Enable interleaved CCE-to-REG [Default %s]\n", interleaved ? "Enabled" : "Disabled");
+  printf("\t-U Number of UE searched in every slot [Default %d]\n", nof_ue);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 static int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "pFIv")) != -1) {
+  while ((opt = getopt(argc, argv, "pFIUv")) != -1) {
     switch (opt) {
       case 'p':
         carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -91,6 +248,9 @@ static int parse_args(int argc, char** argv)
       case 'I':
         interleaved ^= true;
         break;
+      case 'U':
+        nof_ue = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -274,6 +434,11 @@ int main(int argc, char** argv)
   }
   printf("+--------+--------+--------+--------+\n");
 
+  if (test_multi_ue(&pdcch_tx, &pdcch_rx, buffer, grid_sz, ce, rand_gen) < SRSRAN_SUCCESS) {
+    ERROR("Multi-UE test failed");
+    goto clean_exit;
+  }
+
   ret = SRSRAN_SUCCESS;
 clean_exit:
   srsran_random_free(rand_gen);
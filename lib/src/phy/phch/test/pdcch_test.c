@@ -37,6 +37,7 @@ static uint32_t         nof_prb     = 100;
 static float            snr_dB      = NAN;
 static uint32_t         repetitions = 1;
 static bool             false_check = false;
+static uint32_t         nof_ue      = 8;
 
 // Test objects
 static srsran_random_t       random_gen                     = NULL;
@@ -48,7 +49,7 @@ static cf_t*                 slot_symbols[SRSRAN_MAX_PORTS] = {};
 
 static void usage(char* prog)
 {
-  printf("Usage: %s [pfncxv]\n", prog);
+  printf("Usage: %s [pfncxvFRSU]\n", prog);
   printf("\t-c cell id [Default %d]\n", pci);
   printf("\t-f cfi [Default %d]\n", cfi);
   printf("\t-p cell.nof_ports [Default %d]\n", nof_ports);
@@ -57,13 +58,14 @@ static void usage(char* prog)
   printf("\t-F False detection check [Default %s]\n", false_check ? "enabled" : "disabled");
   printf("\t-R Repetitions [Default %d]\n", repetitions);
   printf("\t-S SNR in dB [Default %+.1f]\n", snr_dB);
+  printf("\t-U Number of UE searched in every subframe [Default %d]\n", nof_ue);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "pfncxvFRS")) != -1) {
+  while ((opt = getopt(argc, argv, "pfncxvFRSU")) != -1) {
     switch (opt) {
       case 'p':
         nof_ports = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -89,6 +91,9 @@ static void parse_args(int argc, char** argv)
       case 'S':
         snr_dB = (float)strtof(argv[optind], NULL);
         break;
+      case 'U':
+        nof_ue = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -98,7 +103,7 @@ static void parse_args(int argc, char** argv)
     }
   }
   printf("params - pci=%d; rnti=0x%04x; cfi=%d; nof_ports=%d; cif_enabled=%d; nof_prb=%d; snr_db=%+.1f; "
-         "repetitions=%d; false_check=%d;\n",
+         "repetitions=%d; false_check=%d; nof_ue=%d;\n",
          pci,
          rnti,
          cfi,
@@ -107,7 +112,8 @@ static void parse_args(int argc, char** argv)
          nof_prb,
          snr_dB,
          repetitions,
-         false_check);
+         false_check,
+         nof_ue);
 }
 
 static void print_dci_msg(const char* desc, const srsran_dci_msg_t* dci_msg)
@@ -347,6 +353,142 @@ static int test_case1()
   return SRSRAN_SUCCESS;
 }
 
+/*
+ * Blind search of several UE in the same subframe, as done by a UE emulator or a monitor. Each UE receives a DCI in
+ * its UE-specific search space and all of them search the common and UE-specific search spaces for formats 1A and 1.
+ * Candidates are decoded only the first time they are searched in the subframe.
+ */
+static int test_case2()
+{
+  uint32_t                  nof_re                                   = SRSRAN_NOF_RE(pdcch_tx.cell);
+  const srsran_dci_format_t search_formats[2]                        = {SRSRAN_DCI_FORMAT1A, SRSRAN_DCI_FORMAT1};
+  struct timeval            t[3]                                     = {};
+  uint64_t                  t_search_us                              = 0;
+  uint64_t                  nof_searches                             = 0;
+  uint64_t                  nof_tx                                   = 0;
+  uint32_t                  nof_decoded                              = pdcch_rx.nof_decoded;
+  uint32_t                  nof_reused                               = pdcch_rx.nof_reused;
+  srsran_dci_msg_t          dci_tx[SRSRAN_MAX_CANDIDATES]            = {};
+  bool                      dci_found[SRSRAN_MAX_CANDIDATES]         = {};
+  bool                      cce_used[128]                            = {}; // More than the CCE of 100 PRB
+
+  if (nof_ue == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  for (uint32_t sf_idx = 0; sf_idx < repetitions * SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+    srsran_dl_sf_cfg_t dl_sf_cfg = {};
+    dl_sf_cfg.cfi                = cfi;
+    dl_sf_cfg.tti                = sf_idx % 10240;
+
+    for (uint32_t p = 0; p < nof_ports; p++) {
+      srsran_vec_cf_zero(slot_symbols[p], nof_re);
+    }
+    memset(cce_used, 0, sizeof(cce_used));
+    memset(dci_found, 0, sizeof(dci_found));
+
+    // Allocate a DCI with aggregation level 2 to every UE that has a free candidate
+    uint32_t nof_dci = 0;
+    for (uint32_t ue = 0; ue < nof_ue && nof_dci < SRSRAN_MAX_CANDIDATES; ue++) {
+      uint16_t              ue_rnti                          = (uint16_t)(rnti + ue);
+      srsran_dci_location_t locations[SRSRAN_MAX_CANDIDATES] = {};
+      uint32_t              nof_locations =
+          srsran_pdcch_ue_locations(&pdcch_tx, &dl_sf_cfg, locations, SRSRAN_MAX_CANDIDATES_UE, ue_rnti);
+      for (uint32_t loc = 0; loc < nof_locations; loc++) {
+        if (locations[loc].L != 2) {
+          continue;
+        }
+        bool is_free = true;
+        for (uint32_t i = 0; i < 4; i++) {
+          is_free = is_free && !cce_used[locations[loc].ncce + i];
+        }
+        if (!is_free) {
+          continue;
+        }
+        for (uint32_t i = 0; i < 4; i++) {
+          cce_used[locations[loc].ncce + i] = true;
+        }
+
+        srsran_dci_msg_t* dci = &dci_tx[nof_dci++];
+        dci->format           = SRSRAN_DCI_FORMAT1A;
+        dci->nof_bits         = srsran_dci_format_sizeof(&pdcch_tx.cell, &dl_sf_cfg, &dci_cfg, dci->format);
+        dci->location         = locations[loc];
+        dci->rnti             = ue_rnti;
+        srsran_random_bit_vector(random_gen, dci->payload, dci->nof_bits);
+        dci->payload[dci_cfg.cif_enabled ? 3 : 0] = 1; // Format 1A flag
+        TESTASSERT(srsran_pdcch_encode(&pdcch_tx, &dl_sf_cfg, dci, slot_symbols) == SRSRAN_SUCCESS);
+        break;
+      }
+    }
+    nof_tx += nof_dci;
+
+    float n0_dB = -get_snr_dB(2);
+    TESTASSERT(srsran_channel_awgn_set_n0(&awgn, n0_dB) == SRSRAN_SUCCESS);
+    chest_dl_res.noise_estimate = srsran_convert_dB_to_power(n0_dB);
+    for (uint32_t p = 0; p < nof_ports; p++) {
+      srsran_channel_awgn_run_c(&awgn, slot_symbols[p], slot_symbols[p], nof_re);
+    }
+
+    gettimeofday(&t[1], NULL);
+    TESTASSERT(srsran_pdcch_extract_llr(&pdcch_rx, &dl_sf_cfg, &chest_dl_res, slot_symbols) == SRSRAN_SUCCESS);
+
+    // Blind search of every UE
+    for (uint32_t ue = 0; ue < nof_ue; ue++) {
+      uint16_t              ue_rnti                          = (uint16_t)(rnti + ue);
+      srsran_dci_location_t locations[SRSRAN_MAX_CANDIDATES] = {};
+      uint32_t nof_locations = srsran_pdcch_common_locations(&pdcch_rx, locations, SRSRAN_MAX_CANDIDATES_COM, cfi);
+      uint32_t nof_common    = nof_locations;
+      nof_locations += srsran_pdcch_ue_locations(
+          &pdcch_rx, &dl_sf_cfg, &locations[nof_locations], SRSRAN_MAX_CANDIDATES_UE, ue_rnti);
+
+      for (uint32_t loc = 0; loc < nof_locations; loc++) {
+        // Format 1 is only searched in the UE-specific search space
+        uint32_t nof_formats = (loc < nof_common) ? 1 : 2;
+        for (uint32_t f = 0; f < nof_formats; f++) {
+          srsran_dci_msg_t dci_rx = {};
+          dci_rx.location         = locations[loc];
+          dci_rx.format           = search_formats[f];
+          TESTASSERT(srsran_pdcch_decode_msg(&pdcch_rx, &dl_sf_cfg, &dci_cfg, &dci_rx) == SRSRAN_SUCCESS);
+          nof_searches++;
+
+          if (dci_rx.rnti != ue_rnti) {
+            continue;
+          }
+          for (uint32_t i = 0; i < nof_dci; i++) {
+            if (dci_tx[i].rnti == ue_rnti && dci_tx[i].location.ncce == dci_rx.location.ncce &&
+                dci_tx[i].location.L == dci_rx.location.L && dci_rx.format == SRSRAN_DCI_FORMAT1A) {
+              TESTASSERT(memcmp(dci_tx[i].payload, dci_rx.payload, dci_tx[i].nof_bits) == 0);
+              dci_found[i] = true;
+            }
+          }
+        }
+      }
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    t_search_us += (size_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+
+    // Every transmitted DCI must be found by its UE
+    for (uint32_t i = 0; i < nof_dci; i++) {
+      TESTASSERT(dci_found[i]);
+    }
+  }
+
+  uint64_t nof_sf = repetitions * SRSRAN_NOF_SF_X_FRAME;
+  nof_decoded     = pdcch_rx.nof_decoded - nof_decoded;
+  nof_reused      = pdcch_rx.nof_reused - nof_reused;
+  printf("test_case_2 - %d UE - passed - %.1f DCI/sf; %.1f searches/sf; %.1f decodes/sf; %.1f reused/sf; "
+         "%.1f usec/sf;\n",
+         nof_ue,
+         (double)nof_tx / (double)nof_sf,
+         (double)nof_searches / (double)nof_sf,
+         (double)nof_decoded / (double)nof_sf,
+         (double)nof_reused / (double)nof_sf,
+         (double)t_search_us / (double)nof_sf);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   srsran_regs_t regs = {};
@@ -416,6 +558,11 @@ int main(int argc, char** argv)
     goto quit;
   }
 
+  if (test_case2() < SRSRAN_SUCCESS) {
+    ERROR("Test case 2 failed");
+    goto quit;
+  }
+
   ret = SRSRAN_SUCCESS;
 
 quit:
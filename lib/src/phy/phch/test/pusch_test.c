@@ -56,6 +56,8 @@ int          freq_hop      = -1;
 int          riv           = -1;
 uint32_t     mcs_idx       = 0;
 bool         enable_64_qam = false;
+bool         use_pool      = false;
+bool         use_8_bit     = false;
 
 void usage(char* prog)
 {
@@ -83,6 +85,9 @@ void usage(char* prog)
 
   printf("\n\tOther parameters:\n");
   printf("\t\t-p enable_64qam [Default %s]\n", enable_64_qam ? "enabled" : "disabled");
+  printf("\t\t-p softbuffer_pool, soft-buffers bind code blocks from a pool [Default %s]\n", use_pool ? "yes" : "no");
+  printf("\t\t-p llr_8bit, decode with 8-bit LLR as the eNB with pusch_8bit_decoder [Default %s]\n",
+         use_8_bit ? "yes" : "no");
   printf("\t\t-s number of subframes [Default %d]\n", subframe);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
@@ -126,6 +131,10 @@ void parse_extensive_param(char* param, char* arg)
     uci_data_tx.cfg.ack[0].nof_acks = SRSRAN_MIN((uint32_t)strtol(arg, NULL, 10), SRSRAN_UCI_MAX_ACK_BITS);
   } else if (!strcmp(param, "enable_64qam")) {
     enable_64_qam ^= true;
+  } else if (!strcmp(param, "softbuffer_pool")) {
+    use_pool = true;
+  } else if (!strcmp(param, "llr_8bit")) {
+    use_8_bit = true;
   } else {
     ext_code = SRSRAN_ERROR;
   }
@@ -181,19 +190,21 @@ void parse_args(int argc, char** argv)
 
 int main(int argc, char** argv)
 {
-  srsran_random_t        random_h = srsran_random_init(0);
-  srsran_chest_ul_res_t  chest_res  = {};
-  srsran_pusch_t         pusch_tx   = {};
-  srsran_pusch_t         pusch_rx   = {};
-  uint8_t*               data       = NULL;
-  uint8_t*               data_rx    = NULL;
-  cf_t*                  sf_symbols = NULL;
-  int                    ret        = -1;
-  struct timeval         t[3];
-  srsran_pusch_cfg_t     cfg           = {};
-  srsran_softbuffer_tx_t softbuffer_tx = {};
-  srsran_softbuffer_rx_t softbuffer_rx = {};
-  srsran_crc_t           crc_tb;
+  srsran_random_t          random_h   = srsran_random_init(0);
+  srsran_chest_ul_res_t    chest_res  = {};
+  srsran_pusch_t           pusch_tx   = {};
+  srsran_pusch_t           pusch_rx   = {};
+  uint8_t*                 data       = NULL;
+  uint8_t*                 data_rx    = NULL;
+  cf_t*                    sf_symbols = NULL;
+  int                      ret        = -1;
+  struct timeval           t[3];
+  srsran_pusch_cfg_t       cfg           = {};
+  srsran_softbuffer_tx_t   softbuffer_tx = {};
+  srsran_softbuffer_rx_t   softbuffer_rx = {};
+  srsran_softbuffer_pool_t pool_tx       = {};
+  srsran_softbuffer_pool_t pool_rx       = {};
+  srsran_crc_t             crc_tb;
 
   ZERO_OBJECT(uci_data_tx);
   ZERO_OBJECT(crc_tb);
@@ -243,6 +254,8 @@ int main(int argc, char** argv)
     ERROR("Error creating PUSCH object");
     goto quit;
   }
+  pusch_rx.llr_is_8bit        = use_8_bit;
+  pusch_rx.ul_sch.llr_is_8bit = use_8_bit;
 
   uint16_t rnti = 62;
   dci.rnti      = rnti;
@@ -267,14 +280,27 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
-  if (srsran_softbuffer_tx_init(&softbuffer_tx, 100)) {
-    ERROR("Error initiating soft buffer");
-    goto quit;
-  }
+  if (use_pool) {
+    // Same set-up as the eNB MAC, the Rx code blocks follow the LLR width of the PUSCH decoder
+    int      max_tbs = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, 100);
+    uint32_t max_cb  = (uint32_t)SRSRAN_MAX(max_tbs, 0) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
+    if (srsran_softbuffer_pool_init(&pool_tx, false, SOFTBUFFER_SIZE, false, max_cb) ||
+        srsran_softbuffer_pool_init(&pool_rx, true, SOFTBUFFER_SIZE, use_8_bit, max_cb) ||
+        srsran_softbuffer_tx_init_pool(&softbuffer_tx, &pool_tx, max_cb) ||
+        srsran_softbuffer_rx_init_pool(&softbuffer_rx, &pool_rx, max_cb)) {
+      ERROR("Error initiating soft buffer pools");
+      goto quit;
+    }
+  } else {
+    if (srsran_softbuffer_tx_init(&softbuffer_tx, 100)) {
+      ERROR("Error initiating soft buffer");
+      goto quit;
+    }
 
-  if (srsran_softbuffer_rx_init(&softbuffer_rx, 100)) {
-    ERROR("Error initiating soft buffer");
-    goto quit;
+    if (srsran_softbuffer_rx_init(&softbuffer_rx, 100)) {
+      ERROR("Error initiating soft buffer");
+      goto quit;
+    }
   }
 
   srsran_chest_ul_res_init(&chest_res, cell.nof_prb);
@@ -293,6 +319,8 @@ int main(int argc, char** argv)
 
     srsran_softbuffer_tx_reset(&softbuffer_tx);
     srsran_softbuffer_rx_reset(&softbuffer_rx);
+    srsran_softbuffer_tx_reset_tbs(&softbuffer_tx, cfg.grant.tb.tbs);
+    srsran_softbuffer_rx_reset_tbs(&softbuffer_rx, cfg.grant.tb.tbs);
 
     // Generate random data
     for (uint32_t i = 0; i < cfg.grant.tb.tbs / 8; i++) {
@@ -405,6 +433,8 @@ quit:
   srsran_pusch_free(&pusch_rx);
   srsran_softbuffer_tx_free(&softbuffer_tx);
   srsran_softbuffer_rx_free(&softbuffer_rx);
+  srsran_softbuffer_pool_free(&pool_tx);
+  srsran_softbuffer_pool_free(&pool_rx);
   srsran_random_free(random_h);
   if (sf_symbols) {
     free(sf_symbols);
@@ -0,0 +1,651 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp.h"
+#include "rf_helper.h"
+#include "rf_shm_imp_ring.h"
+#include <math.h>
+#include <pthread.h>
+#include <srsran/phy/common/phy_common.h>
+#include <srsran/phy/common/timestamp.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Definitions */
+#define SHM_TIMEOUT_MS (2000)
+#define SHM_BASERATE_DEFAULT_HZ (23040000)
+#define SHM_MAX_BUFFER_NSAMPLES (3072000) // 10 subframes at 20 MHz, same as ZMQ
+#define SHM_MAX_GAIN_DB (30.0f)
+#define SHM_MIN_GAIN_DB (0.0f)
+
+/*
+ * Same-host RF device exchanging base-band samples through shared-memory rings. Each process writes its own lane of
+ * the tx ring and reads the sum of the lanes of the rx ring, so several UEs can attach to the rings of one eNB: the
+ * downlink is broadcast to every UE reader and the uplink lanes are added up at the eNB. Timestamps travel with the
+ * samples, there is no real-time pacing and the run speed is set by the slowest process.
+ */
+typedef struct {
+  // Common attributes
+  srsran_rf_info_t info;
+  uint32_t         nof_channels;
+
+  // RF State
+  uint32_t srate; // radio rate configured by upper layers
+  uint32_t base_srate;
+  uint32_t decim_factor; // decimation factor between base_srate used on transport on radio's rate
+  double   rx_gain;
+  double   tx_gain;
+  char     id[RF_PARAM_LEN];
+
+  // Rings
+  rf_shm_ring_t tx_ring[SRSRAN_MAX_CHANNELS];
+  rf_shm_ring_t rx_ring[SRSRAN_MAX_CHANNELS];
+  bool          tx_enabled[SRSRAN_MAX_CHANNELS];
+  bool          rx_enabled[SRSRAN_MAX_CHANNELS];
+  bool          tx_off;
+  bool          rx_off;
+  bool          rx_anchored;
+
+  // Various sample buffers
+  cf_t* buffer_decimation[SRSRAN_MAX_CHANNELS];
+  cf_t* buffer_tx;
+
+  // Rx timestamp
+  uint64_t next_rx_ts;
+
+  pthread_mutex_t tx_config_mutex;
+  pthread_mutex_t decim_mutex;
+  pthread_mutex_t rx_gain_mutex;
+} rf_shm_handler_t;
+
+static void update_rates(rf_shm_handler_t* handler, double srate);
+
+/*
+ * Static Atributes
+ */
+const char shm_devname[4] = "shm";
+
+/*
+ * Public methods
+ */
+
+void rf_shm_suppress_stdout(void* h)
+{
+  // do nothing
+}
+
+void rf_shm_register_error_handler(void* h, srsran_rf_error_handler_t new_handler, void* arg)
+{
+  // do nothing
+}
+
+const char* rf_shm_devname(void* h)
+{
+  return shm_devname;
+}
+
+int rf_shm_start_rx_stream(void* h, bool now)
+{
+  return SRSRAN_SUCCESS;
+}
+
+int rf_shm_stop_rx_stream(void* h)
+{
+  return SRSRAN_SUCCESS;
+}
+
+void rf_shm_flush_buffer(void* h)
+{
+  // do nothing
+}
+
+bool rf_shm_has_rssi(void* h)
+{
+  return false;
+}
+
+float rf_shm_get_rssi(void* h)
+{
+  return 0.0;
+}
+
+int rf_shm_open(char* args, void** h)
+{
+  return rf_shm_open_multi(args, h, 1);
+}
+
+int rf_shm_open_multi(char* args, void** h, uint32_t nof_channels)
+{
+  int ret = SRSRAN_ERROR;
+  if (h && nof_channels < SRSRAN_MAX_CHANNELS) {
+    *h = NULL;
+
+    if (args == NULL || strlen(args) == 0) {
+      fprintf(stderr,
+              "[shm] Error: No device 'args' option has been set. Please set tx_ring and/or rx_ring to be able to use "
+              "the shared-memory no-RF module\n");
+      return SRSRAN_ERROR;
+    }
+
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)malloc(sizeof(rf_shm_handler_t));
+    if (!handler) {
+      perror("malloc");
+      return SRSRAN_ERROR;
+    }
+    bzero(handler, sizeof(rf_shm_handler_t));
+    *h                        = handler;
+    handler->base_srate       = SHM_BASERATE_DEFAULT_HZ; // Sample rate for 100 PRB cell
+    handler->info.max_rx_gain = SHM_MAX_GAIN_DB;
+    handler->info.min_rx_gain = SHM_MIN_GAIN_DB;
+    handler->info.max_tx_gain = SHM_MAX_GAIN_DB;
+    handler->info.min_tx_gain = SHM_MIN_GAIN_DB;
+    handler->nof_channels     = nof_channels;
+    handler->tx_off           = true;
+    handler->rx_off           = true;
+    strcpy(handler->id, "shm\0");
+
+    if (pthread_mutex_init(&handler->tx_config_mutex, NULL)) {
+      perror("Mutex init");
+    }
+    if (pthread_mutex_init(&handler->decim_mutex, NULL)) {
+      perror("Mutex init");
+    }
+    if (pthread_mutex_init(&handler->rx_gain_mutex, NULL)) {
+      perror("Mutex init");
+    }
+
+    // base_srate
+    parse_uint32(args, "base_srate", -1, &handler->base_srate);
+
+    // id
+    parse_string(args, "id", -1, handler->id);
+
+    // ring_size, samples per lane. It must match in all the processes attached to the same ring
+    uint32_t ring_size = SHM_RING_SIZE_DEFAULT;
+    parse_uint32(args, "ring_size", -1, &ring_size);
+
+    // trx_timeout_ms, time after which a peer that stopped is ignored
+    uint32_t timeout_ms = SHM_TIMEOUT_MS;
+    parse_uint32(args, "trx_timeout_ms", -1, &timeout_ms);
+
+    update_rates(handler, 1.92e6);
+
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      // tx_ring
+      char tx_ring[RF_PARAM_LEN] = {};
+      parse_string(args, "tx_ring", i, tx_ring);
+
+      // rx_ring
+      char rx_ring[RF_PARAM_LEN] = {};
+      parse_string(args, "rx_ring", i, rx_ring);
+
+      if (strlen(tx_ring) != 0) {
+        if (rf_shm_ring_open(&handler->tx_ring[i], tx_ring, ring_size, true, timeout_ms) != SRSRAN_SUCCESS) {
+          fprintf(stderr, "[shm] Error: opening tx ring %s\n", tx_ring);
+          goto clean_exit;
+        }
+        handler->tx_enabled[i] = true;
+        handler->tx_off        = false;
+      }
+
+      if (strlen(rx_ring) != 0) {
+        if (rf_shm_ring_open(&handler->rx_ring[i], rx_ring, ring_size, false, timeout_ms) != SRSRAN_SUCCESS) {
+          fprintf(stderr, "[shm] Error: opening rx ring %s\n", rx_ring);
+          goto clean_exit;
+        }
+        handler->rx_enabled[i] = true;
+        handler->rx_off        = false;
+      }
+
+      if (!handler->tx_enabled[i] && !handler->rx_enabled[i]) {
+        fprintf(stderr, "[shm] Error: Neither tx_ring nor rx_ring specified for channel %d.\n", i);
+        goto clean_exit;
+      }
+    }
+
+    // Create decimation and interpolation buffers
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      handler->buffer_decimation[i] = srsran_vec_cf_malloc(SHM_MAX_BUFFER_NSAMPLES);
+      if (!handler->buffer_decimation[i]) {
+        fprintf(stderr, "Error: allocating decimation buffer\n");
+        goto clean_exit;
+      }
+    }
+
+    handler->buffer_tx = srsran_vec_cf_malloc(SHM_MAX_BUFFER_NSAMPLES);
+    if (!handler->buffer_tx) {
+      fprintf(stderr, "Error: allocating tx buffer\n");
+      goto clean_exit;
+    }
+
+    ret = SRSRAN_SUCCESS;
+
+  clean_exit:
+    if (ret) {
+      rf_shm_close(handler);
+      *h = NULL;
+    }
+  }
+  return ret;
+}
+
+int rf_shm_close(void* h)
+{
+  rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+  if (handler == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    rf_shm_ring_close(&handler->tx_ring[i]);
+    rf_shm_ring_close(&handler->rx_ring[i]);
+    if (handler->buffer_decimation[i]) {
+      free(handler->buffer_decimation[i]);
+    }
+  }
+
+  if (handler->buffer_tx) {
+    free(handler->buffer_tx);
+  }
+
+  pthread_mutex_destroy(&handler->tx_config_mutex);
+  pthread_mutex_destroy(&handler->decim_mutex);
+  pthread_mutex_destroy(&handler->rx_gain_mutex);
+
+  free(handler);
+
+  return SRSRAN_SUCCESS;
+}
+
+void update_rates(rf_shm_handler_t* handler, double srate)
+{
+  pthread_mutex_lock(&handler->decim_mutex);
+  // Decimation must be full integer
+  if (((uint64_t)handler->base_srate % (uint64_t)srate) == 0) {
+    handler->srate        = (uint32_t)srate;
+    handler->decim_factor = handler->base_srate / handler->srate;
+  } else {
+    fprintf(stderr,
+            "Error: couldn't update sample rate. %.2f is not divisible by %.2f\n",
+            srate / 1e6,
+            handler->base_srate / 1e6);
+  }
+  printf("Current sample rate is %.2f MHz with a base rate of %.2f MHz (x%d decimation)\n",
+         handler->srate / 1e6,
+         handler->base_srate / 1e6,
+         handler->decim_factor);
+  pthread_mutex_unlock(&handler->decim_mutex);
+}
+
+double rf_shm_set_rx_srate(void* h, double srate)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    update_rates(handler, srate);
+    ret = handler->srate;
+  }
+  return ret;
+}
+
+double rf_shm_set_tx_srate(void* h, double srate)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    update_rates(handler, srate);
+    ret = srate;
+  }
+  return ret;
+}
+
+int rf_shm_set_rx_gain(void* h, double gain)
+{
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    pthread_mutex_lock(&handler->rx_gain_mutex);
+    handler->rx_gain = gain;
+    pthread_mutex_unlock(&handler->rx_gain_mutex);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int rf_shm_set_rx_gain_ch(void* h, uint32_t ch, double gain)
+{
+  return rf_shm_set_rx_gain(h, gain);
+}
+
+int rf_shm_set_tx_gain(void* h, double gain)
+{
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    pthread_mutex_lock(&handler->tx_config_mutex);
+    handler->tx_gain = gain;
+    pthread_mutex_unlock(&handler->tx_config_mutex);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int rf_shm_set_tx_gain_ch(void* h, uint32_t ch, double gain)
+{
+  return rf_shm_set_tx_gain(h, gain);
+}
+
+double rf_shm_get_rx_gain(void* h)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    pthread_mutex_lock(&handler->rx_gain_mutex);
+    ret = handler->rx_gain;
+    pthread_mutex_unlock(&handler->rx_gain_mutex);
+  }
+  return ret;
+}
+
+double rf_shm_get_tx_gain(void* h)
+{
+  double ret = NAN;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    pthread_mutex_lock(&handler->tx_config_mutex);
+    ret = handler->tx_gain;
+    pthread_mutex_unlock(&handler->tx_config_mutex);
+  }
+  return ret;
+}
+
+srsran_rf_info_t* rf_shm_get_info(void* h)
+{
+  srsran_rf_info_t* info = NULL;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    info                      = &handler->info;
+  }
+  return info;
+}
+
+double rf_shm_set_rx_freq(void* h, uint32_t ch, double freq)
+{
+  // Channels map one to one to rings, the frequency is not used
+  return freq;
+}
+
+double rf_shm_set_tx_freq(void* h, uint32_t ch, double freq)
+{
+  return freq;
+}
+
+void rf_shm_get_time(void* h, time_t* secs, double* frac_secs)
+{
+  if (h) {
+    rf_shm_handler_t*  handler = (rf_shm_handler_t*)h;
+    srsran_timestamp_t ts      = {};
+    srsran_timestamp_init_uint64(&ts, handler->next_rx_ts, handler->base_srate);
+    if (secs) {
+      *secs = ts.full_secs;
+    }
+    if (frac_secs) {
+      *frac_secs = ts.frac_secs;
+    }
+  }
+}
+
+static void rf_shm_tx_align(rf_shm_handler_t* handler, uint64_t ts)
+{
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    // Writing nothing at ts fills the gap with zeros
+    if (handler->tx_enabled[i]) {
+      rf_shm_ring_write(&handler->tx_ring[i], ts, NULL, 1.0f, 0);
+    }
+  }
+}
+
+int rf_shm_recv_with_time(void* h, void* data, uint32_t nsamples, bool blocking, time_t* secs, double* frac_secs)
+{
+  return rf_shm_recv_with_time_multi(h, &data, nsamples, blocking, secs, frac_secs);
+}
+
+int rf_shm_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool blocking, time_t* secs, double* frac_secs)
+{
+  if (h == NULL || data == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+
+  // Protect the access to decim_factor since is a shared variable
+  pthread_mutex_lock(&handler->decim_mutex);
+  uint32_t decim_factor = handler->decim_factor;
+  pthread_mutex_unlock(&handler->decim_mutex);
+
+  uint32_t nsamples_baserate = nsamples * decim_factor;
+  if (nsamples_baserate > SHM_MAX_BUFFER_NSAMPLES) {
+    fprintf(stderr,
+            "[shm] Error: Trying to receive %d samples but buffer is only %d samples.\n",
+            nsamples_baserate,
+            SHM_MAX_BUFFER_NSAMPLES);
+    return SRSRAN_ERROR;
+  }
+
+  // Provide our own samples up to the end of this reception first, otherwise two processes reading each other's tx
+  // would wait for each other
+  rf_shm_tx_align(handler, handler->next_rx_ts + nsamples_baserate);
+
+  // The first reception joins the time line of the process already writing the rx ring, if any
+  if (!handler->rx_anchored && !handler->rx_off) {
+    for (uint32_t i = 0; i < handler->nof_channels && !handler->rx_anchored; i++) {
+      uint64_t ts = 0;
+      if (handler->rx_enabled[i] && rf_shm_ring_anchor(&handler->rx_ring[i], &ts) == SRSRAN_SUCCESS) {
+        handler->next_rx_ts  = SRSRAN_MAX(handler->next_rx_ts, ts);
+        handler->rx_anchored = true;
+        rf_shm_tx_align(handler, handler->next_rx_ts + nsamples_baserate);
+      }
+    }
+    handler->rx_anchored = true;
+  }
+
+  // set timestamp for this reception
+  if (secs != NULL && frac_secs != NULL) {
+    srsran_timestamp_t ts = {};
+    srsran_timestamp_init_uint64(&ts, handler->next_rx_ts, handler->base_srate);
+    *secs      = ts.full_secs;
+    *frac_secs = ts.frac_secs;
+  }
+
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    cf_t* dst = (cf_t*)data[i];
+    if (dst == NULL) {
+      continue;
+    }
+
+    if (!handler->rx_enabled[i]) {
+      srsran_vec_cf_zero(dst, nsamples);
+      continue;
+    }
+
+    cf_t* ptr = (decim_factor != 1) ? handler->buffer_decimation[i] : dst;
+    if (rf_shm_ring_read(&handler->rx_ring[i], handler->next_rx_ts, ptr, nsamples_baserate) < SRSRAN_SUCCESS) {
+      fprintf(stderr, "Error: receiving data.\n");
+      return SRSRAN_ERROR;
+    }
+
+    // decimate if needed
+    if (decim_factor != 1) {
+      for (uint32_t k = 0, n = 0; k < nsamples; k++) {
+        // Averaging decimation
+        cf_t avg = 0.0f;
+        for (uint32_t j = 0; j < decim_factor; j++, n++) {
+          avg += ptr[n];
+        }
+        dst[k] = avg; // divide by decim_factor later via scale
+      }
+    }
+  }
+
+  // Set gain, the scale also incorporates decim_factor
+  pthread_mutex_lock(&handler->rx_gain_mutex);
+  float scale = srsran_convert_dB_to_amplitude(handler->rx_gain) / decim_factor;
+  pthread_mutex_unlock(&handler->rx_gain_mutex);
+  if (scale != 1.0f) {
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      if (data[i] != NULL && handler->rx_enabled[i]) {
+        srsran_vec_sc_prod_cfc(data[i], scale, data[i], nsamples);
+      }
+    }
+  }
+
+  // update rx time
+  handler->next_rx_ts += nsamples_baserate;
+
+  return nsamples;
+}
+
+int rf_shm_send_timed(void*  h,
+                      void*  data,
+                      int    nsamples,
+                      time_t secs,
+                      double frac_secs,
+                      bool   has_time_spec,
+                      bool   blocking,
+                      bool   is_start_of_burst,
+                      bool   is_end_of_burst)
+{
+  void* _data[SRSRAN_MAX_CHANNELS] = {data};
+
+  return rf_shm_send_timed_multi(
+      h, _data, nsamples, secs, frac_secs, has_time_spec, blocking, is_start_of_burst, is_end_of_burst);
+}
+
+int rf_shm_send_timed_multi(void*  h,
+                            void*  data[4],
+                            int    nsamples,
+                            time_t secs,
+                            double frac_secs,
+                            bool   has_time_spec,
+                            bool   blocking,
+                            bool   is_start_of_burst,
+                            bool   is_end_of_burst)
+{
+  if (h == NULL || data == NULL || nsamples <= 0) {
+    return SRSRAN_ERROR;
+  }
+
+  rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+
+  // return if transmitter is switched off
+  if (handler->tx_off) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Load transmission gain, if it is NAN, INF or 0.0, use 1.0
+  pthread_mutex_lock(&handler->tx_config_mutex);
+  float tx_gain = srsran_convert_dB_to_amplitude(handler->tx_gain);
+  pthread_mutex_unlock(&handler->tx_config_mutex);
+  if (!isnormal(tx_gain)) {
+    tx_gain = 1.0f;
+  }
+
+  // Protect the access to decim_factor since is a shared variable
+  pthread_mutex_lock(&handler->decim_mutex);
+  uint32_t decim_factor = handler->decim_factor;
+  pthread_mutex_unlock(&handler->decim_mutex);
+
+  uint32_t nsamples_baseband = nsamples * decim_factor;
+  if (nsamples_baseband > SHM_MAX_BUFFER_NSAMPLES) {
+    fprintf(stderr,
+            "Error: trying to transmit too many samples (%d > %d).\n",
+            nsamples_baseband,
+            SHM_MAX_BUFFER_NSAMPLES);
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    if (!handler->tx_enabled[i]) {
+      continue;
+    }
+
+    // Without time spec, samples follow the last transmission
+    uint64_t tx_ts = rf_shm_ring_write_ts(&handler->tx_ring[i]);
+    if (has_time_spec) {
+      srsran_timestamp_t ts = {};
+      srsran_timestamp_init(&ts, secs, frac_secs);
+      tx_ts = srsran_timestamp_uint64(&ts, handler->base_srate);
+      if (tx_ts < rf_shm_ring_write_ts(&handler->tx_ring[i])) {
+        fprintf(stderr,
+                "[shm] Error: tx time is %.3f ms in the past (%" PRIu64 " < %" PRIu64 ")\n",
+                1000.0 * (rf_shm_ring_write_ts(&handler->tx_ring[i]) - tx_ts) / handler->base_srate,
+                tx_ts,
+                rf_shm_ring_write_ts(&handler->tx_ring[i]));
+      }
+    }
+
+    cf_t* buf = (cf_t*)data[i];
+
+    // Interpolate if required, perform zero order hold
+    if (buf != NULL && decim_factor != 1) {
+      for (uint32_t k = 0, n = 0; k < nsamples; k++) {
+        for (uint32_t j = 0; j < decim_factor; j++, n++) {
+          handler->buffer_tx[n] = buf[k];
+        }
+      }
+      buf = handler->buffer_tx;
+    }
+
+    // Finally, write scaled according to current gain, or zeros if there is no buffer
+    if (rf_shm_ring_write(&handler->tx_ring[i], tx_ts, buf, tx_gain, nsamples_baseband) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+rf_dev_t srsran_rf_dev_shm = {"shm",
+                              rf_shm_devname,
+                              rf_shm_start_rx_stream,
+                              rf_shm_stop_rx_stream,
+                              rf_shm_flush_buffer,
+                              rf_shm_has_rssi,
+                              rf_shm_get_rssi,
+                              rf_shm_suppress_stdout,
+                              rf_shm_register_error_handler,
+                              rf_shm_open,
+                              .srsran_rf_open_multi = rf_shm_open_multi,
+                              rf_shm_close,
+                              rf_shm_set_rx_srate,
+                              rf_shm_set_rx_gain,
+                              rf_shm_set_rx_gain_ch,
+                              rf_shm_set_tx_gain,
+                              rf_shm_set_tx_gain_ch,
+                              rf_shm_get_rx_gain,
+                              rf_shm_get_tx_gain,
+                              rf_shm_get_info,
+                              rf_shm_set_rx_freq,
+                              rf_shm_set_tx_srate,
+                              rf_shm_set_tx_freq,
+                              rf_shm_get_time,
+                              NULL,
+                              rf_shm_recv_with_time,
+                              rf_shm_recv_with_time_multi,
+                              rf_shm_send_timed,
+                              .srsran_rf_send_timed_multi = rf_shm_send_timed_multi};
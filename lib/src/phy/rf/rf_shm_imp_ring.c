@@ -0,0 +1,524 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_ring.h"
+#include "srsran/phy/utils/vector.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SHM_SPIN_COUNT (64)
+#define SHM_SLEEP_US (10)
+
+/* Timestamps are read and published with acquire and release semantics, samples are ordered by them */
+#define SHM_LOAD(X) __atomic_load_n(&(X), __ATOMIC_ACQUIRE)
+#define SHM_STORE(X, V) __atomic_store_n(&(X), (V), __ATOMIC_RELEASE)
+
+typedef struct {
+  struct timespec start;
+  uint32_t        count;
+} rf_shm_wait_t;
+
+static void rf_shm_wait_init(rf_shm_wait_t* w)
+{
+  w->count = 0;
+  clock_gettime(CLOCK_MONOTONIC, &w->start);
+}
+
+// Backs off (spinning first, then sleeping) and returns true once the timeout is exceeded
+static bool rf_shm_wait_expired(rf_shm_wait_t* w, uint32_t timeout_ms)
+{
+  if (w->count < SHM_SPIN_COUNT) {
+    w->count++;
+    sched_yield();
+    return false;
+  }
+
+  usleep(SHM_SLEEP_US);
+
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  int64_t elapsed_ms = (now.tv_sec - w->start.tv_sec) * 1000 + (now.tv_nsec - w->start.tv_nsec) / 1000000;
+  return elapsed_ms >= (int64_t)timeout_ms;
+}
+
+static bool rf_shm_pid_alive(int32_t pid)
+{
+  return pid != 0 && (kill(pid, 0) == 0 || errno != ESRCH);
+}
+
+// Takes the segment lock. A lock held by a process that no longer exists is taken over, which is safe because the slot
+// updates done under the lock are single atomic stores and a half-done attach is cleaned up like any dead slot
+static void rf_shm_lock(rf_shm_header_t* hdr)
+{
+  int32_t pid   = (int32_t)getpid();
+  int32_t owner = 0;
+  while (!__atomic_compare_exchange_n(&hdr->lock_pid, &owner, pid, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+    // On failure, owner holds the current lock holder. Expect it again to take over the lock if it is gone
+    if (rf_shm_pid_alive(owner)) {
+      sched_yield();
+      owner = 0;
+    } else if (owner != 0) {
+      fprintf(stderr, "[shm] Taking over the lock held by process %d, which no longer exists\n", owner);
+    }
+  }
+}
+
+static void rf_shm_unlock(rf_shm_header_t* hdr)
+{
+  __atomic_store_n(&hdr->lock_pid, 0, __ATOMIC_RELEASE);
+}
+
+static size_t rf_shm_segment_size(uint32_t capacity)
+{
+  return sizeof(rf_shm_header_t) + (size_t)SHM_MAX_WRITERS * capacity * sizeof(cf_t);
+}
+
+static cf_t* rf_shm_lane(rf_shm_ring_t* q, uint32_t lane)
+{
+  return q->lanes + (size_t)lane * q->hdr->capacity;
+}
+
+// Attaches to a slot under the segment lock, clearing the slots left behind by processes that no longer exist
+static int rf_shm_attach(rf_shm_ring_t* q)
+{
+  rf_shm_header_t* hdr = q->hdr;
+  int32_t          pid = (int32_t)getpid();
+
+  rf_shm_lock(hdr);
+  for (uint32_t i = 0; i < SHM_MAX_WRITERS; i++) {
+    if (hdr->writers[i].pid != 0 && !rf_shm_pid_alive(hdr->writers[i].pid)) {
+      SHM_STORE(hdr->writers[i].pid, 0);
+    }
+  }
+  for (uint32_t i = 0; i < SHM_MAX_READERS; i++) {
+    if (hdr->readers[i].pid != 0 && !rf_shm_pid_alive(hdr->readers[i].pid)) {
+      SHM_STORE(hdr->readers[i].pid, 0);
+    }
+  }
+
+  rf_shm_slot_t* slots     = q->is_writer ? hdr->writers : hdr->readers;
+  uint32_t       nof_slots = q->is_writer ? SHM_MAX_WRITERS : SHM_MAX_READERS;
+  q->slot                  = -1;
+  for (uint32_t i = 0; i < nof_slots && q->slot < 0; i++) {
+    if (slots[i].pid == 0) {
+      q->slot = (int32_t)i;
+      // A new writer starts at timestamp zero, a new reader is idle until its first read
+      SHM_STORE(slots[i].ts, q->is_writer ? 0 : SHM_TS_INVALID);
+      SHM_STORE(slots[i].pid, pid);
+    }
+  }
+  rf_shm_unlock(hdr);
+
+  if (q->slot < 0) {
+    fprintf(stderr, "[shm] Error: no free %s slot in %s\n", q->is_writer ? "writer" : "reader", q->name);
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int rf_shm_ring_open(rf_shm_ring_t* q, const char* name, uint32_t capacity, bool is_writer, uint32_t timeout_ms)
+{
+  int ret = SRSRAN_ERROR;
+  int fd  = -1;
+
+  if (q == NULL || name == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+    fprintf(stderr, "[shm] Error: ring size %d must be a power of two\n", capacity);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  memset(q, 0, sizeof(rf_shm_ring_t));
+  snprintf(q->name, SHM_NAME_LEN, "/srsran_rf_%s", name);
+  q->is_writer  = is_writer;
+  q->timeout_ms = timeout_ms;
+  q->slot       = -1;
+  q->size       = rf_shm_segment_size(capacity);
+
+  // The first process creates and initialises the segment, the rest wait for its magic
+  bool creator = true;
+  fd           = shm_open(q->name, O_RDWR | O_CREAT | O_EXCL, 0666);
+  if (fd < 0 && errno == EEXIST) {
+    creator = false;
+    fd      = shm_open(q->name, O_RDWR, 0666);
+  }
+  if (fd < 0) {
+    fprintf(stderr, "[shm] Error: opening %s: %s\n", q->name, strerror(errno));
+    goto clean_exit;
+  }
+
+  if (creator) {
+    if (ftruncate(fd, (off_t)q->size) < 0) {
+      fprintf(stderr, "[shm] Error: sizing %s: %s\n", q->name, strerror(errno));
+      goto clean_exit;
+    }
+  } else {
+    struct stat   st = {0};
+    rf_shm_wait_t w;
+    rf_shm_wait_init(&w);
+    while (fstat(fd, &st) == 0 && st.st_size == 0) {
+      if (rf_shm_wait_expired(&w, timeout_ms)) {
+        break;
+      }
+    }
+    if ((size_t)st.st_size != q->size) {
+      fprintf(stderr,
+              "[shm] Error: %s has %ld bytes, expected %ld. Check ring_size matches in all the processes\n",
+              q->name,
+              (long)st.st_size,
+              (long)q->size);
+      goto clean_exit;
+    }
+  }
+
+  void* ptr = mmap(NULL, q->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (ptr == MAP_FAILED) {
+    fprintf(stderr, "[shm] Error: mapping %s: %s\n", q->name, strerror(errno));
+    goto clean_exit;
+  }
+  q->hdr   = (rf_shm_header_t*)ptr;
+  q->lanes = (cf_t*)((uint8_t*)ptr + sizeof(rf_shm_header_t));
+
+  if (creator) {
+    q->hdr->version  = SHM_VERSION;
+    q->hdr->capacity = capacity;
+    SHM_STORE(q->hdr->magic, SHM_MAGIC);
+  } else {
+    rf_shm_wait_t w;
+    rf_shm_wait_init(&w);
+    while (SHM_LOAD(q->hdr->magic) != SHM_MAGIC) {
+      if (rf_shm_wait_expired(&w, timeout_ms)) {
+        fprintf(stderr, "[shm] Error: %s was not initialised\n", q->name);
+        goto clean_exit;
+      }
+    }
+    if (q->hdr->version != SHM_VERSION || q->hdr->capacity != capacity) {
+      fprintf(stderr, "[shm] Error: %s has version %d and size %d\n", q->name, q->hdr->version, q->hdr->capacity);
+      goto clean_exit;
+    }
+  }
+
+  if (rf_shm_attach(q) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (fd >= 0) {
+    close(fd);
+  }
+  if (ret != SRSRAN_SUCCESS && q->hdr != NULL) {
+    munmap(q->hdr, q->size);
+    q->hdr = NULL;
+  }
+  return ret;
+}
+
+void rf_shm_ring_close(rf_shm_ring_t* q)
+{
+  if (q == NULL || q->hdr == NULL) {
+    return;
+  }
+
+  rf_shm_header_t* hdr  = q->hdr;
+  bool             last = true;
+
+  rf_shm_lock(hdr);
+  if (q->slot >= 0) {
+    rf_shm_slot_t* slot = q->is_writer ? &hdr->writers[q->slot] : &hdr->readers[q->slot];
+    SHM_STORE(slot->ts, q->is_writer ? 0 : SHM_TS_INVALID);
+    SHM_STORE(slot->pid, 0);
+  }
+  for (uint32_t i = 0; i < SHM_MAX_WRITERS && last; i++) {
+    last = !rf_shm_pid_alive(hdr->writers[i].pid);
+  }
+  for (uint32_t i = 0; i < SHM_MAX_READERS && last; i++) {
+    last = !rf_shm_pid_alive(hdr->readers[i].pid);
+  }
+  // The last process out removes the name, so the next run starts with a fresh segment
+  if (last) {
+    shm_unlink(q->name);
+  }
+  rf_shm_unlock(hdr);
+
+  munmap(hdr, q->size);
+  q->hdr  = NULL;
+  q->slot = -1;
+}
+
+uint64_t rf_shm_ring_write_ts(rf_shm_ring_t* q)
+{
+  if (q == NULL || q->hdr == NULL || !q->is_writer) {
+    return 0;
+  }
+  return q->hdr->writers[q->slot].ts;
+}
+
+// Waits until every active reader is close enough for ts to be written without overwriting unread samples
+static void rf_shm_wait_readers(rf_shm_ring_t* q, uint64_t ts)
+{
+  uint64_t capacity = q->hdr->capacity;
+
+  for (uint32_t i = 0; i < SHM_MAX_READERS; i++) {
+    rf_shm_slot_t* reader = &q->hdr->readers[i];
+    uint64_t       rd_ts  = SHM_LOAD(reader->ts);
+
+    if (rd_ts == SHM_TS_INVALID || SHM_LOAD(reader->pid) == 0) {
+      continue;
+    }
+
+    // A reader that timed out earlier is skipped until it moves again
+    if (q->stale[i]) {
+      if (rd_ts == q->stale_ts[i]) {
+        continue;
+      }
+      q->stale[i] = false;
+    }
+
+    rf_shm_wait_t w;
+    rf_shm_wait_init(&w);
+    while (ts > rd_ts + capacity) {
+      if (rf_shm_wait_expired(&w, q->timeout_ms)) {
+        fprintf(stderr, "[shm] Warning: reader %d of %s stalled, ignoring it\n", i, q->name);
+        q->stale[i]    = true;
+        q->stale_ts[i] = rd_ts;
+        break;
+      }
+      rd_ts = SHM_LOAD(reader->ts);
+      if (rd_ts == SHM_TS_INVALID) {
+        break;
+      }
+    }
+  }
+}
+
+int rf_shm_ring_write(rf_shm_ring_t* q, uint64_t ts, const cf_t* buffer, float scale, uint32_t nsamples)
+{
+  if (q == NULL || q->hdr == NULL || !q->is_writer) {
+    return SRSRAN_ERROR;
+  }
+
+  rf_shm_slot_t* lane_slot = &q->hdr->writers[q->slot];
+  cf_t*          lane      = rf_shm_lane(q, q->slot);
+  uint64_t       capacity  = q->hdr->capacity;
+  uint64_t       chunk_max = capacity / 4;
+  uint64_t       w_ts      = lane_slot->ts;
+  uint32_t       processed = nsamples;
+
+  // Drop what is already in the past
+  if (ts < w_ts) {
+    uint64_t late = SRSRAN_MIN(w_ts - ts, nsamples);
+    if (buffer != NULL) {
+      buffer += late;
+    }
+    nsamples -= late;
+    ts += late;
+  }
+
+  // Fill the gap with zeros, no more than the capacity since older samples would be overwritten anyway
+  if (ts > w_ts + capacity) {
+    w_ts = ts - capacity;
+  }
+  uint64_t end = ts + nsamples;
+
+  while (w_ts < end) {
+    uint64_t gap   = (w_ts < ts) ? ts - w_ts : 0;
+    uint64_t count = SRSRAN_MIN(chunk_max, gap ? gap : end - w_ts);
+    uint64_t idx   = w_ts & (capacity - 1);
+
+    rf_shm_wait_readers(q, w_ts + count);
+
+    // Copy in up to two pieces around the end of the lane
+    uint64_t n1 = SRSRAN_MIN(count, capacity - idx);
+    uint64_t n2 = count - n1;
+    if (gap || buffer == NULL) {
+      srsran_vec_cf_zero(lane + idx, (uint32_t)n1);
+      srsran_vec_cf_zero(lane, (uint32_t)n2);
+    } else {
+      const cf_t* src = buffer + (w_ts - ts);
+      if (scale != 1.0f) {
+        srsran_vec_sc_prod_cfc(src, scale, lane + idx, (uint32_t)n1);
+        srsran_vec_sc_prod_cfc(src + n1, scale, lane, (uint32_t)n2);
+      } else {
+        srsran_vec_cf_copy(lane + idx, src, (uint32_t)n1);
+        srsran_vec_cf_copy(lane, src + n1, (uint32_t)n2);
+      }
+    }
+
+    w_ts += count;
+    SHM_STORE(lane_slot->ts, w_ts);
+  }
+
+  return (int)processed;
+}
+
+static bool rf_shm_has_writers(rf_shm_ring_t* q)
+{
+  for (uint32_t i = 0; i < SHM_MAX_WRITERS; i++) {
+    if (SHM_LOAD(q->hdr->writers[i].pid) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int rf_shm_ring_anchor(rf_shm_ring_t* q, uint64_t* ts)
+{
+  if (q == NULL || q->hdr == NULL || q->is_writer || ts == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  rf_shm_wait_t w;
+  rf_shm_wait_init(&w);
+  while (!rf_shm_has_writers(q)) {
+    if (rf_shm_wait_expired(&w, q->timeout_ms)) {
+      return SRSRAN_ERROR_TIMEOUT;
+    }
+  }
+
+  // Readers start without stale peers
+  for (uint32_t i = 0; i < SHM_MAX_WRITERS; i++) {
+    q->stale[i]    = false;
+    q->stale_ts[i] = 0;
+  }
+
+  // The cursor is published under the segment lock, so it cannot race with the attach or detach of other processes.
+  // Writers keep advancing meanwhile, retry until none of them has gone past the published cursor by a whole ring
+  rf_shm_header_t* hdr      = q->hdr;
+  uint64_t         capacity = hdr->capacity;
+  uint64_t         rd_ts    = 0;
+  bool             settled  = false;
+  rf_shm_lock(hdr);
+  while (!settled) {
+    uint64_t w_ts = 0;
+    for (uint32_t i = 0; i < SHM_MAX_WRITERS; i++) {
+      if (SHM_LOAD(hdr->writers[i].pid) != 0) {
+        w_ts = SRSRAN_MAX(w_ts, SHM_LOAD(hdr->writers[i].ts));
+      }
+    }
+    rd_ts = w_ts - SRSRAN_MIN(w_ts, capacity / 2);
+    SHM_STORE(hdr->readers[q->slot].ts, rd_ts);
+
+    settled = true;
+    for (uint32_t i = 0; i < SHM_MAX_WRITERS; i++) {
+      if (SHM_LOAD(hdr->writers[i].pid) != 0 && SHM_LOAD(hdr->writers[i].ts) > rd_ts + capacity) {
+        settled = false;
+      }
+    }
+  }
+  rf_shm_unlock(hdr);
+
+  *ts = rd_ts;
+  return SRSRAN_SUCCESS;
+}
+
+int rf_shm_ring_read(rf_shm_ring_t* q, uint64_t ts, cf_t* buffer, uint32_t nsamples)
+{
+  if (q == NULL || q->hdr == NULL || q->is_writer || buffer == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  uint64_t capacity = q->hdr->capacity;
+  uint64_t end      = ts + nsamples;
+  bool     first    = true;
+
+  // Publish the position first so that the writers do not overwrite what is about to be read
+  SHM_STORE(q->hdr->readers[q->slot].ts, ts);
+
+  // Without any writer, pace the reader with the timeout instead of returning zeros in a busy loop
+  rf_shm_wait_t w;
+  rf_shm_wait_init(&w);
+  while (!rf_shm_has_writers(q) && !rf_shm_wait_expired(&w, q->timeout_ms)) {
+  }
+
+  for (uint32_t i = 0; i < SHM_MAX_WRITERS; i++) {
+    rf_shm_slot_t* writer = &q->hdr->writers[i];
+    if (SHM_LOAD(writer->pid) == 0) {
+      continue;
+    }
+
+    uint64_t w_ts = SHM_LOAD(writer->ts);
+
+    // A writer that timed out earlier only contributes what it has written until it moves again
+    if (q->stale[i] && w_ts != q->stale_ts[i]) {
+      q->stale[i] = false;
+    }
+
+    rf_shm_wait_init(&w);
+    while (w_ts < end && !q->stale[i]) {
+      if (rf_shm_wait_expired(&w, q->timeout_ms)) {
+        fprintf(stderr, "[shm] Warning: writer %d of %s stalled, ignoring it\n", i, q->name);
+        q->stale[i]    = true;
+        q->stale_ts[i] = w_ts;
+        break;
+      }
+      if (SHM_LOAD(writer->pid) == 0) {
+        break;
+      }
+      w_ts = SHM_LOAD(writer->ts);
+    }
+
+    // Valid samples of the lane, the ones older than one capacity have been overwritten
+    uint64_t a = SRSRAN_MAX(ts, (w_ts > capacity) ? w_ts - capacity : 0);
+    uint64_t b = SRSRAN_MIN(end, w_ts);
+    if (a >= b) {
+      continue;
+    }
+
+    if (first) {
+      srsran_vec_cf_zero(buffer, (uint32_t)(a - ts));
+      srsran_vec_cf_zero(buffer + (b - ts), (uint32_t)(end - b));
+    }
+
+    cf_t*    lane = rf_shm_lane(q, i);
+    uint64_t idx  = a & (capacity - 1);
+    uint64_t n1   = SRSRAN_MIN(b - a, capacity - idx);
+    uint64_t n2   = (b - a) - n1;
+    cf_t*    dst  = buffer + (a - ts);
+    if (first) {
+      srsran_vec_cf_copy(dst, lane + idx, (uint32_t)n1);
+      srsran_vec_cf_copy(dst + n1, lane, (uint32_t)n2);
+    } else {
+      srsran_vec_sum_ccc(dst, lane + idx, dst, (uint32_t)n1);
+      srsran_vec_sum_ccc(dst + n1, lane, dst + n1, (uint32_t)n2);
+    }
+    first = false;
+  }
+
+  if (first) {
+    srsran_vec_cf_zero(buffer, nsamples);
+  }
+
+  SHM_STORE(q->hdr->readers[q->slot].ts, end);
+
+  return (int)nsamples;
+}
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RF_SHM_IMP_RING_H
+#define SRSRAN_RF_SHM_IMP_RING_H
+
+#include "srsran/config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Definitions */
+#define SHM_MAGIC (0x5352534dU) // "SRSM"
+#define SHM_VERSION (2)
+#define SHM_NAME_LEN (64)
+#define SHM_MAX_WRITERS (16)
+#define SHM_MAX_READERS (16)
+#define SHM_TS_INVALID (UINT64_MAX)
+#define SHM_RING_SIZE_DEFAULT (1U << 20U) // 45 ms at 23.04 MHz
+
+/**
+ * @brief Writer lane or reader cursor in the shared segment, one per cache line
+ */
+typedef struct {
+  int32_t  pid; ///< Owner process, 0 if free
+  uint32_t reserved;
+  uint64_t ts; ///< Writers: timestamp of the next sample to write. Readers: next sample to read, SHM_TS_INVALID if idle
+  uint8_t  padding[48];
+} rf_shm_slot_t;
+
+/**
+ * @brief Header of a shared-memory ring. The header is followed by SHM_MAX_WRITERS lanes of capacity samples. Each
+ * lane is written by a single process and read by all the readers, which add up the lanes. Only the slot attach and
+ * detach take the spin lock, the sample path uses atomic timestamps. The lock stores the pid of its holder, so it can
+ * be taken over if that process dies while holding it.
+ */
+typedef struct {
+  uint32_t      magic;
+  uint32_t      version;
+  uint32_t      capacity; ///< Samples per lane, power of two
+  int32_t       lock_pid; ///< Process holding the slot lock, 0 if free
+  rf_shm_slot_t writers[SHM_MAX_WRITERS];
+  rf_shm_slot_t readers[SHM_MAX_READERS];
+} rf_shm_header_t;
+
+typedef struct {
+  char             name[SHM_NAME_LEN];
+  rf_shm_header_t* hdr;
+  cf_t*            lanes;
+  size_t           size;
+  bool             is_writer;
+  int32_t          slot;       ///< Own writer lane or reader cursor
+  uint32_t         timeout_ms; ///< Time after which a peer that makes no progress is ignored
+  bool             stale[SHM_MAX_WRITERS > SHM_MAX_READERS ? SHM_MAX_WRITERS : SHM_MAX_READERS];
+  uint64_t         stale_ts[SHM_MAX_WRITERS > SHM_MAX_READERS ? SHM_MAX_WRITERS : SHM_MAX_READERS];
+} rf_shm_ring_t;
+
+/**
+ * @brief Opens (creating it if needed) the shared-memory ring with the given name and attaches to a free writer lane or
+ * reader cursor. Slots of processes that no longer exist are reclaimed.
+ * @return SRSRAN_SUCCESS or SRSRAN_ERROR
+ */
+SRSRAN_API int
+rf_shm_ring_open(rf_shm_ring_t* q, const char* name, uint32_t capacity, bool is_writer, uint32_t timeout_ms);
+
+SRSRAN_API void rf_shm_ring_close(rf_shm_ring_t* q);
+
+/**
+ * @brief Writes nsamples from buffer (or zeros if buffer is NULL) scaled by scale, starting at timestamp ts. The gap
+ * since the last written sample is filled with zeros and samples older than the last written one are dropped. It
+ * waits for readers lagging more than the ring capacity.
+ * @return The number of samples processed or SRSRAN_ERROR
+ */
+SRSRAN_API int rf_shm_ring_write(rf_shm_ring_t* q, uint64_t ts, const cf_t* buffer, float scale, uint32_t nsamples);
+
+/**
+ * @brief Timestamp of the next sample this writer will write
+ */
+SRSRAN_API uint64_t rf_shm_ring_write_ts(rf_shm_ring_t* q);
+
+/**
+ * @brief Waits up to the timeout for a writer and returns a reading start timestamp that is already written: half the
+ * ring capacity behind the most advanced writer. The reader cursor is published at that timestamp before returning
+ * @return SRSRAN_SUCCESS, or SRSRAN_ERROR_TIMEOUT if no writer is attached
+ */
+SRSRAN_API int rf_shm_ring_anchor(rf_shm_ring_t* q, uint64_t* ts);
+
+/**
+ * @brief Reads the sum of all the writer lanes for the nsamples starting at ts, waiting for the writers to reach
+ * them. Lanes without writer, or whose writer stalls for longer than the timeout, contribute zeros.
+ * @return nsamples or SRSRAN_ERROR
+ */
+SRSRAN_API int rf_shm_ring_read(rf_shm_ring_t* q, uint64_t ts, cf_t* buffer, uint32_t nsamples);
+
+#endif // SRSRAN_RF_SHM_IMP_RING_H
@@ -0,0 +1,320 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp.h"
+#include "rf_shm_imp_ring.h"
+#include "srsran/common/tsan_options.h"
+#include "srsran/phy/common/timestamp.h"
+#include "srsran/phy/rf/rf.h"
+#include "srsran/phy/utils/debug.h"
+#include <complex.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <srsran/phy/common/phy_common.h>
+#include <srsran/phy/utils/vector.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define NOF_CHANNELS 2
+#define NOF_UE 2
+#define NUM_SF (300)
+#define SF_LEN (1920)
+#define TX_OFFSET_SF (4)
+#define CHECK_FROM_SF (NUM_SF / 2)
+
+static char              dl_name[32], ul_name[32];
+static pthread_barrier_t done_barrier;
+static int               ue_errors[NOF_UE] = {};
+static cf_t              enb_rx_buffer[NOF_CHANNELS][SF_LEN];
+static cf_t              enb_tx_buffer[NOF_CHANNELS][SF_LEN];
+
+// Value transmitted by the eNB in subframe sf of channel ch
+static cf_t dl_value(uint64_t sf, uint32_t ch)
+{
+  return (float)(sf + 1) + 1000.0f * ch;
+}
+
+// Value transmitted by a UE in subframe sf of channel ch, each UE on a different component
+static cf_t ul_value(uint32_t ue, uint64_t sf, uint32_t ch)
+{
+  return (ue == 0 ? 1.0f : _Complex_I) * ((float)(sf + 1) + 1000.0f * ch);
+}
+
+static uint64_t rx_sf(time_t secs, double frac_secs)
+{
+  srsran_timestamp_t ts = {};
+  srsran_timestamp_init(&ts, secs, frac_secs);
+  return srsran_timestamp_uint64(&ts, SF_LEN * 1000) / SF_LEN;
+}
+
+static void* ue_thread_function(void* arg)
+{
+  uint32_t    ue    = (uint32_t)(size_t)arg;
+  srsran_rf_t radio = {};
+  char        rf_args[RF_PARAM_LEN];
+  snprintf(rf_args,
+           RF_PARAM_LEN,
+           "rx_ring0=%s0,rx_ring1=%s1,tx_ring0=%s0,tx_ring1=%s1,base_srate=1920000,ring_size=65536",
+           dl_name,
+           dl_name,
+           ul_name,
+           ul_name);
+
+  if (srsran_rf_open_devname(&radio, "shm", rf_args, NOF_CHANNELS)) {
+    fprintf(stderr, "Error opening UE %d rf\n", ue);
+    exit(-1);
+  }
+  srsran_rf_set_rx_srate(&radio, SF_LEN * 1000);
+  srsran_rf_set_tx_srate(&radio, SF_LEN * 1000);
+
+  cf_t* rx_buffer[NOF_CHANNELS] = {};
+  cf_t* tx_buffer[NOF_CHANNELS] = {};
+  for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+    rx_buffer[c] = srsran_vec_cf_malloc(SF_LEN);
+    tx_buffer[c] = srsran_vec_cf_malloc(SF_LEN);
+  }
+
+  // Receive up to the last subframe transmitted by the eNB, whatever the subframe the UE joins in
+  uint64_t sf = 0;
+  while (sf < NUM_SF - 1) {
+    time_t secs      = 0;
+    double frac_secs = 0.0;
+    srsran_rf_recv_with_time_multi(&radio, (void**)rx_buffer, SF_LEN, true, &secs, &frac_secs);
+    sf = rx_sf(secs, frac_secs);
+
+    // The downlink is broadcast to every UE, it is all zeros until the eNB transmits
+    for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+      cf_t expected = (sf < TX_OFFSET_SF) ? 0.0f : dl_value(sf, c);
+      for (uint32_t i = 0; i < SF_LEN; i++) {
+        if (rx_buffer[c][i] != expected) {
+          if (ue_errors[ue] == 0) {
+            fprintf(stderr,
+                    "UE %d ch %d sf %" PRIu64 " sample %d: %+.1f%+.1fi, expected %+.1f%+.1fi\n",
+                    ue,
+                    c,
+                    sf,
+                    i,
+                    __real__ rx_buffer[c][i],
+                    __imag__ rx_buffer[c][i],
+                    __real__ expected,
+                    __imag__ expected);
+          }
+          ue_errors[ue]++;
+        }
+      }
+      for (uint32_t i = 0; i < SF_LEN; i++) {
+        tx_buffer[c][i] = ul_value(ue, sf + TX_OFFSET_SF, c);
+      }
+    }
+
+    srsran_timestamp_t tx_time = {};
+    srsran_timestamp_init(&tx_time, secs, frac_secs);
+    srsran_timestamp_add(&tx_time, 0, TX_OFFSET_SF * 1e-3);
+    srsran_rf_send_timed_multi(
+        &radio, (void**)tx_buffer, SF_LEN, tx_time.full_secs, tx_time.frac_secs, true, false, false);
+  }
+
+  // Keep the uplink lanes attached until the eNB has read them
+  pthread_barrier_wait(&done_barrier);
+  srsran_rf_close(&radio);
+
+  for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+    free(rx_buffer[c]);
+    free(tx_buffer[c]);
+  }
+  return NULL;
+}
+
+// A process that dies while holding the segment lock must not block the others forever
+static int test_dead_lock_owner()
+{
+  char          name[32];
+  rf_shm_ring_t writer = {};
+  rf_shm_ring_t reader = {};
+  snprintf(name, sizeof(name), "test_lock_%d", getpid());
+
+  // Get the pid of a process that no longer exists
+  pid_t dead_pid = fork();
+  if (dead_pid < 0) {
+    perror("fork");
+    return SRSRAN_ERROR;
+  }
+  if (dead_pid == 0) {
+    _exit(0);
+  }
+  waitpid(dead_pid, NULL, 0);
+
+  if (rf_shm_ring_open(&writer, name, 1024, true, 100) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error opening writer ring\n");
+    return SRSRAN_ERROR;
+  }
+  __atomic_store_n(&writer.hdr->lock_pid, (int32_t)dead_pid, __ATOMIC_RELEASE);
+
+  // Without the takeover, the attach spins until the alarm kills the test
+  alarm(10);
+  int ret = rf_shm_ring_open(&reader, name, 1024, false, 100);
+  alarm(0);
+  if (ret != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error opening reader ring with a dead lock holder\n");
+  }
+  rf_shm_ring_close(&reader);
+  rf_shm_ring_close(&writer);
+  return ret;
+}
+
+// The anchor must publish the reader cursor, otherwise writers may overwrite the samples it is about to read
+static int test_anchor_cursor()
+{
+  char          name[32];
+  rf_shm_ring_t writer = {};
+  rf_shm_ring_t reader = {};
+  uint64_t      ts     = 0;
+  int           ret    = SRSRAN_ERROR;
+  snprintf(name, sizeof(name), "test_anchor_%d", getpid());
+
+  if (rf_shm_ring_open(&writer, name, 1024, true, 100) != SRSRAN_SUCCESS ||
+      rf_shm_ring_open(&reader, name, 1024, false, 100) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error opening rings\n");
+  } else if (rf_shm_ring_write(&writer, 0, NULL, 1.0f, 768) < SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error writing ring\n");
+  } else if (rf_shm_ring_anchor(&reader, &ts) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error anchoring reader\n");
+  } else if (ts != 768 - 512 || __atomic_load_n(&reader.hdr->readers[reader.slot].ts, __ATOMIC_ACQUIRE) != ts) {
+    fprintf(stderr, "Reader anchored at %" PRIu64 " without publishing its cursor\n", ts);
+  } else {
+    ret = SRSRAN_SUCCESS;
+  }
+  rf_shm_ring_close(&reader);
+  rf_shm_ring_close(&writer);
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  int            ret   = SRSRAN_ERROR;
+  srsran_rf_t    radio = {};
+  pthread_t      ue_threads[NOF_UE];
+  char           rf_args[RF_PARAM_LEN];
+  uint32_t       enb_errors = 0;
+  struct timeval t[3];
+
+  if (test_dead_lock_owner() != SRSRAN_SUCCESS) {
+    printf("Test failed, the lock of a dead process was not taken over\n");
+    return SRSRAN_ERROR;
+  }
+  if (test_anchor_cursor() != SRSRAN_SUCCESS) {
+    printf("Test failed, the anchored reader cursor was not published\n");
+    return SRSRAN_ERROR;
+  }
+
+  // Unique ring names so that concurrent runs do not interfere
+  snprintf(dl_name, sizeof(dl_name), "test_dl_%d_", getpid());
+  snprintf(ul_name, sizeof(ul_name), "test_ul_%d_", getpid());
+  snprintf(rf_args,
+           RF_PARAM_LEN,
+           "tx_ring0=%s0,tx_ring1=%s1,rx_ring0=%s0,rx_ring1=%s1,base_srate=1920000,ring_size=65536",
+           dl_name,
+           dl_name,
+           ul_name,
+           ul_name);
+
+  if (srsran_rf_open_devname(&radio, "shm", rf_args, NOF_CHANNELS)) {
+    fprintf(stderr, "Error opening eNB rf\n");
+    return SRSRAN_ERROR;
+  }
+  srsran_rf_set_rx_srate(&radio, SF_LEN * 1000);
+  srsran_rf_set_tx_srate(&radio, SF_LEN * 1000);
+
+  pthread_barrier_init(&done_barrier, NULL, NOF_UE + 1);
+  for (uint32_t ue = 0; ue < NOF_UE; ue++) {
+    pthread_create(&ue_threads[ue], NULL, ue_thread_function, (void*)(size_t)ue);
+  }
+
+  gettimeofday(&t[1], NULL);
+  void* rx_ptr[NOF_CHANNELS] = {};
+  void* tx_ptr[NOF_CHANNELS] = {};
+  for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+    rx_ptr[c] = enb_rx_buffer[c];
+    tx_ptr[c] = enb_tx_buffer[c];
+  }
+
+  for (uint32_t n = 0; n < NUM_SF; n++) {
+    time_t secs      = 0;
+    double frac_secs = 0.0;
+    srsran_rf_recv_with_time_multi(&radio, rx_ptr, SF_LEN, true, &secs, &frac_secs);
+    uint64_t sf = rx_sf(secs, frac_secs);
+
+    // Once both UEs are running the uplink is the sum of their transmissions
+    for (uint32_t c = 0; c < NOF_CHANNELS; c++) {
+      cf_t expected = ul_value(0, sf, c) + ul_value(1, sf, c);
+      for (uint32_t i = 0; i < SF_LEN && sf >= CHECK_FROM_SF; i++) {
+        if (enb_rx_buffer[c][i] != expected) {
+          if (enb_errors == 0) {
+            fprintf(stderr,
+                    "eNB ch %d sf %" PRIu64 " sample %d: %+.1f%+.1fi, expected %+.1f%+.1fi\n",
+                    c,
+                    sf,
+                    i,
+                    __real__ enb_rx_buffer[c][i],
+                    __imag__ enb_rx_buffer[c][i],
+                    __real__ expected,
+                    __imag__ expected);
+          }
+          enb_errors++;
+        }
+      }
+      for (uint32_t i = 0; i < SF_LEN; i++) {
+        enb_tx_buffer[c][i] = dl_value(sf + TX_OFFSET_SF, c);
+      }
+    }
+
+    srsran_timestamp_t tx_time = {};
+    srsran_timestamp_init(&tx_time, secs, frac_secs);
+    srsran_timestamp_add(&tx_time, 0, TX_OFFSET_SF * 1e-3);
+    srsran_rf_send_timed_multi(&radio, tx_ptr, SF_LEN, tx_time.full_secs, tx_time.frac_secs, true, false, false);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  pthread_barrier_wait(&done_barrier);
+  for (uint32_t ue = 0; ue < NOF_UE; ue++) {
+    pthread_join(ue_threads[ue], NULL);
+  }
+  srsran_rf_close(&radio);
+  pthread_barrier_destroy(&done_barrier);
+
+  double elapsed_ms = t[0].tv_sec * 1e3 + t[0].tv_usec * 1e-3;
+  printf("%d subframes with %d UEs in %.1f ms (%.1fx real time)\n", NUM_SF, NOF_UE, elapsed_ms, NUM_SF / elapsed_ms);
+
+  uint32_t errors = enb_errors;
+  for (uint32_t ue = 0; ue < NOF_UE; ue++) {
+    errors += ue_errors[ue];
+  }
+  if (errors == 0) {
+    ret = SRSRAN_SUCCESS;
+  }
+  printf("Test %s (%d mismatched samples)\n", ret == SRSRAN_SUCCESS ? "passed" : "failed", errors);
+
+  return ret;
+}
@@ -0,0 +1,205 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_zmq_imp_trx.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define NOF_PATTERN_SF 10
+
+static char*    address     = "ipc:///tmp/rf_zmq_bench";
+static uint32_t base_srate  = 23040000;
+static uint32_t nof_sf      = 2000;
+static uint32_t tx_batch_ms = 0;
+static bool     sc16        = false;
+
+static rf_zmq_tx_t transmitter = {};
+static rf_zmq_rx_t receiver    = {};
+static cf_t*       tx_buffer   = NULL;
+static uint32_t    sf_len      = 0;
+static int         tx_ret      = SRSRAN_SUCCESS;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [abfns]\n", prog);
+  printf("\t-a ZMQ address [Default %s]\n", address);
+  printf("\t-b tx batch in subframes, 0 for one message per subframe [Default %d]\n", tx_batch_ms);
+  printf("\t-f use sc16 samples on the wire instead of fc32 [Default %s]\n", sc16 ? "sc16" : "fc32");
+  printf("\t-n number of subframes [Default %d]\n", nof_sf);
+  printf("\t-s base sampling rate in Hz [Default %d]\n", base_srate);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "abfns")) != -1) {
+    switch (opt) {
+      case 'a':
+        address = argv[optind];
+        break;
+      case 'b':
+        tx_batch_ms = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'f':
+        sc16 = true;
+        break;
+      case 'n':
+        nof_sf = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        base_srate = (uint32_t)strtod(argv[optind], NULL);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static void* tx_thread_function(void* arg)
+{
+  for (uint32_t i = 0; i < nof_sf && tx_ret == SRSRAN_SUCCESS; i++) {
+    if (rf_zmq_tx_baseband(&transmitter, &tx_buffer[(i % NOF_PATTERN_SF) * sf_len], 1.0f, sf_len) < 0) {
+      tx_ret = SRSRAN_ERROR;
+    }
+  }
+  return NULL;
+}
+
+int main(int argc, char** argv)
+{
+  int       ret     = SRSRAN_ERROR;
+  void*     context = NULL;
+  pthread_t tx_thread;
+  cf_t*     rx_buffer = NULL;
+
+  parse_args(argc, argv);
+
+  sf_len = base_srate / 1000;
+  if (tx_batch_ms && nof_sf % tx_batch_ms != 0) {
+    fprintf(stderr, "The number of subframes must be multiple of the batch size\n");
+    return SRSRAN_ERROR;
+  }
+
+  tx_buffer = srsran_vec_cf_malloc(sf_len * NOF_PATTERN_SF);
+  rx_buffer = srsran_vec_cf_malloc(sf_len);
+  if (!tx_buffer || !rx_buffer) {
+    fprintf(stderr, "Error allocating buffers\n");
+    goto clean_exit;
+  }
+
+  // Random samples within the short range so they survive the conversion
+  for (uint32_t i = 0; i < sf_len * NOF_PATTERN_SF; i++) {
+    tx_buffer[i] = ((float)rand() / (float)RAND_MAX - 0.5f) + _Complex_I * ((float)rand() / (float)RAND_MAX - 0.5f);
+  }
+
+  context = zmq_ctx_new();
+  if (!context) {
+    fprintf(stderr, "Error creating ZMQ context\n");
+    goto clean_exit;
+  }
+
+  rf_zmq_opts_t opts  = {};
+  opts.sample_format  = sc16 ? ZMQ_TYPE_SC16 : ZMQ_TYPE_FC32;
+  opts.trx_timeout_ms = 1000;
+
+  opts.id             = "tx";
+  opts.socket_type    = ZMQ_REP;
+  opts.batch_nsamples = tx_batch_ms * sf_len;
+  if (rf_zmq_tx_open(&transmitter, opts, context, address) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error opening transmitter\n");
+    goto clean_exit;
+  }
+
+  opts.id             = "rx";
+  opts.socket_type    = ZMQ_REQ;
+  opts.batch_nsamples = 0;
+  if (rf_zmq_rx_open(&receiver, opts, context, address) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error opening receiver\n");
+    goto clean_exit;
+  }
+
+  if (pthread_create(&tx_thread, NULL, tx_thread_function, NULL)) {
+    perror("pthread_create");
+    goto clean_exit;
+  }
+
+  struct timeval t[3];
+  gettimeofday(&t[1], NULL);
+
+  float max_err = 0.0f;
+  for (uint32_t i = 0; i < nof_sf; i++) {
+    if (rf_zmq_rx_baseband(&receiver, rx_buffer, sf_len) <= 0) {
+      fprintf(stderr, "Error receiving subframe %d\n", i);
+      tx_ret              = SRSRAN_ERROR;
+      transmitter.running = false;
+      break;
+    }
+
+    // Check the samples, sc16 quantizes them
+    srsran_vec_sub_ccc(rx_buffer, &tx_buffer[(i % NOF_PATTERN_SF) * sf_len], rx_buffer, sf_len);
+    uint32_t max_ix = srsran_vec_max_abs_ci(rx_buffer, sf_len);
+    max_err         = SRSRAN_MAX(max_err, cabsf(rx_buffer[max_ix]));
+  }
+
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  pthread_join(tx_thread, NULL);
+
+  double elapsed_s = t[0].tv_sec + t[0].tv_usec * 1e-6;
+  double msps      = (double)nof_sf * sf_len / elapsed_s / 1e6;
+  printf("Transferred %d subframes of %d %s samples (tx batch %d) in %.3f s: %.1f Msps, %.1fx real time, max err %.1e\n",
+         nof_sf,
+         sf_len,
+         sc16 ? "sc16" : "fc32",
+         tx_batch_ms,
+         elapsed_s,
+         msps,
+         msps * 1e6 / base_srate,
+         max_err);
+
+  float max_allowed_err = sc16 ? 2.0f / INT16_MAX : 1e-6f;
+  if (tx_ret == SRSRAN_SUCCESS && max_err < max_allowed_err) {
+    ret = SRSRAN_SUCCESS;
+  } else {
+    fprintf(stderr, "Received samples do not match\n");
+  }
+
+clean_exit:
+  rf_zmq_rx_close(&receiver);
+  rf_zmq_tx_close(&transmitter);
+  if (context) {
+    zmq_ctx_destroy(context);
+  }
+  if (tx_buffer) {
+    free(tx_buffer);
+  }
+  if (rx_buffer) {
+    free(rx_buffer);
+  }
+  return ret;
+}
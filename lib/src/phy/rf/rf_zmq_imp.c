@@ -243,6 +243,12 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
       // base_srate
       parse_uint32(args, "base_srate", -1, &handler->base_srate);
 
+      // tx_batch_ms, number of milliseconds of samples sent in a single message. Note that with the default
+      // request/reply sockets it must not exceed the time the peer transmits in advance, otherwise both ends stall
+      uint32_t tx_batch_ms = 0;
+      parse_uint32(args, "tx_batch_ms", -1, &tx_batch_ms);
+      tx_opts.batch_nsamples = (uint32_t)(((uint64_t)tx_batch_ms * handler->base_srate) / 1000);
+
       // id
       parse_string(args, "id", -1, handler->id);
 
@@ -970,11 +976,8 @@ int rf_zmq_send_timed_multi(void*  h,
           }
         }
 
-        // Scale according to current gain
-        srsran_vec_sc_prod_cfc(buf, tx_gain, buf, nsamples_baseband);
-
-        // Finally, transmit baseband
-        int n = rf_zmq_tx_baseband(&handler->transmitter[i], buf, nsamples_baseband);
+        // Finally, transmit baseband scaled according to current gain
+        int n = rf_zmq_tx_baseband(&handler->transmitter[i], buf, tx_gain, nsamples_baseband);
         if (n == SRSRAN_ERROR) {
           goto clean_exit;
         }
@@ -31,9 +31,10 @@ static void* rf_zmq_async_rx_thread(void* h)
   rf_zmq_rx_t* q = (rf_zmq_rx_t*)h;
 
   while (q->sock && rf_zmq_rx_is_running(q)) {
-    int     nbytes = 0;
-    int     n      = SRSRAN_ERROR;
-    uint8_t dummy  = 0xFF;
+    int       nbytes = 0;
+    int       n      = SRSRAN_ERROR;
+    uint8_t   dummy  = 0xFF;
+    zmq_msg_t msg;
 
     rf_zmq_info(q->id, "-- ASYNC RX wait...\n");
 
@@ -52,11 +53,14 @@ static void* rf_zmq_async_rx_thread(void* h)
       n = 0;
     }
 
-    // Receive baseband
+    // Receive baseband in a message owned by ZMQ. Its payload is copied once into the ring buffer, there is no
+    // intermediate buffer in between
+    zmq_msg_init(&msg);
     for (n = (n < 0) ? 0 : -1; n < 0 && rf_zmq_rx_is_running(q);) {
-      n = zmq_recv(q->sock, q->temp_buffer, ZMQ_MAX_BUFFER_SIZE, 0);
+      n = zmq_msg_recv(&msg, q->sock, 0);
       if (n == -1) {
         if (rf_zmq_handle_error(q->id, "asynchronous rx baseband receive")) {
+          zmq_msg_close(&msg);
           return NULL;
         }
 
@@ -66,6 +70,7 @@ static void* rf_zmq_async_rx_thread(void* h)
                 ZMQ_MAX_BUFFER_SIZE,
                 n,
                 0);
+        zmq_msg_close(&msg);
         return NULL;
       } else {
         nbytes = n;
@@ -78,7 +83,7 @@ static void* rf_zmq_async_rx_thread(void* h)
 
       // Try to write in ring buffer
       while (n < 0 && rf_zmq_rx_is_running(q)) {
-        n = srsran_ringbuffer_write_timed(&q->ringbuffer, q->temp_buffer, nbytes, q->trx_timeout_ms);
+        n = srsran_ringbuffer_write_timed(&q->ringbuffer, zmq_msg_data(&msg), nbytes, q->trx_timeout_ms);
         if (n == SRSRAN_ERROR_TIMEOUT && q->log_trx_timeout) {
           fprintf(stderr, "Error: timeout writing samples to ringbuffer after %dms\n", q->trx_timeout_ms);
         }
@@ -93,6 +98,7 @@ static void* rf_zmq_async_rx_thread(void* h)
                     NBYTES2NSAMPLES(srsran_ringbuffer_status(&q->ringbuffer)));
       }
     }
+    zmq_msg_close(&msg);
   }
 
   return NULL;
@@ -183,12 +189,6 @@ int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
       goto clean_exit;
     }
 
-    q->temp_buffer_convert = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
-    if (!q->temp_buffer_convert) {
-      fprintf(stderr, "Error: allocating rx buffer\n");
-      goto clean_exit;
-    }
-
     if (pthread_mutex_init(&q->mutex, NULL)) {
       fprintf(stderr, "Error: creating mutex\n");
       goto clean_exit;
@@ -209,11 +209,9 @@ clean_exit:
 
 int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples)
 {
-  void*    dst_buffer = buffer;
-  uint32_t sample_sz  = sizeof(cf_t);
+  uint32_t sample_sz = sizeof(cf_t);
   if (q->sample_format != ZMQ_TYPE_FC32) {
-    dst_buffer = q->temp_buffer_convert;
-    sample_sz  = 2 * sizeof(short);
+    sample_sz = 2 * sizeof(short);
   }
 
   // If the read needs to be delayed
@@ -238,16 +236,12 @@ int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples)
     q->sample_offset += n_offset;
   }
 
-  int n = srsran_ringbuffer_read_timed(&q->ringbuffer, dst_buffer, sample_sz * nsamples, q->trx_timeout_ms);
-  if (n < 0) {
-    return n;
-  }
-
+  // Short samples are converted straight from the ring buffer
   if (q->sample_format == ZMQ_TYPE_SC16) {
-    srsran_vec_convert_if(dst_buffer, INT16_MAX, (float*)buffer, 2 * nsamples);
+    return srsran_ringbuffer_read_convert_timed(&q->ringbuffer, buffer, INT16_MAX, nsamples, q->trx_timeout_ms);
   }
 
-  return n;
+  return srsran_ringbuffer_read_timed(&q->ringbuffer, buffer, sample_sz * nsamples, q->trx_timeout_ms);
 }
 
 bool rf_zmq_rx_match_freq(rf_zmq_rx_t* q, uint32_t freq_hz)
@@ -280,10 +274,6 @@ void rf_zmq_rx_close(rf_zmq_rx_t* q)
     free(q->temp_buffer);
   }
 
-  if (q->temp_buffer_convert) {
-    free(q->temp_buffer_convert);
-  }
-
   if (q->sock) {
     zmq_close(q->sock);
     q->sock = NULL;
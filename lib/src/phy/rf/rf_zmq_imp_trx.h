@@ -25,6 +25,7 @@
 #include <pthread.h>
 #include <srsran/phy/utils/ringbuffer.h>
 #include <stdbool.h>
+#include <zmq.h>
 
 /* Definitions */
 #define VERBOSE (0)
@@ -48,8 +49,11 @@ typedef struct {
   uint64_t        nsamples;
   bool            running;
   pthread_mutex_t mutex;
-  cf_t*           zeros;
-  void*           temp_buffer_convert;
+  zmq_msg_t       msg;            ///< Message being filled, its payload is handed over to ZMQ without copies
+  bool            msg_pending;    ///< Set when msg is initialised and not sent yet
+  uint32_t        msg_capacity;   ///< Number of samples that fit in msg
+  uint32_t        msg_nsamples;   ///< Number of samples written in msg
+  uint32_t        batch_nsamples; ///< Number of samples sent in a single message, 0 for one message per call
   uint32_t        frequency_mhz;
   int32_t         sample_offset;
 } rf_zmq_tx_t;
@@ -69,7 +73,6 @@ typedef struct {
   pthread_mutex_t     mutex;
   srsran_ringbuffer_t ringbuffer;
   cf_t*               temp_buffer;
-  void*               temp_buffer_convert;
   uint32_t            frequency_mhz;
   bool                fail_on_disconnect;
   uint32_t            trx_timeout_ms;
@@ -85,7 +88,8 @@ typedef struct {
   bool            fail_on_disconnect;
   uint32_t        trx_timeout_ms;
   bool            log_trx_timeout;
-  int32_t         sample_offset; ///< offset in samples
+  int32_t         sample_offset;  ///< offset in samples
+  uint32_t        batch_nsamples; ///< Tx samples gathered in a single message, 0 sends one message per call
 } rf_zmq_opts_t;
 
 /*
@@ -104,7 +108,11 @@ SRSRAN_API int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx,
 
 SRSRAN_API int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts);
 
-SRSRAN_API int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples);
+/**
+ * @brief Transmits nsamples from buffer scaled by scale. The scaling is applied while the samples are written in the
+ * message, so the buffer is not modified. Samples are sent once the current message is full.
+ */
+SRSRAN_API int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, float scale, uint32_t nsamples);
 
 SRSRAN_API int rf_zmq_tx_get_nsamples(rf_zmq_tx_t* q);
 
@@ -45,10 +45,20 @@ int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
       fprintf(stderr, "[zmq] Error: creating transmitter socket\n");
       goto clean_exit;
     }
-    q->socket_type   = opts.socket_type;
-    q->sample_format = opts.sample_format;
-    q->frequency_mhz = opts.frequency_mhz;
-    q->sample_offset = opts.sample_offset;
+    q->socket_type    = opts.socket_type;
+    q->sample_format  = opts.sample_format;
+    q->frequency_mhz  = opts.frequency_mhz;
+    q->sample_offset  = opts.sample_offset;
+    q->batch_nsamples = opts.batch_nsamples;
+
+    // The receiver buffers a whole message
+    if (NSAMPLES2NBYTES(q->batch_nsamples) > ZMQ_MAX_BUFFER_SIZE) {
+      fprintf(stderr,
+              "[zmq] Error: tx batch of %d samples exceeds the maximum of %zu\n",
+              q->batch_nsamples,
+              NBYTES2NSAMPLES(ZMQ_MAX_BUFFER_SIZE));
+      goto clean_exit;
+    }
 
     rf_zmq_info(q->id, "Binding transmitter: %s\n", sock_args);
 
@@ -82,19 +92,6 @@ int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
       goto clean_exit;
     }
 
-    q->temp_buffer_convert = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
-    if (!q->temp_buffer_convert) {
-      fprintf(stderr, "Error: allocating rx buffer\n");
-      goto clean_exit;
-    }
-
-    q->zeros = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
-    if (!q->zeros) {
-      fprintf(stderr, "Error: allocating zeros\n");
-      goto clean_exit;
-    }
-    bzero(q->zeros, ZMQ_MAX_BUFFER_SIZE);
-
     q->running = true;
 
     ret = SRSRAN_SUCCESS;
@@ -104,9 +101,16 @@ clean_exit:
   return ret;
 }
 
-static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
+static uint32_t rf_zmq_tx_sample_sz(rf_zmq_tx_t* q)
 {
-  int n = SRSRAN_ERROR;
+  return (q->sample_format == ZMQ_TYPE_SC16) ? 2 * sizeof(int16_t) : sizeof(cf_t);
+}
+
+// Sends the pending message once the peer requests it (if the socket type is REPLY)
+static int rf_zmq_tx_flush(rf_zmq_tx_t* q)
+{
+  int    n      = SRSRAN_ERROR;
+  size_t nbytes = zmq_msg_size(&q->msg);
 
   while (n < 0 && q->running) {
     // Receive Transmit request is socket type is REPLY
@@ -121,34 +125,24 @@ static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
       } else {
         // Tx request received successful
         rf_zmq_info(q->id, " - tx request received\n");
-        rf_zmq_info(q->id, " - sending %d samples (%d B)\n", nsamples, NSAMPLES2NBYTES(nsamples));
+        rf_zmq_info(q->id, " - sending %d samples (%d B)\n", q->msg_nsamples, (int)nbytes);
       }
     } else {
       n = 1;
     }
 
-    // convert samples if necessary
-    void*    buf       = (buffer) ? buffer : q->zeros;
-    uint32_t sample_sz = sizeof(cf_t);
-
-    if (q->sample_format == ZMQ_TYPE_SC16) {
-      buf       = q->temp_buffer_convert;
-      sample_sz = 2 * sizeof(short);
-      srsran_vec_convert_fi((float*)buffer, INT16_MAX, (short*)q->temp_buffer_convert, 2 * nsamples);
-    }
-
-    // Send base-band if request was received
+    // Send base-band if request was received, ZMQ takes the ownership of the message payload
     if (n > 0) {
-      n = zmq_send(q->sock, buf, (size_t)sample_sz * nsamples, 0);
+      n = zmq_msg_send(&q->msg, q->sock, 0);
       if (n < 0) {
         if (rf_zmq_handle_error(q->id, "tx baseband send")) {
           n = SRSRAN_ERROR;
           goto clean_exit;
         }
-      } else if (n != NSAMPLES2NBYTES(nsamples)) {
+      } else if ((size_t)n != nbytes) {
         rf_zmq_error(q->id,
                      "[zmq] Error: transmitter expected %d bytes and sent %d. %s.\n",
-                     NSAMPLES2NBYTES(nsamples),
+                     (int)nbytes,
                      n,
                      strerror(zmq_errno()));
         n = SRSRAN_ERROR;
@@ -159,12 +153,60 @@ static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
     // If failed to receive request or send base-band, keep trying
   }
 
+clean_exit:
+  // The message is empty after a successful send, otherwise it is discarded
+  zmq_msg_close(&q->msg);
+  q->msg_pending  = false;
+  q->msg_nsamples = 0;
+
+  // Samples are silently dropped when the transmitter is stopped
+  return (n < 0 && q->running) ? SRSRAN_ERROR : SRSRAN_SUCCESS;
+}
+
+// Writes the samples (or zeros if buffer is NULL) in the pending message, sending it whenever it is full
+static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, float scale, uint32_t nsamples)
+{
+  uint32_t sample_sz = rf_zmq_tx_sample_sz(q);
+  uint32_t count     = 0;
+
+  while (count < nsamples) {
+    // Start a new message, its payload is allocated by ZMQ so it can be sent without copying it
+    if (!q->msg_pending) {
+      q->msg_capacity = (q->batch_nsamples) ? q->batch_nsamples : nsamples - count;
+      if (zmq_msg_init_size(&q->msg, (size_t)q->msg_capacity * sample_sz)) {
+        rf_zmq_error(q->id, "[zmq] Error: allocating tx message. %s.\n", zmq_strerror(zmq_errno()));
+        return SRSRAN_ERROR;
+      }
+      q->msg_pending  = true;
+      q->msg_nsamples = 0;
+    }
+
+    // Convert, scale or copy straight into the message
+    uint32_t n   = SRSRAN_MIN(nsamples - count, q->msg_capacity - q->msg_nsamples);
+    uint8_t* dst = (uint8_t*)zmq_msg_data(&q->msg) + (size_t)q->msg_nsamples * sample_sz;
+    if (buffer == NULL) {
+      memset(dst, 0, (size_t)n * sample_sz);
+    } else if (q->sample_format == ZMQ_TYPE_SC16) {
+      srsran_vec_convert_fi((float*)&buffer[count], INT16_MAX * scale, (int16_t*)dst, 2 * n);
+    } else if (scale != 1.0f) {
+      srsran_vec_sc_prod_cfc(&buffer[count], scale, (cf_t*)dst, n);
+    } else {
+      srsran_vec_cf_copy((cf_t*)dst, &buffer[count], n);
+    }
+    q->msg_nsamples += n;
+    count += n;
+
+    if (q->msg_nsamples == q->msg_capacity) {
+      if (rf_zmq_tx_flush(q) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
   // Increment sample counter
   q->nsamples += nsamples;
-  n = nsamples;
 
-clean_exit:
-  return n;
+  return nsamples;
 }
 
 int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts)
@@ -175,7 +217,7 @@ int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts)
 
   if (nsamples > 0) {
     rf_zmq_info(q->id, " - Detected Tx gap of %d samples.\n", nsamples);
-    _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)nsamples);
+    _rf_zmq_tx_baseband(q, NULL, 1.0f, (uint32_t)nsamples);
   }
 
   pthread_mutex_unlock(&q->mutex);
@@ -183,14 +225,14 @@ int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts)
   return (int)nsamples;
 }
 
-int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
+int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, float scale, uint32_t nsamples)
 {
   int n;
 
   pthread_mutex_lock(&q->mutex);
 
   if (q->sample_offset > 0) {
-    _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)q->sample_offset);
+    _rf_zmq_tx_baseband(q, NULL, 1.0f, (uint32_t)q->sample_offset);
     q->sample_offset = 0;
   } else if (q->sample_offset < 0) {
     n = SRSRAN_MIN(-q->sample_offset, nsamples);
@@ -198,11 +240,12 @@ int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
     nsamples -= n;
     q->sample_offset += n;
     if (nsamples == 0) {
+      pthread_mutex_unlock(&q->mutex);
       return n;
     }
   }
 
-  n = _rf_zmq_tx_baseband(q, buffer, nsamples);
+  n = _rf_zmq_tx_baseband(q, buffer, scale, nsamples);
 
   pthread_mutex_unlock(&q->mutex);
 
@@ -222,7 +265,7 @@ int rf_zmq_tx_zeros(rf_zmq_tx_t* q, uint32_t nsamples)
   pthread_mutex_lock(&q->mutex);
 
   rf_zmq_info(q->id, " - Tx %d Zeros.\n", nsamples);
-  _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)nsamples);
+  _rf_zmq_tx_baseband(q, NULL, 1.0f, (uint32_t)nsamples);
 
   pthread_mutex_unlock(&q->mutex);
 
@@ -246,12 +289,10 @@ void rf_zmq_tx_close(rf_zmq_tx_t* q)
 
   pthread_mutex_destroy(&q->mutex);
 
-  if (q->zeros) {
-    free(q->zeros);
-  }
-
-  if (q->temp_buffer_convert) {
-    free(q->temp_buffer_convert);
+  // Samples that did not fill a batch are dropped
+  if (q->msg_pending) {
+    zmq_msg_close(&q->msg);
+    q->msg_pending = false;
   }
 
   if (q->sock) {
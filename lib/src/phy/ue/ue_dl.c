@@ -1407,65 +1407,47 @@ void srsran_ue_dl_gen_ack(const srsran_cell_t*      cell,
   }
 }
 
-int srsran_ue_dl_find_and_decode(srsran_ue_dl_t*     q,
-                                 srsran_dl_sf_cfg_t* sf,
-                                 srsran_ue_dl_cfg_t* cfg,
-                                 srsran_pdsch_cfg_t* pdsch_cfg,
-                                 uint8_t*            data[SRSRAN_MAX_CODEWORDS],
-                                 bool                acks[SRSRAN_MAX_CODEWORDS])
+// Converts the first DCI of the user into a grant and decodes the PDSCH (or PMCH) in the last processed subframe
+static int decode_dl_grant(srsran_ue_dl_t*      q,
+                           srsran_dl_sf_cfg_t*  sf,
+                           srsran_ue_dl_user_t* user,
+                           srsran_pdsch_cfg_t*  pdsch_cfg)
 {
-  int ret = SRSRAN_ERROR;
-
-  srsran_dci_dl_t    dci_dl[SRSRAN_MAX_DCI_MSG] = {};
+  int                ret    = SRSRAN_SUCCESS;
+  srsran_dci_dl_t*   dci_dl = &user->dci_dl[0];
+  uint8_t**          data   = user->data;
   srsran_pmch_cfg_t  pmch_cfg;
   srsran_pdsch_res_t pdsch_res[SRSRAN_MAX_CODEWORDS];
 
   // Use default values for PDSCH decoder
   ZERO_OBJECT(pmch_cfg);
 
-  uint32_t mi_set_len;
-  if (q->cell.frame_type == SRSRAN_TDD && !sf->tdd_config.configured) {
-    mi_set_len = 3;
-  } else {
-    mi_set_len = 1;
+  // Logging
+  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO) {
+    char str[512];
+    srsran_dci_dl_info(dci_dl, str, 512);
+    INFO("PDCCH: %s, snr=%.1f dB", str, q->chest_res.snr_db);
   }
 
-  // Blind search PHICH mi value
-  ret = 0;
-  for (uint32_t i = 0; i < mi_set_len && !ret; i++) {
-    if (mi_set_len == 1) {
-      srsran_ue_dl_set_mi_auto(q);
-    } else {
-      srsran_ue_dl_set_mi_manual(q, i);
-    }
-
-    if ((ret = srsran_ue_dl_decode_fft_estimate(q, sf, cfg)) < 0) {
-      return ret;
-    }
-
-    ret = srsran_ue_dl_find_dl_dci(q, sf, cfg, pdsch_cfg->rnti, dci_dl);
+  // Force known MBSFN grant
+  if (sf->sf_type == SRSRAN_SF_MBSFN) {
+    dci_dl->rnti                    = SRSRAN_MRNTI;
+    dci_dl->alloc_type              = SRSRAN_RA_ALLOC_TYPE0;
+    dci_dl->type0_alloc.rbg_bitmask = 0xffffffff;
+    dci_dl->tb[0].rv                = 0;
+    dci_dl->tb[0].mcs_idx           = 2;
+    dci_dl->format                  = SRSRAN_DCI_FORMAT1;
   }
 
-  if (ret == 1) {
-    // Logging
-    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO) {
-      char str[512];
-      srsran_dci_dl_info(&dci_dl[0], str, 512);
-      INFO("PDCCH: %s, snr=%.1f dB", str, q->chest_res.snr_db);
-    }
-
-    // Force known MBSFN grant
-    if (sf->sf_type == SRSRAN_SF_MBSFN) {
-      dci_dl[0].rnti                    = SRSRAN_MRNTI;
-      dci_dl[0].alloc_type              = SRSRAN_RA_ALLOC_TYPE0;
-      dci_dl[0].type0_alloc.rbg_bitmask = 0xffffffff;
-      dci_dl[0].tb[0].rv                = 0;
-      dci_dl[0].tb[0].mcs_idx           = 2;
-      dci_dl[0].format                  = SRSRAN_DCI_FORMAT1;
+  if (user->new_grant != NULL) {
+    // The user provides the grant, the softbuffers and the RV, e.g. from its HARQ entity
+    if (user->new_grant(user->new_grant_arg, sf, dci_dl, pdsch_cfg, data) < SRSRAN_SUCCESS) {
+      ERROR("Error handling DL grant for rnti=0x%x", dci_dl->rnti);
+      return SRSRAN_ERROR;
     }
-
+  } else {
     // Convert DCI message to DL grant
-    if (srsran_ue_dl_dci_to_pdsch_grant(q, sf, cfg, &dci_dl[0], &pdsch_cfg->grant)) {
+    if (srsran_ue_dl_dci_to_pdsch_grant(q, sf, user->cfg, dci_dl, &pdsch_cfg->grant)) {
       ERROR("Error unpacking DCI");
       return SRSRAN_ERROR;
     }
@@ -1481,40 +1463,141 @@ int srsran_ue_dl_find_and_decode(srsran_ue_dl_t*     q,
         srsran_softbuffer_rx_reset_tbs(pdsch_cfg->softbuffers.rx[i], (uint32_t)pdsch_cfg->grant.tb[i].tbs);
       }
     }
+  }
 
-    bool decode_enable = false;
-    for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
-      if (pdsch_cfg->grant.tb[tb].enabled) {
-        decode_enable         = true;
-        pdsch_res[tb].payload = data[tb];
-        pdsch_res[tb].crc     = false;
-      }
+  bool decode_enable = false;
+  for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
+    if (pdsch_cfg->grant.tb[tb].enabled) {
+      decode_enable         = true;
+      pdsch_res[tb].payload = data[tb];
+      pdsch_res[tb].crc     = false;
     }
+  }
 
-    if (decode_enable) {
-      if (sf->sf_type == SRSRAN_SF_NORM) {
-        if (srsran_ue_dl_decode_pdsch(q, sf, pdsch_cfg, pdsch_res)) {
-          ERROR("ERROR: Decoding PDSCH");
-          ret = -1;
-        }
-      } else {
-        pmch_cfg.pdsch_cfg = *pdsch_cfg;
-        if (srsran_ue_dl_decode_pmch(q, sf, &pmch_cfg, pdsch_res)) {
-          ERROR("Decoding PMCH");
-          ret = -1;
-        }
+  if (decode_enable) {
+    if (sf->sf_type == SRSRAN_SF_NORM) {
+      if (srsran_ue_dl_decode_pdsch(q, sf, pdsch_cfg, pdsch_res)) {
+        ERROR("ERROR: Decoding PDSCH");
+        ret = -1;
+      }
+    } else {
+      pmch_cfg.pdsch_cfg = *pdsch_cfg;
+      if (srsran_ue_dl_decode_pmch(q, sf, &pmch_cfg, pdsch_res)) {
+        ERROR("Decoding PMCH");
+        ret = -1;
       }
     }
+  }
 
+  for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
+    if (pdsch_cfg->grant.tb[tb].enabled) {
+      user->acks[tb] = pdsch_res[tb].crc;
+    }
+  }
+  return ret;
+}
+
+int srsran_ue_dl_find_and_decode(srsran_ue_dl_t*     q,
+                                 srsran_dl_sf_cfg_t* sf,
+                                 srsran_ue_dl_cfg_t* cfg,
+                                 srsran_pdsch_cfg_t* pdsch_cfg,
+                                 uint8_t*            data[SRSRAN_MAX_CODEWORDS],
+                                 bool                acks[SRSRAN_MAX_CODEWORDS])
+{
+  if (pdsch_cfg == NULL || data == NULL || acks == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  srsran_ue_dl_user_t user = {};
+  user.rnti                = pdsch_cfg->rnti;
+  user.ul_rnti             = pdsch_cfg->rnti;
+  user.cfg                 = cfg;
+  user.pdsch_cfg           = pdsch_cfg;
+  for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
+    user.data[tb] = data[tb];
+  }
+
+  int ret = srsran_ue_dl_find_and_decode_multi(q, sf, &user, 1);
+  if (ret > 0) {
     for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
       if (pdsch_cfg->grant.tb[tb].enabled) {
-        acks[tb] = pdsch_res[tb].crc;
+        acks[tb] = user.acks[tb];
       }
     }
   }
   return ret;
 }
 
+int srsran_ue_dl_find_and_decode_multi(srsran_ue_dl_t*      q,
+                                       srsran_dl_sf_cfg_t*  sf,
+                                       srsran_ue_dl_user_t* users,
+                                       uint32_t             nof_users)
+{
+  if (q == NULL || sf == NULL || users == NULL || nof_users == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t mi_set_len;
+  if (q->cell.frame_type == SRSRAN_TDD && !sf->tdd_config.configured) {
+    mi_set_len = 3;
+  } else {
+    mi_set_len = 1;
+  }
+
+  // Blind search PHICH mi value. The control region and the reference signals are common to all users, so they are
+  // processed once per mi value and the search stops at the first value where any user finds a DL grant
+  uint32_t nof_found = 0;
+  for (uint32_t i = 0; i < mi_set_len && nof_found == 0; i++) {
+    if (mi_set_len == 1) {
+      srsran_ue_dl_set_mi_auto(q);
+    } else {
+      srsran_ue_dl_set_mi_manual(q, i);
+    }
+
+    if (srsran_ue_dl_decode_fft_estimate(q, sf, users[0].cfg) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t u = 0; u < nof_users; u++) {
+      srsran_ue_dl_user_t* user = &users[u];
+
+      // Format0 messages found by the DL search are only kept until the next search, collect them right away
+      user->nof_dci_dl = 0;
+      user->nof_dci_ul = 0;
+      if (user->rnti != SRSRAN_INVALID_RNTI) {
+        user->nof_dci_dl = srsran_ue_dl_find_dl_dci(q, sf, user->cfg, user->rnti, user->dci_dl);
+      }
+      if (user->ul_rnti != SRSRAN_INVALID_RNTI) {
+        user->nof_dci_ul = srsran_ue_dl_find_ul_dci(q, sf, user->cfg, user->ul_rnti, user->dci_ul);
+      }
+      if (user->nof_dci_dl < SRSRAN_SUCCESS || user->nof_dci_ul < SRSRAN_SUCCESS) {
+        ERROR("Searching DCI for rnti=0x%x", user->rnti);
+        return SRSRAN_ERROR;
+      }
+      if (user->nof_dci_dl > 0) {
+        nof_found++;
+      }
+    }
+  }
+
+  int nof_decoded = 0;
+  for (uint32_t u = 0; u < nof_users && nof_found > 0; u++) {
+    srsran_ue_dl_user_t* user = &users[u];
+    if (user->nof_dci_dl == 0) {
+      continue;
+    }
+
+    srsran_pdsch_cfg_t* pdsch_cfg = user->pdsch_cfg != NULL ? user->pdsch_cfg : &user->cfg->cfg.pdsch;
+    pdsch_cfg->rnti               = user->dci_dl[0].rnti;
+    if (decode_dl_grant(q, sf, user, pdsch_cfg)) {
+      return SRSRAN_ERROR;
+    }
+    nof_decoded++;
+  }
+
+  return nof_decoded;
+}
+
 void srsran_ue_dl_save_signal(srsran_ue_dl_t* q, srsran_dl_sf_cfg_t* sf, srsran_pdsch_cfg_t* pdsch_cfg)
 {
   uint32_t cfi = sf->cfi;
@@ -234,6 +234,9 @@ void srsran_ue_dl_nr_estimate_fft(srsran_ue_dl_nr_t* q, const srsran_slot_cfg_t*
       srsran_dmrs_pdcch_estimate(&q->dmrs_pdcch[i], slot_cfg, q->sf_symbols[0]);
     }
   }
+
+  // Discard the PDCCH candidates decoded in the previous slot
+  srsran_pdcch_nr_new_slot(&q->pdcch);
 }
 
 static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
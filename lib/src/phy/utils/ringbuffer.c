@@ -205,7 +205,7 @@ int srsran_ringbuffer_read_timed_block(srsran_ringbuffer_t* q, void* p, int nof_
 
     // check nsec wrap-around
     towait.tv_sec = now.tv_sec + timeout_ms / 1000L;
-    long nsec     = now.tv_nsec + ((timeout_ms % 1000U) * 1000UL);
+    long nsec     = now.tv_nsec + ((timeout_ms % 1000U) * 1000000UL);
     towait.tv_sec += nsec / 1000000000L;
     towait.tv_nsec = nsec % 1000000000L;
   }
@@ -299,6 +299,73 @@ int srsran_ringbuffer_read_convert_conj(srsran_ringbuffer_t* q, cf_t* dst_ptr, f
   return nof_samples;
 }
 
+// Converts SC16 to cf_t without an intermediate copy, returns the number of bytes consumed from the buffer
+int srsran_ringbuffer_read_convert_timed(srsran_ringbuffer_t* q,
+                                         cf_t*                dst_ptr,
+                                         float                norm,
+                                         int                  nof_samples,
+                                         int32_t              timeout_ms)
+{
+  int             ret       = SRSRAN_SUCCESS;
+  int             nof_bytes = nof_samples * 2 * sizeof(int16_t);
+  struct timespec towait    = {};
+
+  // Get current time and update timeout
+  if (timeout_ms > 0) {
+    struct timespec now = {};
+    timespec_get(&now, TIME_UTC);
+
+    // check nsec wrap-around
+    towait.tv_sec = now.tv_sec + timeout_ms / 1000L;
+    long nsec     = now.tv_nsec + ((timeout_ms % 1000U) * 1000000UL);
+    towait.tv_sec += nsec / 1000000000L;
+    towait.tv_nsec = nsec % 1000000000L;
+  }
+
+  pthread_mutex_lock(&q->mutex);
+
+  // Wait for having enough samples
+  while (q->count < nof_bytes && q->active && ret == SRSRAN_SUCCESS) {
+    if (timeout_ms > 0) {
+      ret = pthread_cond_timedwait(&q->write_cvar, &q->mutex, &towait);
+    } else {
+      pthread_cond_wait(&q->write_cvar, &q->mutex);
+    }
+  }
+
+  if (ret == ETIMEDOUT) {
+    ret = SRSRAN_ERROR_TIMEOUT;
+  } else if (!q->active) {
+    ret = SRSRAN_SUCCESS;
+  } else if (ret == SRSRAN_SUCCESS) {
+    int16_t* src = (int16_t*)&q->buffer[q->rpm];
+    float*   dst = (float*)dst_ptr;
+
+    if (nof_bytes + q->rpm > q->capacity) {
+      int x = (q->capacity - q->rpm) / sizeof(int16_t);
+      srsran_vec_convert_if(src, norm, dst, x);
+      srsran_vec_convert_if((int16_t*)q->buffer, norm, &dst[x], 2 * nof_samples - x);
+    } else {
+      srsran_vec_convert_if(src, norm, dst, 2 * nof_samples);
+    }
+    q->rpm += nof_bytes;
+    if (q->rpm >= q->capacity) {
+      q->rpm -= q->capacity;
+    }
+    q->count -= nof_bytes;
+    ret = nof_bytes;
+  } else if (ret == EINVAL) {
+    fprintf(stderr, "Error: pthread_cond_timedwait() returned EINVAL, timeout value corrupted.\n");
+    ret = SRSRAN_ERROR;
+  } else {
+    ret = SRSRAN_ERROR;
+  }
+
+  pthread_cond_broadcast(&q->read_cvar);
+  pthread_mutex_unlock(&q->mutex);
+  return ret;
+}
+
 /* For this function, the ring buffer capacity must be multiple of block size */
 int srsran_ringbuffer_read_block(srsran_ringbuffer_t* q, void** p, int nof_bytes, int32_t timeout_ms)
 {
@@ -312,7 +379,7 @@ int srsran_ringbuffer_read_block(srsran_ringbuffer_t* q, void** p, int nof_bytes
 
     // check nsec wrap-around
     towait.tv_sec = now.tv_sec + timeout_ms / 1000L;
-    long nsec     = now.tv_nsec + ((timeout_ms % 1000U) * 1000UL);
+    long nsec     = now.tv_nsec + ((timeout_ms % 1000U) * 1000000UL);
     towait.tv_sec += nsec / 1000000000L;
     towait.tv_nsec = nsec % 1000000000L;
   }
@@ -92,6 +92,70 @@ int test_overflow_write(srsran_ringbuffer_t* q, uint8_t* in, uint8_t* out, int l
   return ret;
 }
 
+int test_convert_read(srsran_ringbuffer_t* q, int len)
+{
+  // Move the read and write pointers so the converted samples wrap around the end of the buffer
+  int      nof_samples = len / 8;
+  int      offset      = (3 * len / 4) & ~3;
+  int16_t* in          = srsran_vec_i16_malloc(2 * nof_samples);
+  cf_t*    out         = srsran_vec_cf_malloc(len);
+  TESTASSERT(srsran_ringbuffer_write(q, NULL, offset) == offset);
+  TESTASSERT(srsran_ringbuffer_read(q, out, offset) == offset);
+
+  for (int i = 0; i < 2 * nof_samples; i++) {
+    in[i] = (int16_t)((i % 2) ? -i * 100 : i * 100);
+  }
+  TESTASSERT(srsran_ringbuffer_write(q, in, 2 * nof_samples * sizeof(int16_t)) == 2 * nof_samples * sizeof(int16_t));
+  TESTASSERT(srsran_ringbuffer_read_convert_timed(q, out, INT16_MAX, nof_samples, 10) ==
+             2 * nof_samples * sizeof(int16_t));
+
+  float* out_f = (float*)out;
+  for (int i = 0; i < 2 * nof_samples; i++) {
+    TESTASSERT(fabsf(out_f[i] - (float)in[i] / INT16_MAX) < 1e-6f);
+  }
+
+  // Nothing left to read, it must time out
+  TESTASSERT(srsran_ringbuffer_read_convert_timed(q, out, INT16_MAX, 1, 10) == SRSRAN_ERROR_TIMEOUT);
+
+  free(in);
+  free(out);
+  return SRSRAN_SUCCESS;
+}
+
+static double elapsed_ms(const struct timespec* start)
+{
+  struct timespec now = {};
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - start->tv_sec) * 1e3 + (now.tv_nsec - start->tv_nsec) * 1e-6;
+}
+
+int test_read_timeout(srsran_ringbuffer_t* q)
+{
+  const int32_t   timeout_ms = 50;
+  uint8_t         out[8]     = {};
+  cf_t            out_cf[1]  = {};
+  void*           out_ptr    = NULL;
+  struct timespec start      = {};
+
+  // The buffer is empty, every timed read must wait for the whole timeout before giving up
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  int ret = srsran_ringbuffer_read_timed(q, out, sizeof(out), timeout_ms);
+  TESTASSERT(ret == SRSRAN_ERROR_TIMEOUT);
+  TESTASSERT(elapsed_ms(&start) >= timeout_ms * 0.9);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  ret = srsran_ringbuffer_read_convert_timed(q, out_cf, INT16_MAX, 1, timeout_ms);
+  TESTASSERT(ret == SRSRAN_ERROR_TIMEOUT);
+  TESTASSERT(elapsed_ms(&start) >= timeout_ms * 0.9);
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  ret = srsran_ringbuffer_read_block(q, &out_ptr, sizeof(out), timeout_ms);
+  TESTASSERT(ret == SRSRAN_ERROR_TIMEOUT);
+  TESTASSERT(elapsed_ms(&start) >= timeout_ms * 0.9);
+
+  return SRSRAN_SUCCESS;
+}
+
 void* write_thread(void* args_)
 {
   int                   res  = 0;
@@ -186,6 +250,18 @@ int main(int argc, char** argv)
   bzero(out, N * 10);
   srsran_ringbuffer_reset(&ring_buf);
 
+  if (test_convert_read(&ring_buf, N) < 0) {
+    printf("Convert read test failed\n");
+    ret = SRSRAN_ERROR;
+  }
+  srsran_ringbuffer_reset(&ring_buf);
+
+  if (test_read_timeout(&ring_buf) < 0) {
+    printf("Timed read test failed\n");
+    ret = SRSRAN_ERROR;
+  }
+  srsran_ringbuffer_reset(&ring_buf);
+
   if (threaded_blocking_test((void*)&thread_in)) {
     printf("Error in multithreaded blocking ringbuffer test\n");
     ret = SRSRAN_ERROR;
@@ -407,6 +407,29 @@ void srsran_vec_convert_if_simd(const int16_t* x, float* z, const float scale, c
   int         i    = 0;
   const float gain = 1.0f / scale;
 
+#ifdef LV_HAVE_AVX512
+  __m512 s512 = _mm512_set1_ps(gain);
+  for (; i < len - 15; i += 16) {
+    __m256i i16 = _mm256_loadu_si256((__m256i*)&x[i]);
+    __m512  fl  = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(i16));
+
+    _mm512_storeu_ps(&z[i], _mm512_mul_ps(fl, s512));
+  }
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX2
+  // Sign-extend 16 samples to 32 bit in two halves, then convert and scale 8 at a time
+  __m256 s256 = _mm256_set1_ps(gain);
+  for (; i < len - 15; i += 16) {
+    __m256i i16 = _mm256_loadu_si256((__m256i*)&x[i]);
+    __m256  lo  = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(i16)));
+    __m256  hi  = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(i16, 1)));
+
+    _mm256_storeu_ps(&z[i], _mm256_mul_ps(lo, s256));
+    _mm256_storeu_ps(&z[i + 8], _mm256_mul_ps(hi, s256));
+  }
+#endif /* LV_HAVE_AVX2 */
+
 #ifdef LV_HAVE_SSE
   __m128 s = _mm_set1_ps(gain);
   if (SRSRAN_IS_ALIGNED(z)) {
@@ -1369,8 +1369,6 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
 
 void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header)
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-
   RlcHexInfo(payload,
              nof_bytes,
              "Rx data PDU segment of SN=%d (%d B), SO=%d, N_li=%d",
@@ -1412,8 +1410,7 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
   segment.header       = header;
 
   // Check if we already have a segment from the same PDU
-  it = rx_segments.find(header.sn);
-  if (rx_segments.end() != it) {
+  if (rx_segments.has_sn(header.sn)) {
     if (header.p) {
       RlcInfo("Status packet requested through polling bit");
       do_status = true;
@@ -1421,15 +1418,15 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
 
     // Add segment to PDU list and check for complete
     // NOTE: MAY MOVE. Preference would be to capture by value, and then move; but header is stack allocated
-    if (add_segment_and_check(&it->second, &segment)) {
-      rx_segments.erase(it);
+    if (add_segment_and_check(&rx_segments[header.sn], &segment)) {
+      rx_segments.remove_pdu(header.sn);
     }
 
   } else {
     // Create new PDU segment list and write to rx_segments
-    rlc_amd_rx_pdu_segments_t pdu;
+    rlc_amd_rx_pdu_segments_t& pdu = rx_segments.add_pdu(header.sn);
+    pdu.segments.set_pool(&rx_segment_pool);
     pdu.segments.push_back(std::move(segment));
-    rx_segments[header.sn] = std::move(pdu);
 
     // Update vr_h
     if (RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_h)) {
@@ -1585,19 +1582,16 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
     // Move the rx_window
     RlcDebug("Erasing SN=%d.", vr_r);
     // also erase any segments of this SN
-    std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-    it = rx_segments.find(vr_r);
-    if (rx_segments.end() != it) {
+    if (rx_segments.has_sn(vr_r)) {
       RlcDebug("Erasing segments of SN=%d", vr_r);
-      std::list<rlc_amd_rx_pdu>::iterator segit;
-      for (segit = it->second.segments.begin(); segit != it->second.segments.end(); ++segit) {
+      for (const rlc_amd_rx_pdu& seg : rx_segments[vr_r].segments) {
         RlcDebug(" Erasing segment of SN=%d SO=%d Len=%d N_li=%d",
-                 segit->header.sn,
-                 segit->header.so,
-                 segit->buf->N_bytes,
-                 segit->header.N_li);
+                 seg.header.sn,
+                 seg.header.so,
+                 seg.buf->N_bytes,
+                 seg.header.N_li);
       }
-      it->second.segments.clear();
+      rx_segments.remove_pdu(vr_r);
     }
     rx_window.remove_pdu(vr_r);
     vr_r  = (vr_r + 1) % MOD;
@@ -1733,14 +1727,15 @@ int rlc_am_lte_rx::get_status_pdu_length()
 
 void rlc_am_lte_rx::print_rx_segments()
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-  std::stringstream                                       ss;
+  if (not logger.debug.enabled()) {
+    return;
+  }
+  std::stringstream ss;
   ss << "rx_segments:" << std::endl;
-  for (it = rx_segments.begin(); it != rx_segments.end(); it++) {
-    std::list<rlc_amd_rx_pdu>::iterator segit;
-    for (segit = it->second.segments.begin(); segit != it->second.segments.end(); segit++) {
-      ss << "    SN=" << segit->header.sn << " SO:" << segit->header.so << " N:" << segit->buf->N_bytes
-         << " N_li: " << segit->header.N_li << std::endl;
+  for (const auto& it : rx_segments) {
+    for (const rlc_amd_rx_pdu& seg : it.second.segments) {
+      ss << "    SN=" << seg.header.sn << " SO:" << seg.header.so << " N:" << seg.buf->N_bytes
+         << " N_li: " << seg.header.N_li << std::endl;
     }
   }
   RlcDebug("%s", ss.str().c_str());
@@ -1777,8 +1772,8 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
   }
 
   // Check for complete
-  uint32_t                            so = 0;
-  std::list<rlc_amd_rx_pdu>::iterator it, tmpit;
+  uint32_t                                           so = 0;
+  rlc_segment_list<rlc_amd_rx_pdu>::iterator it, tmpit;
   for (it = pdu->segments.begin(); it != pdu->segments.end(); /* Do not increment */) {
     // Check that there is no gap between last segment and current; overlap allowed
     if (so < it->header.so) {
@@ -210,6 +210,7 @@ uint32_t rlc_am_nr_tx::build_new_pdu(uint8_t* payload, uint32_t nof_bytes)
   // NOTE: from now on, we can't return from this function anymore before increasing tx_next
   rlc_amd_tx_pdu_nr& tx_pdu = tx_window->add_pdu(st.tx_next);
   tx_pdu.pdcp_sn            = tx_sdu->md.pdcp_sn;
+  tx_pdu.segment_list.set_pool(&tx_segment_pool);
   tx_pdu.sdu_buf            = srsran::make_byte_buffer();
   if (tx_pdu.sdu_buf == nullptr) {
     RlcError("Couldn't allocate PDU in %s().", __FUNCTION__);
@@ -676,7 +677,7 @@ uint32_t rlc_am_nr_tx::build_retx_pdu_with_segmentation(rlc_amd_retx_nr_t& retx,
   } else {
     // Retx is already a segment
     // Find current segment in segment list.
-    std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator it;
+    rlc_segment_list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator it;
     for (it = tx_pdu.segment_list.begin(); it != tx_pdu.segment_list.end(); ++it) {
       if (it->so == retx.current_so) {
         break;
@@ -690,9 +691,9 @@ uint32_t rlc_am_nr_tx::build_retx_pdu_with_segmentation(rlc_amd_retx_nr_t& retx,
       seg2.so                             = it->so + retx_pdu_payload_size;
       seg2.payload_len                    = it->payload_len - retx_pdu_payload_size;
 
-      std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator begin_it   = tx_pdu.segment_list.erase(it);
-      std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator insert_it  = tx_pdu.segment_list.insert(begin_it, seg2);
-      std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator insert_it2 = tx_pdu.segment_list.insert(insert_it, seg1);
+      rlc_segment_list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator begin_it   = tx_pdu.segment_list.erase(it);
+      rlc_segment_list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator insert_it  = tx_pdu.segment_list.insert(begin_it, seg2);
+      rlc_segment_list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator insert_it2 = tx_pdu.segment_list.insert(insert_it, seg1);
       RlcDebug("Old segment SN=%d, SO=%d len=%d", retx.sn, retx.current_so, retx.segment_length);
       RlcDebug("New segment SN=%d, SO=%d len=%d", retx.sn, seg1.so, seg1.payload_len);
       RlcDebug("New segment SN=%d, SO=%d len=%d", retx.sn, seg2.so, seg2.payload_len);
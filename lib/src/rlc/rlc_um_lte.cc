@@ -251,9 +251,16 @@ bool rlc_um_lte::rlc_um_lte_rx::configure(const rlc_config_t& cnfg_, std::string
 
   rb_name = rb_name_;
 
-  if (cfg.um.rx_mod == 0) {
-    RlcError("Error configuring RLC UM: rx_mod==0");
-    return false;
+  switch (cfg.um.rx_mod) {
+    case 32:
+      rx_window = std::unique_ptr<rlc_ringbuffer_base<rlc_umd_pdu_t> >(new rlc_ringbuffer_t<rlc_umd_pdu_t, 32>);
+      break;
+    case 1024:
+      rx_window = std::unique_ptr<rlc_ringbuffer_base<rlc_umd_pdu_t> >(new rlc_ringbuffer_t<rlc_umd_pdu_t, 1024>);
+      break;
+    default:
+      RlcError("Error configuring RLC UM: unsupported rx_mod=%d", cfg.um.rx_mod);
+      return false;
   }
 
   // check timer
@@ -298,7 +305,9 @@ void rlc_um_lte::rlc_um_lte_rx::reset()
   rx_sdu.reset();
 
   // Drop all messages in RX window
-  rx_window.clear();
+  if (rx_window != nullptr) {
+    rx_window->clear();
+  }
 }
 
 void rlc_um_lte::rlc_um_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
@@ -313,27 +322,26 @@ void rlc_um_lte::rlc_um_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_b
     return;
   }
 
-  std::map<uint32_t, rlc_umd_pdu_t>::iterator it = rx_window.find(header.sn);
-  if (rx_window.end() != it) {
+  if (rx_window->has_sn(header.sn)) {
     RlcInfo("Discarding duplicate SN=%d", header.sn);
     return;
   }
 
   // Write to rx window
-  rlc_umd_pdu_t pdu = {};
-  pdu.buf           = make_byte_buffer();
-  if (!pdu.buf) {
+  unique_byte_buffer_t buf = make_byte_buffer();
+  if (!buf) {
     RlcError("Discarding packet: no space in buffer pool");
     return;
   }
-  memcpy(pdu.buf->msg, payload, nof_bytes);
-  pdu.buf->N_bytes = nof_bytes;
+  memcpy(buf->msg, payload, nof_bytes);
+  buf->N_bytes = nof_bytes;
   // Strip header from PDU
   int header_len = rlc_um_packed_length(&header);
-  pdu.buf->msg += header_len;
-  pdu.buf->N_bytes -= header_len;
-  pdu.header           = header;
-  rx_window[header.sn] = std::move(pdu);
+  buf->msg += header_len;
+  buf->N_bytes -= header_len;
+  rlc_umd_pdu_t& pdu = rx_window->add_pdu(header.sn);
+  pdu.header         = header;
+  pdu.buf            = std::move(buf);
 
   // Update vr_uh
   if (!inside_reordering_window(header.sn)) {
@@ -376,36 +384,36 @@ void rlc_um_lte::rlc_um_lte_rx::reassemble_rx_sdus()
   while (!inside_reordering_window(vr_ur)) {
     RlcDebug("SN=%d is not inside reordering windows", vr_ur);
 
-    if (rx_window.end() == rx_window.find(vr_ur)) {
+    if (not rx_window->has_sn(vr_ur)) {
       RlcDebug("SN=%d not in rx_window. Reset received SDU", vr_ur);
       rx_sdu->clear();
     } else {
       // Handle any SDU segments
-      for (uint32_t i = 0; i < rx_window[vr_ur].header.N_li; i++) {
-        int len = rx_window[vr_ur].header.li[i];
-        RlcHexDebug(rx_window[vr_ur].buf->msg,
+      for (uint32_t i = 0; i < (*rx_window)[vr_ur].header.N_li; i++) {
+        int len = (*rx_window)[vr_ur].header.li[i];
+        RlcHexDebug((*rx_window)[vr_ur].buf->msg,
                     len,
                     "Handling segment %d/%d of length %d B of SN=%d",
                     i + 1,
-                    rx_window[vr_ur].header.N_li,
+                    (*rx_window)[vr_ur].header.N_li,
                     len,
                     vr_ur);
         // Check if we received a middle or end segment
-        if (rx_sdu->N_bytes == 0 && i == 0 && !rlc_um_start_aligned(rx_window[vr_ur].header.fi)) {
+        if (rx_sdu->N_bytes == 0 && i == 0 && !rlc_um_start_aligned((*rx_window)[vr_ur].header.fi)) {
           RlcWarning("Dropping PDU %d in reassembly due to lost start segment", vr_ur);
           // Advance data pointers and continue with next segment
-          rx_window[vr_ur].buf->msg += len;
-          rx_window[vr_ur].buf->N_bytes -= len;
+          (*rx_window)[vr_ur].buf->msg += len;
+          (*rx_window)[vr_ur].buf->N_bytes -= len;
           rx_sdu->clear();
           metrics.num_lost_pdus++;
           break;
         }
 
-        memcpy(&rx_sdu->msg[rx_sdu->N_bytes], rx_window[vr_ur].buf->msg, len);
+        memcpy(&rx_sdu->msg[rx_sdu->N_bytes], (*rx_window)[vr_ur].buf->msg, len);
         rx_sdu->N_bytes += len;
-        rx_window[vr_ur].buf->msg += len;
-        rx_window[vr_ur].buf->N_bytes -= len;
-        if ((pdu_lost && !rlc_um_start_aligned(rx_window[vr_ur].header.fi)) ||
+        (*rx_window)[vr_ur].buf->msg += len;
+        (*rx_window)[vr_ur].buf->N_bytes -= len;
+        if ((pdu_lost && !rlc_um_start_aligned((*rx_window)[vr_ur].header.fi)) ||
             (vr_ur != ((vr_ur_in_rx_sdu + 1) % cfg.um.rx_mod))) {
           RlcWarning("Dropping remainder of lost PDU (lower edge middle segments, vr_ur=%d, vr_ur_in_rx_sdu=%d)",
                      vr_ur,
@@ -432,17 +440,17 @@ void rlc_um_lte::rlc_um_lte_rx::reassemble_rx_sdus()
       }
 
       // Handle last segment
-      if (rx_sdu->N_bytes > 0 || rlc_um_start_aligned(rx_window[vr_ur].header.fi)) {
+      if (rx_sdu->N_bytes > 0 || rlc_um_start_aligned((*rx_window)[vr_ur].header.fi)) {
         RlcInfo("Writing last segment in SDU buffer. Lower edge vr_ur=%d, Buffer size=%d, segment size=%d",
                 vr_ur,
                 rx_sdu->N_bytes,
-                rx_window[vr_ur].buf->N_bytes);
+                (*rx_window)[vr_ur].buf->N_bytes);
 
-        memcpy(&rx_sdu->msg[rx_sdu->N_bytes], rx_window[vr_ur].buf->msg, rx_window[vr_ur].buf->N_bytes);
-        rx_sdu->N_bytes += rx_window[vr_ur].buf->N_bytes;
+        memcpy(&rx_sdu->msg[rx_sdu->N_bytes], (*rx_window)[vr_ur].buf->msg, (*rx_window)[vr_ur].buf->N_bytes);
+        rx_sdu->N_bytes += (*rx_window)[vr_ur].buf->N_bytes;
         vr_ur_in_rx_sdu = vr_ur;
-        if (rlc_um_end_aligned(rx_window[vr_ur].header.fi)) {
-          if (pdu_lost && !rlc_um_start_aligned(rx_window[vr_ur].header.fi)) {
+        if (rlc_um_end_aligned((*rx_window)[vr_ur].header.fi)) {
+          if (pdu_lost && !rlc_um_start_aligned((*rx_window)[vr_ur].header.fi)) {
             RlcWarning("Dropping remainder of lost PDU (lower edge last segments)");
             rx_sdu->clear();
             metrics.num_lost_pdus++;
@@ -467,14 +475,14 @@ void rlc_um_lte::rlc_um_lte_rx::reassemble_rx_sdus()
       }
 
       // Clean up rx_window
-      rx_window.erase(vr_ur);
+      rx_window->remove_pdu(vr_ur);
     }
 
     vr_ur = (vr_ur + 1) % cfg.um.rx_mod;
   }
 
   // Now update vr_ur until we reach an SN we haven't yet received
-  while (rx_window.end() != rx_window.find(vr_ur)) {
+  while (rx_window->has_sn(vr_ur)) {
     RlcDebug("Reassemble loop for vr_ur=%d", vr_ur);
 
     if (not pdu_belongs_to_rx_sdu()) {
@@ -484,30 +492,30 @@ void rlc_um_lte::rlc_um_lte_rx::reassemble_rx_sdus()
     }
 
     // Handle any SDU segments
-    for (uint32_t i = 0; i < rx_window[vr_ur].header.N_li; i++) {
-      uint16_t len = rx_window[vr_ur].header.li[i];
+    for (uint32_t i = 0; i < (*rx_window)[vr_ur].header.N_li; i++) {
+      uint16_t len = (*rx_window)[vr_ur].header.li[i];
       RlcDebug("Handling SDU segment i=%d with len=%d of vr_ur=%d N_li=%d [%s]",
                i,
                len,
                vr_ur,
-               rx_window[vr_ur].header.N_li,
-               rlc_fi_field_text[rx_window[vr_ur].header.fi]);
+               (*rx_window)[vr_ur].header.N_li,
+               rlc_fi_field_text[(*rx_window)[vr_ur].header.fi]);
       // Check if the first part of the PDU is a middle or end segment
-      if (rx_sdu->N_bytes == 0 && i == 0 && !rlc_um_start_aligned(rx_window[vr_ur].header.fi)) {
+      if (rx_sdu->N_bytes == 0 && i == 0 && !rlc_um_start_aligned((*rx_window)[vr_ur].header.fi)) {
         RlcHexInfo(
-            rx_window[vr_ur].buf->msg, len, "Dropping first %d B of SN=%d due to lost start segment", len, vr_ur);
+            (*rx_window)[vr_ur].buf->msg, len, "Dropping first %d B of SN=%d due to lost start segment", len, vr_ur);
 
-        if (rx_window[vr_ur].buf->N_bytes < len) {
+        if ((*rx_window)[vr_ur].buf->N_bytes < len) {
           RlcError("Dropping remaining remainder of SN=%d too (N_bytes=%u < len=%d)",
                    vr_ur,
-                   rx_window[vr_ur].buf->N_bytes,
+                   (*rx_window)[vr_ur].buf->N_bytes,
                    len);
           goto clean_up_rx_window;
         }
 
         // Advance data pointers and continue with next segment
-        rx_window[vr_ur].buf->msg += len;
-        rx_window[vr_ur].buf->N_bytes -= len;
+        (*rx_window)[vr_ur].buf->msg += len;
+        (*rx_window)[vr_ur].buf->N_bytes -= len;
         rx_sdu->clear();
         metrics.num_lost_pdus++;
 
@@ -528,27 +536,27 @@ void rlc_um_lte::rlc_um_lte_rx::reassemble_rx_sdus()
       }
 
       if (not pdu_belongs_to_rx_sdu()) {
-        RlcHexInfo(rx_window[vr_ur].buf->msg, len, "Copying first %d bytes of new SDU", len);
+        RlcHexInfo((*rx_window)[vr_ur].buf->msg, len, "Copying first %d bytes of new SDU", len);
         RlcInfo("Updating vr_ur_in_rx_sdu. old=%d, new=%d", vr_ur_in_rx_sdu, vr_ur);
         vr_ur_in_rx_sdu = vr_ur;
       } else {
-        RlcHexInfo(rx_window[vr_ur].buf->msg,
+        RlcHexInfo((*rx_window)[vr_ur].buf->msg,
                    len,
                    "Concatenating %d bytes in to current length %d. rx_window remaining bytes=%d, "
                    "vr_ur_in_rx_sdu=%d, vr_ur=%d, rx_mod=%d, last_mod=%d",
                    len,
                    rx_sdu->N_bytes,
-                   rx_window[vr_ur].buf->N_bytes,
+                   (*rx_window)[vr_ur].buf->N_bytes,
                    vr_ur_in_rx_sdu,
                    vr_ur,
                    cfg.um.rx_mod,
                    (vr_ur_in_rx_sdu + 1) % cfg.um.rx_mod);
       }
 
-      memcpy(&rx_sdu->msg[rx_sdu->N_bytes], rx_window[vr_ur].buf->msg, len);
+      memcpy(&rx_sdu->msg[rx_sdu->N_bytes], (*rx_window)[vr_ur].buf->msg, len);
       rx_sdu->N_bytes += len;
-      rx_window[vr_ur].buf->msg += len;
-      rx_window[vr_ur].buf->N_bytes -= len;
+      (*rx_window)[vr_ur].buf->msg += len;
+      (*rx_window)[vr_ur].buf->N_bytes -= len;
       vr_ur_in_rx_sdu = vr_ur;
 
       if (pdu_belongs_to_rx_sdu()) {
@@ -571,16 +579,16 @@ void rlc_um_lte::rlc_um_lte_rx::reassemble_rx_sdus()
                    vr_ur,
                    vr_ur_in_rx_sdu);
         // Advance data pointers and continue with next segment
-        rx_window[vr_ur].buf->msg += len;
-        rx_window[vr_ur].buf->N_bytes -= len;
+        (*rx_window)[vr_ur].buf->msg += len;
+        (*rx_window)[vr_ur].buf->N_bytes -= len;
         metrics.num_lost_pdus++;
       }
       pdu_lost = false;
     }
 
     // Handle last segment
-    if (rx_sdu->N_bytes == 0 && rx_window[vr_ur].header.N_li == 0 &&
-        !rlc_um_start_aligned(rx_window[vr_ur].header.fi)) {
+    if (rx_sdu->N_bytes == 0 && (*rx_window)[vr_ur].header.N_li == 0 &&
+        !rlc_um_start_aligned((*rx_window)[vr_ur].header.fi)) {
       RlcWarning("Dropping PDU %d during last segment handling due to lost start segment", vr_ur);
       rx_sdu->clear();
       metrics.num_lost_pdus++;
@@ -588,27 +596,27 @@ void rlc_um_lte::rlc_um_lte_rx::reassemble_rx_sdus()
     }
 
     if (rx_sdu->N_bytes < SRSRAN_MAX_BUFFER_SIZE_BYTES &&
-        rx_window[vr_ur].buf->N_bytes < SRSRAN_MAX_BUFFER_SIZE_BYTES &&
-        rx_window[vr_ur].buf->N_bytes + rx_sdu->N_bytes < SRSRAN_MAX_BUFFER_SIZE_BYTES) {
-      RlcHexInfo(rx_window[vr_ur].buf->msg,
-                 rx_window[vr_ur].buf->N_bytes,
+        (*rx_window)[vr_ur].buf->N_bytes < SRSRAN_MAX_BUFFER_SIZE_BYTES &&
+        (*rx_window)[vr_ur].buf->N_bytes + rx_sdu->N_bytes < SRSRAN_MAX_BUFFER_SIZE_BYTES) {
+      RlcHexInfo((*rx_window)[vr_ur].buf->msg,
+                 (*rx_window)[vr_ur].buf->N_bytes,
                  "Writing last segment in SDU buffer. Updating vr_ur=%d, vr_ur_in_rx_sdu=%d, Buffer size=%d, "
                  "segment size=%d",
                  vr_ur,
                  vr_ur_in_rx_sdu,
                  rx_sdu->N_bytes,
-                 rx_window[vr_ur].buf->N_bytes);
-      memcpy(&rx_sdu->msg[rx_sdu->N_bytes], rx_window[vr_ur].buf->msg, rx_window[vr_ur].buf->N_bytes);
-      rx_sdu->N_bytes += rx_window[vr_ur].buf->N_bytes;
+                 (*rx_window)[vr_ur].buf->N_bytes);
+      memcpy(&rx_sdu->msg[rx_sdu->N_bytes], (*rx_window)[vr_ur].buf->msg, (*rx_window)[vr_ur].buf->N_bytes);
+      rx_sdu->N_bytes += (*rx_window)[vr_ur].buf->N_bytes;
     } else {
       RlcError("Out of bounds while reassembling SDU buffer in UM: sdu_len=%d, window_buffer_len=%d, vr_ur=%d",
                rx_sdu->N_bytes,
-               rx_window[vr_ur].buf->N_bytes,
+               (*rx_window)[vr_ur].buf->N_bytes,
                vr_ur);
     }
     vr_ur_in_rx_sdu = vr_ur;
-    if (rlc_um_end_aligned(rx_window[vr_ur].header.fi)) {
-      if (pdu_lost && !rlc_um_start_aligned(rx_window[vr_ur].header.fi)) {
+    if (rlc_um_end_aligned((*rx_window)[vr_ur].header.fi)) {
+      if (pdu_lost && !rlc_um_start_aligned((*rx_window)[vr_ur].header.fi)) {
         RlcWarning("Dropping remainder of lost PDU (update vr_ur last segments)");
         rx_sdu->clear();
         metrics.num_lost_pdus++;
@@ -633,7 +641,7 @@ void rlc_um_lte::rlc_um_lte_rx::reassemble_rx_sdus()
 
   clean_up_rx_window:
     // Clean up rx_window
-    rx_window.erase(vr_ur);
+    rx_window->remove_pdu(vr_ur);
 
     vr_ur = (vr_ur + 1) % cfg.um.rx_mod;
   }
@@ -653,7 +661,7 @@ bool rlc_um_lte::rlc_um_lte_rx::pdu_belongs_to_rx_sdu()
 // 36.322 Section 5.1.2.2.1
 bool rlc_um_lte::rlc_um_lte_rx::inside_reordering_window(uint16_t sn)
 {
-  if (cfg.um.rx_window_size == 0 || rx_window.empty()) {
+  if (cfg.um.rx_window_size == 0 || rx_window->empty()) {
     return true;
   }
   if (RX_MOD_BASE(vr_uh - cfg.um.rx_window_size) <= RX_MOD_BASE(sn) && RX_MOD_BASE(sn) < RX_MOD_BASE(vr_uh)) {
@@ -261,6 +261,15 @@ bool rlc_um_nr::rlc_um_nr_rx::configure(const rlc_config_t& cnfg_, std::string r
   mod            = (cfg.um_nr.sn_field_length == rlc_um_nr_sn_size_t::size6bits) ? 64 : 4096;
   UM_Window_Size = (cfg.um_nr.sn_field_length == rlc_um_nr_sn_size_t::size6bits) ? 32 : 2048;
 
+  // Stored SNs always lie inside the reassembly window, a ring of mod entries keeps the slot equal to the SN
+  if (cfg.um_nr.sn_field_length == rlc_um_nr_sn_size_t::size6bits) {
+    rx_window = std::unique_ptr<rlc_ringbuffer_base<rlc_umd_pdu_segments_nr_t> >(
+        new rlc_ringbuffer_t<rlc_umd_pdu_segments_nr_t, 64>);
+  } else {
+    rx_window = std::unique_ptr<rlc_ringbuffer_base<rlc_umd_pdu_segments_nr_t> >(
+        new rlc_ringbuffer_t<rlc_umd_pdu_segments_nr_t, 4096>);
+  }
+
   rb_name = rb_name_;
 
   // check timer
@@ -294,7 +303,9 @@ void rlc_um_nr::rlc_um_nr_rx::reset()
   rx_sdu.reset();
 
   // Drop all messages in RX window
-  rx_window.clear();
+  if (rx_window != nullptr) {
+    rx_window->clear();
+  }
 
   // stop timer
   if (reassembly_timer.is_valid()) {
@@ -330,11 +341,11 @@ void rlc_um_nr::rlc_um_nr_rx::timer_expired(uint32_t timeout_id)
     }
 
     // discard all segments with SN < updated RX_Next_Reassembly
-    for (auto it = rx_window.begin(); it != rx_window.end();) {
-      if (RX_MOD_NR_BASE(it->first) < RX_MOD_NR_BASE(RX_Next_Reassembly)) {
-        it = rx_window.erase(it);
-      } else {
-        ++it;
+    for (uint32_t sn = (RX_Next_Highest + mod - UM_Window_Size) % mod;
+         RX_MOD_NR_BASE(sn) < RX_MOD_NR_BASE(RX_Next_Reassembly) and not rx_window->empty();
+         sn = (sn + 1) % mod) {
+      if (rx_window->has_sn(sn)) {
+        rx_window->remove_pdu(sn);
       }
     }
 
@@ -388,54 +399,54 @@ bool rlc_um_nr::rlc_um_nr_rx::has_missing_byte_segment(const uint32_t sn)
 {
   // is at least one missing byte segment of the RLC SDU associated with SN = RX_Next_Reassembly before the last byte of
   // all received segments of this RLC SDU
-  return (rx_window.find(sn) != rx_window.end());
+  return rx_window->has_sn(sn);
 }
 
 // Sect 5.2.2.2.3
 void rlc_um_nr::rlc_um_nr_rx::handle_rx_buffer_update(const uint32_t sn)
 {
-  if (rx_window.find(sn) != rx_window.end()) {
+  if (rx_window->has_sn(sn)) {
     bool sdu_complete = false;
 
     // iterate over received segments and try to assemble full SDU
-    auto& pdu = rx_window.at(sn);
+    auto& pdu = (*rx_window)[sn];
     for (auto it = pdu.segments.begin(); it != pdu.segments.end();) {
       RlcDebug("Have %s segment with SO=%d for SN=%d",
-               to_string_short(it->second.header.si).c_str(),
-               it->second.header.so,
-               it->second.header.sn);
-      if (it->second.header.so == pdu.next_expected_so) {
+               to_string_short(it->header.si).c_str(),
+               it->header.so,
+               it->header.sn);
+      if (it->header.so == pdu.next_expected_so) {
         if (pdu.next_expected_so == 0) {
           if (pdu.sdu == nullptr) {
             // reuse buffer of first segment for final SDU
-            pdu.sdu              = std::move(it->second.buf);
+            pdu.sdu              = std::move(it->buf);
             pdu.next_expected_so = pdu.sdu->N_bytes;
-            RlcDebug("Reusing first segment of SN=%d for final SDU", it->second.header.sn);
+            RlcDebug("Reusing first segment of SN=%d for final SDU", it->header.sn);
             it = pdu.segments.erase(it);
           } else {
             RlcDebug("SDU buffer already allocated. Possible retransmission of first segment.");
-            if (it->second.header.so != pdu.next_expected_so) {
+            if (it->header.so != pdu.next_expected_so) {
               RlcError("Invalid PDU. SO doesn't match. Discarding all segments of SN=%d.", sn);
-              rx_window.erase(sn);
+              rx_window->remove_pdu(sn);
               return;
             }
           }
         } else {
-          if (it->second.buf->N_bytes > pdu.sdu->get_tailroom()) {
+          if (it->buf->N_bytes > pdu.sdu->get_tailroom()) {
             RlcError("Cannot fit RLC PDU in SDU buffer (tailroom=%d, len=%d), dropping both. Erasing SN=%d.",
                      rx_sdu->get_tailroom(),
-                     it->second.buf->N_bytes,
-                     it->second.header.sn);
-            rx_window.erase(sn);
+                     it->buf->N_bytes,
+                     it->header.sn);
+            rx_window->remove_pdu(sn);
             metrics.num_lost_pdus++;
             return;
           }
 
           // add this segment to the end of the SDU buffer
-          memcpy(pdu.sdu->msg + pdu.sdu->N_bytes, it->second.buf->msg, it->second.buf->N_bytes);
-          pdu.sdu->N_bytes += it->second.buf->N_bytes;
-          pdu.next_expected_so += it->second.buf->N_bytes;
-          RlcDebug("Appended SO=%d of SN=%d", it->second.header.so, it->second.header.sn);
+          memcpy(pdu.sdu->msg + pdu.sdu->N_bytes, it->buf->msg, it->buf->N_bytes);
+          pdu.sdu->N_bytes += it->buf->N_bytes;
+          pdu.next_expected_so += it->buf->N_bytes;
+          RlcDebug("Appended SO=%d of SN=%d", it->header.so, it->header.sn);
           it = pdu.segments.erase(it);
 
           if (pdu.next_expected_so == pdu.total_sdu_length) {
@@ -456,18 +467,19 @@ void rlc_um_nr::rlc_um_nr_rx::handle_rx_buffer_update(const uint32_t sn)
       pdcp->write_pdu(lcid, std::move(pdu.sdu));
 
       // delete PDU from rx_window
-      rx_window.erase(sn);
+      rx_window->remove_pdu(sn);
 
       // find next SN in rx buffer
       if (sn == RX_Next_Reassembly) {
-        if (rx_window.empty()) {
+        if (rx_window->empty()) {
           // no further segments received
           RX_Next_Reassembly = RX_Next_Highest;
         } else {
-          for (auto it = rx_window.begin(); it != rx_window.end(); ++it) {
-            RlcDebug("SN=%d has %zd segments", it->first, it->second.segments.size());
-            if (RX_MOD_NR_BASE(it->first) > RX_MOD_NR_BASE(RX_Next_Reassembly)) {
-              RX_Next_Reassembly = it->first;
+          for (uint32_t next_sn = (sn + 1) % mod; RX_MOD_NR_BASE(next_sn) < RX_MOD_NR_BASE(RX_Next_Highest);
+               next_sn = (next_sn + 1) % mod) {
+            if (rx_window->has_sn(next_sn)) {
+              RlcDebug("SN=%d has %zd segments", next_sn, (*rx_window)[next_sn].segments.size());
+              RX_Next_Reassembly = next_sn;
               break;
             }
           }
@@ -477,28 +489,31 @@ void rlc_um_nr::rlc_um_nr_rx::handle_rx_buffer_update(const uint32_t sn)
     } else if (not sn_in_reassembly_window(sn)) {
       // SN outside of rx window
 
-      RX_Next_Highest = (sn + 1) % mod; // update RX_Next_highest
+      uint32_t old_next_highest = RX_Next_Highest;
+      RX_Next_Highest           = (sn + 1) % mod; // update RX_Next_highest
       RlcDebug("Updating RX_Next_Highest=%d", RX_Next_Highest);
 
-      // drop all SNs outside of new rx window
-      for (auto it = rx_window.begin(); it != rx_window.end();) {
-        if (not sn_in_reassembly_window(it->first)) {
+      // drop all SNs outside of new rx window. Stored SNs lie in the old window, so only the part of it that slid out
+      // needs to be visited
+      uint32_t nof_slid = std::min((RX_Next_Highest + mod - old_next_highest) % mod, UM_Window_Size);
+      for (uint32_t i = 0; i < nof_slid; ++i) {
+        uint32_t old_sn = (old_next_highest + mod - UM_Window_Size + i) % mod;
+        if (rx_window->has_sn(old_sn)) {
           RlcInfo("SN=%d outside rx window [%d:%d] - discarding",
-                  it->first,
+                  old_sn,
                   RX_Next_Highest - UM_Window_Size,
                   RX_Next_Highest);
-          it = rx_window.erase(it);
+          rx_window->remove_pdu(old_sn);
           metrics.num_lost_pdus++;
-        } else {
-          ++it;
         }
       }
 
       if (not sn_in_reassembly_window(RX_Next_Reassembly)) {
         // update RX_Next_Reassembly to first SN that has not been reassembled and delivered
-        for (const auto& rx_pdu : rx_window) {
-          if (rx_pdu.first >= RX_MOD_NR_BASE(RX_Next_Highest - UM_Window_Size)) {
-            RX_Next_Reassembly = rx_pdu.first;
+        for (uint32_t next_sn = (RX_Next_Highest + mod - UM_Window_Size) % mod; next_sn != RX_Next_Highest;
+             next_sn = (next_sn + 1) % mod) {
+          if (rx_window->has_sn(next_sn)) {
+            RX_Next_Reassembly = next_sn;
             RlcDebug("Updating RX_Next_Reassembly=%d", RX_Next_Reassembly);
             break;
           }
@@ -538,6 +553,20 @@ inline void rlc_um_nr::rlc_um_nr_rx::update_total_sdu_length(rlc_umd_pdu_segment
   }
 };
 
+// Keep the segments sorted by SO. Like before, a segment whose SO was already received is ignored
+void rlc_um_nr::rlc_um_nr_rx::insert_segment(rlc_umd_pdu_segments_nr_t& pdu_segments, rlc_umd_pdu_nr_t&& rx_pdu)
+{
+  auto it = pdu_segments.segments.begin();
+  while (it != pdu_segments.segments.end() and it->header.so < rx_pdu.header.so) {
+    ++it;
+  }
+  if (it != pdu_segments.segments.end() and it->header.so == rx_pdu.header.so) {
+    RlcDebug("Discarding duplicate segment with SO=%d for SN=%d", rx_pdu.header.so, rx_pdu.header.sn);
+    return;
+  }
+  pdu_segments.segments.insert(it, std::move(rx_pdu));
+}
+
 // Section 5.2.2.2.2
 void rlc_um_nr::rlc_um_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
@@ -565,7 +594,7 @@ void rlc_um_nr::rlc_um_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_byt
     rx_pdu.buf              = rlc_um_nr_strip_pdu_header(header, payload, nof_bytes);
 
     // check if this SN is already present in rx buffer
-    if (rx_window.find(header.sn) == rx_window.end()) {
+    if (not rx_window->has_sn(header.sn)) {
       // first received segment of this SN, add to rx buffer
       RlcHexDebug(rx_pdu.buf->msg,
                   rx_pdu.buf->N_bytes,
@@ -573,10 +602,10 @@ void rlc_um_nr::rlc_um_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_byt
                   to_string_short(header.si).c_str(),
                   header.sn,
                   rx_pdu.buf->N_bytes);
-      rlc_umd_pdu_segments_nr_t pdu_segments = {};
+      rlc_umd_pdu_segments_nr_t& pdu_segments = rx_window->add_pdu(header.sn);
+      pdu_segments.segments.set_pool(&rx_segment_pool);
       update_total_sdu_length(pdu_segments, rx_pdu);
-      pdu_segments.segments.emplace(header.so, std::move(rx_pdu));
-      rx_window[header.sn] = std::move(pdu_segments);
+      pdu_segments.segments.push_back(std::move(rx_pdu));
     } else {
       // other segment for this SN already present, update received data
       RlcHexDebug(rx_pdu.buf->msg,
@@ -586,13 +615,13 @@ void rlc_um_nr::rlc_um_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_byt
                   rx_pdu.header.so,
                   rx_pdu.buf->N_bytes);
 
-      auto& pdu_segments = rx_window.at(header.sn);
+      auto& pdu_segments = (*rx_window)[header.sn];
 
       // calculate total SDU length
       update_total_sdu_length(pdu_segments, rx_pdu);
 
-      // append to list of segments
-      pdu_segments.segments.emplace(header.so, std::move(rx_pdu));
+      // add to list of segments
+      insert_segment(pdu_segments, std::move(rx_pdu));
     }
 
     // handle received segments
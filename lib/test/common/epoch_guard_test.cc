@@ -0,0 +1,128 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/epoch_guard.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+
+struct shared_obj {
+  std::atomic<bool> alive{true};
+  uint32_t          value = 0;
+};
+
+int test_epoch_nested_read_sections()
+{
+  srsran::epoch_domain domain;
+  uint32_t             nof_deleted = 0;
+
+  {
+    srsran::epoch_read_guard outer(domain);
+    {
+      srsran::epoch_read_guard inner(domain);
+      domain.retire([&nof_deleted]() { nof_deleted++; });
+      TESTASSERT(domain.reclaim() == 1);
+    }
+    // TEST: the object is kept while any read section started before its retirement is running
+    TESTASSERT(domain.reclaim() == 1);
+    TESTASSERT(nof_deleted == 0);
+  }
+  TESTASSERT(domain.reclaim() == 0);
+  TESTASSERT(nof_deleted == 1);
+
+  // TEST: read sections started after the retirement don't hold the object
+  domain.retire([&nof_deleted]() { nof_deleted++; });
+  {
+    srsran::epoch_read_guard guard(domain);
+    TESTASSERT(domain.reclaim() == 0);
+    TESTASSERT(nof_deleted == 2);
+  }
+
+  // TEST: synchronize deletes all the retired objects
+  domain.retire([&nof_deleted]() { nof_deleted++; });
+  domain.retire([&nof_deleted]() { nof_deleted++; });
+  domain.synchronize();
+  TESTASSERT(domain.nof_retired() == 0);
+  TESTASSERT(nof_deleted == 4);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_epoch_concurrent_readers()
+{
+  const uint32_t nof_readers = 8, nof_updates = 20000;
+
+  srsran::epoch_domain     domain;
+  std::atomic<shared_obj*> current{new shared_obj{}};
+  std::atomic<bool>        running{true};
+  std::atomic<uint32_t>    nof_dead_reads{0};
+  std::vector<std::thread> readers;
+  std::vector<shared_obj*> deleted;
+  deleted.reserve(nof_updates + 1);
+
+  for (uint32_t i = 0; i < nof_readers; ++i) {
+    readers.emplace_back([&]() {
+      while (running) {
+        srsran::epoch_read_guard guard(domain);
+        shared_obj*              obj = current.load();
+        // the writer keeps replacing the object meanwhile
+        std::this_thread::yield();
+        if (not obj->alive.load()) {
+          nof_dead_reads++;
+        }
+      }
+    });
+  }
+
+  // The deleted objects are only marked, so that reading them after deletion is seen by the test
+  for (uint32_t i = 0; i < nof_updates; ++i) {
+    shared_obj* obj  = new shared_obj{};
+    obj->value       = i;
+    shared_obj* prev = current.exchange(obj);
+    domain.retire([prev, &deleted]() {
+      prev->alive = false;
+      deleted.push_back(prev);
+    });
+    domain.reclaim();
+    if (i % 16 == 0) {
+      std::this_thread::yield();
+    }
+  }
+  running = false;
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  domain.synchronize();
+
+  TESTASSERT(nof_dead_reads == 0);
+  TESTASSERT(deleted.size() == nof_updates);
+  for (shared_obj* obj : deleted) {
+    delete obj;
+  }
+  delete current.load();
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_epoch_nested_read_sections() == SRSRAN_SUCCESS);
+  TESTASSERT(test_epoch_concurrent_readers() == SRSRAN_SUCCESS);
+}
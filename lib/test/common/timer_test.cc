@@ -448,6 +448,40 @@ void timers_test7()
   TESTASSERT(timers.nof_running_timers() == 1 and timers.nof_timers() == 3);
 }
 
+/**
+ * Description:
+ * - check that the number of tics to the next expiry ignores timers beyond the horizon and wheel aliasing
+ */
+void timers_test8()
+{
+  timer_handler timers;
+  size_t        wheel_size = timer_handler::get_wheel_size();
+
+  TESTASSERT(timers.nof_tics_to_next_expiry(100) == 100);
+
+  unique_timer t  = timers.get_unique_timer();
+  unique_timer t2 = timers.get_unique_timer();
+  t.set(10 + wheel_size);
+  t.run();
+  TESTASSERT(timers.nof_tics_to_next_expiry(100) == 100);
+
+  // t2 falls in the same wheel position as t, but expires first
+  t2.set(10);
+  t2.run();
+  TESTASSERT(timers.nof_tics_to_next_expiry(100) == 10);
+  TESTASSERT(timers.nof_tics_to_next_expiry(5) == 5);
+  for (size_t i = 0; i < 9; ++i) {
+    timers.step_all();
+  }
+  TESTASSERT(timers.nof_tics_to_next_expiry(100) == 1);
+  timers.step_all();
+  TESTASSERT(t2.is_expired() and t.is_running());
+
+  // Only t is left, one wheel turn away
+  TESTASSERT(timers.nof_tics_to_next_expiry(100) == 100);
+  TESTASSERT(timers.nof_tics_to_next_expiry(wheel_size) == wheel_size);
+}
+
 int main()
 {
   timers_test1();
@@ -457,6 +491,7 @@ int main()
   timers_test5();
   timers_test6();
   timers_test7();
+  timers_test8();
   printf("Success\n");
   return 0;
 }
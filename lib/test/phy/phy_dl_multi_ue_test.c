@@ -0,0 +1,451 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Schedules several RNTIs in the same subframe and decodes all of them with srsran_ue_dl_find_and_decode_multi(), which
+ * runs the FFT and channel estimation once. The same subframe is also decoded as N independent UEs would do it, to
+ * compare the UE PHY processing time of both approaches. In TDD mode, the UE does not know the UL/DL configuration and
+ * has to blindly search the PHICH mi value, as srsran_ue_dl_find_and_decode() does. The odd users provide their own
+ * grant handler, as a UE with a HARQ entity does.
+ */
+
+#include <srsran/phy/utils/random.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "srsran/srsran.h"
+
+#define MAX_DATABUFFER_SIZE (6144 * 16 * 3 / 8)
+#define MAX_USERS 32
+
+srsran_cell_t cell = {.nof_prb         = 50,
+                      .nof_ports       = 1,
+                      .id              = 1,
+                      .cp              = SRSRAN_CP_NORM,
+                      .phich_resources = SRSRAN_PHICH_R_1,
+                      .phich_length    = SRSRAN_PHICH_NORM};
+
+static uint32_t nof_users     = 8;
+static uint32_t cfi           = 3;
+static uint32_t nof_subframes = 100;
+static uint32_t mcs           = 20;
+static float    snr_db        = NAN; // SNR in dB
+static bool     tdd           = false;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [pusmStv]\n", prog);
+  printf("\t-p cell.nof_prb [Default %d]\n", cell.nof_prb);
+  printf("\t-u number of UEs, up to %d [Default %d]\n", MAX_USERS, nof_users);
+  printf("\t-s number of subframes to simulate [Default %d]\n", nof_subframes);
+  printf("\t-m mcs [Default %d]\n", mcs);
+  printf("\t-S SNR in dB [Default %+.2f]\n", snr_db);
+  printf("\t-t TDD with UL/DL configuration 2, unknown to the UE [Default FDD]\n");
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "pusmStv")) != -1) {
+    switch (opt) {
+      case 'p':
+        cell.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'u':
+        nof_users = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        nof_subframes = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'm':
+        mcs = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'S':
+        snr_db = strtof(argv[optind], NULL);
+        break;
+      case 't':
+        tdd = true;
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (nof_users == 0 || nof_users > MAX_USERS) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+static bool location_is_free(const srsran_dci_location_t* used, uint32_t nof_used, const srsran_dci_location_t* loc)
+{
+  for (uint32_t i = 0; i < nof_used; i++) {
+    // L is the aggregation level index, the candidate spans 2^L CCEs
+    if (loc->ncce < used[i].ncce + (1U << used[i].L) && used[i].ncce < loc->ncce + (1U << loc->L)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void set_ue_dl_cfg(srsran_ue_dl_cfg_t* ue_dl_cfg, srsran_dci_cfg_t* dci_cfg, srsran_softbuffer_rx_t* softbuffer)
+{
+  ZERO_OBJECT(*ue_dl_cfg);
+  ue_dl_cfg->cfg.tm                        = SRSRAN_TM1;
+  ue_dl_cfg->cfg.dci                       = *dci_cfg;
+  ue_dl_cfg->cfg.pdsch.decoder_type        = SRSRAN_MIMO_DECODER_MMSE;
+  ue_dl_cfg->cfg.pdsch.max_nof_iterations  = 10;
+  ue_dl_cfg->cfg.pdsch.softbuffers.rx[0]   = softbuffer;
+  ue_dl_cfg->chest_cfg.filter_coef[0]      = 4;
+  ue_dl_cfg->chest_cfg.filter_coef[1]      = 1;
+  ue_dl_cfg->chest_cfg.filter_type         = SRSRAN_CHEST_FILTER_GAUSS;
+  ue_dl_cfg->chest_cfg.noise_alg           = SRSRAN_NOISE_ALG_REFS;
+  ue_dl_cfg->chest_cfg.estimator_alg       = SRSRAN_ESTIMATOR_ALG_AVERAGE;
+  ue_dl_cfg->chest_cfg.cfo_estimate_enable = false;
+  ue_dl_cfg->chest_cfg.sync_error_enable   = false;
+}
+
+typedef struct {
+  srsran_ue_dl_t*         ue_dl;
+  srsran_ue_dl_cfg_t*     cfg;
+  srsran_softbuffer_rx_t* softbuffer;
+  uint8_t*                data;
+  uint32_t                nof_grants;
+} grant_handler_t;
+
+// Grant handler of the odd users, provides the softbuffer, the RV and the payload buffer of the first TB
+static int handle_new_grant(void*               arg,
+                            srsran_dl_sf_cfg_t* sf,
+                            srsran_dci_dl_t*    dci_dl,
+                            srsran_pdsch_cfg_t* pdsch_cfg,
+                            uint8_t*            data[SRSRAN_MAX_CODEWORDS])
+{
+  grant_handler_t* h = (grant_handler_t*)arg;
+  if (srsran_ue_dl_dci_to_pdsch_grant(h->ue_dl, sf, h->cfg, dci_dl, &pdsch_cfg->grant)) {
+    return SRSRAN_ERROR;
+  }
+  pdsch_cfg->grant.tb[0].rv      = dci_dl->tb[0].rv;
+  pdsch_cfg->grant.tb[1].enabled = false;
+  pdsch_cfg->softbuffers.rx[0]   = h->softbuffer;
+  srsran_softbuffer_rx_reset_tbs(h->softbuffer, (uint32_t)pdsch_cfg->grant.tb[0].tbs);
+  data[0] = h->data;
+  h->nof_grants++;
+  return SRSRAN_SUCCESS;
+}
+
+// Checks the results of one user, returns the number of failures
+static uint32_t check_user(srsran_ue_dl_user_t* user, bool scheduled, uint8_t* data_tx)
+{
+  if (!scheduled) {
+    if (user->nof_dci_dl != 0) {
+      printf("rnti=0x%x: found %d DCI but was not scheduled\n", user->rnti, user->nof_dci_dl);
+      return 1;
+    }
+    return 0;
+  }
+  if (user->nof_dci_dl != 1) {
+    printf("rnti=0x%x: found %d DCI, expected 1\n", user->rnti, user->nof_dci_dl);
+    return 1;
+  }
+  uint32_t tbs = (uint32_t)user->cfg->cfg.pdsch.grant.tb[0].tbs / 8;
+  if (!user->acks[0] || memcmp(data_tx, user->data[0], tbs) != 0) {
+    printf("rnti=0x%x: failed decoding PDSCH, crc=%d\n", user->rnti, user->acks[0]);
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char** argv)
+{
+  srsran_enb_dl_t*        enb_dl                             = srsran_vec_malloc(sizeof(srsran_enb_dl_t));
+  srsran_ue_dl_t*         ue_dl                              = srsran_vec_malloc(sizeof(srsran_ue_dl_t));
+  srsran_random_t         random                             = srsran_random_init(0);
+  srsran_channel_awgn_t   awgn                               = {};
+  cf_t*                   signal_buffer[SRSRAN_MAX_PORTS]    = {};
+  srsran_softbuffer_tx_t  softbuffer_tx[MAX_USERS]           = {};
+  srsran_softbuffer_rx_t  softbuffer_rx[MAX_USERS]           = {};
+  uint8_t*                data_tx[MAX_USERS][SRSRAN_MAX_TB]  = {};
+  uint8_t*                data_rx[MAX_USERS]                 = {};
+  srsran_ue_dl_cfg_t      ue_dl_cfg[MAX_USERS]               = {};
+  srsran_ue_dl_user_t     users[MAX_USERS]                   = {};
+  grant_handler_t         handlers[MAX_USERS]                = {};
+  struct timeval          t[3]                               = {};
+  uint64_t                multi_us = 0, single_us = 0;
+  uint32_t                count_failures = 0, count_tbs = 0, nof_dl_subframes = 0, count_handled = 0;
+
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+  if (tdd) {
+    cell.frame_type = SRSRAN_TDD;
+  }
+
+  if (enb_dl == NULL || ue_dl == NULL) {
+    ERROR("Error allocating eNb/UE DL objects");
+    goto quit;
+  }
+  ZERO_OBJECT(*enb_dl);
+  ZERO_OBJECT(*ue_dl);
+
+  signal_buffer[0] = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB(cell.nof_prb));
+  if (!signal_buffer[0]) {
+    ERROR("Error allocating buffer");
+    goto quit;
+  }
+
+  if (srsran_channel_awgn_init(&awgn, 0x1234) < SRSRAN_SUCCESS) {
+    ERROR("Error AWGN init");
+    goto quit;
+  }
+  if (isnormal(snr_db)) {
+    if (srsran_channel_awgn_set_n0(&awgn, srsran_enb_dl_get_maximum_signal_power_dBfs(cell.nof_prb) - snr_db) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error setting N0");
+      goto quit;
+    }
+  }
+
+  if (srsran_enb_dl_init(enb_dl, signal_buffer, cell.nof_prb) || srsran_enb_dl_set_cell(enb_dl, cell)) {
+    ERROR("Error initiating eNb downlink");
+    goto quit;
+  }
+  if (srsran_ue_dl_init(ue_dl, signal_buffer, cell.nof_prb, 1) || srsran_ue_dl_set_cell(ue_dl, cell)) {
+    ERROR("Error initiating UE downlink");
+    goto quit;
+  }
+
+  srsran_dci_cfg_t dci_cfg = {};
+
+  for (uint32_t u = 0; u < nof_users; u++) {
+    if (srsran_softbuffer_tx_init(&softbuffer_tx[u], cell.nof_prb) ||
+        srsran_softbuffer_rx_init(&softbuffer_rx[u], cell.nof_prb)) {
+      ERROR("Error initiating softbuffers");
+      goto quit;
+    }
+    data_tx[u][0] = srsran_vec_u8_malloc(MAX_DATABUFFER_SIZE);
+    data_rx[u]    = srsran_vec_u8_malloc(MAX_DATABUFFER_SIZE);
+    if (!data_tx[u][0] || !data_rx[u]) {
+      ERROR("Error allocating data");
+      goto quit;
+    }
+
+    set_ue_dl_cfg(&ue_dl_cfg[u], &dci_cfg, &softbuffer_rx[u]);
+    users[u].rnti    = (uint16_t)(0x46 + u);
+    users[u].ul_rnti = users[u].rnti;
+    users[u].cfg     = &ue_dl_cfg[u];
+    users[u].data[0] = data_rx[u];
+
+    if (u % 2) {
+      handlers[u].ue_dl      = ue_dl;
+      handlers[u].cfg        = &ue_dl_cfg[u];
+      handlers[u].softbuffer = &softbuffer_rx[u];
+      handlers[u].data       = data_rx[u];
+      users[u].new_grant     = handle_new_grant;
+      users[u].new_grant_arg = &handlers[u];
+      users[u].data[0]       = NULL;
+    }
+  }
+
+  // Split the RBGs among the users
+  uint32_t P            = srsran_ra_type0_P(cell.nof_prb);
+  uint32_t nof_rbg      = SRSRAN_CEIL(cell.nof_prb, P);
+  uint32_t rbg_per_user = SRSRAN_MAX(1, nof_rbg / nof_users);
+
+  for (uint32_t sf_idx = 0; sf_idx < nof_subframes; sf_idx++) {
+    srsran_dl_sf_cfg_t sf_cfg_dl    = {};
+    sf_cfg_dl.tti                   = sf_idx % 10240;
+    sf_cfg_dl.cfi                   = cfi;
+    sf_cfg_dl.sf_type               = SRSRAN_SF_NORM;
+    sf_cfg_dl.tdd_config.sf_config  = 2;
+    sf_cfg_dl.tdd_config.configured = tdd;
+    if (srsran_sfidx_tdd_type(sf_cfg_dl.tdd_config, sf_cfg_dl.tti % 10) != SRSRAN_TDD_SF_D) {
+      continue;
+    }
+    nof_dl_subframes++;
+
+    // The UE has not received the TDD configuration yet, so it has to find the PHICH mi value blindly
+    srsran_dl_sf_cfg_t sf_cfg_ue    = sf_cfg_dl;
+    sf_cfg_ue.tdd_config.configured = false;
+
+    /*
+     * Run eNodeB: schedule every user with a free PDCCH location and at least one RBG
+     */
+    bool                  scheduled[MAX_USERS] = {};
+    srsran_dci_location_t used[MAX_USERS]      = {};
+    uint32_t              nof_used             = 0;
+
+    srsran_enb_dl_put_base(enb_dl, &sf_cfg_dl);
+    for (uint32_t u = 0; u < nof_users; u++) {
+      uint32_t first_rbg = u * rbg_per_user;
+      if (first_rbg + rbg_per_user > nof_rbg) {
+        continue;
+      }
+
+      srsran_dci_location_t locations[SRSRAN_MAX_CANDIDATES_UE];
+      uint32_t              nof_locations =
+          srsran_pdcch_ue_locations(&enb_dl->pdcch, &sf_cfg_dl, locations, SRSRAN_MAX_CANDIDATES_UE, users[u].rnti);
+
+      srsran_dci_dl_t dci = {};
+      dci.rnti            = users[u].rnti;
+      dci.format          = SRSRAN_DCI_FORMAT1;
+      dci.alloc_type      = SRSRAN_RA_ALLOC_TYPE0;
+      for (uint32_t i = first_rbg; i < first_rbg + rbg_per_user; i++) {
+        dci.type0_alloc.rbg_bitmask |= 1U << (nof_rbg - 1 - i);
+      }
+      dci.tb[0].mcs_idx = mcs;
+      dci.tb[0].rv      = 0;
+      dci.tb[0].ndi     = sf_idx % 2;
+      dci.tb[1].mcs_idx = 0;
+      dci.tb[1].rv      = 1;
+
+      srsran_pdsch_cfg_t pdsch_cfg = {};
+      if (srsran_ra_dl_dci_to_grant(&cell, &sf_cfg_dl, SRSRAN_TM1, false, &dci, &pdsch_cfg.grant)) {
+        ERROR("Computing DL grant sf_idx=%d", sf_idx);
+        goto quit;
+      }
+
+      // Like a real scheduler, skip the allocations that the PBCH/PSS/SSS leave without enough REs
+      float coderate = srsran_coderate(pdsch_cfg.grant.tb[0].tbs, pdsch_cfg.grant.tb[0].nof_bits);
+      if (coderate > 0.93f) {
+        continue;
+      }
+
+      for (uint32_t l = 0; l < nof_locations && !scheduled[u]; l++) {
+        if (location_is_free(used, nof_used, &locations[l])) {
+          dci.location     = locations[l];
+          used[nof_used++] = locations[l];
+          scheduled[u]     = true;
+        }
+      }
+      if (!scheduled[u]) {
+        continue;
+      }
+
+      if (srsran_enb_dl_put_pdcch_dl(enb_dl, &dci_cfg, &dci)) {
+        ERROR("Error putting PDCCH sf_idx=%d", sf_idx);
+        goto quit;
+      }
+
+      pdsch_cfg.softbuffers.tx[0] = &softbuffer_tx[u];
+      pdsch_cfg.rnti              = users[u].rnti;
+      srsran_softbuffer_tx_reset(&softbuffer_tx[u]);
+      srsran_random_byte_vector(random, data_tx[u][0], pdsch_cfg.grant.tb[0].tbs / 8);
+      if (srsran_enb_dl_put_pdsch(enb_dl, &pdsch_cfg, data_tx[u]) < 0) {
+        ERROR("Error putting PDSCH sf_idx=%d", sf_idx);
+        goto quit;
+      }
+    }
+    srsran_enb_dl_gen_signal(enb_dl);
+    srsran_channel_awgn_run_c(&awgn, signal_buffer[0], signal_buffer[0], SRSRAN_SF_LEN_PRB(cell.nof_prb));
+
+    /*
+     * Run UEs sharing the front-end
+     */
+    gettimeofday(&t[1], NULL);
+    if (srsran_ue_dl_find_and_decode_multi(ue_dl, &sf_cfg_ue, users, nof_users) < SRSRAN_SUCCESS) {
+      ERROR("Error decoding users in sf_idx=%d", sf_idx);
+      goto quit;
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    multi_us += (uint64_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+
+    for (uint32_t u = 0; u < nof_users; u++) {
+      count_failures += check_user(&users[u], scheduled[u], data_tx[u][0]);
+      count_tbs += scheduled[u] ? 1 : 0;
+      count_handled += (scheduled[u] && users[u].new_grant != NULL) ? 2 : 0;
+    }
+
+    /*
+     * Run UEs as independent processes would, each one with its own FFT and channel estimation
+     */
+    gettimeofday(&t[1], NULL);
+    for (uint32_t u = 0; u < nof_users; u++) {
+      if (srsran_ue_dl_find_and_decode_multi(ue_dl, &sf_cfg_ue, &users[u], 1) < SRSRAN_SUCCESS) {
+        ERROR("Error decoding rnti=0x%x in sf_idx=%d", users[u].rnti, sf_idx);
+        goto quit;
+      }
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    single_us += (uint64_t)(t[0].tv_sec * 1e6 + t[0].tv_usec);
+
+    for (uint32_t u = 0; u < nof_users; u++) {
+      count_failures += check_user(&users[u], scheduled[u], data_tx[u][0]);
+    }
+  }
+
+  printf("Finished! %d UEs, %d TBs, %d failures.\n", nof_users, count_tbs, count_failures);
+  printf("UE PHY time per subframe: shared front-end %.1f us, one front-end per UE %.1f us (x%.2f)\n",
+         nof_dl_subframes ? (double)multi_us / nof_dl_subframes : 0.0,
+         nof_dl_subframes ? (double)single_us / nof_dl_subframes : 0.0,
+         multi_us ? (double)single_us / multi_us : 0.0);
+
+  // Every grant of the odd users went through their handler, once per decoding approach
+  for (uint32_t u = 1; u < nof_users; u += 2) {
+    count_handled -= handlers[u].nof_grants;
+  }
+  if (count_handled != 0) {
+    printf("Grant handlers were not called for every grant of the odd users\n");
+    count_failures++;
+  }
+
+  if (count_failures == 0 && count_tbs > 0) {
+    ret = SRSRAN_SUCCESS;
+  }
+
+quit:
+  if (enb_dl) {
+    srsran_enb_dl_free(enb_dl);
+    free(enb_dl);
+  }
+  if (ue_dl) {
+    srsran_ue_dl_free(ue_dl);
+    free(ue_dl);
+  }
+  srsran_random_free(random);
+  srsran_channel_awgn_free(&awgn);
+  if (signal_buffer[0]) {
+    free(signal_buffer[0]);
+  }
+  for (uint32_t u = 0; u < nof_users; u++) {
+    srsran_softbuffer_tx_free(&softbuffer_tx[u]);
+    srsran_softbuffer_rx_free(&softbuffer_rx[u]);
+    if (data_tx[u][0]) {
+      free(data_tx[u][0]);
+    }
+    if (data_rx[u]) {
+      free(data_rx[u]);
+    }
+  }
+
+  if (ret) {
+    printf("Error\n");
+  } else {
+    printf("Ok\n");
+  }
+  exit(ret);
+}
@@ -29,9 +29,11 @@
 #include "srsran/rlc/rlc.h"
 #include <boost/program_options.hpp>
 #include <boost/program_options/parsers.hpp>
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
+#include <new>
 #include <pthread.h>
 #include <random>
 
@@ -39,6 +41,24 @@
 #include "srsran/mac/mac_sch_pdu_nr.h"
 
 static std::unique_ptr<srsran::mac_pcap> pcap_handle = nullptr;
+
+// Count heap allocations of the whole process, to spot allocations left in the per-PDU data path
+static std::atomic<uint64_t> nof_heap_allocs{0};
+
+void* operator new(std::size_t sz)
+{
+  nof_heap_allocs.fetch_add(1, std::memory_order_relaxed);
+  void* p = std::malloc(sz);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
 /***********************
  * MAC tester class
  ***********************/
@@ -334,6 +354,7 @@ void stress_test(stress_test_args_t args)
   }
 
   printf("Starting test ... Seed: %u\n", seed);
+  uint64_t allocs_at_start = nof_heap_allocs.load(std::memory_order_relaxed);
 
   tester1.start(7);
   if (!args.single_tx) {
@@ -360,6 +381,7 @@ void stress_test(stress_test_args_t args)
   tester2.stop();
 
   printf("Writers stopped.\n");
+  uint64_t nof_allocs = nof_heap_allocs.load(std::memory_order_relaxed) - allocs_at_start;
 
   mac.stop();
   if (args.write_pcap) {
@@ -376,6 +398,7 @@ void stress_test(stress_test_args_t args)
          metrics.bearer[lcid].num_tx_pdu_bytes,
          metrics.bearer[lcid].num_rx_pdu_bytes);
   rlc_bearer_metrics_print(metrics.bearer[lcid]);
+  uint64_t nof_rx_pdus = metrics.bearer[lcid].num_rx_pdus;
 
   rlc2.get_metrics(metrics, 1);
   printf("RLC2 received %" PRIu64 " SDUs in %ds (%.2f/s), Tx=%" PRIu64 " B, Rx=%" PRIu64 " B\n",
@@ -385,6 +408,13 @@ void stress_test(stress_test_args_t args)
          metrics.bearer[lcid].num_tx_pdu_bytes,
          metrics.bearer[lcid].num_rx_pdu_bytes);
   rlc_bearer_metrics_print(metrics.bearer[lcid]);
+  nof_rx_pdus += metrics.bearer[lcid].num_rx_pdus;
+
+  printf("Processed %" PRIu64 " PDUs (%.2f PDUs/s), %" PRIu64 " heap allocations (%.2f per PDU)\n",
+         nof_rx_pdus,
+         static_cast<double>(nof_rx_pdus) / args.test_duration_sec,
+         nof_allocs,
+         nof_rx_pdus > 0 ? static_cast<double>(nof_allocs) / nof_rx_pdus : 0.0);
 }
 
 int main(int argc, char** argv)
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_RNTI_RCU_MAP_H
+#define SRSENB_RNTI_RCU_MAP_H
+
+#include "common_enb.h"
+#include "rnti_pool.h"
+#include "srsran/common/epoch_guard.h"
+#include <array>
+
+namespace srsenb {
+
+/**
+ * Map of RNTI to UE objects with wait-free lookups, for objects shared between the PHY workers and the stack.
+ * Like rnti_map_t, each RNTI goes to the slot RNTI % SRSENB_MAX_UES. Lookups and iterations must be done inside a read
+ * section of the map epoch domain, and the objects found stay valid until the read section ends. Insertions and
+ * removals are done by a single writer thread. A removed object is deleted once the read sections that may see it
+ * are over, either on removal or on a later call to reclaim().
+ */
+template <typename T>
+class rnti_rcu_map
+{
+  struct node_t {
+    node_t(uint16_t rnti_, unique_rnti_ptr<T> obj_) : rnti(rnti_), obj(std::move(obj_)) {}
+    uint16_t           rnti;
+    unique_rnti_ptr<T> obj;
+  };
+
+public:
+  rnti_rcu_map() = default;
+  rnti_rcu_map(const rnti_rcu_map&) = delete;
+  rnti_rcu_map& operator=(const rnti_rcu_map&) = delete;
+  ~rnti_rcu_map() { clear(); }
+
+  srsran::epoch_domain& epochs() { return epoch_db; }
+
+  /* Reader side, inside a read section */
+  T* find(uint16_t rnti) const
+  {
+    node_t* node = slots[rnti % SRSENB_MAX_UES].load();
+    return (node != nullptr and node->rnti == rnti) ? node->obj.get() : nullptr;
+  }
+  bool contains(uint16_t rnti) const { return find(rnti) != nullptr; }
+
+  /// Calls f(rnti, obj) for every object in the map
+  template <typename F>
+  void for_each(F&& f) const
+  {
+    for (const std::atomic<node_t*>& slot : slots) {
+      node_t* node = slot.load();
+      if (node != nullptr) {
+        f(node->rnti, *node->obj);
+      }
+    }
+  }
+
+  size_t size() const { return count.load(std::memory_order_relaxed); }
+
+  /* Writer side */
+  bool full() const { return size() == SRSENB_MAX_UES; }
+  bool has_space(uint16_t rnti) const { return slots[rnti % SRSENB_MAX_UES].load() == nullptr; }
+
+  /// Publishes the object, once it is fully initialized. Returns nullptr if the RNTI slot is taken
+  T* insert(uint16_t rnti, unique_rnti_ptr<T> obj)
+  {
+    if (not has_space(rnti)) {
+      return nullptr;
+    }
+    node_t* node = new node_t(rnti, std::move(obj));
+    slots[rnti % SRSENB_MAX_UES].store(node);
+    count.fetch_add(1, std::memory_order_relaxed);
+    return node->obj.get();
+  }
+
+  /// Unlinks the object and retires it. Returns false if the RNTI is not in the map
+  bool erase(uint16_t rnti)
+  {
+    std::atomic<node_t*>& slot = slots[rnti % SRSENB_MAX_UES];
+    node_t*               node = slot.load();
+    if (node == nullptr or node->rnti != rnti) {
+      return false;
+    }
+    slot.store(nullptr);
+    count.fetch_sub(1, std::memory_order_relaxed);
+    epoch_db.retire([node]() { delete node; });
+    epoch_db.reclaim();
+    return true;
+  }
+
+  /// Deletes the removed objects that no read section can see anymore. Returns the number of objects left
+  size_t reclaim() { return epoch_db.reclaim(); }
+
+  /// Removes all objects, waiting for the read sections in course to finish
+  void clear()
+  {
+    for (std::atomic<node_t*>& slot : slots) {
+      node_t* node = slot.exchange(nullptr);
+      if (node != nullptr) {
+        epoch_db.retire([node]() { delete node; });
+      }
+    }
+    count.store(0, std::memory_order_relaxed);
+    epoch_db.synchronize();
+  }
+
+private:
+  std::array<std::atomic<node_t*>, SRSENB_MAX_UES> slots = {};
+  std::atomic<size_t>                              count{0};
+  srsran::epoch_domain                             epoch_db;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_RNTI_RCU_MAP_H
@@ -23,10 +23,13 @@
 #define SRSENB_NR_SLOT_WORKER_H
 
 #include "srsran/common/thread_pool.h"
+#include "srsran/common/work_stealing_pool.h"
 #include "srsran/interfaces/gnb_interfaces.h"
 #include "srsran/interfaces/phy_common_interface.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
+#include <condition_variable>
+#include <mutex>
 
 namespace srsenb {
 namespace nr {
@@ -34,7 +37,9 @@ namespace nr {
 /**
  * The slot_worker class handles the PHY processing, UL and DL procedures associated with 1 slot.
  *
- * A slot_worker object is executed by a thread within the thread_pool.
+ * A slot_worker object is executed by a thread within the thread_pool. If a task pool is provided, the PDSCH encoding
+ * and PUSCH decoding of the different UEs within the slot are executed concurrently in its real-time workers, the
+ * slot worker executes pending tasks while it waits for them.
  */
 
 class slot_worker final : public srsran::thread_pool::worker
@@ -66,8 +71,22 @@ public:
     uint32_t                    rf_port          = 0;
     srsran_subcarrier_spacing_t scs              = srsran_subcarrier_spacing_15kHz;
     uint32_t                    pusch_max_its    = 10;
+    bool                        pusch_early_stop = false; ///< LDPC syndrome check and early abort
+    uint32_t                    pusch_abort_its  = 0;     ///< LDPC iterations without progress before abort, 0 default
     float                       pusch_min_snr_dB = -10.0f;
     double                      srate_hz         = 0.0;
+    srsran::work_stealing_pool* task_pool        = nullptr; ///< Intra-slot task pool, set to nullptr for none
+    uint32_t                    nof_task_threads = 0; ///< Threads that can run tasks of the pool, helpers included
+  };
+
+  /**
+   * @brief Slot processing latency metrics
+   */
+  struct metrics_t {
+    uint32_t count  = 0;         ///< Number of processed slots
+    double   avg_us = 0.0;       ///< Average slot processing time in microseconds
+    double   min_us = +INFINITY; ///< Minimum slot processing time in microseconds
+    double   max_us = -INFINITY; ///< Maximum slot processing time in microseconds
   };
 
   slot_worker(srsran::phy_common_interface& common_,
@@ -88,7 +107,42 @@ public:
   uint32_t get_buffer_len();
   void     set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
 
+  /**
+   * @brief Gets the slot processing latency metrics since the worker was initialised
+   */
+  metrics_t get_metrics();
+
 private:
+  /**
+   * @brief Keeps track of the PDSCH or PUSCH lanes in use by the concurrent tasks of a slot, acquire() blocks while
+   * all the lanes are in use
+   */
+  class lane_pool
+  {
+  public:
+    void     set_nof_lanes(uint32_t nof_lanes_) { nof_lanes = nof_lanes_; }
+    uint32_t acquire();
+    void     release(uint32_t lane);
+
+  private:
+    std::mutex              mutex;
+    std::condition_variable cvar;
+    uint32_t                busy      = 0; ///< Bitmap of the lanes in use
+    uint32_t                nof_lanes = 1;
+  };
+
+  /**
+   * @brief PUSCH decoding result, kept until it is reported to the stack in the scheduling order
+   */
+  struct pusch_result_t {
+    stack_interface_phy_nr::pusch_info_t info = {};
+    bool                                 ok   = false;
+    std::array<char, 512>                str  = {};
+  };
+
+  /// Maximum number of lanes, limited by the lane_pool bitmap
+  static const uint32_t MAX_NOF_LANES = 32;
+
   /**
    * @brief Inherited from thread_pool::worker. Function called every slot to run the DL/UL processing
    */
@@ -106,6 +160,17 @@ private:
    */
   bool work_dl();
 
+  /**
+   * @brief Encodes and logs a PDSCH transmission, it can be called concurrently with different lanes
+   * @return True if no error occurs, false otherwise
+   */
+  bool put_pdsch(const stack_interface_phy_nr::pdsch_t& pdsch, uint32_t lane);
+
+  /**
+   * @brief Decodes a PUSCH transmission and formats its log, it can be called concurrently with different lanes
+   */
+  void get_pusch(stack_interface_phy_nr::pusch_t& pusch, pusch_result_t& result, uint32_t lane);
+
   srsran::phy_common_interface& common;
   stack_interface_phy_nr&       stack;
   srslog::basic_logger&         logger;
@@ -122,6 +187,12 @@ private:
   srsran_gnb_ul_t                                gnb_ul      = {};
   std::vector<cf_t*>                             tx_buffer; ///< Baseband transmit buffers
   std::vector<cf_t*>                             rx_buffer; ///< Baseband receive buffers
+  srsran::work_stealing_pool*                    task_pool = nullptr;
+  lane_pool                                      dl_lanes;
+  lane_pool                                      ul_lanes;
+  std::vector<pusch_result_t>                    pusch_results;
+  std::mutex                                     metrics_mutex;
+  metrics_t                                      metrics = {};
   std::mutex mutex; ///< Protect concurrent access from workers (and main process that inits the class)
 };
 
@@ -87,25 +87,29 @@ private:
     void set_sched_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs) override {}
   };
 
-  srsran::phy_common_interface&              common;
-  stack_interface_phy_nr&                    stack;
-  srslog::sink&                              log_sink;
-  srsran::thread_pool                        pool;
-  std::vector<std::unique_ptr<slot_worker> > workers;
-  prach_worker_pool                          prach;
-  uint32_t                                   current_tti = 0; ///< Current TTI, read and write from same thread
-  srslog::basic_logger&                      logger;
-  prach_stack_adaptor_t                      prach_stack_adaptor;
-  uint32_t                                   nof_prach_workers = 0;
-  double                                     srate_hz          = 0.0; ///< Current sampling rate in Hz
+  srsran::phy_common_interface&               common;
+  stack_interface_phy_nr&                     stack;
+  srslog::sink&                               log_sink;
+  srsran::thread_pool                         pool;
+  std::vector<std::unique_ptr<slot_worker> >  workers;
+  std::unique_ptr<srsran::work_stealing_pool> task_pool; ///< Intra-slot task pool shared by all workers
+  prach_worker_pool                           prach;
+  uint32_t                                    current_tti = 0; ///< Current TTI, read and write from same thread
+  srslog::basic_logger&                       logger;
+  prach_stack_adaptor_t                       prach_stack_adaptor;
+  uint32_t                                    nof_prach_workers = 0;
+  double                                      srate_hz          = 0.0; ///< Current sampling rate in Hz
 
 public:
   struct args_t {
     double                 srate_hz          = 0.0;
     uint32_t               nof_phy_threads   = 3;
     uint32_t               nof_prach_workers = 0;
+    uint32_t               nof_slot_threads  = 0; ///< Threads for intra-slot PDSCH/PUSCH processing, 0 for none
     uint32_t               prio              = 52;
     uint32_t               pusch_max_its     = 10;
+    bool                   pusch_early_stop  = false;
+    uint32_t               pusch_abort_its   = 0;
     float                  pusch_min_snr_dB  = -10;
     srsran::phy_log_args_t log               = {};
   };
@@ -121,6 +125,7 @@ public:
   void         start_worker(slot_worker* w);
   void         stop();
   int          set_common_cfg(const phy_interface_rrc_nr::common_cfg_t& common_cfg);
+  void         get_metrics(slot_worker::metrics_t& metrics);
 };
 
 } // namespace nr
@@ -63,6 +63,9 @@ struct phy_args_t {
   float                   max_prach_offset_us = 10;
   uint32_t                pusch_max_its       = 10;
   uint32_t                nr_pusch_max_its    = 10;
+  bool                    nr_pusch_early_stop = false;
+  uint32_t                nr_pusch_abort_its  = 0;
+  uint32_t                nr_nof_slot_threads = 0;
   bool                    pusch_8bit_decoder  = false;
   float                   tx_amplitude        = 1.0f;
   uint32_t                nof_phy_threads     = 1;
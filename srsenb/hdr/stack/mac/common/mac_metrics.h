@@ -22,6 +22,7 @@
 #ifndef SRSENB_MAC_METRICS_H
 #define SRSENB_MAC_METRICS_H
 
+#include "srsran/phy/phch/sch_nr.h"
 #include <cstdint>
 #include <vector>
 
@@ -49,14 +50,16 @@ struct mac_ue_metrics_t {
   float    ul_snr_offset;
 
   // NR-only UL PHY metrics
-  float pusch_sinr;
-  float pucch_sinr;
-  float ul_rssi;
-  float fec_iters;
-  float dl_mcs;
-  int   dl_mcs_samples;
-  float ul_mcs;
-  int   ul_mcs_samples;
+  float    pusch_sinr;
+  float    pucch_sinr;
+  float    ul_rssi;
+  float    fec_iters;
+  float    dl_mcs;
+  int      dl_mcs_samples;
+  float    ul_mcs;
+  int      ul_mcs_samples;
+  uint32_t fec_iters_hist[SRSRAN_SCH_NR_ITER_HIST_SIZE]; ///< PUSCH code blocks per number of LDPC iterations - 1
+  uint32_t fec_cb_aborted;                               ///< PUSCH code blocks given up by the LDPC early abort
 };
 /// MAC misc information for each cc.
 struct mac_cc_info_t {
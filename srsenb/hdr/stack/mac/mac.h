@@ -25,6 +25,7 @@
 #include "sched.h"
 #include "sched_interface.h"
 #include "srsenb/hdr/common/rnti_pool.h"
+#include "srsenb/hdr/common/rnti_rcu_map.h"
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_rr.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/pool/batch_mem_pool.h"
@@ -126,9 +127,11 @@ private:
                 const sched::dl_sched_bc_t& sched_result,
                 unsigned                    cc_idx);
 
-  bool     check_ue_active(uint16_t rnti);
+  ue*      get_active_ue(uint16_t rnti);
+  bool     check_ue_active(uint16_t rnti) { return get_active_ue(rnti) != nullptr; }
   uint16_t allocate_ue(uint32_t enb_cc_idx);
-  bool     is_valid_rnti_unprotected(uint16_t rnti);
+  bool     is_valid_rnti(uint16_t rnti);
+  void     reclaim_ues();
 
   /* helper function for PDCCH orders */
   /**
@@ -142,10 +145,6 @@ private:
 
   srslog::basic_logger& logger;
 
-  // We use a rwlock in MAC to allow multiple workers to access MAC simultaneously. No conflicts will happen since
-  // access for different TTIs
-  pthread_rwlock_t rwlock = {};
-
   // Interaction with PHY
   phy_interface_stack_lte*      phy_h = nullptr;
   rlc_interface_mac*            rlc_h = nullptr;
@@ -158,7 +157,7 @@ private:
   // derived from args
   srsran::task_multiqueue::queue_handle stack_task_queue;
 
-  bool started = false;
+  std::atomic<bool> started{false};
 
   /* Scheduler unit */
   sched                                    scheduler;
@@ -166,10 +165,13 @@ private:
 
   sched_interface::dl_pdu_mch_t mch = {};
 
-  /* Map of active UEs */
-  static const uint16_t            FIRST_RNTI = 0x46;
-  rnti_map_t<unique_rnti_ptr<ue> > ue_db;
-  std::atomic<uint16_t>            ue_counter{0};
+  /* Map of active UEs. The PHY workers and the stack access the UEs inside read sections of the map epoch domain,
+   * which never block. UEs are only added and removed from the stack thread, and a removed UE is deleted once the read
+   * sections that may still use it are over */
+  static const uint16_t FIRST_RNTI = 0x46;
+  rnti_rcu_map<ue>      ue_db;
+  std::atomic<uint16_t> ue_counter{0};
+  bool                  reclaim_pending = false;
 
   uint8_t* assemble_rar(sched_interface::dl_sched_rar_grant_t* grants,
                         uint32_t                               enb_cc_idx,
@@ -214,6 +216,10 @@ private:
   // PDCCH order
   std::vector<sched_interface::dl_sched_po_info_t> pending_po_prachs = {};
 
+  // Code block buffers shared by the softbuffers of all UEs and carriers
+  srsran_softbuffer_pool_t cb_pool_tx = {};
+  srsran_softbuffer_pool_t cb_pool_rx = {};
+
   // Softbuffer pool
   std::unique_ptr<srsran::obj_pool_itf<ue_cc_softbuffers> > softbuffer_pool;
 };
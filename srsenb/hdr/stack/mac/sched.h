@@ -65,6 +65,7 @@ public:
   int dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue) final;
   int dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds = 1) final;
 
+  int dl_ack_pid(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx) final;
   int dl_ack_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack) final;
   int dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info) final;
   int dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value) final;
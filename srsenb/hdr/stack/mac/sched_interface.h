@@ -351,6 +351,13 @@ public:
    */
   virtual int dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds) = 0;
 
+  /**
+   * Find the DL HARQ process that a HARQ-ACK received in tti refers to, without changing its state
+   *
+   * @return HARQ process id, or SRSRAN_ERROR if no DL HARQ process expects a HARQ-ACK in tti
+   */
+  virtual int dl_ack_pid(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx) = 0;
+
   /* DL information */
   virtual int dl_ack_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)        = 0;
   virtual int dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info)                                 = 0;
@@ -78,6 +78,7 @@ public:
    *******************************************************/
 
   const dl_harq_proc&       get_dl_harq(uint32_t idx, uint32_t enb_cc_idx) const;
+  int                       get_ack_pid(tti_point tti_rx, uint32_t enb_cc_idx) const;
   uint16_t                  get_rnti() const { return rnti; }
   std::pair<bool, uint32_t> get_active_cell_index(uint32_t enb_cc_idx) const;
   const ue_cfg_t&           get_ue_cfg() const { return cfg; }
@@ -164,6 +164,12 @@ public:
    */
   std::tuple<uint32_t, int, int> set_ack_info(tti_point tti_rx, uint32_t tb_idx, bool ack);
 
+  /**
+   * Find the DL Harq Proc that an ACK received in tti_rx refers to
+   * @return pid of the DL harq or -1 if none is waiting for this ACK
+   */
+  int get_ack_pid(tti_point tti_rx) const;
+
   //! Get UL Harq for a given tti_tx_ul
   ul_harq_proc* get_ul_harq(tti_point tti_tx_ul);
 
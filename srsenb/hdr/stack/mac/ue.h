@@ -57,7 +57,13 @@ struct ue_cc_softbuffers {
   cc_softbuffer_tx_list_t softbuffer_tx_list;
   cc_softbuffer_rx_list_t softbuffer_rx_list;
 
-  ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_);
+  /// Without pools, every softbuffer holds code blocks for the largest TBS of nof_prb. With pools, code blocks are
+  /// bound to a HARQ process when it starts a new TB, as many as its TBS needs, and returned when it finishes
+  ue_cc_softbuffers(uint32_t                  nof_prb,
+                    uint32_t                  nof_tx_harq_proc_,
+                    uint32_t                  nof_rx_harq_proc_,
+                    srsran_softbuffer_pool_t* tx_pool = nullptr,
+                    srsran_softbuffer_pool_t* rx_pool = nullptr);
   ue_cc_softbuffers(ue_cc_softbuffers&&) noexcept = default;
   ~ue_cc_softbuffers();
   void clear();
@@ -171,6 +177,12 @@ public:
   srsran_softbuffer_tx_t* get_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx);
   srsran_softbuffer_rx_t* get_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti);
 
+  /// Binds the code blocks of a new DL transport block to the softbuffer of its HARQ process
+  srsran_softbuffer_tx_t* new_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx, uint32_t tbs);
+  /// Returns the code blocks of a finished HARQ process to the shared softbuffer pool
+  void release_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx);
+  void release_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti_rx);
+
   uint8_t* request_buffer(uint32_t tti, uint32_t enb_cc_idx, uint32_t len);
   void     process_pdu(srsran::unique_byte_buffer_t pdu, uint32_t ue_cc_idx, uint32_t grant_nof_prbs);
   srsran::unique_byte_buffer_t release_pdu(uint32_t tti, uint32_t enb_cc_idx);
@@ -26,13 +26,16 @@
 #include "srsran/adt/span.h"
 #include "srsran/asn1/rrc/paging.h"
 #include "srsran/common/tti_point.h"
+#include <atomic>
 
 namespace srsenb {
 
 /**
  * Class that handles the buffering of paging records and encoding of PCCH messages.
- * It's thread-safe, and, assuming that threads contend for pending PCCH messages using different subframe indexes,
- * should rarely blocking on mutexes
+ * It's thread-safe. New paging records are pushed to a lock-free queue of the respective paging occasion, so the
+ * S1AP thread never blocks the MAC. The queued records are moved to the PCCH message, which is packed only once, when
+ * the scheduler asks for the paging occasion. The mutex of each paging subframe is only shared among the carriers
+ * reading the PCCH.
  */
 class paging_manager
 {
@@ -45,8 +48,8 @@ public:
     logger(srslog::fetch_basic_logger("RRC"))
   {
     for (subframe_info& sf_obj : sf_pending_pcch) {
-      sf_obj.pending_paging.resize(T);
-      for (pcch_info& pcch : sf_obj.pending_paging) {
+      sf_obj.pending_paging.reset(new pcch_info[T]);
+      for (pcch_info& pcch : srsran::span<pcch_info>(sf_obj.pending_paging.get(), T)) {
         pcch.pcch_msg.msg.set_c1().paging().paging_record_list_present = true;
 
         // Set ETWS/CMAS paging indicators.
@@ -59,6 +62,16 @@ public:
       }
     }
   }
+  paging_manager(const paging_manager&) = delete;
+  paging_manager& operator=(const paging_manager&) = delete;
+  ~paging_manager()
+  {
+    for (subframe_info& sf_obj : sf_pending_pcch) {
+      for (pcch_info& pcch : srsran::span<pcch_info>(sf_obj.pending_paging.get(), T)) {
+        delete pcch.pending_records.exchange(nullptr, std::memory_order_acquire);
+      }
+    }
+  }
 
   /// add new IMSI paging record
   bool add_imsi_paging(uint32_t ueid, srsran::const_byte_span imsi);
@@ -82,23 +95,41 @@ public:
   bool read_pdu_pcch(tti_point tti_tx_dl, const Callable& callable);
 
 private:
+  /// Paging record waiting to be added to the PCCH message of its paging occasion
+  struct paging_record_node {
+    asn1::rrc::paging_record_s record;
+    paging_record_node*        next = nullptr;
+
+    paging_record_node(const asn1::rrc::paging_record_s& record_) : record(record_) {}
+    ~paging_record_node() { delete next; }
+  };
+
   struct pcch_info {
     tti_point                    tti_tx_dl;
     asn1::rrc::pcch_msg_s        pcch_msg;
     srsran::unique_byte_buffer_t pdu;
 
+    /// Multi-producer, single-consumer stack of records that were not packed yet. Producers push with a CAS, the
+    /// consumer takes the whole list at once, which avoids the ABA problem
+    std::atomic<paging_record_node*> pending_records{nullptr};
+    /// Records in "pcch_msg" plus records in "pending_records". Used to reject records beyond ASN1_RRC_MAX_PAGE_REC
+    std::atomic<uint32_t> nof_records{0};
+
     bool is_tx() const { return tti_tx_dl.is_valid(); }
     bool empty() const { return pdu == nullptr; }
     void clear()
     {
       tti_tx_dl = tti_point();
-      pcch_msg.msg.c1().paging().paging_record_list.clear();
+      auto& record_list = pcch_msg.msg.c1().paging().paging_record_list;
+      nof_records.fetch_sub(record_list.size(), std::memory_order_relaxed);
+      record_list.clear();
       pdu.reset();
     }
   };
   const static size_t nof_paging_subframes = 4;
 
   bool add_paging_record(uint32_t ueid, const asn1::rrc::paging_record_s& paging_record);
+  bool pack_pending_records(pcch_info& pending_pcch);
 
   static int get_sf_idx_key(uint32_t sf_idx)
   {
@@ -125,9 +156,9 @@ private:
   srslog::basic_logger& logger;
 
   struct subframe_info {
-    mutable std::mutex        mutex;
-    srsran::deque<pcch_info*> transmitted_pcch;
-    std::vector<pcch_info>    pending_paging;
+    mutable std::mutex           mutex;
+    srsran::deque<pcch_info*>    transmitted_pcch;
+    std::unique_ptr<pcch_info[]> pending_paging;
   };
 
   std::array<subframe_info, nof_paging_subframes> sf_pending_pcch;
@@ -170,32 +201,57 @@ bool paging_manager::add_paging_record(uint32_t ueid, const asn1::rrc::paging_re
   }
   size_t sf_key = static_cast<size_t>(get_sf_idx_key(sf_idx));
 
-  subframe_info&              locked_sf = sf_pending_pcch[sf_key];
-  std::lock_guard<std::mutex> lock(locked_sf.mutex);
-
   size_t     sfn_cycle_idx = ((size_t)T / (size_t)N) * (size_t)(ueid % N);
-  pcch_info& pending_pcch  = locked_sf.pending_paging[sfn_cycle_idx];
-  auto&      record_list   = pending_pcch.pcch_msg.msg.c1().paging().paging_record_list;
+  pcch_info& pending_pcch  = sf_pending_pcch[sf_key].pending_paging[sfn_cycle_idx];
 
-  if (record_list.size() >= ASN1_RRC_MAX_PAGE_REC) {
+  if (pending_pcch.nof_records.fetch_add(1, std::memory_order_relaxed) >= ASN1_RRC_MAX_PAGE_REC) {
+    pending_pcch.nof_records.fetch_sub(1, std::memory_order_relaxed);
     logger.warning("Failed to add new paging record for ueid=%d. Cause: no paging record space left.", ueid);
     return false;
   }
-  if (pending_pcch.is_tx()) {
-    logger.error("Adding Paging records to ueid=%d PCCH that has been already sent but not cleared.", ueid);
-    pending_pcch.clear();
+
+  // Lock-free push. The record is packed in the PCCH message when the paging occasion is scheduled
+  paging_record_node* node = new paging_record_node(paging_record);
+  node->next               = pending_pcch.pending_records.load(std::memory_order_relaxed);
+  while (not pending_pcch.pending_records.compare_exchange_weak(
+      node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
   }
 
+  return true;
+}
+
+/// Moves the queued paging records to the PCCH message and packs it. Called with the subframe mutex locked
+bool paging_manager::pack_pending_records(pcch_info& pending_pcch)
+{
+  paging_record_node* head = pending_pcch.pending_records.exchange(nullptr, std::memory_order_acquire);
+  if (head == nullptr) {
+    return true;
+  }
+
+  // The stack is LIFO, restore the arrival order
+  paging_record_node* ordered = nullptr;
+  while (head != nullptr) {
+    paging_record_node* next = head->next;
+    head->next               = ordered;
+    ordered                  = head;
+    head                     = next;
+  }
+
+  auto& record_list = pending_pcch.pcch_msg.msg.c1().paging().paging_record_list;
+  for (paging_record_node* node = ordered; node != nullptr; node = node->next) {
+    record_list.push_back(node->record);
+  }
+  delete ordered;
+
   if (pending_pcch.pdu == nullptr) {
     pending_pcch.pdu = srsran::make_byte_buffer();
     if (pending_pcch.pdu == nullptr) {
-      logger.warning("Failed to add new paging record for ueid=%d. Cause: No buffers available", ueid);
+      logger.warning("Failed to pack %d paging records. Cause: No buffers available", record_list.size());
+      pending_pcch.clear();
       return false;
     }
   }
 
-  record_list.push_back(paging_record);
-
   asn1::bit_ref bref(pending_pcch.pdu->msg, pending_pcch.pdu->get_tailroom());
   if (pending_pcch.pcch_msg.pack(bref) == asn1::SRSASN_ERROR_ENCODE_FAIL) {
     logger.error("Failed to pack PCCH message");
@@ -228,7 +284,11 @@ size_t paging_manager::pending_pcch_bytes(tti_point tti_tx_dl)
     locked_sf.transmitted_pcch.pop_front();
   }
 
-  const pcch_info& pending_pcch = locked_sf.pending_paging[tti_tx_dl.sfn() % T];
+  pcch_info& pending_pcch = locked_sf.pending_paging[tti_tx_dl.sfn() % T];
+  if (not pending_pcch.is_tx()) {
+    // Records that arrive after the first carrier transmitted this PCCH are kept for the next paging cycle
+    pack_pending_records(pending_pcch);
+  }
   if (pending_pcch.empty()) {
     return 0;
   }
@@ -19,13 +19,13 @@
  *
  */
 
+#include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/ue_interfaces.h"
 #include "srsran/rlc/rlc.h"
 #include "srsran/srslog/srslog.h"
-#include <map>
 
 #ifndef SRSENB_RLC_H
 #define SRSENB_RLC_H
@@ -102,8 +102,8 @@ private:
 
   pthread_rwlock_t rwlock;
 
-  std::map<uint32_t, user_interface> users;
-  std::vector<mch_service_t>         mch_services;
+  rnti_map_t<user_interface> users;
+  std::vector<mch_service_t> mch_services;
 
   mac_interface_rlc*     mac  = nullptr;
   pdcp_interface_rlc*    pdcp = nullptr;
@@ -211,7 +211,18 @@ bool enb::enable_e2_agent(srsenb::e2_interface_metrics* e2_metrics)
     srsran::console("Error creating e2_agent instance.\n");
     return SRSRAN_ERROR;
   }
-  if (tmp_e2_agent->init(args.e2_agent)) {
+  // the E2SM-KPM cells are the ones of the NR stack when it has any, as for the metrics
+  e2_agent_args_t e2_agent_args = args.e2_agent;
+  if (not rrc_nr_cfg.cell_list.empty()) {
+    for (const auto& cell : rrc_nr_cfg.cell_list) {
+      e2_agent_args.cell_ids.push_back(((uint64_t)rrc_nr_cfg.enb_id << 8U) + cell.phy_cell.cell_id);
+    }
+  } else {
+    for (const auto& cell : rrc_cfg.cell_list) {
+      e2_agent_args.cell_ids.push_back(((uint64_t)rrc_cfg.enb_id << 8U) + cell.cell_id);
+    }
+  }
+  if (tmp_e2_agent->init(e2_agent_args)) {
     srsran::console("Error initializing e2_agent client.\n");
     return SRSRAN_ERROR;
   }
@@ -304,6 +304,9 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
+    ("expert.nr_pusch_early_stop", bpo::value<bool>(&args->phy.nr_pusch_early_stop)->default_value(false), "Stop NR LDPC decoding on a zero syndrome and abort code blocks that stop converging.")
+    ("expert.nr_pusch_abort_its", bpo::value<uint32_t>(&args->phy.nr_pusch_abort_its)->default_value(0),   "LDPC iterations without progress before an NR code block is aborted (0 for default).")
+    ("expert.nr_nof_slot_threads", bpo::value<uint32_t>(&args->phy.nr_nof_slot_threads)->default_value(0), "Number of threads for concurrent NR PDSCH/PUSCH processing within a slot.")
   ;
 
   // Positional options - config file location
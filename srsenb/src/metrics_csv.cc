@@ -60,7 +60,14 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
 {
   if (file.is_open() && enb != NULL) {
     if (n_reports == 0) {
-      file << "time;nof_ue;dl_brate;ul_brate;"
+      file << "time;nof_ue;dl_brate;ul_brate;";
+
+      // Add the NR PUSCH code blocks per number of LDPC iterations.
+      for (uint32_t i = 0; i < SRSRAN_SCH_NR_ITER_HIST_SIZE; i++) {
+        file << "nr_ul_ldpc_iter_" << std::to_string(i + 1) << ";";
+      }
+
+      file << "nr_ul_ldpc_aborted;"
               "proc_rmem;proc_rmem_kB;proc_vmem_kB;sys_mem;system_load;thread_count";
 
       // Add the cpus
@@ -99,6 +106,20 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
       file << float_to_string(0, 2);
     }
 
+    // NR LDPC iterations and aborted code blocks, summed up for all UEs
+    uint32_t ldpc_iters_hist[SRSRAN_SCH_NR_ITER_HIST_SIZE] = {};
+    uint32_t ldpc_aborted                                  = 0;
+    for (const mac_ue_metrics_t& ue : metrics.nr_stack.mac.ues) {
+      for (uint32_t i = 0; i < SRSRAN_SCH_NR_ITER_HIST_SIZE; i++) {
+        ldpc_iters_hist[i] += ue.fec_iters_hist[i];
+      }
+      ldpc_aborted += ue.fec_cb_aborted;
+    }
+    for (uint32_t i = 0; i < SRSRAN_SCH_NR_ITER_HIST_SIZE; i++) {
+      file << std::to_string(ldpc_iters_hist[i]) << ";";
+    }
+    file << std::to_string(ldpc_aborted) << ";";
+
     // Write system metrics.
     const srsran::sys_metrics_t& m = metrics.sys;
     file << float_to_string(m.process_realmem, 2);
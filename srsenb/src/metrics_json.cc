@@ -95,13 +95,25 @@ DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
 DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
 
+/// NR UE container metrics, the LDPC iteration list holds the code blocks decoded with index + 1 iterations.
+DECLARE_METRIC("ul_ldpc_aborted", metric_ul_ldpc_aborted, uint32_t, "");
+DECLARE_METRIC("nof_cb", metric_nof_cb, uint32_t, "");
+DECLARE_METRIC_SET("ldpc_iter_container", mset_ldpc_iter_container, metric_nof_cb);
+DECLARE_METRIC_LIST("ul_ldpc_iter_list", mlist_ul_ldpc_iters, std::vector<mset_ldpc_iter_container>);
+DECLARE_METRIC_SET("nr_ue_container",
+                   mset_nr_ue_container,
+                   metric_ue_rnti,
+                   metric_ul_ldpc_aborted,
+                   mlist_ul_ldpc_iters);
+DECLARE_METRIC_LIST("nr_ue_list", mlist_nr_ues, std::vector<mset_nr_ue_container>);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
 
 /// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell, mlist_nr_ues>;
 
 } // namespace
 
@@ -238,6 +250,20 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     }
   }
 
+  // For each NR UE...
+  auto& nr_ue_list = ctx.get<mlist_nr_ues>();
+  nr_ue_list.resize(m.nr_stack.mac.ues.size());
+  for (unsigned i = 0, e = nr_ue_list.size(); i != e; ++i) {
+    const mac_ue_metrics_t& nr_ue = m.nr_stack.mac.ues[i];
+    nr_ue_list[i].write<metric_ue_rnti>(nr_ue.rnti);
+    nr_ue_list[i].write<metric_ul_ldpc_aborted>(nr_ue.fec_cb_aborted);
+    auto& iter_list = nr_ue_list[i].get<mlist_ul_ldpc_iters>();
+    iter_list.resize(SRSRAN_SCH_NR_ITER_HIST_SIZE);
+    for (unsigned j = 0; j != SRSRAN_SCH_NR_ITER_HIST_SIZE; ++j) {
+      iter_list[j].write<metric_nof_cb>(nr_ue.fec_iters_hist[j]);
+    }
+  }
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
@@ -174,6 +174,11 @@ void metrics_stdout::set_metrics_helper(uint32_t                          num_ue
       fmt::print(" {:>3}%", 0);
     }
     fmt::print(" {:>6.6}", float_to_eng_string(mac.ues[i].ul_buffer, 2));
+    if (is_nr) {
+      fmt::print("  {:>4}", mac.ues[i].fec_cb_aborted);
+    } else {
+      fmt::print("  {:>4.4}", "n/a");
+    }
     fmt::print("\n");
   }
 }
@@ -195,10 +200,10 @@ void metrics_stdout::set_metrics(const enb_metrics_t& metrics, const uint32_t pe
   if (++n_reports > 10) {
     n_reports = 0;
     fmt::print("\n");
-    fmt::print(
-        "               -----------------DL----------------|-------------------------UL-------------------------\n");
-    fmt::print(
-        "rat  pci rnti  cqi  ri  mcs  brate   ok  nok  (%) | pusch  pucch  phr  mcs  brate   ok  nok  (%)    bsr\n");
+    fmt::print("               -----------------DL----------------|"
+               "----------------------------UL----------------------------\n");
+    fmt::print("rat  pci rnti  cqi  ri  mcs  brate   ok  nok  (%) |"
+               " pusch  pucch  phr  mcs  brate   ok  nok  (%)    bsr  abrt\n");
   }
 
   set_metrics_helper(metrics.stack.rrc.ues.size(), metrics.stack.mac, metrics.phy, false);
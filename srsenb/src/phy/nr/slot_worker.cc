@@ -22,6 +22,9 @@
 #include "srsenb/hdr/phy/nr/slot_worker.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 
 //#define DEBUG_WRITE_FILE
 
@@ -33,6 +36,23 @@ static uint32_t slots_to_dump = 10;
 
 namespace srsenb {
 namespace nr {
+
+/// Indexes of the transmissions of a slot, sorted by decreasing number of coded bits so the longest tasks start first
+using tx_order_t = std::array<uint32_t, mac_interface_phy_nr::MAX_GRANTS>;
+
+template <typename T>
+static tx_order_t sort_by_size(const T& txs)
+{
+  tx_order_t order = {};
+  for (uint32_t i = 0; i < (uint32_t)txs.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.begin() + txs.size(), [&txs](uint32_t a, uint32_t b) {
+    return txs[a].sch.grant.tb[0].nof_bits > txs[b].sch.grant.tb[0].nof_bits;
+  });
+  return order;
+}
+
 slot_worker::slot_worker(srsran::phy_common_interface& common_,
                          stack_interface_phy_nr&       stack_,
                          sync_interface&               sync_,
@@ -53,6 +73,17 @@ bool slot_worker::init(const args_t& args)
   cell_index = args.cell_index;
   rf_port    = args.rf_port;
 
+  // Select the number of PDSCH/PUSCH lanes, one for each thread that can process a task of this worker concurrently:
+  // the pool workers and the slot workers that run pending tasks while they wait. Beyond the maximum, tasks wait for
+  // a lane to be released
+  task_pool          = args.task_pool;
+  uint32_t nof_lanes = 1;
+  if (task_pool != nullptr) {
+    nof_lanes = std::min(std::max(args.nof_task_threads, 1U), MAX_NOF_LANES);
+  }
+  dl_lanes.set_nof_lanes(nof_lanes);
+  ul_lanes.set_nof_lanes(nof_lanes);
+
   // Allocate Tx buffers
   tx_buffer.resize(args.nof_tx_ports);
   for (uint32_t i = 0; i < args.nof_tx_ports; i++) {
@@ -81,6 +112,7 @@ bool slot_worker::init(const args_t& args)
   dl_args.nof_tx_antennas      = args.nof_tx_ports;
   dl_args.nof_max_prb          = args.nof_max_prb;
   dl_args.srate_hz             = args.srate_hz;
+  dl_args.nof_pdsch_lanes      = nof_lanes - 1;
 
   // Initialise DL
   if (srsran_gnb_dl_init(&gnb_dl, tx_buffer.data(), &dl_args) < SRSRAN_SUCCESS) {
@@ -89,14 +121,17 @@ bool slot_worker::init(const args_t& args)
   }
 
   // Prepare UL arguments
-  srsran_gnb_ul_args_t ul_args   = {};
-  ul_args.pusch.measure_time     = true;
-  ul_args.pusch.measure_evm      = true;
-  ul_args.pusch.max_layers       = args.nof_rx_ports;
-  ul_args.pusch.sch.max_nof_iter = args.pusch_max_its;
-  ul_args.pusch.max_prb          = args.nof_max_prb;
-  ul_args.nof_max_prb            = args.nof_max_prb;
-  ul_args.pusch_min_snr_dB       = args.pusch_min_snr_dB;
+  srsran_gnb_ul_args_t ul_args               = {};
+  ul_args.pusch.measure_time                 = true;
+  ul_args.pusch.measure_evm                  = true;
+  ul_args.pusch.max_layers                   = args.nof_rx_ports;
+  ul_args.pusch.sch.max_nof_iter             = args.pusch_max_its;
+  ul_args.pusch.sch.decoder_early_stop       = args.pusch_early_stop;
+  ul_args.pusch.sch.decoder_early_abort_iter = args.pusch_abort_its;
+  ul_args.pusch.max_prb                      = args.nof_max_prb;
+  ul_args.nof_max_prb                        = args.nof_max_prb;
+  ul_args.pusch_min_snr_dB                   = args.pusch_min_snr_dB;
+  ul_args.nof_pusch_lanes                    = nof_lanes - 1;
 
   // Initialise UL
   if (srsran_gnb_ul_init(&gnb_ul, rx_buffer[0], &ul_args) < SRSRAN_SUCCESS) {
@@ -164,6 +199,52 @@ void slot_worker::set_context(const srsran::phy_common_interface::worker_context
   context.copy(w_ctx);
 }
 
+slot_worker::metrics_t slot_worker::get_metrics()
+{
+  std::lock_guard<std::mutex> lock(metrics_mutex);
+  return metrics;
+}
+
+uint32_t slot_worker::lane_pool::acquire()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  uint32_t                     all_lanes = (nof_lanes < 32) ? ((1U << nof_lanes) - 1U) : UINT32_MAX;
+  while ((busy & all_lanes) == all_lanes) {
+    cvar.wait(lock);
+  }
+
+  uint32_t lane = (uint32_t)__builtin_ctz(~busy);
+  busy |= 1U << lane;
+  return lane;
+}
+
+void slot_worker::lane_pool::release(uint32_t lane)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    busy &= ~(1U << lane);
+  }
+  cvar.notify_one();
+}
+
+void slot_worker::get_pusch(stack_interface_phy_nr::pusch_t& pusch, pusch_result_t& result, uint32_t lane)
+{
+  // Decode PUSCH and extract DMRS information
+  result.ok = srsran_gnb_ul_get_pusch_lane(&gnb_ul,
+                                           lane,
+                                           &ul_slot_cfg,
+                                           &pusch.sch,
+                                           &pusch.sch.grant,
+                                           &result.info.pusch_data,
+                                           &result.info.csi) == SRSRAN_SUCCESS;
+
+  // Format the log while the lane still holds the decoder state
+  if (result.ok and logger.info.enabled()) {
+    srsran_gnb_ul_pusch_lane_info(
+        &gnb_ul, lane, &pusch.sch, &result.info.pusch_data, result.str.data(), (uint32_t)result.str.size());
+  }
+}
+
 bool slot_worker::work_ul()
 {
   stack_interface_phy_nr::ul_sched_t* ul_sched = stack.get_ul_sched(ul_slot_cfg);
@@ -234,48 +315,70 @@ bool slot_worker::work_ul()
     }
   }
 
-  // For each PUSCH...
-  for (stack_interface_phy_nr::pusch_t& pusch : ul_sched->pusch) {
-    // Prepare PUSCH
-    stack_interface_phy_nr::pusch_info_t pusch_info = {};
-    pusch_info.uci_cfg                              = pusch.sch.uci;
-    pusch_info.pid                                  = pusch.pid;
-    pusch_info.rnti                                 = pusch.sch.grant.rnti;
-    pusch_info.pdu                                  = srsran::make_byte_buffer();
+  // Prepare PUSCH
+  pusch_results.resize(ul_sched->pusch.size());
+  for (uint32_t i = 0; i < (uint32_t)ul_sched->pusch.size(); i++) {
+    stack_interface_phy_nr::pusch_t&      pusch      = ul_sched->pusch[i];
+    stack_interface_phy_nr::pusch_info_t& pusch_info = pusch_results[i].info;
+    pusch_info                                       = {};
+    pusch_info.uci_cfg                               = pusch.sch.uci;
+    pusch_info.pid                                   = pusch.pid;
+    pusch_info.rnti                                  = pusch.sch.grant.rnti;
+    pusch_info.pdu                                   = srsran::make_byte_buffer();
     if (pusch_info.pdu == nullptr) {
       logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
       return false;
     }
     pusch_info.pdu->N_bytes             = pusch.sch.grant.tb[0].tbs / 8;
     pusch_info.pusch_data.tb[0].payload = pusch_info.pdu->data();
+  }
 
-    // Decode PUSCH
-    if (srsran_gnb_ul_get_pusch(&gnb_ul, &ul_slot_cfg, &pusch.sch, &pusch.sch.grant, &pusch_info.pusch_data) <
-        SRSRAN_SUCCESS) {
+  // Decode PUSCH, concurrently if there is more than one
+  if (task_pool == nullptr or ul_sched->pusch.size() < 2) {
+    for (uint32_t i = 0; i < (uint32_t)ul_sched->pusch.size(); i++) {
+      get_pusch(ul_sched->pusch[i], pusch_results[i], 0);
+    }
+  } else {
+    srsran::work_stealing_pool::task_group group;
+    tx_order_t                             order = sort_by_size(ul_sched->pusch);
+    for (uint32_t i = 0; i < (uint32_t)ul_sched->pusch.size(); i++) {
+      stack_interface_phy_nr::pusch_t* pusch  = &ul_sched->pusch[order[i]];
+      pusch_result_t*                  result = &pusch_results[order[i]];
+      auto                             task   = [this, pusch, result]() {
+        uint32_t lane = ul_lanes.acquire();
+        get_pusch(*pusch, *result, lane);
+        ul_lanes.release(lane);
+      };
+      // Decode it here if the pool cannot take it
+      if (not task_pool->push_task(group, task)) {
+        task();
+      }
+    }
+    task_pool->wait(group);
+  }
+
+  // Inform stack in the scheduling order
+  for (uint32_t i = 0; i < (uint32_t)ul_sched->pusch.size(); i++) {
+    stack_interface_phy_nr::pusch_t& pusch  = ul_sched->pusch[i];
+    pusch_result_t&                  result = pusch_results[i];
+    if (not result.ok) {
       logger.error("Error getting PUSCH");
       return false;
     }
 
-    // Extract DMRS information
-    pusch_info.csi = gnb_ul.dmrs.csi;
-
-    // Inform stack
-    if (stack.pusch_info(ul_slot_cfg, pusch_info) < SRSRAN_SUCCESS) {
+    if (stack.pusch_info(ul_slot_cfg, result.info) < SRSRAN_SUCCESS) {
       logger.error("Error pushing PUSCH information to stack");
       return false;
     }
 
     // Log PUSCH decoding
     if (logger.info.enabled()) {
-      std::array<char, 512> str;
-      srsran_gnb_ul_pusch_info(&gnb_ul, &pusch.sch, &pusch_info.pusch_data, str.data(), (uint32_t)str.size());
-
       if (logger.debug.enabled()) {
         std::array<char, 1024> str_extra = {};
         srsran_sch_cfg_nr_info(&pusch.sch, str_extra.data(), (uint32_t)str_extra.size());
-        logger.info("PUSCH: %s\n%s", str.data(), str_extra.data());
+        logger.info("PUSCH: %s\n%s", result.str.data(), str_extra.data());
       } else {
-        logger.info("PUSCH: %s", str.data());
+        logger.info("PUSCH: %s", result.str.data());
       }
     }
   }
@@ -283,6 +386,39 @@ bool slot_worker::work_ul()
   return true;
 }
 
+bool slot_worker::put_pdsch(const stack_interface_phy_nr::pdsch_t& pdsch, uint32_t lane)
+{
+  // convert MAC to PHY buffer data structures
+  uint8_t* data[SRSRAN_MAX_TB] = {};
+  for (uint32_t i = 0; i < SRSRAN_MAX_TB; ++i) {
+    if (pdsch.data[i] != nullptr) {
+      data[i] = pdsch.data[i]->msg;
+    }
+  }
+
+  // Put PDSCH message
+  if (srsran_gnb_dl_pdsch_put_lane(&gnb_dl, lane, &dl_slot_cfg, &pdsch.sch, data) < SRSRAN_SUCCESS) {
+    logger.error("PDSCH: Error putting DL message");
+    return false;
+  }
+
+  // Log PDSCH information
+  if (logger.info.enabled()) {
+    std::array<char, 512> str = {};
+    srsran_gnb_dl_pdsch_lane_info(&gnb_dl, lane, &pdsch.sch, str.data(), (uint32_t)str.size());
+
+    if (logger.debug.enabled()) {
+      std::array<char, 1024> str_extra = {};
+      srsran_sch_cfg_nr_info(&pdsch.sch, str_extra.data(), (uint32_t)str_extra.size());
+      logger.info("PDSCH: cc=%d %s tti_tx=%d\n%s", cell_index, str.data(), dl_slot_cfg.idx, str_extra.data());
+    } else {
+      logger.info("PDSCH: cc=%d %s tti_tx=%d", cell_index, str.data(), dl_slot_cfg.idx);
+    }
+  }
+
+  return true;
+}
+
 bool slot_worker::work_dl()
 {
   // The Scheduler interface needs to be called synchronously, wait for the sync to be available
@@ -348,34 +484,35 @@ bool slot_worker::work_dl()
     }
   }
 
-  // Encode PDSCH
-  for (const stack_interface_phy_nr::pdsch_t& pdsch : dl_sched_ptr->pdsch) {
-    // convert MAC to PHY buffer data structures
-    uint8_t* data[SRSRAN_MAX_TB] = {};
-    for (uint32_t i = 0; i < SRSRAN_MAX_TB; ++i) {
-      if (pdsch.data[i] != nullptr) {
-        data[i] = pdsch.data[i]->msg;
+  // Encode PDSCH, concurrently if there is more than one
+  if (task_pool == nullptr or dl_sched_ptr->pdsch.size() < 2) {
+    for (const stack_interface_phy_nr::pdsch_t& pdsch : dl_sched_ptr->pdsch) {
+      if (not put_pdsch(pdsch, 0)) {
+        return false;
       }
     }
-
-    // Put PDSCH message
-    if (srsran_gnb_dl_pdsch_put(&gnb_dl, &dl_slot_cfg, &pdsch.sch, data) < SRSRAN_SUCCESS) {
-      logger.error("PDSCH: Error putting DL message");
-      return false;
+  } else {
+    std::atomic<bool>                      pdsch_ok = {true};
+    srsran::work_stealing_pool::task_group group;
+    tx_order_t                             order = sort_by_size(dl_sched_ptr->pdsch);
+    for (uint32_t i = 0; i < (uint32_t)dl_sched_ptr->pdsch.size(); i++) {
+      const stack_interface_phy_nr::pdsch_t* p    = &dl_sched_ptr->pdsch[order[i]];
+      auto                                   task = [this, p, &pdsch_ok]() {
+        uint32_t lane = dl_lanes.acquire();
+        if (not put_pdsch(*p, lane)) {
+          pdsch_ok = false;
+        }
+        dl_lanes.release(lane);
+      };
+      // Encode it here if the pool cannot take it
+      if (not task_pool->push_task(group, task)) {
+        task();
+      }
     }
+    task_pool->wait(group);
 
-    // Log PDSCH information
-    if (logger.info.enabled()) {
-      std::array<char, 512> str = {};
-      srsran_gnb_dl_pdsch_info(&gnb_dl, &pdsch.sch, str.data(), (uint32_t)str.size());
-
-      if (logger.debug.enabled()) {
-        std::array<char, 1024> str_extra = {};
-        srsran_sch_cfg_nr_info(&pdsch.sch, str_extra.data(), (uint32_t)str_extra.size());
-        logger.info("PDSCH: cc=%d %s tti_tx=%d\n%s", cell_index, str.data(), dl_slot_cfg.idx, str_extra.data());
-      } else {
-        logger.info("PDSCH: cc=%d %s tti_tx=%d", cell_index, str.data(), dl_slot_cfg.idx);
-      }
+    if (not pdsch_ok) {
+      return false;
     }
   }
 
@@ -403,6 +540,8 @@ bool slot_worker::work_dl()
 
 void slot_worker::work_imp()
 {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
   // Inform Scheduler about new slot
   stack.slot_indication(dl_slot_cfg);
 
@@ -429,6 +568,16 @@ void slot_worker::work_imp()
     return;
   }
 
+  // Account slot processing latency, excluding the wait for the transmission order
+  double elapsed_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  {
+    std::lock_guard<std::mutex> lock(metrics_mutex);
+    metrics.avg_us = SRSRAN_VEC_CMA(elapsed_us, metrics.avg_us, metrics.count);
+    metrics.min_us = SRSRAN_MIN(metrics.min_us, elapsed_us);
+    metrics.max_us = SRSRAN_MAX(metrics.max_us, elapsed_us);
+    metrics.count++;
+  }
+
   common.worker_end(context, true, tx_rf_buffer);
 
 #ifdef DEBUG_WRITE_FILE
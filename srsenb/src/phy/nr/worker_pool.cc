@@ -53,6 +53,16 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   logger.set_level(log_level);
 
+  // Create the intra-slot task pool shared by all workers, its real-time workers run the PDSCH/PUSCH tasks
+  if (args.nof_slot_threads > 0) {
+    srsran::work_stealing_pool::args_t pool_args = {};
+    pool_args.realtime.nof_workers               = args.nof_slot_threads;
+    pool_args.realtime.prio                      = args.prio;
+    pool_args.realtime.name                      = "NRSLOT";
+    pool_args.background.nof_workers             = 0;
+    task_pool.reset(new srsran::work_stealing_pool(pool_args));
+  }
+
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("{}PHY{}-NR", args.log.id_preamble, i), log_sink);
@@ -72,7 +82,11 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     w_args.rf_port                 = cell_list[cell_index].rf_port;
     w_args.srate_hz                = srate_hz;
     w_args.pusch_max_its           = args.pusch_max_its;
+    w_args.pusch_early_stop        = args.pusch_early_stop;
+    w_args.pusch_abort_its         = args.pusch_abort_its;
     w_args.pusch_min_snr_dB        = args.pusch_min_snr_dB;
+    w_args.task_pool               = task_pool.get();
+    w_args.nof_task_threads        = args.nof_slot_threads + args.nof_phy_threads;
 
     if (not w->init(w_args)) {
       return false;
@@ -114,6 +128,25 @@ void worker_pool::stop()
 {
   pool.stop();
   prach.stop();
+  if (task_pool != nullptr) {
+    task_pool->stop();
+  }
+}
+
+void worker_pool::get_metrics(slot_worker::metrics_t& metrics)
+{
+  metrics = {};
+  for (std::unique_ptr<slot_worker>& w : workers) {
+    slot_worker::metrics_t m = w->get_metrics();
+    if (m.count == 0) {
+      continue;
+    }
+
+    metrics.avg_us = (metrics.avg_us * metrics.count + m.avg_us * m.count) / (metrics.count + m.count);
+    metrics.min_us = SRSRAN_MIN(metrics.min_us, m.min_us);
+    metrics.max_us = SRSRAN_MAX(metrics.max_us, m.max_us);
+    metrics.count += m.count;
+  }
 }
 
 int worker_pool::set_common_cfg(const phy_interface_rrc_nr::common_cfg_t& common_cfg)
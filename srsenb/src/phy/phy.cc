@@ -376,6 +376,9 @@ int phy::init_nr(const phy_args_t& args, const phy_cfg_t& cfg, stack_interface_p
   worker_args.log.phy_level           = args.log.phy_level;
   worker_args.log.phy_hex_limit       = args.log.phy_hex_limit;
   worker_args.pusch_max_its           = args.nr_pusch_max_its;
+  worker_args.pusch_early_stop        = args.nr_pusch_early_stop;
+  worker_args.pusch_abort_its         = args.nr_pusch_abort_its;
+  worker_args.nof_slot_threads        = args.nr_nof_slot_threads;
 
   if (not nr_workers->init(worker_args, cfg.phy_cell_cfg_nr)) {
     return SRSRAN_ERROR;
@@ -184,6 +184,14 @@ int sched::dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmd
   return ue_db_access_locked(rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); });
 }
 
+int sched::dl_ack_pid(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx)
+{
+  int ret = SRSRAN_ERROR;
+  ue_db_access_locked(
+      rnti, [&](sched_ue& ue) { ret = ue.get_ack_pid(tti_point{tti_rx}, enb_cc_idx); }, __PRETTY_FUNCTION__);
+  return ret;
+}
+
 int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
 {
   int ret = -1;
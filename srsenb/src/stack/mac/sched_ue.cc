@@ -989,6 +989,14 @@ const dl_harq_proc& sched_ue::get_dl_harq(uint32_t idx, uint32_t enb_cc_idx) con
   return cells[enb_cc_idx].harq_ent.dl_harq_procs()[idx];
 }
 
+int sched_ue::get_ack_pid(tti_point tti_rx, uint32_t enb_cc_idx) const
+{
+  if (enb_cc_idx >= cells.size() or not cells[enb_cc_idx].configured()) {
+    return SRSRAN_ERROR;
+  }
+  return cells[enb_cc_idx].harq_ent.get_ack_pid(tti_rx);
+}
+
 std::pair<bool, uint32_t> sched_ue::get_active_cell_index(uint32_t enb_cc_idx) const
 {
   if (cells[enb_cc_idx].configured()) {
@@ -409,6 +409,16 @@ std::tuple<uint32_t, int, int> harq_entity::set_ack_info(tti_point tti_rx, uint3
   return std::make_tuple(dl_harqs.size(), -1, -1);
 }
 
+int harq_entity::get_ack_pid(tti_point tti_rx) const
+{
+  for (const auto& h : dl_harqs) {
+    if (h.get_tti() + FDD_HARQ_DELAY_DL_MS == tti_rx) {
+      return h.get_id();
+    }
+  }
+  return -1;
+}
+
 ul_harq_proc* harq_entity::get_ul_harq(tti_point tti_tx_ul)
 {
   return &ul_harqs[tti_tx_ul.to_uint() % ul_harqs.size()];
@@ -32,19 +32,34 @@
 
 namespace srsenb {
 
-ue_cc_softbuffers::ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_) :
+ue_cc_softbuffers::ue_cc_softbuffers(uint32_t                  nof_prb,
+                                     uint32_t                  nof_tx_harq_proc_,
+                                     uint32_t                  nof_rx_harq_proc_,
+                                     srsran_softbuffer_pool_t* tx_pool,
+                                     srsran_softbuffer_pool_t* rx_pool) :
   nof_tx_harq_proc(nof_tx_harq_proc_), nof_rx_harq_proc(nof_rx_harq_proc_)
 {
+  int      tbs    = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
+  uint32_t max_cb = (uint32_t)SRSRAN_MAX(tbs, 0) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
+
   // Create and init Rx buffers
   softbuffer_rx_list.resize(nof_rx_harq_proc);
   for (srsran_softbuffer_rx_t& buffer : softbuffer_rx_list) {
-    srsran_softbuffer_rx_init(&buffer, nof_prb);
+    if (rx_pool != nullptr) {
+      srsran_softbuffer_rx_init_pool(&buffer, rx_pool, max_cb);
+    } else {
+      srsran_softbuffer_rx_init(&buffer, nof_prb);
+    }
   }
 
   // Create and init Tx buffers
   softbuffer_tx_list.resize(nof_tx_harq_proc * SRSRAN_MAX_TB);
   for (auto& buffer : softbuffer_tx_list) {
-    srsran_softbuffer_tx_init(&buffer, nof_prb);
+    if (tx_pool != nullptr) {
+      srsran_softbuffer_tx_init_pool(&buffer, tx_pool, max_cb);
+    } else {
+      srsran_softbuffer_tx_init(&buffer, nof_prb);
+    }
   }
 }
 
@@ -265,6 +280,37 @@ srsran_softbuffer_tx_t* ue::get_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq
   return &cc_buffers[enb_cc_idx].get_tx_softbuffer(harq_process, tb_idx);
 }
 
+srsran_softbuffer_tx_t*
+ue::new_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx, uint32_t tbs)
+{
+  srsran_softbuffer_tx_t* softbuffer = get_tx_softbuffer(enb_cc_idx, harq_process, tb_idx);
+  if (softbuffer != nullptr) {
+    srsran_softbuffer_tx_reset_tbs(softbuffer, tbs * 8);
+  }
+  return softbuffer;
+}
+
+void ue::release_tx_softbuffer(uint32_t enb_cc_idx, uint32_t harq_process, uint32_t tb_idx)
+{
+  if ((size_t)enb_cc_idx < cc_buffers.size() and not cc_buffers[enb_cc_idx].empty() and
+      harq_process < SRSRAN_FDD_NOF_HARQ) {
+    srsran_softbuffer_tx_t& softbuffer = cc_buffers[enb_cc_idx].get_tx_softbuffer(harq_process, tb_idx);
+    if (softbuffer.pool != nullptr) {
+      srsran_softbuffer_tx_reset(&softbuffer);
+    }
+  }
+}
+
+void ue::release_rx_softbuffer(uint32_t enb_cc_idx, uint32_t tti_rx)
+{
+  if ((size_t)enb_cc_idx < cc_buffers.size() and not cc_buffers[enb_cc_idx].empty()) {
+    srsran_softbuffer_rx_t& softbuffer = cc_buffers[enb_cc_idx].get_rx_softbuffer(tti_rx);
+    if (softbuffer.pool != nullptr) {
+      srsran_softbuffer_rx_reset(&softbuffer);
+    }
+  }
+}
+
 uint8_t* ue::request_buffer(uint32_t tti, uint32_t enb_cc_idx, uint32_t len)
 {
   srsran_assert(len > 0, "UE buffers: Requesting buffer for zero bytes");
@@ -40,25 +40,30 @@ void pdcp::init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interfa
 
 void pdcp::stop()
 {
-  for (std::map<uint32_t, user_interface>::iterator iter = users.begin(); iter != users.end(); ++iter) {
-    clear_user(&iter->second);
+  for (auto& user : users) {
+    clear_user(&user.second);
   }
   users.clear();
 }
 
 void pdcp::add_user(uint16_t rnti)
 {
-  if (users.count(rnti) == 0) {
-    unique_rnti_ptr<srsran::pdcp> obj = make_rnti_obj<srsran::pdcp>(rnti, task_sched, logger.id().c_str());
-    obj->init(&users[rnti].rlc_itf, &users[rnti].rrc_itf, &users[rnti].gtpu_itf);
-    users[rnti].rlc_itf.rnti  = rnti;
-    users[rnti].gtpu_itf.rnti = rnti;
-    users[rnti].rrc_itf.rnti  = rnti;
-
-    users[rnti].rrc_itf.rrc   = rrc;
-    users[rnti].rlc_itf.rlc   = rlc;
-    users[rnti].gtpu_itf.gtpu = gtpu;
-    users[rnti].pdcp          = std::move(obj);
+  if (not users.contains(rnti)) {
+    if (not users.insert(rnti, user_interface{}).has_value()) {
+      logger.error("Failed to add rnti=0x%x. Slot taken by another user", rnti);
+      return;
+    }
+    user_interface&               user = users[rnti];
+    unique_rnti_ptr<srsran::pdcp> obj  = make_rnti_obj<srsran::pdcp>(rnti, task_sched, logger.id().c_str());
+    obj->init(&user.rlc_itf, &user.rrc_itf, &user.gtpu_itf);
+    user.rlc_itf.rnti  = rnti;
+    user.gtpu_itf.rnti = rnti;
+    user.rrc_itf.rnti  = rnti;
+
+    user.rrc_itf.rrc   = rrc;
+    user.rlc_itf.rlc   = rlc;
+    user.gtpu_itf.gtpu = gtpu;
+    user.pdcp          = std::move(obj);
   }
 }
 
@@ -71,7 +76,7 @@ void pdcp::clear_user(user_interface* ue)
 
 void pdcp::rem_user(uint16_t rnti)
 {
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     clear_user(&users[rnti]);
     users.erase(rnti);
   }
@@ -79,7 +84,7 @@ void pdcp::rem_user(uint16_t rnti)
 
 void pdcp::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t& cfg)
 {
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
       users[rnti].pdcp->add_bearer(lcid, cfg);
     } else {
@@ -90,45 +95,49 @@ void pdcp::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t&
 
 void pdcp::del_bearer(uint16_t rnti, uint32_t lcid)
 {
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].pdcp->del_bearer(lcid);
   }
 }
 
 void pdcp::set_enabled(uint16_t rnti, uint32_t lcid, bool enabled)
 {
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].pdcp->set_enabled(lcid, enabled);
   }
 }
 
 void pdcp::reset(uint16_t rnti)
 {
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].pdcp->reset();
   }
 }
 
 void pdcp::config_security(uint16_t rnti, uint32_t lcid, const srsran::as_security_config_t& sec_cfg)
 {
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].pdcp->config_security(lcid, sec_cfg);
   }
 }
 
 void pdcp::enable_integrity(uint16_t rnti, uint32_t lcid)
 {
-  users[rnti].pdcp->enable_integrity(lcid, srsran::DIRECTION_TXRX);
+  if (users.contains(rnti)) {
+    users[rnti].pdcp->enable_integrity(lcid, srsran::DIRECTION_TXRX);
+  }
 }
 
 void pdcp::enable_encryption(uint16_t rnti, uint32_t lcid)
 {
-  users[rnti].pdcp->enable_encryption(lcid, srsran::DIRECTION_TXRX);
+  if (users.contains(rnti)) {
+    users[rnti].pdcp->enable_encryption(lcid, srsran::DIRECTION_TXRX);
+  }
 }
 
 bool pdcp::get_bearer_state(uint16_t rnti, uint32_t lcid, srsran::pdcp_lte_state_t* state)
 {
-  if (users.count(rnti) == 0) {
+  if (not users.contains(rnti)) {
     return false;
   }
   return users[rnti].pdcp->get_bearer_state(lcid, state);
@@ -136,7 +145,7 @@ bool pdcp::get_bearer_state(uint16_t rnti, uint32_t lcid, srsran::pdcp_lte_state
 
 bool pdcp::set_bearer_state(uint16_t rnti, uint32_t lcid, const srsran::pdcp_lte_state_t& state)
 {
-  if (users.count(rnti) == 0) {
+  if (not users.contains(rnti)) {
     return false;
   }
   return users[rnti].pdcp->set_bearer_state(lcid, state);
@@ -144,7 +153,7 @@ bool pdcp::set_bearer_state(uint16_t rnti, uint32_t lcid, const srsran::pdcp_lte
 
 void pdcp::reestablish(uint16_t rnti)
 {
-  if (users.count(rnti) == 0) {
+  if (not users.contains(rnti)) {
     return;
   }
   users[rnti].pdcp->reestablish();
@@ -152,7 +161,7 @@ void pdcp::reestablish(uint16_t rnti)
 
 void pdcp::send_status_report(uint16_t rnti)
 {
-  if (users.count(rnti) == 0) {
+  if (not users.contains(rnti)) {
     return;
   }
   users[rnti].pdcp->send_status_report();
@@ -160,21 +169,21 @@ void pdcp::send_status_report(uint16_t rnti)
 
 void pdcp::notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].pdcp->notify_delivery(lcid, pdcp_sns);
   }
 }
 
 void pdcp::notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].pdcp->notify_failure(lcid, pdcp_sns);
   }
 }
 
 void pdcp::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn)
 {
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
       // TODO: Handle PDCP SN coming from GTPU
       users[rnti].pdcp->write_sdu(lcid, std::move(sdu), pdcp_sn);
@@ -186,14 +195,14 @@ void pdcp::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t
 
 void pdcp::send_status_report(uint16_t rnti, uint32_t lcid)
 {
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].pdcp->send_status_report(lcid);
   }
 }
 
 std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp::get_buffered_pdus(uint16_t rnti, uint32_t lcid)
 {
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     return users[rnti].pdcp->get_buffered_pdus(lcid);
   }
   return {};
@@ -201,7 +210,7 @@ std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp::get_buffered_pdus(uint16_
 
 void pdcp::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu)
 {
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].pdcp->write_pdu(lcid, std::move(sdu));
   }
 }
@@ -272,6 +281,7 @@ void pdcp::get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti)
   size_t count = 0;
   for (auto& user : users) {
     user.second.pdcp->get_metrics(m.ues[count], nof_tti);
+    m.ues[count].rnti = user.first;
     count++;
   }
 }
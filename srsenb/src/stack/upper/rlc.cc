@@ -64,20 +64,26 @@ void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
 void rlc::add_user(uint16_t rnti)
 {
   pthread_rwlock_wrlock(&rwlock);
-  if (users.count(rnti) == 0) {
-    auto obj = make_rnti_obj<srsran::rlc>(rnti, logger.id().c_str());
-    obj->init(&users[rnti],
-              &users[rnti],
+  if (not users.contains(rnti)) {
+    if (not users.insert(rnti, user_interface{}).has_value()) {
+      logger.error("Failed to add rnti=0x%x. Slot taken by another user", rnti);
+      pthread_rwlock_unlock(&rwlock);
+      return;
+    }
+    user_interface& user = users[rnti];
+    auto            obj  = make_rnti_obj<srsran::rlc>(rnti, logger.id().c_str());
+    obj->init(&user,
+              &user,
               timers,
               srb_to_lcid(lte_srb::srb0),
               [rnti, this](uint32_t lcid, uint32_t tx_queue, uint32_t retx_queue) {
                 update_bsr(rnti, lcid, tx_queue, retx_queue);
               });
-    users[rnti].rnti   = rnti;
-    users[rnti].pdcp   = pdcp;
-    users[rnti].rrc    = rrc;
-    users[rnti].rlc    = std::move(obj);
-    users[rnti].parent = this;
+    user.rnti   = rnti;
+    user.pdcp   = pdcp;
+    user.rrc    = rrc;
+    user.rlc    = std::move(obj);
+    user.parent = this;
   }
   pthread_rwlock_unlock(&rwlock);
 }
@@ -85,7 +91,7 @@ void rlc::add_user(uint16_t rnti)
 void rlc::rem_user(uint16_t rnti)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->stop();
   } else {
     logger.error("Removing rnti=0x%x. Already removed", rnti);
@@ -100,7 +106,7 @@ void rlc::rem_user(uint16_t rnti)
 void rlc::clear_buffer(uint16_t rnti)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->empty_queue();
     for (int i = 0; i < SRSRAN_N_RADIO_BEARERS; i++) {
       if (users[rnti].rlc->has_bearer(i)) {
@@ -115,7 +121,7 @@ void rlc::clear_buffer(uint16_t rnti)
 void rlc::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::rlc_config_t& cnfg)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->add_bearer(lcid, cnfg);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -124,7 +130,7 @@ void rlc::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::rlc_config_t& c
 void rlc::add_bearer_mrb(uint16_t rnti, uint32_t lcid)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->add_bearer_mrb(lcid);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -134,7 +140,7 @@ bool rlc::has_bearer(uint16_t rnti, uint32_t lcid)
 {
   pthread_rwlock_rdlock(&rwlock);
   bool result = false;
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     result = users[rnti].rlc->has_bearer(lcid);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -144,7 +150,7 @@ bool rlc::has_bearer(uint16_t rnti, uint32_t lcid)
 void rlc::del_bearer(uint16_t rnti, uint32_t lcid)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->del_bearer(lcid);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -154,7 +160,7 @@ bool rlc::suspend_bearer(uint16_t rnti, uint32_t lcid)
 {
   pthread_rwlock_rdlock(&rwlock);
   bool result = false;
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->suspend_bearer(lcid);
     result = true;
   }
@@ -166,7 +172,7 @@ bool rlc::is_suspended(uint16_t rnti, uint32_t lcid)
 {
   pthread_rwlock_rdlock(&rwlock);
   bool result = false;
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     result = users[rnti].rlc->is_suspended(lcid);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -177,7 +183,7 @@ bool rlc::resume_bearer(uint16_t rnti, uint32_t lcid)
 {
   pthread_rwlock_rdlock(&rwlock);
   bool result = false;
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->resume_bearer(lcid);
     result = true;
   }
@@ -188,7 +194,7 @@ bool rlc::resume_bearer(uint16_t rnti, uint32_t lcid)
 void rlc::reestablish(uint16_t rnti)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->reestablish();
   }
   pthread_rwlock_unlock(&rwlock);
@@ -207,7 +213,7 @@ int rlc::read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_b
   int ret;
 
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
       ret = users[rnti].rlc->read_pdu(lcid, payload, nof_bytes);
     } else {
@@ -223,7 +229,7 @@ int rlc::read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_b
 void rlc::write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->write_pdu(lcid, payload, nof_bytes);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -232,7 +238,7 @@ void rlc::write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof
 void rlc::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
       users[rnti].rlc->write_sdu(lcid, std::move(sdu));
     } else {
@@ -245,7 +251,7 @@ void rlc::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t s
 void rlc::discard_sdu(uint16_t rnti, uint32_t lcid, uint32_t discard_sn)
 {
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     users[rnti].rlc->discard_sdu(lcid, discard_sn);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -255,7 +261,7 @@ bool rlc::rb_is_um(uint16_t rnti, uint32_t lcid)
 {
   bool ret = false;
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     ret = users[rnti].rlc->rb_is_um(lcid);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -266,7 +272,7 @@ bool rlc::sdu_queue_is_full(uint16_t rnti, uint32_t lcid)
 {
   bool ret = false;
   pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  if (users.contains(rnti)) {
     ret = users[rnti].rlc->sdu_queue_is_full(lcid);
   }
   pthread_rwlock_unlock(&rwlock);
@@ -0,0 +1,233 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_test_common.h"
+#include "srsenb/hdr/stack/mac/mac.h"
+#include "srsenb/test/common/rlc_test_dummy.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/enb_phy_interfaces.h"
+#include <deque>
+#include <thread>
+
+// PHY workers run the MAC of consecutive TTIs while the stack adds and removes a UE every TTI, as in an attach storm.
+// The stall of a TTI is the time a worker spends in the MAC for it
+
+namespace srsenb {
+
+class phy_stack_dummy : public phy_interface_stack_lte
+{
+public:
+  void rem_rnti(uint16_t rnti) override {}
+  void set_mch_period_stop(uint32_t stop) override {}
+  void set_activation_deactivation_scell(uint16_t                                     rnti,
+                                         const std::array<bool, SRSRAN_MAX_CARRIERS>& activation) override
+  {}
+  void configure_mbsfn(srsran::sib2_mbms_t* sib2, srsran::sib13_t* sib13, const srsran::mcch_msg_t& mcch) override {}
+  void set_config(uint16_t rnti, const phy_rrc_cfg_list_t& phy_cfg_list) override {}
+  void complete_config(uint16_t rnti) override {}
+};
+
+} // namespace srsenb
+
+using namespace srsenb;
+
+static const uint32_t nof_prb      = 25;
+static const uint32_t max_nof_ues  = 32;
+static const uint32_t tti_duration = 250; // microseconds, the stack runs 4 times faster than real time
+
+struct worker_stats {
+  uint32_t                 nof_ttis = 0;
+  std::chrono::nanoseconds total_stall{0};
+  std::chrono::nanoseconds max_stall{0};
+};
+
+static void run_worker(mac&                         mac_obj,
+                       uint32_t                     worker_idx,
+                       uint32_t                     nof_workers,
+                       const std::atomic<uint32_t>& nof_released_ttis,
+                       const std::atomic<bool>&     running,
+                       worker_stats&                stats)
+{
+  std::vector<uint16_t>                  dl_grants, ul_grants;
+  mac_interface_phy_lte::dl_sched_list_t dl_sched_res(1);
+  mac_interface_phy_lte::ul_sched_list_t ul_sched_res(1);
+
+  for (uint32_t count = worker_idx;; count += nof_workers) {
+    // Wait for the radio to release the TTI
+    while (nof_released_ttis.load(std::memory_order_acquire) <= count) {
+      if (not running) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+    uint32_t tti_rx = count % 10240;
+
+    auto tp0 = std::chrono::steady_clock::now();
+
+    // Feedback of the grants of the last TTI of this worker
+    for (uint16_t rnti : dl_grants) {
+      mac_obj.ack_info(tti_rx, rnti, 0, 0, true);
+      mac_obj.cqi_info(tti_rx, rnti, 0, 12);
+    }
+    for (uint16_t rnti : ul_grants) {
+      mac_obj.crc_info(tti_rx, rnti, 0, 0, true);
+      mac_obj.snr_info(tti_rx, rnti, 0, 20.0, mac_interface_phy_lte::PUSCH);
+    }
+    dl_grants.clear();
+    ul_grants.clear();
+
+    int dl_ret = mac_obj.get_dl_sched(TTI_ADD(tti_rx, FDD_HARQ_DELAY_UL_MS), dl_sched_res);
+    int ul_ret = mac_obj.get_ul_sched(TTI_ADD(tti_rx, FDD_HARQ_DELAY_UL_MS + FDD_HARQ_DELAY_DL_MS), ul_sched_res);
+
+    auto tp1 = std::chrono::steady_clock::now();
+    TESTASSERT(dl_ret == SRSRAN_SUCCESS and ul_ret == SRSRAN_SUCCESS);
+
+    for (uint32_t i = 0; i < dl_sched_res[0].nof_grants; i++) {
+      dl_grants.push_back(dl_sched_res[0].pdsch[i].dci.rnti);
+    }
+    for (uint32_t i = 0; i < ul_sched_res[0].nof_grants; i++) {
+      ul_grants.push_back(ul_sched_res[0].pusch[i].dci.rnti);
+    }
+
+    stats.nof_ttis++;
+    stats.total_stall += tp1 - tp0;
+    stats.max_stall = std::max(stats.max_stall, std::chrono::nanoseconds(tp1 - tp0));
+  }
+}
+
+int run_stress_test(uint32_t nof_workers, uint32_t duration_ms)
+{
+  srsran::task_scheduler task_sched;
+  phy_stack_dummy        phy;
+  rlc_dummy              rlc;
+  rrc_dummy              rrc;
+  mac                    mac_obj(&task_sched, srslog::fetch_basic_logger("MAC"));
+
+  mac_args_t args           = {};
+  args.nof_prb              = nof_prb;
+  args.nof_prealloc_ues     = 8;
+  args.max_nof_kos          = 100;
+  args.rlf_min_ul_snr_estim = -2;
+  cell_list_t cells(1);
+  bool initialized = mac_obj.init(args, cells, &phy, &rlc, &rrc);
+  TESTASSERT(initialized);
+  int configured = mac_obj.cell_cfg({generate_default_cell_cfg(nof_prb)});
+  TESTASSERT(configured == SRSRAN_SUCCESS);
+
+  std::atomic<uint32_t>     nof_released_ttis{0};
+  std::atomic<bool>         running{true};
+  std::vector<worker_stats> stats(nof_workers);
+  std::vector<std::thread>  workers;
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    workers.emplace_back(run_worker,
+                         std::ref(mac_obj),
+                         i,
+                         nof_workers,
+                         std::cref(nof_released_ttis),
+                         std::cref(running),
+                         std::ref(stats[i]));
+  }
+  // Metrics are read from their own thread
+  std::thread metrics_thread([&mac_obj, &running]() {
+    while (running) {
+      mac_metrics_t metrics = {};
+      mac_obj.get_metrics(metrics);
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  });
+
+  // The stack thread adds a UE every TTI, and removes the oldest one once the maximum number of UEs is reached
+  sched_interface::ue_cfg_t ue_cfg = generate_default_ue_cfg();
+  std::deque<uint16_t>      ues;
+  uint32_t                  nof_added_ues = 0;
+  uint32_t                  nof_ttis      = duration_ms * 1000 / tti_duration;
+  auto                      tp_next_tti   = std::chrono::steady_clock::now();
+  for (uint32_t tti = 0; tti < nof_ttis; tti++) {
+    nof_released_ttis.store(tti + 1, std::memory_order_release);
+    task_sched.tic();
+    task_sched.run_pending_tasks();
+
+    uint16_t rnti = mac_obj.reserve_new_crnti(ue_cfg);
+    if (rnti != SRSRAN_INVALID_RNTI) {
+      mac_obj.rlc_buffer_state(rnti, drb_to_lcid(lte_drb::drb1), 10000, 0);
+      ues.push_back(rnti);
+      nof_added_ues++;
+    }
+    if (ues.size() > max_nof_ues) {
+      int removed = mac_obj.ue_rem(ues.front());
+      TESTASSERT(removed == SRSRAN_SUCCESS);
+      ues.pop_front();
+    }
+
+    tp_next_tti += std::chrono::microseconds(tti_duration);
+    std::this_thread::sleep_until(tp_next_tti);
+  }
+
+  running = false;
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  metrics_thread.join();
+  mac_obj.stop();
+
+  worker_stats total = {};
+  for (const worker_stats& s : stats) {
+    total.nof_ttis += s.nof_ttis;
+    total.total_stall += s.total_stall;
+    total.max_stall = std::max(total.max_stall, s.max_stall);
+  }
+  TESTASSERT(nof_added_ues > max_nof_ues);
+  TESTASSERT(total.nof_ttis > 0);
+
+  fmt::print("\n{:>11}  {:>8}  {:>9}  {:>14}  {:>14}\n",
+             "nof_workers",
+             "nof_ttis",
+             "added_ues",
+             "avg_stall [us]",
+             "max_stall [us]");
+  fmt::print("{:>11}  {:>8}  {:>9}  {:>14.1f}  {:>14.1f}\n",
+             nof_workers,
+             total.nof_ttis,
+             nof_added_ues,
+             total.total_stall.count() / 1000.0 / total.nof_ttis,
+             total.max_stall.count() / 1000.0);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("MAC").set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  uint32_t nof_workers = 16;
+  uint32_t duration_ms = 2000;
+  if (argc > 1) {
+    nof_workers = strtoul(argv[1], nullptr, 10);
+  }
+  if (argc > 2) {
+    duration_ms = strtoul(argv[2], nullptr, 10);
+  }
+
+  int ret = run_stress_test(nof_workers, duration_ms);
+
+  srslog::flush();
+  return ret;
+}
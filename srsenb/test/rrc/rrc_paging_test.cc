@@ -21,6 +21,8 @@
 
 #include "srsenb/hdr/stack/rrc/rrc_paging.h"
 #include "srsran/common/test_common.h"
+#include <chrono>
+#include <thread>
 
 using namespace srsenb;
 
@@ -51,7 +53,130 @@ void test_paging()
   }
 }
 
+void test_paging_multiple_records()
+{
+  unsigned       paging_cycle = 32;
+  paging_manager pcch_manager{paging_cycle, 1};
+  unsigned       mmec = 10;
+
+  auto add_paging = [&](unsigned ue_id) {
+    uint8_t m_tmsi[] = {0x64, 0x04, (uint8_t)(ue_id >> 8U), (uint8_t)ue_id};
+    return pcch_manager.add_tmsi_paging(ue_id, mmec, m_tmsi);
+  };
+
+  // All these UEs map to the same paging occasion (sfn % 32 == 12, sf_idx == 9)
+  unsigned nof_added = 0;
+  for (unsigned ue_id = 12; ue_id < 1024; ue_id += paging_cycle) {
+    nof_added += add_paging(ue_id) ? 1 : 0;
+  }
+  // The PCCH can only fit ASN1_RRC_MAX_PAGE_REC records
+  TESTASSERT_EQ(ASN1_RRC_MAX_PAGE_REC, nof_added);
+
+  tti_point t{12 * 10 + 9};
+  TESTASSERT(pcch_manager.pending_pcch_bytes(t) > 0);
+  auto read_full = [&](srsran::const_byte_span pdu, const asn1::rrc::pcch_msg_s& msg, bool is_first_tx) {
+    const auto& records = msg.msg.c1().paging().paging_record_list;
+    TESTASSERT(is_first_tx);
+    TESTASSERT_EQ(ASN1_RRC_MAX_PAGE_REC, records.size());
+    // Records keep their arrival order
+    for (unsigned i = 0; i < records.size(); ++i) {
+      TESTASSERT_EQ(0x64040000U + 12 + i * paging_cycle, records[i].ue_id.s_tmsi().m_tmsi.to_number());
+    }
+    return true;
+  };
+  TESTASSERT(pcch_manager.read_pdu_pcch(t, read_full));
+
+  // Once the transmitted PCCH is cleared, there is space again in the next cycle
+  t += paging_cycle * 10;
+  TESTASSERT_EQ(0, pcch_manager.pending_pcch_bytes(t));
+  TESTASSERT(add_paging(12));
+
+  // Records that arrive after the first carrier transmitted the PCCH are kept for the next paging cycle
+  TESTASSERT(pcch_manager.pending_pcch_bytes(t) > 0);
+  unsigned nof_records = 0;
+  auto     read_pcch   = [&](srsran::const_byte_span pdu, const asn1::rrc::pcch_msg_s& msg, bool is_first_tx) {
+    nof_records = msg.msg.c1().paging().paging_record_list.size();
+    return true;
+  };
+  TESTASSERT(pcch_manager.read_pdu_pcch(t, read_pcch));
+  TESTASSERT_EQ(1, nof_records);
+  TESTASSERT(add_paging(44));
+  TESTASSERT(pcch_manager.pending_pcch_bytes(t) > 0);
+  TESTASSERT(pcch_manager.read_pdu_pcch(t, read_pcch));
+  TESTASSERT_EQ(1, nof_records);
+
+  t += paging_cycle * 10;
+  TESTASSERT(pcch_manager.pending_pcch_bytes(t) > 0);
+  TESTASSERT(pcch_manager.read_pdu_pcch(t, read_pcch));
+  TESTASSERT_EQ(1, nof_records);
+}
+
+/// Measures the paging records/s handled while several S1AP-like threads add records and the MAC reads the PCCH
+void benchmark_paging_storm(unsigned nof_producers, std::chrono::milliseconds duration)
+{
+  unsigned       paging_cycle = 32;
+  paging_manager pcch_manager{paging_cycle, 4};
+
+  std::atomic<bool>     running{true};
+  std::atomic<uint64_t> nof_added{0};
+  std::atomic<uint64_t> nof_attempts{0};
+
+  std::vector<std::thread> producers;
+  for (unsigned p = 0; p < nof_producers; ++p) {
+    producers.emplace_back([&, p]() {
+      uint32_t ue_id = p;
+      uint64_t added = 0, attempts = 0;
+      while (running.load(std::memory_order_relaxed)) {
+        uint8_t m_tmsi[] = {0x64, 0x04, (uint8_t)(ue_id >> 8U), (uint8_t)ue_id};
+        added += pcch_manager.add_tmsi_paging(ue_id, 10, m_tmsi) ? 1 : 0;
+        attempts++;
+        ue_id += nof_producers;
+      }
+      nof_added += added;
+      nof_attempts += attempts;
+    });
+  }
+
+  // MAC thread, which runs the TTIs as fast as possible
+  uint64_t   nof_tx_records = 0;
+  tti_point  t{0};
+  auto       tstart   = std::chrono::steady_clock::now();
+  auto       read_pcch = [&nof_tx_records](srsran::const_byte_span pdu, const asn1::rrc::pcch_msg_s& msg, bool first) {
+    nof_tx_records += first ? msg.msg.c1().paging().paging_record_list.size() : 0;
+    return true;
+  };
+  while (std::chrono::steady_clock::now() - tstart < duration) {
+    for (unsigned i = 0; i < 100; ++i, ++t) {
+      if (pcch_manager.pending_pcch_bytes(t) > 0) {
+        pcch_manager.read_pdu_pcch(t, read_pcch);
+      }
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - tstart;
+  running = false;
+  for (std::thread& th : producers) {
+    th.join();
+  }
+
+  fmt::print("{} producers: {:.0f} records/s added ({:.0f} attempts/s), {:.0f} records/s transmitted, {:.0f} TTI/s\n",
+             nof_producers,
+             nof_added / elapsed.count(),
+             nof_attempts / elapsed.count(),
+             nof_tx_records / elapsed.count(),
+             t.to_uint() / elapsed.count());
+  TESTASSERT(nof_tx_records > 0);
+}
+
 int main()
 {
+  auto& rrc_logger = srslog::fetch_basic_logger("RRC", false);
+  rrc_logger.set_level(srslog::basic_levels::error);
+  srslog::init();
+
   test_paging();
+  test_paging_multiple_records();
+  benchmark_paging_storm(1, std::chrono::milliseconds(500));
+  benchmark_paging_storm(4, std::chrono::milliseconds(500));
+
+  srslog::flush();
 }
\ No newline at end of file
@@ -0,0 +1,176 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Measures the cost of the per-packet user and bearer lookup done by the eNB PDCP and RLC layers. The former layout
+ * (std::map keyed by RNTI, then std::map keyed by LCID) is compared against the RNTI-indexed circular map with dense
+ * per-UE LCID arrays. The eNB is limited to SRSENB_MAX_UES users, larger tables are only used to see how both layouts
+ * scale.
+ */
+
+#include "srsenb/hdr/common/common_enb.h"
+#include "srsran/adt/circular_map.h"
+#include "srsran/common/common.h"
+#include "srsran/config.h"
+#include <chrono>
+#include <cinttypes>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace srsenb {
+
+static const uint16_t first_rnti = 0x46;
+
+struct bearer_entity {
+  uint64_t nof_bytes = 0;
+  void     process(uint32_t len) { nof_bytes += len; }
+};
+
+struct packet_t {
+  uint16_t rnti;
+  uint16_t lcid;
+  uint32_t len;
+};
+
+/// Previous layout, with the lookup pattern used in the data plane (count() + operator[], find() + at())
+struct tree_layout {
+  struct user {
+    std::map<uint16_t, std::unique_ptr<bearer_entity> > bearers;
+  };
+  std::map<uint32_t, user> users;
+
+  void add_user(uint16_t rnti, uint32_t nof_lcid)
+  {
+    for (uint16_t lcid = 0; lcid < nof_lcid; ++lcid) {
+      users[rnti].bearers.emplace(lcid, std::unique_ptr<bearer_entity>(new bearer_entity()));
+    }
+  }
+  void write(const packet_t& p)
+  {
+    if (users.count(p.rnti)) {
+      user& u = users[p.rnti];
+      if (u.bearers.find(p.lcid) != u.bearers.end()) {
+        u.bearers.at(p.lcid)->process(p.len);
+      }
+    }
+  }
+};
+
+/// Current layout, RNTI-indexed table with dense LCID arrays
+template <size_t N>
+struct table_layout {
+  struct user {
+    srsran::static_circular_map<uint16_t, std::unique_ptr<bearer_entity>, SRSRAN_N_RADIO_BEARERS> bearers;
+  };
+  srsran::static_circular_map<uint16_t, user, N> users;
+
+  void add_user(uint16_t rnti, uint32_t nof_lcid)
+  {
+    users.insert(rnti, user{});
+    for (uint16_t lcid = 0; lcid < nof_lcid; ++lcid) {
+      users[rnti].bearers.insert(lcid, std::unique_ptr<bearer_entity>(new bearer_entity()));
+    }
+  }
+  void write(const packet_t& p)
+  {
+    if (users.contains(p.rnti)) {
+      user& u = users[p.rnti];
+      if (p.lcid < SRSRAN_N_RADIO_BEARERS and u.bearers.contains(p.lcid)) {
+        u.bearers[p.lcid]->process(p.len);
+      }
+    }
+  }
+};
+
+template <typename Layout>
+double run_layout(Layout& layout, const std::vector<packet_t>& packets, uint32_t nof_ues, uint64_t& total)
+{
+  const uint32_t nof_lcid = 4; // SRB0-2 and one DRB
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    layout.add_user(first_rnti + i, nof_lcid);
+  }
+
+  auto tp = std::chrono::high_resolution_clock::now();
+  for (const packet_t& p : packets) {
+    layout.write(p);
+  }
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::high_resolution_clock::now() - tp;
+
+  total = 0;
+  for (auto& u : layout.users) {
+    for (auto& b : u.second.bearers) {
+      total += b.second->nof_bytes;
+    }
+  }
+  return elapsed.count() / packets.size();
+}
+
+template <size_t N>
+int run_benchmark(uint32_t nof_packets)
+{
+  std::mt19937                            rgen(N);
+  std::uniform_int_distribution<uint32_t> ue_dist(0, N - 1);
+  std::uniform_int_distribution<uint32_t> lcid_dist(1, 3);
+  std::vector<packet_t>                   packets(nof_packets);
+  for (packet_t& p : packets) {
+    p.rnti = first_rnti + ue_dist(rgen);
+    p.lcid = lcid_dist(rgen);
+    p.len  = 1 + p.rnti % 1500;
+  }
+
+  uint64_t                          tree_total = 0, table_total = 0;
+  std::unique_ptr<tree_layout>      tree(new tree_layout());
+  std::unique_ptr<table_layout<N> > table(new table_layout<N>());
+  double                            tree_ns  = run_layout(*tree, packets, N, tree_total);
+  double                            table_ns = run_layout(*table, packets, N, table_total);
+
+  printf("%6zd UEs: std::map %6.1f ns/packet, rnti table %6.1f ns/packet (x%.1f)\n",
+         N,
+         tree_ns,
+         table_ns,
+         tree_ns / table_ns);
+
+  // Both layouts must deliver every packet to the same bearer
+  if (tree_total != table_total) {
+    fprintf(stderr, "Delivered bytes differ: %" PRIu64 " != %" PRIu64 "\n", tree_total, table_total);
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  uint32_t nof_packets = 1000000;
+  if (argc > 1) {
+    nof_packets = strtoul(argv[1], nullptr, 10);
+  }
+
+  if (srsenb::run_benchmark<SRSENB_MAX_UES>(nof_packets) != SRSRAN_SUCCESS or
+      srsenb::run_benchmark<1024>(nof_packets) != SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
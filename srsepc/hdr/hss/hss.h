@@ -28,6 +28,7 @@
 #ifndef SRSEPC_HSS_H
 #define SRSEPC_HSS_H
 
+#include "srsepc/hdr/hss/hss_db.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
@@ -35,6 +36,7 @@
 #include <cstddef>
 
 #include <map>
+#include <mutex>
 
 #define LTE_FDD_ENB_IND_HE_N_BITS 5
 #define LTE_FDD_ENB_IND_HE_MASK 0x1FUL
@@ -112,7 +114,9 @@ private:
   bool          set_auth_algo(std::string auth_algo);
   bool          read_db_file(std::string db_file);
   bool          write_db_file(std::string db_file);
+  bool          open_db(std::string db_file);
   hss_ue_ctx_t* get_ue_ctx(uint64_t imsi);
+  void          store_ue_ctx(hss_ue_ctx_t* ue_ctx);
 
   std::string hex_string(uint8_t* hex, int size);
 
@@ -125,6 +129,16 @@ private:
   uint16_t mnc;
 
   std::map<std::string, uint64_t> m_ip_to_imsi;
+
+  // Memory-mapped subscriber store, used instead of m_imsi_to_ue_ctx when db_file is a binary database.
+  // get_ue_ctx() loads the record in m_db_ue_ctx and store_ue_ctx() writes SQN and RAND back in place
+  hss_db           m_db;
+  hss_ue_ctx_t     m_db_ue_ctx = {};
+  hss_db_record_t* m_db_record = nullptr;
+
+  // The MME workers request authentication vectors concurrently, the subscriber store and its scratch record above
+  // are guarded by m_mutex
+  std::mutex m_mutex;
 };
 
 inline void hss_ue_ctx_t::set_sqn(const uint8_t* sqn_)
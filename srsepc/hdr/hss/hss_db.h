@@ -0,0 +1,128 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        hss_db.h
+ * Description: Memory-mapped binary subscriber store of the HSS. Records
+ *              have a fixed size and are found through an open-addressing
+ *              hash index by IMSI. SQN and RAND updates are written in place
+ *              in the shared mapping, so they survive a crash of the EPC.
+ *****************************************************************************/
+
+#ifndef SRSEPC_HSS_DB_H
+#define SRSEPC_HSS_DB_H
+
+#include "srsran/srslog/srslog.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace srsepc {
+
+#define HSS_DB_MAGIC "SRSHSSDB"
+#define HSS_DB_VERSION 1
+#define HSS_DB_NAME_LEN 32
+
+/// Subscriber record as stored in the database file
+struct hss_db_record_t {
+  uint64_t imsi;
+  uint8_t  algo; // hss_auth_algo
+  uint8_t  op_configured;
+  uint16_t qci;
+  uint32_t static_ip; // Network byte order, 0 when the SPGW allocates it dynamically
+  uint8_t  key[16];
+  uint8_t  op[16];
+  uint8_t  opc[16];
+  uint8_t  amf[2];
+  uint8_t  sqn[6];
+  uint8_t  last_rand[16];
+  char     name[HSS_DB_NAME_LEN]; // Not null-terminated if it takes the whole field
+  uint8_t  reserved[8];
+};
+static_assert(sizeof(hss_db_record_t) == 128, "The layout of the database records must not change");
+
+struct hss_db_header_t {
+  char     magic[8];
+  uint32_t version;
+  uint32_t record_size;
+  uint64_t nof_records;
+  uint64_t nof_buckets;
+  uint64_t records_offset;
+  uint64_t index_offset;
+  uint8_t  reserved[16];
+};
+static_assert(sizeof(hss_db_header_t) == 64, "The layout of the database header must not change");
+
+class hss_db
+{
+public:
+  hss_db() = default;
+  ~hss_db();
+  hss_db(const hss_db&) = delete;
+  hss_db& operator=(const hss_db&) = delete;
+
+  /// Tells whether the file starts with the binary database magic
+  static bool is_db_file(const std::string& path);
+
+  /// Maps the database file in read-write shared mode
+  bool open(const std::string& path);
+  void close();
+  bool is_open() const { return header != nullptr; }
+
+  /// Returns the record of the given IMSI, or nullptr if it is not in the database
+  hss_db_record_t* find(uint64_t imsi) const;
+
+  size_t           size() const { return nof_records; }
+  hss_db_record_t* records() const { return record_table; }
+
+  /// Schedules the write-back of an updated record. Updates are already visible in the file after a process crash
+  void persist(const hss_db_record_t* record) const;
+  /// Blocks until all updates reach the disk
+  void sync() const;
+
+  /// Writes a new database file with the given records. Records with a duplicated IMSI are dropped, the first wins
+  static bool write(const std::string& path, const std::vector<hss_db_record_t>& records);
+
+  /// Parses a user_db.csv file with several threads and writes it as a binary database
+  static bool convert_csv(const std::string& csv_path, const std::string& db_path, uint32_t nof_threads = 0);
+
+  /// Parses one user_db.csv line. Returns false and sets "error" if the line is not valid
+  static bool parse_csv_line(const char* begin, const char* end, hss_db_record_t& record, std::string& error);
+
+private:
+  static uint64_t hash_imsi(uint64_t imsi);
+
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("HSS");
+
+  int                    fd           = -1;
+  uint8_t*               map_base     = nullptr;
+  size_t                 map_len      = 0;
+  const hss_db_header_t* header       = nullptr;
+  hss_db_record_t*       record_table = nullptr;
+  const uint32_t*        index        = nullptr;
+  uint64_t               nof_records  = 0;
+  uint64_t               bucket_mask  = 0;
+};
+
+} // namespace srsepc
+
+#endif // SRSEPC_HSS_DB_H
@@ -29,25 +29,76 @@
 #define SRSEPC_MME_H
 
 #include "s1ap.h"
+#include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/move_callback.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/threads.h"
+#include "srsran/common/timers.h"
+#include <chrono>
 #include <cstddef>
+#include <memory>
+#include <vector>
 
 namespace srsepc {
 
 typedef struct {
   s1ap_args_t s1ap_args;
+  uint32_t    nof_workers;
   // diameter_args_t diameter_args;
   // gtpc_args_t gtpc_args;
 } mme_args_t;
 
-typedef struct {
-  int                 fd;
-  uint64_t            imsi;
-  enum nas_timer_type type;
-} mme_timer_t;
+/*
+ * NAS timers of one shard, in a single timer wheel with 1 ms tics. The owner thread sleeps until the next expiry, at
+ * most max_sleep_ms, and steps the wheel for every tic that has passed.
+ */
+class mme_timer_wheel
+{
+public:
+  srsran::unique_timer get_unique_timer() { return timers.get_unique_timer(); }
+  void                 step();
+  bool                 get_next_expiry(std::chrono::steady_clock::time_point* expiry);
+
+private:
+  static const uint32_t                 max_sleep_ms = 1000;
+  srsran::timer_handler                 timers;
+  std::chrono::steady_clock::time_point last_tic;
+};
+
+/*
+ * Worker thread of one shard of the UE contexts. It runs the S1AP, NAS and S11 messages of the UEs of its shard, in
+ * the order the MME thread received them, and their NAS timers.
+ */
+class mme_worker : public srsran::thread
+{
+public:
+  using task_t = srsran::move_callback<void()>;
 
+  mme_worker(uint32_t shard_idx_, uint32_t queue_size);
+
+  void     stop();
+  bool     push_task(task_t&& task, bool blocking);
+  uint32_t get_shard_idx() const { return shard_idx; }
+
+  srsran::unique_timer get_unique_timer() { return timers.get_unique_timer(); }
+
+private:
+  void run_thread() override;
+
+  uint32_t                           shard_idx;
+  srsran::dyn_blocking_queue<task_t> pending_tasks;
+  mme_timer_wheel                    timers;
+};
+
+/*
+ * Threading model: the MME thread receives the S1-MME and S11 messages. With a single worker it also runs S1AP, NAS,
+ * MME GTP-C and the NAS timers. With nof_workers > 1, the UE contexts are sharded across worker threads and the MME
+ * thread only dispatches the messages to them: a shard allocates the MME-UE-S1AP-IDs, M-TMSIs and MME control TEIDs
+ * congruent to its index modulo the number of shards, so the UE-associated S1AP messages, the Initial UE Messages with
+ * a S-TMSI or a GUTI and the S11 messages are routed by ID alone. The UE state outside of the shards (eNBs, GTP-C
+ * sessions, IMSI to shard directory and HSS) is guarded by mutexes.
+ */
 class mme : public srsran::thread, public mme_interface_nas
 {
 public:
@@ -59,10 +110,12 @@ public:
   int  get_s1_mme();
   void run_thread();
 
+  // Sharding. Tasks pushed from a worker never block, so that two workers can't wait on each other's full queue
+  static uint32_t get_current_shard();
+  bool            push_shard_task(uint32_t shard, mme_worker::task_t&& task);
+
   // Timer Methods
-  virtual bool add_nas_timer(int timer_fd, enum nas_timer_type type, uint64_t imsi);
-  virtual bool is_nas_timer_running(enum nas_timer_type type, uint64_t imsi);
-  virtual bool remove_nas_timer(enum nas_timer_type type, uint64_t imsi);
+  virtual srsran::unique_timer get_unique_timer();
 
 private:
   mme();
@@ -74,11 +127,19 @@ private:
   bool   m_running;
   fd_set m_set;
 
-  // Timer map
-  std::vector<mme_timer_t> timers;
+  // Workers of the UE shards, empty with a single worker
+  static const uint32_t                     worker_queue_size = 16384;
+  std::vector<std::unique_ptr<mme_worker> > m_workers;
+
+  // NAS timers of the MME thread, with a single worker
+  mme_timer_wheel timers;
 
   // Timer Methods
-  void handle_timer_expire(int timer_fd);
+  struct timeval* get_timers_timeout(struct timeval* timeout);
+
+  // Dispatch to the workers
+  void dispatch_s1ap_pdu(srsran::byte_buffer_t* pdu, const struct sctp_sndrcvinfo& sri);
+  void dispatch_s11_pdu(srsran::byte_buffer_t* pdu);
 
   // Logs
   srslog::basic_logger& m_s1ap_logger = srslog::fetch_basic_logger("S1AP");
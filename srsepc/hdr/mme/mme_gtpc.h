@@ -24,8 +24,11 @@
 #include "nas.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
+#include <mutex>
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <unordered_map>
+#include <vector>
 
 namespace srsepc {
 
@@ -44,7 +47,7 @@ public:
 
   static mme_gtpc* get_instance();
 
-  bool init();
+  bool init(uint32_t nof_shards);
   bool send_s11_pdu(const srsran::gtpc_pdu& pdu);
   void handle_s11_pdu(srsran::byte_buffer_t* msg);
 
@@ -66,9 +69,12 @@ private:
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("MME GTPC");
   s1ap*                 m_s1ap;
 
-  uint32_t                            m_next_ctrl_teid;
-  std::map<uint32_t, uint64_t>        m_mme_ctr_teid_to_imsi;
-  std::map<uint64_t, struct gtpc_ctx> m_imsi_to_gtpc_ctx;
+  // Each shard allocates the control TEIDs congruent to its index modulo the number of shards, so that the S11
+  // messages are routed back to it. The GTP-C contexts of the UEs of all the shards are guarded by m_mutex
+  std::vector<uint32_t>                         m_next_ctrl_teid;
+  std::mutex                                    m_mutex;
+  std::unordered_map<uint32_t, uint64_t>        m_mme_ctr_teid_to_imsi;
+  std::unordered_map<uint64_t, struct gtpc_ctx> m_imsi_to_gtpc_ctx;
 
   int                m_s11;
   struct sockaddr_un m_mme_addr, m_spgw_addr;
@@ -77,11 +83,6 @@ private:
   uint32_t get_new_ctrl_teid();
 };
 
-inline uint32_t mme_gtpc::get_new_ctrl_teid()
-{
-  return m_next_ctrl_teid++;
-}
-
 inline int mme_gtpc::get_s11()
 {
   return m_s11;
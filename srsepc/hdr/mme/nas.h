@@ -256,6 +256,7 @@ public:
 
   /*Timer functions*/
   bool start_timer(enum nas_timer_type type);
+  void stop_timer(enum nas_timer_type type);
   bool expire_timer(enum nas_timer_type type);
 
   /* UE Context */
@@ -286,6 +287,9 @@ private:
   // Timers timeout values
   uint16_t m_t3413 = 0;
 
+  // Timers
+  srsran::unique_timer m_t3413_timer;
+
   // Timer functions
   bool start_t3413();
   bool expire_t3413();
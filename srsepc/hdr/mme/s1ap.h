@@ -39,37 +39,45 @@
 #include "srsran/srslog/srslog.h"
 #include <arpa/inet.h>
 #include <map>
+#include <mutex>
 #include <netinet/sctp.h>
-#include <set>
 #include <strings.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace srsepc {
 
 const uint16_t S1MME_PORT = 36412;
 
+class mme;
+
 using s1ap_pdu_t = asn1::s1ap::s1ap_pdu_c;
 
-class s1ap : public s1ap_interface_nas, public s1ap_interface_gtpc, public s1ap_interface_mme
+class s1ap : public s1ap_interface_nas, public s1ap_interface_gtpc
 {
 public:
   static s1ap* get_instance();
   static void  cleanup();
 
   int  enb_listen();
-  int  init(const s1ap_args_t& s1ap_args);
+  int  init(const s1ap_args_t& s1ap_args, uint32_t nof_shards);
   void stop();
 
   int get_s1_mme();
 
   void delete_enb_ctx(int32_t assoc_id);
 
-  bool s1ap_tx_pdu(const s1ap_pdu_t& pdu, struct sctp_sndrcvinfo* enb_sri);
-  void handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri);
-  void handle_initiating_message(const asn1::s1ap::init_msg_s& msg, struct sctp_sndrcvinfo* enb_sri);
-  void handle_successful_outcome(const asn1::s1ap::successful_outcome_s& msg);
+  bool     s1ap_tx_pdu(const s1ap_pdu_t& pdu, struct sctp_sndrcvinfo* enb_sri);
+  bool     unpack_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, s1ap_pdu_t& rx_pdu);
+  uint32_t get_s1ap_pdu_shard(const s1ap_pdu_t& rx_pdu);
+  void     handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri);
+  void     handle_s1ap_rx_pdu(const s1ap_pdu_t& rx_pdu, struct sctp_sndrcvinfo* enb_sri);
+  void     handle_initiating_message(const asn1::s1ap::init_msg_s& msg, struct sctp_sndrcvinfo* enb_sri);
+  void     handle_successful_outcome(const asn1::s1ap::successful_outcome_s& msg);
 
   void activate_eps_bearer(uint64_t imsi, uint8_t ebi);
 
@@ -105,7 +113,8 @@ public:
   s1ap_erab_mngmt_proc* m_s1ap_erab_mngmt_proc;
   s1ap_paging*          m_s1ap_paging;
 
-  std::map<uint32_t, uint64_t>   m_tmsi_to_imsi;
+  // The eNB tables are written by the S1 Setup and the SCTP shutdown, and read by all the workers
+  std::mutex                     m_enb_mutex;
   std::map<uint16_t, enb_ctx_t*> m_active_enbs;
 
   // Interfaces
@@ -126,8 +135,6 @@ public:
                                            struct sctp_sndrcvinfo enb_sri);
   virtual bool send_paging(uint64_t imsi, uint16_t erab_to_setup);
 
-  virtual bool expire_nas_timer(enum nas_timer_type type, uint64_t imsi);
-
 private:
   s1ap();
   virtual ~s1ap();
@@ -136,22 +143,38 @@ private:
 
   uint32_t m_plmn;
 
-  hss_interface_nas*                     m_hss;
-  int                                    m_s1mme;
-  std::map<int32_t, uint16_t>            m_sctp_to_enb_id;
-  std::map<int32_t, std::set<uint32_t> > m_enb_assoc_to_ue_ids;
-
-  std::map<uint64_t, nas*> m_imsi_to_nas_ctx;
-  std::map<uint32_t, nas*> m_mme_ue_s1ap_id_to_nas_ctx;
-
-  uint32_t m_next_mme_ue_s1ap_id;
-  uint32_t m_next_m_tmsi;
+  hss_interface_nas*          m_hss;
+  mme*                        m_mme;
+  int                         m_s1mme;
+  std::map<int32_t, uint16_t> m_sctp_to_enb_id;
+
+  // UE contexts of one shard, only accessed by the worker of the shard. Per UE lookups are done for every S1AP and NAS
+  // message, so they are hash tables. The MME-UE-S1AP-IDs and M-TMSIs of the shard are congruent to its index modulo
+  // the number of shards
+  struct ue_shard_t {
+    std::unordered_map<uint64_t, nas*>                imsi_to_nas_ctx;
+    std::unordered_map<uint32_t, nas*>                mme_ue_s1ap_id_to_nas_ctx;
+    std::unordered_map<uint32_t, uint64_t>            tmsi_to_imsi;
+    std::map<int32_t, std::unordered_set<uint32_t> > enb_assoc_to_ue_ids;
+    uint32_t                                          next_mme_ue_s1ap_id;
+    uint32_t                                          next_m_tmsi;
+  };
+  std::vector<ue_shard_t> m_shards;
+  ue_shard_t&             get_shard_ctx();
+
+  // Shard of the UE context of each IMSI, with several shards. It routes the Attach Requests with an IMSI, and
+  // moves the UE context when its IMSI shows up in another shard, e.g. in the Identity Response after an unknown GUTI
+  std::mutex                             m_imsi_shard_mutex;
+  std::unordered_map<uint64_t, uint32_t> m_imsi_to_shard;
+  uint32_t                               get_imsi_shard(uint64_t imsi);
+  void                                   delete_moved_ue_ctx(uint64_t imsi);
 
   // GTP-C Interface
   mme_gtpc* m_mme_gtpc;
 
   // PCAP
   bool              m_pcap_enable;
+  std::mutex        m_pcap_mutex;
   srsran::s1ap_pcap m_pcap;
 };
 
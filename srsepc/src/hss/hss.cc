@@ -69,7 +69,8 @@ int hss::init(hss_args_t* hss_args)
   srand(time(NULL));
 
   /*Read user information from DB*/
-  if (read_db_file(hss_args->db_file) == false) {
+  bool db_ok = hss_db::is_db_file(hss_args->db_file) ? open_db(hss_args->db_file) : read_db_file(hss_args->db_file);
+  if (db_ok == false) {
     srsran::console("Error reading user database file %s\n", hss_args->db_file.c_str());
     return -1;
   }
@@ -86,10 +87,36 @@ int hss::init(hss_args_t* hss_args)
 
 void hss::stop()
 {
+  if (m_db.is_open()) {
+    // SQNs are already updated in place, just make sure they reach the disk
+    m_db.close();
+    return;
+  }
   write_db_file(db_file);
   return;
 }
 
+bool hss::open_db(std::string db_filename)
+{
+  if (not m_db.open(db_filename)) {
+    return false;
+  }
+
+  hss_db_record_t* records = m_db.records();
+  for (size_t i = 0; i < m_db.size(); i++) {
+    if (records[i].static_ip != 0) {
+      char ip_str[INET_ADDRSTRLEN] = {};
+      inet_ntop(AF_INET, &records[i].static_ip, ip_str, sizeof(ip_str));
+      if (not m_ip_to_imsi.insert(std::make_pair(std::string(ip_str), records[i].imsi)).second) {
+        m_logger.info("duplicate static ip addr %s", ip_str);
+        return false;
+      }
+    }
+  }
+  m_logger.info("Opened DB file: %s with %zd users", db_filename.c_str(), m_db.size());
+  return true;
+}
+
 bool hss::read_db_file(std::string db_filename)
 {
   std::ifstream m_db_file;
@@ -256,6 +283,7 @@ bool hss::write_db_file(std::string db_filename)
 
 bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
 
   m_logger.debug("Generating AUTH info answer");
   hss_ue_ctx_t* ue_ctx = get_ue_ctx(imsi);
@@ -274,6 +302,7 @@ bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, ui
       break;
   }
   increment_ue_sqn(ue_ctx);
+  store_ue_ctx(ue_ctx);
   return true;
 }
 
@@ -440,13 +469,13 @@ void hss::gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_
 
 bool hss::gen_update_loc_answer(uint64_t imsi, uint8_t* qci)
 {
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
-    m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  hss_ue_ctx_t* ue_ctx = get_ue_ctx(imsi);
+  if (ue_ctx == nullptr) {
     srsran::console("User not found at HSS. IMSI: %015" PRIu64 "\n", imsi);
     return false;
   }
-  const std::unique_ptr<hss_ue_ctx_t>& ue_ctx = ue_ctx_it->second;
   m_logger.info("Found User %015" PRIu64 "", imsi);
   *qci = ue_ctx->qci;
   return true;
@@ -454,6 +483,8 @@ bool hss::gen_update_loc_answer(uint64_t imsi, uint8_t* qci)
 
 bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
   m_logger.debug("Re-syncing SQN");
   hss_ue_ctx_t* ue_ctx = get_ue_ctx(imsi);
   if (ue_ctx == nullptr) {
@@ -472,6 +503,7 @@ bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
   }
 
   increment_seq_after_resync(ue_ctx);
+  store_ue_ctx(ue_ctx);
   return true;
 }
 
@@ -612,6 +644,26 @@ void hss::gen_rand(uint8_t rand_[16])
 
 hss_ue_ctx_t* hss::get_ue_ctx(uint64_t imsi)
 {
+  if (m_db.is_open()) {
+    m_db_record = m_db.find(imsi);
+    if (m_db_record == nullptr) {
+      m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
+      return nullptr;
+    }
+    // The name and the static IP are not needed for authentication, skip the string copies
+    m_db_ue_ctx.imsi          = m_db_record->imsi;
+    m_db_ue_ctx.algo          = (hss_auth_algo)m_db_record->algo;
+    m_db_ue_ctx.op_configured = m_db_record->op_configured != 0;
+    m_db_ue_ctx.qci           = m_db_record->qci;
+    memcpy(m_db_ue_ctx.key, m_db_record->key, sizeof(m_db_ue_ctx.key));
+    memcpy(m_db_ue_ctx.op, m_db_record->op, sizeof(m_db_ue_ctx.op));
+    memcpy(m_db_ue_ctx.opc, m_db_record->opc, sizeof(m_db_ue_ctx.opc));
+    memcpy(m_db_ue_ctx.amf, m_db_record->amf, sizeof(m_db_ue_ctx.amf));
+    memcpy(m_db_ue_ctx.sqn, m_db_record->sqn, sizeof(m_db_ue_ctx.sqn));
+    memcpy(m_db_ue_ctx.last_rand, m_db_record->last_rand, sizeof(m_db_ue_ctx.last_rand));
+    return &m_db_ue_ctx;
+  }
+
   std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
   if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
     m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
@@ -621,6 +673,17 @@ hss_ue_ctx_t* hss::get_ue_ctx(uint64_t imsi)
   return ue_ctx_it->second.get();
 }
 
+void hss::store_ue_ctx(hss_ue_ctx_t* ue_ctx)
+{
+  if (ue_ctx != &m_db_ue_ctx || m_db_record == nullptr) {
+    // Contexts read from the .csv are updated in place and written back in stop()
+    return;
+  }
+  memcpy(m_db_record->sqn, ue_ctx->sqn, sizeof(m_db_record->sqn));
+  memcpy(m_db_record->last_rand, ue_ctx->last_rand, sizeof(m_db_record->last_rand));
+  m_db.persist(m_db_record);
+}
+
 std::map<std::string, uint64_t> hss::get_ip_to_imsi(void) const
 {
   return m_ip_to_imsi;
@@ -0,0 +1,463 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsepc/hdr/hss/hss_db.h"
+#include "srsepc/hdr/hss/hss.h"
+#include "srsran/common/security.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cstring>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_set>
+
+namespace srsepc {
+
+hss_db::~hss_db()
+{
+  close();
+}
+
+bool hss_db::is_db_file(const std::string& path)
+{
+  char  magic[sizeof(hss_db_header_t::magic)] = {};
+  FILE* f                                     = fopen(path.c_str(), "rb");
+  if (f == nullptr) {
+    return false;
+  }
+  size_t n = fread(magic, 1, sizeof(magic), f);
+  fclose(f);
+  return n == sizeof(magic) && memcmp(magic, HSS_DB_MAGIC, sizeof(magic)) == 0;
+}
+
+bool hss_db::open(const std::string& path)
+{
+  close();
+
+  fd = ::open(path.c_str(), O_RDWR);
+  if (fd < 0) {
+    logger.error("Failed to open HSS database %s: %s", path.c_str(), strerror(errno));
+    return false;
+  }
+  struct stat st = {};
+  if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(hss_db_header_t)) {
+    logger.error("HSS database %s is too short", path.c_str());
+    close();
+    return false;
+  }
+  map_len  = (size_t)st.st_size;
+  void* p  = mmap(nullptr, map_len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  map_base = (p == MAP_FAILED) ? nullptr : (uint8_t*)p;
+  if (map_base == nullptr) {
+    logger.error("Failed to map HSS database %s: %s", path.c_str(), strerror(errno));
+    close();
+    return false;
+  }
+
+  const hss_db_header_t* hdr = (const hss_db_header_t*)map_base;
+  if (memcmp(hdr->magic, HSS_DB_MAGIC, sizeof(hdr->magic)) != 0 || hdr->version != HSS_DB_VERSION ||
+      hdr->record_size != sizeof(hss_db_record_t)) {
+    logger.error("%s is not a valid HSS database (version %d)", path.c_str(), hdr->version);
+    close();
+    return false;
+  }
+  bool buckets_ok = hdr->nof_buckets > 0 && (hdr->nof_buckets & (hdr->nof_buckets - 1)) == 0 &&
+                    hdr->nof_buckets > hdr->nof_records;
+  if (not buckets_ok || hdr->records_offset + hdr->nof_records * sizeof(hss_db_record_t) > map_len ||
+      hdr->index_offset + hdr->nof_buckets * sizeof(uint32_t) > map_len) {
+    logger.error("HSS database %s is corrupted", path.c_str());
+    close();
+    return false;
+  }
+
+  header       = hdr;
+  record_table = (hss_db_record_t*)(map_base + hdr->records_offset);
+  index        = (const uint32_t*)(map_base + hdr->index_offset);
+  nof_records  = hdr->nof_records;
+  bucket_mask  = hdr->nof_buckets - 1;
+
+  // The lookups jump randomly through the index, prefetch it
+  madvise(map_base, map_len, MADV_WILLNEED);
+
+  logger.info("Mapped HSS database %s with %" PRIu64 " subscribers", path.c_str(), nof_records);
+  return true;
+}
+
+void hss_db::close()
+{
+  if (map_base != nullptr) {
+    msync(map_base, map_len, MS_SYNC);
+    munmap(map_base, map_len);
+  }
+  if (fd >= 0) {
+    ::close(fd);
+  }
+  fd           = -1;
+  map_base     = nullptr;
+  map_len      = 0;
+  header       = nullptr;
+  record_table = nullptr;
+  index        = nullptr;
+  nof_records  = 0;
+  bucket_mask  = 0;
+}
+
+uint64_t hss_db::hash_imsi(uint64_t imsi)
+{
+  // splitmix64 finalizer. IMSIs of test subscribers are usually consecutive
+  imsi ^= imsi >> 30U;
+  imsi *= 0xbf58476d1ce4e5b9ULL;
+  imsi ^= imsi >> 27U;
+  imsi *= 0x94d049bb133111ebULL;
+  imsi ^= imsi >> 31U;
+  return imsi;
+}
+
+hss_db_record_t* hss_db::find(uint64_t imsi) const
+{
+  if (header == nullptr) {
+    return nullptr;
+  }
+  // A valid index always has an empty bucket, bound the probe anyway in case the file was corrupted after open()
+  uint64_t h = hash_imsi(imsi) & bucket_mask;
+  for (uint64_t n = 0; n <= bucket_mask; n++, h = (h + 1) & bucket_mask) {
+    uint32_t slot = index[h];
+    if (slot == 0) {
+      return nullptr;
+    }
+    if (slot - 1 >= nof_records) {
+      logger.error("HSS database index points to record %d of %" PRIu64, slot - 1, nof_records);
+      return nullptr;
+    }
+    hss_db_record_t* record = &record_table[slot - 1];
+    if (record->imsi == imsi) {
+      return record;
+    }
+  }
+  return nullptr;
+}
+
+void hss_db::persist(const hss_db_record_t* record) const
+{
+  if (map_base == nullptr) {
+    return;
+  }
+  static const uintptr_t page_mask = ~((uintptr_t)sysconf(_SC_PAGESIZE) - 1);
+  uintptr_t              begin     = (uintptr_t)record & page_mask;
+  uintptr_t              end       = (uintptr_t)(record + 1);
+  msync((void*)begin, end - begin, MS_ASYNC);
+}
+
+void hss_db::sync() const
+{
+  if (map_base != nullptr) {
+    msync(map_base, map_len, MS_SYNC);
+  }
+}
+
+bool hss_db::write(const std::string& path, const std::vector<hss_db_record_t>& records)
+{
+  srslog::basic_logger& log = srslog::fetch_basic_logger("HSS");
+
+  // Build the index. Keep the load factor at or below 50%
+  uint64_t nof_buckets = 16;
+  while (nof_buckets < 2 * records.size()) {
+    nof_buckets <<= 1U;
+  }
+  std::vector<uint32_t>        buckets(nof_buckets, 0);
+  std::vector<hss_db_record_t> kept;
+  kept.reserve(records.size());
+  for (const hss_db_record_t& record : records) {
+    uint64_t h = hash_imsi(record.imsi) & (nof_buckets - 1);
+    while (buckets[h] != 0 && kept[buckets[h] - 1].imsi != record.imsi) {
+      h = (h + 1) & (nof_buckets - 1);
+    }
+    if (buckets[h] != 0) {
+      log.warning("Duplicated IMSI %015" PRIu64 " in HSS database, ignoring it", record.imsi);
+      continue;
+    }
+    kept.push_back(record);
+    buckets[h] = (uint32_t)kept.size();
+  }
+
+  hss_db_header_t hdr = {};
+  memcpy(hdr.magic, HSS_DB_MAGIC, sizeof(hdr.magic));
+  hdr.version        = HSS_DB_VERSION;
+  hdr.record_size    = sizeof(hss_db_record_t);
+  hdr.nof_records    = kept.size();
+  hdr.nof_buckets    = nof_buckets;
+  hdr.records_offset = sizeof(hss_db_header_t);
+  hdr.index_offset   = hdr.records_offset + kept.size() * sizeof(hss_db_record_t);
+
+  // Write to a temporary file and rename it, so an interrupted conversion never leaves a truncated database
+  std::string tmp_path = path + ".tmp";
+  FILE*       f        = fopen(tmp_path.c_str(), "wb");
+  if (f == nullptr) {
+    log.error("Failed to create HSS database %s: %s", tmp_path.c_str(), strerror(errno));
+    return false;
+  }
+  bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1;
+  ok      = ok && (kept.empty() || fwrite(kept.data(), sizeof(hss_db_record_t), kept.size(), f) == kept.size());
+  ok      = ok && fwrite(buckets.data(), sizeof(uint32_t), buckets.size(), f) == buckets.size();
+  ok      = ok && fflush(f) == 0 && fsync(fileno(f)) == 0;
+  ok      = (fclose(f) == 0) && ok;
+  if (not ok || rename(tmp_path.c_str(), path.c_str()) != 0) {
+    log.error("Failed to write HSS database %s: %s", path.c_str(), strerror(errno));
+    unlink(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+static bool parse_hex(const char* begin, const char* end, uint8_t* out, uint32_t len)
+{
+  if (end - begin < 2 * (ptrdiff_t)len) {
+    return false;
+  }
+  for (uint32_t i = 0; i < 2 * len; i++) {
+    char    c      = begin[i];
+    uint8_t nibble = 0;
+    if (c >= '0' && c <= '9') {
+      nibble = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      nibble = c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      nibble = c - 'A' + 10;
+    } else {
+      return false;
+    }
+    out[i / 2] = (i % 2 == 0) ? (uint8_t)(nibble << 4U) : (uint8_t)(out[i / 2] | nibble);
+  }
+  return true;
+}
+
+static bool field_equals(const char* begin, const char* end, const char* str)
+{
+  size_t len = strlen(str);
+  return (size_t)(end - begin) == len && memcmp(begin, str, len) == 0;
+}
+
+bool hss_db::parse_csv_line(const char* begin, const char* end, hss_db_record_t& record, std::string& error)
+{
+  const uint32_t column_size = 10;
+  const char*    fields[column_size + 1];
+  uint32_t       nof_fields = 0;
+
+  // Ignore Windows line endings
+  if (end > begin && end[-1] == '\r') {
+    end--;
+  }
+
+  fields[nof_fields++] = begin;
+  for (const char* p = begin; p < end; p++) {
+    if (*p == ',') {
+      if (nof_fields == column_size) {
+        error = "Wrong number of columns in .csv";
+        return false;
+      }
+      fields[nof_fields++] = p + 1;
+    }
+  }
+  if (nof_fields != column_size) {
+    error = "Wrong number of columns in .csv";
+    return false;
+  }
+  fields[column_size] = end + 1;
+#define FIELD(i) fields[i], fields[(i) + 1] - 1
+
+  record = {};
+  memcpy(record.name, fields[0], std::min<size_t>(fields[1] - 1 - fields[0], HSS_DB_NAME_LEN));
+
+  if (field_equals(FIELD(1), "xor")) {
+    record.algo = HSS_ALGO_XOR;
+  } else if (field_equals(FIELD(1), "mil")) {
+    record.algo = HSS_ALGO_MILENAGE;
+  } else {
+    error = "Neither XOR nor MILENAGE configured.";
+    return false;
+  }
+
+  for (const char* p = fields[2]; p < fields[3] - 1; p++) {
+    if (*p < '0' || *p > '9') {
+      error = "Invalid IMSI";
+      return false;
+    }
+    record.imsi = record.imsi * 10 + (uint64_t)(*p - '0');
+  }
+
+  if (not parse_hex(FIELD(3), record.key, 16)) {
+    error = "Invalid key";
+    return false;
+  }
+  if (field_equals(FIELD(4), "op")) {
+    record.op_configured = 1;
+    if (not parse_hex(FIELD(5), record.op, 16)) {
+      error = "Invalid OP";
+      return false;
+    }
+    srsran::compute_opc(record.key, record.op, record.opc);
+  } else if (field_equals(FIELD(4), "opc")) {
+    record.op_configured = 0;
+    if (not parse_hex(FIELD(5), record.opc, 16)) {
+      error = "Invalid OPc";
+      return false;
+    }
+  } else {
+    error = "Neither OP nor OPc configured.";
+    return false;
+  }
+  if (not parse_hex(FIELD(6), record.amf, 2) || not parse_hex(FIELD(7), record.sqn, 6)) {
+    error = "Invalid AMF or SQN";
+    return false;
+  }
+  record.qci = (uint16_t)strtol(std::string(FIELD(8)).c_str(), nullptr, 10);
+
+  if (field_equals(FIELD(9), "dynamic")) {
+    record.static_ip = 0;
+  } else {
+    std::string ip(FIELD(9));
+    if (inet_pton(AF_INET, ip.c_str(), &record.static_ip) != 1) {
+      error = "Invalid static ip addr " + ip;
+      return false;
+    }
+  }
+#undef FIELD
+  return true;
+}
+
+namespace {
+
+struct csv_chunk_result {
+  std::vector<hss_db_record_t> records;
+  std::string                  error;
+  const char*                  error_line = nullptr;
+};
+
+void parse_csv_chunk(const char* begin, const char* end, csv_chunk_result& result)
+{
+  result.records.reserve((end - begin) / 100);
+  while (begin < end) {
+    const char* eol = (const char*)memchr(begin, '\n', end - begin);
+    if (eol == nullptr) {
+      eol = end;
+    }
+    if (eol > begin && begin[0] != '#' && !(eol - begin == 1 && begin[0] == '\r')) {
+      hss_db_record_t record;
+      if (not hss_db::parse_csv_line(begin, eol, record, result.error)) {
+        result.error_line = begin;
+        return;
+      }
+      result.records.push_back(record);
+    }
+    begin = eol + 1;
+  }
+}
+
+} // namespace
+
+bool hss_db::convert_csv(const std::string& csv_path, const std::string& db_path, uint32_t nof_threads)
+{
+  srslog::basic_logger& log = srslog::fetch_basic_logger("HSS");
+
+  int csv_fd = ::open(csv_path.c_str(), O_RDONLY);
+  if (csv_fd < 0) {
+    log.error("Failed to open %s: %s", csv_path.c_str(), strerror(errno));
+    return false;
+  }
+  struct stat st = {};
+  fstat(csv_fd, &st);
+  size_t      len  = (size_t)st.st_size;
+  const char* data = nullptr;
+  if (len > 0) {
+    void* p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, csv_fd, 0);
+    data    = (p == MAP_FAILED) ? nullptr : (const char*)p;
+  }
+  ::close(csv_fd);
+  if (len > 0 && data == nullptr) {
+    log.error("Failed to map %s: %s", csv_path.c_str(), strerror(errno));
+    return false;
+  }
+
+  if (nof_threads == 0) {
+    nof_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  // Do not bother spawning threads for small files
+  nof_threads = std::max<uint32_t>(1, std::min<size_t>(nof_threads, len / (1024 * 1024) + 1));
+
+  // Split the file at line boundaries and parse the chunks in parallel
+  std::vector<const char*> bounds(nof_threads + 1, data + len);
+  bounds[0] = data;
+  for (uint32_t i = 1; i < nof_threads; i++) {
+    const char* p   = std::max(bounds[i - 1], data + len * i / nof_threads);
+    const char* eol = (const char*)memchr(p, '\n', data + len - p);
+    bounds[i]       = (eol != nullptr) ? eol + 1 : data + len;
+  }
+  std::vector<csv_chunk_result> results(nof_threads);
+  std::vector<std::thread>      workers;
+  for (uint32_t i = 1; i < nof_threads; i++) {
+    workers.emplace_back(parse_csv_chunk, bounds[i], bounds[i + 1], std::ref(results[i]));
+  }
+  parse_csv_chunk(bounds[0], bounds[1], results[0]);
+  for (std::thread& t : workers) {
+    t.join();
+  }
+
+  std::vector<hss_db_record_t> records;
+  std::unordered_set<uint32_t> static_ips;
+  bool                         ok = true;
+  for (csv_chunk_result& result : results) {
+    if (result.error_line != nullptr) {
+      size_t line_nr = std::count(data, result.error_line, '\n') + 1;
+      log.error("Error parsing %s line %zd: %s", csv_path.c_str(), line_nr, result.error.c_str());
+      ok = false;
+      break;
+    }
+    for (const hss_db_record_t& record : result.records) {
+      if (record.static_ip != 0 && not static_ips.insert(record.static_ip).second) {
+        char ip_str[INET_ADDRSTRLEN] = {};
+        inet_ntop(AF_INET, &record.static_ip, ip_str, sizeof(ip_str));
+        log.error("Duplicated static ip addr %s", ip_str);
+        ok = false;
+        break;
+      }
+    }
+    if (not ok) {
+      break;
+    }
+    records.insert(records.end(), result.records.begin(), result.records.end());
+  }
+  if (data != nullptr) {
+    munmap((void*)data, len);
+  }
+
+  if (ok) {
+    ok = write(db_path, records);
+  }
+  if (ok) {
+    log.info("Converted %zd subscribers from %s to %s", records.size(), csv_path.c_str(), db_path.c_str());
+  }
+  return ok;
+}
+
+} // namespace srsepc
@@ -0,0 +1,64 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Converts a user_db.csv file into the memory-mapped binary database of the HSS. The output can be given as
+ * hss.db_file to srsepc, which then updates the SQNs in place instead of rewriting the .csv file at exit.
+ */
+
+#include "srsepc/hdr/hss/hss_db.h"
+#include "srsran/srslog/srslog.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3 || argc > 4) {
+    printf("Usage: %s <user_db.csv> <user_db.db> [nof_threads]\n", argv[0]);
+    return -1;
+  }
+  uint32_t nof_threads = (argc == 4) ? (uint32_t)strtoul(argv[3], NULL, 10) : 0;
+
+  srslog::init();
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("HSS", false);
+  logger.set_level(srslog::basic_levels::info);
+
+  auto start = std::chrono::steady_clock::now();
+  if (not srsepc::hss_db::convert_csv(argv[1], argv[2], nof_threads)) {
+    srslog::flush();
+    fprintf(stderr, "Failed to convert %s\n", argv[1]);
+    return -1;
+  }
+  std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+
+  srsepc::hss_db db;
+  if (not db.open(argv[2])) {
+    srslog::flush();
+    fprintf(stderr, "Failed to open %s after writing it\n", argv[2]);
+    return -1;
+  }
+  size_t nof_subscribers = db.size();
+  db.close();
+  srslog::flush();
+  printf("Wrote %zd subscribers to %s in %.3f s\n", nof_subscribers, argv[2], secs.count());
+  return 0;
+}
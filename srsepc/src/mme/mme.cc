@@ -20,6 +20,7 @@
  */
 
 #include "srsepc/hdr/mme/mme.h"
+#include <algorithm>
 #include <arpa/inet.h>
 #include <inttypes.h> // for printing uint64_t
 #include <netinet/sctp.h>
@@ -31,6 +32,9 @@ namespace srsepc {
 mme*            mme::m_instance    = NULL;
 pthread_mutex_t mme_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+// Worker of the calling thread, null in the MME thread
+static thread_local mme_worker* current_worker = nullptr;
+
 mme::mme() : m_running(false), thread("MME")
 {
   return;
@@ -63,22 +67,35 @@ void mme::cleanup(void)
 
 int mme::init(mme_args_t* args)
 {
+  uint32_t nof_shards = std::max(args->nof_workers, 1U);
+
   /*Init S1AP*/
   m_s1ap = s1ap::get_instance();
-  if (m_s1ap->init(args->s1ap_args)) {
+  if (m_s1ap->init(args->s1ap_args, nof_shards)) {
     m_s1ap_logger.error("Error initializing MME S1APP");
     exit(-1);
   }
 
   /*Init GTP-C*/
   m_mme_gtpc = mme_gtpc::get_instance();
-  if (!m_mme_gtpc->init()) {
+  if (!m_mme_gtpc->init(nof_shards)) {
     srsran::console("Error initializing GTP-C\n");
     exit(-1);
   }
 
+  /*Init workers*/
+  if (nof_shards > 1) {
+    for (uint32_t i = 0; i < nof_shards; i++) {
+      m_workers.emplace_back(new mme_worker(i, worker_queue_size));
+      m_workers.back()->start();
+    }
+  }
+
   /*Log successful initialization*/
-  m_s1ap_logger.info("MME Initialized. MCC: 0x%x, MNC: 0x%x", args->s1ap_args.mcc, args->s1ap_args.mnc);
+  m_s1ap_logger.info("MME Initialized. MCC: 0x%x, MNC: 0x%x, workers: %d",
+                     args->s1ap_args.mcc,
+                     args->s1ap_args.mnc,
+                     nof_shards);
   srsran::console("MME Initialized. MCC: 0x%x, MNC: 0x%x\n", args->s1ap_args.mcc, args->s1ap_args.mnc);
   return 0;
 }
@@ -86,11 +103,17 @@ int mme::init(mme_args_t* args)
 void mme::stop()
 {
   if (m_running) {
-    m_s1ap->stop();
-    m_s1ap->cleanup();
     m_running = false;
     thread_cancel();
     wait_thread_finish();
+
+    // The UE contexts are deleted once their workers are done, their NAS timers are released to the worker wheels
+    for (std::unique_ptr<mme_worker>& worker : m_workers) {
+      worker->stop();
+    }
+    m_s1ap->stop();
+    m_s1ap->cleanup();
+    m_workers.clear();
   }
   return;
 }
@@ -126,15 +149,13 @@ void mme::run_thread()
     FD_SET(s1mme, &m_set);
     FD_SET(s11, &m_set);
 
-    // Add timers to select
-    for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end(); ++it) {
-      FD_SET(it->fd, &m_set);
-      max_fd = std::max(max_fd, it->fd);
-      m_s1ap_logger.debug("Adding Timer fd %d to fd_set", it->fd);
-    }
+    // Wake up for the next NAS timer expiry, only while any of them is running
+    struct timeval  tick_timeout = {};
+    struct timeval* timeout      = get_timers_timeout(&tick_timeout);
 
     m_s1ap_logger.debug("Waiting for S1-MME or S11 Message");
-    int n = select(max_fd + 1, &m_set, NULL, NULL, NULL);
+    int n = select(max_fd + 1, &m_set, NULL, NULL, timeout);
+    timers.step();
     if (n == -1) {
       m_s1ap_logger.error("Error from select");
     } else if (n) {
@@ -159,81 +180,170 @@ void mme::run_thread()
             // Received data
             pdu->N_bytes = rd_sz;
             m_s1ap_logger.info("Received S1AP msg. Size: %d", pdu->N_bytes);
-            m_s1ap->handle_s1ap_rx_pdu(pdu.get(), &sri);
+            if (m_workers.empty()) {
+              m_s1ap->handle_s1ap_rx_pdu(pdu.get(), &sri);
+            } else {
+              dispatch_s1ap_pdu(pdu.get(), sri);
+            }
           }
         }
       }
       // Handle S11
       if (FD_ISSET(s11, &m_set)) {
         pdu->N_bytes = recvfrom(s11, pdu->msg, sz, 0, NULL, NULL);
-        m_mme_gtpc->handle_s11_pdu(pdu.get());
-      }
-      // Handle NAS Timers
-      for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end();) {
-        if (FD_ISSET(it->fd, &m_set)) {
-          m_s1ap_logger.info("Timer expired");
-          uint64_t exp;
-          rd_sz = read(it->fd, &exp, sizeof(uint64_t));
-          m_s1ap->expire_nas_timer(it->type, it->imsi);
-          close(it->fd);
-          timers.erase(it);
+        if (m_workers.empty()) {
+          m_mme_gtpc->handle_s11_pdu(pdu.get());
         } else {
-          ++it;
+          dispatch_s11_pdu(pdu.get());
         }
       }
-    } else {
-      m_s1ap_logger.debug("No data from select.");
     }
   }
   return;
 }
 
 /*
- * Timer Handling
+ * Dispatch to the workers
  */
-bool mme::add_nas_timer(int timer_fd, nas_timer_type type, uint64_t imsi)
+void mme::dispatch_s1ap_pdu(srsran::byte_buffer_t* pdu, const struct sctp_sndrcvinfo& sri)
 {
-  m_s1ap_logger.debug("Adding NAS timer to MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, timer_fd);
+  // The PDU is unpacked once, to find the shard of the UE, and handed over to its worker
+  std::unique_ptr<s1ap_pdu_t> rx_pdu(new s1ap_pdu_t());
+  if (!m_s1ap->unpack_s1ap_rx_pdu(pdu, *rx_pdu)) {
+    return;
+  }
+  uint32_t shard = m_s1ap->get_s1ap_pdu_shard(*rx_pdu);
+  push_shard_task(shard, [this, rx_pdu = std::move(rx_pdu), enb_sri = sri]() mutable {
+    m_s1ap->handle_s1ap_rx_pdu(*rx_pdu, &enb_sri);
+  });
+}
+
+void mme::dispatch_s11_pdu(srsran::byte_buffer_t* pdu)
+{
+  srsran::unique_byte_buffer_t s11_pdu = srsran::make_byte_buffer();
+  if (s11_pdu == nullptr || pdu->N_bytes < sizeof(srsran::gtpc_header)) {
+    m_s1ap_logger.error("Dropping S11 message of %d bytes", pdu->N_bytes);
+    return;
+  }
+  memcpy(s11_pdu->msg, pdu->msg, pdu->N_bytes);
+  s11_pdu->N_bytes = pdu->N_bytes;
 
-  mme_timer_t timer;
-  timer.fd   = timer_fd;
-  timer.type = type;
-  timer.imsi = imsi;
+  // The S-GW addresses the UE with its MME control TEID, which was allocated by the shard of the UE
+  uint32_t teid  = ((srsran::gtpc_header*)s11_pdu->msg)->teid;
+  uint32_t shard = teid % m_workers.size();
+  push_shard_task(shard, [this, s11_pdu = std::move(s11_pdu)]() { m_mme_gtpc->handle_s11_pdu(s11_pdu.get()); });
+}
 
-  timers.push_back(timer);
+uint32_t mme::get_current_shard()
+{
+  return current_worker != nullptr ? current_worker->get_shard_idx() : 0;
+}
+
+bool mme::push_shard_task(uint32_t shard, mme_worker::task_t&& task)
+{
+  if (m_workers.empty()) {
+    task();
+    return true;
+  }
+  if (!m_workers[shard]->push_task(std::move(task), current_worker == nullptr)) {
+    m_s1ap_logger.error("Could not push task to MME worker %d", shard);
+    return false;
+  }
   return true;
 }
 
-bool mme::is_nas_timer_running(nas_timer_type type, uint64_t imsi)
+/*
+ * Workers
+ */
+mme_worker::mme_worker(uint32_t shard_idx_, uint32_t queue_size) :
+  thread("MME_W" + std::to_string(shard_idx_)), shard_idx(shard_idx_), pending_tasks(queue_size)
+{}
+
+void mme_worker::stop()
 {
-  std::vector<mme_timer_t>::iterator it;
-  for (it = timers.begin(); it != timers.end(); ++it) {
-    if (it->type == type && it->imsi == imsi) {
-      return true; // found timer
-    }
+  pending_tasks.stop();
+  wait_thread_finish();
+}
+
+bool mme_worker::push_task(task_t&& task, bool blocking)
+{
+  if (blocking) {
+    return not pending_tasks.push_blocking(std::move(task)).is_error();
   }
-  return false;
+  return not pending_tasks.try_push(std::move(task)).is_error();
 }
 
-bool mme::remove_nas_timer(nas_timer_type type, uint64_t imsi)
+void mme_worker::run_thread()
 {
-  std::vector<mme_timer_t>::iterator it;
-  for (it = timers.begin(); it != timers.end(); ++it) {
-    if (it->type == type && it->imsi == imsi) {
-      break; // found timer to remove
+  current_worker = this;
+  while (true) {
+    // Wait for the next task, or for the next NAS timer expiry while any of them is running
+    std::chrono::steady_clock::time_point expiry;
+    task_t                                task;
+    bool                                  popped = false;
+    if (timers.get_next_expiry(&expiry)) {
+      popped = pending_tasks.pop_wait_until(task, expiry);
+    } else {
+      task = pending_tasks.pop_blocking(&popped);
+    }
+    timers.step();
+    if (popped) {
+      task();
+    } else if (pending_tasks.is_stopped()) {
+      break;
     }
   }
-  if (it == timers.end()) {
-    m_s1ap_logger.warning("Could not find timer to remove. IMSI %" PRIu64 ", Type %d", imsi, type);
-    return false;
+  current_worker = nullptr;
+}
+
+/*
+ * Timer Handling
+ */
+srsran::unique_timer mme::get_unique_timer()
+{
+  // The NAS timers run in the thread of the shard of the UE
+  if (current_worker != nullptr) {
+    return current_worker->get_unique_timer();
+  }
+  return timers.get_unique_timer();
+}
+
+void mme_timer_wheel::step()
+{
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  if (timers.nof_running_timers() == 0) {
+    // Timers started from now on count from this point
+    last_tic = now;
+    return;
   }
+  // Catch up with the ticks missed while handling messages
+  while (now - last_tic >= std::chrono::milliseconds(1)) {
+    last_tic += std::chrono::milliseconds(1);
+    timers.step_all();
+  }
+}
 
-  // removing timer
-  m_s1ap_logger.debug("Removing NAS timer from MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, it->fd);
-  FD_CLR(it->fd, &m_set);
-  close(it->fd);
-  timers.erase(it);
+bool mme_timer_wheel::get_next_expiry(std::chrono::steady_clock::time_point* expiry)
+{
+  if (timers.nof_running_timers() == 0) {
+    return false;
+  }
+  *expiry = last_tic + std::chrono::milliseconds(timers.nof_tics_to_next_expiry(max_sleep_ms));
   return true;
 }
 
+struct timeval* mme::get_timers_timeout(struct timeval* timeout)
+{
+  std::chrono::steady_clock::time_point expiry;
+  if (!timers.get_next_expiry(&expiry)) {
+    return NULL;
+  }
+  std::chrono::microseconds sleep_time =
+      std::chrono::duration_cast<std::chrono::microseconds>(expiry - std::chrono::steady_clock::now());
+  int64_t sleep_us = std::max(static_cast<int64_t>(sleep_time.count()), static_cast<int64_t>(0));
+  timeout->tv_sec  = sleep_us / 1000000;
+  timeout->tv_usec = sleep_us % 1000000;
+  return timeout;
+}
+
 } // namespace srsepc
@@ -20,6 +20,7 @@
  */
 
 #include "srsepc/hdr/mme/mme_gtpc.h"
+#include "srsepc/hdr/mme/mme.h"
 #include "srsepc/hdr/mme/s1ap.h"
 #include "srsepc/hdr/spgw/spgw.h"
 #include "srsran/asn1/gtpc.h"
@@ -33,9 +34,13 @@ mme_gtpc* mme_gtpc::get_instance()
   return instance.get();
 }
 
-bool mme_gtpc::init()
+bool mme_gtpc::init(uint32_t nof_shards)
 {
-  m_next_ctrl_teid = 1;
+  // TEID 0 is the butler TEID of the SPGW
+  m_next_ctrl_teid.resize(nof_shards);
+  for (uint32_t i = 0; i < nof_shards; i++) {
+    m_next_ctrl_teid[i] = (i == 0) ? nof_shards : i;
+  }
 
   m_s1ap = s1ap::get_instance();
 
@@ -89,6 +94,14 @@ bool mme_gtpc::init_s11()
   return true;
 }
 
+uint32_t mme_gtpc::get_new_ctrl_teid()
+{
+  uint32_t shard = mme::get_current_shard();
+  uint32_t teid  = m_next_ctrl_teid[shard];
+  m_next_ctrl_teid[shard] += m_next_ctrl_teid.size();
+  return teid;
+}
+
 bool mme_gtpc::send_s11_pdu(const srsran::gtpc_pdu& pdu)
 {
   int n;
@@ -151,7 +164,7 @@ bool mme_gtpc::send_create_session_request(uint64_t imsi)
   // Control TEID allocated
   cs_req->sender_f_teid.teid = get_new_ctrl_teid();
 
-  m_logger.info("Next MME control TEID: %d", m_next_ctrl_teid);
+  m_logger.info("Next MME control TEID: %d", m_next_ctrl_teid[mme::get_current_shard()]);
   m_logger.info("Allocated MME control TEID: %d", cs_req->sender_f_teid.teid);
   srsran::console("Creating Session Response -- IMSI: %" PRIu64 "\n", imsi);
   srsran::console("Creating Session Response -- MME control TEID: %d\n", cs_req->sender_f_teid.teid);
@@ -167,11 +180,12 @@ bool mme_gtpc::send_create_session_request(uint64_t imsi)
   cs_req->eps_bearer_context_created.ebi = 5;
 
   // Check whether this UE is already registed
-  std::map<uint64_t, struct gtpc_ctx>::iterator it = m_imsi_to_gtpc_ctx.find(imsi);
+  std::lock_guard<std::mutex>                             lock(m_mutex);
+  std::unordered_map<uint64_t, struct gtpc_ctx>::iterator it = m_imsi_to_gtpc_ctx.find(imsi);
   if (it != m_imsi_to_gtpc_ctx.end()) {
     m_logger.warning("Create Session Request being called for an UE with an active GTP-C connection.");
     m_logger.warning("Deleting previous GTP-C connection.");
-    std::map<uint32_t, uint64_t>::iterator jt = m_mme_ctr_teid_to_imsi.find(it->second.mme_ctr_fteid.teid);
+    std::unordered_map<uint32_t, uint64_t>::iterator jt = m_mme_ctr_teid_to_imsi.find(it->second.mme_ctr_fteid.teid);
     if (jt == m_mme_ctr_teid_to_imsi.end()) {
       m_logger.error("Could not find IMSI from MME Ctrl TEID. MME Ctr TEID: %d", it->second.mme_ctr_fteid.teid);
     } else {
@@ -213,12 +227,16 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
   }
 
   // Get IMSI from the control TEID
-  std::map<uint32_t, uint64_t>::iterator id_it = m_mme_ctr_teid_to_imsi.find(cs_resp_pdu->header.teid);
-  if (id_it == m_mme_ctr_teid_to_imsi.end()) {
-    m_logger.warning("Could not find IMSI from Ctrl TEID.");
-    return false;
+  uint64_t imsi = 0;
+  {
+    std::lock_guard<std::mutex>                      lock(m_mutex);
+    std::unordered_map<uint32_t, uint64_t>::iterator id_it = m_mme_ctr_teid_to_imsi.find(cs_resp_pdu->header.teid);
+    if (id_it == m_mme_ctr_teid_to_imsi.end()) {
+      m_logger.warning("Could not find IMSI from Ctrl TEID.");
+      return false;
+    }
+    imsi = id_it->second;
   }
-  uint64_t imsi = id_it->second;
 
   m_logger.info("MME GTPC Ctrl TEID %" PRIu64 ", IMSI %" PRIu64 "", cs_resp_pdu->header.teid, imsi);
 
@@ -263,14 +281,17 @@ bool mme_gtpc::handle_create_session_response(srsran::gtpc_pdu* cs_resp_pdu)
   srsran::console("SPGW Allocated IP %s to IMSI %015" PRIu64 "\n", inet_ntoa(emm_ctx->ue_ip), emm_ctx->imsi);
 
   // Save SGW ctrl F-TEID in GTP-C context
-  std::map<uint64_t, struct gtpc_ctx>::iterator it_g = m_imsi_to_gtpc_ctx.find(imsi);
-  if (it_g == m_imsi_to_gtpc_ctx.end()) {
-    // Could not find GTP-C Context
-    m_logger.error("Could not find GTP-C context");
-    return false;
+  {
+    std::lock_guard<std::mutex>                             lock(m_mutex);
+    std::unordered_map<uint64_t, struct gtpc_ctx>::iterator it_g = m_imsi_to_gtpc_ctx.find(imsi);
+    if (it_g == m_imsi_to_gtpc_ctx.end()) {
+      // Could not find GTP-C Context
+      m_logger.error("Could not find GTP-C context");
+      return false;
+    }
+    gtpc_ctx_t* gtpc_ctx    = &it_g->second;
+    gtpc_ctx->sgw_ctr_fteid = sgw_ctr_fteid;
   }
-  gtpc_ctx_t* gtpc_ctx    = &it_g->second;
-  gtpc_ctx->sgw_ctr_fteid = sgw_ctr_fteid;
 
   // Set EPS bearer context
   // TODO default EPS bearer is hard-coded
@@ -288,7 +309,8 @@ bool mme_gtpc::send_modify_bearer_request(uint64_t imsi, uint16_t erab_to_modify
   srsran::gtpc_pdu mb_req_pdu;
   std::memset(&mb_req_pdu, 0, sizeof(mb_req_pdu));
 
-  std::map<uint64_t, gtpc_ctx_t>::iterator it = m_imsi_to_gtpc_ctx.find(imsi);
+  std::lock_guard<std::mutex>                        lock(m_mutex);
+  std::unordered_map<uint64_t, gtpc_ctx_t>::iterator it = m_imsi_to_gtpc_ctx.find(imsi);
   if (it == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("Modify bearer request for UE without GTP-C connection");
     return false;
@@ -317,16 +339,21 @@ bool mme_gtpc::send_modify_bearer_request(uint64_t imsi, uint16_t erab_to_modify
 
 void mme_gtpc::handle_modify_bearer_response(srsran::gtpc_pdu* mb_resp_pdu)
 {
-  uint32_t                               mme_ctrl_teid = mb_resp_pdu->header.teid;
-  std::map<uint32_t, uint64_t>::iterator imsi_it       = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
-  if (imsi_it == m_mme_ctr_teid_to_imsi.end()) {
-    m_logger.error("Could not find IMSI from control TEID");
-    return;
+  uint32_t mme_ctrl_teid = mb_resp_pdu->header.teid;
+  uint64_t imsi          = 0;
+  {
+    std::lock_guard<std::mutex>                      lock(m_mutex);
+    std::unordered_map<uint32_t, uint64_t>::iterator imsi_it = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
+    if (imsi_it == m_mme_ctr_teid_to_imsi.end()) {
+      m_logger.error("Could not find IMSI from control TEID");
+      return;
+    }
+    imsi = imsi_it->second;
   }
 
   uint8_t ebi = mb_resp_pdu->choice.modify_bearer_response.eps_bearer_context_modified.ebi;
   m_logger.debug("Activating EPS bearer with id %d", ebi);
-  m_s1ap->activate_eps_bearer(imsi_it->second, ebi);
+  m_s1ap->activate_eps_bearer(imsi, ebi);
 
   return;
 }
@@ -340,7 +367,8 @@ bool mme_gtpc::send_delete_session_request(uint64_t imsi)
   srsran::gtp_fteid_t mme_ctr_fteid;
 
   // Get S-GW Ctr TEID
-  std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
+  std::lock_guard<std::mutex>                        lock(m_mutex);
+  std::unordered_map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("Could not find GTP-C context to remove");
     return false;
@@ -361,7 +389,7 @@ bool mme_gtpc::send_delete_session_request(uint64_t imsi)
   send_s11_pdu(del_req_pdu);
 
   // Delete GTP-C context
-  std::map<uint32_t, uint64_t>::iterator it_imsi = m_mme_ctr_teid_to_imsi.find(mme_ctr_fteid.teid);
+  std::unordered_map<uint32_t, uint64_t>::iterator it_imsi = m_mme_ctr_teid_to_imsi.find(mme_ctr_fteid.teid);
   if (it_imsi == m_mme_ctr_teid_to_imsi.end()) {
     m_logger.error("Could not find IMSI from MME ctr TEID");
   } else {
@@ -380,7 +408,8 @@ void mme_gtpc::send_release_access_bearers_request(uint64_t imsi)
   srsran::gtp_fteid_t sgw_ctr_fteid;
 
   // Get S-GW Ctr TEID
-  std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
+  std::lock_guard<std::mutex>                        lock(m_mutex);
+  std::unordered_map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("Could not find GTP-C context to remove");
     return;
@@ -406,10 +435,15 @@ bool mme_gtpc::handle_downlink_data_notification(srsran::gtpc_pdu* dl_not_pdu)
 {
   uint32_t                                 mme_ctrl_teid = dl_not_pdu->header.teid;
   srsran::gtpc_downlink_data_notification* dl_not        = &dl_not_pdu->choice.downlink_data_notification;
-  std::map<uint32_t, uint64_t>::iterator   imsi_it       = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
-  if (imsi_it == m_mme_ctr_teid_to_imsi.end()) {
-    m_logger.error("Could not find IMSI from control TEID");
-    return false;
+  uint64_t                                 imsi          = 0;
+  {
+    std::lock_guard<std::mutex>                      lock(m_mutex);
+    std::unordered_map<uint32_t, uint64_t>::iterator imsi_it = m_mme_ctr_teid_to_imsi.find(mme_ctrl_teid);
+    if (imsi_it == m_mme_ctr_teid_to_imsi.end()) {
+      m_logger.error("Could not find IMSI from control TEID");
+      return false;
+    }
+    imsi = imsi_it->second;
   }
 
   if (!dl_not->eps_bearer_id_present) {
@@ -417,9 +451,9 @@ bool mme_gtpc::handle_downlink_data_notification(srsran::gtpc_pdu* dl_not_pdu)
     return false;
   }
   uint8_t ebi = dl_not->eps_bearer_id;
-  m_logger.debug("Downlink Data Notification -- IMSI: %015" PRIu64 ", EBI %d", imsi_it->second, ebi);
+  m_logger.debug("Downlink Data Notification -- IMSI: %015" PRIu64 ", EBI %d", imsi, ebi);
 
-  m_s1ap->send_paging(imsi_it->second, ebi);
+  m_s1ap->send_paging(imsi, ebi);
   return true;
 }
 
@@ -431,7 +465,8 @@ void mme_gtpc::send_downlink_data_notification_acknowledge(uint64_t imsi, enum s
   std::memset(&not_ack_pdu, 0, sizeof(not_ack_pdu));
 
   // get s-gw ctr teid
-  std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
+  std::lock_guard<std::mutex>                        lock(m_mutex);
+  std::unordered_map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("could not find gtp-c context to remove");
     return;
@@ -461,7 +496,8 @@ bool mme_gtpc::send_downlink_data_notification_failure_indication(uint64_t imsi,
   std::memset(&not_fail_pdu, 0, sizeof(not_fail_pdu));
 
   // get s-gw ctr teid
-  std::map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
+  std::lock_guard<std::mutex>                        lock(m_mutex);
+  std::unordered_map<uint64_t, gtpc_ctx_t>::iterator it_ctx = m_imsi_to_gtpc_ctx.find(imsi);
   if (it_ctx == m_imsi_to_gtpc_ctx.end()) {
     m_logger.error("could not find gtp-c context to send paging failure");
     return false;
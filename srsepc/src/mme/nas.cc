@@ -26,7 +26,6 @@
 #include <cmath>
 #include <inttypes.h> // for printing uint64_t
 #include <netinet/sctp.h>
-#include <sys/timerfd.h>
 #include <time.h>
 
 namespace srsepc {
@@ -593,7 +592,6 @@ bool nas::handle_service_request(uint32_t                m_tmsi,
   s1ap_interface_nas* s1ap = itf.s1ap;
   hss_interface_nas*  hss  = itf.hss;
   gtpc_interface_nas* gtpc = itf.gtpc;
-  mme_interface_nas*  mme  = itf.mme;
 
   LIBLTE_ERROR_ENUM err = liblte_mme_unpack_service_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &service_req);
   if (err != LIBLTE_SUCCESS) {
@@ -684,9 +682,7 @@ bool nas::handle_service_request(uint32_t                m_tmsi,
     srsran::console("UE Ctr TEID %d\n", emm_ctx->sgw_ctrl_fteid.teid);
 
     // Stop T3413 if running
-    if (mme->is_nas_timer_running(T_3413, emm_ctx->imsi)) {
-      mme->remove_nas_timer(T_3413, emm_ctx->imsi);
-    }
+    nas_ctx->stop_timer(T_3413);
 
     // Save UE ctx to MME UE S1AP id
     s1ap->add_nas_ctx_to_mme_ue_s1ap_id_map(nas_ctx);
@@ -2027,6 +2023,20 @@ bool nas::start_timer(enum nas_timer_type type)
   return err;
 }
 
+void nas::stop_timer(enum nas_timer_type type)
+{
+  switch (type) {
+    case T_3413:
+      if (m_t3413_timer.is_running()) {
+        m_logger.debug("Stopping T3413 Timer");
+        m_t3413_timer.stop();
+      }
+      break;
+    default:
+      m_logger.error("Invalid timer type");
+  }
+}
+
 bool nas::expire_timer(enum nas_timer_type type)
 {
   m_logger.debug("NAS timer expired");
@@ -2050,24 +2060,12 @@ bool nas::start_t3413()
     return false;
   }
 
-  int fdt = timerfd_create(CLOCK_MONOTONIC, 0);
-  if (fdt < 0) {
-    m_logger.error("Error creating timer. %s", strerror(errno));
-    return false;
-  }
-  struct itimerspec t_value;
-  t_value.it_value.tv_sec     = m_t3413;
-  t_value.it_value.tv_nsec    = 0;
-  t_value.it_interval.tv_sec  = 0;
-  t_value.it_interval.tv_nsec = 0;
-
-  if (timerfd_settime(fdt, 0, &t_value, NULL) == -1) {
-    m_logger.error("Could not set timer");
-    close(fdt);
-    return false;
+  // The timer is only allocated the first time the UE is paged
+  if (not m_t3413_timer.is_valid()) {
+    m_t3413_timer = m_mme->get_unique_timer();
   }
-
-  m_mme->add_nas_timer(fdt, T_3413, m_emm_ctx.imsi); // TODO timers without IMSI?
+  m_t3413_timer.set(m_t3413 * 1000, [this](uint32_t tid) { expire_timer(T_3413); });
+  m_t3413_timer.run();
   return true;
 }
 
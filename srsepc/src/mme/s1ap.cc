@@ -20,8 +20,10 @@
  */
 
 #include "srsepc/hdr/mme/s1ap.h"
+#include "srsepc/hdr/mme/mme.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/bcd_helpers.h"
+#include "srsran/common/int_helpers.h"
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/network_utils.h"
 #include <cmath>
@@ -33,7 +35,7 @@ namespace srsepc {
 s1ap*           s1ap::m_instance    = NULL;
 pthread_mutex_t s1ap_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-s1ap::s1ap() : m_s1mme(-1), m_next_mme_ue_s1ap_id(1), m_mme_gtpc(NULL) {}
+s1ap::s1ap() : m_mme(NULL), m_s1mme(-1), m_mme_gtpc(NULL) {}
 
 s1ap::~s1ap()
 {
@@ -60,7 +62,7 @@ void s1ap::cleanup(void)
   pthread_mutex_unlock(&s1ap_instance_mutex);
 }
 
-int s1ap::init(const s1ap_args_t& s1ap_args)
+int s1ap::init(const s1ap_args_t& s1ap_args, uint32_t nof_shards)
 {
   m_s1ap_args = s1ap_args;
   srsran::s1ap_mccmnc_to_plmn(s1ap_args.mcc, s1ap_args.mnc, &m_plmn);
@@ -68,11 +70,24 @@ int s1ap::init(const s1ap_args_t& s1ap_args)
   std::random_device                      rd;
   std::mt19937                            generator(rd());
   std::uniform_int_distribution<uint32_t> distr(0, std::numeric_limits<uint32_t>::max());
-  m_next_m_tmsi = distr(generator);
+  uint32_t                                first_m_tmsi = distr(generator);
+
+  // Each shard allocates the IDs of its residue class, MME-UE-S1AP-ID 0 is not used
+  m_shards.resize(nof_shards);
+  for (uint32_t i = 0; i < nof_shards; i++) {
+    m_shards[i].next_mme_ue_s1ap_id = (i == 0) ? nof_shards : i;
+    m_shards[i].next_m_tmsi         = first_m_tmsi - first_m_tmsi % nof_shards + i;
+    if (m_shards[i].next_m_tmsi < i || m_shards[i].next_m_tmsi == UINT32_MAX) {
+      m_shards[i].next_m_tmsi = i;
+    }
+  }
 
   // Get pointer to the HSS
   m_hss = hss::get_instance();
 
+  // Get pointer to the MME, which runs the shards
+  m_mme = mme::get_instance();
+
   // Init message handlers
   m_s1ap_mngmt_proc = s1ap_mngmt_proc::get_instance(); // Managment procedures
   m_s1ap_mngmt_proc->init();
@@ -116,13 +131,16 @@ void s1ap::stop()
     m_active_enbs.erase(enb_it++);
   }
 
-  std::map<uint64_t, nas*>::iterator ue_it = m_imsi_to_nas_ctx.begin();
-  while (ue_it != m_imsi_to_nas_ctx.end()) {
-    m_logger.info("Deleting UE EMM context. IMSI: %015" PRIu64 "", ue_it->first);
-    srsran::console("Deleting UE EMM context. IMSI: %015" PRIu64 "\n", ue_it->first);
-    delete ue_it->second;
-    m_imsi_to_nas_ctx.erase(ue_it++);
+  for (ue_shard_t& shard : m_shards) {
+    std::unordered_map<uint64_t, nas*>::iterator ue_it = shard.imsi_to_nas_ctx.begin();
+    while (ue_it != shard.imsi_to_nas_ctx.end()) {
+      m_logger.info("Deleting UE EMM context. IMSI: %015" PRIu64 "", ue_it->first);
+      srsran::console("Deleting UE EMM context. IMSI: %015" PRIu64 "\n", ue_it->first);
+      delete ue_it->second;
+      shard.imsi_to_nas_ctx.erase(ue_it++);
+    }
   }
+  m_imsi_to_shard.clear();
 
   // Cleanup message handlers
   s1ap_mngmt_proc::cleanup();
@@ -143,7 +161,21 @@ int s1ap::get_s1_mme()
 
 uint32_t s1ap::get_next_mme_ue_s1ap_id()
 {
-  return m_next_mme_ue_s1ap_id++;
+  // The IDs of a shard stay in its residue class, and wrap around to its first ID
+  ue_shard_t& shard          = get_shard_ctx();
+  uint32_t    mme_ue_s1ap_id = shard.next_mme_ue_s1ap_id;
+  uint32_t    nof_shards     = m_shards.size();
+  if (mme_ue_s1ap_id <= UINT32_MAX - nof_shards) {
+    shard.next_mme_ue_s1ap_id = mme_ue_s1ap_id + nof_shards;
+  } else {
+    shard.next_mme_ue_s1ap_id = (mme_ue_s1ap_id % nof_shards == 0) ? nof_shards : mme_ue_s1ap_id % nof_shards;
+  }
+  return mme_ue_s1ap_id;
+}
+
+s1ap::ue_shard_t& s1ap::get_shard_ctx()
+{
+  return m_shards[mme::get_current_shard()];
 }
 
 int s1ap::enb_listen()
@@ -223,27 +255,109 @@ bool s1ap::s1ap_tx_pdu(const asn1::s1ap::s1ap_pdu_c& pdu, struct sctp_sndrcvinfo
   }
 
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(buf->msg, buf->N_bytes);
   }
 
   return true;
 }
 
-void s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri)
+bool s1ap::unpack_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, s1ap_pdu_t& rx_pdu)
 {
   // Save PCAP
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(pdu->msg, pdu->N_bytes);
   }
 
   // Get PDU type
-  s1ap_pdu_t     rx_pdu;
   asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
   if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
     m_logger.error("Failed to unpack received PDU");
-    return;
+    return false;
+  }
+  return true;
+}
+
+uint32_t s1ap::get_s1ap_pdu_shard(const s1ap_pdu_t& rx_pdu)
+{
+  using init_msg_type_opts_t           = asn1::s1ap::s1ap_elem_procs_o::init_msg_c::types_opts;
+  using successful_outcome_type_opts_t = asn1::s1ap::s1ap_elem_procs_o::successful_outcome_c::types_opts;
+
+  // The messages that are not UE-associated, like the S1 Setup, go to the first shard
+  uint32_t nof_shards = m_shards.size();
+  if (rx_pdu.type().value == s1ap_pdu_t::types_opts::init_msg) {
+    const asn1::s1ap::init_msg_s& msg = rx_pdu.init_msg();
+    switch (msg.value.type().value) {
+      case init_msg_type_opts_t::init_ue_msg:
+        break;
+      case init_msg_type_opts_t::ul_nas_transport:
+        return msg.value.ul_nas_transport()->mme_ue_s1ap_id.value.value % nof_shards;
+      case init_msg_type_opts_t::ue_context_release_request:
+        return msg.value.ue_context_release_request()->mme_ue_s1ap_id.value.value % nof_shards;
+      default:
+        return 0;
+    }
+
+    // Initial UE Message: the UE is identified by the M-TMSI of its S-TMSI or its GUTI, which was allocated by its
+    // shard, or by its IMSI. Otherwise any shard will do
+    const asn1::s1ap::init_ue_msg_s& init_ue = msg.value.init_ue_msg();
+    uint32_t                         m_tmsi  = 0;
+    if (init_ue->s_tmsi_present) {
+      srsran::uint8_to_uint32(init_ue->s_tmsi.value.m_tmsi.data(), &m_tmsi);
+      return m_tmsi % nof_shards;
+    }
+    const asn1::unbounded_octstring<true>& nas_pdu = init_ue->nas_pdu.value;
+    if (nas_pdu.size() > 2) {
+      uint8_t* msg_ptr      = const_cast<uint8_t*>(nas_pdu.data());
+      uint8_t  sec_hdr_type = (msg_ptr[0] & 0xF0) >> 4;
+      uint32_t offset       = (sec_hdr_type == LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS) ? 0 : 6;
+      // Protocol discriminator, message type and attach type, followed by the EPS mobile identity
+      if (nas_pdu.size() > offset + 4 && msg_ptr[offset + 1] == LIBLTE_MME_MSG_TYPE_ATTACH_REQUEST &&
+          nas_pdu.size() > offset + 3 + msg_ptr[offset + 3]) {
+        msg_ptr += offset + 3;
+        LIBLTE_MME_EPS_MOBILE_ID_STRUCT eps_mobile_id = {};
+        if (liblte_mme_unpack_eps_mobile_id_ie(&msg_ptr, &eps_mobile_id) == LIBLTE_SUCCESS) {
+          if (eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI) {
+            uint64_t imsi = 0;
+            for (int i = 0; i <= 14; i++) {
+              imsi = imsi * 10 + eps_mobile_id.imsi[i];
+            }
+            return get_imsi_shard(imsi);
+          }
+          if (eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI) {
+            return eps_mobile_id.guti.m_tmsi % nof_shards;
+          }
+        }
+      }
+    }
+    return init_ue->enb_ue_s1ap_id.value.value % nof_shards;
+  }
+
+  if (rx_pdu.type().value == s1ap_pdu_t::types_opts::successful_outcome) {
+    const asn1::s1ap::successful_outcome_s& msg = rx_pdu.successful_outcome();
+    switch (msg.value.type().value) {
+      case successful_outcome_type_opts_t::init_context_setup_resp:
+        return msg.value.init_context_setup_resp()->mme_ue_s1ap_id.value.value % nof_shards;
+      case successful_outcome_type_opts_t::ue_context_release_complete:
+        return msg.value.ue_context_release_complete()->mme_ue_s1ap_id.value.value % nof_shards;
+      default:
+        return 0;
+    }
   }
+  return 0;
+}
 
+void s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo* enb_sri)
+{
+  s1ap_pdu_t rx_pdu;
+  if (unpack_s1ap_rx_pdu(pdu, rx_pdu)) {
+    handle_s1ap_rx_pdu(rx_pdu, enb_sri);
+  }
+}
+
+void s1ap::handle_s1ap_rx_pdu(const s1ap_pdu_t& rx_pdu, struct sctp_sndrcvinfo* enb_sri)
+{
   switch (rx_pdu.type().value) {
     case s1ap_pdu_t::types_opts::init_msg:
       m_logger.info("Received Initiating PDU");
@@ -314,16 +428,18 @@ void s1ap::handle_successful_outcome(const asn1::s1ap::successful_outcome_s& msg
 void s1ap::add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinfo* enb_sri)
 {
   m_logger.info("Adding new eNB context. eNB ID %d", enb_ctx.enb_id);
-  std::set<uint32_t> ue_set;
-  enb_ctx_t*         enb_ptr = new enb_ctx_t;
-  *enb_ptr                   = enb_ctx;
+  enb_ctx_t* enb_ptr = new enb_ctx_t;
+  *enb_ptr           = enb_ctx;
+
+  // The UE sets of the eNB are created by the shards when its first UE is added
+  std::lock_guard<std::mutex> lock(m_enb_mutex);
   m_active_enbs.emplace(enb_ptr->enb_id, enb_ptr);
   m_sctp_to_enb_id.emplace(enb_sri->sinfo_assoc_id, enb_ptr->enb_id);
-  m_enb_assoc_to_ue_ids.emplace(enb_sri->sinfo_assoc_id, ue_set);
 }
 
 enb_ctx_t* s1ap::find_enb_ctx(uint16_t enb_id)
 {
+  std::lock_guard<std::mutex>              lock(m_enb_mutex);
   std::map<uint16_t, enb_ctx_t*>::iterator it = m_active_enbs.find(enb_id);
   if (it == m_active_enbs.end()) {
     return nullptr;
@@ -334,22 +450,31 @@ enb_ctx_t* s1ap::find_enb_ctx(uint16_t enb_id)
 
 void s1ap::delete_enb_ctx(int32_t assoc_id)
 {
+  std::unique_lock<std::mutex>          lock(m_enb_mutex);
   std::map<int32_t, uint16_t>::iterator it_assoc = m_sctp_to_enb_id.find(assoc_id);
-  uint16_t                              enb_id   = it_assoc->second;
+  if (it_assoc == m_sctp_to_enb_id.end()) {
+    m_logger.error("Could not find eNB to delete. Association: %d", assoc_id);
+    return;
+  }
+  uint16_t enb_id = it_assoc->second;
 
   std::map<uint16_t, enb_ctx_t*>::iterator it_ctx = m_active_enbs.find(enb_id);
-  if (it_ctx == m_active_enbs.end() || it_assoc == m_sctp_to_enb_id.end()) {
+  if (it_ctx == m_active_enbs.end()) {
     m_logger.error("Could not find eNB to delete. Association: %d", assoc_id);
     return;
   }
+  lock.unlock();
 
   m_logger.info("Deleting eNB context. eNB Id: 0x%x", enb_id);
   srsran::console("Deleting eNB context. eNB Id: 0x%x\n", enb_id);
 
-  // Delete connected UEs ctx
-  release_ues_ecm_ctx_in_enb(assoc_id);
+  // Delete connected UEs ctx, in the shards that own them
+  for (uint32_t i = 0; i < m_shards.size(); i++) {
+    m_mme->push_shard_task(i, [this, assoc_id]() { release_ues_ecm_ctx_in_enb(assoc_id); });
+  }
 
   // Delete eNB
+  lock.lock();
   delete it_ctx->second;
   m_active_enbs.erase(it_ctx);
   m_sctp_to_enb_id.erase(it_assoc);
@@ -359,67 +484,116 @@ void s1ap::delete_enb_ctx(int32_t assoc_id)
 // UE Context Management
 bool s1ap::add_nas_ctx_to_imsi_map(nas* nas_ctx)
 {
-  std::map<uint64_t, nas*>::iterator ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
-  if (ctx_it != m_imsi_to_nas_ctx.end()) {
+  ue_shard_t&                                  shard  = get_shard_ctx();
+  std::unordered_map<uint64_t, nas*>::iterator ctx_it = shard.imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
+  if (ctx_it != shard.imsi_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
-    if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
+    std::unordered_map<uint32_t, nas*>::iterator ctx_it2 =
+        shard.mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    if (ctx_it2 != shard.mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with IMSI does not match context identified by MME UE S1AP Id.");
       return false;
     }
   }
-  m_imsi_to_nas_ctx.emplace(nas_ctx->m_emm_ctx.imsi, nas_ctx);
+  shard.imsi_to_nas_ctx.emplace(nas_ctx->m_emm_ctx.imsi, nas_ctx);
   m_logger.debug("Saved UE context corresponding to IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
+
+  if (m_shards.size() > 1) {
+    // Take over the IMSI. A context of the previous shard is stale now, and is deleted there
+    uint64_t imsi       = nas_ctx->m_emm_ctx.imsi;
+    uint32_t shard_idx  = mme::get_current_shard();
+    uint32_t prev_shard = shard_idx;
+    {
+      std::lock_guard<std::mutex>                      lock(m_imsi_shard_mutex);
+      std::unordered_map<uint64_t, uint32_t>::iterator it = m_imsi_to_shard.find(imsi);
+      if (it == m_imsi_to_shard.end()) {
+        m_imsi_to_shard.emplace(imsi, shard_idx);
+      } else {
+        prev_shard = it->second;
+        it->second = shard_idx;
+      }
+    }
+    if (prev_shard != shard_idx) {
+      m_logger.info("Moved UE context from shard %d to shard %d. IMSI %015" PRIu64 "", prev_shard, shard_idx, imsi);
+      m_mme->push_shard_task(prev_shard, [this, imsi]() { delete_moved_ue_ctx(imsi); });
+    }
+  }
   return true;
 }
 
+uint32_t s1ap::get_imsi_shard(uint64_t imsi)
+{
+  std::lock_guard<std::mutex>                      lock(m_imsi_shard_mutex);
+  std::unordered_map<uint64_t, uint32_t>::iterator it = m_imsi_to_shard.find(imsi);
+  if (it == m_imsi_to_shard.end()) {
+    return imsi % m_shards.size();
+  }
+  return it->second;
+}
+
+void s1ap::delete_moved_ue_ctx(uint64_t imsi)
+{
+  // The UE may have come back to this shard in the meantime
+  if (get_imsi_shard(imsi) == mme::get_current_shard()) {
+    return;
+  }
+  delete_ue_ctx(imsi);
+}
+
 bool s1ap::add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)
 {
   if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id == 0) {
     m_logger.error("Could not add UE context to MME UE S1AP map. MME UE S1AP ID 0 is not valid.");
     return false;
   }
-  std::map<uint32_t, nas*>::iterator ctx_it = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
-  if (ctx_it != m_mme_ue_s1ap_id_to_nas_ctx.end()) {
+  ue_shard_t&                                  shard = get_shard_ctx();
+  std::unordered_map<uint32_t, nas*>::iterator ctx_it =
+      shard.mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+  if (ctx_it != shard.mme_ue_s1ap_id_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. MME UE S1AP Id %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_emm_ctx.imsi != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
-    if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
+    std::unordered_map<uint32_t, nas*>::iterator ctx_it2 =
+        shard.mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    if (ctx_it2 != shard.mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with MME UE S1AP Id does not match context identified by IMSI.");
       return false;
     }
   }
-  m_mme_ue_s1ap_id_to_nas_ctx.emplace(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id, nas_ctx);
+  shard.mme_ue_s1ap_id_to_nas_ctx.emplace(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id, nas_ctx);
   m_logger.debug("Saved UE context corresponding to MME UE S1AP Id %d", nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
   return true;
 }
 
 bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 {
-  std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
-  if (ues_in_enb == m_enb_assoc_to_ue_ids.end()) {
-    m_logger.error("Could not find eNB from eNB SCTP association %d", enb_assoc);
-    return false;
+  {
+    std::lock_guard<std::mutex> lock(m_enb_mutex);
+    if (m_sctp_to_enb_id.find(enb_assoc) == m_sctp_to_enb_id.end()) {
+      m_logger.error("Could not find eNB from eNB SCTP association %d", enb_assoc);
+      return false;
+    }
   }
-  std::set<uint32_t>::iterator ue_id = ues_in_enb->second.find(mme_ue_s1ap_id);
-  if (ue_id != ues_in_enb->second.end()) {
+  std::unordered_set<uint32_t>&          ues_in_enb = get_shard_ctx().enb_assoc_to_ue_ids[enb_assoc];
+  std::unordered_set<uint32_t>::iterator ue_id      = ues_in_enb.find(mme_ue_s1ap_id);
+  if (ue_id != ues_in_enb.end()) {
     m_logger.error("UE with MME UE S1AP Id already exists %d", mme_ue_s1ap_id);
     return false;
   }
-  ues_in_enb->second.insert(mme_ue_s1ap_id);
+  ues_in_enb.insert(mme_ue_s1ap_id);
   m_logger.debug("Added UE with MME-UE S1AP Id %d to eNB with association %d", mme_ue_s1ap_id, enb_assoc);
   return true;
 }
 
 nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 {
-  std::map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
-  if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
+  ue_shard_t&                                  shard = get_shard_ctx();
+  std::unordered_map<uint32_t, nas*>::iterator it    = shard.mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  if (it == shard.mme_ue_s1ap_id_to_nas_ctx.end()) {
     return NULL;
   } else {
     return it->second;
@@ -428,8 +602,9 @@ nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
 {
-  std::map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
-  if (it == m_imsi_to_nas_ctx.end()) {
+  ue_shard_t&                                  shard = get_shard_ctx();
+  std::unordered_map<uint64_t, nas*>::iterator it    = shard.imsi_to_nas_ctx.find(imsi);
+  if (it == shard.imsi_to_nas_ctx.end()) {
     return NULL;
   } else {
     return it->second;
@@ -439,15 +614,16 @@ nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
 void s1ap::release_ues_ecm_ctx_in_enb(int32_t enb_assoc)
 {
   srsran::console("Releasing UEs context\n");
-  std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
-  std::set<uint32_t>::iterator                     ue_id      = ues_in_enb->second.begin();
-  if (ue_id == ues_in_enb->second.end()) {
+  ue_shard_t&                                                shard      = get_shard_ctx();
+  std::map<int32_t, std::unordered_set<uint32_t> >::iterator ues_in_enb = shard.enb_assoc_to_ue_ids.find(enb_assoc);
+  if (ues_in_enb == shard.enb_assoc_to_ue_ids.end() || ues_in_enb->second.empty()) {
     srsran::console("No UEs to be released\n");
   } else {
+    std::unordered_set<uint32_t>::iterator ue_id = ues_in_enb->second.begin();
     while (ue_id != ues_in_enb->second.end()) {
-      std::map<uint32_t, nas*>::iterator nas_ctx = m_mme_ue_s1ap_id_to_nas_ctx.find(*ue_id);
-      emm_ctx_t*                         emm_ctx = &nas_ctx->second->m_emm_ctx;
-      ecm_ctx_t*                         ecm_ctx = &nas_ctx->second->m_ecm_ctx;
+      std::unordered_map<uint32_t, nas*>::iterator nas_ctx = shard.mme_ue_s1ap_id_to_nas_ctx.find(*ue_id);
+      emm_ctx_t*                                   emm_ctx = &nas_ctx->second->m_emm_ctx;
+      ecm_ctx_t*                                   ecm_ctx = &nas_ctx->second->m_ecm_ctx;
 
       m_logger.info(
           "Releasing UE context. IMSI: %015" PRIu64 ", UE-MME S1AP Id: %d", emm_ctx->imsi, ecm_ctx->mme_ue_s1ap_id);
@@ -462,6 +638,9 @@ void s1ap::release_ues_ecm_ctx_in_enb(int32_t enb_assoc)
       ues_in_enb->second.erase(ue_id++);
     }
   }
+  if (ues_in_enb != shard.enb_assoc_to_ue_ids.end()) {
+    shard.enb_assoc_to_ue_ids.erase(ues_in_enb);
+  }
 }
 
 bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
@@ -474,21 +653,24 @@ bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
   ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
 
   // Delete UE within eNB UE set
-  std::map<int32_t, uint16_t>::iterator it = m_sctp_to_enb_id.find(ecm_ctx->enb_sri.sinfo_assoc_id);
-  if (it == m_sctp_to_enb_id.end()) {
-    m_logger.error("Could not find eNB for UE release request.");
-    return false;
+  {
+    std::lock_guard<std::mutex> lock(m_enb_mutex);
+    if (m_sctp_to_enb_id.find(ecm_ctx->enb_sri.sinfo_assoc_id) == m_sctp_to_enb_id.end()) {
+      m_logger.error("Could not find eNB for UE release request.");
+      return false;
+    }
   }
-  uint16_t                                         enb_id = it->second;
-  std::map<int32_t, std::set<uint32_t> >::iterator ue_set = m_enb_assoc_to_ue_ids.find(ecm_ctx->enb_sri.sinfo_assoc_id);
-  if (ue_set == m_enb_assoc_to_ue_ids.end()) {
+  ue_shard_t&                                                shard  = get_shard_ctx();
+  std::map<int32_t, std::unordered_set<uint32_t> >::iterator ue_set =
+      shard.enb_assoc_to_ue_ids.find(ecm_ctx->enb_sri.sinfo_assoc_id);
+  if (ue_set == shard.enb_assoc_to_ue_ids.end()) {
     m_logger.error("Could not find the eNB's UEs.");
     return false;
   }
   ue_set->second.erase(mme_ue_s1ap_id);
 
   // Release UE ECM context
-  m_mme_ue_s1ap_id_to_nas_ctx.erase(mme_ue_s1ap_id);
+  shard.mme_ue_s1ap_id_to_nas_ctx.erase(mme_ue_s1ap_id);
   ecm_ctx->state          = ECM_STATE_IDLE;
   ecm_ctx->mme_ue_s1ap_id = 0;
   ecm_ctx->enb_ue_s1ap_id = 0;
@@ -511,7 +693,14 @@ bool s1ap::delete_ue_ctx(uint64_t imsi)
   }
 
   // Delete UE context
-  m_imsi_to_nas_ctx.erase(imsi);
+  get_shard_ctx().imsi_to_nas_ctx.erase(imsi);
+  if (m_shards.size() > 1) {
+    std::lock_guard<std::mutex>                      lock(m_imsi_shard_mutex);
+    std::unordered_map<uint64_t, uint32_t>::iterator it = m_imsi_to_shard.find(imsi);
+    if (it != m_imsi_to_shard.end() && it->second == mme::get_current_shard()) {
+      m_imsi_to_shard.erase(it);
+    }
+  }
   delete nas_ctx;
   m_logger.info("Deleted UE Context.");
   return true;
@@ -520,15 +709,16 @@ bool s1ap::delete_ue_ctx(uint64_t imsi)
 // UE Bearer Managment
 void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 {
-  std::map<uint64_t, nas*>::iterator ue_ctx_it = m_imsi_to_nas_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_nas_ctx.end()) {
+  ue_shard_t&                                  shard     = get_shard_ctx();
+  std::unordered_map<uint64_t, nas*>::iterator ue_ctx_it = shard.imsi_to_nas_ctx.find(imsi);
+  if (ue_ctx_it == shard.imsi_to_nas_ctx.end()) {
     m_logger.error("Could not activate EPS bearer: Could not find UE context");
     return;
   }
   // Make sure NAS is active
-  uint32_t                           mme_ue_s1ap_id = ue_ctx_it->second->m_ecm_ctx.mme_ue_s1ap_id;
-  std::map<uint32_t, nas*>::iterator it             = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
-  if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
+  uint32_t                                     mme_ue_s1ap_id = ue_ctx_it->second->m_ecm_ctx.mme_ue_s1ap_id;
+  std::unordered_map<uint32_t, nas*>::iterator it = shard.mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  if (it == shard.mme_ue_s1ap_id_to_nas_ctx.end()) {
     m_logger.error("Could not activate EPS bearer: ECM context seems to be missing");
     return;
   }
@@ -557,18 +747,22 @@ void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 
 uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 {
-  uint32_t m_tmsi = m_next_m_tmsi;
-  m_next_m_tmsi   = (m_next_m_tmsi + 1) % UINT32_MAX;
+  // The M-TMSIs of a shard stay in its residue class, and wrap around before 0xffffffff
+  ue_shard_t& shard      = get_shard_ctx();
+  uint32_t    m_tmsi     = shard.next_m_tmsi;
+  uint32_t    nof_shards = m_shards.size();
+  shard.next_m_tmsi      = (m_tmsi < UINT32_MAX - nof_shards) ? m_tmsi + nof_shards : mme::get_current_shard();
 
-  m_tmsi_to_imsi.emplace(m_tmsi, imsi);
+  shard.tmsi_to_imsi.emplace(m_tmsi, imsi);
   m_logger.debug("Allocated M-TMSI 0x%x to IMSI %015" PRIu64 ",", m_tmsi, imsi);
   return m_tmsi;
 }
 
 uint64_t s1ap::find_imsi_from_m_tmsi(uint32_t m_tmsi)
 {
-  std::map<uint32_t, uint64_t>::iterator it = m_tmsi_to_imsi.find(m_tmsi);
-  if (it != m_tmsi_to_imsi.end()) {
+  ue_shard_t&                                      shard = get_shard_ctx();
+  std::unordered_map<uint32_t, uint64_t>::iterator it    = shard.tmsi_to_imsi.find(m_tmsi);
+  if (it != shard.tmsi_to_imsi.end()) {
     m_logger.debug("Found IMSI %015" PRIu64 " from M-TMSI 0x%x", it->second, m_tmsi);
     return it->second;
   } else {
@@ -664,15 +858,4 @@ bool s1ap::send_downlink_nas_transport(uint32_t               enb_ue_s1ap_id,
   return m_s1ap_nas_transport->send_downlink_nas_transport(enb_ue_s1ap_id, mme_ue_s1ap_id, nas_msg, enb_sri);
 }
 
-bool s1ap::expire_nas_timer(enum nas_timer_type type, uint64_t imsi)
-{
-  nas* nas_ctx = find_nas_ctx_from_imsi(imsi);
-  if (nas_ctx == NULL) {
-    m_logger.error("Error finding NAS context to handle timer");
-    return false;
-  }
-  bool err = nas_ctx->expire_timer(type);
-  return err;
-}
-
 } // namespace srsepc
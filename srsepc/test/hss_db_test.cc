@@ -0,0 +1,266 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsepc/hdr/hss/hss_db.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <fstream>
+#include <inttypes.h>
+#include <random>
+#include <unistd.h>
+
+using namespace srsepc;
+
+static uint32_t    nof_subscribers = 100000;
+static uint32_t    nof_auth        = 200000;
+static std::string tmp_dir         = "/tmp";
+
+static uint64_t test_imsi(uint32_t i)
+{
+  return 1010000000000ULL + i;
+}
+
+/// Writes a user_db.csv with both algorithms, OP and OPc, and some static IPs
+static void write_csv(const std::string& path, uint32_t nof_ues)
+{
+  std::ofstream f(path);
+  f << "# Name,Auth,IMSI,Key,OP_Type,OP/OPc,AMF,SQN,QCI,IP_alloc\n";
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    char line[256];
+    snprintf(line,
+             sizeof(line),
+             "ue%d,%s,%015" PRIu64 ",00112233445566778899aabbcc%06x,%s,63bfa50ee6523365ff14c1f45f88737d,8000,%012x,%d,%s",
+             i,
+             (i % 2) ? "xor" : "mil",
+             test_imsi(i),
+             i,
+             (i % 3) ? "opc" : "op",
+             i,
+             7 + (i % 3),
+             (i % 100) ? "dynamic" : "");
+    f << line;
+    if (i % 100 == 0) {
+      f << "10.45." << (i / 100) / 250 << "." << 1 + (i / 100) % 250;
+    }
+    f << "\n";
+  }
+}
+
+int test_convert_and_lookup(const std::string& csv, const std::string& db)
+{
+  write_csv(csv, nof_subscribers);
+  TESTASSERT(hss_db::convert_csv(csv, db, 4));
+  TESTASSERT(hss_db::is_db_file(db));
+  TESTASSERT(not hss_db::is_db_file(csv));
+
+  hss_db store;
+  TESTASSERT(store.open(db));
+  TESTASSERT_EQ(nof_subscribers, store.size());
+  for (uint32_t i = 0; i < nof_subscribers; i++) {
+    hss_db_record_t* rec = store.find(test_imsi(i));
+    TESTASSERT(rec != nullptr);
+    TESTASSERT_EQ(test_imsi(i), rec->imsi);
+    TESTASSERT_EQ((uint32_t)((i % 2) ? HSS_ALGO_XOR : HSS_ALGO_MILENAGE), (uint32_t)rec->algo);
+    TESTASSERT_EQ((uint32_t)((i % 3) ? 0 : 1), (uint32_t)rec->op_configured);
+    TESTASSERT_EQ(7 + (i % 3), (uint32_t)rec->qci);
+    TESTASSERT_EQ(((i >> 8) & 0xff), (uint32_t)rec->sqn[4]);
+    TESTASSERT_EQ((i & 0xff), (uint32_t)rec->sqn[5]);
+    TESTASSERT_EQ((i & 0xff), (uint32_t)rec->key[15]);
+    TESTASSERT((i % 100 == 0) == (rec->static_ip != 0));
+  }
+  TESTASSERT(store.find(test_imsi(nof_subscribers)) == nullptr);
+  TESTASSERT(store.find(0) == nullptr);
+  store.close();
+  return SRSRAN_SUCCESS;
+}
+
+/// Index entries past the record table must not be dereferenced, nor make the lookup probe forever
+int test_corrupted_index(const std::string& csv, const std::string& db)
+{
+  write_csv(csv, 64);
+  TESTASSERT(hss_db::convert_csv(csv, db, 1));
+
+  hss_db_header_t hdr = {};
+  FILE*           f   = fopen(db.c_str(), "r+b");
+  TESTASSERT(f != nullptr);
+  TESTASSERT(fread(&hdr, sizeof(hdr), 1, f) == 1);
+  std::vector<uint32_t> bad_index(hdr.nof_buckets, (uint32_t)hdr.nof_records + 1);
+  TESTASSERT(fseek(f, (long)hdr.index_offset, SEEK_SET) == 0);
+  TESTASSERT(fwrite(bad_index.data(), sizeof(uint32_t), bad_index.size(), f) == bad_index.size());
+  fclose(f);
+
+  hss_db store;
+  TESTASSERT(store.open(db));
+  for (uint32_t i = 0; i < 64; i++) {
+    TESTASSERT(store.find(test_imsi(i)) == nullptr);
+  }
+  TESTASSERT(store.find(0) == nullptr);
+  store.close();
+  unlink(db.c_str());
+  return SRSRAN_SUCCESS;
+}
+
+int test_invalid_csv(const std::string& csv, const std::string& db)
+{
+  hss_db_record_t rec;
+  std::string     error;
+  const char*     wrong_columns = "ue1,xor,001010123456789,00112233445566778899aabbccddeeff,opc";
+  TESTASSERT(not hss_db::parse_csv_line(wrong_columns, wrong_columns + strlen(wrong_columns), rec, error));
+  const char* wrong_algo =
+      "ue1,aes,001010123456789,00112233445566778899aabbccddeeff,opc,63bfa50ee6523365ff14c1f45f88737d,9001,000000001234,7,"
+      "dynamic";
+  TESTASSERT(not hss_db::parse_csv_line(wrong_algo, wrong_algo + strlen(wrong_algo), rec, error));
+  const char* wrong_key =
+      "ue1,xor,001010123456789,0011223344556677889,opc,63bfa50ee6523365ff14c1f45f88737d,9001,000000001234,7,dynamic";
+  TESTASSERT(not hss_db::parse_csv_line(wrong_key, wrong_key + strlen(wrong_key), rec, error));
+
+  // Duplicated static IPs are rejected like in the .csv path of the HSS
+  {
+    std::ofstream f(csv);
+    f << "ue1,xor,001010123456789,00112233445566778899aabbccddeeff,opc,63bfa50ee6523365ff14c1f45f88737d,9001,"
+         "000000001234,7,10.45.0.2\n";
+    f << "ue2,xor,001010123456780,00112233445566778899aabbccddeeff,opc,63bfa50ee6523365ff14c1f45f88737d,9001,"
+         "000000001234,7,10.45.0.2\n";
+  }
+  TESTASSERT(not hss_db::convert_csv(csv, db, 1));
+  return SRSRAN_SUCCESS;
+}
+
+/// Generates auth vectors through the HSS and returns the rate. Each vector increments the SQN of the UE
+static double run_auth_vectors(const std::string& db_file, std::vector<uint64_t>& imsis)
+{
+  hss_args_t args = {};
+  args.db_file    = db_file;
+  args.mcc        = 0xf001;
+  args.mnc        = 0xff01;
+  hss* h          = hss::get_instance();
+  auto init_start = std::chrono::steady_clock::now();
+  if (h->init(&args) != 0) {
+    hss::cleanup();
+    return 0;
+  }
+
+  uint8_t k_asme[32], autn[16], rand[16], xres[16];
+  auto    start = std::chrono::steady_clock::now();
+  std::chrono::duration<double> init_secs = start - init_start;
+  for (uint64_t imsi : imsis) {
+    if (not h->gen_auth_info_answer(imsi, k_asme, autn, rand, xres)) {
+      hss::cleanup();
+      return 0;
+    }
+  }
+  std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+
+  auto stop_start = std::chrono::steady_clock::now();
+  h->stop();
+  std::chrono::duration<double> stop_secs = std::chrono::steady_clock::now() - stop_start;
+  hss::cleanup();
+  fmt::print("{}: init {:.3f} s, stop {:.3f} s\n", db_file, init_secs.count(), stop_secs.count());
+  return imsis.size() / secs.count();
+}
+
+int test_auth_vectors(const std::string& csv, const std::string& db)
+{
+  std::mt19937                            rng(1234);
+  std::uniform_int_distribution<uint32_t> ue_dist(0, nof_subscribers - 1);
+  std::vector<uint64_t>                   imsis(nof_auth);
+  std::vector<uint32_t>                   nof_auth_per_ue(nof_subscribers, 0);
+  for (uint64_t& imsi : imsis) {
+    uint32_t i = ue_dist(rng);
+    imsi       = test_imsi(i);
+    nof_auth_per_ue[i]++;
+  }
+
+  double csv_rate = run_auth_vectors(csv, imsis);
+  TESTASSERT(csv_rate > 0);
+  double db_rate = run_auth_vectors(db, imsis);
+  TESTASSERT(db_rate > 0);
+  fmt::print("{} subscribers, {} auth vectors: .csv {:.1f}k vectors/s, binary database {:.1f}k vectors/s\n",
+             nof_subscribers,
+             nof_auth,
+             csv_rate / 1e3,
+             db_rate / 1e3);
+
+  // The SQNs updated in place must be found after reopening the database, and they must match the ones the .csv
+  // path wrote back at exit
+  std::string                  tmp_db = db + ".check";
+  TESTASSERT(hss_db::convert_csv(csv, tmp_db, 1));
+  hss_db csv_store, db_store;
+  TESTASSERT(csv_store.open(tmp_db));
+  TESTASSERT(db_store.open(db));
+  for (uint32_t i = 0; i < nof_subscribers; i++) {
+    const hss_db_record_t* a = csv_store.find(test_imsi(i));
+    const hss_db_record_t* b = db_store.find(test_imsi(i));
+    TESTASSERT(a != nullptr && b != nullptr);
+    TESTASSERT(memcmp(a->sqn, b->sqn, sizeof(a->sqn)) == 0);
+    // Every vector increments both SEQ and the 5 bit IND of the SQN
+    uint64_t sqn = 0;
+    for (uint8_t byte : b->sqn) {
+      sqn = (sqn << 8) | byte;
+    }
+    uint64_t seq = i >> LTE_FDD_ENB_IND_HE_N_BITS;
+    uint64_t ind = i & LTE_FDD_ENB_IND_HE_MASK;
+    for (uint32_t n = 0; n < nof_auth_per_ue[i]; n++) {
+      seq++;
+      ind = (ind + 1) % LTE_FDD_ENB_IND_HE_MAX_VALUE;
+    }
+    uint64_t expected_sqn = (seq << LTE_FDD_ENB_IND_HE_N_BITS) | ind;
+    TESTASSERT_EQ(expected_sqn, sqn);
+  }
+  csv_store.close();
+  db_store.close();
+  unlink(tmp_db.c_str());
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc > 1) {
+    nof_subscribers = (uint32_t)strtoul(argv[1], NULL, 10);
+  }
+  if (argc > 2) {
+    nof_auth = (uint32_t)strtoul(argv[2], NULL, 10);
+  }
+
+  srslog::init();
+  srslog::fetch_basic_logger("HSS", false).set_level(srslog::basic_levels::warning);
+
+  std::string prefix = tmp_dir + "/hss_db_test_" + std::to_string(getpid());
+  std::string csv    = prefix + ".csv";
+  std::string db     = prefix + ".db";
+
+  int ret = test_convert_and_lookup(csv, db);
+  if (ret == SRSRAN_SUCCESS) {
+    ret = test_auth_vectors(csv, db);
+  }
+  if (ret == SRSRAN_SUCCESS) {
+    ret = test_invalid_csv(csv, db + ".invalid");
+  }
+  if (ret == SRSRAN_SUCCESS) {
+    ret = test_corrupted_index(csv, db + ".corrupted");
+  }
+
+  unlink(csv.c_str());
+  unlink(db.c_str());
+  srslog::flush();
+  return ret;
+}
@@ -0,0 +1,438 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsepc/hdr/hss/hss_db.h"
+#include "srsepc/hdr/mme/mme.h"
+#include "srsran/asn1/liblte_mme.h"
+#include "srsran/common/bcd_helpers.h"
+#include "srsran/common/network_utils.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <fstream>
+#include <inttypes.h>
+#include <unistd.h>
+
+// An eNB stand-in attaches a population of UEs to the MME over S1-MME. Each UE sends an IMSI Attach Request in the
+// Initial UE Message and answers the Authentication Request, which makes the MME fetch a Milenage vector from the HSS
+// and send the Security Mode Command. The attach is counted as done at the Security Mode Command, so that no SPGW is
+// needed. New UEs start as soon as the number of attaches in course is below the concurrency limit. The MME shards the
+// UE contexts across the given number of workers
+
+using namespace srsepc;
+using namespace asn1::s1ap;
+
+using bench_clock = std::chrono::steady_clock;
+
+static const char*    mme_addr_str    = "127.0.0.1";
+static const uint32_t enb_id          = 0x19b;
+static const uint16_t tac             = 7;
+static const int      s1ap_ppid       = 18;
+static const uint32_t max_concurrency = 1024;
+static const uint32_t max_workers     = 64;
+static const uint32_t mme_timeout_ms  = 2000;
+static const char*    opc_str         = "63bfa50ee6523365ff14c1f45f88737d";
+static const uint8_t  opc[16]         = {
+    0x63, 0xbf, 0xa5, 0x0e, 0xe6, 0x52, 0x33, 0x65, 0xff, 0x14, 0xc1, 0xf4, 0x5f, 0x88, 0x73, 0x7d};
+
+static uint64_t test_imsi(uint32_t i)
+{
+  return 1010000000000ULL + i;
+}
+
+/// The K of each UE ends with its index
+static void test_k(uint32_t i, uint8_t* k)
+{
+  for (uint32_t j = 0; j < 13; j++) {
+    k[j] = 0x11 * j;
+  }
+  k[13] = (i >> 16U) & 0xff;
+  k[14] = (i >> 8U) & 0xff;
+  k[15] = i & 0xff;
+}
+
+/// Writes a user_db.csv of Milenage subscribers, all with the same OPc
+static void write_csv(const std::string& path, uint32_t nof_ues)
+{
+  std::ofstream f(path);
+  f << "# Name,Auth,IMSI,Key,OP_Type,OP/OPc,AMF,SQN,QCI,IP_alloc\n";
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    char line[256];
+    snprintf(line,
+             sizeof(line),
+             "ue%d,mil,%015" PRIu64 ",00112233445566778899aabbcc%06x,opc,%s,8000,000000001234,7,dynamic\n",
+             i,
+             test_imsi(i),
+             i,
+             opc_str);
+    f << line;
+  }
+}
+
+/// eNB stand-in, connected to the MME through a SCTP socket
+class enb_standin
+{
+public:
+  enb_standin()
+  {
+    using namespace srsran::net_utils;
+    fd             = open_socket(addr_family::ipv4, socket_type::seqpacket, protocol_type::SCTP);
+    bool connected = fd > 0 and connect_to(fd, mme_addr_str, S1MME_PORT, &mme_addr);
+    TESTASSERT(connected);
+
+    // The MME replies are waited for with a timeout, so that a lost message doesn't block the benchmark
+    timeval timeout = {0, 100000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  }
+  ~enb_standin() { close(fd); }
+
+  bool send(const s1ap_pdu_c& pdu, uint16_t stream_id)
+  {
+    srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+    if (buf == nullptr) {
+      return false;
+    }
+    asn1::bit_ref bref(buf->msg, buf->get_tailroom());
+    if (pdu.pack(bref) != asn1::SRSASN_SUCCESS) {
+      return false;
+    }
+    buf->N_bytes   = bref.distance_bytes();
+    ssize_t n_sent = sctp_sendmsg(fd,
+                                  buf->msg,
+                                  buf->N_bytes,
+                                  (struct sockaddr*)&mme_addr,
+                                  sizeof(struct sockaddr_in),
+                                  htonl(s1ap_ppid),
+                                  0,
+                                  stream_id,
+                                  0,
+                                  0);
+    return n_sent == buf->N_bytes;
+  }
+
+  /// Waits for the next MME message. Returns false on timeout
+  bool recv(s1ap_pdu_c& pdu)
+  {
+    srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+    if (buf == nullptr) {
+      return false;
+    }
+    sockaddr_in     from    = {};
+    socklen_t       fromlen = sizeof(from);
+    sctp_sndrcvinfo sri     = {};
+    int             flags   = 0;
+    ssize_t n_recv = sctp_recvmsg(fd, buf->msg, buf->get_tailroom(), (struct sockaddr*)&from, &fromlen, &sri, &flags);
+    if (n_recv <= 0 or (flags & MSG_NOTIFICATION)) {
+      return false;
+    }
+    asn1::cbit_ref bref(buf->msg, n_recv);
+    return pdu.unpack(bref) == asn1::SRSASN_SUCCESS;
+  }
+
+private:
+  int         fd       = -1;
+  sockaddr_in mme_addr = {};
+};
+
+static int send_s1_setup(enb_standin& enb, uint32_t plmn)
+{
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_S1_SETUP);
+  s1_setup_request_s& container             = pdu.init_msg().value.s1_setup_request();
+  uint32_t            plmn_be               = htonl(plmn);
+  container->global_enb_id.value.plm_nid[0] = ((uint8_t*)&plmn_be)[1];
+  container->global_enb_id.value.plm_nid[1] = ((uint8_t*)&plmn_be)[2];
+  container->global_enb_id.value.plm_nid[2] = ((uint8_t*)&plmn_be)[3];
+  container->global_enb_id.value.enb_id.set_macro_enb_id().from_number(enb_id);
+
+  uint16_t tac_be = htons(tac);
+  container->supported_tas.value.resize(1);
+  memcpy(container->supported_tas.value[0].tac.data(), &tac_be, sizeof(tac_be));
+  container->supported_tas.value[0].broadcast_plmns.resize(1);
+  container->supported_tas.value[0].broadcast_plmns[0][0] = ((uint8_t*)&plmn_be)[1];
+  container->supported_tas.value[0].broadcast_plmns[0][1] = ((uint8_t*)&plmn_be)[2];
+  container->supported_tas.value[0].broadcast_plmns[0][2] = ((uint8_t*)&plmn_be)[3];
+  container->default_paging_drx.value.value               = paging_drx_opts::v128;
+  bool sent = enb.send(pdu, 0);
+  TESTASSERT(sent);
+
+  s1ap_pdu_c resp;
+  bool       received = enb.recv(resp);
+  TESTASSERT(received);
+  TESTASSERT(resp.type().value == s1ap_pdu_c::types_opts::successful_outcome);
+  TESTASSERT(resp.successful_outcome().value.type().value ==
+             s1ap_elem_procs_o::successful_outcome_c::types_opts::s1_setup_resp);
+  return SRSRAN_SUCCESS;
+}
+
+static int send_attach_request(enb_standin& enb, uint32_t ue_idx, uint32_t plmn)
+{
+  srsran::unique_byte_buffer_t nas_pdu = srsran::make_byte_buffer();
+  TESTASSERT(nas_pdu != nullptr);
+
+  // The PDN connectivity request doesn't ask for the ESM information transfer, so it is not part of the attach
+  LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT pdn_con_req = {};
+  pdn_con_req.proc_transaction_id                            = 0x01;
+  pdn_con_req.request_type                                   = LIBLTE_MME_REQUEST_TYPE_INITIAL_REQUEST;
+  pdn_con_req.pdn_type                                       = LIBLTE_MME_PDN_TYPE_IPV4;
+
+  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT attach_req = {};
+  attach_req.eps_attach_type                      = LIBLTE_MME_EPS_ATTACH_TYPE_EPS_ATTACH;
+  attach_req.nas_ksi.nas_ksi                      = LIBLTE_MME_NAS_KEY_SET_IDENTIFIER_NO_KEY_AVAILABLE;
+  attach_req.eps_mobile_id.type_of_id             = LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI;
+  uint64_t imsi                                   = test_imsi(ue_idx);
+  for (int i = 14; i >= 0; i--) {
+    attach_req.eps_mobile_id.imsi[i] = imsi % 10;
+    imsi /= 10;
+  }
+  for (uint32_t i = 0; i < 8; i++) {
+    attach_req.ue_network_cap.eea[i] = true;
+    attach_req.ue_network_cap.eia[i] = true;
+  }
+  int packed = liblte_mme_pack_pdn_connectivity_request_msg(&pdn_con_req, &attach_req.esm_msg);
+  TESTASSERT(packed == LIBLTE_SUCCESS);
+  packed = liblte_mme_pack_attach_request_msg(&attach_req, (LIBLTE_BYTE_MSG_STRUCT*)nas_pdu.get());
+  TESTASSERT(packed == LIBLTE_SUCCESS);
+
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_INIT_UE_MSG);
+  init_ue_msg_s& container        = pdu.init_msg().value.init_ue_msg();
+  container->enb_ue_s1ap_id.value = ue_idx;
+  container->nas_pdu.value.resize(nas_pdu->N_bytes);
+  memcpy(container->nas_pdu.value.data(), nas_pdu->msg, nas_pdu->N_bytes);
+  container->tai.value.plm_nid.from_number(plmn);
+  container->tai.value.tac.from_number(tac);
+  container->eutran_cgi.value.plm_nid.from_number(plmn);
+  container->eutran_cgi.value.cell_id.from_number(enb_id << 8U);
+  container->rrc_establishment_cause.value = rrc_establishment_cause_opts::mo_sig;
+  bool sent                                = enb.send(pdu, 1);
+  TESTASSERT(sent);
+  return SRSRAN_SUCCESS;
+}
+
+/// Computes the RES of the UE for the RAND of the Authentication Request, and sends the Authentication Response
+static int send_authentication_response(enb_standin&              enb,
+                                        const dl_nas_transport_s& dl_nas,
+                                        srsran::byte_buffer_t&    nas_rx,
+                                        uint32_t                  ue_idx)
+{
+  LIBLTE_MME_AUTHENTICATION_REQUEST_MSG_STRUCT auth_req = {};
+  int unpacked = liblte_mme_unpack_authentication_request_msg((LIBLTE_BYTE_MSG_STRUCT*)&nas_rx, &auth_req);
+  TESTASSERT(unpacked == LIBLTE_SUCCESS);
+
+  uint8_t k[16], ck[16], ik[16], ak[6];
+  test_k(ue_idx, k);
+  LIBLTE_MME_AUTHENTICATION_RESPONSE_MSG_STRUCT auth_resp = {};
+  auth_resp.res_len                                       = 8;
+  srsran::security_milenage_f2345(k, (uint8_t*)opc, auth_req.rand, auth_resp.res, ck, ik, ak);
+
+  srsran::unique_byte_buffer_t nas_pdu = srsran::make_byte_buffer();
+  TESTASSERT(nas_pdu != nullptr);
+  int packed = liblte_mme_pack_authentication_response_msg(
+      &auth_resp, LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS, 0, (LIBLTE_BYTE_MSG_STRUCT*)nas_pdu.get());
+  TESTASSERT(packed == LIBLTE_SUCCESS);
+
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_UL_NAS_TRANSPORT);
+  ul_nas_transport_s& container   = pdu.init_msg().value.ul_nas_transport();
+  container->mme_ue_s1ap_id.value = dl_nas->mme_ue_s1ap_id.value;
+  container->enb_ue_s1ap_id.value = dl_nas->enb_ue_s1ap_id.value;
+  container->nas_pdu.value.resize(nas_pdu->N_bytes);
+  memcpy(container->nas_pdu.value.data(), nas_pdu->msg, nas_pdu->N_bytes);
+  bool sent = enb.send(pdu, 1);
+  TESTASSERT(sent);
+  return SRSRAN_SUCCESS;
+}
+
+static void print_latencies(const char* name, std::vector<std::chrono::nanoseconds> latencies)
+{
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) {
+    size_t idx = std::min((size_t)(p * latencies.size()), latencies.size() - 1);
+    return latencies[idx].count() / 1000.0;
+  };
+  fmt::print("{:>21}  {:>10.1f}  {:>10.1f}  {:>10.1f}  {:>10.1f}\n",
+             name,
+             percentile(0.5),
+             percentile(0.9),
+             percentile(0.99),
+             latencies.back().count() / 1000.0);
+}
+
+int run_benchmark(uint32_t nof_ues, uint32_t concurrency, uint32_t nof_workers)
+{
+  uint16_t mcc = 0, mnc = 0;
+  uint32_t plmn = 0;
+  srsran::string_to_mcc("001", &mcc);
+  srsran::string_to_mnc("01", &mnc);
+  srsran::s1ap_mccmnc_to_plmn(mcc, mnc, &plmn);
+
+  // The subscribers are read by the HSS from the binary database, as with large populations
+  std::string csv = "/tmp/mme_attach_benchmark_" + std::to_string(getpid()) + ".csv";
+  std::string db  = "/tmp/mme_attach_benchmark_" + std::to_string(getpid()) + ".db";
+  write_csv(csv, nof_ues);
+  bool converted = hss_db::convert_csv(csv, db);
+  unlink(csv.c_str());
+  TESTASSERT(converted);
+
+  hss_args_t hss_args = {};
+  hss_args.db_file    = db;
+  hss_args.mcc        = mcc;
+  hss_args.mnc        = mnc;
+  hss* hss_obj        = hss::get_instance();
+  int ret             = hss_obj->init(&hss_args);
+  TESTASSERT(ret == SRSRAN_SUCCESS);
+
+  mme_args_t mme_args                = {};
+  mme_args.s1ap_args.mme_code        = 0x01;
+  mme_args.s1ap_args.mme_group       = 0x0001;
+  mme_args.s1ap_args.tac             = tac;
+  mme_args.s1ap_args.mcc             = mcc;
+  mme_args.s1ap_args.mnc             = mnc;
+  mme_args.s1ap_args.paging_timer    = 2;
+  mme_args.s1ap_args.mme_bind_addr   = mme_addr_str;
+  mme_args.s1ap_args.mme_name        = "srsmme01";
+  mme_args.s1ap_args.dns_addr        = "8.8.8.8";
+  mme_args.s1ap_args.mme_apn         = "srsapn";
+  mme_args.s1ap_args.encryption_algo = srsran::CIPHERING_ALGORITHM_ID_EEA0;
+  mme_args.s1ap_args.integrity_algo  = srsran::INTEGRITY_ALGORITHM_ID_128_EIA1;
+  mme_args.nof_workers               = nof_workers;
+  mme* mme_obj                       = mme::get_instance();
+  ret                                = mme_obj->init(&mme_args);
+  TESTASSERT(ret == SRSRAN_SUCCESS);
+  mme_obj->start();
+
+  std::vector<bench_clock::time_point>  start_times(nof_ues);
+  std::vector<std::chrono::nanoseconds> auth_latencies, attach_latencies;
+  auth_latencies.reserve(nof_ues);
+  attach_latencies.reserve(nof_ues);
+  uint32_t next_ue = 0, nof_attached = 0;
+
+  bench_clock::time_point tp_start;
+  {
+    enb_standin enb;
+    ret = send_s1_setup(enb, plmn);
+    TESTASSERT(ret == SRSRAN_SUCCESS);
+
+    tp_start                        = bench_clock::now();
+    bench_clock::time_point last_rx = tp_start;
+    while (nof_attached < nof_ues) {
+      while (next_ue < nof_ues and next_ue - nof_attached < concurrency) {
+        start_times[next_ue] = bench_clock::now();
+        ret                  = send_attach_request(enb, next_ue, plmn);
+        TESTASSERT(ret == SRSRAN_SUCCESS);
+        next_ue++;
+      }
+
+      s1ap_pdu_c pdu;
+      if (not enb.recv(pdu)) {
+        TESTASSERT(bench_clock::now() - last_rx < std::chrono::milliseconds(mme_timeout_ms));
+        continue;
+      }
+      auto now = bench_clock::now();
+      last_rx  = now;
+
+      // All the messages of the attach up to the Security Mode Command are Downlink NAS Transports
+      TESTASSERT(pdu.type().value == s1ap_pdu_c::types_opts::init_msg);
+      TESTASSERT(pdu.init_msg().value.type().value == s1ap_elem_procs_o::init_msg_c::types_opts::dl_nas_transport);
+      const dl_nas_transport_s& dl_nas = pdu.init_msg().value.dl_nas_transport();
+      uint32_t                  ue_idx = dl_nas->enb_ue_s1ap_id.value;
+      TESTASSERT(ue_idx < next_ue);
+
+      srsran::unique_byte_buffer_t nas_rx = srsran::make_byte_buffer();
+      TESTASSERT(nas_rx != nullptr);
+      memcpy(nas_rx->msg, dl_nas->nas_pdu.value.data(), dl_nas->nas_pdu.value.size());
+      nas_rx->N_bytes = dl_nas->nas_pdu.value.size();
+      uint8_t pd = 0, msg_type = 0;
+      liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)nas_rx.get(), &pd, &msg_type);
+
+      if (msg_type == LIBLTE_MME_MSG_TYPE_AUTHENTICATION_REQUEST) {
+        auth_latencies.push_back(now - start_times[ue_idx]);
+        ret = send_authentication_response(enb, dl_nas, *nas_rx, ue_idx);
+        TESTASSERT(ret == SRSRAN_SUCCESS);
+      } else if (msg_type == LIBLTE_MME_MSG_TYPE_SECURITY_MODE_COMMAND) {
+        attach_latencies.push_back(now - start_times[ue_idx]);
+        nof_attached++;
+      } else {
+        fmt::print("Unexpected NAS message {} for UE {}\n", liblte_nas_msg_type_to_string(msg_type), ue_idx);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+  double duration_s = std::chrono::duration<double>(bench_clock::now() - tp_start).count();
+
+  mme_obj->stop();
+  mme::cleanup();
+  hss_obj->stop();
+  hss::cleanup();
+  unlink(db.c_str());
+
+  fmt::print(
+      "\n{:>7}  {:>11}  {:>7}  {:>12}  {:>10}\n", "nof_ues", "concurrency", "workers", "duration [s]", "attaches/s");
+  fmt::print("{:>7}  {:>11}  {:>7}  {:>12.3f}  {:>10.1f}\n",
+             nof_ues,
+             concurrency,
+             nof_workers,
+             duration_s,
+             nof_ues / duration_s);
+  fmt::print("\n{:>21}  {:>10}  {:>10}  {:>10}  {:>10}\n", "latency [us]", "p50", "p90", "p99", "max");
+  print_latencies("AuthenticationRequest", auth_latencies);
+  print_latencies("SecurityModeCommand", attach_latencies);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("S1AP").set_level(srslog::basic_levels::none);
+  srslog::fetch_basic_logger("NAS").set_level(srslog::basic_levels::none);
+  srslog::fetch_basic_logger("MME GTPC").set_level(srslog::basic_levels::none);
+  srslog::fetch_basic_logger("HSS").set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  uint32_t nof_ues     = 5000;
+  uint32_t concurrency = 64;
+  uint32_t nof_workers = 1;
+  if (argc > 1) {
+    nof_ues = strtoul(argv[1], nullptr, 10);
+  }
+  if (argc > 2) {
+    concurrency = strtoul(argv[2], nullptr, 10);
+  }
+  if (argc > 3) {
+    nof_workers = strtoul(argv[3], nullptr, 10);
+  }
+  if (nof_ues == 0 or nof_ues > 0xffffff or concurrency == 0 or concurrency > max_concurrency or nof_workers == 0 or
+      nof_workers > max_workers) {
+    fmt::print("Usage: {} [nof_ues (1-{})] [concurrency (1-{})] [nof_workers (1-{})]\n",
+               argv[0],
+               0xffffff,
+               max_concurrency,
+               max_workers);
+    return SRSRAN_ERROR;
+  }
+
+  int ret = run_benchmark(nof_ues, concurrency, nof_workers);
+
+  srslog::flush();
+  return ret;
+}
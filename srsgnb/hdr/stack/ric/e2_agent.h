@@ -42,13 +42,14 @@ enum e2_msg_type_t {
 };
 
 struct e2_agent_args_t {
-  bool        enable;
-  std::string ric_ip;
-  uint32_t    ric_port;
-  std::string ric_bind_ip;
-  uint32_t    ric_bind_port;
-  int32_t     max_ric_setup_retries;
-  uint32_t    ric_connect_timer;
+  bool                  enable;
+  std::string           ric_ip;
+  uint32_t              ric_port;
+  std::string           ric_bind_ip;
+  uint32_t              ric_bind_port;
+  int32_t               max_ric_setup_retries;
+  uint32_t              ric_connect_timer;
+  std::vector<uint64_t> cell_ids; ///< Cell identity (ECI or NCI) of each cell, in the order of the cell metrics
 };
 
 namespace srsenb {
@@ -67,8 +68,10 @@ public:
 
   // Send messages to RIC
   bool send_sctp(srsran::unique_byte_buffer_t& buf);
+  bool send_sctp_batch(std::vector<srsran::unique_byte_buffer_t>& msgs);
   bool send_e2_msg(e2_msg_type_t msg_type);
   bool queue_send_e2ap_pdu(e2_ap_pdu_c send_pdu);
+  bool queue_send_e2ap_msgs(std::vector<srsran::unique_byte_buffer_t> msgs);
   bool send_e2ap_pdu(e2_ap_pdu_c send_pdu);
   bool send_reset_response();
 
@@ -54,6 +54,31 @@ typedef struct {
   std::vector<uint32_t> not_admitted_actions;
 } ric_subscription_reponse_t;
 
+// RIC Indication PDU of a subscription action with the IEs that are the same in all its indications packed once, so
+// only the sequence number, header and message are encoded when an indication is sent
+class ric_indication_template
+{
+public:
+  // pdu is a RIC Indication of the action, the content of its header and message is ignored
+  bool init(const e2_ap_pdu_c& pdu);
+  bool is_initialized() const { return not pdu_prefix.empty(); }
+
+  // produces the same bytes as packing the RIC Indication PDU, false if the indication does not match the template
+  // or the PDU is too long to be packed without fragmentation
+  bool pack(const ric_indication_t& ric_indication, srsran::byte_buffer_t& buf) const;
+
+private:
+  std::vector<uint8_t> pdu_prefix;    // PDU type, procedure code and criticality
+  std::vector<uint8_t> value_prefix;  // extension bit and number of IEs
+  std::vector<uint8_t> fixed_ies;     // RIC Request ID, RAN Function ID and RIC Action ID
+  std::vector<uint8_t> sn_ie_prefix;  // IE ID, criticality and length of the RIC Indication SN
+  std::vector<uint8_t> type_ie;       // RIC Indication Type
+  std::vector<uint8_t> hdr_ie_prefix; // IE ID and criticality of the RIC Indication Header
+  std::vector<uint8_t> msg_ie_prefix; // IE ID and criticality of the RIC Indication Message
+  bool                 sn_present      = false;
+  ri_cind_type_e       indication_type = ri_cind_type_opts::report;
+};
+
 class e2_agent;
 
 class e2ap
@@ -94,9 +119,11 @@ public:
   int process_e2_removal_failure(e2_removal_fail_s e2_remove_failure);
 
   bool queue_send_e2ap_pdu(e2_ap_pdu_c e2ap_pdu);
+  bool queue_send_e2ap_msgs(std::vector<srsran::unique_byte_buffer_t> msgs);
 
   int  get_reset_id();
   bool get_func_desc(uint32_t ran_func_id, RANfunction_description& fdesc);
+  void set_cell_ids(const std::vector<uint64_t>& cell_ids) { e2sm_.set_cell_ids(cell_ids); }
   bool send_setup_request() { return !e2_established && pending_e2_setup; }
 
   class ric_subscription;
@@ -50,6 +50,7 @@ private:
   void     _send_subscription_response();
   void     _send_subscription_failure();
   void     _send_ric_indication();
+  void     _fill_ric_indication(const E2AP_RIC_action_t& action, ric_indication_t& ric_indication);
   uint32_t _generate_ric_indication_sn();
 
   e2ap* parent      = nullptr;
@@ -63,8 +64,9 @@ private:
   uint32_t             reporting_period = 0; // ms
   srsran::unique_timer reporting_timer;      // for RIC indication reporting
 
-  std::vector<E2AP_RIC_action_t> admitted_actions;
-  std::vector<uint32_t>          not_admitted_actions;
+  std::vector<E2AP_RIC_action_t>       admitted_actions;
+  std::vector<ric_indication_template> indication_templates; // one for each admitted action
+  std::vector<uint32_t>                not_admitted_actions;
 
   uint32_t _ric_indication_sn_gen = 0;
 };
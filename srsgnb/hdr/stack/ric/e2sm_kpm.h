@@ -21,10 +21,12 @@
 
 #include "e2sm.h"
 #include "e2sm_kpm_common.h"
+#include "e2sm_kpm_registry.h"
 #include "srsran/asn1/e2ap.h"
 #include "srsran/asn1/e2sm.h"
 #include "srsran/asn1/e2sm_kpm_v2.h"
 #include "srsran/srsran.h"
+#include <mutex>
 
 #ifndef RIC_E2SM_KPM_H
 #define RIC_E2SM_KPM_H
@@ -54,6 +56,9 @@ public:
 
   virtual void receive_e2_metrics_callback(const enb_metrics_t& m);
 
+  /// Sets the cell identity (ECI or NCI) of each cell of the E2 node, indexed by the cell index of its metrics
+  void set_cell_ids(const std::vector<uint64_t>& cell_ids_) { cell_ids = cell_ids_; }
+
   friend class e2sm_kpm_report_service;
   friend class e2sm_kpm_report_service_style1;
   friend class e2sm_kpm_report_service_style2;
@@ -65,19 +70,16 @@ private:
   bool _generate_indication_header(e2_sm_kpm_ind_hdr_s& hdr, srsran::unique_byte_buffer_t& buf);
   bool _generate_indication_message(e2_sm_kpm_ind_msg_s& msg, srsran::unique_byte_buffer_t& buf);
   bool                     _get_meas_definition(std::string meas_name, e2sm_kpm_metric_t& def);
+  bool                     _get_cell_idx(const cgi_c& cell_global_id, uint32_t& cell_idx);
   std::vector<std::string> _get_supported_meas(uint32_t level_mask);
 
-  bool _collect_meas_value(e2sm_kpm_meas_def_t& meas_value, meas_record_item_c& item);
-  bool
-  _extract_integer_type_meas_value(e2sm_kpm_meas_def_t& meas_value, const enb_metrics_t& enb_metrics, uint32_t& value);
-  bool _extract_real_type_meas_value(e2sm_kpm_meas_def_t& meas_value, const enb_metrics_t& enb_metrics, float& value);
-
   srslog::basic_logger&                        logger;
-  std::vector<e2sm_kpm_metric_t>               supported_meas_types;
+  e2sm_kpm_registry                            registry;
   std::map<uint32_t, e2sm_kpm_report_service*> registered_actions_data;
+  std::vector<uint64_t>                        cell_ids;
 
-  srsran_random_t random_gen;
-
+  // protects the registered actions and their measurements, metrics are received from the metrics thread
+  std::mutex    metrics_mutex;
   enb_metrics_t last_enb_metrics;
 };
 
@@ -22,50 +22,242 @@
 #ifndef SRSRAN_E2SM_KPM_METRICS_H
 #define SRSRAN_E2SM_KPM_METRICS_H
 
-#include "e2sm_kpm_common.h"
+#include "e2sm_kpm_registry.h"
 #include "srsran/srsran.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+// Accessors of the measurements over the metrics of the eNB/gNB
+static const mac_ue_metrics_t& kpm_mac_ue(const enb_metrics_t& m, uint32_t ue_idx)
+{
+  return e2sm_kpm_get_stack_metrics(m).mac.ues[ue_idx];
+}
+
+static double kpm_ue_thp_dl(const enb_metrics_t& m, uint32_t ue_idx)
+{
+  // Bits per TTI are kbps
+  const mac_ue_metrics_t& ue = kpm_mac_ue(m, ue_idx);
+  return ue.nof_tti > 0 ? (double)ue.tx_brate / ue.nof_tti : 0.0;
+}
+
+static double kpm_ue_thp_ul(const enb_metrics_t& m, uint32_t ue_idx)
+{
+  const mac_ue_metrics_t& ue = kpm_mac_ue(m, ue_idx);
+  return ue.nof_tti > 0 ? (double)ue.rx_brate / ue.nof_tti : 0.0;
+}
+
+static double kpm_ue_tb_dl(const enb_metrics_t& m, uint32_t ue_idx)
+{
+  return kpm_mac_ue(m, ue_idx).tx_pkts;
+}
+
+static double kpm_ue_tb_err_dl(const enb_metrics_t& m, uint32_t ue_idx)
+{
+  return kpm_mac_ue(m, ue_idx).tx_errors;
+}
+
+static double kpm_ue_tb_ul(const enb_metrics_t& m, uint32_t ue_idx)
+{
+  return kpm_mac_ue(m, ue_idx).rx_pkts;
+}
+
+static double kpm_ue_tb_err_ul(const enb_metrics_t& m, uint32_t ue_idx)
+{
+  return kpm_mac_ue(m, ue_idx).rx_errors;
+}
+
+/// PDCP metrics of a MAC UE, only reported by the EUTRA stack
+static const srsran::pdcp_metrics_t* kpm_pdcp_ue(const enb_metrics_t& m, uint32_t ue_idx)
+{
+  const stack_metrics_t& stack = e2sm_kpm_get_stack_metrics(m);
+  uint16_t               rnti  = stack.mac.ues[ue_idx].rnti;
+  // Both layers list their UEs by RNTI, so the PDCP UE is usually at the same position
+  if (ue_idx < stack.pdcp.ues.size() and stack.pdcp.ues[ue_idx].rnti == rnti) {
+    return &stack.pdcp.ues[ue_idx];
+  }
+  auto it = std::find_if(stack.pdcp.ues.begin(), stack.pdcp.ues.end(), [rnti](const srsran::pdcp_metrics_t& ue) {
+    return ue.rnti == rnti;
+  });
+  return it != stack.pdcp.ues.end() ? &(*it) : nullptr;
+}
+
+static double kpm_ue_pdcp_vol_dl(const enb_metrics_t& m, uint32_t ue_idx)
+{
+  const srsran::pdcp_metrics_t* pdcp = kpm_pdcp_ue(m, ue_idx);
+  if (pdcp == nullptr) {
+    return 0.0;
+  }
+  uint64_t nof_bytes = 0;
+  for (uint32_t lcid = SRSRAN_N_SRB; lcid < SRSRAN_N_RADIO_BEARERS; lcid++) {
+    nof_bytes += pdcp->bearer[lcid].num_tx_sdu_bytes;
+  }
+  return nof_bytes * 8 / 1e3;
+}
+
+static double kpm_ue_pdcp_vol_ul(const enb_metrics_t& m, uint32_t ue_idx)
+{
+  const srsran::pdcp_metrics_t* pdcp = kpm_pdcp_ue(m, ue_idx);
+  if (pdcp == nullptr) {
+    return 0.0;
+  }
+  uint64_t nof_bytes = 0;
+  for (uint32_t lcid = SRSRAN_N_SRB; lcid < SRSRAN_N_RADIO_BEARERS; lcid++) {
+    nof_bytes += pdcp->bearer[lcid].num_rx_sdu_bytes;
+  }
+  return nof_bytes * 8 / 1e3;
+}
+
+static double kpm_ue_dl_cqi(const enb_metrics_t& m, uint32_t ue_idx)
+{
+  return kpm_mac_ue(m, ue_idx).dl_cqi;
+}
+
+static double kpm_ue_dl_mcs(const enb_metrics_t& m, uint32_t ue_idx)
+{
+  return kpm_mac_ue(m, ue_idx).dl_mcs;
+}
+
+static double kpm_ue_ul_mcs(const enb_metrics_t& m, uint32_t ue_idx)
+{
+  return kpm_mac_ue(m, ue_idx).ul_mcs;
+}
+
+static double kpm_ue_ul_rssi(const enb_metrics_t& m, uint32_t ue_idx)
+{
+  return kpm_mac_ue(m, ue_idx).ul_rssi;
+}
+
+/// Cell value as the sum of the values of its UEs
+template <e2sm_kpm_ue_accessor_t ue_value>
+static double kpm_cell_sum(const enb_metrics_t& m, uint32_t cell_idx)
+{
+  const std::vector<mac_ue_metrics_t>& ues = e2sm_kpm_get_stack_metrics(m).mac.ues;
+  double                               sum = 0.0;
+  for (uint32_t i = 0; i < ues.size(); i++) {
+    if (ues[i].cc_idx == cell_idx) {
+      sum += ue_value(m, i);
+    }
+  }
+  return sum;
+}
+
+/// Cell value as the average of the values of its UEs
+template <e2sm_kpm_ue_accessor_t ue_value>
+static double kpm_cell_avg(const enb_metrics_t& m, uint32_t cell_idx)
+{
+  const std::vector<mac_ue_metrics_t>& ues    = e2sm_kpm_get_stack_metrics(m).mac.ues;
+  double                               sum    = 0.0;
+  uint32_t                             nof_ue = 0;
+  for (uint32_t i = 0; i < ues.size(); i++) {
+    if (ues[i].cc_idx == cell_idx) {
+      sum += ue_value(m, i);
+      nof_ue++;
+    }
+  }
+  return nof_ue > 0 ? sum / nof_ue : 0.0;
+}
+
+static double kpm_cell_nof_ues(const enb_metrics_t& m, uint32_t cell_idx)
+{
+  const std::vector<mac_ue_metrics_t>& ues = e2sm_kpm_get_stack_metrics(m).mac.ues;
+  return std::count_if(
+      ues.begin(), ues.end(), [cell_idx](const mac_ue_metrics_t& ue) { return ue.cc_idx == cell_idx; });
+}
+
+static double kpm_cell_rach_counter(const enb_metrics_t& m, uint32_t cell_idx)
+{
+  const std::vector<mac_cc_info_t>& cc_info = e2sm_kpm_get_stack_metrics(m).mac.cc_info;
+  return cell_idx < cc_info.size() ? cc_info[cell_idx].cc_rach_counter : 0.0;
+}
+
+static double kpm_enb_nof_ues(const enb_metrics_t& m)
+{
+  return e2sm_kpm_get_stack_metrics(m).mac.ues.size();
+}
+
+static double kpm_enb_cpu0_load(const enb_metrics_t& m)
+{
+  return m.sys.cpu_load[0];
+}
+
+static double kpm_enb_cpu_load(const enb_metrics_t& m)
+{
+  return std::accumulate(m.sys.cpu_load.begin(), m.sys.cpu_load.end(), 0.0) / m.sys.cpu_load.size();
+}
+
+static double kpm_cell_random_int(const enb_metrics_t& m, uint32_t cell_idx)
+{
+  static std::minstd_rand random_gen(1234);
+  return std::uniform_int_distribution<uint32_t>(0, 100)(random_gen);
+}
 
 // clang-format off
 // Measurements defined in 3GPP TS 28.552
-std::vector<e2sm_kpm_metric_t> get_e2sm_kpm_28_552_metrics()
+std::vector<e2sm_kpm_registry_entry_t> get_e2sm_kpm_28_552_metrics()
 {
   // TODO: add all metrics from 3GPP TS 28.552
-  std::vector<e2sm_kpm_metric_t> metrics;
-  // not supported metrics
-  metrics.push_back({"RRU.PrbTotDl", false, REAL, "%", true, 0, true, 100, NO_LABEL | AVG_LABEL, CELL_LEVEL | UE_LEVEL });
-  metrics.push_back({"RRU.PrbTotUl", false, REAL, "%", true, 0, true, 100, NO_LABEL | AVG_LABEL, CELL_LEVEL | UE_LEVEL });
+  std::vector<e2sm_kpm_registry_entry_t> metrics;
+  // supported metrics
+  metrics.push_back({{"DRB.UEThpDl", true, INTEGER, "kbps", true, 0, false, 0, NO_LABEL | MIN_LABEL | MAX_LABEL | AVG_LABEL, CELL_LEVEL | UE_LEVEL },
+                     AVG_LABEL, nullptr, kpm_cell_sum<kpm_ue_thp_dl>, kpm_ue_thp_dl});
+  metrics.push_back({{"DRB.UEThpUl", true, INTEGER, "kbps", true, 0, false, 0, NO_LABEL | MIN_LABEL | MAX_LABEL | AVG_LABEL, CELL_LEVEL | UE_LEVEL },
+                     AVG_LABEL, nullptr, kpm_cell_sum<kpm_ue_thp_ul>, kpm_ue_thp_ul});
+  metrics.push_back({{"RRC.ConnMean", true, INTEGER, "-", true, 0, false, 0, NO_LABEL | MIN_LABEL | MAX_LABEL | AVG_LABEL, ENB_LEVEL | CELL_LEVEL },
+                     AVG_LABEL, kpm_enb_nof_ues, kpm_cell_nof_ues, nullptr});
+  metrics.push_back({{"TB.TotNbrDl", true, INTEGER, "-", true, 0, false, 0, NO_LABEL | SUM_LABEL, CELL_LEVEL | UE_LEVEL },
+                     SUM_LABEL, nullptr, kpm_cell_sum<kpm_ue_tb_dl>, kpm_ue_tb_dl});
+  metrics.push_back({{"TB.ErrTotalNbrDl", true, INTEGER, "-", true, 0, false, 0, NO_LABEL | SUM_LABEL, CELL_LEVEL | UE_LEVEL },
+                     SUM_LABEL, nullptr, kpm_cell_sum<kpm_ue_tb_err_dl>, kpm_ue_tb_err_dl});
+  metrics.push_back({{"TB.TotNbrUl", true, INTEGER, "-", true, 0, false, 0, NO_LABEL | SUM_LABEL, CELL_LEVEL | UE_LEVEL },
+                     SUM_LABEL, nullptr, kpm_cell_sum<kpm_ue_tb_ul>, kpm_ue_tb_ul});
+  metrics.push_back({{"TB.ErrTotalNbrUl", true, INTEGER, "-", true, 0, false, 0, NO_LABEL | SUM_LABEL, CELL_LEVEL | UE_LEVEL },
+                     SUM_LABEL, nullptr, kpm_cell_sum<kpm_ue_tb_err_ul>, kpm_ue_tb_err_ul});
+  metrics.push_back({{"DRB.PdcpSduVolumeDL", true, INTEGER, "kbit", true, 0, false, 0, NO_LABEL | SUM_LABEL, CELL_LEVEL | UE_LEVEL },
+                     SUM_LABEL, nullptr, kpm_cell_sum<kpm_ue_pdcp_vol_dl>, kpm_ue_pdcp_vol_dl});
+  metrics.push_back({{"DRB.PdcpSduVolumeUL", true, INTEGER, "kbit", true, 0, false, 0, NO_LABEL | SUM_LABEL, CELL_LEVEL | UE_LEVEL },
+                     SUM_LABEL, nullptr, kpm_cell_sum<kpm_ue_pdcp_vol_ul>, kpm_ue_pdcp_vol_ul});
   // not supported metrics
-  metrics.push_back({"RRU.RachPreambleDedMean", false, REAL, "-", false, 0, false, 100, NO_LABEL, CELL_LEVEL | UE_LEVEL });
+  metrics.push_back({{"RRU.PrbTotDl", false, REAL, "%", true, 0, true, 100, NO_LABEL | AVG_LABEL, CELL_LEVEL | UE_LEVEL }, AVG_LABEL, nullptr, nullptr, nullptr});
+  metrics.push_back({{"RRU.PrbTotUl", false, REAL, "%", true, 0, true, 100, NO_LABEL | AVG_LABEL, CELL_LEVEL | UE_LEVEL }, AVG_LABEL, nullptr, nullptr, nullptr});
+  metrics.push_back({{"RRU.RachPreambleDedMean", false, REAL, "-", false, 0, false, 100, NO_LABEL, CELL_LEVEL | UE_LEVEL }, AVG_LABEL, nullptr, nullptr, nullptr});
   return metrics;
 }
 
 // Measurements defined in 3GPP TS 32.425
-std::vector<e2sm_kpm_metric_t> get_e2sm_kpm_34_425_metrics()
+std::vector<e2sm_kpm_registry_entry_t> get_e2sm_kpm_34_425_metrics()
 {
   // TODO: add all metrics from 3GPP TS 32.425
-  std::vector<e2sm_kpm_metric_t> metrics;
+  std::vector<e2sm_kpm_registry_entry_t> metrics;
   return metrics;
 }
 
 // E2SM_KPM O-RAN specific Measurements
-std::vector<e2sm_kpm_metric_t> e2sm_kpm_oran_metrics()
+std::vector<e2sm_kpm_registry_entry_t> e2sm_kpm_oran_metrics()
 {
   // TODO: add all E2SM_KPM O-RAN specific Measurements
-  std::vector<e2sm_kpm_metric_t> metrics;
+  std::vector<e2sm_kpm_registry_entry_t> metrics;
   return metrics;
 }
 
 // Custom Measurements
-std::vector<e2sm_kpm_metric_t> e2sm_kpm_custom_metrics()
+std::vector<e2sm_kpm_registry_entry_t> e2sm_kpm_custom_metrics()
 {
-  std::vector<e2sm_kpm_metric_t> metrics;
+  std::vector<e2sm_kpm_registry_entry_t> metrics;
   // supported metrics
-  metrics.push_back({"test", true, INTEGER, "", true, 0, true, 100, NO_LABEL, ENB_LEVEL | CELL_LEVEL | UE_LEVEL });
-  metrics.push_back({"random_int", true, INTEGER, "", true, 0, true, 100, NO_LABEL, CELL_LEVEL });
-  metrics.push_back({"cpu0_load", true, REAL, "", true, 0, true, 100, NO_LABEL, ENB_LEVEL });
-  metrics.push_back({"cpu_load", true, REAL, "", true, 0, true, 100, MIN_LABEL|MAX_LABEL|AVG_LABEL, ENB_LEVEL });
+  metrics.push_back({{"test", true, INTEGER, "", true, 0, true, 100, NO_LABEL, ENB_LEVEL | CELL_LEVEL | UE_LEVEL },
+                     AVG_LABEL, kpm_enb_cpu0_load, kpm_cell_rach_counter, kpm_ue_ul_rssi});
+  metrics.push_back({{"random_int", true, INTEGER, "", true, 0, true, 100, NO_LABEL, CELL_LEVEL }, AVG_LABEL, nullptr, kpm_cell_random_int, nullptr});
+  metrics.push_back({{"cpu0_load", true, REAL, "", true, 0, true, 100, NO_LABEL, ENB_LEVEL }, AVG_LABEL, kpm_enb_cpu0_load, nullptr, nullptr});
+  metrics.push_back({{"cpu_load", true, REAL, "", true, 0, true, 100, MIN_LABEL|MAX_LABEL|AVG_LABEL, ENB_LEVEL }, AVG_LABEL, kpm_enb_cpu_load, nullptr, nullptr});
+  metrics.push_back({{"dl_cqi", true, INTEGER, "", true, 0, true, 15, NO_LABEL | MIN_LABEL | MAX_LABEL | AVG_LABEL, CELL_LEVEL | UE_LEVEL },
+                     AVG_LABEL, nullptr, kpm_cell_avg<kpm_ue_dl_cqi>, kpm_ue_dl_cqi});
+  metrics.push_back({{"dl_mcs", true, INTEGER, "", true, 0, true, 28, NO_LABEL | MIN_LABEL | MAX_LABEL | AVG_LABEL, CELL_LEVEL | UE_LEVEL },
+                     AVG_LABEL, nullptr, kpm_cell_avg<kpm_ue_dl_mcs>, kpm_ue_dl_mcs});
+  metrics.push_back({{"ul_mcs", true, INTEGER, "", true, 0, true, 28, NO_LABEL | MIN_LABEL | MAX_LABEL | AVG_LABEL, CELL_LEVEL | UE_LEVEL },
+                     AVG_LABEL, nullptr, kpm_cell_avg<kpm_ue_ul_mcs>, kpm_ue_ul_mcs});
   // not supported metrics
-  metrics.push_back({"test123", false,  REAL, "", true, 0, true, 100, NO_LABEL, CELL_LEVEL | UE_LEVEL });
+  metrics.push_back({{"test123", false,  REAL, "", true, 0, true, 100, NO_LABEL, CELL_LEVEL | UE_LEVEL }, AVG_LABEL, nullptr, nullptr, nullptr});
   return metrics;
 }
 
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "e2sm_kpm_common.h"
+#include "srsran/interfaces/enb_metrics_interface.h"
+#include <unordered_map>
+
+#ifndef SRSRAN_E2SM_KPM_REGISTRY_H
+#define SRSRAN_E2SM_KPM_REGISTRY_H
+
+using namespace srsenb;
+
+// Accessors of a measurement over a metrics report. The cell accessor gets the index of the cell and the UE accessor
+// the index of the UE in the MAC metrics
+typedef double (*e2sm_kpm_enb_accessor_t)(const enb_metrics_t& m);
+typedef double (*e2sm_kpm_cell_accessor_t)(const enb_metrics_t& m, uint32_t cell_idx);
+typedef double (*e2sm_kpm_ue_accessor_t)(const enb_metrics_t& m, uint32_t ue_idx);
+
+typedef struct {
+  e2sm_kpm_metric_t        def;
+  e2sm_kpm_label_enum      no_label_stat; // Statistic reported without label, AVG_LABEL or SUM_LABEL (counters)
+  e2sm_kpm_enb_accessor_t  enb_value;
+  e2sm_kpm_cell_accessor_t cell_value;
+  e2sm_kpm_ue_accessor_t   ue_value;
+} e2sm_kpm_registry_entry_t;
+
+/// Metrics of the NR stack when it has cells, otherwise the ones of the EUTRA stack
+const stack_metrics_t& e2sm_kpm_get_stack_metrics(const enb_metrics_t& m);
+
+/// Supported measurements by name, only looked up when an action is admitted
+class e2sm_kpm_registry
+{
+public:
+  e2sm_kpm_registry();
+
+  const e2sm_kpm_registry_entry_t* find(const std::string& meas_name) const;
+  std::vector<std::string>         get_supported_meas(uint32_t level_mask) const;
+
+private:
+  std::vector<e2sm_kpm_registry_entry_t>    entries;
+  std::unordered_map<std::string, uint32_t> name_to_idx;
+};
+
+/// Measurement of an admitted action, bound to its registry entry, label and scope. Every metrics report updates the
+/// label statistics, so a record is produced without going through the metrics again
+class e2sm_kpm_meas_t
+{
+public:
+  e2sm_kpm_meas_t(const e2sm_kpm_registry_entry_t* entry_,
+                  e2sm_kpm_label_enum              label_,
+                  e2sm_kpm_metric_scope_enum       scope_,
+                  uint32_t                         id_);
+
+  void add_sample(const enb_metrics_t& m);
+  bool has_samples() const { return nof_samples > 0; }
+  /// Counters count the events of each metrics report, unlike gauges their last value does not hold until the next one
+  bool is_counter() const { return entry != nullptr and entry->no_label_stat == SUM_LABEL; }
+
+  /// Writes the label statistic of the samples since the last reset, or no value if there are none
+  void get_record(meas_record_item_c& item) const;
+  void reset();
+
+private:
+  bool get_sample(const enb_metrics_t& m, double& value);
+
+  const e2sm_kpm_registry_entry_t* entry;
+  e2sm_kpm_label_enum              label;
+  e2sm_kpm_metric_scope_enum       scope;
+  uint32_t                         id;              // Cell index for CELL_LEVEL, RNTI for UE_LEVEL
+  uint32_t                         ue_idx_hint = 0; // The UEs keep their order between metrics reports
+
+  uint32_t nof_samples = 0;
+  double   min_val     = 0.0;
+  double   max_val     = 0.0;
+  double   sum_val     = 0.0;
+};
+
+#endif // SRSRAN_E2SM_KPM_REGISTRY_H
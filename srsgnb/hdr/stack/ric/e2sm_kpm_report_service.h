@@ -46,11 +46,17 @@ public:
   virtual bool is_ric_ind_ready()        = 0;
   virtual bool clear_collected_data()    = 0;
 
+  // packs the indication message with the data collected since the last indication
+  virtual bool _pack_ric_ind_msg(srsran::unique_byte_buffer_t& buf);
+
   virtual bool _start_meas_collection();
   bool         stop();
   virtual bool _stop_meas_collection();
   virtual bool _reschedule_meas_collection();
 
+  // add the samples of a metrics report to the measurements of the action
+  void _add_meas_samples(const enb_metrics_t& m);
+
   std::vector<e2sm_kpm_label_enum> _get_present_labels(const meas_info_item_s& action_meas_info_item);
   meas_record_item_c::types
   _get_meas_data_type(std::string meas_name, e2sm_kpm_label_enum label, meas_record_l& meas_record_list);
@@ -73,6 +79,9 @@ public:
 
   uint32_t             granul_period = 0;
   srsran::unique_timer meas_collection_timer; // for measurements collection
+
+  // measurements resolved in the registry when the action is admitted, in the order of the meas_info_list
+  std::vector<e2sm_kpm_meas_t> meas_list;
 };
 
 class e2sm_kpm_report_service_style1 : public e2sm_kpm_report_service
@@ -89,16 +98,34 @@ public:
   virtual bool _collect_meas_data();
   virtual bool is_ric_ind_ready();
   virtual bool clear_collected_data();
+  virtual bool _pack_ric_ind_msg(srsran::unique_byte_buffer_t& buf);
 
-private:
-  meas_data_item_s&
-  _get_meas_data_item(std::string meas_name, e2sm_kpm_label_enum label, uint32_t ue_id, bool& ref_found);
+protected:
+  // measurements of a single UE if ue_rnti is valid, of the cell or the whole E2 node otherwise
+  e2sm_kpm_report_service_style1(e2sm_kpm*                     e2sm_kpm,
+                                 uint16_t                      action_id,
+                                 e2_sm_kpm_action_definition_s action_definition,
+                                 uint16_t                      ue_rnti);
+
+  static e2_sm_kpm_action_definition_format1_s&
+              _get_subscript_info(e2_sm_kpm_action_definition_s& action_definition);
+  static bool _process_subscript_info(e2sm_kpm*                              e2sm_kpm,
+                                      e2_sm_kpm_action_definition_format1_s& action_definition,
+                                      e2sm_kpm_metric_scope_enum             scope);
+
+  e2sm_kpm_metric_scope_enum meas_scope = ENB_LEVEL;
+  uint32_t                   meas_id    = 0; // cell index for CELL_LEVEL, RNTI for UE_LEVEL
 
+private:
   e2_sm_kpm_action_definition_format1_s& action_def;
   e2_sm_kpm_ind_msg_format1_s&           ric_ind_message;
+
+  // everything after the measurement data does not change between indications, so it is packed once
+  std::vector<uint8_t> ric_ind_msg_tail;
 };
 
-class e2sm_kpm_report_service_style2 : public e2sm_kpm_report_service
+// same measurements and indication message as style 1, but for the single UE given in the action definition
+class e2sm_kpm_report_service_style2 : public e2sm_kpm_report_service_style1
 {
 public:
   e2sm_kpm_report_service_style2(e2sm_kpm*                     e2sm_kpm,
@@ -108,14 +135,9 @@ public:
 
   static bool process_ric_action_definition(e2sm_kpm* e2sm_kpm, e2_sm_kpm_action_definition_s& action_definition);
 
-  virtual bool _initialize_ric_ind_msg();
-  virtual bool _collect_meas_data();
-  virtual bool is_ric_ind_ready();
-  virtual bool clear_collected_data();
-
 private:
-  e2_sm_kpm_action_definition_format2_s& action_def;
-  e2_sm_kpm_ind_msg_format1_s&           ric_ind_message;
+  // RNTI carried in the RAN UE ID of the UE identity, SRSRAN_INVALID_RNTI if there is none
+  static uint16_t _get_ue_rnti(const ueid_c& ue_id);
 };
 
 class e2sm_kpm_report_service_style3 : public e2sm_kpm_report_service
@@ -37,6 +37,8 @@ static int assert_ue_cfg_valid(uint16_t rnti, const sched_nr_interface::ue_cfg_t
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Class that stores events that are not specific to a CC (e.g. SRs, removal of UEs, buffer state updates)
+/// The event queues are preallocated and swapped every slot, so that the feedback path does not allocate once their
+/// capacity fits the largest number of events of a slot
 class sched_nr::event_manager
 {
 public:
@@ -79,9 +81,22 @@ public:
     fmt::memory_buffer    event_fmtbuf;
   };
 
+  /// UE feedback is stored in the event objects, without heap allocations
+  using ue_callback_t = srsran::move_callback<void(ue&, logger&), srsran::default_move_callback_buffer_size, true>;
+  using ue_cc_callback_t =
+      srsran::move_callback<void(ue_carrier&, logger&), srsran::default_move_callback_buffer_size, true>;
+
   explicit event_manager(sched_params_t& params) :
     sched_logger(srslog::fetch_basic_logger(params.sched_cfg.logger_name)), carriers(params.cells.size())
   {
+    next_slot_events.reserve(SRSENB_MAX_UES);
+    current_slot_events.reserve(SRSENB_MAX_UES);
+    next_slot_ue_events.reserve(nof_prealloc_events);
+    current_slot_ue_events.reserve(nof_prealloc_events);
+    for (cc_events& cc_ev : carriers) {
+      cc_ev.next_slot_ue_events.reserve(nof_prealloc_events);
+      cc_ev.current_slot_ue_events.reserve(nof_prealloc_events);
+    }
   }
 
   /// Enqueue an event that does not map into a ue method (e.g. rem_user, add_user)
@@ -93,7 +108,7 @@ public:
 
   /// Enqueue an event that directly maps into a ue method (e.g. ul_sr_info, ul_bsr, etc.)
   /// Note: these events can be processed sequentially or in parallel, depending on whether the UE supports CA
-  void enqueue_ue_event(const char* event_name, uint16_t rnti, srsran::move_callback<void(ue&, logger&)> callback)
+  void enqueue_ue_event(const char* event_name, uint16_t rnti, ue_callback_t callback)
   {
     srsran_assert(rnti != SRSRAN_INVALID_RNTI, "Invalid rnti=0x%x passed to common event manager", rnti);
     std::lock_guard<std::mutex> lock(event_mutex);
@@ -101,10 +116,7 @@ public:
   }
 
   /// Enqueue feedback directed at a given UE in a given cell (e.g. ACKs, CQI)
-  void enqueue_ue_cc_feedback(const char*                                       event_name,
-                              uint16_t                                          rnti,
-                              uint32_t                                          cc,
-                              srsran::move_callback<void(ue_carrier&, logger&)> callback)
+  void enqueue_ue_cc_feedback(const char* event_name, uint16_t rnti, uint32_t cc, ue_cc_callback_t callback)
   {
     srsran_assert(rnti != SRSRAN_INVALID_RNTI, "Invalid rnti=0x%x passed to event manager", rnti);
     srsran_assert(cc < carriers.size(), "Invalid cc=%d passed to event manager", cc);
@@ -191,36 +203,36 @@ private:
     }
   };
   struct ue_event_t {
-    uint16_t                                  rnti;
-    const char*                               event_name;
-    srsran::move_callback<void(ue&, logger&)> callback;
-    ue_event_t(uint16_t rnti_, const char* event_name_, srsran::move_callback<void(ue&, logger&)> c) :
+    uint16_t      rnti;
+    const char*   event_name;
+    ue_callback_t callback;
+    ue_event_t(uint16_t rnti_, const char* event_name_, ue_callback_t c) :
       rnti(rnti_), event_name(event_name_), callback(std::move(c))
     {
     }
   };
   struct ue_cc_event_t {
-    uint16_t                                          rnti;
-    uint32_t                                          cc;
-    const char*                                       event_name;
-    srsran::move_callback<void(ue_carrier&, logger&)> callback;
-    ue_cc_event_t(uint16_t                                          rnti_,
-                  uint32_t                                          cc_,
-                  const char*                                       event_name_,
-                  srsran::move_callback<void(ue_carrier&, logger&)> c) :
+    uint16_t         rnti;
+    uint32_t         cc;
+    const char*      event_name;
+    ue_cc_callback_t callback;
+    ue_cc_event_t(uint16_t rnti_, uint32_t cc_, const char* event_name_, ue_cc_callback_t c) :
       rnti(rnti_), cc(cc_), event_name(event_name_), callback(std::move(c))
     {
     }
   };
 
+  /// Number of UE events per slot the queues are preallocated for
+  static const size_t nof_prealloc_events = 8 * SRSENB_MAX_UES;
+
   srslog::basic_logger& sched_logger;
 
-  std::mutex             event_mutex;
-  std::deque<event_t>    next_slot_events, current_slot_events;
-  std::deque<ue_event_t> next_slot_ue_events, current_slot_ue_events;
+  std::mutex              event_mutex;
+  std::vector<event_t>    next_slot_events, current_slot_events;
+  std::vector<ue_event_t> next_slot_ue_events, current_slot_ue_events;
   struct cc_events {
-    std::mutex                   event_cc_mutex;
-    srsran::deque<ue_cc_event_t> next_slot_ue_events, current_slot_ue_events;
+    std::mutex                 event_cc_mutex;
+    std::vector<ue_cc_event_t> next_slot_ue_events, current_slot_ue_events;
   };
   std::vector<cc_events> carriers;
 };
@@ -48,7 +48,6 @@ int ue_buffer_manager::get_dl_tx_total() const
 bool ue_buffer_manager::pdu_builder::alloc_subpdus(uint32_t rem_bytes, sched_nr_interface::dl_pdu_t& pdu)
 {
   // First step: allocate MAC CEs until resources allow
-  srsran::deque<ce_t> restore_ces;
   for (ce_t ce : parent->pending_ces) {
     if (ce.cc == cc) {
       // Note: This check also avoids thread collisions across UE carriers
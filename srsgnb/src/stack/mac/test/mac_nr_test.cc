@@ -0,0 +1,180 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_nr_alloc_counter.h"
+#include "sched_nr_cfg_generators.h"
+#include "srsgnb/hdr/stack/common/test/dummy_nr_classes.h"
+#include "srsgnb/hdr/stack/mac/mac_nr.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+
+namespace srsenb {
+
+/// RLC that always has data to transmit and counts the received SDU bytes
+class rlc_mac_nr_tester : public rlc_interface_mac
+{
+public:
+  int read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) override
+  {
+    uint32_t len = std::min(nof_bytes, sdu_len);
+    std::fill(payload, payload + len, (uint8_t)lcid);
+    return (int)len;
+  }
+  void write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) override
+  {
+    rx_bytes += nof_bytes;
+  }
+
+  const uint32_t sdu_len  = 100;
+  uint64_t       rx_bytes = 0;
+};
+
+/// Writes the UL MAC PDU of the UE, a Long BSR followed by an SDU on the DRB
+void fill_ul_pdu(srsran::byte_buffer_t& pdu, uint32_t lcid, uint32_t sdu_len)
+{
+  pdu.clear();
+  uint8_t* ptr = pdu.msg;
+  *ptr++       = srsran::mac_sch_subpdu_nr::LONG_BSR;
+  *ptr++       = 2;    // L: bitmap and one buffer size
+  *ptr++       = 0x01; // LCG0
+  *ptr++       = 200;  // Buffer size index
+  *ptr++       = lcid;
+  *ptr++       = (uint8_t)sdu_len;
+  std::fill(ptr, ptr + sdu_len, 0xab);
+  pdu.N_bytes = 6 + sdu_len;
+}
+
+/**
+ * Runs the slot path of the gNB MAC for one UE with DL and UL data, as called by the PHY and the stack thread:
+ * get_dl_sched(), get_ul_sched(), pucch_info(), pusch_info() and the UL PDU demux. After a warm-up the MAC must not
+ * allocate from the heap any more.
+ */
+void test_mac_nr_slot_path_no_allocs()
+{
+  uint32_t nof_warmup_slots = 1000, nof_slots = 3000, drb_lcid = 4;
+
+  srsran::task_scheduler task_sched;
+  rrc_nr_dummy           rrc;
+  rlc_mac_nr_tester      rlc;
+  mac_nr                 mac(&task_sched);
+
+  mac_nr_args_t args{};
+  TESTASSERT(mac.init(args, nullptr, nullptr, &rlc, &rrc) == SRSRAN_SUCCESS);
+  TESTASSERT(mac.cell_cfg(get_default_cells_cfg(1)) == SRSRAN_SUCCESS);
+
+  sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(1);
+  uecfg.lc_ch_to_add.emplace_back();
+  uecfg.lc_ch_to_add.back().lcid          = drb_lcid;
+  uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+  uecfg.lc_ch_to_add.back().cfg.group     = 0;
+  uint16_t rnti                           = mac.reserve_rnti(0, uecfg);
+  TESTASSERT(rnti != SRSRAN_INVALID_RNTI);
+  mac.ul_bsr(rnti, 0, 100000);
+
+  uint64_t nof_allocs_warmup = 0, rx_bytes_warmup = 0;
+  uint32_t nof_pdsch = 0, nof_pusch = 0;
+  for (uint32_t n = 0; n < nof_slots; ++n) {
+    srsran_slot_cfg_t slot_cfg = {};
+    slot_cfg.idx               = n % 10240;
+
+    if (n == nof_warmup_slots) {
+      nof_allocs_warmup = get_sched_nr_nof_allocs();
+      rx_bytes_warmup   = rlc.rx_bytes;
+      nof_pdsch = nof_pusch = 0;
+    }
+
+    // UL PDU decoded by the PHY, taken from the byte buffer pool outside of the counted scope
+    srsran::unique_byte_buffer_t ul_pdu = srsran::make_byte_buffer();
+    TESTASSERT(ul_pdu != nullptr);
+    fill_ul_pdu(*ul_pdu, drb_lcid, rlc.sdu_len);
+
+    sched_nr_alloc_scope alloc_scope;
+
+    // RLC keeps the DL buffer full
+    mac.rlc_buffer_state(rnti, drb_lcid, 100000, 0);
+
+    // PHY DL and UL slot processing, every DL transmission is ACKed and every PUSCH passes the CRC
+    mac_nr::dl_sched_t* dl_res = mac.get_dl_sched(slot_cfg);
+    TESTASSERT(dl_res != nullptr);
+    for (const mac_interface_phy_nr::pdcch_dl_t& pdcch : dl_res->pdcch_dl) {
+      if (pdcch.dci.ctx.rnti != rnti) {
+        continue;
+      }
+      mac_interface_phy_nr::pucch_info_t pucch_info = {};
+      pucch_info.uci_data.cfg.pucch.rnti            = rnti;
+      pucch_info.uci_data.cfg.ack.count             = 1;
+      pucch_info.uci_data.cfg.ack.bits[0].pid       = pdcch.dci.pid;
+      pucch_info.uci_data.value.valid               = true;
+      pucch_info.uci_data.value.ack[0]              = 1;
+      TESTASSERT(mac.pucch_info(slot_cfg, pucch_info) == SRSRAN_SUCCESS);
+      nof_pdsch++;
+    }
+
+    mac_nr::ul_sched_t* ul_res = mac.get_ul_sched(slot_cfg);
+    TESTASSERT(ul_res != nullptr);
+    for (const mac_interface_phy_nr::pusch_t& pusch : ul_res->pusch) {
+      if (pusch.sch.grant.rnti != rnti or ul_pdu == nullptr) {
+        continue;
+      }
+      mac_interface_phy_nr::pusch_info_t pusch_info = {};
+      pusch_info.rnti                               = rnti;
+      pusch_info.pid                                = pusch.pid;
+      pusch_info.pusch_data.tb[0].crc               = true;
+      pusch_info.pdu                                = std::move(ul_pdu);
+      TESTASSERT(mac.pusch_info(slot_cfg, pusch_info) == SRSRAN_SUCCESS);
+      nof_pusch++;
+    }
+
+    // Stack thread demuxes the UL PDUs
+    task_sched.run_pending_tasks();
+  }
+
+  fmt::print("MAC NR heap allocations: {} in warm-up, {} in steady state ({} PDSCH, {} PUSCH)\n",
+             nof_allocs_warmup,
+             get_sched_nr_nof_allocs() - nof_allocs_warmup,
+             nof_pdsch,
+             nof_pusch);
+
+  // The UE kept being served in DL and UL during the steady state, and its UL SDUs reached the RLC
+  TESTASSERT(nof_pdsch > 0);
+  TESTASSERT(nof_pusch > 0);
+  TESTASSERT(rlc.rx_bytes > rx_bytes_warmup);
+  // TEST: the MAC slot path did not allocate after the warm-up
+  TESTASSERT_EQ(nof_allocs_warmup, get_sched_nr_nof_allocs());
+
+  mac.stop();
+}
+
+} // namespace srsenb
+
+int main()
+{
+  auto& mac_logger = srslog::fetch_basic_logger("MAC");
+  mac_logger.set_level(srslog::basic_levels::warning);
+  auto& mac_nr_logger = srslog::fetch_basic_logger("MAC-NR");
+  mac_nr_logger.set_level(srslog::basic_levels::warning);
+
+  srslog::init();
+
+  srsenb::test_mac_nr_slot_path_no_allocs();
+
+  return SRSRAN_SUCCESS;
+}
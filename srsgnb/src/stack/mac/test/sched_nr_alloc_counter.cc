@@ -0,0 +1,99 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_nr_alloc_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace srsenb {
+
+static thread_local bool     counting_allocs = false;
+static std::atomic<uint64_t> nof_allocs{0};
+
+sched_nr_alloc_scope::sched_nr_alloc_scope() : prev_counting(counting_allocs)
+{
+  counting_allocs = true;
+}
+
+sched_nr_alloc_scope::~sched_nr_alloc_scope()
+{
+  counting_allocs = prev_counting;
+}
+
+uint64_t get_sched_nr_nof_allocs()
+{
+  return nof_allocs.load(std::memory_order_relaxed);
+}
+
+static void* counted_malloc(size_t sz)
+{
+  if (counting_allocs) {
+    nof_allocs.fetch_add(1, std::memory_order_relaxed);
+  }
+  return malloc(sz == 0 ? 1 : sz);
+}
+
+} // namespace srsenb
+
+void* operator new(size_t sz)
+{
+  void* ptr = srsenb::counted_malloc(sz);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new[](size_t sz)
+{
+  return operator new(sz);
+}
+
+void* operator new(size_t sz, const std::nothrow_t&) noexcept
+{
+  return srsenb::counted_malloc(sz);
+}
+
+void* operator new[](size_t sz, const std::nothrow_t&) noexcept
+{
+  return srsenb::counted_malloc(sz);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+  free(ptr);
+}
@@ -0,0 +1,51 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_NR_ALLOC_COUNTER_H
+#define SRSRAN_SCHED_NR_ALLOC_COUNTER_H
+
+#include <cstdint>
+
+namespace srsenb {
+
+/**
+ * Counts the heap allocations made by the calling thread while an object of this class is alive.
+ * The test bench opens a scope around each call to the scheduler or to the MAC, so that the allocations of the bench
+ * itself are not counted. Linking this file replaces the global operator new of the test binary.
+ */
+class sched_nr_alloc_scope
+{
+public:
+  sched_nr_alloc_scope();
+  sched_nr_alloc_scope(const sched_nr_alloc_scope&) = delete;
+  sched_nr_alloc_scope& operator=(const sched_nr_alloc_scope&) = delete;
+  ~sched_nr_alloc_scope();
+
+private:
+  bool prev_counting;
+};
+
+/// Number of heap allocations counted so far, in all threads
+uint64_t get_sched_nr_nof_allocs();
+
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_NR_ALLOC_COUNTER_H
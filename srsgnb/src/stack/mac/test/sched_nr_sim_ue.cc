@@ -20,6 +20,7 @@
  */
 
 #include "sched_nr_sim_ue.h"
+#include "sched_nr_alloc_counter.h"
 #include "sched_nr_common_test.h"
 #include "sched_nr_ue_ded_test_suite.h"
 #include "srsran/common/test_common.h"
@@ -298,7 +299,10 @@ void sched_nr_base_test_bench::run_slot(slot_point slot_tx)
   slot_ctxt     = get_enb_ctxt();
   slot_start_tp = std::chrono::steady_clock::now();
 
-  sched_ptr->slot_indication(current_slot_tx);
+  {
+    sched_nr_alloc_scope alloc_scope;
+    sched_ptr->slot_indication(current_slot_tx);
+  }
 
   // Generate CC result (parallel or serialized)
   uint32_t worker_idx = 0;
@@ -315,10 +319,13 @@ void sched_nr_base_test_bench::run_slot(slot_point slot_tx)
 void sched_nr_base_test_bench::generate_cc_result(uint32_t cc)
 {
   // Run scheduler
-  cc_results[cc].res.slot      = current_slot_tx;
-  cc_results[cc].res.cc        = cc;
-  cc_results[cc].res.dl        = sched_ptr->get_dl_sched(current_slot_tx, cc);
-  cc_results[cc].res.ul        = sched_ptr->get_ul_sched(current_slot_tx, cc);
+  cc_results[cc].res.slot = current_slot_tx;
+  cc_results[cc].res.cc   = cc;
+  {
+    sched_nr_alloc_scope alloc_scope;
+    cc_results[cc].res.dl = sched_ptr->get_dl_sched(current_slot_tx, cc);
+    cc_results[cc].res.ul = sched_ptr->get_ul_sched(current_slot_tx, cc);
+  }
   auto tp2                     = std::chrono::steady_clock::now();
   cc_results[cc].cc_latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - slot_start_tp);
 
@@ -414,7 +421,10 @@ void sched_nr_base_test_bench::update_sched_buffer_state(uint16_t rnti)
       }
     }
     if (newtx != (int)lch.second.rlc_newtx) {
-      sched_ptr->dl_buffer_state(rnti, lch.first, newtx, 0);
+      {
+        sched_nr_alloc_scope alloc_scope;
+        sched_ptr->dl_buffer_state(rnti, lch.first, newtx, 0);
+      }
       lch.second.rlc_newtx = newtx;
       logger.debug("STATUS: rnti=0x%x, lcid=%d DL buffer state is (unacked=%d, newtx=%d)",
                    rnti,
@@ -496,7 +506,10 @@ int sched_nr_base_test_bench::apply_slot_events(sim_nr_ue_ctxt_t& ue_ctxt, const
       }
 
       // update scheduler
-      sched_ptr->dl_ack_info(ue_ctxt.rnti, enb_cc_idx, h.pid, 0, ack.ack);
+      {
+        sched_nr_alloc_scope alloc_scope;
+        sched_ptr->dl_ack_info(ue_ctxt.rnti, enb_cc_idx, h.pid, 0, ack.ack);
+      }
 
       // update UE sim context
       if (ack.ack or ue_ctxt.is_last_dl_retx(enb_cc_idx, h.pid)) {
@@ -516,7 +529,10 @@ int sched_nr_base_test_bench::apply_slot_events(sim_nr_ue_ctxt_t& ue_ctxt, const
       }
 
       // update scheduler
-      sched_ptr->ul_crc_info(ue_ctxt.rnti, enb_cc_idx, ack.pid, ack.ack);
+      {
+        sched_nr_alloc_scope alloc_scope;
+        sched_ptr->ul_crc_info(ue_ctxt.rnti, enb_cc_idx, ack.pid, ack.ack);
+      }
 
       if (h.is_msg3) {
         logger.info("STATUS: rnti=0x%x received Msg3", ue_ctxt.rnti);
@@ -526,6 +542,7 @@ int sched_nr_base_test_bench::apply_slot_events(sim_nr_ue_ctxt_t& ue_ctxt, const
 
     if (cc_feedback.cqi >= 0) {
       logger.info("EVENT: DL CQI rnti=0x%x, cqi=%d", ue_ctxt.rnti, cc_feedback.cqi);
+      sched_nr_alloc_scope alloc_scope;
       sched_ptr->dl_cqi_info(ue_ctxt.rnti, enb_cc_idx, cc_feedback.cqi);
     }
   }
@@ -19,6 +19,7 @@
  *
  */
 
+#include "sched_nr_alloc_counter.h"
 #include "sched_nr_cfg_generators.h"
 #include "sched_nr_sim_ue.h"
 #include "srsran/common/phy_cfg_nr_default.h"
@@ -235,6 +236,66 @@ void test_sched_nr_data(sim_args_t args)
   TESTASSERT_EQ(1, tester.ue_metrics[rnti].nof_ul_txs);
 }
 
+void test_sched_nr_steady_state_no_allocs(sim_args_t args)
+{
+  uint32_t nof_warmup_slots = 1000, max_nof_ttis = 3000, nof_sectors = 1, nof_ues = 4;
+
+  sched_nr_interface::sched_args_t cfg;
+  cfg.auto_refill_buffer                     = true;
+  std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(nof_sectors);
+
+  std::string  test_name = "Test steady state without allocations";
+  sched_tester tester(args, cfg, cells_cfg, test_name);
+
+  /* Set events */
+  std::deque<sched_event_t>    events;
+  sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(1);
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    uint16_t rnti = 0x4601 + i;
+    events.push_back(add_user(9 + 20 * i, rnti, i));
+    events.push_back(ue_cfg(20 + 20 * i, rnti, uecfg));
+  }
+
+  /* Run Test */
+  uint64_t                                           nof_allocs_warmup = 0;
+  std::map<uint16_t, sched_tester::sched_ue_metrics> metrics_warmup;
+  for (uint32_t nof_slots = 0; nof_slots < max_nof_ttis; ++nof_slots) {
+    slot_point slot_rx(0, nof_slots % 10240);
+    slot_point slot_tx = slot_rx + TX_ENB_DELAY;
+
+    // run events
+    while (not events.empty() and events.front().slot_count <= nof_slots) {
+      events.front().run(tester);
+      events.pop_front();
+    }
+
+    // The UEs are connected and the scheduler reached its steady state at the end of the warm-up
+    if (nof_slots == nof_warmup_slots) {
+      tester.get_slot_results();
+      nof_allocs_warmup = get_sched_nr_nof_allocs();
+      metrics_warmup    = tester.ue_metrics;
+    }
+
+    // call sched
+    tester.run_slot(slot_tx);
+  }
+  tester.get_slot_results();
+
+  tester.print_results();
+  fmt::print("Scheduler heap allocations: {} in warm-up, {} in steady state\n",
+             nof_allocs_warmup,
+             get_sched_nr_nof_allocs() - nof_allocs_warmup);
+
+  // The UEs kept being scheduled in DL and UL during the steady state
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    uint16_t rnti = 0x4601 + i;
+    TESTASSERT(tester.ue_metrics[rnti].nof_dl_txs > metrics_warmup[rnti].nof_dl_txs);
+    TESTASSERT(tester.ue_metrics[rnti].nof_ul_txs > metrics_warmup[rnti].nof_ul_txs);
+  }
+  // TEST: the scheduler slot loop did not allocate after the warm-up
+  TESTASSERT_EQ(nof_allocs_warmup, get_sched_nr_nof_allocs());
+}
+
 sim_args_t handle_args(int argc, char** argv)
 {
   sim_args_t args;
@@ -329,6 +390,7 @@ int main(int argc, char** argv)
 
   srsenb::test_sched_nr_no_data(args);
   srsenb::test_sched_nr_data(args);
+  srsenb::test_sched_nr_steady_state_no_allocs(args);
 
   fmt::print("TEST: Random Seed was {}", args.rand_seed);
 }
@@ -180,6 +180,7 @@ void ue_nr::metrics_read(mac_ue_metrics_t* metrics_)
   dl_cqi_valid_counter = 0;
   pucch_sinr_counter   = 0;
   pusch_sinr_counter   = 0;
+  pusch_fec_counter    = 0;
   ue_metrics           = {};
 }
 
@@ -263,6 +264,23 @@ void ue_nr::metrics_pusch_sinr(float sinr)
   }
 }
 
+void ue_nr::metrics_pusch_fec(const srsran_sch_tb_res_nr_t& tb)
+{
+  std::lock_guard<std::mutex> lock(metrics_mutex);
+  uint32_t                    nof_cb = 0;
+  for (uint32_t i = 0; i < SRSRAN_SCH_NR_ITER_HIST_SIZE; i++) {
+    ue_metrics.fec_iters_hist[i] += tb.iter_hist[i];
+    nof_cb += tb.iter_hist[i];
+  }
+  ue_metrics.fec_cb_aborted += tb.nof_cb_aborted;
+
+  // Skip the transport blocks whose code blocks were all decoded in previous retransmissions
+  if (nof_cb > 0 && !std::isnan(tb.avg_iter)) {
+    ue_metrics.fec_iters = SRSRAN_VEC_SAFE_CMA(tb.avg_iter, ue_metrics.fec_iters, pusch_fec_counter);
+    pusch_fec_counter++;
+  }
+}
+
 // Called from Stack thread when demuxing UL PDUs
 void ue_nr::store_msg3(srsran::unique_byte_buffer_t pdu)
 {
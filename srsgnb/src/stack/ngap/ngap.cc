@@ -581,7 +581,12 @@ bool ngap::handle_ue_context_release_cmd(const asn1::ngap::ue_context_release_cm
     return false;
   }
 
-  return u->handle_ue_context_release_cmd(msg);
+  if (not u->handle_ue_context_release_cmd(msg)) {
+    return false;
+  }
+  // The UE Context Release Complete has been sent, so the UE context can go
+  users.erase(u);
+  return true;
 }
 
 bool ngap::handle_ue_pdu_session_res_setup_request(const asn1::ngap::pdu_session_res_setup_request_s& msg)
@@ -829,18 +834,14 @@ ngap::ue* ngap::handle_ngapmsg_ue_id(uint32_t gnb_id, uint64_t amf_id)
       return user_ptr;
     }
 
+    // TS 38.413, Sec. 10.6 - The AMF UE NGAP ID does not match the one of the UE
     logger.warning("AMF UE NGAP ID=%d not found - discarding message", amf_id);
-    if (user_amf_ptr != nullptr) {
-      cause.set_radio_network().value = cause_radio_network_opts::unknown_target_id;
-    }
-
+    cause.set_radio_network().value = cause_radio_network_opts::inconsistent_remote_ue_ngap_id;
   } else {
+    // TS 38.413, Sec. 10.6 - The RAN UE NGAP ID is unknown, e.g. the UE context was already released
     logger.warning("User associated with gNB ID %d not found", gnb_id);
-    user_amf_ptr = users.find_ue_amfid(amf_id);
     logger.warning("RAN UE NGAP ID=%d not found - discarding message", gnb_id);
-    if (user_amf_ptr != nullptr) {
-      cause.set_radio_network().value = cause_radio_network_opts::unknown_local_ue_ngap_id;
-    }
+    cause.set_radio_network().value = cause_radio_network_opts::unknown_local_ue_ngap_id;
   }
 
   send_error_indication(cause, gnb_id, amf_id);
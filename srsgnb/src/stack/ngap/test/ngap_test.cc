@@ -22,6 +22,7 @@
 #include "srsgnb/hdr/stack/ngap/ngap.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/common/test_common.h"
+#include <poll.h>
 
 using namespace srsenb;
 
@@ -64,6 +65,15 @@ struct amf_dummy {
     return pdu;
   }
 
+  /// Checks whether the gNB sent a message to the AMF within the given timeout
+  bool has_msg(int timeout_ms)
+  {
+    struct pollfd pfd = {};
+    pfd.fd            = fd;
+    pfd.events        = POLLIN;
+    return poll(&pfd, 1, timeout_ms) > 0;
+  }
+
   const char*                  addr_str;
   int                          port;
   struct sockaddr_in           amf_sockaddr = {};
@@ -285,6 +295,71 @@ void run_ng_initial_ue(ngap& ngap_obj, amf_dummy& amf, rrc_nr_dummy& rrc)
   TESTASSERT(rrc.sec_mod_proc_started);
 }
 
+void run_ng_ue_context_release(ngap& ngap_obj, amf_dummy& amf)
+{
+  sockaddr_in     amf_addr = {};
+  sctp_sndrcvinfo rcvinfo  = {};
+  int             flags    = 0;
+
+  // AMF -> gNB: UE Context Release Command for the UE of run_ng_initial_ue()
+  asn1::ngap::ngap_pdu_c ngap_release_cmd_pdu;
+  ngap_release_cmd_pdu.set_init_msg().load_info_obj(ASN1_NGAP_ID_UE_CONTEXT_RELEASE);
+  auto& container                = ngap_release_cmd_pdu.init_msg().value.ue_context_release_cmd();
+  auto& ue_ngap_id_pair          = container->ue_ngap_ids.value.set_ue_ngap_id_pair();
+  ue_ngap_id_pair.amf_ue_ngap_id = 0x1;
+  ue_ngap_id_pair.ran_ue_ngap_id = 0x1;
+
+  container->cause.value.set_nas().value = asn1::ngap::cause_nas_opts::normal_release;
+
+  srsran::unique_byte_buffer_t release_cmd = srsran::make_byte_buffer();
+  TESTASSERT_NEQ(release_cmd, nullptr);
+  asn1::bit_ref bref(release_cmd->msg, release_cmd->get_tailroom());
+  TESTASSERT_EQ(ngap_release_cmd_pdu.pack(bref), asn1::SRSASN_SUCCESS);
+  release_cmd->N_bytes = bref.distance_bytes();
+
+  // Keep a copy to send the command a second time
+  srsran::unique_byte_buffer_t release_cmd_copy = srsran::make_byte_buffer();
+  TESTASSERT_NEQ(release_cmd_copy, nullptr);
+  *release_cmd_copy = *release_cmd;
+
+  TESTASSERT(ngap_obj.handle_amf_rx_msg(std::move(release_cmd), amf_addr, rcvinfo, flags));
+
+  // gNB -> AMF: UE Context Release Complete
+  asn1::ngap::ngap_pdu_c       ngap_release_complete_pdu;
+  srsran::unique_byte_buffer_t sdu = amf.read_msg();
+  TESTASSERT(sdu->N_bytes > 0);
+  asn1::cbit_ref cbref(sdu->msg, sdu->N_bytes);
+  TESTASSERT_EQ(ngap_release_complete_pdu.unpack(cbref), asn1::SRSASN_SUCCESS);
+  TESTASSERT_EQ(ngap_release_complete_pdu.type().value, asn1::ngap::ngap_pdu_c::types_opts::successful_outcome);
+  TESTASSERT_EQ(ngap_release_complete_pdu.successful_outcome().proc_code, ASN1_NGAP_ID_UE_CONTEXT_RELEASE);
+  auto& complete = ngap_release_complete_pdu.successful_outcome().value.ue_context_release_complete();
+  TESTASSERT_EQ(complete->amf_ue_ngap_id.value, 0x1);
+  TESTASSERT_EQ(complete->ran_ue_ngap_id.value, 0x1);
+
+  // The UE context is gone, a release request from the RRC finds no UE and sends nothing to the AMF
+  ngap_obj.user_release_request(0xf0f0, asn1::ngap::cause_radio_network_opts::user_inactivity);
+  TESTASSERT(not amf.has_msg(100));
+
+  // A second UE Context Release Command for the same UE is rejected with an Error Indication instead of a UE Context
+  // Release Complete
+  TESTASSERT(ngap_obj.handle_amf_rx_msg(std::move(release_cmd_copy), amf_addr, rcvinfo, flags));
+  asn1::ngap::ngap_pdu_c ngap_error_ind_pdu;
+  sdu = amf.read_msg();
+  TESTASSERT(sdu->N_bytes > 0);
+  asn1::cbit_ref cbref2(sdu->msg, sdu->N_bytes);
+  TESTASSERT_EQ(ngap_error_ind_pdu.unpack(cbref2), asn1::SRSASN_SUCCESS);
+  TESTASSERT_EQ(ngap_error_ind_pdu.type().value, asn1::ngap::ngap_pdu_c::types_opts::init_msg);
+  TESTASSERT_EQ(ngap_error_ind_pdu.init_msg().proc_code, ASN1_NGAP_ID_ERROR_IND);
+  auto& error_ind = ngap_error_ind_pdu.init_msg().value.error_ind();
+  TESTASSERT(error_ind->ran_ue_ngap_id_present);
+  TESTASSERT_EQ(error_ind->ran_ue_ngap_id.value, 0x1);
+  TESTASSERT(error_ind->cause_present);
+  TESTASSERT_EQ(error_ind->cause.value.type().value, asn1::ngap::cause_c::types_opts::radio_network);
+  TESTASSERT_EQ(error_ind->cause.value.radio_network().value,
+                asn1::ngap::cause_radio_network_opts::unknown_local_ue_ngap_id);
+  TESTASSERT(not amf.has_msg(100));
+}
+
 int main(int argc, char** argv)
 {
   // Setup logging.
@@ -319,4 +394,5 @@ int main(int argc, char** argv)
   srsran::test_init(argc, argv);
   run_ng_setup(ngap_obj, amf);
   run_ng_initial_ue(ngap_obj, amf, rrc);
+  run_ng_ue_context_release(ngap_obj, amf);
 }
@@ -22,6 +22,7 @@
 #include "srsgnb/hdr/stack/ric/e2_agent.h"
 #include "srsran/asn1/e2ap.h"
 #include "srsran/common/standard_streams.h"
+#include <sys/socket.h>
 
 using namespace srsenb;
 
@@ -135,6 +136,7 @@ e2_agent::e2_agent(srslog::basic_logger& logger, e2_interface_metrics* _gnb_metr
 bool e2_agent::init(e2_agent_args_t args)
 {
   _args = args;
+  e2ap_.set_cell_ids(_args.cell_ids);
 
   // Setup RIC reconnection timer
   ric_connect_timer    = task_sched.get_unique_timer();
@@ -265,6 +267,50 @@ bool e2_agent::send_sctp(srsran::unique_byte_buffer_t& buf)
   return true;
 }
 
+bool e2_agent::send_sctp_batch(std::vector<srsran::unique_byte_buffer_t>& msgs)
+{
+  // one E2AP PDU per SCTP message, as with sctp_sendmsg(), but up to max_batch_size messages per system call
+  static const uint32_t max_batch_size = 64;
+  struct mmsghdr        hdrs[max_batch_size];
+  struct iovec          iovs[max_batch_size];
+  uint8_t               cmsg_bufs[max_batch_size][CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))];
+
+  uint32_t offset = 0;
+  while (offset < msgs.size()) {
+    uint32_t nof_msgs = std::min(max_batch_size, (uint32_t)msgs.size() - offset);
+    for (uint32_t i = 0; i < nof_msgs; i++) {
+      srsran::byte_buffer_t* buf = msgs[offset + i].get();
+      iovs[i].iov_base           = buf->msg;
+      iovs[i].iov_len            = buf->N_bytes;
+
+      memset(&hdrs[i], 0, sizeof(hdrs[i]));
+      memset(cmsg_bufs[i], 0, sizeof(cmsg_bufs[i]));
+      hdrs[i].msg_hdr.msg_name       = &ric_addr;
+      hdrs[i].msg_hdr.msg_namelen    = sizeof(ric_addr);
+      hdrs[i].msg_hdr.msg_iov        = &iovs[i];
+      hdrs[i].msg_hdr.msg_iovlen     = 1;
+      hdrs[i].msg_hdr.msg_control    = cmsg_bufs[i];
+      hdrs[i].msg_hdr.msg_controllen = sizeof(cmsg_bufs[i]);
+
+      struct cmsghdr* cmsg = CMSG_FIRSTHDR(&hdrs[i].msg_hdr);
+      cmsg->cmsg_level     = IPPROTO_SCTP;
+      cmsg->cmsg_type      = SCTP_SNDRCV;
+      cmsg->cmsg_len       = CMSG_LEN(sizeof(struct sctp_sndrcvinfo));
+      struct sctp_sndrcvinfo* sinfo = (struct sctp_sndrcvinfo*)CMSG_DATA(cmsg);
+      sinfo->sinfo_ppid             = htonl(e2ap_ppid);
+    }
+
+    int ret = sendmmsg(ric_socket.fd(), hdrs, nof_msgs, 0);
+    if (ret <= 0) {
+      logger.error("Failed to send %d E2AP messages to RIC: %s", nof_msgs, strerror(errno));
+      return false;
+    }
+    offset += ret;
+  }
+  logger.debug("Sent %zd E2AP messages to RIC", msgs.size());
+  return true;
+}
+
 bool e2_agent::send_e2_msg(e2_msg_type_t msg_type)
 {
   std::string message_name;
@@ -303,6 +349,18 @@ bool e2_agent::queue_send_e2ap_pdu(e2_ap_pdu_c e2ap_pdu)
   return true;
 }
 
+bool e2_agent::queue_send_e2ap_msgs(std::vector<srsran::unique_byte_buffer_t> msgs)
+{
+  if (not ric_connected) {
+    logger.error("Aborting sending msgs. Cause: RIC is not connected.");
+    return false;
+  }
+
+  auto send_e2ap_msgs_task = [this, msgs = std::move(msgs)]() mutable { send_sctp_batch(msgs); };
+  ric_rece_task_queue.push(std::move(send_e2ap_msgs_task));
+  return true;
+}
+
 bool e2_agent::send_e2ap_pdu(e2_ap_pdu_c send_pdu)
 {
   srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
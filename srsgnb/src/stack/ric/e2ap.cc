@@ -64,6 +64,14 @@ bool e2ap::queue_send_e2ap_pdu(e2_ap_pdu_c e2ap_pdu)
   return true;
 }
 
+bool e2ap::queue_send_e2ap_msgs(std::vector<srsran::unique_byte_buffer_t> msgs)
+{
+  if (_e2_agent) {
+    _e2_agent->queue_send_e2ap_msgs(std::move(msgs));
+  }
+  return true;
+}
+
 e2_ap_pdu_c e2ap::generate_setup_request()
 {
   e2_ap_pdu_c pdu;
@@ -369,6 +377,138 @@ e2_ap_pdu_c e2ap::generate_indication(ric_indication_t& ric_indication)
   return pdu;
 }
 
+// packs an IE and the padding to the next octet, IEs are always octet-aligned
+template <class IE>
+static bool pack_ie(const IE& ie, std::vector<uint8_t>& out)
+{
+  srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  if (buf == nullptr) {
+    return false;
+  }
+  asn1::bit_ref bref(buf->msg, buf->get_tailroom());
+  if (ie.pack(bref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  bref.align_bytes_zero();
+  out.assign(buf->msg, buf->msg + bref.distance_bytes());
+  return true;
+}
+
+// IE ID and criticality, the IE value follows as an open type
+static void pack_ie_id_crit(uint32_t id, asn1::crit_e crit, std::vector<uint8_t>& out)
+{
+  uint8_t       buf[4] = {};
+  asn1::bit_ref bref(buf, sizeof(buf));
+  asn1::pack_integer(bref, id, (uint32_t)0u, (uint32_t)65535u, false, true);
+  crit.pack(bref);
+  bref.align_bytes_zero();
+  out.assign(buf, buf + bref.distance_bytes());
+}
+
+// octets of an aligned length determinant below 16K
+static uint32_t length_det_size(uint32_t len)
+{
+  return len < 128 ? 1 : 2;
+}
+
+bool ric_indication_template::init(const e2_ap_pdu_c& pdu)
+{
+  using namespace asn1::e2ap;
+  pdu_prefix.clear();
+  if (pdu.type().value != e2_ap_pdu_c::types_opts::init_msg or
+      pdu.init_msg().value.type().value != e2_ap_elem_procs_o::init_msg_c::types_opts::ri_cind) {
+    return false;
+  }
+  const init_msg_s& initmsg    = pdu.init_msg();
+  const ri_cind_s&  indication = initmsg.value.ri_cind();
+  if (indication->ri_ccall_process_id_present) {
+    return false;
+  }
+
+  uint8_t       buf[8] = {};
+  asn1::bit_ref bref(buf, sizeof(buf));
+  bref.pack(indication.ext, 1);
+  asn1::pack_length(bref, indication->ri_cind_sn_present ? 7u : 6u, 0u, 65535u, true);
+  value_prefix.assign(buf, buf + bref.distance_bytes());
+
+  std::vector<uint8_t> ran_func_ie, action_ie;
+  if (not pack_ie(indication->ri_crequest_id, fixed_ies) or not pack_ie(indication->ra_nfunction_id, ran_func_ie) or
+      not pack_ie(indication->ri_caction_id, action_ie) or not pack_ie(indication->ri_cind_type, type_ie)) {
+    return false;
+  }
+  fixed_ies.insert(fixed_ies.end(), ran_func_ie.begin(), ran_func_ie.end());
+  fixed_ies.insert(fixed_ies.end(), action_ie.begin(), action_ie.end());
+
+  // the SN is the last two octets of its IE
+  sn_present = indication->ri_cind_sn_present;
+  sn_ie_prefix.clear();
+  if (sn_present) {
+    if (not pack_ie(indication->ri_cind_sn, sn_ie_prefix)) {
+      return false;
+    }
+    sn_ie_prefix.resize(sn_ie_prefix.size() - 2);
+  }
+  indication_type = indication->ri_cind_type.value;
+
+  pack_ie_id_crit(indication->ri_cind_hdr.id, indication->ri_cind_hdr.crit, hdr_ie_prefix);
+  pack_ie_id_crit(indication->ri_cind_msg.id, indication->ri_cind_msg.crit, msg_ie_prefix);
+
+  // the value of the initiating message is an open type, its length goes after this prefix
+  bref = asn1::bit_ref(buf, sizeof(buf));
+  pdu.type().pack(bref);
+  asn1::pack_integer(bref, initmsg.proc_code, (uint16_t)0u, (uint16_t)255u, false, true);
+  initmsg.crit.pack(bref);
+  bref.align_bytes_zero();
+  pdu_prefix.assign(buf, buf + bref.distance_bytes());
+  return true;
+}
+
+bool ric_indication_template::pack(const ric_indication_t& ric_indication, srsran::byte_buffer_t& buf) const
+{
+  if (not is_initialized() or ric_indication.ri_indication_sn_present != sn_present or
+      ric_indication.indication_type.value != indication_type.value or ric_indication.ri_cind_hdr == nullptr or
+      ric_indication.ri_cind_msg == nullptr) {
+    return false;
+  }
+
+  // header and message are octet strings inside an open type, so each has two length determinants
+  uint32_t hdr_len       = ric_indication.ri_cind_hdr->N_bytes;
+  uint32_t msg_len       = ric_indication.ri_cind_msg->N_bytes;
+  uint32_t hdr_value_len = length_det_size(hdr_len) + hdr_len;
+  uint32_t msg_value_len = length_det_size(msg_len) + msg_len;
+  uint32_t value_len     = value_prefix.size() + fixed_ies.size() + (sn_present ? sn_ie_prefix.size() + 2 : 0) +
+                       type_ie.size() + hdr_ie_prefix.size() + length_det_size(hdr_value_len) + hdr_value_len +
+                       msg_ie_prefix.size() + length_det_size(msg_value_len) + msg_value_len;
+  uint32_t pdu_len = pdu_prefix.size() + length_det_size(value_len) + value_len;
+  if (value_len >= ASN_16K or pdu_len >= buf.get_tailroom()) {
+    return false;
+  }
+
+  asn1::bit_ref bref(buf.msg, buf.get_tailroom());
+  bref.pack_bytes(pdu_prefix.data(), pdu_prefix.size());
+  asn1::pack_length(bref, value_len, true);
+  bref.pack_bytes(value_prefix.data(), value_prefix.size());
+  bref.pack_bytes(fixed_ies.data(), fixed_ies.size());
+  if (sn_present) {
+    bref.pack_bytes(sn_ie_prefix.data(), sn_ie_prefix.size());
+    bref.pack(ric_indication.ri_indication_sn, 16);
+  }
+  bref.pack_bytes(type_ie.data(), type_ie.size());
+
+  bref.pack_bytes(hdr_ie_prefix.data(), hdr_ie_prefix.size());
+  asn1::pack_length(bref, hdr_value_len, true);
+  asn1::pack_length(bref, hdr_len, true);
+  bref.pack_bytes(ric_indication.ri_cind_hdr->msg, hdr_len);
+
+  bref.pack_bytes(msg_ie_prefix.data(), msg_ie_prefix.size());
+  asn1::pack_length(bref, msg_value_len, true);
+  asn1::pack_length(bref, msg_len, true);
+  bref.pack_bytes(ric_indication.ri_cind_msg->msg, msg_len);
+
+  buf.N_bytes = bref.distance_bytes();
+  return true;
+}
+
 e2_ap_pdu_c e2ap::generate_reset_request()
 {
   using namespace asn1::e2ap;
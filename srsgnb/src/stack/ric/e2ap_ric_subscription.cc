@@ -47,7 +47,6 @@ e2ap::ric_subscription::ric_subscription(e2ap* e2ap, ricsubscription_request_s r
   if (sm_ptr->process_ric_event_trigger_definition(ric_subscription_request, event_trigger)) {
     if (event_trigger.type == RIC_event_trigger_definition_t::e2sm_event_trigger_type_t::E2SM_REPORT) {
       reporting_period = event_trigger.report_period;
-      reporting_period = 3000; // TODO: to remove, keep it 3s for testing
     }
   }
 
@@ -100,6 +99,20 @@ void e2ap::ric_subscription::start_subscription()
 {
   this->_send_subscription_response();
 
+  // the IEs that identify the action are the same in all its indications, pack them only once
+  indication_templates.resize(admitted_actions.size());
+  for (uint32_t i = 0; i < admitted_actions.size(); i++) {
+    ric_indication_t ric_indication;
+    _fill_ric_indication(admitted_actions[i], ric_indication);
+    ric_indication.indication_type = ri_cind_type_opts::report;
+    ric_indication.ri_cind_hdr     = srsran::make_byte_buffer();
+    ric_indication.ri_cind_msg     = srsran::make_byte_buffer();
+    if (ric_indication.ri_cind_hdr == nullptr or ric_indication.ri_cind_msg == nullptr or
+        not indication_templates[i].init(parent->generate_indication(ric_indication))) {
+      parent->logger.warning("Cannot pre-encode RIC indications of action %i", admitted_actions[i].ric_action_id);
+    }
+  }
+
   if (reporting_period) {
     printf("Start sending RIC indication msgs every %i ms\n", reporting_period);
     parent->logger.debug("Start sending RIC indication msgs every %i ms", reporting_period);
@@ -197,6 +210,16 @@ uint32_t e2ap::ric_subscription::_generate_ric_indication_sn()
   return sn;
 };
 
+void e2ap::ric_subscription::_fill_ric_indication(const E2AP_RIC_action_t& action, ric_indication_t& ric_indication)
+{
+  ric_indication.ric_requestor_id         = ric_requestor_id;
+  ric_indication.ric_instance_id          = ric_instance_id;
+  ric_indication.ra_nfunction_id          = ra_nfunction_id;
+  ric_indication.ri_caction_id            = action.ric_action_id;
+  ric_indication.ri_indication_sn_present = true;
+  ric_indication.ri_indication_sn         = 0;
+}
+
 void e2ap::ric_subscription::_send_ric_indication()
 {
   if (sm_ptr == nullptr) {
@@ -204,23 +227,43 @@ void e2ap::ric_subscription::_send_ric_indication()
     return;
   }
 
-  for (auto& action : admitted_actions) {
-    printf("Sending RIC indication msg to RIC Requestor ID: %i\n", ric_requestor_id);
+  // the indications of all actions are sent together
+  std::vector<srsran::unique_byte_buffer_t> ind_msgs;
+  ind_msgs.reserve(admitted_actions.size());
+  for (uint32_t i = 0; i < admitted_actions.size(); i++) {
+    E2AP_RIC_action_t& action = admitted_actions[i];
+    parent->logger.debug("Sending RIC indication msg to RIC Requestor ID: %i", ric_requestor_id);
     ric_indication_t ric_indication;
-    ric_indication.ric_requestor_id = ric_requestor_id;
-    ric_indication.ric_instance_id  = ric_instance_id;
-    ric_indication.ra_nfunction_id  = ra_nfunction_id;
-    ric_indication.ri_caction_id    = action.ric_action_id;
-    ric_indication.ri_indication_sn_present = true;
-    ric_indication.ri_indication_sn         = _generate_ric_indication_sn();
-    if (sm_ptr->generate_ric_indication_content(action, ric_indication)) {
-      e2_ap_pdu_c send_pdu = parent->generate_indication(ric_indication);
-      parent->queue_send_e2ap_pdu(send_pdu);
+    _fill_ric_indication(action, ric_indication);
+    ric_indication.ri_indication_sn = _generate_ric_indication_sn();
+    if (not sm_ptr->generate_ric_indication_content(action, ric_indication)) {
+      continue;
+    }
+
+    srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+    if (buf == nullptr) {
+      parent->logger.error("Couldn't allocate buffer for RIC indication of action %i", action.ric_action_id);
+      continue;
     }
+    if (i >= indication_templates.size() or not indication_templates[i].pack(ric_indication, *buf)) {
+      // pack the whole PDU into the same batch, so that the indications are sent in SN order
+      buf->clear();
+      e2_ap_pdu_c   send_pdu = parent->generate_indication(ric_indication);
+      asn1::bit_ref bref(buf->msg, buf->get_tailroom());
+      if (send_pdu.pack(bref) != asn1::SRSASN_SUCCESS) {
+        parent->logger.error("Failed to pack RIC indication of action %i", action.ric_action_id);
+        continue;
+      }
+      buf->N_bytes = bref.distance_bytes();
+    }
+    ind_msgs.push_back(std::move(buf));
+  }
+  if (not ind_msgs.empty()) {
+    parent->queue_send_e2ap_msgs(std::move(ind_msgs));
   }
 
   // reschedule sending RIC indication
   if (reporting_period) {
     reporting_timer.run();
   }
-}
\ No newline at end of file
+}
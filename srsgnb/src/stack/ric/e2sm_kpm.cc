@@ -20,9 +20,8 @@
  */
 
 #include "srsgnb/hdr/stack/ric/e2sm_kpm.h"
-#include "srsgnb/hdr/stack/ric/e2sm_kpm_metrics.h"
 #include "srsgnb/hdr/stack/ric/e2sm_kpm_report_service.h"
-#include <numeric>
+#include <algorithm>
 
 const std::string e2sm_kpm::short_name       = "ORAN-E2SM-KPM";
 const std::string e2sm_kpm::oid              = "1.3.6.1.4.1.53148.1.2.2.2";
@@ -32,35 +31,10 @@ const uint32_t    e2sm_kpm::revision         = 0;
 e2sm_kpm::e2sm_kpm(srslog::basic_logger& logger_, srsran::task_scheduler* _task_sched_ptr) :
   e2sm(short_name, oid, func_description, revision, _task_sched_ptr), logger(logger_)
 {
-  random_gen = srsran_random_init(1234);
-
-  // add supported metrics
-  for (auto& metric : get_e2sm_kpm_28_552_metrics()) {
-    if (metric.supported) {
-      supported_meas_types.push_back(metric);
-    }
-  }
-  for (auto& metric : get_e2sm_kpm_34_425_metrics()) {
-    if (metric.supported) {
-      supported_meas_types.push_back(metric);
-    }
-  }
-  for (auto& metric : e2sm_kpm_oran_metrics()) {
-    if (metric.supported) {
-      supported_meas_types.push_back(metric);
-    }
-  }
-  for (auto& metric : e2sm_kpm_custom_metrics()) {
-    if (metric.supported) {
-      supported_meas_types.push_back(metric);
-    }
-  }
 }
 
-e2sm_kpm::~e2sm_kpm()
-{
-  srsran_random_free(random_gen);
-}
+e2sm_kpm::~e2sm_kpm() {}
+
 bool e2sm_kpm::generate_ran_function_description(RANfunction_description& desc, ra_nfunction_item_s& ran_func)
 {
   desc.function_shortname = short_name;
@@ -238,6 +212,7 @@ bool e2sm_kpm::process_ric_action_definition(ri_caction_to_be_setup_item_s ric_a
 
   _generate_new_local_action_id();
 
+  std::lock_guard<std::mutex> lock(metrics_mutex);
   registered_actions_data.insert(
       std::pair<uint32_t, e2sm_kpm_report_service*>(action_entry.sm_local_ric_action_id, report_service));
 
@@ -246,6 +221,7 @@ bool e2sm_kpm::process_ric_action_definition(ri_caction_to_be_setup_item_s ric_a
 
 bool e2sm_kpm::remove_ric_action_definition(E2AP_RIC_action_t& action_entry)
 {
+  std::lock_guard<std::mutex> lock(metrics_mutex);
   if (registered_actions_data.count(action_entry.sm_local_ric_action_id)) {
     registered_actions_data.at(action_entry.sm_local_ric_action_id)->stop();
     delete registered_actions_data.at(action_entry.sm_local_ric_action_id);
@@ -257,7 +233,8 @@ bool e2sm_kpm::remove_ric_action_definition(E2AP_RIC_action_t& action_entry)
 
 bool e2sm_kpm::generate_ric_indication_content(E2AP_RIC_action_t& action_entry, ric_indication_t& ric_indication)
 {
-  uint32_t action_id = action_entry.sm_local_ric_action_id;
+  std::lock_guard<std::mutex> lock(metrics_mutex);
+  uint32_t                    action_id = action_entry.sm_local_ric_action_id;
   if (!registered_actions_data.count(action_id)) {
     logger.info("Unknown RIC action ID: %i (type %i)  (SM local RIC action ID: %i)",
                 action_entry.ric_action_id,
@@ -279,7 +256,9 @@ bool e2sm_kpm::generate_ric_indication_content(E2AP_RIC_action_t& action_entry,
 
   logger.info("Generating E2-SM-KPM Indication Message");
   ric_indication.ri_cind_msg = srsran::make_byte_buffer();
-  this->_generate_indication_message(report_service->get_ind_msg(), ric_indication.ri_cind_msg);
+  if (ric_indication.ri_cind_msg == nullptr or not report_service->_pack_ric_ind_msg(ric_indication.ri_cind_msg)) {
+    return false;
+  }
 
   // clear data collected for this action
   report_service->clear_collected_data();
@@ -313,148 +292,47 @@ bool e2sm_kpm::_generate_indication_message(e2_sm_kpm_ind_msg_s& msg, srsran::un
 
 bool e2sm_kpm::_get_meas_definition(std::string meas_name, e2sm_kpm_metric_t& def)
 {
-  auto name_matches = [&meas_name](const e2sm_kpm_metric_t& x) {
-    return (x.name == meas_name.c_str() or x.name == meas_name);
-  };
-  auto it = std::find_if(supported_meas_types.begin(), supported_meas_types.end(), name_matches);
-  if (it == supported_meas_types.end()) {
+  const e2sm_kpm_registry_entry_t* entry = registry.find(meas_name);
+  if (entry == nullptr) {
     return false;
   }
-  def = *it;
+  def = entry->def;
   return true;
 }
 
-std::vector<std::string> e2sm_kpm::_get_supported_meas(uint32_t level_mask)
-{
-  std::vector<std::string> supported_meas;
-  for (auto& metric : supported_meas_types) {
-    if ((level_mask & ENB_LEVEL) and (metric.supported_scopes & ENB_LEVEL)) {
-      supported_meas.push_back(metric.name);
-    } else if ((level_mask & CELL_LEVEL) and (metric.supported_scopes & CELL_LEVEL)) {
-      supported_meas.push_back(metric.name);
-    } else if ((level_mask & UE_LEVEL) and (metric.supported_scopes & UE_LEVEL)) {
-      supported_meas.push_back(metric.name);
-    } else if ((level_mask & BEARER_LEVEL) and (metric.supported_scopes & BEARER_LEVEL)) {
-      supported_meas.push_back(metric.name);
-    }
-  }
-
-  return supported_meas;
-}
-
-void e2sm_kpm::receive_e2_metrics_callback(const enb_metrics_t& m)
-{
-  last_enb_metrics = m;
-  logger.debug("e2sm_kpm received new enb metrics, CPU0 Load: %.1f", last_enb_metrics.sys.cpu_load[0]);
-}
-
-bool e2sm_kpm::_collect_meas_value(e2sm_kpm_meas_def_t& meas_value, meas_record_item_c& item)
+bool e2sm_kpm::_get_cell_idx(const cgi_c& cell_global_id, uint32_t& cell_idx)
 {
-  // here we implement logic of measurement data collection, currently we only read from enb_metrics
-  if (meas_value.data_type == meas_record_item_c::types::options::integer) {
-    uint32_t value;
-    if (_extract_integer_type_meas_value(meas_value, last_enb_metrics, value)) {
-      item.set_integer() = value;
-      return true;
-    }
+  uint64_t cell_id;
+  if (cell_global_id.type() == cgi_c::types_opts::eutra_cgi) {
+    cell_id = cell_global_id.eutra_cgi().eutra_cell_id.to_number();
+  } else if (cell_global_id.type() == cgi_c::types_opts::nr_cgi) {
+    cell_id = cell_global_id.nr_cgi().nrcell_id.to_number();
   } else {
-    // data_type == meas_record_item_c::types::options::real;
-    float value;
-    if (_extract_real_type_meas_value(meas_value, last_enb_metrics, value)) {
-      real_s real_value;
-      // TODO: real value seems to be not supported in asn1???
-      // real_value.value = value;
-      item.set_real() = real_value;
-      return true;
-    }
+    return false;
   }
 
-  return false;
+  auto it = std::find(cell_ids.begin(), cell_ids.end(), cell_id);
+  if (it == cell_ids.end()) {
+    logger.debug("Cell global ID with cell identity 0x%x is not served by the E2 node", cell_id);
+    return false;
+  }
+  cell_idx = it - cell_ids.begin();
+  return true;
 }
 
-bool e2sm_kpm::_extract_integer_type_meas_value(e2sm_kpm_meas_def_t& meas_value,
-                                                const enb_metrics_t& enb_metrics,
-                                                uint32_t&            value)
+std::vector<std::string> e2sm_kpm::_get_supported_meas(uint32_t level_mask)
 {
-  // TODO: maybe add ID to metric types in e2sm_kpm_metrics definitions, so we do not have to compare strings?
-  // TODO: make string comparison case insensitive
-  // all integer type measurements
-  // test: no_label
-  if (meas_value.name.c_str() == std::string("test")) {
-    switch (meas_value.label) {
-      case NO_LABEL:
-        if (meas_value.scope & ENB_LEVEL) {
-          value = (int32_t)enb_metrics.sys.cpu_load[0];
-          printf("extract last \"test\" value as int, (filled with ENB_LEVEL metric: CPU0_load) value %i \n", value);
-          return true;
-        }
-        if (meas_value.scope & CELL_LEVEL) {
-          uint32_t cell_id = meas_value.cell_id;
-          value            = (int32_t)enb_metrics.stack.mac.cc_info[cell_id].cc_rach_counter;
-          printf("extract last \"test\" value as int, (filled with CELL_LEVEL metric: cc_rach_counter) value %i \n",
-                 value);
-          return true;
-        }
-        if (meas_value.scope & UE_LEVEL) {
-          uint32_t ue_id = meas_value.ue_id;
-          value          = (int32_t)enb_metrics.stack.mac.ues[ue_id].ul_rssi;
-          printf("extract last \"test\" value as int, (filled with UE_LEVEL metric: ul_rssi) value %i \n", value);
-          return true;
-        }
-      default:
-        return false;
-    }
-  }
-
-  // random_int: no_label
-  if (meas_value.name.c_str() == std::string("random_int")) {
-    switch (meas_value.label) {
-      case NO_LABEL:
-        value = srsran_random_uniform_int_dist(random_gen, 0, 100);
-        printf("extract last \"random_int\" value as int, random value %i \n", value);
-        return true;
-      default:
-        return false;
-    }
-  }
-
-  return false;
+  return registry.get_supported_meas(level_mask);
 }
 
-bool e2sm_kpm::_extract_real_type_meas_value(e2sm_kpm_meas_def_t& meas_value,
-                                             const enb_metrics_t& enb_metrics,
-                                             float&               value)
+void e2sm_kpm::receive_e2_metrics_callback(const enb_metrics_t& m)
 {
-  // all real type measurements
-  // cpu0_load: no_label
-  if (meas_value.name.c_str() == std::string("cpu0_load")) {
-    switch (meas_value.label) {
-      case NO_LABEL:
-        value = enb_metrics.sys.cpu_load[0];
-        return true;
-      default:
-        return false;
-    }
-  }
+  std::lock_guard<std::mutex> lock(metrics_mutex);
+  last_enb_metrics = m;
+  logger.debug("e2sm_kpm received new enb metrics, CPU0 Load: %.1f", last_enb_metrics.sys.cpu_load[0]);
 
-  // cpu_load: min,max,avg
-  if (meas_value.name.c_str() == std::string("cpu_load")) {
-    uint32_t size;
-    switch (meas_value.label) {
-      case MIN_LABEL:
-        value = *std::min_element(enb_metrics.sys.cpu_load.begin(), enb_metrics.sys.cpu_load.end());
-        return true;
-      case MAX_LABEL:
-        value = *std::max_element(enb_metrics.sys.cpu_load.begin(), enb_metrics.sys.cpu_load.end());
-        return true;
-      case AVG_LABEL:
-        size  = enb_metrics.sys.cpu_load.size();
-        value = std::accumulate(enb_metrics.sys.cpu_load.begin(), enb_metrics.sys.cpu_load.end(), 0.0 / size);
-        return true;
-      default:
-        return false;
-    }
+  // update the label statistics of all admitted measurements
+  for (auto& it : registered_actions_data) {
+    it.second->_add_meas_samples(last_enb_metrics);
   }
-
-  return false;
-}
\ No newline at end of file
+}
@@ -0,0 +1,173 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsgnb/hdr/stack/ric/e2sm_kpm_registry.h"
+#include "srsgnb/hdr/stack/ric/e2sm_kpm_metrics.h"
+
+const stack_metrics_t& e2sm_kpm_get_stack_metrics(const enb_metrics_t& m)
+{
+  return m.nr_stack.mac.cc_info.empty() ? m.stack : m.nr_stack;
+}
+
+e2sm_kpm_registry::e2sm_kpm_registry()
+{
+  // add supported metrics
+  for (auto* metric_list : {get_e2sm_kpm_28_552_metrics,
+                            get_e2sm_kpm_34_425_metrics,
+                            e2sm_kpm_oran_metrics,
+                            e2sm_kpm_custom_metrics}) {
+    for (auto& metric : metric_list()) {
+      if (metric.def.supported) {
+        name_to_idx[metric.def.name] = entries.size();
+        entries.push_back(metric);
+      }
+    }
+  }
+}
+
+const e2sm_kpm_registry_entry_t* e2sm_kpm_registry::find(const std::string& meas_name) const
+{
+  auto it = name_to_idx.find(meas_name);
+  if (it == name_to_idx.end()) {
+    return nullptr;
+  }
+  return &entries[it->second];
+}
+
+std::vector<std::string> e2sm_kpm_registry::get_supported_meas(uint32_t level_mask) const
+{
+  std::vector<std::string> supported_meas;
+  for (const auto& entry : entries) {
+    if (entry.def.supported_scopes & level_mask) {
+      supported_meas.push_back(entry.def.name);
+    }
+  }
+  return supported_meas;
+}
+
+e2sm_kpm_meas_t::e2sm_kpm_meas_t(const e2sm_kpm_registry_entry_t* entry_,
+                                 e2sm_kpm_label_enum              label_,
+                                 e2sm_kpm_metric_scope_enum       scope_,
+                                 uint32_t                         id_) :
+  entry(entry_),
+  label(label_ == NO_LABEL and entry_ != nullptr ? entry_->no_label_stat : label_),
+  scope(scope_),
+  id(id_)
+{
+}
+
+bool e2sm_kpm_meas_t::get_sample(const enb_metrics_t& m, double& value)
+{
+  if (entry == nullptr) {
+    return false;
+  }
+
+  switch (scope) {
+    case ENB_LEVEL:
+      if (entry->enb_value == nullptr) {
+        return false;
+      }
+      value = entry->enb_value(m);
+      return true;
+    case CELL_LEVEL:
+      if (entry->cell_value == nullptr) {
+        return false;
+      }
+      value = entry->cell_value(m, id);
+      return true;
+    case UE_LEVEL: {
+      if (entry->ue_value == nullptr) {
+        return false;
+      }
+      // Look the UE up from its position in the previous report
+      const std::vector<mac_ue_metrics_t>& ues = e2sm_kpm_get_stack_metrics(m).mac.ues;
+      if (ue_idx_hint >= ues.size() or ues[ue_idx_hint].rnti != id) {
+        auto it = std::find_if(ues.begin(), ues.end(), [this](const mac_ue_metrics_t& ue) { return ue.rnti == id; });
+        if (it == ues.end()) {
+          return false;
+        }
+        ue_idx_hint = it - ues.begin();
+      }
+      value = entry->ue_value(m, ue_idx_hint);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+void e2sm_kpm_meas_t::add_sample(const enb_metrics_t& m)
+{
+  double value;
+  if (not get_sample(m, value)) {
+    return;
+  }
+
+  if (nof_samples == 0) {
+    min_val = value;
+    max_val = value;
+  } else {
+    min_val = std::min(min_val, value);
+    max_val = std::max(max_val, value);
+  }
+  sum_val += value;
+  nof_samples++;
+}
+
+void e2sm_kpm_meas_t::get_record(meas_record_item_c& item) const
+{
+  if (nof_samples == 0) {
+    item.set_no_value();
+    return;
+  }
+
+  double value;
+  switch (label) {
+    case MIN_LABEL:
+      value = min_val;
+      break;
+    case MAX_LABEL:
+      value = max_val;
+      break;
+    case SUM_LABEL:
+      value = sum_val;
+      break;
+    case AVG_LABEL:
+    default:
+      value = sum_val / nof_samples;
+      break;
+  }
+
+  if (entry->def.data_type == INTEGER) {
+    item.set_integer() = (uint64_t)std::max(std::round(value), 0.0);
+  } else {
+    // TODO: real value seems to be not supported in asn1???
+    item.set_real();
+  }
+}
+
+void e2sm_kpm_meas_t::reset()
+{
+  nof_samples = 0;
+  min_val     = 0.0;
+  max_val     = 0.0;
+  sum_val     = 0.0;
+}
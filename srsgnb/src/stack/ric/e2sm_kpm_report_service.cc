@@ -130,11 +130,31 @@ bool e2sm_kpm_report_service::_reschedule_meas_collection()
   return false;
 }
 
+bool e2sm_kpm_report_service::_pack_ric_ind_msg(srsran::unique_byte_buffer_t& buf)
+{
+  return parent->_generate_indication_message(ric_ind_message_generic, buf);
+}
+
+void e2sm_kpm_report_service::_add_meas_samples(const enb_metrics_t& m)
+{
+  for (auto& meas : meas_list) {
+    meas.add_sample(m);
+  }
+}
+
 e2sm_kpm_report_service_style1::e2sm_kpm_report_service_style1(e2sm_kpm*                     e2sm_kpm,
                                                                uint16_t                      action_id,
                                                                e2_sm_kpm_action_definition_s action_definition) :
+  e2sm_kpm_report_service_style1(e2sm_kpm, action_id, action_definition, SRSRAN_INVALID_RNTI)
+{
+}
+
+e2sm_kpm_report_service_style1::e2sm_kpm_report_service_style1(e2sm_kpm*                     e2sm_kpm,
+                                                               uint16_t                      action_id,
+                                                               e2_sm_kpm_action_definition_s action_definition,
+                                                               uint16_t                      ue_rnti) :
   e2sm_kpm_report_service(e2sm_kpm, action_id, action_definition),
-  action_def(action_def_generic.action_definition_formats.action_definition_format1()),
+  action_def(_get_subscript_info(action_def_generic)),
   ric_ind_message(ric_ind_message_generic.ind_msg_formats.set_ind_msg_format1())
 {
   ind_msg_format         = e2_sm_kpm_ind_msg_s::ind_msg_formats_c_::types_opts::ind_msg_format1;
@@ -144,13 +164,31 @@ e2sm_kpm_report_service_style1::e2sm_kpm_report_service_style1(e2sm_kpm*
     cell_global_id = action_def.cell_global_id;
   }
 
+  if (ue_rnti != SRSRAN_INVALID_RNTI) {
+    meas_scope = UE_LEVEL;
+    meas_id    = ue_rnti;
+  } else if (cell_global_id_present) {
+    meas_scope = CELL_LEVEL;
+    // the cell was checked when the action was admitted
+    parent->_get_cell_idx(cell_global_id, meas_id);
+  }
+
   this->_initialize_ric_ind_hdr();
   this->_initialize_ric_ind_msg();
 
-  granul_period = 1000; // TODO: overwrite for testing
   _start_meas_collection();
 }
 
+e2_sm_kpm_action_definition_format1_s&
+e2sm_kpm_report_service_style1::_get_subscript_info(e2_sm_kpm_action_definition_s& action_definition)
+{
+  if (action_definition.action_definition_formats.type() ==
+      e2_sm_kpm_action_definition_s::action_definition_formats_c_::types_opts::action_definition_format2) {
+    return action_definition.action_definition_formats.action_definition_format2().subscript_info;
+  }
+  return action_definition.action_definition_formats.action_definition_format1();
+}
+
 bool e2sm_kpm_report_service_style1::_initialize_ric_ind_msg()
 {
   meas_info_list_l action_meas_info_list = action_def.meas_info_list;
@@ -160,6 +198,8 @@ bool e2sm_kpm_report_service_style1::_initialize_ric_ind_msg()
   ric_ind_message.granul_period = 0;
   ric_ind_message.meas_info_list.resize(action_meas_info_list.size());
   ric_ind_message.meas_data.resize(action_meas_info_list.size());
+  meas_list.clear();
+  meas_list.reserve(action_meas_info_list.size());
 
   // add measurement info
   for (uint32_t i = 0; i < ric_ind_message.meas_info_list.size(); i++) {
@@ -196,22 +236,47 @@ bool e2sm_kpm_report_service_style1::_initialize_ric_ind_msg()
         meas_info_item.label_info_list[l].meas_label.sum         = meas_label_s::sum_opts::true_value;
       }
     }
+
+    // resolve the measurement once, the collection only reads its label statistic
+    std::vector<e2sm_kpm_label_enum> labels = _get_present_labels(meas_def_item);
+    meas_list.emplace_back(
+        parent->registry.find(meas_name), labels.empty() ? NO_LABEL : labels[0], meas_scope, meas_id);
   }
 
+  // the measurement info follows the measurement data, whose length field leaves it octet-aligned
+  srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  if (buf == nullptr) {
+    return false;
+  }
+  asn1::bit_ref bref(buf->msg, buf->get_tailroom());
+  if (ric_ind_message.meas_info_list.size() > 0) {
+    if (pack_dyn_seq_of(bref, ric_ind_message.meas_info_list, 1, 65535, true) != asn1::SRSASN_SUCCESS) {
+      parent->logger.error("Failed to pack the measurement info of action %i", action_id);
+      return false;
+    }
+  }
+  if (ric_ind_message.granul_period_present) {
+    pack_integer(bref, ric_ind_message.granul_period, (uint64_t)1u, (uint64_t)4294967295u, false, true);
+  }
+  bref.align_bytes_zero();
+  ric_ind_msg_tail.assign(buf->msg, buf->msg + bref.distance_bytes());
+
   return true;
 }
 
 bool e2sm_kpm_report_service_style1::process_ric_action_definition(e2sm_kpm*                      e2sm_kpm,
                                                                    e2_sm_kpm_action_definition_s& action_def_generic)
 {
-  e2_sm_kpm_action_definition_format1_s& action_definition =
-      action_def_generic.action_definition_formats.action_definition_format1();
+  e2_sm_kpm_action_definition_format1_s& action_definition = _get_subscript_info(action_def_generic);
+  return _process_subscript_info(
+      e2sm_kpm, action_definition, action_definition.cell_global_id_present ? CELL_LEVEL : ENB_LEVEL);
+}
 
-  bool             cell_global_id_present = false;
+bool e2sm_kpm_report_service_style1::_process_subscript_info(e2sm_kpm*                              e2sm_kpm,
+                                                             e2_sm_kpm_action_definition_format1_s& action_definition,
+                                                             e2sm_kpm_metric_scope_enum             scope)
+{
   uint64_t         granul_period;
-  uint64_t         eutra_cell_id;
-  uint64_t         plmn_id;
-  ueid_c           ue_id;
   meas_info_list_l meas_info_list;
 
   granul_period = action_definition.granul_period;
@@ -223,13 +288,12 @@ bool e2sm_kpm_report_service_style1::process_ric_action_definition(e2sm_kpm*
   }
 
   if (action_definition.cell_global_id_present) {
-    cell_global_id_present = true;
-    if (action_definition.cell_global_id.type() == cgi_c::types_opts::eutra_cgi) {
-      eutra_cell_id = action_definition.cell_global_id.eutra_cgi().eutra_cell_id.to_number();
-      plmn_id       = action_definition.cell_global_id.eutra_cgi().plmn_id.to_number();
-      e2sm_kpm->logger.debug("plmn_id 0x%x, eutra_cell_id %i", plmn_id, eutra_cell_id);
-      //  TODO: check if E2 node has cell_id and plmn_id
+    uint32_t cell_idx;
+    if (not e2sm_kpm->_get_cell_idx(action_definition.cell_global_id, cell_idx)) {
+      printf("Unknown cell global ID --> do not admit action\n");
+      return false;
     }
+    e2sm_kpm->logger.debug("Cell global ID of cell index %i", cell_idx);
   }
 
   std::map<std::string, e2sm_kpm_label_enum> admitted_metrics;
@@ -242,10 +306,13 @@ bool e2sm_kpm_report_service_style1::process_ric_action_definition(e2sm_kpm*
       return false;
     }
 
+    if (not(metric_definition.supported_scopes & scope)) {
+      printf("Unsupported level 0x%x for metric \"%s\" --> do not admit action\n", scope, meas_name.c_str());
+      return false;
+    }
+
     uint32_t nof_labels = 0;
     // TODO: add all labels defined in e2sm_kpm doc, make this part generic and put to base class
-    // TODO: check if metric is supported at the requested level, i.e., CELL_LEVEL if cell_global_id_present == true,
-    // and ENB_LEVEL otherwise
     for (uint32_t l = 0; l < meas_info_list[i].label_info_list.size(); l++) {
       if (meas_info_list[i].label_info_list[l].meas_label.no_label_present) {
         if (metric_definition.supported_labels & NO_LABEL) {
@@ -283,6 +350,15 @@ bool e2sm_kpm_report_service_style1::process_ric_action_definition(e2sm_kpm*
           return false;
         }
       }
+      if (meas_info_list[i].label_info_list[l].meas_label.sum_present) {
+        if (metric_definition.supported_labels & SUM_LABEL) {
+          nof_labels++;
+          admitted_metrics[meas_name] = SUM_LABEL;
+        } else {
+          printf("Unsupported label: SUM_LABEL for metric \"%s\" --> do not admit action\n", meas_name.c_str());
+          return false;
+        }
+      }
     }
 
     // Note: currently we use labels as choice (i.e., only one can be present) as documentation is not clear about it
@@ -304,98 +380,19 @@ bool e2sm_kpm_report_service_style1::process_ric_action_definition(e2sm_kpm*
   return true;
 }
 
-meas_data_item_s& e2sm_kpm_report_service_style1::_get_meas_data_item(std::string         meas_name,
-                                                                      e2sm_kpm_label_enum label,
-                                                                      uint32_t            ue_id,
-                                                                      bool&               ref_found)
-{
-  meas_info_list_l& meas_info_list = ric_ind_message.meas_info_list;
-  ref_found                        = false;
-  // find proper index of the metric
-  for (uint32_t i = 0; i < meas_info_list.size(); i++) {
-    // measurements definition
-    meas_info_item_s meas_def_item = meas_info_list[i];
-    std::string      meas_def_name = meas_def_item.meas_type.meas_name().to_string();
-
-    // check if the metric name matches
-    if (meas_def_name != meas_name.c_str()) {
-      continue;
-    }
-
-    // check if the metric label matches
-    // TODO: add all labels defined in e2sm_kpm doc
-    for (uint32_t l = 0; l < meas_def_item.label_info_list.size(); l++) {
-      if (meas_def_item.label_info_list[l].meas_label.no_label_present and label == NO_LABEL) {
-        ref_found = true;
-        return ric_ind_message.meas_data[i];
-      }
-      if (meas_def_item.label_info_list[l].meas_label.min_present and label == MIN_LABEL) {
-        ref_found = true;
-        return ric_ind_message.meas_data[i];
-      }
-      if (meas_def_item.label_info_list[l].meas_label.max_present and label == MAX_LABEL) {
-        ref_found = true;
-        return ric_ind_message.meas_data[i];
-      }
-      if (meas_def_item.label_info_list[l].meas_label.avg_present and label == AVG_LABEL) {
-        ref_found = true;
-        return ric_ind_message.meas_data[i];
-      }
-      if (meas_def_item.label_info_list[l].meas_label.sum_present and label == SUM_LABEL) {
-        ref_found = true;
-        return ric_ind_message.meas_data[i];
-      }
-    }
-  }
-  // TODO assert if match == false, has to be present as was created during initialization
-  ref_found = false;
-  return ric_ind_message.meas_data[0];
-}
-
 bool e2sm_kpm_report_service_style1::_collect_meas_data()
 {
-  meas_info_list_l& meas_info_list = ric_ind_message.meas_info_list;
-  for (uint32_t i = 0; i < meas_info_list.size(); i++) {
-    meas_info_item_s&                meas_def_item = meas_info_list[i];
-    std::string                      meas_name     = meas_def_item.meas_type.meas_name().to_string();
-    std::vector<e2sm_kpm_label_enum> labels        = _get_present_labels(meas_def_item);
-
-    for (const auto& label : labels) {
-      // TODO: probably some labels need a special processing (e.g., use bin width that needs to be stored)
-      // get a proper record list
-      bool              ref_found      = false;
-      meas_data_item_s& meas_data_item = _get_meas_data_item(meas_name, label, 0, ref_found);
-      if (not ref_found) {
-        parent->logger.info("Cannot find a meas record list, action_id %i, metric \"%s\" label: %i",
-                            action_id,
-                            meas_name.c_str(),
-                            label);
-        return false;
-      }
-
-      // get data type
-      meas_record_item_c::types data_type = _get_meas_data_type(meas_name, label, meas_data_item.meas_record);
-
-      // extract a needed value from enb metrics and add to the proper meas record list
-      e2sm_kpm_meas_def_t meas_value;
-      meas_value.name  = meas_name;
-      meas_value.label = label;
-      meas_value.scope = ENB_LEVEL;
-      if (cell_global_id_present) {
-        meas_value.scope   = CELL_LEVEL;
-        meas_value.cell_id = 0;
-      }
-      meas_value.data_type = data_type;
-
-      meas_record_item_c item;
-      if (not parent->_collect_meas_value(meas_value, item)) {
-        parent->logger.info("Cannot extract value \"%s\" label: %i", meas_name.c_str(), label);
-        return false;
-      }
-
-      // save meas value in the proper record list
-      meas_data_item.meas_record.push_back(item);
+  std::lock_guard<std::mutex> lock(parent->metrics_mutex);
+  for (uint32_t i = 0; i < meas_list.size(); i++) {
+    // no metrics report during the granularity period: a gauge keeps its last value, a counter has no value
+    if (not meas_list[i].has_samples() and not meas_list[i].is_counter()) {
+      meas_list[i].add_sample(parent->last_enb_metrics);
     }
+
+    meas_record_item_c item;
+    meas_list[i].get_record(item);
+    ric_ind_message.meas_data[i].meas_record.push_back(item);
+    meas_list[i].reset();
   }
 
   // reschedule measurement collection
@@ -409,6 +406,29 @@ bool e2sm_kpm_report_service_style1::is_ric_ind_ready()
   return true;
 }
 
+bool e2sm_kpm_report_service_style1::_pack_ric_ind_msg(srsran::unique_byte_buffer_t& buf)
+{
+  // same encoding as e2_sm_kpm_ind_msg_s::pack(), but only the measurement data is packed per indication
+  asn1::bit_ref bref(buf->msg, buf->get_tailroom());
+  bref.pack(ric_ind_message_generic.ext, 1);
+  ric_ind_message_generic.ind_msg_formats.type().pack(bref);
+  bref.pack(ric_ind_message.ext, 1);
+  bref.pack(ric_ind_message.meas_info_list.size() > 0, 1);
+  bref.pack(ric_ind_message.granul_period_present, 1);
+  if (pack_dyn_seq_of(bref, ric_ind_message.meas_data, 1, 65535, true) != asn1::SRSASN_SUCCESS) {
+    parent->logger.error("Failed to pack the measurement data of action %i", action_id);
+    return false;
+  }
+  bref.align_bytes_zero();
+  if (not ric_ind_msg_tail.empty() and
+      bref.pack_bytes(ric_ind_msg_tail.data(), ric_ind_msg_tail.size()) != asn1::SRSASN_SUCCESS) {
+    parent->logger.error("Failed to pack the measurement info of action %i", action_id);
+    return false;
+  }
+  buf->N_bytes = bref.distance_bytes();
+  return true;
+}
+
 bool e2sm_kpm_report_service_style1::clear_collected_data()
 {
   ric_ind_header.collet_start_time.from_number(std::time(0));
@@ -421,46 +441,38 @@ bool e2sm_kpm_report_service_style1::clear_collected_data()
 e2sm_kpm_report_service_style2::e2sm_kpm_report_service_style2(e2sm_kpm*                     e2sm_kpm,
                                                                uint16_t                      action_id,
                                                                e2_sm_kpm_action_definition_s action_definition) :
-  e2sm_kpm_report_service(e2sm_kpm, action_id, action_definition),
-  action_def(action_def_generic.action_definition_formats.action_definition_format2()),
-  ric_ind_message(ric_ind_message_generic.ind_msg_formats.set_ind_msg_format1())
+  e2sm_kpm_report_service_style1(
+      e2sm_kpm,
+      action_id,
+      action_definition,
+      _get_ue_rnti(action_definition.action_definition_formats.action_definition_format2().ue_id))
 {
-  ind_msg_format = e2_sm_kpm_ind_msg_s::ind_msg_formats_c_::types_opts::ind_msg_format1;
-  this->_initialize_ric_ind_hdr();
-  this->_initialize_ric_ind_msg();
 }
 
-bool e2sm_kpm_report_service_style2::_initialize_ric_ind_msg()
+uint16_t e2sm_kpm_report_service_style2::_get_ue_rnti(const ueid_c& ue_id)
 {
-  // TODO: implement
-  return false;
+  uint64_t ran_ueid = SRSRAN_INVALID_RNTI;
+  if (ue_id.type() == ueid_c::types_opts::gnb_ueid and ue_id.gnb_ueid().ran_ueid_present) {
+    ran_ueid = ue_id.gnb_ueid().ran_ueid.to_number();
+  } else if (ue_id.type() == ueid_c::types_opts::gnb_du_ueid and ue_id.gnb_du_ueid().ran_ueid_present) {
+    ran_ueid = ue_id.gnb_du_ueid().ran_ueid.to_number();
+  }
+  return ran_ueid > SRSRAN_CRNTI_END ? SRSRAN_INVALID_RNTI : ran_ueid;
 }
 
 bool e2sm_kpm_report_service_style2::process_ric_action_definition(e2sm_kpm*                      e2sm_kpm,
                                                                    e2_sm_kpm_action_definition_s& action_def_generic)
 {
-  // TODO: implement
-  // note: similar to e2sm_kpm_report_service_style1::process_ric_action_definition but in addition
-  // we need to check whether measurement is supported at UE_LEVEL
-  return false;
-}
+  e2_sm_kpm_action_definition_format2_s& action_definition =
+      action_def_generic.action_definition_formats.action_definition_format2();
 
-bool e2sm_kpm_report_service_style2::_collect_meas_data()
-{
-  // TODO: implement
-  return false;
-}
-
-bool e2sm_kpm_report_service_style2::is_ric_ind_ready()
-{
-  // TODO: check if only NO_VALUES, if so then skip
-  return false;
-}
+  uint16_t rnti = _get_ue_rnti(action_definition.ue_id);
+  if (rnti == SRSRAN_INVALID_RNTI) {
+    printf("UE identity without a valid RAN UE ID --> do not admit action\n");
+    return false;
+  }
 
-bool e2sm_kpm_report_service_style2::clear_collected_data()
-{
-  // TODO: implement
-  return false;
+  return _process_subscript_info(e2sm_kpm, action_definition.subscript_info, UE_LEVEL);
 }
 
 e2sm_kpm_report_service_style3::e2sm_kpm_report_service_style3(e2sm_kpm*                     e2sm_kpm,
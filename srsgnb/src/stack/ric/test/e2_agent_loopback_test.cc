@@ -0,0 +1,236 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsgnb/hdr/stack/ric/e2_agent.h"
+#include "srsran/common/test_common.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// Stand-in RIC on a loopback SCTP socket. It accepts the E2 setup of the agent, subscribes to a number of E2SM-KPM
+// report actions and counts the RIC indications it receives
+
+static const char*    ric_addr         = "127.0.0.1";
+static const uint32_t ran_function_id  = 147;
+static const uint32_t ric_requestor_id = 1021;
+static const uint64_t cell_id          = 0x19b01; // ECI of the only cell, eNB ID 0x19B and cell ID 0x01
+
+class dummy_metrics_interface : public srsenb::e2_interface_metrics
+{
+  bool pull_metrics(srsenb::enb_metrics_t* m) { return true; }
+  bool register_e2sm(e2sm* sm) { return true; }
+  bool unregister_e2sm(e2sm* sm) { return true; }
+};
+
+static bool send_pdu(srsran::unique_socket& sock, const sockaddr_in& to, const e2_ap_pdu_c& pdu)
+{
+  srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  asn1::bit_ref                bref(buf->msg, buf->get_tailroom());
+  if (pdu.pack(bref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  buf->N_bytes = bref.distance_bytes();
+  ssize_t n_sent =
+      sctp_sendmsg(sock.fd(), buf->msg, buf->N_bytes, (sockaddr*)&to, sizeof(to), htonl(e2ap_ppid), 0, 0, 0, 0);
+  return n_sent == buf->N_bytes;
+}
+
+static e2_ap_pdu_c make_setup_response(const e2setup_request_s& setup_request)
+{
+  e2_ap_pdu_c           pdu;
+  successful_outcome_s& success = pdu.set_successful_outcome();
+  success.load_info_obj(ASN1_E2AP_ID_E2SETUP);
+  e2setup_resp_s& setup_response             = success.value.e2setup_resp();
+  setup_response->transaction_id.value.value = setup_request->transaction_id.value.value;
+  setup_response->global_ric_id.value.plmn_id.from_number(0x05f510);
+  setup_response->global_ric_id.value.ric_id.from_number(1);
+  return pdu;
+}
+
+static e2_ap_pdu_c make_subscription_request(uint32_t nof_actions, uint32_t report_period_ms)
+{
+  e2_ap_pdu_c pdu;
+  init_msg_s& initmsg = pdu.set_init_msg();
+  initmsg.load_info_obj(ASN1_E2AP_ID_RICSUBSCRIPTION);
+  ricsubscription_request_s& request        = initmsg.value.ricsubscription_request();
+  request->ri_crequest_id->ric_requestor_id = ric_requestor_id;
+  request->ri_crequest_id->ric_instance_id  = 0;
+  request->ra_nfunction_id->value           = ran_function_id;
+
+  srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  asn1::bit_ref                bref(buf->msg, buf->get_tailroom());
+
+  e2_sm_kpm_event_trigger_definition_s trigger_def;
+  trigger_def.event_definition_formats.event_definition_format1().report_period = report_period_ms;
+  trigger_def.pack(bref);
+  asn1::unbounded_octstring<true>& trigger = request->ricsubscription_details->ric_event_trigger_definition;
+  trigger.resize(bref.distance_bytes());
+  std::copy(buf->msg, buf->msg + bref.distance_bytes(), trigger.data());
+
+  // cell measurements collected every report period
+  e2_sm_kpm_action_definition_s          action_def;
+  e2_sm_kpm_action_definition_format1_s& def = action_def.action_definition_formats.set_action_definition_format1();
+  action_def.ric_style_type                  = 1;
+  def.granul_period                          = report_period_ms;
+  def.cell_global_id_present                 = true;
+  def.cell_global_id.set_eutra_cgi().eutra_cell_id.from_number(cell_id);
+  const char* meas_names[] = {"RRC.ConnMean", "DRB.UEThpDl", "DRB.UEThpUl"};
+  def.meas_info_list.resize(sizeof(meas_names) / sizeof(meas_names[0]));
+  for (uint32_t i = 0; i < def.meas_info_list.size(); i++) {
+    def.meas_info_list[i].meas_type.set_meas_name().from_string(meas_names[i]);
+    def.meas_info_list[i].label_info_list.resize(1);
+    def.meas_info_list[i].label_info_list[0].meas_label.no_label_present = true;
+    def.meas_info_list[i].label_info_list[0].meas_label.no_label         = meas_label_s::no_label_opts::true_value;
+  }
+  bref = asn1::bit_ref(buf->msg, buf->get_tailroom());
+  action_def.pack(bref);
+
+  ri_cactions_to_be_setup_list_l& action_list = request->ricsubscription_details->ric_action_to_be_setup_list;
+  action_list.resize(nof_actions);
+  for (uint32_t i = 0; i < nof_actions; i++) {
+    action_list[i].load_info_obj(ASN1_E2AP_ID_RI_CACTION_TO_BE_SETUP_ITEM);
+    ri_caction_to_be_setup_item_s& action = action_list[i]->ri_caction_to_be_setup_item();
+    action.ric_action_id                  = i;
+    action.ric_action_type                = ri_caction_type_opts::report;
+    action.ric_action_definition.resize(bref.distance_bytes());
+    std::copy(buf->msg, buf->msg + bref.distance_bytes(), action.ric_action_definition.data());
+  }
+  return pdu;
+}
+
+int run_loopback_test(uint32_t nof_actions, uint32_t report_period_ms, uint32_t duration_s)
+{
+  using namespace srsran::net_utils;
+  srsran::unique_socket ric_socket;
+  if (not ric_socket.open_socket(addr_family::ipv4, socket_type::seqpacket, protocol_type::SCTP) or
+      not ric_socket.bind_addr(ric_addr, 0) or not ric_socket.start_listen()) {
+    return SRSRAN_ERROR;
+  }
+  // the RIC listens on an ephemeral port, so that the test does not depend on the E2 port being free
+  sockaddr_in ric_sockaddr = {};
+  socklen_t   addr_len     = sizeof(ric_sockaddr);
+  if (getsockname(ric_socket.fd(), (sockaddr*)&ric_sockaddr, &addr_len) != 0) {
+    return SRSRAN_ERROR;
+  }
+  struct timeval rx_timeout = {0, 100000};
+  setsockopt(ric_socket.fd(), SOL_SOCKET, SO_RCVTIMEO, &rx_timeout, sizeof(rx_timeout));
+
+  dummy_metrics_interface dummy_metrics;
+  srsenb::e2_agent        agent(srslog::fetch_basic_logger("E2_AGENT"), &dummy_metrics);
+  e2_agent_args_t         args = {};
+  args.enable                  = true;
+  args.ric_ip                  = ric_addr;
+  args.ric_port                = ntohs(ric_sockaddr.sin_port);
+  args.ric_bind_ip             = ric_addr;
+  args.ric_bind_port           = 0;
+  args.max_ric_setup_retries   = 0;
+  args.ric_connect_timer       = 1;
+  args.cell_ids                = {cell_id};
+  agent.init(args);
+
+  // the agent timers are driven by the caller of tic(), as by the eNB every TTI
+  std::atomic<bool> running{true};
+  std::thread       tic_thread([&agent, &running]() {
+    while (running) {
+      agent.tic();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+
+  uint32_t nof_indications = 0;
+  bool     subscribed      = false;
+  auto     tp_first_ind    = std::chrono::steady_clock::now();
+  auto     tp_deadline     = tp_first_ind + std::chrono::seconds(duration_s + 10);
+  uint8_t  rx_buf[65536];
+  while (std::chrono::steady_clock::now() < tp_deadline) {
+    sockaddr_in     from     = {};
+    socklen_t       from_len = sizeof(from);
+    sctp_sndrcvinfo sri      = {};
+    int             flags    = 0;
+    int rd_sz = sctp_recvmsg(ric_socket.fd(), rx_buf, sizeof(rx_buf), (sockaddr*)&from, &from_len, &sri, &flags);
+    if (rd_sz <= 0 or (flags & MSG_NOTIFICATION)) {
+      continue;
+    }
+
+    e2_ap_pdu_c    pdu;
+    asn1::cbit_ref bref(rx_buf, rd_sz);
+    if (pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+      continue;
+    }
+    if (pdu.type().value == e2_ap_pdu_c::types_opts::init_msg and
+        pdu.init_msg().value.type().value == e2_ap_elem_procs_o::init_msg_c::types_opts::e2setup_request) {
+      bool sent = send_pdu(ric_socket, from, make_setup_response(pdu.init_msg().value.e2setup_request())) and
+                  send_pdu(ric_socket, from, make_subscription_request(nof_actions, report_period_ms));
+      TESTASSERT(sent);
+    } else if (pdu.type().value == e2_ap_pdu_c::types_opts::successful_outcome and
+               pdu.successful_outcome().value.type().value ==
+                   e2_ap_elem_procs_o::successful_outcome_c::types_opts::ricsubscription_resp) {
+      subscribed = true;
+    } else if (pdu.type().value == e2_ap_pdu_c::types_opts::init_msg and
+               pdu.init_msg().value.type().value == e2_ap_elem_procs_o::init_msg_c::types_opts::ri_cind) {
+      TESTASSERT_EQ(ric_requestor_id, pdu.init_msg().value.ri_cind()->ri_crequest_id->ric_requestor_id);
+      if (nof_indications == 0) {
+        tp_first_ind = std::chrono::steady_clock::now();
+        tp_deadline  = tp_first_ind + std::chrono::seconds(duration_s);
+      }
+      nof_indications++;
+    }
+  }
+
+  agent.stop();
+  running = false;
+  tic_thread.join();
+
+  TESTASSERT(subscribed);
+  TESTASSERT(nof_indications > 0);
+  fmt::print(
+      "\n{:>11}  {:>16}  {:>15}  {:>13}\n", "nof_actions", "report_period_ms", "nof_indications", "indications/s");
+  fmt::print("{:>11}  {:>16}  {:>15}  {:>13.1f}\n",
+             nof_actions,
+             report_period_ms,
+             nof_indications,
+             nof_indications / (double)duration_s);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("E2_AGENT").set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  uint32_t nof_actions      = 16;
+  uint32_t report_period_ms = 10;
+  uint32_t duration_s       = 2;
+  if (argc > 1) {
+    nof_actions = strtoul(argv[1], nullptr, 10);
+  }
+  if (argc > 2) {
+    report_period_ms = strtoul(argv[2], nullptr, 10);
+  }
+  if (argc > 3) {
+    duration_s = strtoul(argv[3], nullptr, 10);
+  }
+
+  int ret = run_loopback_test(nof_actions, report_period_ms, duration_s);
+
+  srslog::flush();
+  return ret;
+}
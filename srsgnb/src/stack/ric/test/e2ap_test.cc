@@ -171,6 +171,62 @@ void test_native_e2ap_reset_response()
   TESTASSERT_EQ(asn1::SRSASN_SUCCESS, unpack_ret);
   printf("Unpacked native E2AP PDU RESET RESPONSE %d\n", (int)unpack_ret);
 }
+
+// the pre-encoded RIC Indication has to produce the same bytes as the generic ASN.1 packer
+void test_native_e2ap_indication_template()
+{
+  srslog::basic_logger&   logger = srslog::fetch_basic_logger("E2AP");
+  dummy_metrics_interface dummy_metrics;
+  e2ap                    e2ap_(logger, nullptr, &dummy_metrics, NULL);
+
+  ric_indication_t ric_indication;
+  ric_indication.ric_requestor_id         = 1021;
+  ric_indication.ric_instance_id          = 0;
+  ric_indication.ra_nfunction_id          = 147;
+  ric_indication.ri_caction_id            = 3;
+  ric_indication.ri_indication_sn_present = true;
+  ric_indication.ri_indication_sn         = 0;
+  ric_indication.indication_type          = ri_cind_type_opts::report;
+  ric_indication.ri_cind_hdr              = srsran::make_byte_buffer();
+  ric_indication.ri_cind_msg              = srsran::make_byte_buffer();
+
+  ric_indication_template ind_template;
+  bool                    initialized = ind_template.init(e2ap_.generate_indication(ric_indication));
+  TESTASSERT(initialized);
+
+  // lengths around the one and two octets length determinants of the octet strings and their open types
+  for (uint32_t hdr_len : {0u, 11u, 126u, 127u, 128u}) {
+    for (uint32_t msg_len : {0u, 1u, 100u, 126u, 127u, 128u, 1000u, 4000u}) {
+      ric_indication.ri_indication_sn     = (hdr_len * 1000 + msg_len) % 65536;
+      ric_indication.ri_cind_hdr->N_bytes = hdr_len;
+      ric_indication.ri_cind_msg->N_bytes = msg_len;
+      for (uint32_t i = 0; i < hdr_len; i++) {
+        ric_indication.ri_cind_hdr->msg[i] = i;
+      }
+      for (uint32_t i = 0; i < msg_len; i++) {
+        ric_indication.ri_cind_msg->msg[i] = 255 - i % 256;
+      }
+
+      srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+      bool                         packed = ind_template.pack(ric_indication, *buf);
+      TESTASSERT(packed);
+
+      srsran::unique_byte_buffer_t ref_buf = srsran::make_byte_buffer();
+      asn1::bit_ref                bref(ref_buf->msg, ref_buf->get_tailroom());
+      asn1::SRSASN_CODE            pack_ret = e2ap_.generate_indication(ric_indication).pack(bref);
+      TESTASSERT_EQ(asn1::SRSASN_SUCCESS, pack_ret);
+      TESTASSERT_EQ(bref.distance_bytes(), (int)buf->N_bytes);
+      TESTASSERT(std::equal(buf->msg, buf->msg + buf->N_bytes, ref_buf->msg));
+    }
+  }
+
+  // indications that do not match the template are left to the generic packer
+  ric_indication.ri_indication_sn_present = false;
+  srsran::unique_byte_buffer_t buf        = srsran::make_byte_buffer();
+  bool                         packed     = ind_template.pack(ric_indication, *buf);
+  TESTASSERT(not packed);
+  printf("Packed pre-encoded E2AP RIC INDICATION\n");
+}
 // add tets for set-up request and response
 
 int main()
@@ -181,6 +237,7 @@ int main()
   test_native_e2ap_subscription_response();
   test_native_e2ap_reset_request();
   test_native_e2ap_reset_response();
+  test_native_e2ap_indication_template();
   // call reset test functions here
   return 0;
 }
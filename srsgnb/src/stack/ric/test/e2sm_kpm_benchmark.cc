@@ -0,0 +1,219 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsgnb/hdr/stack/ric/e2sm_kpm.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+
+// Indications are built every granularity period, with one metrics report per period
+static const uint32_t granul_period_ms = 10;
+// ECI of the only cell, eNB ID 0x19B and cell ID 0x01
+static const uint64_t cell_id = 0x19b01;
+
+static const std::vector<std::string> cell_meas = {"RRC.ConnMean",
+                                                   "DRB.UEThpDl",
+                                                   "DRB.UEThpUl",
+                                                   "TB.TotNbrDl",
+                                                   "dl_cqi"};
+static const std::vector<std::string> ue_meas   = {"DRB.UEThpDl", "DRB.UEThpUl", "TB.TotNbrDl", "TB.ErrTotalNbrDl"};
+
+struct run_data {
+  uint32_t                  nof_ues;
+  std::chrono::microseconds metrics_latency;
+  std::chrono::microseconds indication_latency;
+};
+
+static void fill_metrics(enb_metrics_t& m, uint32_t nof_ues, uint32_t report_idx)
+{
+  m.sys.cpu_load[0] = 10 + report_idx % 50;
+  m.stack.mac.cc_info.resize(1);
+  m.stack.mac.cc_info[0].cc_rach_counter = report_idx;
+  m.stack.mac.ues.resize(nof_ues);
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    mac_ue_metrics_t& ue = m.stack.mac.ues[i];
+    ue.rnti              = 0x46 + i;
+    ue.nof_tti           = granul_period_ms;
+    ue.tx_brate          = 1000 * (i + report_idx);
+    ue.rx_brate          = 500 * (i + report_idx);
+    ue.tx_pkts           = granul_period_ms;
+    ue.tx_errors         = (i + report_idx) % 2;
+    ue.dl_cqi            = (i + report_idx) % 16;
+  }
+}
+
+static void add_meas_info(e2_sm_kpm_action_definition_format1_s& def, const std::vector<std::string>& meas_names)
+{
+  def.granul_period = granul_period_ms;
+  def.meas_info_list.resize(meas_names.size());
+  for (uint32_t i = 0; i < meas_names.size(); i++) {
+    def.meas_info_list[i].meas_type.set_meas_name().from_string(meas_names[i].c_str());
+    def.meas_info_list[i].label_info_list.resize(1);
+    def.meas_info_list[i].label_info_list[0].meas_label.no_label_present = true;
+    def.meas_info_list[i].label_info_list[0].meas_label.no_label         = meas_label_s::no_label_opts::true_value;
+  }
+}
+
+static bool admit_action(e2sm_kpm& sm, e2_sm_kpm_action_definition_s& def, E2AP_RIC_action_t& action_entry)
+{
+  srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  asn1::bit_ref                bref(buf->msg, buf->get_tailroom());
+  if (def.pack(bref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  buf->N_bytes = bref.distance_bytes();
+
+  ri_caction_to_be_setup_item_s ric_action;
+  ric_action.ric_action_id   = action_entry.ric_action_id;
+  ric_action.ric_action_type = ri_caction_type_opts::report;
+  ric_action.ric_action_definition.resize(buf->N_bytes);
+  std::copy(buf->msg, buf->msg + buf->N_bytes, ric_action.ric_action_definition.data());
+  return sm.process_ric_action_definition(ric_action, action_entry);
+}
+
+// the message must decode and encode back to the same bytes with the generic ASN.1 packer
+static bool check_ind_msg(const srsran::byte_buffer_t& msg)
+{
+  e2_sm_kpm_ind_msg_s ind_msg;
+  asn1::cbit_ref      cbref(msg.msg, msg.N_bytes);
+  if (ind_msg.unpack(cbref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+
+  srsran::unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  asn1::bit_ref                bref(buf->msg, buf->get_tailroom());
+  if (ind_msg.pack(bref) != asn1::SRSASN_SUCCESS) {
+    return false;
+  }
+  return bref.distance_bytes() == (int)msg.N_bytes and std::equal(msg.msg, msg.msg + msg.N_bytes, buf->msg);
+}
+
+int run_benchmark_scenario(uint32_t nof_ues, uint32_t nof_periods, std::vector<run_data>& run_results)
+{
+  srsran::task_scheduler task_sched;
+  e2sm_kpm               sm(srslog::fetch_basic_logger("E2SM-KPM"), &task_sched);
+  sm.set_cell_ids({cell_id});
+
+  // one action for the whole cell and one for each UE
+  std::vector<E2AP_RIC_action_t> actions(nof_ues + 1);
+  {
+    e2_sm_kpm_action_definition_s def;
+    def.ric_style_type = 1;
+    add_meas_info(def.action_definition_formats.set_action_definition_format1(), cell_meas);
+    def.action_definition_formats.action_definition_format1().cell_global_id_present = true;
+    def.action_definition_formats.action_definition_format1().cell_global_id.set_eutra_cgi().eutra_cell_id.from_number(
+        cell_id);
+    actions[0].ric_action_id = 0;
+    bool admitted            = admit_action(sm, def, actions[0]);
+    TESTASSERT(admitted);
+  }
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    e2_sm_kpm_action_definition_s          def;
+    e2_sm_kpm_action_definition_format2_s& def2 = def.action_definition_formats.set_action_definition_format2();
+    def.ric_style_type                            = 2;
+    def2.ue_id.set_gnb_du_ueid().ran_ueid_present = true;
+    def2.ue_id.gnb_du_ueid().ran_ueid.from_number(0x46 + i);
+    add_meas_info(def2.subscript_info, ue_meas);
+    actions[i + 1].ric_action_id = (i + 1) % 256;
+    bool admitted                = admit_action(sm, def, actions[i + 1]);
+    TESTASSERT(admitted);
+  }
+
+  enb_metrics_t            metrics = {};
+  std::chrono::nanoseconds metrics_time{0}, indication_time{0};
+  std::vector<uint32_t>    ind_bytes(actions.size(), 0);
+  bool                     ind_msg_ok = true;
+  for (uint32_t p = 0; p < nof_periods; p++) {
+    fill_metrics(metrics, nof_ues, p);
+
+    auto tp0 = std::chrono::steady_clock::now();
+    sm.receive_e2_metrics_callback(metrics);
+    auto tp1 = std::chrono::steady_clock::now();
+
+    // the last tick of the period collects the measurements of all actions
+    for (uint32_t t = 0; t < granul_period_ms - 1; t++) {
+      task_sched.tic();
+    }
+    auto tp2 = std::chrono::steady_clock::now();
+    task_sched.tic();
+    for (uint32_t a = 0; a < actions.size(); a++) {
+      ric_indication_t ric_indication;
+      bool             generated = sm.generate_ric_indication_content(actions[a], ric_indication);
+      TESTASSERT(generated);
+      ind_bytes[a] = ric_indication.ri_cind_msg->N_bytes;
+      if (p == 0) {
+        ind_msg_ok &= check_ind_msg(*ric_indication.ri_cind_msg);
+      }
+    }
+    auto tp3 = std::chrono::steady_clock::now();
+
+    metrics_time += tp1 - tp0;
+    indication_time += tp3 - tp2;
+  }
+  TESTASSERT(ind_bytes[0] > 0 and ind_bytes.back() > 0);
+  TESTASSERT(ind_msg_ok);
+
+  for (auto& action : actions) {
+    bool removed = sm.remove_ric_action_definition(action);
+    TESTASSERT(removed);
+  }
+
+  run_data run_result           = {};
+  run_result.nof_ues            = nof_ues;
+  run_result.metrics_latency    = std::chrono::duration_cast<std::chrono::microseconds>(metrics_time / nof_periods);
+  run_result.indication_latency = std::chrono::duration_cast<std::chrono::microseconds>(indication_time / nof_periods);
+  run_results.push_back(run_result);
+
+  return SRSRAN_SUCCESS;
+}
+
+void print_benchmark_results(const std::vector<run_data>& run_results)
+{
+  fmt::print("\n{:>8}  {:>16}  {:>19}\n", "nof_ues", "metrics_lat [us]", "indication_lat [us]");
+  for (const run_data& r : run_results) {
+    fmt::print("{:>8}  {:>16}  {:>19}\n", r.nof_ues, r.metrics_latency.count(), r.indication_latency.count());
+  }
+}
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("E2SM-KPM").set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  uint32_t max_nof_ues = 64;
+  uint32_t nof_periods = 100;
+  if (argc > 1) {
+    max_nof_ues = strtoul(argv[1], nullptr, 10);
+  }
+  if (argc > 2) {
+    nof_periods = strtoul(argv[2], nullptr, 10);
+  }
+
+  std::vector<run_data> run_results;
+  for (uint32_t nof_ues = 1; nof_ues <= max_nof_ues; nof_ues *= 4) {
+    if (run_benchmark_scenario(nof_ues, nof_periods, run_results) != SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+  print_benchmark_results(run_results);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -194,7 +194,10 @@ int rrc_nr::add_user(uint16_t rnti, uint32_t pcell_cc_idx, bool start_msg3_timer
 {
   if (users.contains(rnti) == 0) {
     // If in the ue ctor, "start_msg3_timer" is set to true, this will start the MSG3 RX TIMEOUT at ue creation
-    users.insert(rnti, std::make_unique<ue>(this, rnti, pcell_cc_idx, start_msg3_timer));
+    if (not users.insert(rnti, std::make_unique<ue>(this, rnti, pcell_cc_idx, start_msg3_timer))) {
+      logger.error("Adding user rnti=0x%x - No space left for the user", rnti);
+      return SRSRAN_ERROR;
+    }
     rlc->add_user(rnti);
     pdcp->add_user(rnti);
     logger.info("Added new user rnti=0x%x", rnti);
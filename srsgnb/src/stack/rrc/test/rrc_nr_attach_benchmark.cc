@@ -0,0 +1,453 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rrc_nr_test_helpers.h"
+#include "srsgnb/hdr/stack/ngap/ngap.h"
+#include "srsgnb/hdr/stack/rrc/rrc_nr_config_utils.h"
+#include "srsran/common/bearer_manager.h"
+#include "srsran/common/network_utils.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+// A population of emulated UEs attaches to the gNB RRC and NGAP, with PHY, MAC, RLC and PDCP replaced by dummies.
+// Each UE sends the RRCSetupRequest and, once it gets the RRCSetup, the RRCSetupComplete carrying a NAS Registration
+// Request, which makes the NGAP send the Initial UE Message to an AMF stand-in over SCTP. The AMF releases the UE
+// right away, so that the UE contexts don't pile up. New UEs start as soon as the number of attaches in course is below
+// the concurrency limit
+
+using namespace srsenb;
+using namespace asn1::rrc_nr;
+
+using bench_clock = std::chrono::steady_clock;
+
+static const char*    amf_addr_str    = "127.0.0.1";
+static const uint32_t amf_port        = 38412;
+static const uint16_t first_rnti      = 0x4601;
+static const uint32_t nof_rntis       = 0xb000;
+static const uint32_t max_concurrency = SRSENB_MAX_UES; // The RRC holds at most SRSENB_MAX_UES UEs
+static const uint32_t amf_timeout_ms  = 2000;
+
+// NAS Registration Request. The UE index is written in the last bytes of the MSIN, so that the AMF can tell the UEs
+// apart
+static const uint8_t nas_reg_req[] = {0x7e, 0x00, 0x41, 0x79, 0x00, 0x0d, 0x01, 0x00, 0xf1, 0x10, 0x00, 0x00,
+                                      0x00, 0x00, 0x10, 0x32, 0x54, 0x76, 0x98, 0x2e, 0x02, 0xf0, 0xf0};
+static const size_t  nas_ue_idx_pos = 15;
+
+static const uint8_t ng_setup_resp[] = {
+    0x20, 0x15, 0x00, 0x55, 0x00, 0x00, 0x04, 0x00, 0x01, 0x00, 0x31, 0x17, 0x00, 0x61, 0x6d, 0x61, 0x72, 0x69,
+    0x73, 0x6f, 0x66, 0x74, 0x2e, 0x61, 0x6d, 0x66, 0x2e, 0x35, 0x67, 0x63, 0x2e, 0x6d, 0x6e, 0x63, 0x30, 0x30,
+    0x31, 0x2e, 0x6d, 0x63, 0x63, 0x30, 0x30, 0x31, 0x2e, 0x33, 0x67, 0x70, 0x70, 0x6e, 0x65, 0x74, 0x77, 0x6f,
+    0x72, 0x6b, 0x2e, 0x6f, 0x72, 0x67, 0x00, 0x60, 0x00, 0x08, 0x00, 0x00, 0x00, 0xf1, 0x10, 0x80, 0x01, 0x01,
+    0x00, 0x56, 0x40, 0x01, 0x32, 0x00, 0x50, 0x00, 0x08, 0x00, 0x00, 0xf1, 0x10, 0x00, 0x00, 0x00, 0x08};
+
+/// The AMF messages are fed to the NGAP from the stack thread, so the rx socket is not needed
+struct rx_socket_dummy : public srsran::socket_manager_itf {
+  rx_socket_dummy() : srsran::socket_manager_itf(srslog::fetch_basic_logger("TEST")) {}
+  bool add_socket_handler(int fd, recv_callback_t handler) final { return true; }
+  bool remove_socket(int fd) final { return true; }
+};
+
+/**
+ * AMF stand-in, running in its own thread. It answers the NG Setup Request and replies to each Initial UE Message with
+ * a UE Context Release Command. The replies are queued, together with the time the gNB message was received, for the
+ * stack thread to pass them to the NGAP.
+ */
+class amf_standin
+{
+public:
+  static const uint32_t no_ue = std::numeric_limits<uint32_t>::max();
+
+  struct event_t {
+    uint32_t                     ue_idx = no_ue;
+    bench_clock::time_point      rx_time;
+    srsran::unique_byte_buffer_t pdu;
+  };
+
+  amf_standin()
+  {
+    using namespace srsran::net_utils;
+    sockaddr_in addr = {};
+    set_sockaddr(&addr, amf_addr_str, amf_port);
+    fd = open_socket(addr_family::ipv4, socket_type::seqpacket, protocol_type::SCTP);
+    bool bound = fd > 0 and bind_addr(fd, addr);
+    TESTASSERT(bound);
+    int success = listen(fd, SOMAXCONN);
+    srsran_assert(success == 0, "Failed to listen to incoming SCTP connections");
+
+    // The thread checks regularly whether it has to stop
+    timeval timeout = {0, 100000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    thread = std::thread([this]() { run(); });
+  }
+  ~amf_standin()
+  {
+    running = false;
+    thread.join();
+    close(fd);
+  }
+
+  /// Waits for the next event. Returns false on timeout
+  bool pop(event_t& ev, std::chrono::milliseconds timeout)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (not cvar.wait_for(lock, timeout, [this]() { return not events.empty(); })) {
+      return false;
+    }
+    ev = std::move(events.front());
+    events.pop_front();
+    return true;
+  }
+  bool try_pop(event_t& ev) { return pop(ev, std::chrono::milliseconds(0)); }
+
+  uint32_t nof_release_completes() const { return nof_rel_completes; }
+
+private:
+  void run()
+  {
+    while (running) {
+      srsran::unique_byte_buffer_t pdu     = srsran::make_byte_buffer();
+      sockaddr_in                  from    = {};
+      socklen_t                    fromlen = sizeof(from);
+      sctp_sndrcvinfo              sri     = {};
+      int                          flags   = 0;
+      ssize_t n_recv = sctp_recvmsg(fd, pdu->msg, pdu->get_tailroom(), (struct sockaddr*)&from, &fromlen, &sri, &flags);
+      if (n_recv <= 0 or (flags & MSG_NOTIFICATION) != 0) {
+        continue;
+      }
+      pdu->N_bytes = n_recv;
+      handle_rx_msg(*pdu, bench_clock::now());
+    }
+  }
+
+  void handle_rx_msg(const srsran::byte_buffer_t& pdu, bench_clock::time_point rx_time)
+  {
+    asn1::ngap::ngap_pdu_c rx_pdu;
+    asn1::cbit_ref         bref(pdu.msg, pdu.N_bytes);
+    if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+      srsran::console_stderr("AMF: Failed to unpack NGAP PDU\n");
+      return;
+    }
+
+    event_t ev;
+    ev.rx_time = rx_time;
+    ev.pdu     = srsran::make_byte_buffer();
+    if (rx_pdu.type().value == asn1::ngap::ngap_pdu_c::types_opts::successful_outcome) {
+      if (rx_pdu.successful_outcome().proc_code == ASN1_NGAP_ID_UE_CONTEXT_RELEASE) {
+        nof_rel_completes++;
+      }
+      return;
+    }
+    if (rx_pdu.type().value != asn1::ngap::ngap_pdu_c::types_opts::init_msg) {
+      return;
+    }
+    switch (rx_pdu.init_msg().proc_code) {
+      case ASN1_NGAP_ID_NG_SETUP:
+        memcpy(ev.pdu->msg, ng_setup_resp, sizeof(ng_setup_resp));
+        ev.pdu->N_bytes = sizeof(ng_setup_resp);
+        break;
+      case ASN1_NGAP_ID_INIT_UE_MSG: {
+        const asn1::ngap::init_ue_msg_s& init_ue = rx_pdu.init_msg().value.init_ue_msg();
+        const auto&                      nas     = init_ue->nas_pdu.value;
+        if (nas.size() != sizeof(nas_reg_req)) {
+          srsran::console_stderr("AMF: Unexpected NAS PDU\n");
+          return;
+        }
+        memcpy(&ev.ue_idx, &nas[nas_ue_idx_pos], sizeof(ev.ue_idx));
+
+        asn1::ngap::ngap_pdu_c tx_pdu;
+        tx_pdu.set_init_msg().load_info_obj(ASN1_NGAP_ID_UE_CONTEXT_RELEASE);
+        asn1::ngap::ue_context_release_cmd_s& release = tx_pdu.init_msg().value.ue_context_release_cmd();
+        asn1::ngap::ue_ngap_id_pair_s&        ids     = release->ue_ngap_ids.value.set_ue_ngap_id_pair();
+        ids.amf_ue_ngap_id                            = next_amf_ue_ngap_id++;
+        ids.ran_ue_ngap_id                            = init_ue->ran_ue_ngap_id.value.value;
+        release->cause.value.set_nas().value          = asn1::ngap::cause_nas_opts::normal_release;
+
+        asn1::bit_ref     tx_bref(ev.pdu->msg, ev.pdu->get_tailroom());
+        asn1::SRSASN_CODE ret = tx_pdu.pack(tx_bref);
+        TESTASSERT(ret == asn1::SRSASN_SUCCESS);
+        ev.pdu->N_bytes = tx_bref.distance_bytes();
+      } break;
+      default:
+        return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      events.push_back(std::move(ev));
+    }
+    cvar.notify_one();
+  }
+
+  int                   fd = -1;
+  std::atomic<bool>     running{true};
+  std::atomic<uint32_t> nof_rel_completes{0};
+  uint64_t              next_amf_ue_ngap_id = 1;
+  std::thread           thread;
+
+  std::mutex              mutex;
+  std::condition_variable cvar;
+  std::deque<event_t>     events;
+};
+
+/// Counts the UEs removed by the RRC, which happens some TTIs after the RRC Release
+class mac_nr_rem_counter : public mac_nr_dummy
+{
+public:
+  int remove_ue(uint16_t rnti) override
+  {
+    nof_removed++;
+    return SRSRAN_SUCCESS;
+  }
+
+  uint32_t nof_removed = 0;
+};
+
+struct ue_stats {
+  bench_clock::time_point  start_time;
+  std::chrono::nanoseconds setup_latency{0};  ///< RRCSetupRequest -> RRCSetup
+  std::chrono::nanoseconds attach_latency{0}; ///< RRCSetupRequest -> Initial UE Message received by the AMF
+};
+
+template <typename UlMsg>
+static srsran::unique_byte_buffer_t pack_ul_msg(const UlMsg& msg)
+{
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  asn1::bit_ref                bref{pdu->data(), pdu->get_tailroom()};
+  asn1::SRSASN_CODE            ret = msg.pack(bref);
+  TESTASSERT(ret == asn1::SRSASN_SUCCESS);
+  pdu->N_bytes = bref.distance_bytes();
+  return pdu;
+}
+
+/// Runs the UE side of the RRC connection establishment, up to the RRCSetupComplete
+static int start_ue_attach(rrc_nr& rrc_obj, rlc_nr_rrc_tester& rlc, uint32_t ue_idx, ue_stats& ue)
+{
+  uint16_t rnti = first_rnti + ue_idx % nof_rntis;
+
+  ul_ccch_msg_s            setup_req_msg;
+  rrc_setup_request_ies_s& setup_req  = setup_req_msg.msg.set_c1().set_rrc_setup_request().rrc_setup_request;
+  setup_req.establishment_cause.value = establishment_cause_opts::mo_sig;
+  setup_req.ue_id.set_random_value().from_number(ue_idx);
+  srsran::unique_byte_buffer_t pdu = pack_ul_msg(setup_req_msg);
+
+  ue.start_time = bench_clock::now();
+  if (rrc_obj.add_user(rnti, 0) != SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  rlc.last_sdu_rnti = SRSRAN_INVALID_RNTI;
+  rrc_obj.write_pdu(rnti, srsran::srb_to_lcid(srsran::nr_srb::srb0), std::move(pdu));
+  if (rlc.last_sdu_rnti != rnti) {
+    return SRSRAN_ERROR;
+  }
+  ue.setup_latency = bench_clock::now() - ue.start_time;
+
+  dl_ccch_msg_s  dl_ccch_msg;
+  asn1::cbit_ref bref{rlc.last_sdu->data(), rlc.last_sdu->size()};
+  if (dl_ccch_msg.unpack(bref) != asn1::SRSASN_SUCCESS or
+      dl_ccch_msg.msg.type().value != dl_ccch_msg_type_c::types_opts::c1 or
+      dl_ccch_msg.msg.c1().type().value != dl_ccch_msg_type_c::c1_c_::types_opts::rrc_setup) {
+    return SRSRAN_ERROR;
+  }
+
+  ul_dcch_msg_s             ul_dcch_msg;
+  rrc_setup_complete_s&     complete     = ul_dcch_msg.msg.set_c1().set_rrc_setup_complete();
+  complete.rrc_transaction_id            = dl_ccch_msg.msg.c1().rrc_setup().rrc_transaction_id;
+  rrc_setup_complete_ies_s& complete_ies = complete.crit_exts.set_rrc_setup_complete();
+  complete_ies.sel_plmn_id               = 1;
+  complete_ies.ded_nas_msg.resize(sizeof(nas_reg_req));
+  memcpy(complete_ies.ded_nas_msg.data(), nas_reg_req, sizeof(nas_reg_req));
+  memcpy(&complete_ies.ded_nas_msg[nas_ue_idx_pos], &ue_idx, sizeof(ue_idx));
+  rrc_obj.write_pdu(rnti, srsran::srb_to_lcid(srsran::nr_srb::srb1), pack_ul_msg(ul_dcch_msg));
+
+  return SRSRAN_SUCCESS;
+}
+
+static void print_latencies(const char* name, std::vector<std::chrono::nanoseconds> latencies)
+{
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) {
+    size_t idx = std::min((size_t)(p * latencies.size()), latencies.size() - 1);
+    return latencies[idx].count() / 1000.0;
+  };
+  fmt::print("{:>16}  {:>10.1f}  {:>10.1f}  {:>10.1f}  {:>10.1f}\n",
+             name,
+             percentile(0.5),
+             percentile(0.9),
+             percentile(0.99),
+             latencies.back().count() / 1000.0);
+}
+
+int run_benchmark(uint32_t nof_ues, uint32_t concurrency)
+{
+  srsran::task_scheduler task_sched;
+  phy_nr_dummy           phy_obj;
+  mac_nr_rem_counter     mac_obj;
+  rlc_nr_rrc_tester      rlc_obj;
+  pdcp_nr_rrc_tester     pdcp_obj;
+  enb_bearer_manager     bearer_mapper;
+  rx_socket_dummy        rx_sockets;
+  amf_standin            amf;
+
+  ngap   ngap_obj(&task_sched, srslog::fetch_basic_logger("NGAP"), &rx_sockets);
+  rrc_nr rrc_obj(&task_sched);
+
+  // set cfg
+  asn1::rrc_nr::rlc_cfg_c rlc_cfg;
+  rlc_cfg.set_um_bi_dir();
+  rlc_cfg.um_bi_dir().dl_um_rlc.t_reassembly = t_reassembly_e::ms50;
+
+  rrc_nr_cfg_t rrc_cfg_nr = {};
+  rrc_cfg_nr.cell_list.emplace_back();
+  generate_default_nr_cell(rrc_cfg_nr.cell_list[0]);
+  rrc_cfg_nr.cell_list[0].phy_cell.carrier.pci     = 500;
+  rrc_cfg_nr.cell_list[0].dl_arfcn                 = 368500;
+  rrc_cfg_nr.cell_list[0].band                     = 3;
+  rrc_cfg_nr.cell_list[0].phy_cell.carrier.nof_prb = 52;
+  rrc_cfg_nr.cell_list[0].duplex_mode              = SRSRAN_DUPLEX_MODE_FDD;
+  rrc_cfg_nr.is_standalone                         = true;
+  rrc_cfg_nr.enb_id                                = 0x19B;
+  rrc_cfg_nr.five_qi_cfg[9].configured             = true;
+  rrc_cfg_nr.five_qi_cfg[9].rlc_cfg                = rlc_cfg;
+  rrc_cfg_nr.five_qi_cfg[9].pdcp_cfg               = {};
+  srsran::string_to_mcc("001", &rrc_cfg_nr.mcc);
+  srsran::string_to_mnc("01", &rrc_cfg_nr.mnc);
+  set_derived_nr_cell_params(rrc_cfg_nr.is_standalone, rrc_cfg_nr.cell_list[0]);
+
+  ngap_args_t ngap_args   = {};
+  ngap_args.cell_id       = 0x01;
+  ngap_args.gnb_id        = 0x19B;
+  ngap_args.ngc_bind_addr = "127.0.0.100";
+  ngap_args.tac           = 7;
+  ngap_args.gtp_bind_addr = "127.0.0.100";
+  ngap_args.amf_addr      = amf_addr_str;
+  ngap_args.gnb_name      = "srsgnb01";
+  srsran::string_to_mcc("001", &ngap_args.mcc);
+  srsran::string_to_mnc("01", &ngap_args.mnc);
+
+  if (rrc_obj.init(rrc_cfg_nr, &phy_obj, &mac_obj, &rlc_obj, &pdcp_obj, &ngap_obj, nullptr, bearer_mapper, nullptr) !=
+          SRSRAN_SUCCESS or
+      ngap_obj.init(ngap_args, &rrc_obj, nullptr) != SRSRAN_SUCCESS) {
+    srsran::console_stderr("Failed to initialize the RRC and NGAP\n");
+    return SRSRAN_ERROR;
+  }
+
+  sockaddr_in     amf_sockaddr = {};
+  sctp_sndrcvinfo rcvinfo      = {};
+  int             flags        = 0;
+  srsran::net_utils::set_sockaddr(&amf_sockaddr, amf_addr_str, amf_port);
+
+  // NG Setup
+  amf_standin::event_t ev;
+  if (not amf.pop(ev, std::chrono::milliseconds(amf_timeout_ms))) {
+    srsran::console_stderr("Timeout waiting for the NG Setup\n");
+    return SRSRAN_ERROR;
+  }
+  ngap_obj.handle_amf_rx_msg(std::move(ev.pdu), amf_sockaddr, rcvinfo, flags);
+  TESTASSERT(ngap_obj.is_amf_connected());
+
+  std::vector<ue_stats> ues(nof_ues);
+  uint32_t              nof_started = 0, nof_attached = 0;
+  auto                  tp_start = bench_clock::now();
+  while (nof_attached < nof_ues) {
+    // A UE only starts once the RRC has room for it. The released UEs are removed in order, so the RNTI of the new UE
+    // is free too
+    for (; nof_started < nof_ues and nof_started - nof_attached < concurrency and
+           nof_started - mac_obj.nof_removed < SRSENB_MAX_UES;
+         ++nof_started) {
+      if (start_ue_attach(rrc_obj, rlc_obj, nof_started, ues[nof_started]) != SRSRAN_SUCCESS) {
+        srsran::console_stderr("UE %d failed the RRC connection establishment\n", nof_started);
+        return SRSRAN_ERROR;
+      }
+    }
+
+    // The AMF releases the attached UEs. When all the started UEs are attached, the TTIs run until the RRC removes the
+    // released ones
+    if (nof_started > nof_attached) {
+      if (not amf.pop(ev, std::chrono::milliseconds(amf_timeout_ms))) {
+        srsran::console_stderr("Timeout waiting for the Initial UE Messages (%d/%d)\n", nof_attached, nof_started);
+        return SRSRAN_ERROR;
+      }
+      do {
+        TESTASSERT(ev.ue_idx < nof_started);
+        ues[ev.ue_idx].attach_latency = ev.rx_time - ues[ev.ue_idx].start_time;
+        nof_attached++;
+        ngap_obj.handle_amf_rx_msg(std::move(ev.pdu), amf_sockaddr, rcvinfo, flags);
+      } while (amf.try_pop(ev));
+    }
+
+    task_sched.tic();
+    task_sched.run_pending_tasks();
+  }
+  auto tp_end = bench_clock::now();
+
+  // Wait for the last UE Context Release Completes
+  auto tp_timeout = tp_end + std::chrono::milliseconds(amf_timeout_ms);
+  while (amf.nof_release_completes() < nof_ues and bench_clock::now() < tp_timeout) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  TESTASSERT(amf.nof_release_completes() == nof_ues);
+
+  std::vector<std::chrono::nanoseconds> setup_latencies, attach_latencies;
+  for (const ue_stats& ue : ues) {
+    setup_latencies.push_back(ue.setup_latency);
+    attach_latencies.push_back(ue.attach_latency);
+  }
+  double duration_s = std::chrono::duration<double>(tp_end - tp_start).count();
+
+  fmt::print("\n{:>7}  {:>11}  {:>12}  {:>13}\n", "nof_ues", "concurrency", "duration [s]", "procedures/s");
+  fmt::print("{:>7}  {:>11}  {:>12.3f}  {:>13.1f}\n", nof_ues, concurrency, duration_s, nof_ues / duration_s);
+  fmt::print("\n{:>16}  {:>10}  {:>10}  {:>10}  {:>10}\n", "latency [us]", "p50", "p90", "p99", "max");
+  print_latencies("RRCSetup", setup_latencies);
+  print_latencies("InitialUEMessage", attach_latencies);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("RRC-NR").set_level(srslog::basic_levels::none);
+  srslog::fetch_basic_logger("NGAP").set_level(srslog::basic_levels::none);
+  srslog::init();
+
+  uint32_t nof_ues     = 2000;
+  uint32_t concurrency = 32;
+  if (argc > 1) {
+    nof_ues = strtoul(argv[1], nullptr, 10);
+  }
+  if (argc > 2) {
+    concurrency = strtoul(argv[2], nullptr, 10);
+  }
+  if (nof_ues == 0 or concurrency == 0 or concurrency > max_concurrency) {
+    fmt::print("Usage: {} [nof_ues] [concurrency (1-{})]\n", argv[0], max_concurrency);
+    return SRSRAN_ERROR;
+  }
+
+  int ret = run_benchmark(nof_ues, concurrency);
+
+  srslog::flush();
+  return ret;
+}
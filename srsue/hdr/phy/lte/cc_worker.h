@@ -32,7 +32,13 @@ namespace lte {
 class cc_worker
 {
 public:
-  cc_worker(uint32_t cc_idx, uint32_t max_prb, phy_common* phy, srslog::basic_logger& logger);
+  /// A worker created with a front-end serves the UE ue_idx from the subframes received and processed by the front-end
+  cc_worker(uint32_t              cc_idx,
+            uint32_t              max_prb,
+            phy_common*           phy,
+            srslog::basic_logger& logger,
+            uint32_t              ue_idx    = 0,
+            cc_worker*            front_end = nullptr);
   ~cc_worker();
 
   /* Functions used by main PHY thread */
@@ -58,6 +64,10 @@ public:
   bool work_dl_mbsfn(srsran_mbsfn_cfg_t mbsfn_cfg);
   bool work_ul(srsran_uci_data_t* uci_data);
 
+  /// Decodes the DL of all the UEs sharing the front-end of this worker, the first one being this worker
+  bool work_dl_multi_ue(const std::vector<cc_worker*>& ue_workers);
+  void decode_phich();
+
   int read_ce_abs(float* ce_abs, uint32_t tx_antenna, uint32_t rx_antenna);
   int read_pdsch_d(cf_t* pdsch_d);
 
@@ -76,15 +86,36 @@ private:
                            mac_interface_phy_lte::mac_grant_ul_t* mac_grant);
 
   /* Methods for DL... */
-  int decode_pdcch_ul();
-  int decode_pdcch_dl();
+  int  decode_pdcch_ul();
+  int  decode_pdcch_dl();
+  bool new_dl_grant(srsran_dci_dl_t* dci_dl, mac_interface_phy_lte::mac_grant_dl_t* mac_grant);
 
-  void decode_phich();
   int  decode_pdsch(srsran_pdsch_ack_resource_t            ack_resource,
                     mac_interface_phy_lte::tb_action_dl_t* action,
                     bool                                   acks[SRSRAN_MAX_CODEWORDS]);
+  bool prepare_pdsch(mac_interface_phy_lte::tb_action_dl_t* action,
+                     bool                                   tb_enable[SRSRAN_MAX_CODEWORDS],
+                     uint8_t*                               payload[SRSRAN_MAX_CODEWORDS]);
+  void process_pdsch_result(srsran_pdsch_ack_resource_t            ack_resource,
+                            mac_interface_phy_lte::tb_action_dl_t* action,
+                            bool                                   tb_enable[SRSRAN_MAX_CODEWORDS],
+                            bool                                   decode_enable,
+                            srsran_pdsch_res_t                     pdsch_dec[SRSRAN_MAX_CODEWORDS],
+                            bool                                   mac_acks[SRSRAN_MAX_CODEWORDS]);
   int  decode_pmch(mac_interface_phy_lte::tb_action_dl_t* action, srsran_mbsfn_cfg_t* mbsfn_cfg);
   void new_mch_dl(mac_interface_phy_lte::tb_action_dl_t*);
+
+  /* Methods for the DL of several UEs */
+  void       set_multi_ue_user(srsran_ue_dl_user_t* user, bool is_active);
+  void       end_multi_ue_user(srsran_ue_dl_user_t* user);
+  static int new_dl_grant_multi_ue(void*               arg,
+                                   srsran_dl_sf_cfg_t* sf,
+                                   srsran_dci_dl_t*    dci_dl,
+                                   srsran_pdsch_cfg_t* pdsch_cfg,
+                                   uint8_t*            data[SRSRAN_MAX_CODEWORDS]);
+  int        handle_dl_grant_multi_ue(srsran_dci_dl_t*    dci_dl,
+                                      srsran_pdsch_cfg_t* pdsch_cfg,
+                                      uint8_t*            data[SRSRAN_MAX_CODEWORDS]);
   /* Methods for UL */
   bool     encode_uplink(mac_interface_phy_lte::tb_action_ul_t* action, srsran_uci_data_t* uci_data);
   void     set_uci_sr(srsran_uci_data_t* uci_data);
@@ -94,6 +125,7 @@ private:
 
   /* Common objects */
   phy_common*           phy = nullptr;
+  phy_common::ue_state* ue  = nullptr;
   srslog::basic_logger& logger;
 
   srsran_cell_t      cell      = {};
@@ -109,11 +141,23 @@ private:
   uint8_t                mch_payload_buffer[mch_payload_buffer_sz];
   srsran_softbuffer_rx_t mch_softbuffer = {};
 
-  /* Objects for DL */
-  srsran_ue_dl_t     ue_dl     = {};
+  /* Objects for DL, ue_dl points to the object of the front-end worker when it is shared */
+  srsran_ue_dl_t     ue_dl_obj = {};
+  srsran_ue_dl_t*    ue_dl     = nullptr;
   srsran_ue_dl_cfg_t ue_dl_cfg = {};
   srsran_pmch_cfg_t  pmch_cfg  = {};
 
+  /* DL grant of the current subframe when the DL of several UEs is decoded at once */
+  struct multi_ue_dl_t {
+    bool                                  present                         = false;
+    bool                                  decode_enable                   = false;
+    bool                                  tb_enable[SRSRAN_MAX_CODEWORDS] = {};
+    srsran_pdsch_ack_resource_t           ack_resource                    = {};
+    mac_interface_phy_lte::mac_grant_dl_t mac_grant                       = {};
+    mac_interface_phy_lte::tb_action_dl_t action                          = {};
+  } multi_ue_dl;
+  std::vector<srsran_ue_dl_user_t> multi_ue_users;
+
   srsran_chest_dl_cfg_t chest_mbsfn_cfg   = {};
   srsran_chest_dl_cfg_t chest_default_cfg = {};
 
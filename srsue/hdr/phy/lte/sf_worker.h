@@ -52,11 +52,11 @@ public:
   cf_t*    get_buffer(uint32_t cc_idx, uint32_t antenna_idx);
   uint32_t get_buffer_len();
   void     set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
-  void     set_prach(cf_t* prach_ptr, float prach_power);
+  void     set_prach(cf_t* prach_ptr, float prach_power, uint32_t ue_idx = 0);
   void     set_cfo_nolock(const uint32_t& cc_idx, float cfo);
 
   void set_tdd_config_nolock(srsran_tdd_config_t config);
-  void set_config_nolock(uint32_t cc_idx, const srsran::phy_cfg_t& phy_cfg);
+  void set_config_nolock(uint32_t cc_idx, const srsran::phy_cfg_t& phy_cfg, uint32_t ue_idx = 0);
 
   ///< Methods for plotting called from GUI thread
   int      read_ce_abs(float* ce_abs, uint32_t tx_antenna, uint32_t rx_antenna);
@@ -80,9 +80,14 @@ private:
 
   void update_measurements();
   void reset_uci(srsran_uci_data_t* uci_data);
+  bool work_ul_multi_ue(bool ul_sf, uint32_t nof_samples);
 
   std::vector<cc_worker*> cc_workers;
 
+  // PCell workers of all the UEs sharing the PHY, ue_workers[0] is cc_workers[0]. Empty with a single UE
+  std::vector<cc_worker*> ue_workers;
+  cf_t*                   tx_mix_buffer = nullptr;
+
   phy_common* phy = nullptr;
 
   srslog::basic_logger& logger;
@@ -94,8 +99,8 @@ private:
   std::condition_variable cell_init_cond;
   bool                    cell_initiated = false;
 
-  cf_t* prach_ptr   = nullptr;
-  float prach_power = 0;
+  std::vector<cf_t*> prach_ptr;
+  std::vector<float> prach_power;
 
   srsran::phy_common_interface::worker_context_t context = {};
 };
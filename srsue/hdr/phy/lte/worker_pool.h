@@ -46,8 +46,8 @@ private:
     bool                     is_pending(uint32_t sf_idx);
     const srsran::phy_cfg_t& get_cfg(uint32_t sf_idx);
   };
-  std::mutex                                       phy_cfg_mutex; ///< Protects configuration stash
-  std::array<phy_cfg_stash_t, SRSRAN_MAX_CARRIERS> phy_cfg_stash; ///< Stores the latest worker configuration
+  std::mutex                   phy_cfg_mutex; ///< Protects configuration stash
+  std::vector<phy_cfg_stash_t> phy_cfg_stash; ///< Latest worker configuration, SRSRAN_MAX_CARRIERS entries per UE
 
 public:
   sf_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
@@ -64,8 +64,9 @@ public:
    * applied to the sf_worker at the time it is reserved.
    * @param cc_idx CC index
    * @param phy_cfg Actual PHY configuration
+   * @param ue_idx Index of the UE sharing the PHY
    */
-  void set_config(uint32_t cc_idx, const srsran::phy_cfg_t& phy_cfg);
+  void set_config(uint32_t cc_idx, const srsran::phy_cfg_t& phy_cfg, uint32_t ue_idx = 0);
 };
 
 } // namespace lte
@@ -438,6 +438,16 @@ public:
     dl_metrics.set(m);
   }
 
+  /**
+   * @brief Accumulates the LDPC decoder statistics of a given PDSCH transmission, successful or not
+   * @param tb Transport block decoding result
+   */
+  void set_dl_fec_metrics(const srsran_sch_tb_res_nr_t& tb)
+  {
+    std::lock_guard<std::mutex> lock(metrics_mutex);
+    dl_metrics.add_fec(tb);
+  }
+
   /**
    * @brief Sets UL metrics of a given PUSCH transmission
    * @param m Metrics object
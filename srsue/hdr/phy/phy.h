@@ -41,6 +41,53 @@ namespace srsue {
 
 typedef _Complex float cf_t;
 
+class phy;
+
+/**
+ * PHY interface of the stack of an additional UE sharing the EUTRA PHY (see phy_args_t::nof_ue). The PRACH, the SR,
+ * the TA, the RAR grant and the dedicated configuration belong to the UE. The cell is searched, selected and measured
+ * by the first UE, the cell search and selection of this UE complete once the first UE camps on a cell.
+ */
+class phy_ue final : public phy_interface_stack_lte
+{
+public:
+  phy_ue(phy& parent_, uint32_t ue_idx_) : parent(parent_), ue_idx(ue_idx_) {}
+
+  /********** RRC INTERFACE ********************/
+  bool cell_search(int earfcn) final;
+  bool cell_select(phy_cell_t cell) final;
+  bool cell_is_camping() final;
+  bool set_config(const srsran::phy_cfg_t& config, uint32_t cc_idx) final;
+
+  // Carrier aggregation, MBMS and the measurements are not supported for the additional UEs
+  bool set_scell(srsran_cell_t cell_info, uint32_t cc_idx, uint32_t earfcn) final { return false; }
+  void set_config_tdd(srsran_tdd_config_t& tdd_config) final {}
+  void set_config_mbsfn_sib2(srsran::mbsfn_sf_cfg_t* cfg_list, uint32_t nof_cfgs) final {}
+  void set_config_mbsfn_sib13(const srsran::sib13_t& sib13) final {}
+  void set_config_mbsfn_mcch(const srsran::mcch_msg_t& mcch) final {}
+  void deactivate_scells() final {}
+  void set_cells_to_meas(uint32_t earfcn, const std::set<uint32_t>& pci) final {}
+  void meas_stop() final {}
+
+  /********** MAC INTERFACE ********************/
+  void         prach_send(uint32_t preamble_idx, int allowed_subframe, float target_power_dbm, float ta_base_sec) final;
+  prach_info_t prach_get_info() final;
+  void         sr_send() final;
+  int          sr_last_tx_tti() final;
+  void         set_timeadv_rar(uint32_t tti, uint32_t ta_cmd) final;
+  void         set_timeadv(uint32_t tti, uint32_t ta_cmd) final;
+  void         set_activation_deactivation_scell(uint32_t cmd, uint32_t tti) final {}
+  void         set_rar_grant(uint8_t grant_payload[SRSRAN_RAR_GRANT_LEN], uint16_t rnti) final;
+  void         set_mch_period_stop(uint32_t stop) final {}
+  uint32_t     get_current_tti() final;
+  float        get_phr() final;
+  float        get_pathloss_db() final;
+
+private:
+  phy&     parent;
+  uint32_t ue_idx = 0;
+};
+
 class phy final : public ue_phy_base,
                   public phy_interface_stack_lte,
                   public phy_interface_stack_nr,
@@ -55,7 +102,6 @@ public:
     nr_workers(logger_phy, MAX_WORKERS),
     common(logger_phy),
     sfsync(logger_phy, logger_phy_lib),
-    prach_buffer(logger_phy),
     thread("PHY")
   {}
 
@@ -64,6 +110,14 @@ public:
   // Init for LTE PHYs
   int init(const phy_args_t& args_, stack_interface_phy_lte* stack_, srsran::radio_interface_phy* radio_);
 
+  // Init for LTE PHYs shared by several UEs, one stack per UE. The first one uses this object as PHY interface
+  int init(const phy_args_t&                            args_,
+           const std::vector<stack_interface_phy_lte*>& stacks_,
+           srsran::radio_interface_phy*                 radio_);
+
+  // PHY interface of the stack of the UE ue_idx, available after init
+  phy_interface_stack_lte* get_ue_phy(uint32_t ue_idx);
+
   void stop() final;
 
   void wait_initialize() final;
@@ -162,6 +216,18 @@ public:
   bool           start_cell_select(const cell_select_args_t& req) override { return false; };
 
 private:
+  // Per-UE procedures, the interface methods apply them to the first UE and phy_ue to the others
+  friend class phy_ue;
+  void prach_send(uint32_t ue_idx,
+                  uint32_t preamble_idx,
+                  int      allowed_subframe,
+                  float    target_power_dbm,
+                  float    ta_base_sec);
+  bool set_config(const srsran::phy_cfg_t& config_, uint32_t cc_idx, uint32_t ue_idx);
+  bool cell_search_ue(uint32_t ue_idx);
+  bool cell_select_ue(uint32_t ue_idx, phy_cell_t cell);
+  void complete_ue_cell_procedures(bool camping);
+
   void run_thread() final;
   void configure_prach_params();
   void reset();
@@ -186,7 +252,16 @@ private:
   nr::worker_pool  nr_workers;
   phy_common       common;
   sync             sfsync;
-  prach            prach_buffer;
+
+  // Stack, PHY interface and PRACH of every UE sharing the PHY, index 0 is the first UE
+  std::vector<stack_interface_phy_lte*> stacks;
+  std::vector<std::unique_ptr<phy_ue> > ue_phys;
+  std::vector<std::unique_ptr<prach> >  prach_buffers;
+
+  // Cell search or selection of the additional UEs waiting for the first UE to camp
+  enum ue_cell_proc_t { UE_CELL_PROC_NONE = 0, UE_CELL_PROC_SEARCH, UE_CELL_PROC_SELECT };
+  std::mutex                  ue_cell_mutex;
+  std::vector<ue_cell_proc_t> ue_cell_procs;
 
   srsran_prach_cfg_t  prach_cfg  = {};
   srsran_tdd_config_t tdd_config = {};
@@ -93,8 +93,7 @@ class phy_common : public srsran::phy_common_interface
 {
 public:
   /* Common variables used by all phy workers */
-  phy_args_t*              args  = nullptr;
-  stack_interface_phy_lte* stack = nullptr;
+  phy_args_t* args = nullptr;
 
   srsran::phy_cfg_mbsfn_t mbsfn_config = {};
 
@@ -103,81 +102,8 @@ public:
   // Secondary serving cell states
   scell::state cell_state;
 
-  // Save last TBS for uplink (mcs >= 28)
-  srsran_ra_tb_t last_ul_tb[SRSRAN_MAX_HARQ_PROC][SRSRAN_MAX_CARRIERS] = {};
-
-  // Save last TBS for DL (Format1C)
-  int last_dl_tbs[SRSRAN_MAX_HARQ_PROC][SRSRAN_MAX_CARRIERS][SRSRAN_MAX_CODEWORDS] = {};
-
   srsran::tti_semaphore<void*> semaphore;
 
-  // Time Aligment Controller, internal thread safe
-  ta_control ta;
-
-  // Last reported RI
-  std::atomic<uint32_t> last_ri = {0};
-
-  phy_common(srslog::basic_logger& logger);
-
-  ~phy_common();
-
-  void init(phy_args_t*                  args,
-            srsran::radio_interface_phy* _radio,
-            stack_interface_phy_lte*     _stack,
-            rsrp_insync_itf*             rsrp_insync);
-
-  uint32_t ul_pidof(uint32_t tti, srsran_tdd_config_t* tdd_config);
-
-  // Set configurations for lib objects
-  void set_ue_dl_cfg(srsran_ue_dl_cfg_t* ue_dl_cfg);
-  void set_ue_ul_cfg(srsran_ue_ul_cfg_t* ue_ul_cfg);
-  void set_pdsch_cfg(srsran_pdsch_cfg_t* pdsch_cfg);
-
-  void set_rar_grant(uint8_t grant_payload[SRSRAN_RAR_GRANT_LEN], uint16_t rnti, srsran_tdd_config_t tdd_config);
-
-  void set_dl_pending_grant(uint32_t tti, uint32_t cc_idx, uint32_t grant_cc_idx, const srsran_dci_dl_t* dl_dci);
-  bool get_dl_pending_grant(uint32_t tti, uint32_t cc_idx, uint32_t* grant_cc_idx, srsran_dci_dl_t* dl_dci);
-
-  void set_ul_pending_ack(srsran_ul_sf_cfg_t*  sf,
-                          uint32_t             cc_idx,
-                          srsran_phich_grant_t phich_grant,
-                          srsran_dci_ul_t*     dci_ul);
-  bool get_ul_pending_ack(srsran_dl_sf_cfg_t*   sf,
-                          uint32_t              cc_idx,
-                          srsran_phich_grant_t* phich_grant,
-                          srsran_dci_ul_t*      dci_ul);
-  bool is_any_ul_pending_ack();
-
-  bool get_ul_received_ack(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, bool* ack_value, srsran_dci_ul_t* dci_ul);
-  void set_ul_received_ack(srsran_dl_sf_cfg_t* sf,
-                           uint32_t            cc_idx,
-                           bool                ack_value,
-                           uint32_t            I_phich,
-                           srsran_dci_ul_t*    dci_ul);
-
-  void set_ul_pending_grant(srsran_dl_sf_cfg_t* sf, uint32_t cc_idx, srsran_dci_ul_t* dci);
-  bool get_ul_pending_grant(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, uint32_t* pid, srsran_dci_ul_t* dci);
-
-  /**
-   * If there is a UL Grant it returns the lowest index component carrier that has a grant, otherwise it returns 0.
-   *
-   * @param tti_tx TTI in which the transmission is happening
-   * @return The number of carrier if a grant is available, otherwise 0
-   */
-  uint32_t get_ul_uci_cc(uint32_t tti_tx) const;
-
-  void set_rar_grant_tti(uint32_t tti);
-
-  void set_dl_pending_ack(srsran_dl_sf_cfg_t*         sf,
-                          uint32_t                    cc_idx,
-                          uint8_t                     value[SRSRAN_MAX_CODEWORDS],
-                          srsran_pdsch_ack_resource_t resource);
-  bool get_dl_pending_ack(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, srsran_pdsch_ack_cc_t* ack);
-
-  void worker_end(const worker_context_t& w_ctx, const bool& tx_enable, srsran::rf_buffer_t& buffer) override;
-
-  void set_cell(const srsran_cell_t& c);
-
   class sr_signal
   {
   public:
@@ -219,7 +145,154 @@ public:
     bool       enabled     = false;
     int        last_tx_tti = -1;
   };
-  sr_signal sr;
+
+  /* State of one UE stack attached to the PHY: RNTI-specific grants, HARQ feedback, SR and timing advance. All the UEs
+   * share the cell processing, the measurements and the radio */
+  class ue_state
+  {
+  public:
+    ue_state(phy_common& common_, srslog::basic_logger& logger_) : ta(logger_), common(common_), logger(logger_) {}
+
+    stack_interface_phy_lte* stack = nullptr;
+
+    // Save last TBS for uplink (mcs >= 28)
+    srsran_ra_tb_t last_ul_tb[SRSRAN_MAX_HARQ_PROC][SRSRAN_MAX_CARRIERS] = {};
+
+    // Save last TBS for DL (Format1C)
+    int last_dl_tbs[SRSRAN_MAX_HARQ_PROC][SRSRAN_MAX_CARRIERS][SRSRAN_MAX_CODEWORDS] = {};
+
+    // Time Aligment Controller, internal thread safe
+    ta_control ta;
+
+    // Last reported RI
+    std::atomic<uint32_t> last_ri = {0};
+
+    sr_signal sr;
+
+    void set_rar_grant(uint8_t grant_payload[SRSRAN_RAR_GRANT_LEN], uint16_t rnti, srsran_tdd_config_t tdd_config);
+
+    void set_dl_pending_grant(uint32_t tti, uint32_t cc_idx, uint32_t grant_cc_idx, const srsran_dci_dl_t* dl_dci);
+    bool get_dl_pending_grant(uint32_t tti, uint32_t cc_idx, uint32_t* grant_cc_idx, srsran_dci_dl_t* dl_dci);
+
+    void set_ul_pending_ack(srsran_ul_sf_cfg_t*  sf,
+                            uint32_t             cc_idx,
+                            srsran_phich_grant_t phich_grant,
+                            srsran_dci_ul_t*     dci_ul);
+    bool get_ul_pending_ack(srsran_dl_sf_cfg_t*   sf,
+                            uint32_t              cc_idx,
+                            srsran_phich_grant_t* phich_grant,
+                            srsran_dci_ul_t*      dci_ul);
+    bool is_any_ul_pending_ack();
+
+    bool get_ul_received_ack(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, bool* ack_value, srsran_dci_ul_t* dci_ul);
+    void set_ul_received_ack(srsran_dl_sf_cfg_t* sf,
+                             uint32_t            cc_idx,
+                             bool                ack_value,
+                             uint32_t            I_phich,
+                             srsran_dci_ul_t*    dci_ul);
+
+    void set_ul_pending_grant(srsran_dl_sf_cfg_t* sf, uint32_t cc_idx, srsran_dci_ul_t* dci);
+    bool get_ul_pending_grant(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, uint32_t* pid, srsran_dci_ul_t* dci);
+
+    /**
+     * If there is a UL Grant it returns the lowest index component carrier that has a grant, otherwise it returns 0.
+     *
+     * @param tti_tx TTI in which the transmission is happening
+     * @return The number of carrier if a grant is available, otherwise 0
+     */
+    uint32_t get_ul_uci_cc(uint32_t tti_tx) const;
+
+    void set_rar_grant_tti(uint32_t tti);
+
+    void set_dl_pending_ack(srsran_dl_sf_cfg_t*         sf,
+                            uint32_t                    cc_idx,
+                            uint8_t                     value[SRSRAN_MAX_CODEWORDS],
+                            srsran_pdsch_ack_resource_t resource);
+    bool get_dl_pending_ack(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, srsran_pdsch_ack_cc_t* ack);
+
+    void reset();
+
+  private:
+    phy_common&           common;
+    srslog::basic_logger& logger;
+
+    int rar_grant_tti = -1;
+
+    typedef struct {
+      bool                 enable;
+      srsran_phich_grant_t phich_grant;
+      srsran_dci_ul_t      dci_ul;
+    } pending_ul_ack_t;
+    srsran::circular_array<pending_ul_ack_t, TTIMOD_SZ> pending_ul_ack[SRSRAN_MAX_CARRIERS][2] = {};
+    std::mutex                                          pending_ul_ack_mutex;
+
+    typedef struct {
+      bool            hi_value;
+      bool            hi_present;
+      srsran_dci_ul_t dci_ul;
+    } received_ul_ack_t;
+    srsran::circular_array<received_ul_ack_t, TTIMOD_SZ> received_ul_ack[SRSRAN_MAX_CARRIERS] = {};
+    std::mutex                                           received_ul_ack_mutex;
+
+    typedef struct {
+      bool            enable;
+      uint32_t        pid;
+      srsran_dci_ul_t dci;
+    } pending_ul_grant_t;
+    srsran::circular_array<pending_ul_grant_t, TTIMOD_SZ> pending_ul_grant[SRSRAN_MAX_CARRIERS] = {};
+    mutable std::mutex                                    pending_ul_grant_mutex;
+
+    typedef struct {
+      bool                        enable;
+      uint8_t                     value[SRSRAN_MAX_CODEWORDS]; // 0/1 or 2 for DTX
+      srsran_pdsch_ack_resource_t resource;
+    } received_ack_t;
+    srsran::circular_array<received_ack_t, TTIMOD_SZ> pending_dl_ack[SRSRAN_MAX_CARRIERS] = {};
+    srsran::circular_array<uint32_t, TTIMOD_SZ>       pending_dl_dai[SRSRAN_MAX_CARRIERS] = {};
+    std::mutex                                        pending_dl_ack_mutex;
+    std::mutex                                        pending_dl_grant_mutex;
+
+    // Cross-carried grants scheduled from PCell
+    typedef struct {
+      bool            enable;
+      uint32_t        grant_cc_idx;
+      srsran_dci_dl_t dl_dci;
+    } pending_dl_grant_t;
+    pending_dl_grant_t pending_dl_grant[FDD_HARQ_DELAY_UL_MS][SRSRAN_MAX_CARRIERS] = {};
+  };
+
+  phy_common(srslog::basic_logger& logger);
+
+  ~phy_common();
+
+  void init(phy_args_t*                                  args,
+            srsran::radio_interface_phy*                 _radio,
+            const std::vector<stack_interface_phy_lte*>& _stacks,
+            rsrp_insync_itf*                             rsrp_insync);
+
+  /// UE 0 is the one that drives the cell search, the cell selection, the measurements and the Tx timing
+  ue_state& get_ue(uint32_t ue_idx) { return *ues.at(ue_idx); }
+  uint32_t  get_nof_ue() const { return (uint32_t)ues.size(); }
+
+  /// Signals a cell-level event (sync, MIB, measurements, TTI) to the stacks of all the UEs
+  template <typename F>
+  void for_each_stack(const F& f)
+  {
+    for (auto& ue : ues) {
+      f(ue->stack);
+    }
+  }
+
+  uint32_t ul_pidof(uint32_t tti, srsran_tdd_config_t* tdd_config);
+
+  // Set configurations for lib objects
+  void set_ue_dl_cfg(srsran_ue_dl_cfg_t* ue_dl_cfg);
+  void set_ue_ul_cfg(srsran_ue_ul_cfg_t* ue_ul_cfg);
+  void set_pdsch_cfg(srsran_pdsch_cfg_t* pdsch_cfg);
+
+  void worker_end(const worker_context_t& w_ctx, const bool& tx_enable, srsran::rf_buffer_t& buffer) override;
+
+  void set_cell(const srsran_cell_t& c);
 
   srsran::radio_interface_phy* get_radio();
 
@@ -354,49 +427,7 @@ private:
   srslog::basic_logger&        logger;
   srsran::channel_ptr          ul_channel = nullptr;
 
-  int rar_grant_tti = -1;
-
-  typedef struct {
-    bool                 enable;
-    srsran_phich_grant_t phich_grant;
-    srsran_dci_ul_t      dci_ul;
-  } pending_ul_ack_t;
-  srsran::circular_array<pending_ul_ack_t, TTIMOD_SZ> pending_ul_ack[SRSRAN_MAX_CARRIERS][2] = {};
-  std::mutex                                          pending_ul_ack_mutex;
-
-  typedef struct {
-    bool            hi_value;
-    bool            hi_present;
-    srsran_dci_ul_t dci_ul;
-  } received_ul_ack_t;
-  srsran::circular_array<received_ul_ack_t, TTIMOD_SZ> received_ul_ack[SRSRAN_MAX_CARRIERS] = {};
-  std::mutex                                           received_ul_ack_mutex;
-
-  typedef struct {
-    bool            enable;
-    uint32_t        pid;
-    srsran_dci_ul_t dci;
-  } pending_ul_grant_t;
-  srsran::circular_array<pending_ul_grant_t, TTIMOD_SZ> pending_ul_grant[SRSRAN_MAX_CARRIERS] = {};
-  mutable std::mutex                                    pending_ul_grant_mutex;
-
-  typedef struct {
-    bool                        enable;
-    uint8_t                     value[SRSRAN_MAX_CODEWORDS]; // 0/1 or 2 for DTX
-    srsran_pdsch_ack_resource_t resource;
-  } received_ack_t;
-  srsran::circular_array<received_ack_t, TTIMOD_SZ> pending_dl_ack[SRSRAN_MAX_CARRIERS] = {};
-  srsran::circular_array<uint32_t, TTIMOD_SZ>       pending_dl_dai[SRSRAN_MAX_CARRIERS] = {};
-  std::mutex                                        pending_dl_ack_mutex;
-  std::mutex                                        pending_dl_grant_mutex;
-
-  // Cross-carried grants scheduled from PCell
-  typedef struct {
-    bool            enable;
-    uint32_t        grant_cc_idx;
-    srsran_dci_dl_t dl_dci;
-  } pending_dl_grant_t;
-  pending_dl_grant_t pending_dl_grant[FDD_HARQ_DELAY_UL_MS][SRSRAN_MAX_CARRIERS] = {};
+  std::vector<std::unique_ptr<ue_state> > ues;
 
   srsran_cell_t cell = {};
 
@@ -124,6 +124,10 @@ struct dl_metrics_t {
   float mcs       = 0.0;
   float evm       = 0.0;
 
+  // NR only, accumulated for every PDSCH regardless of its CRC
+  std::array<uint32_t, SRSRAN_SCH_NR_ITER_HIST_SIZE> fec_iters_hist = {}; ///< Code blocks per LDPC iterations - 1
+  uint32_t                                           fec_cb_aborted = 0;  ///< Code blocks given up by the LDPC decoder
+
   void set(const dl_metrics_t& other)
   {
     count++;
@@ -132,12 +136,22 @@ struct dl_metrics_t {
     PHY_METRICS_SET(evm);
   }
 
+  void add_fec(const srsran_sch_tb_res_nr_t& tb)
+  {
+    for (uint32_t i = 0; i < SRSRAN_SCH_NR_ITER_HIST_SIZE; i++) {
+      fec_iters_hist[i] += tb.iter_hist[i];
+    }
+    fec_cb_aborted += tb.nof_cb_aborted;
+  }
+
   void reset()
   {
     count     = 0;
     fec_iters = 0.0f;
     mcs       = 0.0f;
     evm       = 0.0f;
+    fec_iters_hist.fill(0);
+    fec_cb_aborted = 0;
   }
 
 private:
@@ -65,8 +65,7 @@ public:
   ~sync();
 
   void init(srsran::radio_interface_phy* radio_,
-            stack_interface_phy_lte*     _stack,
-            prach*                       prach_buffer,
+            const std::vector<prach*>&   prach_buffers,
             lte::worker_pool*            _lte_workers_pool,
             nr::worker_pool*             _nr_workers_pool,
             phy_common*                  _worker_com,
@@ -218,21 +217,23 @@ private:
   std::mutex                                              intra_freq_cfg_mutex;
 
   // Pointers to other classes
-  stack_interface_phy_lte*     stack = nullptr;
   srslog::basic_logger&        phy_logger;
   srslog::basic_logger&        phy_lib_logger;
   lte::worker_pool*            lte_worker_pool  = nullptr;
   nr::worker_pool*             nr_worker_pool   = nullptr;
   srsran::radio_interface_phy* radio_h          = nullptr;
   phy_common*                  worker_com       = nullptr;
-  prach*                       prach_buffer     = nullptr;
   srsran::channel_ptr          channel_emulator = nullptr;
 
-  // PRACH state
-  uint32_t prach_nof_sf = 0;
-  uint32_t prach_sf_cnt = 0;
-  cf_t*    prach_ptr    = nullptr;
-  float    prach_power  = 0;
+  // PRACH state of every UE sharing the PHY
+  struct prach_state_t {
+    prach*   buffer = nullptr;
+    uint32_t nof_sf = 0;
+    uint32_t sf_cnt = 0;
+    cf_t*    ptr    = nullptr;
+    float    power  = 0;
+  };
+  std::vector<prach_state_t> prach_state;
 
   // Object for synchronization of the primary cell
   srsran_ue_sync_t ue_sync = {};
@@ -187,6 +187,7 @@ public:
 
   // Interface for GW
   void write_sdu(uint32_t eps_bearer_id, srsran::unique_byte_buffer_t sdu) final;
+  void write_sdu_batch(uint32_t eps_bearer_id, srsran::unique_byte_buffer_t* sdus, uint32_t nof_sdus) final;
   bool has_active_radio_bearer(uint32_t eps_bearer_id) final;
 
   // Interface for RRC
@@ -201,6 +202,9 @@ private:
   void run_thread() final;
   void run_tti_impl(uint32_t tti, uint32_t tti_jump);
   void stop_impl();
+  void route_sdu(uint32_t                                  eps_bearer_id,
+                 const ue_bearer_manager::radio_bearer_t& bearer,
+                 srsran::unique_byte_buffer_t             sdu);
 
   const uint32_t                  TTI_STAT_PERIOD = 1024;
   const std::chrono::milliseconds TTI_WARN_THRESHOLD_MS{5};
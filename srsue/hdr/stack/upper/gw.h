@@ -31,9 +31,11 @@
 #include "srsran/srslog/srslog.h"
 #include "tft_packet_filter.h"
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <net/if.h>
 #include <netinet/in.h>
+#include <vector>
 
 namespace srsue {
 
@@ -47,8 +49,21 @@ struct gw_args_t {
   std::string netns;
   std::string tun_dev_name;
   std::string tun_dev_netmask;
+  uint32_t    tun_nof_queues = 1;     ///< Number of TUN queues, each one served by its own reader thread
+  uint32_t    tun_batch_size = 1;     ///< Maximum number of IP packets read per wake-up and pushed in one go
+  bool        tun_vnet_hdr   = false; ///< Let the kernel hand over TSO and checksum-offloaded packets
 };
 
+/**
+ * Completes the checksum and splits a TCP segmentation offload (TSO) packet read from a TUN device opened with
+ * IFF_VNET_HDR into MTU-sized IP packets.
+ * @param buf   Packet, starting with the virtio-net header.
+ * @param len   Packet length in bytes, including the header.
+ * @param pdus  The resulting IP packets are appended here.
+ * @return Number of appended packets or SRSRAN_ERROR if the packet is malformed or no buffer is available.
+ */
+int gw_vnet_segment(const uint8_t* buf, uint32_t len, std::vector<srsran::unique_byte_buffer_t>& pdus);
+
 class gw : public gw_interface_stack, public srsran::thread
 {
 public:
@@ -76,6 +91,19 @@ public:
 private:
   static const int GW_THREAD_PRIO = -1;
 
+  /// Reader thread for the additional queues of a multi-queue TUN device
+  class tun_queue_reader : public srsran::thread
+  {
+  public:
+    tun_queue_reader(gw* parent_, int32_t fd_) : thread("GW_QUEUE"), parent(parent_), fd(fd_) {}
+
+  private:
+    void run_thread() override { parent->run_batched_rx(fd); }
+
+    gw*     parent = nullptr;
+    int32_t fd     = 0;
+  };
+
   stack_interface_gw* stack = nullptr;
 
   gw_args_t args = {};
@@ -88,21 +116,33 @@ private:
   int32_t           sock       = 0;
   std::atomic<bool> if_up      = {false};
 
-  static const int NOT_ASSIGNED          = -1;
-  int32_t          default_eps_bearer_id = NOT_ASSIGNED;
-  std::mutex       gw_mutex;
+  std::vector<int32_t> tun_queue_fds; // Queues 1..N-1 of a multi-queue TUN device, queue 0 is tun_fd
+
+  static const int    NOT_ASSIGNED          = -1;
+  std::atomic<int32_t> default_eps_bearer_id = {NOT_ASSIGNED};
+  std::mutex           gw_mutex;
 
   srslog::basic_logger& logger;
 
   uint32_t current_ip_addr = 0;
   uint8_t  current_if_id[8];
 
-  uint32_t                                       ul_tput_bytes = 0;
-  uint32_t                                       dl_tput_bytes = 0;
+  std::atomic<uint32_t>                          ul_tput_bytes   = {0};
+  std::atomic<uint32_t>                          dl_tput_bytes   = {0};
+  std::atomic<uint32_t>                          dl_dropped_pkts = {0}; // DL packets the TUN device did not accept
   std::chrono::high_resolution_clock::time_point metrics_tp; // stores time when last metrics have been taken
 
+  std::vector<std::unique_ptr<tun_queue_reader> > queue_readers;
+
   void run_thread();
+  bool batched_rx() const { return args.tun_nof_queues > 1 || args.tun_batch_size > 1 || args.tun_vnet_hdr; }
+  void run_batched_rx(int32_t fd);
+  void write_batch(std::vector<srsran::unique_byte_buffer_t>& batch);
+  bool wait_for_service(uint32_t eps_bearer_id);
+  int  tun_write(const uint8_t* data, uint32_t nof_bytes);
+  void stop_rx_threads();
   int  init_if(char* err_str);
+  int  open_tun_queue(struct ifreq* ifr_, char* err_str);
   int  setup_if_addr4(uint32_t ip_addr, char* err_str);
   int  setup_if_addr6(uint8_t* ipv6_if_id, char* err_str);
   bool find_ipv6_addr(struct in6_addr* in6_out);
@@ -25,6 +25,9 @@
 #include "srsran/asn1/liblte_mme.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/srslog/srslog.h"
+#include <atomic>
+#include <map>
+#include <memory>
 #include <mutex>
 
 namespace srsue {
@@ -70,8 +73,8 @@ public:
   tft_packet_filter_t(uint8_t                                eps_bearer_id_,
                       const LIBLTE_MME_PACKET_FILTER_STRUCT& tft_,
                       srslog::basic_logger&                  logger);
-  bool match(const srsran::unique_byte_buffer_t& pdu);
-  bool filter_contains(uint16_t filtertype);
+  bool match(const srsran::unique_byte_buffer_t& pdu) const;
+  bool filter_contains(uint16_t filtertype) const;
 
   uint8_t  eps_bearer_id             = {};
   uint8_t  id                        = {};
@@ -99,11 +102,11 @@ public:
 
   srslog::basic_logger& logger;
 
-  bool match_ip(const srsran::unique_byte_buffer_t& pdu);
-  bool match_protocol(const srsran::unique_byte_buffer_t& pdu);
-  bool match_type_of_service(const srsran::unique_byte_buffer_t& pdu);
-  bool match_flow_label(const srsran::unique_byte_buffer_t& pdu);
-  bool match_port(const srsran::unique_byte_buffer_t& pdu);
+  bool match_ip(const srsran::unique_byte_buffer_t& pdu) const;
+  bool match_protocol(const srsran::unique_byte_buffer_t& pdu) const;
+  bool match_type_of_service(const srsran::unique_byte_buffer_t& pdu) const;
+  bool match_flow_label(const srsran::unique_byte_buffer_t& pdu) const;
+  bool match_port(const srsran::unique_byte_buffer_t& pdu) const;
 };
 
 /**
@@ -123,10 +126,17 @@ public:
   void    delete_tft_for_eps_bearer(const uint8_t eps_bearer_id);
 
 private:
-  srslog::basic_logger&                           logger;
-  std::mutex                                      tft_mutex;
   typedef std::map<uint16_t, tft_packet_filter_t> tft_filter_map_t;
-  tft_filter_map_t                                tft_filter_map;
+
+  void publish(tft_filter_map_t filters);
+  int  apply_traffic_flow_template(tft_filter_map_t&                              filters,
+                                   const uint8_t&                                 erab_id,
+                                   const LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT* tft);
+
+  srslog::basic_logger& logger;
+  std::mutex            tft_mutex; ///< Serializes updates, lookups only load the current snapshot
+  std::atomic<bool>     has_filters{false};
+  std::shared_ptr<const tft_filter_map_t> tft_filter_map = std::make_shared<const tft_filter_map_t>();
 };
 
 } // namespace srsue
@@ -31,6 +31,7 @@
 #include <pthread.h>
 #include <stdarg.h>
 #include <string>
+#include <vector>
 
 #include "phy/ue_phy_base.h"
 #include "srsran/common/buffer_pool.h"
@@ -119,6 +120,10 @@ private:
   std::unique_ptr<ue_stack_base>      stack;
   std::unique_ptr<gw>                 gw_inst;
 
+  // Additional UEs sharing the EUTRA PHY (see phy_args_t::nof_ue), each one with its own stack, USIM and GW
+  std::vector<std::unique_ptr<ue_stack_base> > ue_stacks;
+  std::vector<std::unique_ptr<gw> >            ue_gws;
+
   // Generic logger members
   srslog::basic_logger& logger;
 
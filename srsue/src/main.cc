@@ -134,6 +134,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("rat.eutra.dl_freq",      bpo::value<float>(&args->phy.dl_freq)->default_value(-1),            "Downlink Frequency (if positive overrides EARFCN)")
     ("rat.eutra.ul_freq",      bpo::value<float>(&args->phy.ul_freq)->default_value(-1),            "Uplink Frequency (if positive overrides EARFCN)")
     ("rat.eutra.nof_carriers", bpo::value<uint32_t>(&args->phy.nof_lte_carriers)->default_value(1), "Number of carriers")
+    ("rat.eutra.nof_ue",       bpo::value<uint32_t>(&args->phy.nof_ue)->default_value(1),           "Number of UEs sharing the EUTRA PHY, each one with its own stack and RNTI")
     
     ("rat.nr.bands",        bpo::value<string>(&args->stack.rrc_nr.supported_bands_nr_str)->default_value("3"),   "Supported NR bands")
     ("rat.nr.nof_carriers", bpo::value<uint32_t>(&args->phy.nof_nr_carriers)->default_value(0),                   "Number of NR carriers")
@@ -214,6 +215,9 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("gw.netns", bpo::value<string>(&args->gw.netns)->default_value(""), "Network namespace to for TUN device (empty for default netns)")
     ("gw.ip_devname", bpo::value<string>(&args->gw.tun_dev_name)->default_value("tun_srsue"), "Name of the tun_srsue device")
     ("gw.ip_netmask", bpo::value<string>(&args->gw.tun_dev_netmask)->default_value("255.255.255.0"), "Netmask of the tun_srsue device")
+    ("gw.tun_nof_queues", bpo::value<uint32_t>(&args->gw.tun_nof_queues)->default_value(1), "Number of queues of the tun_srsue device, each one with its own reader thread")
+    ("gw.tun_batch_size", bpo::value<uint32_t>(&args->gw.tun_batch_size)->default_value(1), "Maximum number of IP packets read from the tun_srsue device and pushed to the stack at once")
+    ("gw.tun_vnet_hdr", bpo::value<bool>(&args->gw.tun_vnet_hdr)->default_value(false), "Receive TSO and checksum-offloaded packets from the tun_srsue device")
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),                 "Enable/Disable internal Downlink channel emulator")
@@ -448,6 +452,14 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
       bpo::value<bool>(&args->phy.nr_store_pdsch_ko)->default_value(false),
       "Dumps the PDSCH baseband samples into a file on KO reception.")
 
+    ("phy.nr.pdsch_early_stop",
+      bpo::value<bool>(&args->phy.nr_pdsch_early_stop)->default_value(false),
+      "Stops LDPC decoding on a zero syndrome and aborts code blocks that stop converging.")
+
+    ("phy.nr.pdsch_abort_its",
+      bpo::value<uint32_t>(&args->phy.nr_pdsch_abort_its)->default_value(0),
+      "LDPC iterations without progress before a code block is aborted (0 for default).")
+
     // UE simulation args
     ("sim.airplane_t_on_ms",
      bpo::value<int>(&args->stack.nas.sim.airplane_t_on_ms)->default_value(-1),
@@ -120,6 +120,10 @@ void metrics_csv::set_metrics_helper(const srsran::rf_metrics_t&  rf,
   file << float_to_string(phy.dl[r].mcs, 2);
   file << float_to_string(phy.ch[r].sinr, 2);
   file << float_to_string(phy.dl[r].fec_iters, 2);
+  for (uint32_t i = 0; i < SRSRAN_SCH_NR_ITER_HIST_SIZE; i++) {
+    file << phy.dl[r].fec_iters_hist[i] << ";";
+  }
+  file << phy.dl[r].fec_cb_aborted << ";";
 
   if (mac[r].rx_brate > 0) {
     file << float_to_string(mac[r].rx_brate / (mac[r].nof_tti * 1e-3), 2);
@@ -186,7 +190,14 @@ void metrics_csv::set_metrics(const ue_metrics_t& metrics, const uint32_t period
 
   if (file.is_open() && ue != NULL) {
     if (n_reports == 0 && !file_exists) {
-      file << "time;cc;earfcn;pci;rsrp;pl;cfo;pci_neigh;rsrp_neigh;cfo_neigh;dl_mcs;dl_snr;dl_turbo;dl_brate;dl_bler;"
+      file << "time;cc;earfcn;pci;rsrp;pl;cfo;pci_neigh;rsrp_neigh;cfo_neigh;dl_mcs;dl_snr;dl_turbo;";
+
+      // Add the NR code blocks per number of LDPC iterations, these are zero for LTE carriers.
+      for (uint32_t i = 0; i < SRSRAN_SCH_NR_ITER_HIST_SIZE; i++) {
+        file << "dl_ldpc_iter_" << std::to_string(i + 1) << ";";
+      }
+
+      file << "dl_ldpc_aborted;dl_brate;dl_bler;"
               "ul_ta;distance_km;speed_kmph;ul_mcs;ul_buff;ul_brate;ul_"
               "bler;"
               "rf_o;rf_"
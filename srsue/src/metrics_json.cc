@@ -60,6 +60,10 @@ DECLARE_METRIC("ul_mcs", metric_ul_mcs, float, "");
 DECLARE_METRIC("ul_ta", metric_ul_ta, float, "");
 DECLARE_METRIC("distance_km", metric_distance_km, float, "");
 DECLARE_METRIC("speed_kmph", metric_speed_kmph, float, "");
+DECLARE_METRIC("dl_ldpc_aborted", metric_dl_ldpc_aborted, uint32_t, "");
+DECLARE_METRIC("nof_cb", metric_nof_cb, uint32_t, "");
+DECLARE_METRIC_SET("ldpc_iter_container", mset_ldpc_iter_container, metric_nof_cb);
+DECLARE_METRIC_LIST("dl_ldpc_iter_list", mlist_dl_ldpc_iters, std::vector<mset_ldpc_iter_container>);
 DECLARE_METRIC_SET("carrier_container",
                    mset_carrier_container,
                    metric_earfcn,
@@ -76,6 +80,10 @@ DECLARE_METRIC_SET("carrier_container",
                    mset_mac_container);
 DECLARE_METRIC_LIST("carrier_list", mlist_carriers, std::vector<mset_carrier_container>);
 
+/// NR carrier container, the LDPC iteration list holds the code blocks decoded with index + 1 iterations.
+DECLARE_METRIC_SET("nr_carrier_container", mset_nr_carrier_container, metric_dl_ldpc_aborted, mlist_dl_ldpc_iters);
+DECLARE_METRIC_LIST("nr_carrier_list", mlist_nr_carriers, std::vector<mset_nr_carrier_container>);
+
 /// GW container.
 DECLARE_METRIC_SET("gw_container", mset_gw_container, metric_dl_brate, metric_ul_brate);
 
@@ -129,6 +137,7 @@ DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 using metric_context_t = srslog::build_context_type<metric_type_tag,
                                                     metric_timestamp_tag,
                                                     mlist_carriers,
+                                                    mlist_nr_carriers,
                                                     mset_gw_container,
                                                     mset_rrc_container,
                                                     mlist_neighbours,
@@ -198,6 +207,19 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
     carrier.get<mset_mac_container>().write<metric_ul_buff>(metrics.stack.mac[i].ul_buffer);
   }
 
+  // Fill NR carrier container.
+  auto& nr_carrier_list = ctx.get<mlist_nr_carriers>();
+  nr_carrier_list.resize(metrics.phy_nr.nof_active_cc);
+  for (uint32_t i = 0, e = nr_carrier_list.size(); i != e; ++i) {
+    auto& carrier = nr_carrier_list[i];
+    carrier.write<metric_dl_ldpc_aborted>(metrics.phy_nr.dl[i].fec_cb_aborted);
+    auto& iter_list = carrier.get<mlist_dl_ldpc_iters>();
+    iter_list.resize(SRSRAN_SCH_NR_ITER_HIST_SIZE);
+    for (uint32_t j = 0; j != SRSRAN_SCH_NR_ITER_HIST_SIZE; ++j) {
+      iter_list[j].write<metric_nof_cb>(metrics.phy_nr.dl[i].fec_iters_hist[j]);
+    }
+  }
+
   // Fill GW container.
   ctx.get<mset_gw_container>().write<metric_dl_brate>(metrics.gw.dl_tput_mbps);
   ctx.get<mset_gw_container>().write<metric_ul_brate>(metrics.gw.ul_tput_mbps);
@@ -76,13 +76,13 @@ void metrics_stdout::print_table(const bool display_neighbours, const bool is_nr
 {
   if (is_nr) {
     if (display_neighbours) {
-      fmt::print(
-          "---------Signal-----------|-Neighbour-|-----------------DL-----------------|-----------UL-----------\n");
-      fmt::print(
-          "rat  pci  rsrp   pl   cfo | pci  rsrp | mcs  snr  iter  brate  bler  ta_us | mcs   buff  brate  bler\n");
+      fmt::print("---------Signal-----------|-Neighbour-|--------------------DL--------------------|"
+                 "-----------UL-----------\n");
+      fmt::print("rat  pci  rsrp   pl   cfo | pci  rsrp | mcs  snr  iter  abrt  brate  bler  ta_us |"
+                 " mcs   buff  brate  bler\n");
     } else {
-      fmt::print("---------Signal-----------|-----------------DL-----------------|-----------UL-----------\n");
-      fmt::print("rat  pci  rsrp   pl   cfo | mcs  snr  iter  brate  bler  ta_us | mcs   buff  brate  bler\n");
+      fmt::print("---------Signal-----------|--------------------DL--------------------|-----------UL-----------\n");
+      fmt::print("rat  pci  rsrp   pl   cfo | mcs  snr  iter  abrt  brate  bler  ta_us | mcs   buff  brate  bler\n");
     }
   } else {
     if (display_neighbours) {
@@ -150,6 +150,14 @@ void metrics_stdout::set_metrics_helper(const phy_metrics_t& phy,
     fmt::print("  {:>3}", int(phy.ch[r].sinr));
   }
   fmt::print("  {:>4.1f}", phy.dl[r].fec_iters);
+  // The aborted code block column is only part of the table with NR carriers
+  if (not print_carrier_num) {
+    if (is_carrier_nr) {
+      fmt::print("  {:>4}", phy.dl[r].fec_cb_aborted);
+    } else {
+      fmt::print("  {:>4.4}", "n/a");
+    }
+  }
 
   fmt::print(" {:>6.6}", float_to_eng_string((float)mac[r].rx_brate / (mac[r].nof_tti * 1e-3), 2));
   if (mac[r].rx_pkts > 0) {
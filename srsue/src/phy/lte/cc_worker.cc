@@ -50,21 +50,31 @@ namespace lte {
  *
  */
 
-cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_, srslog::basic_logger& logger) :
+cc_worker::cc_worker(uint32_t              cc_idx_,
+                     uint32_t              max_prb,
+                     srsue::phy_common*    phy_,
+                     srslog::basic_logger& logger,
+                     uint32_t              ue_idx,
+                     cc_worker*            front_end) :
   logger(logger)
 {
   cc_idx = cc_idx_;
   phy    = phy_;
+  ue     = &phy->get_ue(ue_idx);
+  ue_dl  = (front_end != nullptr) ? front_end->ue_dl : &ue_dl_obj;
 
   srsran_cfr_cfg_t cfr_config = phy->get_cfr_config();
 
   signal_buffer_max_samples = 3 * SRSRAN_SF_LEN_PRB(max_prb);
 
   for (uint32_t i = 0; i < phy->args->nof_rx_ant; i++) {
-    signal_buffer_rx[i] = srsran_vec_cf_malloc(signal_buffer_max_samples);
-    if (!signal_buffer_rx[i]) {
-      Error("Allocating memory");
-      return;
+    // A UE sharing the front-end of another worker decodes the subframe received by that worker
+    if (front_end == nullptr) {
+      signal_buffer_rx[i] = srsran_vec_cf_malloc(signal_buffer_max_samples);
+      if (!signal_buffer_rx[i]) {
+        Error("Allocating memory");
+        return;
+      }
     }
     signal_buffer_tx[i] = srsran_vec_cf_malloc(signal_buffer_max_samples);
     if (!signal_buffer_tx[i]) {
@@ -73,7 +83,7 @@ cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_
     }
   }
 
-  if (srsran_ue_dl_init(&ue_dl, signal_buffer_rx, max_prb, phy->args->nof_rx_ant)) {
+  if (front_end == nullptr && srsran_ue_dl_init(&ue_dl_obj, signal_buffer_rx, max_prb, phy->args->nof_rx_ant)) {
     Error("Initiating UE DL");
     return;
   }
@@ -105,9 +115,9 @@ cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_
   // Set default PHY params
   reset();
 
-  if (phy->args->pdsch_8bit_decoder) {
-    ue_dl.pdsch.llr_is_8bit        = true;
-    ue_dl.pdsch.dl_sch.llr_is_8bit = true;
+  if (front_end == nullptr && phy->args->pdsch_8bit_decoder) {
+    ue_dl->pdsch.llr_is_8bit        = true;
+    ue_dl->pdsch.dl_sch.llr_is_8bit = true;
   }
 }
 
@@ -122,7 +132,9 @@ cc_worker::~cc_worker()
     }
   }
   srsran_softbuffer_rx_free(&mch_softbuffer);
-  srsran_ue_dl_free(&ue_dl);
+  if (ue_dl == &ue_dl_obj) {
+    srsran_ue_dl_free(&ue_dl_obj);
+  }
   srsran_ue_ul_free(&ue_ul);
 }
 
@@ -143,13 +155,16 @@ bool cc_worker::set_cell_nolock(srsran_cell_t cell_)
   if (cell.id != cell_.id || !cell_initiated) {
     cell = cell_;
 
-    if (srsran_ue_dl_set_cell(&ue_dl, cell)) {
-      Error("Setting ue_dl cell");
-      return false;
-    }
+    // The cell of a shared front-end is set by its own worker
+    if (ue_dl == &ue_dl_obj) {
+      if (srsran_ue_dl_set_cell(ue_dl, cell)) {
+        Error("Setting ue_dl cell");
+        return false;
+      }
 
-    if (srsran_ue_dl_set_mbsfn_area_id(&ue_dl, 1)) {
-      Error("Setting mbsfn id");
+      if (srsran_ue_dl_set_mbsfn_area_id(ue_dl, 1)) {
+        Error("Setting mbsfn id");
+      }
     }
 
     if (srsran_ue_ul_set_cell(&ue_ul, cell)) {
@@ -196,7 +211,7 @@ void cc_worker::set_cfo_nolock(float cfo)
 
 float cc_worker::get_ref_cfo() const
 {
-  return ue_dl.chest_res.cfo;
+  return ue_dl->chest_res.cfo;
 }
 
 void cc_worker::set_tdd_config_nolock(srsran_tdd_config_t config)
@@ -242,13 +257,13 @@ bool cc_worker::work_dl_regular()
   // Blind search PHICH mi value
   for (uint32_t i = 0; i < mi_set_len && !found_dl_grant; i++) {
     if (mi_set_len == 1) {
-      srsran_ue_dl_set_mi_auto(&ue_dl);
+      srsran_ue_dl_set_mi_auto(ue_dl);
     } else {
-      srsran_ue_dl_set_mi_manual(&ue_dl, i);
+      srsran_ue_dl_set_mi_manual(ue_dl, i);
     }
 
     /* Do FFT and extract PDCCH LLR, or quit if no actions are required in this subframe */
-    if (srsran_ue_dl_decode_fft_estimate(&ue_dl, &sf_cfg_dl, &ue_dl_cfg) < 0) {
+    if (srsran_ue_dl_decode_fft_estimate(ue_dl, &sf_cfg_dl, &ue_dl_cfg) < 0) {
       Error("Getting PDCCH FFT estimate");
       return false;
     }
@@ -263,42 +278,21 @@ bool cc_worker::work_dl_regular()
 
   srsran_dci_dl_t dci_dl       = {};
   uint32_t        grant_cc_idx = 0;
-  bool            has_dl_grant = phy->get_dl_pending_grant(CURRENT_TTI, cc_idx, &grant_cc_idx, &dci_dl);
+  bool            has_dl_grant = ue->get_dl_pending_grant(CURRENT_TTI, cc_idx, &grant_cc_idx, &dci_dl);
 
   // If found a dci for this carrier, generate a grant, pass it to MAC and decode the associated PDSCH
   if (has_dl_grant) {
-    // PDCCH order has no associated PDSCH to decode
-    if (not dci_dl.is_pdcch_order) {
-      // Read last TB from last retx for this pid
-      for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
-        ue_dl_cfg.cfg.pdsch.grant.last_tbs[i] = phy->last_dl_tbs[dci_dl.pid][cc_idx][i];
-      }
-      // Generate PHY grant
-      if (srsran_ue_dl_dci_to_pdsch_grant(&ue_dl, &sf_cfg_dl, &ue_dl_cfg, &dci_dl, &ue_dl_cfg.cfg.pdsch.grant)) {
-        Info("Converting DCI message to DL dci");
-        return false;
-      }
-
-      // Save TB for next retx
-      for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
-        phy->last_dl_tbs[dci_dl.pid][cc_idx][i] = ue_dl_cfg.cfg.pdsch.grant.last_tbs[i];
-      }
-
-      // Set RNTI
-      ue_dl_cfg.cfg.pdsch.rnti = dci_dl.rnti;
-    } else {
-      ue_dl_cfg.cfg.pdsch.rnti            = dci_dl.rnti;
-      ue_dl_cfg.cfg.pdsch.grant.tb[0].tbs = 0;
-    }
-    // Generate MAC grant
+    // Generate PHY and MAC grants
     mac_interface_phy_lte::mac_grant_dl_t mac_grant = {};
-    dl_phy_to_mac_grant(&ue_dl_cfg.cfg.pdsch.grant, &dci_dl, &mac_grant);
+    if (not new_dl_grant(&dci_dl, &mac_grant)) {
+      return false;
+    }
 
     // Save ACK resource configuration
     srsran_pdsch_ack_resource_t ack_resource = {dci_dl.dai, dci_dl.location.ncce, grant_cc_idx, dci_dl.tpc_pucch};
 
     // Send grant to MAC and get action for this TB, then call tb_decoded to unlock MAC
-    phy->stack->new_grant_dl(cc_idx, mac_grant, &dl_action);
+    ue->stack->new_grant_dl(cc_idx, mac_grant, &dl_action);
 
     // Decode PDSCH
     decode_pdsch(ack_resource, &dl_action, dl_ack);
@@ -309,7 +303,7 @@ bool cc_worker::work_dl_regular()
         dl_ack[i] = false;
       }
     }
-    phy->stack->tb_decoded(cc_idx, mac_grant, dl_ack);
+    ue->stack->tb_decoded(cc_idx, mac_grant, dl_ack);
   }
 
   /* Decode PHICH */
@@ -318,6 +312,139 @@ bool cc_worker::work_dl_regular()
   return true;
 }
 
+bool cc_worker::work_dl_multi_ue(const std::vector<cc_worker*>& ue_workers)
+{
+  if (!cell_initiated) {
+    logger.warning("Trying to access cc_worker=%d while cell not initialized (DL)", cc_idx);
+    return false;
+  }
+
+  // Set default channel estimation, the FFT and the channel estimation run once for all the UEs
+  ue_dl_cfg.chest_cfg = chest_default_cfg;
+
+  // Every UE looks for its own RNTIs in the processed subframe
+  bool is_active = phy->cell_state.is_active(cc_idx, sf_cfg_dl.tti);
+  multi_ue_users.resize(ue_workers.size());
+  for (uint32_t i = 0; i < ue_workers.size(); i++) {
+    ue_workers[i]->set_multi_ue_user(&multi_ue_users[i], is_active);
+  }
+
+  bool ret =
+      srsran_ue_dl_find_and_decode_multi(ue_dl, &sf_cfg_dl, multi_ue_users.data(), multi_ue_users.size()) >= 0;
+  if (not ret) {
+    Error("Decoding DL of %zd UEs", ue_workers.size());
+  }
+
+  // Every grant passed to a MAC is closed with tb_decoded(), even if the decoding of another UE failed
+  for (uint32_t i = 0; i < ue_workers.size(); i++) {
+    ue_workers[i]->end_multi_ue_user(&multi_ue_users[i]);
+  }
+
+  return ret;
+}
+
+void cc_worker::set_multi_ue_user(srsran_ue_dl_user_t* user, bool is_active)
+{
+  sf_cfg_dl.sf_type = SRSRAN_SF_NORM;
+  multi_ue_dl       = {};
+
+  *user               = {};
+  user->cfg           = &ue_dl_cfg;
+  user->new_grant     = new_dl_grant_multi_ue;
+  user->new_grant_arg = this;
+
+  // There is no cross-carrier scheduling with several UEs, only the PCell is used
+  if (is_active) {
+    ue_dl_cfg.cfg.dci.cif_enabled = false;
+    ue_dl_cfg.cfg.dci_common_ss   = true;
+    user->rnti                    = ue->stack->get_dl_sched_rnti(CURRENT_TTI);
+    user->ul_rnti                 = ue->stack->get_ul_sched_rnti(CURRENT_TTI);
+  }
+}
+
+int cc_worker::new_dl_grant_multi_ue(void*               arg,
+                                     srsran_dl_sf_cfg_t* sf,
+                                     srsran_dci_dl_t*    dci_dl,
+                                     srsran_pdsch_cfg_t* pdsch_cfg,
+                                     uint8_t*            data[SRSRAN_MAX_CODEWORDS])
+{
+  return static_cast<cc_worker*>(arg)->handle_dl_grant_multi_ue(dci_dl, pdsch_cfg, data);
+}
+
+int cc_worker::handle_dl_grant_multi_ue(srsran_dci_dl_t*    dci_dl,
+                                        srsran_pdsch_cfg_t* pdsch_cfg,
+                                        uint8_t*            data[SRSRAN_MAX_CODEWORDS])
+{
+  // If RAR dci, save TTI
+  if (SRSRAN_RNTI_ISRAR(dci_dl->rnti)) {
+    ue->set_rar_grant_tti(CURRENT_TTI);
+  }
+
+  // Logging
+  if (logger.info.enabled()) {
+    char str[512];
+    srsran_dci_dl_info(dci_dl, str, 512);
+    logger.info("PDCCH: cc=%d, %s, snr=%.1f dB", cc_idx, str, ue_dl->chest_res.snr_db);
+  }
+
+  // A DCI that can not be converted only skips the PDSCH of this UE
+  if (not new_dl_grant(dci_dl, &multi_ue_dl.mac_grant)) {
+    for (srsran_ra_tb_t& tb : pdsch_cfg->grant.tb) {
+      tb.enabled = false;
+    }
+    return SRSRAN_SUCCESS;
+  }
+  multi_ue_dl.present      = true;
+  multi_ue_dl.ack_resource = {dci_dl->dai, dci_dl->location.ncce, cc_idx, dci_dl->tpc_pucch};
+
+  // Send grant to MAC and get action for this TB, the PDSCH is decoded into the MAC buffers
+  ue->stack->new_grant_dl(cc_idx, multi_ue_dl.mac_grant, &multi_ue_dl.action);
+  multi_ue_dl.decode_enable = prepare_pdsch(&multi_ue_dl.action, multi_ue_dl.tb_enable, data);
+
+  return SRSRAN_SUCCESS;
+}
+
+void cc_worker::end_multi_ue_user(srsran_ue_dl_user_t* user)
+{
+  // Save the UL DCIs found for this UE
+  for (int k = 0; k < user->nof_dci_ul; k++) {
+    ue->set_ul_pending_grant(&sf_cfg_dl, cc_idx, &user->dci_ul[k]);
+
+    // Logging
+    if (logger.info.enabled()) {
+      char str[512];
+      srsran_dci_ul_info(&user->dci_ul[k], str, 512);
+      logger.info("PDCCH: cc=%d, %s, snr=%.1f dB", cc_idx, str, ue_dl->chest_res.snr_db);
+    }
+  }
+
+  if (multi_ue_dl.present) {
+    srsran_pdsch_res_t pdsch_dec[SRSRAN_MAX_CODEWORDS] = {};
+    bool               dl_ack[SRSRAN_MAX_CODEWORDS]    = {};
+    for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
+      pdsch_dec[tb].payload = multi_ue_dl.action.tb[tb].payload;
+      pdsch_dec[tb].crc     = user->acks[tb];
+    }
+    process_pdsch_result(multi_ue_dl.ack_resource,
+                         &multi_ue_dl.action,
+                         multi_ue_dl.tb_enable,
+                         multi_ue_dl.decode_enable,
+                         pdsch_dec,
+                         dl_ack);
+
+    // Informs Stack about the decoding status, send NACK if cell is in process of re-selection
+    if (phy->cell_is_selecting) {
+      for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+        dl_ack[i] = false;
+      }
+    }
+    ue->stack->tb_decoded(cc_idx, multi_ue_dl.mac_grant, dl_ack);
+  }
+
+  /* Decode PHICH */
+  decode_phich();
+}
+
 bool cc_worker::work_dl_mbsfn(srsran_mbsfn_cfg_t mbsfn_cfg)
 {
   mac_interface_phy_lte::tb_action_dl_t dl_action = {};
@@ -328,8 +455,8 @@ bool cc_worker::work_dl_mbsfn(srsran_mbsfn_cfg_t mbsfn_cfg)
   }
 
   // Configure MBSFN settings
-  srsran_ue_dl_set_mbsfn_area_id(&ue_dl, mbsfn_cfg.mbsfn_area_id);
-  srsran_ue_dl_set_non_mbsfn_region(&ue_dl, mbsfn_cfg.non_mbsfn_region_length);
+  srsran_ue_dl_set_mbsfn_area_id(ue_dl, mbsfn_cfg.mbsfn_area_id);
+  srsran_ue_dl_set_non_mbsfn_region(ue_dl, mbsfn_cfg.non_mbsfn_region_length);
 
   sf_cfg_dl.sf_type = SRSRAN_SF_MBSFN;
 
@@ -338,7 +465,7 @@ bool cc_worker::work_dl_mbsfn(srsran_mbsfn_cfg_t mbsfn_cfg)
   ue_dl_cfg.chest_cfg           = chest_mbsfn_cfg;
 
   /* Do FFT and extract PDCCH LLR, or quit if no actions are required in this subframe */
-  if (srsran_ue_dl_decode_fft_estimate(&ue_dl, &sf_cfg_dl, &ue_dl_cfg) < 0) {
+  if (srsran_ue_dl_decode_fft_estimate(ue_dl, &sf_cfg_dl, &ue_dl_cfg) < 0) {
     Error("Getting PDCCH FFT estimate");
     return false;
   }
@@ -360,7 +487,7 @@ bool cc_worker::work_dl_mbsfn(srsran_mbsfn_cfg_t mbsfn_cfg)
     if (!decode_pmch(&dl_action, &mbsfn_cfg)) {
       mch_decoded = false;
     }
-    phy->stack->mch_decoded((uint32_t)pmch_cfg.pdsch_cfg.grant.tb[0].tbs / 8, mch_decoded, mch_payload_buffer);
+    ue->stack->mch_decoded((uint32_t)pmch_cfg.pdsch_cfg.grant.tb[0].tbs / 8, mch_decoded, mch_payload_buffer);
   } else if (mbsfn_cfg.is_mcch) {
     // release lock in phy_common
     phy->set_mch_period_stop(0);
@@ -399,11 +526,43 @@ void cc_worker::dl_phy_to_mac_grant(srsran_pdsch_grant_t*
   }
 }
 
+bool cc_worker::new_dl_grant(srsran_dci_dl_t* dci_dl, mac_interface_phy_lte::mac_grant_dl_t* mac_grant)
+{
+  // PDCCH order has no associated PDSCH to decode
+  if (not dci_dl->is_pdcch_order) {
+    // Read last TB from last retx for this pid
+    for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+      ue_dl_cfg.cfg.pdsch.grant.last_tbs[i] = ue->last_dl_tbs[dci_dl->pid][cc_idx][i];
+    }
+    // Generate PHY grant
+    if (srsran_ue_dl_dci_to_pdsch_grant(ue_dl, &sf_cfg_dl, &ue_dl_cfg, dci_dl, &ue_dl_cfg.cfg.pdsch.grant)) {
+      Info("Converting DCI message to DL dci");
+      return false;
+    }
+
+    // Save TB for next retx
+    for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+      ue->last_dl_tbs[dci_dl->pid][cc_idx][i] = ue_dl_cfg.cfg.pdsch.grant.last_tbs[i];
+    }
+
+    // Set RNTI
+    ue_dl_cfg.cfg.pdsch.rnti = dci_dl->rnti;
+  } else {
+    ue_dl_cfg.cfg.pdsch.rnti            = dci_dl->rnti;
+    ue_dl_cfg.cfg.pdsch.grant.tb[0].tbs = 0;
+  }
+
+  // Generate MAC grant
+  dl_phy_to_mac_grant(&ue_dl_cfg.cfg.pdsch.grant, dci_dl, mac_grant);
+
+  return true;
+}
+
 int cc_worker::decode_pdcch_dl()
 {
   int nof_grants = 0;
 
-  uint16_t dl_rnti = phy->stack->get_dl_sched_rnti(CURRENT_TTI);
+  uint16_t dl_rnti = ue->stack->get_dl_sched_rnti(CURRENT_TTI);
   if (dl_rnti != SRSRAN_INVALID_RNTI) {
     srsran_dci_dl_t dci[SRSRAN_MAX_CARRIERS] = {};
 
@@ -412,7 +571,7 @@ int cc_worker::decode_pdcch_dl()
       Debug("PDCCH looking for rnti=0x%x", dl_rnti);
       ue_dl_cfg.cfg.dci.cif_enabled = i > 0;
       ue_dl_cfg.cfg.dci_common_ss   = (cc_idx == 0);
-      nof_grants                    = srsran_ue_dl_find_dl_dci(&ue_dl, &sf_cfg_dl, &ue_dl_cfg, dl_rnti, dci);
+      nof_grants                    = srsran_ue_dl_find_dl_dci(ue_dl, &sf_cfg_dl, &ue_dl_cfg, dl_rnti, dci);
       if (nof_grants < 0) {
         Error("Looking for DL grants");
         return -1;
@@ -421,18 +580,18 @@ int cc_worker::decode_pdcch_dl()
 
     // If RAR dci, save TTI
     if (nof_grants > 0 && SRSRAN_RNTI_ISRAR(dl_rnti)) {
-      phy->set_rar_grant_tti(CURRENT_TTI);
+      ue->set_rar_grant_tti(CURRENT_TTI);
     }
 
     for (int k = 0; k < nof_grants; k++) {
       // Save dci to CC index
-      phy->set_dl_pending_grant(CURRENT_TTI, dci[k].cif_present ? dci[k].cif : cc_idx, cc_idx, &dci[k]);
+      ue->set_dl_pending_grant(CURRENT_TTI, dci[k].cif_present ? dci[k].cif : cc_idx, cc_idx, &dci[k]);
 
       // Logging
       if (logger.info.enabled()) {
         char str[512];
         srsran_dci_dl_info(&dci[k], str, 512);
-        logger.info("PDCCH: cc=%d, %s, snr=%.1f dB", cc_idx, str, ue_dl.chest_res.snr_db);
+        logger.info("PDCCH: cc=%d, %s, snr=%.1f dB", cc_idx, str, ue_dl->chest_res.snr_db);
       }
     }
   }
@@ -444,17 +603,39 @@ int cc_worker::decode_pdsch(srsran_pdsch_ack_resource_t            ack_resource,
                             bool                                   mac_acks[SRSRAN_MAX_CODEWORDS])
 {
   srsran_pdsch_res_t pdsch_dec[SRSRAN_MAX_CODEWORDS] = {};
+  bool               tb_enable[SRSRAN_MAX_CODEWORDS] = {};
+  uint8_t*           payload[SRSRAN_MAX_CODEWORDS]   = {};
 
   // See if at least 1 codeword needs to be decoded. If not need to be decode, resend ACK
-  bool decode_enable                   = false;
-  bool tb_enable[SRSRAN_MAX_CODEWORDS] = {};
+  bool decode_enable = prepare_pdsch(action, tb_enable, payload);
+  for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
+    pdsch_dec[tb].payload = payload[tb];
+  }
+
+  // Run PDSCH decoder
+  if (decode_enable) {
+    if (srsran_ue_dl_decode_pdsch(ue_dl, &sf_cfg_dl, &ue_dl_cfg.cfg.pdsch, pdsch_dec)) {
+      Error("ERROR: Decoding PDSCH");
+    }
+  }
+
+  process_pdsch_result(ack_resource, action, tb_enable, decode_enable, pdsch_dec, mac_acks);
+
+  return SRSRAN_SUCCESS;
+}
+
+bool cc_worker::prepare_pdsch(mac_interface_phy_lte::tb_action_dl_t* action,
+                              bool                                   tb_enable[SRSRAN_MAX_CODEWORDS],
+                              uint8_t*                               payload[SRSRAN_MAX_CODEWORDS])
+{
+  bool decode_enable = false;
   for (uint32_t tb = 0; tb < SRSRAN_MAX_CODEWORDS; tb++) {
     tb_enable[tb] = ue_dl_cfg.cfg.pdsch.grant.tb[tb].enabled;
     if (action->tb[tb].enabled) {
       decode_enable = true;
 
       // Prepare I/O based on action
-      pdsch_dec[tb].payload                  = action->tb[tb].payload;
+      payload[tb]                            = action->tb[tb].payload;
       ue_dl_cfg.cfg.pdsch.softbuffers.rx[tb] = action->tb[tb].softbuffer.rx;
 
       // Use RV from higher layers
@@ -465,14 +646,16 @@ int cc_worker::decode_pdsch(srsran_pdsch_ack_resource_t            ack_resource,
       ue_dl_cfg.cfg.pdsch.grant.tb[tb].enabled = false;
     }
   }
+  return decode_enable;
+}
 
-  // Run PDSCH decoder
-  if (decode_enable) {
-    if (srsran_ue_dl_decode_pdsch(&ue_dl, &sf_cfg_dl, &ue_dl_cfg.cfg.pdsch, pdsch_dec)) {
-      Error("ERROR: Decoding PDSCH");
-    }
-  }
-
+void cc_worker::process_pdsch_result(srsran_pdsch_ack_resource_t            ack_resource,
+                                     mac_interface_phy_lte::tb_action_dl_t* action,
+                                     bool                                   tb_enable[SRSRAN_MAX_CODEWORDS],
+                                     bool                                   decode_enable,
+                                     srsran_pdsch_res_t                     pdsch_dec[SRSRAN_MAX_CODEWORDS],
+                                     bool                                   mac_acks[SRSRAN_MAX_CODEWORDS])
+{
   // Generate ACKs for MAC and PUCCH
   uint32_t nof_tb                             = 0;
   uint8_t  pending_acks[SRSRAN_MAX_CODEWORDS] = {};
@@ -490,7 +673,7 @@ int cc_worker::decode_pdsch(srsran_pdsch_ack_resource_t            ack_resource,
   }
 
   if (action->generate_ack && nof_tb > 0) {
-    phy->set_dl_pending_ack(&sf_cfg_dl, cc_idx, pending_acks, ack_resource);
+    ue->set_dl_pending_ack(&sf_cfg_dl, cc_idx, pending_acks, ack_resource);
   }
 
   if (decode_enable) {
@@ -508,11 +691,9 @@ int cc_worker::decode_pdsch(srsran_pdsch_ack_resource_t            ack_resource,
     if (logger.info.enabled()) {
       char str[512];
       srsran_pdsch_rx_info(&ue_dl_cfg.cfg.pdsch, pdsch_dec, str, 512);
-      logger.info("PDSCH: cc=%d, %s, snr=%.1f dB", cc_idx, str, ue_dl.chest_res.snr_db);
+      logger.info("PDSCH: cc=%d, %s, snr=%.1f dB", cc_idx, str, ue_dl->chest_res.snr_db);
     }
   }
-
-  return SRSRAN_SUCCESS;
 }
 
 int cc_worker::decode_pmch(mac_interface_phy_lte::tb_action_dl_t* action, srsran_mbsfn_cfg_t* mbsfn_cfg)
@@ -526,7 +707,7 @@ int cc_worker::decode_pmch(mac_interface_phy_lte::tb_action_dl_t* action, srsran
   if (action->tb[0].enabled) {
     srsran_softbuffer_rx_reset_tbs(pmch_cfg.pdsch_cfg.softbuffers.rx[0], pmch_cfg.pdsch_cfg.grant.tb[0].tbs);
 
-    if (srsran_ue_dl_decode_pmch(&ue_dl, &sf_cfg_dl, &pmch_cfg, &pmch_dec)) {
+    if (srsran_ue_dl_decode_pmch(ue_dl, &sf_cfg_dl, &pmch_cfg, &pmch_dec)) {
       Error("Decoding PMCH");
       return -1;
     }
@@ -543,7 +724,7 @@ int cc_worker::decode_pmch(mac_interface_phy_lte::tb_action_dl_t* action, srsran
          pmch_cfg.pdsch_cfg.grant.tb[0].tbs / 8,
          pmch_cfg.pdsch_cfg.grant.tb[0].mcs_idx,
          pmch_dec.crc ? "OK" : "KO",
-         ue_dl.chest_res.snr_db,
+         ue_dl->chest_res.snr_db,
          pmch_dec.avg_iterations_block);
 
     if (pmch_dec.crc) {
@@ -565,11 +746,11 @@ void cc_worker::decode_phich()
   // Receive PHICH, in TDD might be more than one
   for (uint32_t I_phich = 0; I_phich < 2; I_phich++) {
     phich_grant.I_phich = I_phich;
-    if (phy->get_ul_pending_ack(&sf_cfg_dl, cc_idx, &phich_grant, &dci_ul)) {
-      if (srsran_ue_dl_decode_phich(&ue_dl, &sf_cfg_dl, &ue_dl_cfg, &phich_grant, &phich_res)) {
+    if (ue->get_ul_pending_ack(&sf_cfg_dl, cc_idx, &phich_grant, &dci_ul)) {
+      if (srsran_ue_dl_decode_phich(ue_dl, &sf_cfg_dl, &ue_dl_cfg, &phich_grant, &phich_res)) {
         Error("Decoding PHICH");
       }
-      phy->set_ul_received_ack(&sf_cfg_dl, cc_idx, phich_res.ack_value, I_phich, &dci_ul);
+      ue->set_ul_received_ack(&sf_cfg_dl, cc_idx, phich_res.ack_value, I_phich, &dci_ul);
       Info("PHICH: hi=%d, corr=%.1f, I_lowest=%d, n_dmrs=%d, I_phich=%d",
            phich_res.ack_value,
            phich_res.distance,
@@ -588,7 +769,7 @@ void cc_worker::update_measurements(std::vector<phy_meas_t>& serving_cells, cf_t
   }
 
   phy->update_measurements(
-      cc_idx, ue_dl.chest_res, sf_cfg_dl, ue_dl_cfg.cfg.pdsch.rs_power, serving_cells, rssi_power_buffer);
+      cc_idx, ue_dl->chest_res, sf_cfg_dl, ue_dl_cfg.cfg.pdsch.rs_power, serving_cells, rssi_power_buffer);
 }
 
 /************
@@ -611,9 +792,9 @@ bool cc_worker::work_ul(srsran_uci_data_t* uci_data)
     return false;
   }
 
-  bool ul_grant_available = phy->get_ul_pending_grant(&sf_cfg_ul, cc_idx, &pid, &dci_ul);
+  bool ul_grant_available = ue->get_ul_pending_grant(&sf_cfg_ul, cc_idx, &pid, &dci_ul);
   ul_mac_grant.phich_available =
-      phy->get_ul_received_ack(&sf_cfg_ul, cc_idx, &ul_mac_grant.hi_value, ul_grant_available ? nullptr : &dci_ul);
+      ue->get_ul_received_ack(&sf_cfg_ul, cc_idx, &ul_mac_grant.hi_value, ul_grant_available ? nullptr : &dci_ul);
 
   // If there is no grant, pid is from current TX TTI
   if (!ul_grant_available) {
@@ -631,7 +812,7 @@ bool cc_worker::work_ul(srsran_uci_data_t* uci_data)
   /* Send UL dci or HARQ information (from PHICH) to MAC and receive actions*/
   if (ul_grant_available || ul_mac_grant.phich_available) {
     // Read last TB info from last retx for this PID
-    ue_ul_cfg.ul_cfg.pusch.grant.last_tb = phy->last_ul_tb[pid][cc_idx];
+    ue_ul_cfg.ul_cfg.pusch.grant.last_tb = ue->last_ul_tb[pid][cc_idx];
 
     // Generate PHY grant
     if (srsran_ue_ul_dci_to_pusch_grant(&ue_ul, &sf_cfg_ul, &ue_ul_cfg, &dci_ul, &ue_ul_cfg.ul_cfg.pusch.grant)) {
@@ -646,12 +827,12 @@ bool cc_worker::work_ul(srsran_uci_data_t* uci_data)
       ul_grant_available = false;
     } else {
       // Save TBS info for next retx
-      phy->last_ul_tb[pid][cc_idx] = ue_ul_cfg.ul_cfg.pusch.grant.tb;
+      ue->last_ul_tb[pid][cc_idx] = ue_ul_cfg.ul_cfg.pusch.grant.tb;
 
       // Fill MAC dci
       ul_phy_to_mac_grant(&ue_ul_cfg.ul_cfg.pusch.grant, &dci_ul, pid, ul_grant_available, &ul_mac_grant);
 
-      phy->stack->new_grant_ul(cc_idx, ul_mac_grant, &ul_action);
+      ue->stack->new_grant_ul(cc_idx, ul_mac_grant, &ul_action);
 
       // Calculate PUSCH Hopping procedure
       ue_ul_cfg.ul_cfg.hopping.current_tx_nb = ul_action.current_tx_nb;
@@ -663,7 +844,7 @@ bool cc_worker::work_ul(srsran_uci_data_t* uci_data)
   if (ul_grant_available || ul_mac_grant.phich_available) {
     ue_ul_cfg.ul_cfg.pusch.rnti = dci_ul.rnti;
   } else {
-    ue_ul_cfg.ul_cfg.pucch.rnti = phy->stack->get_ul_sched_rnti(CURRENT_TTI_TX);
+    ue_ul_cfg.ul_cfg.pucch.rnti = ue->stack->get_ul_sched_rnti(CURRENT_TTI_TX);
   }
 
   // PCell sends SR and ACK
@@ -688,7 +869,7 @@ bool cc_worker::work_ul(srsran_uci_data_t* uci_data)
     phich_grant.n_prb_lowest = ue_ul_cfg.ul_cfg.pusch.grant.n_prb_tilde[0];
     phich_grant.n_dmrs       = ue_ul_cfg.ul_cfg.pusch.grant.n_dmrs;
 
-    phy->set_ul_pending_ack(&sf_cfg_ul, cc_idx, phich_grant, &dci_ul);
+    ue->set_ul_pending_ack(&sf_cfg_ul, cc_idx, phich_grant, &dci_ul);
   }
 
   return signal_ready;
@@ -701,7 +882,7 @@ void cc_worker::ul_phy_to_mac_grant(srsran_pusch_grant_t*
                                     srsue::mac_interface_phy_lte::mac_grant_ul_t* mac_grant)
 {
   if (mac_grant->phich_available && !dci_ul->rnti) {
-    mac_grant->rnti = phy->stack->get_ul_sched_rnti(CURRENT_TTI);
+    mac_grant->rnti = ue->stack->get_ul_sched_rnti(CURRENT_TTI);
   } else {
     mac_grant->rnti = dci_ul->rnti;
   }
@@ -721,14 +902,14 @@ int cc_worker::decode_pdcch_ul()
   srsran_dci_ul_t dci[SRSRAN_MAX_CARRIERS];
   ZERO_OBJECT(dci);
 
-  uint16_t ul_rnti = phy->stack->get_ul_sched_rnti(CURRENT_TTI);
+  uint16_t ul_rnti = ue->stack->get_ul_sched_rnti(CURRENT_TTI);
 
   if (ul_rnti) {
     /* Blind search first without cross scheduling then with it if enabled */
     for (int i = 0; i < (ue_dl_cfg.cfg.dci.cif_present ? 2 : 1) && !nof_grants; i++) {
       ue_dl_cfg.cfg.dci.cif_enabled = i > 0;
       ue_dl_cfg.cfg.dci_common_ss   = (cc_idx == 0);
-      nof_grants                    = srsran_ue_dl_find_ul_dci(&ue_dl, &sf_cfg_dl, &ue_dl_cfg, ul_rnti, dci);
+      nof_grants                    = srsran_ue_dl_find_ul_dci(ue_dl, &sf_cfg_dl, &ue_dl_cfg, ul_rnti, dci);
       if (nof_grants < 0) {
         Error("Looking for UL grants");
         return -1;
@@ -741,13 +922,13 @@ int cc_worker::decode_pdcch_ul()
       uint32_t cc_idx_grant = dci[k].cif_present ? dci[k].cif : cc_idx;
 
       // Save DCI
-      phy->set_ul_pending_grant(&sf_cfg_dl, cc_idx_grant, &dci[k]);
+      ue->set_ul_pending_grant(&sf_cfg_dl, cc_idx_grant, &dci[k]);
 
       // Logging
       if (logger.info.enabled()) {
         char str[512];
         srsran_dci_ul_info(&dci[k], str, 512);
-        logger.info("PDCCH: cc=%d, %s, snr=%.1f dB", cc_idx_grant, str, ue_dl.chest_res.snr_db);
+        logger.info("PDCCH: cc=%d, %s, snr=%.1f dB", cc_idx_grant, str, ue_dl->chest_res.snr_db);
       }
     }
   }
@@ -783,7 +964,7 @@ bool cc_worker::encode_uplink(mac_interface_phy_lte::tb_action_ul_t* action, srs
   }
 
   // Set UL RNTI
-  ue_ul_cfg.ul_cfg.pucch.rnti = phy->stack->get_ul_sched_rnti(CURRENT_TTI_TX);
+  ue_ul_cfg.ul_cfg.pucch.rnti = ue->stack->get_ul_sched_rnti(CURRENT_TTI_TX);
 
   // Check if the RNTI is valid. Early return without transmitting any signal if the RNTI is invalid.
   if (ue_ul_cfg.ul_cfg.pucch.rnti == SRSRAN_INVALID_RNTI) {
@@ -817,9 +998,9 @@ bool cc_worker::encode_uplink(mac_interface_phy_lte::tb_action_ul_t* action, srs
 
 void cc_worker::set_uci_sr(srsran_uci_data_t* uci_data)
 {
-  Debug("set_uci_sr() query: sr_enabled=%d, last_tx_tti=%d", phy->sr.is_triggered(), phy->sr.get_last_tx_tti());
-  if (srsran_ue_ul_gen_sr(&ue_ul_cfg, &sf_cfg_ul, uci_data, phy->sr.is_triggered())) {
-    if (phy->sr.set_last_tx_tti(CURRENT_TTI_TX)) {
+  Debug("set_uci_sr() query: sr_enabled=%d, last_tx_tti=%d", ue->sr.is_triggered(), ue->sr.get_last_tx_tti());
+  if (srsran_ue_ul_gen_sr(&ue_ul_cfg, &sf_cfg_ul, uci_data, ue->sr.is_triggered())) {
+    if (ue->sr.set_last_tx_tti(CURRENT_TTI_TX)) {
       Debug("set_uci_sr() sending SR: sr_enabled=true, last_tx_tti=%d", CURRENT_TTI_TX);
     }
   }
@@ -844,21 +1025,21 @@ uint32_t cc_worker::get_wideband_cqi()
 void cc_worker::set_uci_periodic_cqi(srsran_uci_data_t* uci_data)
 {
   // Load last reported RI
-  ue_dl_cfg.last_ri = phy->last_ri;
+  ue_dl_cfg.last_ri = ue->last_ri;
 
-  srsran_ue_dl_gen_cqi_periodic(&ue_dl, &ue_dl_cfg, get_wideband_cqi(), CURRENT_TTI_TX, uci_data);
+  srsran_ue_dl_gen_cqi_periodic(ue_dl, &ue_dl_cfg, get_wideband_cqi(), CURRENT_TTI_TX, uci_data);
 
   // Store serving cell index for logging purposes
   uci_data->cfg.cqi.scell_index = cc_idx;
 
   // Store the reported RI
-  phy->last_ri = ue_dl_cfg.last_ri;
+  ue->last_ri = ue_dl_cfg.last_ri;
 }
 
 void cc_worker::set_uci_aperiodic_cqi(srsran_uci_data_t* uci_data)
 {
   if (ue_dl_cfg.cfg.cqi_report.aperiodic_configured) {
-    srsran_ue_dl_gen_cqi_aperiodic(&ue_dl, &ue_dl_cfg, get_wideband_cqi(), uci_data);
+    srsran_ue_dl_gen_cqi_aperiodic(ue_dl, &ue_dl_cfg, get_wideband_cqi(), uci_data);
   } else {
     Warning("Received CQI request but aperiodic mode is not configured");
   }
@@ -875,7 +1056,7 @@ void cc_worker::set_uci_ack(srsran_uci_data_t* uci_data,
   // Only PCell generates ACK for all SCell
   for (uint32_t i = 0; i < phy->args->nof_lte_carriers; i++) {
     if (phy->cell_state.is_configured(i)) {
-      phy->get_dl_pending_ack(&sf_cfg_ul, i, &ack_info.cc[i]);
+      ue->get_dl_pending_ack(&sf_cfg_ul, i, &ack_info.cc[i]);
       nof_configured_carriers++;
     }
   }
@@ -891,7 +1072,7 @@ void cc_worker::set_uci_ack(srsran_uci_data_t* uci_data,
   ack_info.transmission_mode      = ue_dl_cfg.cfg.tm;
 
   // Generate ACK/NACK bits
-  srsran_ue_dl_gen_ack(&ue_dl.cell, &sf_cfg_dl, &ack_info, uci_data);
+  srsran_ue_dl_gen_ack(&ue_dl->cell, &sf_cfg_dl, &ack_info, uci_data);
 }
 
 /************
@@ -921,13 +1102,13 @@ int cc_worker::read_ce_abs(float* ce_abs, uint32_t tx_antenna, uint32_t rx_anten
   uint32_t sz = (uint32_t)srsran_symbol_sz(cell.nof_prb);
   srsran_vec_f_zero(ce_abs, sz);
   int g = (sz - 12 * cell.nof_prb) / 2;
-  srsran_vec_abs_dB_cf(ue_dl.chest_res.ce[tx_antenna][rx_antenna], -80, &ce_abs[g], SRSRAN_NRE * cell.nof_prb);
+  srsran_vec_abs_dB_cf(ue_dl->chest_res.ce[tx_antenna][rx_antenna], -80, &ce_abs[g], SRSRAN_NRE * cell.nof_prb);
   return sz;
 }
 
 int cc_worker::read_pdsch_d(cf_t* pdsch_d)
 {
-  memcpy(pdsch_d, ue_dl.pdsch.d[0], ue_dl_cfg.cfg.pdsch.grant.nof_re * sizeof(cf_t));
+  memcpy(pdsch_d, ue_dl->pdsch.d[0], ue_dl_cfg.cfg.pdsch.grant.nof_re * sizeof(cf_t));
   return ue_dl_cfg.cfg.pdsch.grant.nof_re;
 }
 
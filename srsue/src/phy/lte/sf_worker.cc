@@ -64,6 +64,17 @@ sf_worker::sf_worker(uint32_t max_prb, phy_common* phy_, srslog::basic_logger& l
   for (uint32_t r = 0; r < phy->args->nof_lte_carriers; r++) {
     cc_workers.push_back(new cc_worker(r, max_prb, phy, logger));
   }
+
+  // The other UEs sharing the PHY are served on the PCell from the subframes received by the first worker
+  if (phy->get_nof_ue() > 1) {
+    ue_workers.push_back(cc_workers[0]);
+    for (uint32_t ue_idx = 1; ue_idx < phy->get_nof_ue(); ue_idx++) {
+      ue_workers.push_back(new cc_worker(0, max_prb, phy, logger, ue_idx, cc_workers[0]));
+    }
+    tx_mix_buffer = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB(max_prb));
+  }
+  prach_ptr.resize(phy->get_nof_ue());
+  prach_power.resize(phy->get_nof_ue());
 }
 
 sf_worker::~sf_worker()
@@ -71,11 +82,22 @@ sf_worker::~sf_worker()
   for (uint32_t r = 0; r < phy->args->nof_lte_carriers; r++) {
     delete cc_workers[r];
   }
+  for (uint32_t ue_idx = 1; ue_idx < ue_workers.size(); ue_idx++) {
+    delete ue_workers[ue_idx];
+  }
+  if (tx_mix_buffer != nullptr) {
+    free(tx_mix_buffer);
+  }
 }
 
 void sf_worker::reset_cell_nolock(uint32_t cc_idx)
 {
   cc_workers[cc_idx]->reset_cell_nolock();
+  if (cc_idx == 0) {
+    for (uint32_t ue_idx = 1; ue_idx < ue_workers.size(); ue_idx++) {
+      ue_workers[ue_idx]->reset_cell_nolock();
+    }
+  }
 }
 
 bool sf_worker::set_cell_nolock(uint32_t cc_idx, srsran_cell_t cell_)
@@ -90,6 +112,13 @@ bool sf_worker::set_cell_nolock(uint32_t cc_idx, srsran_cell_t cell_)
   }
 
   if (cc_idx == 0) {
+    for (uint32_t ue_idx = 1; ue_idx < ue_workers.size(); ue_idx++) {
+      if (!ue_workers[ue_idx]->set_cell_nolock(cell_)) {
+        Error("Setting cell for ue=%d", ue_idx);
+        return false;
+      }
+    }
+
     std::lock_guard<std::mutex> lock(cell_mutex);
     cell           = cell_;
     cell_initiated = true;
@@ -119,19 +148,27 @@ void sf_worker::set_context(const srsran::phy_common_interface::worker_context_t
   for (auto& cc_worker : cc_workers) {
     cc_worker->set_tti(w_ctx.sf_idx);
   }
+  for (uint32_t ue_idx = 1; ue_idx < ue_workers.size(); ue_idx++) {
+    ue_workers[ue_idx]->set_tti(w_ctx.sf_idx);
+  }
 
   logger.set_context(w_ctx.sf_idx);
 }
 
-void sf_worker::set_prach(cf_t* prach_ptr_, float prach_power_)
+void sf_worker::set_prach(cf_t* prach_ptr_, float prach_power_, uint32_t ue_idx)
 {
-  prach_ptr   = prach_ptr_;
-  prach_power = prach_power_;
+  prach_ptr[ue_idx]   = prach_ptr_;
+  prach_power[ue_idx] = prach_power_;
 }
 
 void sf_worker::set_cfo_nolock(const uint32_t& cc_idx, float cfo)
 {
   cc_workers[cc_idx]->set_cfo_nolock(cfo);
+  if (cc_idx == 0) {
+    for (uint32_t ue_idx = 1; ue_idx < ue_workers.size(); ue_idx++) {
+      ue_workers[ue_idx]->set_cfo_nolock(cfo);
+    }
+  }
 }
 
 void sf_worker::set_tdd_config_nolock(srsran_tdd_config_t config)
@@ -139,12 +176,21 @@ void sf_worker::set_tdd_config_nolock(srsran_tdd_config_t config)
   for (auto& cc_worker : cc_workers) {
     cc_worker->set_tdd_config_nolock(config);
   }
+  for (uint32_t ue_idx = 1; ue_idx < ue_workers.size(); ue_idx++) {
+    ue_workers[ue_idx]->set_tdd_config_nolock(config);
+  }
   tdd_config = config;
 }
 
-void sf_worker::set_config_nolock(uint32_t cc_idx, const srsran::phy_cfg_t& phy_cfg)
+void sf_worker::set_config_nolock(uint32_t cc_idx, const srsran::phy_cfg_t& phy_cfg, uint32_t ue_idx)
 {
-  if (cc_idx < cc_workers.size()) {
+  if (ue_idx > 0) {
+    if (cc_idx == 0 && ue_idx < ue_workers.size()) {
+      ue_workers[ue_idx]->set_config_nolock(phy_cfg);
+    } else {
+      Error("Setting config for cc=%d; Invalid ue_idx=%d", cc_idx, ue_idx);
+    }
+  } else if (cc_idx < cc_workers.size()) {
     cc_workers[cc_idx]->set_config_nolock(phy_cfg);
     if (cc_idx > 0) {
       // Update DCI config for PCell
@@ -180,6 +226,15 @@ void sf_worker::work_imp()
       if (carrier_idx == 0 && phy->is_mbsfn_sf(&mbsfn_cfg, tti)) {
         rx_signal_ok =
             cc_workers[0]->work_dl_mbsfn(mbsfn_cfg); // Don't do chest_ok in mbsfn since it trigger measurements
+
+        // The MCH is only received by the first UE, the others still need their HARQ feedback
+        for (uint32_t ue_idx = 1; ue_idx < ue_workers.size(); ue_idx++) {
+          ue_workers[ue_idx]->decode_phich();
+        }
+      } else if (carrier_idx == 0 && not ue_workers.empty()) {
+        if (phy->cell_state.is_configured(carrier_idx)) {
+          rx_signal_ok = cc_workers[0]->work_dl_multi_ue(ue_workers);
+        }
       } else {
         if (phy->cell_state.is_configured(carrier_idx)) {
           rx_signal_ok = cc_workers[carrier_idx]->work_dl_regular();
@@ -192,14 +247,21 @@ void sf_worker::work_imp()
   /***** Uplink Generation + Transmission *******/
 
   /* If TTI+4 is an uplink subframe (TODO: Support short PRACH and SRS in UpPts special subframes) */
-  if ((srsran_sfidx_tdd_type(tdd_config, TTI_TX(tti) % 10) == SRSRAN_TDD_SF_U) || cell.frame_type == SRSRAN_FDD) {
+  bool ul_sf = srsran_sfidx_tdd_type(tdd_config, TTI_TX(tti) % 10) == SRSRAN_TDD_SF_U || cell.frame_type == SRSRAN_FDD;
+  if (not ue_workers.empty()) {
+    // Several UEs share the PHY, their PCell signals are added up
+    if (work_ul_multi_ue(ul_sf, nof_samples)) {
+      tx_signal_ready = true;
+      tx_signal_ptr.set(0, tx_mix_buffer);
+    }
+  } else if (ul_sf) {
     // Generate Uplink signal if no PRACH pending
-    if (!prach_ptr) {
+    if (!prach_ptr[0]) {
       // Common UCI data object for all carriers
       srsran_uci_data_t uci_data;
       reset_uci(&uci_data);
 
-      uint32_t uci_cc_idx = phy->get_ul_uci_cc(TTI_TX(tti));
+      uint32_t uci_cc_idx = phy->get_ue(0).get_ul_uci_cc(TTI_TX(tti));
 
       // Fill periodic CQI data; In case of periodic CSI report collision, lower carrier index have preference, so
       // stop as soon as either CQI data is enabled or RI is carried
@@ -224,10 +286,10 @@ void sf_worker::work_imp()
   }
 
   // Set PRACH buffer signal pointer
-  if (prach_ptr) {
+  if (prach_ptr[0] && ue_workers.empty()) {
     tx_signal_ready = true;
-    tx_signal_ptr.set(0, prach_ptr);
-    prach_ptr = nullptr;
+    tx_signal_ptr.set(0, prach_ptr[0]);
+    prach_ptr[0] = nullptr;
   }
 
   // Call worker_end to transmit the signal
@@ -247,6 +309,39 @@ void sf_worker::work_imp()
 
 /********************* Uplink common control functions ****************************/
 
+bool sf_worker::work_ul_multi_ue(bool ul_sf, uint32_t nof_samples)
+{
+  uint32_t tti       = context.sf_idx;
+  bool     tx_mixed  = false;
+  bool     is_active = phy->cell_state.is_active(0, tti);
+
+  srsran_vec_cf_zero(tx_mix_buffer, nof_samples);
+  for (uint32_t ue_idx = 0; ue_idx < ue_workers.size(); ue_idx++) {
+    cf_t* ue_signal = nullptr;
+
+    // A pending PRACH replaces the uplink of its UE
+    if (prach_ptr[ue_idx]) {
+      ue_signal         = prach_ptr[ue_idx];
+      prach_ptr[ue_idx] = nullptr;
+    } else if (ul_sf && is_active) {
+      srsran_uci_data_t uci_data;
+      reset_uci(&uci_data);
+      if (phy->cell_state.is_active(0, TTI_TX(tti))) {
+        ue_workers[ue_idx]->set_uci_periodic_cqi(&uci_data);
+      }
+      if (ue_workers[ue_idx]->work_ul(&uci_data)) {
+        ue_signal = ue_workers[ue_idx]->get_tx_buffer(0);
+      }
+    }
+
+    if (ue_signal != nullptr) {
+      srsran_vec_sum_ccc(tx_mix_buffer, ue_signal, tx_mix_buffer, nof_samples);
+      tx_mixed = true;
+    }
+  }
+  return tx_mixed;
+}
+
 void sf_worker::reset_uci(srsran_uci_data_t* uci_data)
 {
   srsran_uci_data_reset(uci_data);
@@ -267,7 +362,7 @@ void sf_worker::update_measurements()
   }
   // Send report to stack
   if (not serving_cells.empty()) {
-    phy->stack->new_cell_meas(serving_cells);
+    phy->for_each_stack([&serving_cells](stack_interface_phy_lte* stack) { stack->new_cell_meas(serving_cells); });
   }
 }
 
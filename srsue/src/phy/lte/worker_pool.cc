@@ -49,11 +49,14 @@ const srsran::phy_cfg_t& worker_pool::phy_cfg_stash_t::get_cfg(uint32_t sf_idx)
 }
 
 worker_pool::worker_pool(uint32_t max_workers) :
-  pool(max_workers), phy_cfg_stash{{max_workers, max_workers, max_workers, max_workers, max_workers}}
+  pool(max_workers), phy_cfg_stash(SRSRAN_MAX_CARRIERS, phy_cfg_stash_t(max_workers))
 {}
 
 bool worker_pool::init(phy_common* common, int prio)
 {
+  // Every UE sharing the PHY has its own configuration
+  phy_cfg_stash.resize(SRSRAN_MAX_CARRIERS * common->get_nof_ue(), phy_cfg_stash_t(pool.get_nof_workers()));
+
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < common->args->nof_phy_threads; i++) {
     srslog::basic_logger& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i));
@@ -85,9 +88,9 @@ sf_worker* worker_pool::wait_worker(uint32_t tti)
 
   // Iterate all CC searching for a pending configuration
   uint32_t worker_id = w->get_id();
-  for (uint32_t cc_idx = 0; cc_idx < SRSRAN_MAX_CARRIERS; cc_idx++) {
-    if (phy_cfg_stash[cc_idx].is_pending(worker_id)) {
-      w->set_config_nolock(cc_idx, phy_cfg_stash[cc_idx].get_cfg(worker_id));
+  for (uint32_t i = 0; i < phy_cfg_stash.size(); i++) {
+    if (phy_cfg_stash[i].is_pending(worker_id)) {
+      w->set_config_nolock(i % SRSRAN_MAX_CARRIERS, phy_cfg_stash[i].get_cfg(worker_id), i / SRSRAN_MAX_CARRIERS);
     }
   }
 
@@ -104,16 +107,17 @@ void worker_pool::stop()
   pool.stop();
 }
 
-void worker_pool::set_config(uint32_t cc_idx, const srsran::phy_cfg_t& phy_cfg)
+void worker_pool::set_config(uint32_t cc_idx, const srsran::phy_cfg_t& phy_cfg, uint32_t ue_idx)
 {
-  // Protect CC index bounds
-  if (cc_idx >= SRSRAN_MAX_CARRIERS) {
+  // Protect CC and UE index bounds
+  uint32_t stash_idx = ue_idx * SRSRAN_MAX_CARRIERS + cc_idx;
+  if (cc_idx >= SRSRAN_MAX_CARRIERS || stash_idx >= phy_cfg_stash.size()) {
     return;
   }
 
   // Protect configuration
   std::unique_lock<std::mutex> lock(phy_cfg_mutex);
-  phy_cfg_stash[cc_idx].set_cfg(phy_cfg);
+  phy_cfg_stash[stash_idx].set_cfg(phy_cfg);
 }
 }; // namespace lte
 }; // namespace srsue
\ No newline at end of file
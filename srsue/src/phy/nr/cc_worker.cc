@@ -347,6 +347,7 @@ bool cc_worker::decode_pdsch_dl()
   mac_dl_result.payload     = mac_dl_result.ack ? std::move(data) : nullptr; // only pass data when successful
   phy.stack->tb_decoded(cc_idx, mac_dl_grant, std::move(mac_dl_result));
 
+  phy.set_dl_fec_metrics(pdsch_res.tb[0]);
   if (pdsch_res.tb[0].crc) {
     // Generate DL metrics
     dl_metrics_t dl_m = {};
@@ -101,14 +101,36 @@ bool phy::check_args(const phy_args_t& args_)
 }
 
 int phy::init(const phy_args_t& args_, stack_interface_phy_lte* stack_, srsran::radio_interface_phy* radio_)
+{
+  return init(args_, std::vector<stack_interface_phy_lte*>{stack_}, radio_);
+}
+
+int phy::init(const phy_args_t&                            args_,
+              const std::vector<stack_interface_phy_lte*>& stacks_,
+              srsran::radio_interface_phy*                 radio_)
 {
   std::unique_lock<std::mutex> lock(config_mutex);
 
-  stack = stack_;
-  radio = radio_;
+  if (stacks_.empty() || stacks_.size() != args_.nof_ue) {
+    srsran::console("Error in PHY args: %zd stacks given for nof_ue=%d\n", stacks_.size(), args_.nof_ue);
+    return SRSRAN_ERROR;
+  }
+
+  stacks = stacks_;
+  stack  = stacks.front();
+  radio  = radio_;
 
   args = args_;
 
+  // Every UE has its own PRACH, the additional UEs access the PHY through a phy_ue
+  prach_buffers.clear();
+  ue_phys.clear();
+  for (uint32_t ue_idx = 0; ue_idx < stacks.size(); ue_idx++) {
+    prach_buffers.emplace_back(new prach(logger_phy));
+    ue_phys.emplace_back(ue_idx == 0 ? nullptr : new phy_ue(*this, ue_idx));
+  }
+  ue_cell_procs.assign(stacks.size(), UE_CELL_PROC_NONE);
+
   // Force frequency if given as argument
   if (args.dl_freq > 0 && args.ul_freq > 0) {
     sfsync.force_freq(args.dl_freq, args.ul_freq);
@@ -136,18 +158,29 @@ int phy::init(const phy_args_t& args_, stack_interface_phy_lte* stack_, srsran::
 }
 
 // Initializes PHY in a thread
+phy_interface_stack_lte* phy::get_ue_phy(uint32_t ue_idx)
+{
+  if (ue_idx == 0) {
+    return this;
+  }
+  return ue_idx < ue_phys.size() ? ue_phys[ue_idx].get() : nullptr;
+}
+
 void phy::run_thread()
 {
   std::unique_lock<std::mutex> lock(config_mutex);
-  prach_buffer.init(SRSRAN_MAX_PRB);
-  common.init(&args, radio, stack, &sfsync);
+  std::vector<prach*> prachs;
+  for (auto& prach_buffer : prach_buffers) {
+    prach_buffer->init(SRSRAN_MAX_PRB);
+    prachs.push_back(prach_buffer.get());
+  }
+  common.init(&args, radio, stacks, &sfsync);
 
   // Initialise workers
   lte_workers.init(&common, WORKERS_THREAD_PRIO);
 
   // Warning this must be initialized after all workers have been added to the pool
-  sfsync.init(
-      radio, stack, &prach_buffer, &lte_workers, &nr_workers, &common, SF_RECV_THREAD_PRIO, args.sync_cpu_affinity);
+  sfsync.init(radio, prachs, &lte_workers, &nr_workers, &common, SF_RECV_THREAD_PRIO, args.sync_cpu_affinity);
 
   is_configured = true;
   config_cond.notify_all();
@@ -176,7 +209,9 @@ void phy::stop()
     sfsync.stop();
     lte_workers.stop();
     nr_workers.stop();
-    prach_buffer.stop();
+    for (auto& prach_buffer : prach_buffers) {
+      prach_buffer->stop();
+    }
     wait_thread_finish();
 
     is_configured = false;
@@ -221,12 +256,12 @@ void phy::get_metrics(const srsran::srsran_rat_t& rat, phy_metrics_t* m)
 
 void phy::set_timeadv_rar(uint32_t tti, uint32_t ta_cmd)
 {
-  common.ta.add_ta_cmd_rar(tti, ta_cmd);
+  common.get_ue(0).ta.add_ta_cmd_rar(tti, ta_cmd);
 }
 
 void phy::set_timeadv(uint32_t tti, uint32_t ta_cmd)
 {
-  common.ta.add_ta_cmd_new(tti, ta_cmd);
+  common.get_ue(0).ta.add_ta_cmd_new(tti, ta_cmd);
 }
 
 void phy::deactivate_scells()
@@ -243,8 +278,10 @@ void phy::configure_prach_params()
 {
   Debug("Configuring PRACH parameters");
 
-  if (!prach_buffer.set_cell(selected_cell, prach_cfg)) {
-    Error("Configuring PRACH parameters");
+  for (auto& prach_buffer : prach_buffers) {
+    if (!prach_buffer->set_cell(selected_cell, prach_cfg)) {
+      Error("Configuring PRACH parameters");
+    }
   }
 }
 
@@ -342,6 +379,9 @@ bool phy::cell_select(phy_cell_t cell)
 
       // Indicate workers that cell selection has finished
       common.cell_is_selecting = false;
+
+      // The other UEs camp on the cell of the first one
+      complete_ue_cell_procedures(ret);
     });
     return true;
   } else {
@@ -379,6 +419,66 @@ bool phy::cell_is_camping()
   return sfsync.cell_is_camping();
 }
 
+// The additional UEs do not search or select a cell on their own. Their procedure waits for the first UE to camp on
+// a cell and completes with the cell of the first UE.
+bool phy::cell_search_ue(uint32_t ue_idx)
+{
+  {
+    std::lock_guard<std::mutex> lock(ue_cell_mutex);
+    ue_cell_procs[ue_idx] = UE_CELL_PROC_SEARCH;
+  }
+
+  if (sfsync.cell_is_camping() and not common.cell_is_selecting) {
+    complete_ue_cell_procedures(true);
+  }
+  return true;
+}
+
+bool phy::cell_select_ue(uint32_t ue_idx, phy_cell_t cell)
+{
+  if (cell.pci != selected_cell.id or cell.earfcn != selected_earfcn) {
+    logger_phy.warning("UE %d can not select pci=%d, earfcn=%d. The PHY is on pci=%d, earfcn=%d",
+                       ue_idx,
+                       cell.pci,
+                       cell.earfcn,
+                       selected_cell.id,
+                       selected_earfcn);
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(ue_cell_mutex);
+    ue_cell_procs[ue_idx] = UE_CELL_PROC_SELECT;
+  }
+
+  if (sfsync.cell_is_camping() and not common.cell_is_selecting) {
+    complete_ue_cell_procedures(true);
+  }
+  return true;
+}
+
+void phy::complete_ue_cell_procedures(bool camping)
+{
+  std::lock_guard<std::mutex> lock(ue_cell_mutex);
+
+  phy_cell_t serving_cell = {};
+  serving_cell.pci        = selected_cell.id;
+  serving_cell.earfcn     = selected_earfcn;
+
+  for (uint32_t ue_idx = 1; ue_idx < ue_cell_procs.size(); ue_idx++) {
+    if (ue_cell_procs[ue_idx] == UE_CELL_PROC_SEARCH) {
+      rrc_interface_phy_lte::cell_search_ret_t ret = {};
+      ret.found     = camping ? rrc_interface_phy_lte::cell_search_ret_t::CELL_FOUND
+                              : rrc_interface_phy_lte::cell_search_ret_t::CELL_NOT_FOUND;
+      ret.last_freq = rrc_interface_phy_lte::cell_search_ret_t::NO_MORE_FREQS;
+      stacks[ue_idx]->cell_search_complete(ret, serving_cell);
+    } else if (ue_cell_procs[ue_idx] == UE_CELL_PROC_SELECT) {
+      stacks[ue_idx]->cell_select_complete(camping);
+    }
+    ue_cell_procs[ue_idx] = UE_CELL_PROC_NONE;
+  }
+}
+
 float phy::get_phr()
 {
   float phr = radio->get_info()->max_tx_gain - common.get_pusch_power();
@@ -405,16 +505,28 @@ bool phy::get_se_phr_report(se_phr_report_t& report)
 
 void phy::prach_send(uint32_t preamble_idx, int allowed_subframe, float target_power_dbm, float ta_base_sec)
 {
-  common.ta.set_base_sec(ta_base_sec);
-  common.reset_radio();
-  if (!prach_buffer.prepare_to_send(preamble_idx, allowed_subframe, target_power_dbm)) {
+  prach_send(0, preamble_idx, allowed_subframe, target_power_dbm, ta_base_sec);
+}
+
+void phy::prach_send(uint32_t ue_idx,
+                     uint32_t preamble_idx,
+                     int      allowed_subframe,
+                     float    target_power_dbm,
+                     float    ta_base_sec)
+{
+  common.get_ue(ue_idx).ta.set_base_sec(ta_base_sec);
+  // The Tx stream is shared by all the UEs, only the first one restarts it
+  if (ue_idx == 0) {
+    common.reset_radio();
+  }
+  if (!prach_buffers[ue_idx]->prepare_to_send(preamble_idx, allowed_subframe, target_power_dbm)) {
     Error("Preparing PRACH to send");
   }
 }
 
 phy_interface_mac_lte::prach_info_t phy::prach_get_info()
 {
-  return prach_buffer.get_info();
+  return prach_buffers[0]->get_info();
 }
 
 // Handle the case of a radio overflow. Resynchronise immediatly
@@ -432,7 +544,9 @@ void phy::radio_failure()
 void phy::reset()
 {
   Info("Resetting PHY...");
-  common.ta.set_base_sec(0);
+  for (uint32_t ue_idx = 0; ue_idx < common.get_nof_ue(); ue_idx++) {
+    common.get_ue(ue_idx).ta.set_base_sec(0);
+  }
   common.reset();
 
   // Release mapping of secondary cells
@@ -450,18 +564,18 @@ uint32_t phy::get_current_tti()
 
 void phy::sr_send()
 {
-  common.sr.trigger();
+  common.get_ue(0).sr.trigger();
   Debug("SR is triggered");
 }
 
 int phy::sr_last_tx_tti()
 {
-  return common.sr.get_last_tx_tti();
+  return common.get_ue(0).sr.get_last_tx_tti();
 }
 
 void phy::set_rar_grant(uint8_t grant_payload[SRSRAN_RAR_GRANT_LEN], uint16_t rnti)
 {
-  common.set_rar_grant(grant_payload, rnti, tdd_config);
+  common.get_ue(0).set_rar_grant(grant_payload, rnti, tdd_config);
 }
 
 // Start GUI
@@ -474,6 +588,11 @@ void phy::start_plot()
 }
 
 bool phy::set_config(const srsran::phy_cfg_t& config_, uint32_t cc_idx)
+{
+  return set_config(config_, cc_idx, 0);
+}
+
+bool phy::set_config(const srsran::phy_cfg_t& config_, uint32_t cc_idx, uint32_t ue_idx)
 {
   if (!is_initialized()) {
     fprintf(stderr, "Error calling set_config(): PHY not initialized\n");
@@ -490,7 +609,7 @@ bool phy::set_config(const srsran::phy_cfg_t& config_, uint32_t cc_idx)
   Info("Setting configuration");
 
   // Apply configurations asynchronously to avoid race conditions
-  cmd_worker.add_cmd([this, config_, cc_idx]() {
+  cmd_worker.add_cmd([this, config_, cc_idx, ue_idx]() {
     // The PRACH configuration shall be updated only if:
     // - The new configuration belongs to the primary cell
     // - The PRACH configuration is present
@@ -499,12 +618,12 @@ bool phy::set_config(const srsran::phy_cfg_t& config_, uint32_t cc_idx)
       prach_cfg.tdd_config = tdd_config;
     }
 
-    logger_phy.info("Setting new PHY configuration cc_idx=%d...", cc_idx);
-    lte_workers.set_config(cc_idx, config_);
+    logger_phy.info("Setting new PHY configuration ue_idx=%d, cc_idx=%d...", ue_idx, cc_idx);
+    lte_workers.set_config(cc_idx, config_, ue_idx);
 
     // It is up to the PRACH component to detect whether the cell or the configuration have changed to reconfigure
     configure_prach_params();
-    stack->set_config_complete(true);
+    stacks[ue_idx]->set_config_complete(true);
   });
   return true;
 }
@@ -737,4 +856,80 @@ void phy::clear_pending_grants()
   nr_workers.clear_pending_grants();
 }
 
+/********** Additional UEs sharing the EUTRA PHY ********************/
+
+bool phy_ue::cell_search(int earfcn)
+{
+  return parent.cell_search_ue(ue_idx);
+}
+
+bool phy_ue::cell_select(phy_cell_t cell)
+{
+  return parent.cell_select_ue(ue_idx, cell);
+}
+
+bool phy_ue::cell_is_camping()
+{
+  return parent.cell_is_camping();
+}
+
+bool phy_ue::set_config(const srsran::phy_cfg_t& config, uint32_t cc_idx)
+{
+  // Only the PCell is supported
+  if (cc_idx != 0) {
+    return false;
+  }
+  return parent.set_config(config, cc_idx, ue_idx);
+}
+
+void phy_ue::prach_send(uint32_t preamble_idx, int allowed_subframe, float target_power_dbm, float ta_base_sec)
+{
+  parent.prach_send(ue_idx, preamble_idx, allowed_subframe, target_power_dbm, ta_base_sec);
+}
+
+phy_interface_mac_lte::prach_info_t phy_ue::prach_get_info()
+{
+  return parent.prach_buffers[ue_idx]->get_info();
+}
+
+void phy_ue::sr_send()
+{
+  parent.common.get_ue(ue_idx).sr.trigger();
+}
+
+int phy_ue::sr_last_tx_tti()
+{
+  return parent.common.get_ue(ue_idx).sr.get_last_tx_tti();
+}
+
+void phy_ue::set_timeadv_rar(uint32_t tti, uint32_t ta_cmd)
+{
+  parent.common.get_ue(ue_idx).ta.add_ta_cmd_rar(tti, ta_cmd);
+}
+
+void phy_ue::set_timeadv(uint32_t tti, uint32_t ta_cmd)
+{
+  parent.common.get_ue(ue_idx).ta.add_ta_cmd_new(tti, ta_cmd);
+}
+
+void phy_ue::set_rar_grant(uint8_t grant_payload[SRSRAN_RAR_GRANT_LEN], uint16_t rnti)
+{
+  parent.common.get_ue(ue_idx).set_rar_grant(grant_payload, rnti, parent.tdd_config);
+}
+
+uint32_t phy_ue::get_current_tti()
+{
+  return parent.get_current_tti();
+}
+
+float phy_ue::get_phr()
+{
+  return parent.get_phr();
+}
+
+float phy_ue::get_pathloss_db()
+{
+  return parent.get_pathloss_db();
+}
+
 } // namespace srsue
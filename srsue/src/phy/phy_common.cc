@@ -42,23 +42,31 @@ namespace srsue {
 
 static srsran::rf_buffer_t zeros_multi(1);
 
-phy_common::phy_common(srslog::basic_logger& logger) : logger(logger), ta(logger)
+phy_common::phy_common(srslog::basic_logger& logger) : logger(logger)
 {
+  ues.emplace_back(new ue_state(*this, logger));
   reset();
 }
 
 phy_common::~phy_common() = default;
 
-void phy_common::init(phy_args_t*                  _args,
-                      srsran::radio_interface_phy* _radio,
-                      stack_interface_phy_lte*     _stack,
-                      rsrp_insync_itf*             _chest_loop)
+void phy_common::init(phy_args_t*                                  _args,
+                      srsran::radio_interface_phy*                 _radio,
+                      const std::vector<stack_interface_phy_lte*>& _stacks,
+                      rsrp_insync_itf*                             _chest_loop)
 {
   radio_h    = _radio;
-  stack      = _stack;
   args       = _args;
   insync_itf = _chest_loop;
-  sr.reset();
+
+  // One state per UE stack, the first one already exists
+  while (ues.size() < _stacks.size()) {
+    ues.emplace_back(new ue_state(*this, logger));
+  }
+  for (uint32_t i = 0; i < _stacks.size(); i++) {
+    ues[i]->stack = _stacks[i];
+    ues[i]->sr.reset();
+  }
 
   // Instantiate UL channel emulator
   if (args->ul_channel_args.enable) {
@@ -136,9 +144,9 @@ srsran::radio_interface_phy* phy_common::get_radio()
 }
 
 // Unpack RAR dci as defined in Section 6.2 of 36.213
-void phy_common::set_rar_grant(uint8_t             grant_payload[SRSRAN_RAR_GRANT_LEN],
-                               uint16_t            rnti,
-                               srsran_tdd_config_t tdd_config)
+void phy_common::ue_state::set_rar_grant(uint8_t             grant_payload[SRSRAN_RAR_GRANT_LEN],
+                                         uint16_t            rnti,
+                                         srsran_tdd_config_t tdd_config)
 {
 #if MSG3_DELAY_MS < 0
 #error "Error MSG3_DELAY_MS can't be negative"
@@ -152,7 +160,7 @@ void phy_common::set_rar_grant(uint8_t             grant_payload[SRSRAN_RAR_GRAN
   srsran_dci_rar_grant_t rar_grant;
   srsran_dci_rar_unpack(grant_payload, &rar_grant);
 
-  if (srsran_dci_rar_to_ul_dci(&cell, &rar_grant, &dci_ul)) {
+  if (srsran_dci_rar_to_ul_dci(&common.cell, &rar_grant, &dci_ul)) {
     Error("Converting RAR message to UL dci");
     return;
   }
@@ -167,7 +175,7 @@ void phy_common::set_rar_grant(uint8_t             grant_payload[SRSRAN_RAR_GRAN
     msg3_tx_tti = (TTI_TX(rar_grant_tti) + MSG3_DELAY_MS) % 10240;
   }
 
-  if (cell.frame_type == SRSRAN_TDD) {
+  if (common.cell.frame_type == SRSRAN_TDD) {
     while (srsran_sfidx_tdd_type(tdd_config, msg3_tx_tti % 10) != SRSRAN_TDD_SF_U) {
       msg3_tx_tti++;
     }
@@ -178,7 +186,7 @@ void phy_common::set_rar_grant(uint8_t             grant_payload[SRSRAN_RAR_GRAN
   pending_ul_grant_t&         pending_grant = pending_ul_grant[0][msg3_tx_tti];
   if (!pending_grant.enable) {
     Debug("RAR grant rar_grant=%d, msg3_tti=%d, stored in index=%d", rar_grant_tti, msg3_tx_tti, TTIMOD(msg3_tx_tti));
-    pending_grant.pid    = ul_pidof(msg3_tx_tti, &tdd_config);
+    pending_grant.pid    = common.ul_pidof(msg3_tx_tti, &tdd_config);
     pending_grant.dci    = dci_ul;
     pending_grant.enable = true;
   } else {
@@ -258,13 +266,14 @@ uint32_t phy_common::ul_pidof(uint32_t tti, srsran_tdd_config_t* tdd_config)
 
 // Computes SF->TTI at which PHICH will be received according to 9.1.2 of 36.213
 #define tti_phich(sf)                                                                                                  \
-  (sf->tti + (cell.frame_type == SRSRAN_FDD ? FDD_HARQ_DELAY_UL_MS : k_phich[sf->tdd_config.sf_config][sf->tti % 10]))
+  (sf->tti + (common.cell.frame_type == SRSRAN_FDD ? FDD_HARQ_DELAY_UL_MS                                              \
+                                                   : k_phich[sf->tdd_config.sf_config][sf->tti % 10]))
 
 // Here SF->TTI is when PUSCH is transmitted
-void phy_common::set_ul_pending_ack(srsran_ul_sf_cfg_t*  sf,
-                                    uint32_t             cc_idx,
-                                    srsran_phich_grant_t phich_grant,
-                                    srsran_dci_ul_t*     dci_ul)
+void phy_common::ue_state::set_ul_pending_ack(srsran_ul_sf_cfg_t*  sf,
+                                              uint32_t             cc_idx,
+                                              srsran_phich_grant_t phich_grant,
+                                              srsran_dci_ul_t*     dci_ul)
 {
   // Use a lock here because subframe 4 and 9 of TDD config 0 accept multiple PHICH from multiple frames
   std::lock_guard<std::mutex> lock(pending_ul_ack_mutex);
@@ -286,10 +295,10 @@ void phy_common::set_ul_pending_ack(srsran_ul_sf_cfg_t*  sf,
 }
 
 // Here SF->TTI is when PHICH is being transmitted so that's DL subframe
-bool phy_common::get_ul_pending_ack(srsran_dl_sf_cfg_t*   sf,
-                                    uint32_t              cc_idx,
-                                    srsran_phich_grant_t* phich_grant,
-                                    srsran_dci_ul_t*      dci_ul)
+bool phy_common::ue_state::get_ul_pending_ack(srsran_dl_sf_cfg_t*   sf,
+                                              uint32_t              cc_idx,
+                                              srsran_phich_grant_t* phich_grant,
+                                              srsran_dci_ul_t*      dci_ul)
 {
   std::lock_guard<std::mutex> lock(pending_ul_ack_mutex);
   bool                        ret         = false;
@@ -304,7 +313,7 @@ bool phy_common::get_ul_pending_ack(srsran_dl_sf_cfg_t*   sf,
   return ret;
 }
 
-bool phy_common::is_any_ul_pending_ack()
+bool phy_common::ue_state::is_any_ul_pending_ack()
 {
   std::lock_guard<std::mutex> lock(pending_ul_ack_mutex);
 
@@ -322,24 +331,24 @@ bool phy_common::is_any_ul_pending_ack()
 // Computes SF->TTI at which PUSCH will be transmitted according to Section 8 of 36.213
 #define tti_pusch_hi(sf)                                                                                               \
   (sf->tti +                                                                                                           \
-   (cell.frame_type == SRSRAN_FDD ? FDD_HARQ_DELAY_UL_MS                                                               \
+   (common.cell.frame_type == SRSRAN_FDD ? FDD_HARQ_DELAY_UL_MS                                                        \
     : I_phich                     ? 7                                                                                  \
                                   : k_pusch[sf->tdd_config.sf_config][sf->tti % 10]) +                                                     \
    (FDD_HARQ_DELAY_DL_MS - FDD_HARQ_DELAY_UL_MS))
 #define tti_pusch_gr(sf)                                                                                               \
   (sf->tti +                                                                                                           \
-   (cell.frame_type == SRSRAN_FDD ? FDD_HARQ_DELAY_UL_MS                                                               \
+   (common.cell.frame_type == SRSRAN_FDD ? FDD_HARQ_DELAY_UL_MS                                                        \
     : dci->ul_idx == 1            ? 7                                                                                  \
                                   : k_pusch[sf->tdd_config.sf_config][sf->tti % 10]) +                                            \
    (FDD_HARQ_DELAY_DL_MS - FDD_HARQ_DELAY_UL_MS))
 
 // SF->TTI is at which Format0 dci is received
-void phy_common::set_ul_pending_grant(srsran_dl_sf_cfg_t* sf, uint32_t cc_idx, srsran_dci_ul_t* dci)
+void phy_common::ue_state::set_ul_pending_grant(srsran_dl_sf_cfg_t* sf, uint32_t cc_idx, srsran_dci_ul_t* dci)
 {
   std::lock_guard<std::mutex> lock(pending_ul_grant_mutex);
 
   // Calculate PID for this SF->TTI
-  uint32_t            pid           = ul_pidof(tti_pusch_gr(sf), &sf->tdd_config);
+  uint32_t            pid           = common.ul_pidof(tti_pusch_gr(sf), &sf->tdd_config);
   pending_ul_grant_t& pending_grant = pending_ul_grant[cc_idx][tti_pusch_gr(sf)];
 
   if (!pending_grant.enable) {
@@ -353,7 +362,10 @@ void phy_common::set_ul_pending_grant(srsran_dl_sf_cfg_t* sf, uint32_t cc_idx, s
 }
 
 // SF->TTI at which PUSCH should be transmitted
-bool phy_common::get_ul_pending_grant(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, uint32_t* pid, srsran_dci_ul_t* dci)
+bool phy_common::ue_state::get_ul_pending_grant(srsran_ul_sf_cfg_t* sf,
+                                                uint32_t            cc_idx,
+                                                uint32_t*           pid,
+                                                srsran_dci_ul_t*    dci)
 {
   std::lock_guard<std::mutex> lock(pending_ul_grant_mutex);
   bool                        ret           = false;
@@ -374,10 +386,10 @@ bool phy_common::get_ul_pending_grant(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, u
   return ret;
 }
 
-uint32_t phy_common::get_ul_uci_cc(uint32_t tti_tx) const
+uint32_t phy_common::ue_state::get_ul_uci_cc(uint32_t tti_tx) const
 {
   std::lock_guard<std::mutex> lock(pending_ul_grant_mutex);
-  for (uint32_t cc = 0; cc < args->nof_lte_carriers; cc++) {
+  for (uint32_t cc = 0; cc < common.args->nof_lte_carriers; cc++) {
     const pending_ul_grant_t& grant = pending_ul_grant[cc][tti_tx];
     if (grant.enable) {
       return cc;
@@ -387,11 +399,11 @@ uint32_t phy_common::get_ul_uci_cc(uint32_t tti_tx) const
 }
 
 // SF->TTI at which PHICH is received
-void phy_common::set_ul_received_ack(srsran_dl_sf_cfg_t* sf,
-                                     uint32_t            cc_idx,
-                                     bool                ack_value,
-                                     uint32_t            I_phich,
-                                     srsran_dci_ul_t*    dci_ul)
+void phy_common::ue_state::set_ul_received_ack(srsran_dl_sf_cfg_t* sf,
+                                               uint32_t            cc_idx,
+                                               bool                ack_value,
+                                               uint32_t            I_phich,
+                                               srsran_dci_ul_t*    dci_ul)
 {
   std::lock_guard<std::mutex> lock(received_ul_ack_mutex);
   received_ul_ack_t&          received_ack = received_ul_ack[cc_idx][tti_pusch_hi(sf)];
@@ -403,7 +415,10 @@ void phy_common::set_ul_received_ack(srsran_dl_sf_cfg_t* sf,
 }
 
 // SF->TTI at which PUSCH will be transmitted
-bool phy_common::get_ul_received_ack(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, bool* ack_value, srsran_dci_ul_t* dci_ul)
+bool phy_common::ue_state::get_ul_received_ack(srsran_ul_sf_cfg_t* sf,
+                                               uint32_t            cc_idx,
+                                               bool*               ack_value,
+                                               srsran_dci_ul_t*    dci_ul)
 {
   std::lock_guard<std::mutex> lock(received_ul_ack_mutex);
   bool                        ret          = false;
@@ -425,10 +440,10 @@ bool phy_common::get_ul_received_ack(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, bo
 }
 
 // SF->TTI at which PDSCH is decoded and ACK generated
-void phy_common::set_dl_pending_ack(srsran_dl_sf_cfg_t*         sf,
-                                    uint32_t                    cc_idx,
-                                    uint8_t                     value[SRSRAN_MAX_CODEWORDS],
-                                    srsran_pdsch_ack_resource_t resource)
+void phy_common::ue_state::set_dl_pending_ack(srsran_dl_sf_cfg_t*         sf,
+                                              uint32_t                    cc_idx,
+                                              uint8_t                     value[SRSRAN_MAX_CODEWORDS],
+                                              srsran_pdsch_ack_resource_t resource)
 {
   std::lock_guard<std::mutex> lock(pending_dl_ack_mutex);
   received_ack_t&             pending_ack = pending_dl_ack[cc_idx][sf->tti];
@@ -443,15 +458,15 @@ void phy_common::set_dl_pending_ack(srsran_dl_sf_cfg_t*         sf,
   }
 }
 
-void phy_common::set_rar_grant_tti(uint32_t tti)
+void phy_common::ue_state::set_rar_grant_tti(uint32_t tti)
 {
   rar_grant_tti = tti;
 }
 
-void phy_common::set_dl_pending_grant(uint32_t               tti,
-                                      uint32_t               cc_idx,
-                                      uint32_t               grant_cc_idx,
-                                      const srsran_dci_dl_t* dl_dci)
+void phy_common::ue_state::set_dl_pending_grant(uint32_t               tti,
+                                                uint32_t               cc_idx,
+                                                uint32_t               grant_cc_idx,
+                                                const srsran_dci_dl_t* dl_dci)
 {
   std::lock_guard<std::mutex> lock(pending_dl_grant_mutex);
   if (!pending_dl_grant[tti % FDD_HARQ_DELAY_UL_MS][cc_idx].enable) {
@@ -463,7 +478,10 @@ void phy_common::set_dl_pending_grant(uint32_t               tti,
   }
 }
 
-bool phy_common::get_dl_pending_grant(uint32_t tti, uint32_t cc_idx, uint32_t* grant_cc_idx, srsran_dci_dl_t* dl_dci)
+bool phy_common::ue_state::get_dl_pending_grant(uint32_t         tti,
+                                                uint32_t         cc_idx,
+                                                uint32_t*        grant_cc_idx,
+                                                srsran_dci_dl_t* dl_dci)
 {
   std::lock_guard<std::mutex> lock(pending_dl_grant_mutex);
   if (pending_dl_grant[tti % FDD_HARQ_DELAY_UL_MS][cc_idx].enable) {
@@ -507,19 +525,19 @@ das_index_t das_table[7][10] = {
     {{0, {}}, {0, {}}, {1, {7}}, {1, {7}}, {1, {5}}, {0, {}}, {0, {}}, {1, {7}}, {1, {7}}, {0, {}}}};
 
 // SF->TTI at which ACK/NACK would be transmitted
-bool phy_common::get_dl_pending_ack(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, srsran_pdsch_ack_cc_t* ack)
+bool phy_common::ue_state::get_dl_pending_ack(srsran_ul_sf_cfg_t* sf, uint32_t cc_idx, srsran_pdsch_ack_cc_t* ack)
 {
   std::lock_guard<std::mutex> lock(pending_dl_ack_mutex);
   bool                        ret = false;
   uint32_t                    M;
-  if (cell.frame_type == SRSRAN_FDD) {
+  if (common.cell.frame_type == SRSRAN_FDD) {
     M = 1;
   } else {
     M = das_table[sf->tdd_config.sf_config][sf->tti % 10].M;
   }
   for (uint32_t i = 0; i < M; i++) {
-    uint32_t k =
-        (cell.frame_type == SRSRAN_FDD) ? FDD_HARQ_DELAY_UL_MS : das_table[sf->tdd_config.sf_config][sf->tti % 10].K[i];
+    uint32_t k = (common.cell.frame_type == SRSRAN_FDD) ? FDD_HARQ_DELAY_UL_MS
+                                                         : das_table[sf->tdd_config.sf_config][sf->tti % 10].K[i];
     uint32_t        pdsch_tti   = TTI_SUB(sf->tti, k + (FDD_HARQ_DELAY_DL_MS - FDD_HARQ_DELAY_UL_MS));
     received_ack_t& pending_ack = pending_dl_ack[cc_idx][pdsch_tti];
     if (pending_ack.enable) {
@@ -582,7 +600,7 @@ void phy_common::worker_end(const worker_context_t& w_ctx, const bool& tx_enable
 
   // Add current time alignment
   srsran::rf_timestamp_t tx_time = w_ctx.tx_time; // get transmit time from the last worker
-  tx_time.sub((double)ta.get_sec());
+  tx_time.sub((double)get_ue(0).ta.get_sec());
 
   // Check if any worker had a transmission
   if (tx_enabled) {
@@ -907,19 +925,27 @@ void phy_common::reset()
 {
   reset_radio();
 
-  sr.reset();
+  for (auto& ue : ues) {
+    ue->reset();
+  }
+
   {
     std::unique_lock<std::mutex> lock(meas_mutex);
     cur_pathloss    = 0;
     cur_pusch_power = 0;
   }
-  last_ri = 0;
 
   // Reset all measurements
   reset_measurements(SRSRAN_MAX_CARRIERS);
 
   // Reset all SCell states
   cell_state.reset();
+}
+
+void phy_common::ue_state::reset()
+{
+  sr.reset();
+  last_ri = 0;
 
   // Note: Using memset to reset these members is forbidden because they are real objects, not plain arrays.
   {
@@ -56,8 +56,7 @@ static SRSRAN_AGC_CALLBACK(callback_set_rx_gain)
 }
 
 void sync::init(srsran::radio_interface_phy* _radio,
-                stack_interface_phy_lte*     _stack,
-                prach*                       _prach_buffer,
+                const std::vector<prach*>&   prach_buffers,
                 lte::worker_pool*            _lte_workers_pool,
                 nr::worker_pool*             _nr_workers_pool,
                 phy_common*                  _worker_com,
@@ -65,11 +64,14 @@ void sync::init(srsran::radio_interface_phy* _radio,
                 int                          sync_cpu_affinity)
 {
   radio_h         = _radio;
-  stack           = _stack;
   lte_worker_pool = _lte_workers_pool;
   nr_worker_pool  = _nr_workers_pool;
   worker_com      = _worker_com;
-  prach_buffer    = _prach_buffer;
+
+  prach_state.resize(prach_buffers.size());
+  for (uint32_t i = 0; i < prach_buffers.size(); i++) {
+    prach_state[i].buffer = prach_buffers[i];
+  }
 
   nof_rf_channels =
       (worker_com->args->nof_lte_carriers + worker_com->args->nof_nr_carriers) * worker_com->args->nof_rx_ant;
@@ -384,7 +386,7 @@ bool sync::cell_select_start(phy_cell_t new_cell)
   phy_state.run_sfn_sync();
   if (phy_state.is_camping()) {
     Info("Cell Select: SFN synchronized. CAMPING...");
-    stack->in_sync();
+    worker_com->for_each_stack([](stack_interface_phy_lte* s) { s->in_sync(); });
     ret = true;
   } else {
     Info("Cell Select: Could not synchronize SFN");
@@ -426,7 +428,8 @@ void sync::run_cell_search_state()
   cell_search_ret        = search_p.run(&tmp_cell, mib);
   if (cell_search_ret == search::CELL_FOUND) {
     cell.set(tmp_cell);
-    stack->bch_decoded_ok(SYNC_CC_IDX, mib.data(), mib.size() / 8);
+    worker_com->for_each_stack(
+        [this](stack_interface_phy_lte* s) { s->bch_decoded_ok(SYNC_CC_IDX, mib.data(), mib.size() / 8); });
   }
   phy_state.state_exit();
 }
@@ -444,7 +447,7 @@ void sync::run_sfn_sync_state()
                         "to cells with different MIB is not supported\n");
         phy_state.state_exit(false);
       }
-      stack->in_sync();
+      worker_com->for_each_stack([](stack_interface_phy_lte* s) { s->in_sync(); });
       phy_state.state_exit();
       break;
     case sfn_sync::IDLE:
@@ -514,23 +517,25 @@ void sync::run_camping_in_sync_state(lte::sf_worker*      lte_worker,
   // Collect and provide metrics from last successful sync
   metrics.sfo         = sfo;
   metrics.cfo         = cfo;
-  metrics.ta_us       = worker_com->ta.get_usec();
-  metrics.distance_km = worker_com->ta.get_km();
-  metrics.speed_kmph  = worker_com->ta.get_speed_kmph(tti);
+  metrics.ta_us       = worker_com->get_ue(0).ta.get_usec();
+  metrics.distance_km = worker_com->get_ue(0).ta.get_km();
+  metrics.speed_kmph  = worker_com->get_ue(0).ta.get_speed_kmph(tti);
   for (uint32_t i = 0; i < worker_com->args->nof_lte_carriers; i++) {
     worker_com->set_sync_metrics(i, metrics);
   }
 
-  // Check if we need to TX a PRACH
-  if (prach_buffer->is_ready_to_send(tti, cell.get().id)) {
-    prach_ptr = prach_buffer->generate(get_tx_cfo(), &prach_nof_sf, &prach_power);
-    if (prach_ptr == nullptr) {
-      Error("Generating PRACH");
+  // Check if we need to TX a PRACH, for every UE sharing the PHY
+  for (uint32_t ue_idx = 0; ue_idx < prach_state.size(); ue_idx++) {
+    prach_state_t& p = prach_state[ue_idx];
+    if (p.buffer->is_ready_to_send(tti, cell.get().id)) {
+      p.ptr = p.buffer->generate(get_tx_cfo(), &p.nof_sf, &p.power);
+      if (p.ptr == nullptr) {
+        Error("Generating PRACH");
+      }
     }
-  }
 
-  lte_worker->set_prach(prach_ptr ? &prach_ptr[prach_sf_cnt * SRSRAN_SF_LEN_PRB(cell.get().nof_prb)] : nullptr,
-                        prach_power);
+    lte_worker->set_prach(p.ptr ? &p.ptr[p.sf_cnt * SRSRAN_SF_LEN_PRB(cell.get().nof_prb)] : nullptr, p.power, ue_idx);
+  }
 
   // Execute Serving Cell state FSM
   worker_com->cell_state.run_tti(tti);
@@ -545,11 +550,13 @@ void sync::run_camping_in_sync_state(lte::sf_worker*      lte_worker,
   last_rx_time.add(FDD_HARQ_DELAY_DL_MS * 1e-3);
 
   // Advance/reset prach subframe pointer
-  if (prach_ptr) {
-    prach_sf_cnt++;
-    if (prach_sf_cnt == prach_nof_sf) {
-      prach_sf_cnt = 0;
-      prach_ptr    = nullptr;
+  for (prach_state_t& p : prach_state) {
+    if (p.ptr) {
+      p.sf_cnt++;
+      if (p.sf_cnt == p.nof_sf) {
+        p.sf_cnt = 0;
+        p.ptr    = nullptr;
+      }
     }
   }
 
@@ -735,7 +742,7 @@ void sync::in_sync()
   in_sync_cnt++;
   // Send RRC in-sync signal after 100 ms consecutive subframes
   if (in_sync_cnt == worker_com->args->nof_in_sync_events) {
-    stack->in_sync();
+    worker_com->for_each_stack([](stack_interface_phy_lte* s) { s->in_sync(); });
     in_sync_cnt     = 0;
     out_of_sync_cnt = 0;
   }
@@ -749,7 +756,7 @@ void sync::out_of_sync()
   out_of_sync_cnt++;
   if (out_of_sync_cnt == worker_com->args->nof_out_of_sync_events) {
     Info("Sending to RRC");
-    stack->out_of_sync();
+    worker_com->for_each_stack([](stack_interface_phy_lte* s) { s->out_of_sync(); });
     out_of_sync_cnt = 0;
     in_sync_cnt     = 0;
   }
@@ -1053,7 +1060,7 @@ void sync::run_stack_tti()
 
     // Run stack
     Debug("run_stack_tti: calling stack tti=%d, tti_jump=%d", tti, tti_jump);
-    stack->run_tti(tti, tti_jump);
+    worker_com->for_each_stack([this, tti_jump](stack_interface_phy_lte* s) { s->run_tti(tti, tti_jump); });
     Debug("run_stack_tti: stack called");
   }
 
@@ -1130,7 +1137,7 @@ void sync::new_cell_meas(uint32_t cc_idx, const std::vector<phy_meas_t>& meas)
   worker_com->set_neighbour_cells(cc_idx, meas);
 
   // Pass-through to the stack
-  stack->new_cell_meas(meas);
+  worker_com->for_each_stack([&meas](stack_interface_phy_lte* s) { s->new_cell_meas(meas); });
 }
 
 } // namespace srsue
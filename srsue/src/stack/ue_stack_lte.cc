@@ -424,18 +424,7 @@ void ue_stack_lte::write_sdu(uint32_t eps_bearer_id, srsran::unique_byte_buffer_
   auto bearer = bearers.get_radio_bearer(eps_bearer_id);
 
   auto task = [this, eps_bearer_id, bearer](srsran::unique_byte_buffer_t& sdu) {
-    // route SDU to PDCP entity
-    if (bearer.rat == srsran_rat_t::lte) {
-      pdcp.write_sdu(bearer.lcid, std::move(sdu));
-    } else if (bearer.rat == srsran_rat_t::nr) {
-      if (args.sa_mode) {
-        sdap.write_sdu(bearer.lcid, std::move(sdu));
-      } else {
-        pdcp_nr.write_sdu(bearer.lcid, std::move(sdu));
-      }
-    } else {
-      stack_logger.warning("Can't deliver SDU for EPS bearer %d. Dropping it.", eps_bearer_id);
-    }
+    route_sdu(eps_bearer_id, bearer, std::move(sdu));
   };
 
   bool ret = gw_queue_id.try_push(std::bind(task, std::move(sdu))).has_value();
@@ -445,6 +434,55 @@ void ue_stack_lte::write_sdu(uint32_t eps_bearer_id, srsran::unique_byte_buffer_
   }
 }
 
+/**
+ * GW calls write_sdu_batch() to push several SDUs of the same EPS bearer.
+ * They are handed over to the stack thread in a single task.
+ *
+ * @param eps_bearer_id
+ * @param sdus
+ * @param nof_sdus
+ */
+void ue_stack_lte::write_sdu_batch(uint32_t eps_bearer_id, srsran::unique_byte_buffer_t* sdus, uint32_t nof_sdus)
+{
+  auto bearer = bearers.get_radio_bearer(eps_bearer_id);
+
+  std::vector<srsran::unique_byte_buffer_t> batch;
+  batch.reserve(nof_sdus);
+  for (uint32_t i = 0; i < nof_sdus; i++) {
+    batch.push_back(std::move(sdus[i]));
+  }
+
+  auto task = [this, eps_bearer_id, bearer](std::vector<srsran::unique_byte_buffer_t>& batch) {
+    for (srsran::unique_byte_buffer_t& sdu : batch) {
+      route_sdu(eps_bearer_id, bearer, std::move(sdu));
+    }
+  };
+
+  bool ret = gw_queue_id.try_push(std::bind(task, std::move(batch))).has_value();
+  if (not ret) {
+    pdcp_logger.info("GW batch of %d SDUs with lcid=%d was discarded.", nof_sdus, bearer.lcid);
+    ul_dropped_sdus += nof_sdus;
+  }
+}
+
+void ue_stack_lte::route_sdu(uint32_t                                  eps_bearer_id,
+                             const ue_bearer_manager::radio_bearer_t& bearer,
+                             srsran::unique_byte_buffer_t             sdu)
+{
+  // route SDU to PDCP entity
+  if (bearer.rat == srsran_rat_t::lte) {
+    pdcp.write_sdu(bearer.lcid, std::move(sdu));
+  } else if (bearer.rat == srsran_rat_t::nr) {
+    if (args.sa_mode) {
+      sdap.write_sdu(bearer.lcid, std::move(sdu));
+    } else {
+      pdcp_nr.write_sdu(bearer.lcid, std::move(sdu));
+    }
+  } else {
+    stack_logger.warning("Can't deliver SDU for EPS bearer %d. Dropping it.", eps_bearer_id);
+  }
+}
+
 bool ue_stack_lte::has_active_radio_bearer(uint32_t eps_bearer_id)
 {
   return bearers.has_active_radio_bearer(eps_bearer_id);
@@ -32,12 +32,231 @@
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 namespace srsue {
 
+namespace {
+
+// virtio-net header prepended by TUN devices opened with IFF_VNET_HDR. Mirrors struct virtio_net_hdr, whose kernel
+// header cannot be included from C++
+struct vnet_hdr_t {
+  uint8_t  flags;
+  uint8_t  gso_type;
+  uint16_t hdr_len;
+  uint16_t gso_size;
+  uint16_t csum_start;
+  uint16_t csum_offset;
+};
+const uint8_t VNET_HDR_F_NEEDS_CSUM = 1;
+const uint8_t VNET_HDR_GSO_NONE     = 0;
+const uint8_t VNET_HDR_GSO_TCPV4    = 1;
+const uint8_t VNET_HDR_GSO_TCPV6    = 4;
+const uint8_t VNET_HDR_GSO_ECN      = 0x80;
+
+// Largest packet the kernel hands over with TSO enabled, plus the virtio-net header
+const uint32_t GW_VNET_MAX_PKT_SIZE = sizeof(vnet_hdr_t) + 65536;
+// Period to check for run_enable while the batched reader waits for packets
+const int GW_POLL_TIMEOUT_MS = 100;
+// Time a DL write waits for room in a full non-blocking TUN queue before the packet is dropped
+const int GW_TUN_WRITE_TIMEOUT_MS = 10;
+
+const uint8_t IPV4_HDR_MIN_LEN = 20;
+const uint8_t IPV6_HDR_LEN     = 40;
+const uint8_t TCP_HDR_MIN_LEN  = 20;
+const uint8_t TCP_FLAG_FIN     = 0x01;
+const uint8_t TCP_FLAG_PSH     = 0x08;
+const uint8_t TCP_FLAG_CWR     = 0x80;
+
+/// Returns the IP packet length announced in its header, or 0 for unsupported IP versions
+uint32_t get_ip_pkt_len(const uint8_t* pkt, uint32_t nof_bytes)
+{
+  if (nof_bytes < IPV4_HDR_MIN_LEN) {
+    return 0;
+  }
+  const struct iphdr*   ip_pkt  = (const struct iphdr*)pkt;
+  const struct ipv6hdr* ip6_pkt = (const struct ipv6hdr*)pkt;
+  if (ip_pkt->version == 4) {
+    return ntohs(ip_pkt->tot_len);
+  }
+  if (ip_pkt->version == 6 && nof_bytes >= IPV6_HDR_LEN) {
+    return ntohs(ip6_pkt->payload_len) + IPV6_HDR_LEN;
+  }
+  return 0;
+}
+
+/// Adds the 16-bit big-endian words of a buffer to a one's complement sum
+uint32_t csum_add(uint32_t sum, const uint8_t* data, uint32_t len)
+{
+  uint32_t i = 0;
+  for (; i + 1 < len; i += 2) {
+    sum += ((uint32_t)data[i] << 8U) | data[i + 1];
+  }
+  if (i < len) {
+    sum += (uint32_t)data[i] << 8U;
+  }
+  return sum;
+}
+
+/// Folds a one's complement sum and writes its complement in network order
+void csum_store(uint32_t sum, uint8_t* dst)
+{
+  while (sum >> 16U) {
+    sum = (sum & 0xffffU) + (sum >> 16U);
+  }
+  sum    = ~sum & 0xffffU;
+  dst[0] = (uint8_t)(sum >> 8U);
+  dst[1] = (uint8_t)(sum & 0xffU);
+}
+
+/// Computes the TCP checksum of a complete IPv4 or IPv6 packet
+void tcp_csum(uint8_t* pkt, uint32_t ip_hdr_len, uint32_t nof_bytes)
+{
+  uint8_t* tcp     = pkt + ip_hdr_len;
+  uint32_t tcp_len = nof_bytes - ip_hdr_len;
+  uint32_t sum     = 0;
+
+  // Pseudo-header
+  if ((pkt[0] >> 4U) == 4) {
+    sum = csum_add(sum, pkt + 12, 2 * 4);
+  } else {
+    sum = csum_add(sum, pkt + 8, 2 * 16);
+  }
+  sum += IPPROTO_TCP + tcp_len;
+
+  tcp[16] = 0;
+  tcp[17] = 0;
+  csum_store(csum_add(sum, tcp, tcp_len), &tcp[16]);
+}
+
+} // namespace
+
+int gw_vnet_segment(const uint8_t* buf, uint32_t len, std::vector<srsran::unique_byte_buffer_t>& pdus)
+{
+  const uint32_t max_pdu_len = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+
+  if (len < sizeof(vnet_hdr_t)) {
+    return SRSRAN_ERROR;
+  }
+  vnet_hdr_t vnet_hdr;
+  memcpy(&vnet_hdr, buf, sizeof(vnet_hdr));
+  const uint8_t* pkt       = buf + sizeof(vnet_hdr);
+  uint32_t       nof_bytes = len - sizeof(vnet_hdr);
+  uint8_t        gso_type  = vnet_hdr.gso_type & ~VNET_HDR_GSO_ECN;
+
+  if (get_ip_pkt_len(pkt, nof_bytes) != nof_bytes) {
+    return SRSRAN_ERROR;
+  }
+
+  // Plain packet, possibly with a partial checksum left to complete
+  if (gso_type == VNET_HDR_GSO_NONE) {
+    if (nof_bytes > max_pdu_len) {
+      return SRSRAN_ERROR;
+    }
+    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+    if (pdu == nullptr) {
+      return SRSRAN_ERROR;
+    }
+    memcpy(pdu->msg, pkt, nof_bytes);
+    pdu->N_bytes = nof_bytes;
+    if (vnet_hdr.flags & VNET_HDR_F_NEEDS_CSUM) {
+      // The checksum field already holds the pseudo-header sum
+      uint32_t csum_pos = vnet_hdr.csum_start + vnet_hdr.csum_offset;
+      if (vnet_hdr.csum_start >= nof_bytes || csum_pos + 2 > nof_bytes) {
+        return SRSRAN_ERROR;
+      }
+      uint32_t sum = csum_add(0, pdu->msg + vnet_hdr.csum_start, nof_bytes - vnet_hdr.csum_start);
+      csum_store(sum, pdu->msg + csum_pos);
+    }
+    pdus.push_back(std::move(pdu));
+    return 1;
+  }
+
+  if (gso_type != VNET_HDR_GSO_TCPV4 && gso_type != VNET_HDR_GSO_TCPV6) {
+    return SRSRAN_ERROR;
+  }
+
+  // Locate the TCP header
+  uint32_t ip_hdr_len = 0;
+  if (gso_type == VNET_HDR_GSO_TCPV4) {
+    ip_hdr_len = (pkt[0] & 0x0fU) * 4U;
+    if ((pkt[0] >> 4U) != 4 || ip_hdr_len < IPV4_HDR_MIN_LEN || pkt[9] != IPPROTO_TCP) {
+      return SRSRAN_ERROR;
+    }
+  } else {
+    ip_hdr_len = IPV6_HDR_LEN;
+    if ((pkt[0] >> 4U) != 6 || pkt[6] != IPPROTO_TCP) {
+      return SRSRAN_ERROR;
+    }
+  }
+  if (ip_hdr_len + TCP_HDR_MIN_LEN > nof_bytes) {
+    return SRSRAN_ERROR;
+  }
+  uint32_t tcp_hdr_len = (pkt[ip_hdr_len + 12] >> 4U) * 4U;
+  uint32_t hdr_len     = ip_hdr_len + tcp_hdr_len;
+  uint32_t mss         = vnet_hdr.gso_size;
+  if (tcp_hdr_len < TCP_HDR_MIN_LEN || hdr_len > nof_bytes || mss == 0 || hdr_len + mss > max_pdu_len) {
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t payload_len = nof_bytes - hdr_len;
+  uint32_t seq         = 0;
+  uint16_t ip_id       = 0;
+  memcpy(&seq, &pkt[ip_hdr_len + 4], sizeof(seq));
+  memcpy(&ip_id, &pkt[4], sizeof(ip_id));
+  seq   = ntohl(seq);
+  ip_id = ntohs(ip_id);
+
+  int nof_segments = 0;
+  for (uint32_t offset = 0; offset < payload_len; offset += mss, nof_segments++) {
+    uint32_t seg_len = std::min(mss, payload_len - offset);
+    bool     last    = offset + seg_len == payload_len;
+
+    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+    if (pdu == nullptr) {
+      return SRSRAN_ERROR;
+    }
+    memcpy(pdu->msg, pkt, hdr_len);
+    memcpy(pdu->msg + hdr_len, pkt + hdr_len + offset, seg_len);
+    pdu->N_bytes = hdr_len + seg_len;
+
+    // IP header
+    uint8_t* ip = pdu->msg;
+    if (gso_type == VNET_HDR_GSO_TCPV4) {
+      uint16_t tot_len = htons(pdu->N_bytes);
+      uint16_t id      = htons(ip_id + nof_segments);
+      memcpy(&ip[2], &tot_len, sizeof(tot_len));
+      memcpy(&ip[4], &id, sizeof(id));
+      ip[10] = 0;
+      ip[11] = 0;
+      csum_store(csum_add(0, ip, ip_hdr_len), &ip[10]);
+    } else {
+      uint16_t payload_len_be = htons(pdu->N_bytes - IPV6_HDR_LEN);
+      memcpy(&ip[4], &payload_len_be, sizeof(payload_len_be));
+    }
+
+    // TCP header
+    uint8_t* tcp    = ip + ip_hdr_len;
+    uint32_t seq_be = htonl(seq + offset);
+    memcpy(&tcp[4], &seq_be, sizeof(seq_be));
+    if (!last) {
+      tcp[13] &= ~(TCP_FLAG_FIN | TCP_FLAG_PSH);
+    }
+    if (offset > 0) {
+      tcp[13] &= ~TCP_FLAG_CWR;
+    }
+    tcp_csum(ip, ip_hdr_len, pdu->N_bytes);
+
+    pdus.push_back(std::move(pdu));
+  }
+
+  return nof_segments;
+}
+
 gw::gw(srslog::basic_logger& logger_) : thread("GW"), logger(logger_), tft_matcher(logger) {}
 
 int gw::init(const gw_args_t& args_, stack_interface_gw* stack_)
@@ -76,6 +295,9 @@ gw::~gw()
   if (tun_fd > 0) {
     close(tun_fd);
   }
+  for (int32_t fd : tun_queue_fds) {
+    close(fd);
+  }
 }
 
 void gw::stop()
@@ -84,9 +306,11 @@ void gw::stop()
     run_enable = false;
     if (if_up) {
       if_up = false;
-      if (running) {
+      // The batched readers poll run_enable, so they are never cancelled in the middle of a push to the stack
+      if (running && !batched_rx()) {
         thread_cancel();
       }
+      stop_rx_threads();
 
       // Wait thread to exit gracefully otherwise might leave a mutex locked
       int cnt = 0;
@@ -111,6 +335,12 @@ void gw::get_metrics(gw_metrics_t& m, const uint32_t nof_tti)
 
   std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - metrics_tp;
 
+  // reset counters and store time
+  uint32_t dl_tput_bytes   = this->dl_tput_bytes.exchange(0);
+  uint32_t ul_tput_bytes   = this->ul_tput_bytes.exchange(0);
+  uint32_t dl_dropped_pkts = this->dl_dropped_pkts.exchange(0);
+  metrics_tp               = std::chrono::high_resolution_clock::now();
+
   double dl_tput_mbps_real_time = (dl_tput_bytes * 8 / (double)1e6) / secs.count();
   double ul_tput_mbps_real_time = (ul_tput_bytes * 8 / (double)1e6) / secs.count();
 
@@ -123,11 +353,9 @@ void gw::get_metrics(gw_metrics_t& m, const uint32_t nof_tti)
                dl_tput_mbps_real_time,
                m.ul_tput_mbps,
                ul_tput_mbps_real_time);
-
-  // reset counters and store time
-  metrics_tp    = std::chrono::high_resolution_clock::now();
-  dl_tput_bytes = 0;
-  ul_tput_bytes = 0;
+  if (dl_dropped_pkts > 0) {
+    logger.warning("Dropped %d DL packets since the last metrics report, the TUN queue was full", dl_dropped_pkts);
+  }
 }
 
 /*******************************************************************************
@@ -136,10 +364,7 @@ void gw::get_metrics(gw_metrics_t& m, const uint32_t nof_tti)
 void gw::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
 {
   logger.info(pdu->msg, pdu->N_bytes, "RX PDU. Stack latency: %ld us", pdu->get_latency_us().count());
-  {
-    std::unique_lock<std::mutex> lock(gw_mutex);
-    dl_tput_bytes += pdu->N_bytes;
-  }
+  dl_tput_bytes += pdu->N_bytes;
   if (!if_up) {
     if (run_enable) {
       logger.warning("TUN/TAP not up - dropping gw RX message");
@@ -151,7 +376,7 @@ void gw::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
     // Only handle IPv4 and IPv6 packets
     struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
     if (ip_pkt->version == 4 || ip_pkt->version == 6) {
-      int n = write(tun_fd, pdu->msg, pdu->N_bytes);
+      int n = tun_write(pdu->msg, pdu->N_bytes);
       if (n > 0 && (pdu->N_bytes != (uint32_t)n)) {
         logger.warning("DL TUN/TAP write failure. Wanted to write %d B but only wrote %d B.", pdu->N_bytes, n);
       }
@@ -169,10 +394,7 @@ void gw::write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
                 "RX MCH PDU (%d B). Stack latency: %ld us",
                 pdu->N_bytes,
                 pdu->get_latency_us().count());
-    {
-      std::unique_lock<std::mutex> lock(gw_mutex);
-      dl_tput_bytes += pdu->N_bytes;
-    }
+    dl_tput_bytes += pdu->N_bytes;
 
     // Hack to drop initial 2 bytes
     pdu->msg += 2;
@@ -185,7 +407,7 @@ void gw::write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
         logger.warning("TUN/TAP not up - dropping gw RX message");
       }
     } else {
-      int n = write(tun_fd, pdu->msg, pdu->N_bytes);
+      int n = tun_write(pdu->msg, pdu->N_bytes);
       if (n > 0 && (pdu->N_bytes != (uint32_t)n)) {
         logger.warning("DL TUN/TAP write failure");
       }
@@ -203,9 +425,13 @@ int gw::setup_if_addr(uint32_t eps_bearer_id, uint8_t pdn_type, uint32_t ip_addr
   // Make sure the worker thread is terminated before spawning a new one.
   if (running) {
     run_enable = false;
-    thread_cancel();
+    if (!batched_rx()) {
+      thread_cancel();
+    }
     wait_thread_finish();
   }
+  run_enable = false;
+  stop_rx_threads();
   if (pdn_type == LIBLTE_MME_PDN_TYPE_IPV4 || pdn_type == LIBLTE_MME_PDN_TYPE_IPV4V6) {
     err = setup_if_addr4(ip_addr, err_str);
     if (err != SRSRAN_SUCCESS) {
@@ -221,9 +447,13 @@ int gw::setup_if_addr(uint32_t eps_bearer_id, uint8_t pdn_type, uint32_t ip_addr
 
   default_eps_bearer_id = static_cast<int>(eps_bearer_id);
 
-  // Setup a thread to receive packets from the TUN device
+  // Setup a thread to receive packets from the TUN device, plus one per additional queue
   run_enable = true;
   start(GW_THREAD_PRIO);
+  for (int32_t fd : tun_queue_fds) {
+    queue_readers.emplace_back(new tun_queue_reader(this, fd));
+    queue_readers.back()->start(GW_THREAD_PRIO);
+  }
 
   return SRSRAN_SUCCESS;
 }
@@ -274,6 +504,11 @@ void gw::add_mch_port(uint32_t lcid, uint32_t port)
 /********************/
 void gw::run_thread()
 {
+  if (batched_rx()) {
+    run_batched_rx(tun_fd);
+    return;
+  }
+
   uint32 idx     = 0;
   int32  N_bytes = 0;
 
@@ -393,6 +628,198 @@ void gw::run_thread()
   logger.info("GW IP receiver thread exiting.");
 }
 
+/**
+ * Receive loop of the batched mode. Every wake-up drains up to tun_batch_size packets from one TUN queue, which are
+ * then pushed to the stack in runs of consecutive packets mapped to the same EPS bearer.
+ * TUN devices return a single packet per read() or readv(). With tun_vnet_hdr, a single read may return a TSO packet
+ * of up to 64 KB, which is segmented here.
+ */
+void gw::run_batched_rx(int32_t fd)
+{
+  const uint32_t                            batch_size = std::max(args.tun_batch_size, 1U);
+  std::vector<srsran::unique_byte_buffer_t> batch;
+  std::vector<uint8_t>                      vnet_buf(args.tun_vnet_hdr ? GW_VNET_MAX_PKT_SIZE : 0);
+  batch.reserve(batch_size);
+
+  if (fd == tun_fd) {
+    running = true;
+  }
+  logger.info("GW IP packet receiver thread running for TUN fd=%d, batch_size=%d", fd, batch_size);
+
+  struct pollfd pfd = {};
+  pfd.fd            = fd;
+  pfd.events        = POLLIN;
+  bool failure      = false;
+  while (run_enable && !failure) {
+    int ret = poll(&pfd, 1, GW_POLL_TIMEOUT_MS);
+    if (ret == 0 || (ret < 0 && errno == EINTR)) {
+      continue;
+    }
+    if (ret < 0 || (pfd.revents & (POLLERR | POLLHUP | POLLNVAL))) {
+      failure = true;
+      break;
+    }
+
+    // Drain the queue, the fd is non-blocking
+    for (uint32_t n = 0; n < batch_size; n++) {
+      if (args.tun_vnet_hdr) {
+        int N_bytes = read(fd, vnet_buf.data(), vnet_buf.size());
+        if (N_bytes < 0) {
+          failure = (errno != EAGAIN && errno != EWOULDBLOCK);
+          break;
+        }
+        if (gw_vnet_segment(vnet_buf.data(), N_bytes, batch) < 0) {
+          logger.warning("Dropping TUN packet with %d B that could not be segmented", N_bytes);
+        }
+      } else {
+        srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+        if (pdu == nullptr) {
+          logger.warning("Couldn't allocate PDU in %s().", __FUNCTION__);
+          break;
+        }
+        int N_bytes = read(fd, pdu->msg, SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET);
+        if (N_bytes < 0) {
+          failure = (errno != EAGAIN && errno != EWOULDBLOCK);
+          break;
+        }
+        pdu->N_bytes = N_bytes;
+        if (get_ip_pkt_len(pdu->msg, pdu->N_bytes) != pdu->N_bytes) {
+          logger.error(pdu->msg, pdu->N_bytes, "Unsupported IP version or truncated packet. Dropping packet.");
+          continue;
+        }
+        batch.push_back(std::move(pdu));
+      }
+    }
+
+    if (!batch.empty()) {
+      write_batch(batch);
+    }
+  }
+
+  if (failure) {
+    logger.error("Failed to read from TUN interface - gw receive thread exiting.");
+    srsran::console("Failed to read from TUN interface - gw receive thread exiting.\n");
+  }
+  if (fd == tun_fd) {
+    running = false;
+  }
+  logger.info("GW IP receiver thread for TUN fd=%d exiting.", fd);
+}
+
+void gw::write_batch(std::vector<srsran::unique_byte_buffer_t>& batch)
+{
+  const static uint32_t REGISTER_WAIT_TOUT = 40;
+
+  // Make sure UE is attached and has default EPS bearer activated
+  for (uint32_t register_wait = 0;
+       run_enable && default_eps_bearer_id == NOT_ASSIGNED && register_wait < REGISTER_WAIT_TOUT;
+       register_wait++) {
+    if (!register_wait) {
+      logger.info("UE is not attached, waiting for NAS attach (%d/%d)", register_wait, REGISTER_WAIT_TOUT);
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  int32_t default_bearer = default_eps_bearer_id;
+  if (!run_enable || default_bearer == NOT_ASSIGNED) {
+    batch.clear();
+    return;
+  }
+
+  // Route every packet and push runs of packets with the same EPS bearer together
+  uint32_t run_start  = 0;
+  uint8_t  run_bearer = 0;
+  for (uint32_t i = 0; i <= batch.size(); i++) {
+    uint8_t eps_bearer_id = default_bearer;
+    if (i < batch.size()) {
+      logger.info(batch[i]->msg, batch[i]->N_bytes, "TX PDU");
+      tft_matcher.check_tft_filter_match(batch[i], eps_bearer_id);
+    }
+    if (i > run_start && (i == batch.size() || eps_bearer_id != run_bearer)) {
+      if (!wait_for_service(run_bearer)) {
+        break;
+      }
+      uint32_t nof_bytes = 0;
+      for (uint32_t j = run_start; j < i; j++) {
+        batch[j]->set_timestamp();
+        nof_bytes += batch[j]->N_bytes;
+      }
+      ul_tput_bytes += nof_bytes;
+      stack->write_sdu_batch(run_bearer, &batch[run_start], i - run_start);
+      run_start = i;
+    }
+    run_bearer = eps_bearer_id;
+  }
+  batch.clear();
+}
+
+/**
+ * Waits for the radio bearer of an EPS bearer to become active, triggering a service request if needed.
+ * @return false if the GW is stopping.
+ */
+bool gw::wait_for_service(uint32_t eps_bearer_id)
+{
+  const static uint32_t SERVICE_WAIT_TOUT = 40; // 4 sec
+
+  for (uint32_t service_wait = 0;
+       run_enable && !stack->has_active_radio_bearer(eps_bearer_id) && service_wait < SERVICE_WAIT_TOUT;
+       service_wait++) {
+    if (!service_wait) {
+      logger.info("UE does not have service, waiting for NAS service request (%d/%d)", service_wait, SERVICE_WAIT_TOUT);
+      stack->start_service_request();
+    }
+    usleep(100000);
+  }
+  return run_enable;
+}
+
+/**
+ * Writes one IP packet to the TUN device, prepending an empty virtio-net header if tun_vnet_hdr is enabled.
+ * In batched mode the TUN fd is non-blocking. A write to a full queue waits up to GW_TUN_WRITE_TIMEOUT_MS for room
+ * once, then the packet is dropped and counted.
+ */
+int gw::tun_write(const uint8_t* data, uint32_t nof_bytes)
+{
+  vnet_hdr_t   vnet_hdr = {};
+  struct iovec iov[2];
+  int          nof_iov = 0;
+  if (args.tun_vnet_hdr) {
+    vnet_hdr.gso_type     = VNET_HDR_GSO_NONE;
+    iov[nof_iov].iov_base = &vnet_hdr;
+    iov[nof_iov].iov_len  = sizeof(vnet_hdr);
+    nof_iov++;
+  }
+  iov[nof_iov].iov_base = (void*)data;
+  iov[nof_iov].iov_len  = nof_bytes;
+  nof_iov++;
+
+  int n = writev(tun_fd, iov, nof_iov);
+  if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+    struct pollfd pfd = {};
+    pfd.fd            = tun_fd;
+    pfd.events        = POLLOUT;
+    if (poll(&pfd, 1, GW_TUN_WRITE_TIMEOUT_MS) > 0) {
+      n = writev(tun_fd, iov, nof_iov);
+    }
+    if (n < 0) {
+      dl_dropped_pkts++;
+      logger.debug("TUN queue full, dropping DL packet with %d B", nof_bytes);
+      return n;
+    }
+  }
+  if (args.tun_vnet_hdr && n >= (int)sizeof(vnet_hdr)) {
+    n -= (int)sizeof(vnet_hdr);
+  }
+  return n;
+}
+
+void gw::stop_rx_threads()
+{
+  for (std::unique_ptr<tun_queue_reader>& reader : queue_readers) {
+    reader->wait_thread_finish();
+  }
+  queue_readers.clear();
+}
+
 /**************************/
 /* TUN Interface Helpers  */
 /**************************/
@@ -420,26 +847,38 @@ int gw::init_if(char* err_str)
   }
 
   // Construct the TUN device
-  tun_fd = open("/dev/net/tun", O_RDWR);
-  logger.info("TUN file descriptor = %d", tun_fd);
-  if (0 > tun_fd) {
-    err_str = strerror(errno);
-    logger.error("Failed to open TUN device: %s", err_str);
-    return SRSRAN_ERROR_CANT_START;
-  }
-
   memset(&ifr, 0, sizeof(ifr));
   ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+  if (args.tun_nof_queues > 1) {
+    ifr.ifr_flags |= IFF_MULTI_QUEUE;
+  }
+  if (args.tun_vnet_hdr) {
+    ifr.ifr_flags |= IFF_VNET_HDR;
+  }
   strncpy(
       ifr.ifr_ifrn.ifrn_name, args.tun_dev_name.c_str(), std::min(args.tun_dev_name.length(), (size_t)(IFNAMSIZ - 1)));
   ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = 0;
-  if (0 > ioctl(tun_fd, TUNSETIFF, &ifr)) {
-    err_str = strerror(errno);
-    logger.error("Failed to set TUN device name: %s", err_str);
-    close(tun_fd);
+  struct ifreq queue_ifr               = ifr;
+  tun_fd                               = open_tun_queue(&ifr, err_str);
+  if (0 > tun_fd) {
     return SRSRAN_ERROR_CANT_START;
   }
 
+  // Attach the additional queues of a multi-queue device
+  for (uint32_t i = 1; i < args.tun_nof_queues; i++) {
+    struct ifreq tmp_ifr = queue_ifr;
+    int32_t      fd      = open_tun_queue(&tmp_ifr, err_str);
+    if (0 > fd) {
+      for (int32_t queue_fd : tun_queue_fds) {
+        close(queue_fd);
+      }
+      tun_queue_fds.clear();
+      close(tun_fd);
+      return SRSRAN_ERROR_CANT_START;
+    }
+    tun_queue_fds.push_back(fd);
+  }
+
   // Bring up the interface
   sock = socket(AF_INET, SOCK_DGRAM, 0);
   if (0 > ioctl(sock, SIOCGIFFLAGS, &ifr)) {
@@ -470,6 +909,43 @@ int gw::init_if(char* err_str)
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * Opens /dev/net/tun and attaches it to the device described by ifr_. In batched mode the descriptor is non-blocking
+ * and, with tun_vnet_hdr, TSO and checksum offloads are enabled.
+ * @return File descriptor or -1 on failure.
+ */
+int gw::open_tun_queue(struct ifreq* ifr_, char* err_str)
+{
+  int32_t fd = open("/dev/net/tun", O_RDWR);
+  logger.info("TUN file descriptor = %d", fd);
+  if (0 > fd) {
+    err_str = strerror(errno);
+    logger.error("Failed to open TUN device: %s", err_str);
+    return -1;
+  }
+
+  if (0 > ioctl(fd, TUNSETIFF, ifr_)) {
+    err_str = strerror(errno);
+    logger.error("Failed to set TUN device name: %s", err_str);
+    close(fd);
+    return -1;
+  }
+
+  if (args.tun_vnet_hdr && 0 > ioctl(fd, TUNSETOFFLOAD, TUN_F_CSUM | TUN_F_TSO4 | TUN_F_TSO6)) {
+    // The kernel still prepends the virtio-net header, packets are just not aggregated
+    logger.warning("Failed to enable TUN offloads: %s", strerror(errno));
+  }
+
+  if (batched_rx() && 0 > fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK)) {
+    err_str = strerror(errno);
+    logger.error("Failed to set non-blocking TUN device: %s", err_str);
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+
 int gw::setup_if_addr4(uint32_t ip_addr, char* err_str)
 {
   if (ip_addr != current_ip_addr) {
@@ -0,0 +1,224 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * UL throughput benchmark of the GW. UDP flows are sent from the host into the TUN device, the GW reads them and
+ * pushes them to a dummy stack that only counts them. Requires permissions to create TUN devices.
+ */
+
+#include "srsran/common/multiqueue.h"
+#include "srsran/interfaces/ue_pdcp_interfaces.h"
+#include "srsran/srslog/srslog.h"
+#include "srsue/hdr/stack/upper/gw.h"
+
+#include <arpa/inet.h>
+#include <getopt.h>
+#include <sys/socket.h>
+#include <thread>
+
+static uint32_t    duration_s     = 2;
+static uint32_t    payload_size   = 1400;
+static uint32_t    nof_flows      = 4;
+static uint32_t    tun_nof_queues = 1;
+static uint32_t    tun_batch_size = 1;
+static bool        tun_vnet_hdr   = false;
+static std::string tun_dev_name   = "tun_gw_bench";
+
+/// Stack that hands the SDUs over to its own thread through a task queue, like ue_stack_lte, and only counts them
+class bench_stack_dummy : public srsue::stack_interface_gw
+{
+public:
+  bench_stack_dummy() : gw_queue(pending_tasks.add_queue())
+  {
+    worker = std::thread([this]() {
+      srsran::move_task_t task;
+      while (pending_tasks.wait_pop(&task)) {
+        task();
+      }
+    });
+  }
+  ~bench_stack_dummy()
+  {
+    pending_tasks.stop();
+    worker.join();
+  }
+
+  bool is_registered() { return true; }
+  bool start_service_request() { return true; };
+  void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu)
+  {
+    auto task = [this](srsran::unique_byte_buffer_t& sdu) {
+      nof_bytes += sdu->N_bytes;
+      nof_sdus++;
+    };
+    gw_queue.try_push(std::bind(task, std::move(sdu)));
+  }
+  void write_sdu_batch(uint32_t eps_bearer_id, srsran::unique_byte_buffer_t* sdus, uint32_t nof_sdus_)
+  {
+    std::vector<srsran::unique_byte_buffer_t> batch;
+    batch.reserve(nof_sdus_);
+    for (uint32_t i = 0; i < nof_sdus_; i++) {
+      batch.push_back(std::move(sdus[i]));
+    }
+    auto task = [this](std::vector<srsran::unique_byte_buffer_t>& batch) {
+      for (srsran::unique_byte_buffer_t& sdu : batch) {
+        nof_bytes += sdu->N_bytes;
+        nof_sdus++;
+      }
+    };
+    gw_queue.try_push(std::bind(task, std::move(batch)));
+  }
+  bool has_active_radio_bearer(uint32_t eps_bearer_id) { return true; }
+
+  std::atomic<uint64_t> nof_bytes = {0};
+  std::atomic<uint64_t> nof_sdus  = {0};
+
+private:
+  srsran::task_multiqueue   pending_tasks;
+  srsran::task_queue_handle gw_queue;
+  std::thread               worker;
+};
+
+void usage(char* prog)
+{
+  printf("Usage: %s [-tX] [-sX] [-fX] [-qX] [-bX] [-v] [-nX]\n", prog);
+  printf("\t-t Duration in seconds [Default %d]\n", duration_s);
+  printf("\t-s UDP payload size in bytes [Default %d]\n", payload_size);
+  printf("\t-f Number of UDP flows [Default %d]\n", nof_flows);
+  printf("\t-q Number of TUN queues [Default %d]\n", tun_nof_queues);
+  printf("\t-b TUN batch size [Default %d]\n", tun_batch_size);
+  printf("\t-v Enable virtio-net headers [Default %s]\n", tun_vnet_hdr ? "true" : "false");
+  printf("\t-n TUN device name [Default %s]\n", tun_dev_name.c_str());
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "t:s:f:q:b:vn:")) != -1) {
+    switch (opt) {
+      case 't':
+        duration_s = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        payload_size = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'f':
+        nof_flows = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'q':
+        tun_nof_queues = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'b':
+        tun_batch_size = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'v':
+        tun_vnet_hdr = true;
+        break;
+      case 'n':
+        tun_dev_name = optarg;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::init();
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("GW", false);
+
+  srsue::gw_args_t gw_args;
+  gw_args.tun_dev_name     = tun_dev_name;
+  gw_args.tun_dev_netmask  = "255.255.255.0";
+  gw_args.log.gw_level     = "warning";
+  gw_args.log.gw_hex_limit = 0;
+  gw_args.tun_nof_queues   = tun_nof_queues;
+  gw_args.tun_batch_size   = tun_batch_size;
+  gw_args.tun_vnet_hdr     = tun_vnet_hdr;
+
+  bench_stack_dummy stack;
+  srsue::gw         gw(logger);
+  if (gw.init(gw_args, &stack) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Failed to initialize GW\n");
+    return SRSRAN_ERROR;
+  }
+
+  struct in_addr ue_addr;
+  inet_pton(AF_INET, "192.168.56.32", &ue_addr.s_addr);
+  char* err_str = nullptr;
+  if (gw.setup_if_addr(5, LIBLTE_MME_PDN_TYPE_IPV4, ntohl(ue_addr.s_addr), nullptr, err_str) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Failed to setup GW interface. Try to execute with sudo rights.\n");
+    gw.stop();
+    return SRSRAN_SUCCESS;
+  }
+
+  // One socket per flow, so that a multi-queue TUN device spreads them over its queues
+  std::vector<int> socks;
+  for (uint32_t i = 0; i < nof_flows; i++) {
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) {
+      perror("socket");
+      return SRSRAN_ERROR;
+    }
+    socks.push_back(sock);
+  }
+  struct sockaddr_in dst_addr = {};
+  dst_addr.sin_family         = AF_INET;
+  dst_addr.sin_port           = htons(5001);
+  inet_pton(AF_INET, "192.168.56.1", &dst_addr.sin_addr.s_addr);
+
+  std::vector<uint8_t> payload(payload_size, 0xab);
+  uint64_t             nof_sent = 0;
+  auto                 start    = std::chrono::steady_clock::now();
+  auto                 end      = start + std::chrono::seconds(duration_s);
+  while (std::chrono::steady_clock::now() < end) {
+    for (uint32_t n = 0; n < 64; n++) {
+      int sock = socks[nof_sent % nof_flows];
+      if (sendto(sock, payload.data(), payload.size(), 0, (struct sockaddr*)&dst_addr, sizeof(dst_addr)) > 0) {
+        nof_sent++;
+      }
+    }
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+
+  uint64_t nof_sdus  = stack.nof_sdus;
+  uint64_t nof_bytes = stack.nof_bytes;
+  printf("queues=%d batch=%d vnet_hdr=%s flows=%d: sent %ld packets, GW pushed %ld SDUs (%.1f kpps, %.1f Mbps)\n",
+         tun_nof_queues,
+         tun_batch_size,
+         tun_vnet_hdr ? "true" : "false",
+         nof_flows,
+         nof_sent,
+         nof_sdus,
+         nof_sdus / secs.count() / 1e3,
+         nof_bytes * 8 / secs.count() / 1e6);
+
+  for (int sock : socks) {
+    close(sock);
+  }
+  gw.stop();
+  return SRSRAN_SUCCESS;
+}
@@ -72,10 +72,128 @@ int gw_test()
   return SRSRAN_SUCCESS;
 }
 
+// One's complement sum of a buffer, folded to 16 bits
+uint16_t csum_fold(uint32_t sum, const uint8_t* data, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i += 2) {
+    sum += ((uint32_t)data[i] << 8U) | (i + 1 < len ? data[i + 1] : 0);
+  }
+  while (sum >> 16U) {
+    sum = (sum & 0xffffU) + (sum >> 16U);
+  }
+  return sum;
+}
+
+// Builds a virtio-net header followed by an IPv4 TCP packet with nof_payload bytes
+std::vector<uint8_t> make_tso_packet(uint32_t nof_payload, uint16_t gso_size)
+{
+  const uint32_t       vnet_len = 10, ip_len = 20, tcp_len = 20;
+  std::vector<uint8_t> buf(vnet_len + ip_len + tcp_len + nof_payload);
+  uint8_t*             vnet = buf.data();
+  uint8_t*             ip   = vnet + vnet_len;
+  uint8_t*             tcp  = ip + ip_len;
+
+  vnet[1] = 1; // GSO TCPv4
+  memcpy(&vnet[4], &gso_size, sizeof(gso_size));
+
+  uint16_t tot_len = htons(ip_len + tcp_len + nof_payload);
+  ip[0]            = 0x45;
+  memcpy(&ip[2], &tot_len, sizeof(tot_len));
+  ip[4]           = 0x12;
+  ip[5]           = 0x34;
+  ip[8]           = 64;
+  ip[9]           = IPPROTO_TCP;
+  uint8_t addr[8] = {10, 0, 0, 1, 10, 0, 0, 2};
+  memcpy(&ip[12], addr, sizeof(addr));
+
+  uint32_t seq = htonl(1000);
+  tcp[1]       = 80;
+  tcp[3]       = 81;
+  memcpy(&tcp[4], &seq, sizeof(seq));
+  tcp[12] = 5 << 4U;
+  tcp[13] = 0x19; // FIN, PSH, ACK
+
+  for (uint32_t i = 0; i < nof_payload; i++) {
+    tcp[tcp_len + i] = (uint8_t)(i * 7);
+  }
+  return buf;
+}
+
+int gw_vnet_segment_test()
+{
+  const uint32_t                            nof_payload = 3000, mss = 1400;
+  std::vector<uint8_t>                      buf = make_tso_packet(nof_payload, mss);
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+
+  TESTASSERT(srsue::gw_vnet_segment(buf.data(), buf.size(), pdus) == 3);
+  TESTASSERT(pdus.size() == 3);
+
+  uint32_t offset = 0;
+  for (uint32_t i = 0; i < pdus.size(); i++) {
+    uint8_t* ip      = pdus[i]->msg;
+    uint8_t* tcp     = ip + 20;
+    uint32_t seg_len = std::min(mss, nof_payload - offset);
+    TESTASSERT(pdus[i]->N_bytes == 40 + seg_len);
+    TESTASSERT(((ip[2] << 8U) | ip[3]) == pdus[i]->N_bytes);
+    TESTASSERT(((ip[4] << 8U) | ip[5]) == 0x1234 + i);
+    TESTASSERT(csum_fold(0, ip, 20) == 0xffff);
+
+    uint32_t seq = 0;
+    memcpy(&seq, &tcp[4], sizeof(seq));
+    TESTASSERT(ntohl(seq) == 1000 + offset);
+    bool last = i == pdus.size() - 1;
+    TESTASSERT(((tcp[13] & 0x09) != 0) == last);
+
+    // The TCP checksum covers the pseudo-header, header and payload
+    uint32_t pseudo = IPPROTO_TCP + pdus[i]->N_bytes - 20;
+    pseudo          = csum_fold(pseudo, &ip[12], 8);
+    TESTASSERT(csum_fold(pseudo, tcp, pdus[i]->N_bytes - 20) == 0xffff);
+    for (uint32_t j = 0; j < seg_len; j++) {
+      TESTASSERT(tcp[20 + j] == (uint8_t)((offset + j) * 7));
+    }
+    offset += seg_len;
+  }
+
+  // A TCP data offset below the 20 B minimum header is rejected
+  buf[10 + 20 + 12] = 4 << 4U;
+  pdus.clear();
+  TESTASSERT(srsue::gw_vnet_segment(buf.data(), buf.size(), pdus) == SRSRAN_ERROR);
+  buf[10 + 20 + 12] = 5 << 4U;
+
+  // Non-TCP segmentation offloads are not supported
+  buf[1] = 3; // GSO UDP
+  pdus.clear();
+  TESTASSERT(srsue::gw_vnet_segment(buf.data(), buf.size(), pdus) == SRSRAN_ERROR);
+
+  // Plain packet with a partial checksum, the checksum field holds the pseudo-header sum
+  buf = make_tso_packet(100, 0);
+  buf[1]                 = 0; // GSO none
+  buf[0]                 = 1; // needs checksum
+  uint16_t csum_start    = 20;
+  uint16_t csum_offset   = 16;
+  uint8_t* tcp           = &buf[10 + 20];
+  uint16_t pseudo        = csum_fold(IPPROTO_TCP + 120, &buf[10 + 12], 8);
+  memcpy(&buf[6], &csum_start, sizeof(csum_start));
+  memcpy(&buf[8], &csum_offset, sizeof(csum_offset));
+  tcp[16] = pseudo >> 8U;
+  tcp[17] = pseudo & 0xffU;
+  pdus.clear();
+  TESTASSERT(srsue::gw_vnet_segment(buf.data(), buf.size(), pdus) == 1);
+  TESTASSERT(pdus[0]->N_bytes == 140);
+  TESTASSERT(csum_fold(csum_fold(IPPROTO_TCP + 120, &pdus[0]->msg[12], 8), pdus[0]->msg + 20, 120) == 0xffff);
+
+  // Truncated packet
+  pdus.clear();
+  TESTASSERT(srsue::gw_vnet_segment(buf.data(), buf.size() - 1, pdus) == SRSRAN_ERROR);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   srslog::init();
 
+  TESTASSERT(gw_vnet_segment_test() == SRSRAN_SUCCESS);
   TESTASSERT(gw_test() == SRSRAN_SUCCESS);
 
   return SRSRAN_SUCCESS;
@@ -178,7 +178,7 @@ tft_packet_filter_t::tft_packet_filter_t(uint8_t
   }
 }
 
-bool inline tft_packet_filter_t::filter_contains(uint16_t filtertype)
+bool inline tft_packet_filter_t::filter_contains(uint16_t filtertype) const
 {
   return (active_filters & filtertype) != 0;
 }
@@ -191,7 +191,7 @@ bool inline tft_packet_filter_t::filter_contains(uint16_t filtertype)
  *
  * Note: 'active_filters' is a bitmask; bits set to '1' represent active filter components.
  */
-bool tft_packet_filter_t::match(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match(const srsran::unique_byte_buffer_t& pdu) const
 {
   uint16_t ip_flags = IPV4_REMOTE_ADDR_FLAG | IPV4_LOCAL_ADDR_FLAG | IPV6_REMOTE_ADDR_FLAG |
                       IPV6_REMOTE_ADDR_LENGTH_FLAG | IPV6_LOCAL_ADDR_LENGTH_FLAG;
@@ -226,7 +226,7 @@ bool tft_packet_filter_t::match(const srsran::unique_byte_buffer_t& pdu)
   return true;
 }
 
-bool tft_packet_filter_t::match_ip(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_ip(const srsran::unique_byte_buffer_t& pdu) const
 {
   struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
   struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
@@ -263,7 +263,7 @@ bool tft_packet_filter_t::match_ip(const srsran::unique_byte_buffer_t& pdu)
   return true;
 }
 
-bool tft_packet_filter_t::match_protocol(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_protocol(const srsran::unique_byte_buffer_t& pdu) const
 {
   struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
   struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
@@ -285,7 +285,7 @@ bool tft_packet_filter_t::match_protocol(const srsran::unique_byte_buffer_t& pdu
   return true;
 }
 
-bool tft_packet_filter_t::match_type_of_service(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_type_of_service(const srsran::unique_byte_buffer_t& pdu) const
 {
   struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
 
@@ -301,7 +301,7 @@ bool tft_packet_filter_t::match_type_of_service(const srsran::unique_byte_buffer
   return true;
 }
 
-bool tft_packet_filter_t::match_flow_label(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_flow_label(const srsran::unique_byte_buffer_t& pdu) const
 {
   struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
 
@@ -314,7 +314,7 @@ bool tft_packet_filter_t::match_flow_label(const srsran::unique_byte_buffer_t& p
   return true;
 }
 
-bool tft_packet_filter_t::match_port(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_port(const srsran::unique_byte_buffer_t& pdu) const
 {
   struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
   struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
@@ -389,20 +389,35 @@ bool tft_packet_filter_t::match_port(const srsran::unique_byte_buffer_t& pdu)
 
 void tft_pdu_matcher::reset()
 {
-  tft_filter_map.clear();
+  std::lock_guard<std::mutex> lock(tft_mutex);
+  publish(tft_filter_map_t());
+}
+
+/**
+ * Replaces the filter snapshot seen by check_tft_filter_match(). Must be called with tft_mutex held.
+ */
+void tft_pdu_matcher::publish(tft_filter_map_t filters)
+{
+  bool empty = filters.empty();
+  std::atomic_store(&tft_filter_map, std::shared_ptr<const tft_filter_map_t>(new tft_filter_map_t(std::move(filters))));
+  has_filters = not empty;
 }
 
 /**
  * Checks whether the provided PDU matches any configured TFT.
  * If it finds a match, it updates the eps_bearer_id parameter.
+ * Lookups do not take tft_mutex, they iterate over an immutable snapshot of the filters.
  * @param pdu           Reference to the PDU to check.
  * @param eps_bearer_id Reference to variable to store EPS bearer ID.
  * @return SRSRAN_SUCCESS if a reference could be found, SRSRAN_ERROR otherwise.
  */
 int tft_pdu_matcher::check_tft_filter_match(const srsran::unique_byte_buffer_t& pdu, uint8_t& eps_bearer_id)
 {
-  std::lock_guard<std::mutex> lock(tft_mutex);
-  for (std::pair<const uint16_t, tft_packet_filter_t>& filter_pair : tft_filter_map) {
+  if (not has_filters) {
+    return SRSRAN_ERROR;
+  }
+  std::shared_ptr<const tft_filter_map_t> filters = std::atomic_load(&tft_filter_map);
+  for (const std::pair<const uint16_t, tft_packet_filter_t>& filter_pair : *filters) {
     bool match = filter_pair.second.match(pdu);
     if (match) {
       eps_bearer_id = filter_pair.second.eps_bearer_id;
@@ -421,13 +436,15 @@ int tft_pdu_matcher::check_tft_filter_match(const srsran::unique_byte_buffer_t&
 void tft_pdu_matcher::delete_tft_for_eps_bearer(const uint8_t eps_bearer_id)
 {
   std::lock_guard<std::mutex> lock(tft_mutex);
+  tft_filter_map_t            filters    = *std::atomic_load(&tft_filter_map);
   auto                        old_filter = std::find_if(
-      tft_filter_map.begin(), tft_filter_map.end(), [&](const std::pair<uint16_t, tft_packet_filter_t>& filter) {
+      filters.begin(), filters.end(), [&](const std::pair<uint16_t, tft_packet_filter_t>& filter) {
         return filter.second.eps_bearer_id == eps_bearer_id;
       });
-  if (old_filter != tft_filter_map.end()) {
+  if (old_filter != filters.end()) {
     logger.debug("Deleting TFT for EPS bearer %d", eps_bearer_id);
-    tft_filter_map.erase(old_filter);
+    filters.erase(old_filter);
+    publish(std::move(filters));
   }
 }
 
@@ -435,6 +452,17 @@ int tft_pdu_matcher::apply_traffic_flow_template(const uint8_t&
                                                  const LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT* tft)
 {
   std::lock_guard<std::mutex> lock(tft_mutex);
+  // Changes are applied to a private copy, which is published even on failure to keep the filters inserted so far
+  tft_filter_map_t filters = *std::atomic_load(&tft_filter_map);
+  int              ret     = apply_traffic_flow_template(filters, eps_bearer_id, tft);
+  publish(std::move(filters));
+  return ret;
+}
+
+int tft_pdu_matcher::apply_traffic_flow_template(tft_filter_map_t&                              filters,
+                                                 const uint8_t&                                 eps_bearer_id,
+                                                 const LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT* tft)
+{
   switch (tft->tft_op_code) {
     case LIBLTE_MME_TFT_OPERATION_CODE_CREATE_NEW_TFT:
       for (int i = 0; i < tft->packet_filter_list_size; i++) {
@@ -442,7 +470,7 @@ int tft_pdu_matcher::apply_traffic_flow_template(const uint8_t&
                     eps_bearer_id,
                     tft->packet_filter_list[i].eval_precedence);
         tft_packet_filter_t filter(eps_bearer_id, tft->packet_filter_list[i], logger);
-        auto                it = tft_filter_map.insert(std::make_pair(filter.eval_precedence, filter));
+        auto                it = filters.insert(std::make_pair(filter.eval_precedence, filter));
         if (it.second == false) {
           logger.error("Error inserting TFT Packet Filter");
           return SRSRAN_ERROR_CANT_START;
@@ -453,20 +481,20 @@ int tft_pdu_matcher::apply_traffic_flow_template(const uint8_t&
       for (int i = 0; i < tft->packet_filter_list_size; i++) {
         // erase old filter if it exists
         auto old_filter = std::find_if(
-            tft_filter_map.begin(), tft_filter_map.end(), [&](const std::pair<uint16_t, tft_packet_filter_t>& filter) {
+            filters.begin(), filters.end(), [&](const std::pair<uint16_t, tft_packet_filter_t>& filter) {
               return filter.second.id == tft->packet_filter_list[i].id;
             });
-        if (old_filter == tft_filter_map.end()) {
+        if (old_filter == filters.end()) {
           logger.error("Error couldn't find TFT with id %d", tft->packet_filter_list[i].id);
           return SRSRAN_ERROR_CANT_START;
         }
 
         // release old filter
-        tft_filter_map.erase(old_filter);
+        filters.erase(old_filter);
 
         // Add new filter
         tft_packet_filter_t new_filter(eps_bearer_id, tft->packet_filter_list[i], logger);
-        auto                it = tft_filter_map.insert(std::make_pair(new_filter.eval_precedence, new_filter));
+        auto                it = filters.insert(std::make_pair(new_filter.eval_precedence, new_filter));
         if (it.second == false) {
           logger.error("Error inserting TFT Packet Filter");
           return SRSRAN_ERROR_CANT_START;
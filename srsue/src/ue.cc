@@ -39,6 +39,26 @@ using namespace srsran;
 
 namespace srsue {
 
+/// Adds the offset to a decimal identity (IMSI or IMEI) keeping its number of digits
+static std::string get_ue_identity(const std::string& identity, uint32_t offset)
+{
+  std::string ret = std::to_string(std::stoull(identity) + offset);
+  if (ret.size() < identity.size()) {
+    ret.insert(0, identity.size() - ret.size(), '0');
+  }
+  return ret;
+}
+
+/// Appends the UE index to a file or device name, before its extension, so that the additional UEs do not share it
+static std::string get_ue_name(const std::string& name, uint32_t ue_idx)
+{
+  std::string::size_type ext = name.find_last_of('.');
+  if (ext == std::string::npos or (name.find_last_of('/') != std::string::npos and name.find_last_of('/') > ext)) {
+    ext = name.size();
+  }
+  return name.substr(0, ext) + "_" + std::to_string(ue_idx) + name.substr(ext);
+}
+
 ue::ue() : logger(srslog::fetch_basic_logger("UE", false)), sys_proc(logger)
 {
   // print build info
@@ -47,6 +67,7 @@ ue::ue() : logger(srslog::fetch_basic_logger("UE", false)), sys_proc(logger)
 
 ue::~ue()
 {
+  ue_stacks.clear();
   stack.reset();
 }
 
@@ -77,6 +98,14 @@ int ue::init(const all_args_t& args_)
     return SRSRAN_ERROR;
   }
 
+  // Additional UEs sharing the EUTRA PHY, each one with its own stack, USIM and GW
+  std::vector<std::unique_ptr<ue_stack_lte> > ue_stack_ptrs;
+  std::vector<std::unique_ptr<gw> >           ue_gw_ptrs;
+  for (uint32_t ue_idx = 1; ue_idx < args.phy.nof_ue; ue_idx++) {
+    ue_stack_ptrs.emplace_back(new ue_stack_lte);
+    ue_gw_ptrs.emplace_back(new gw(srslog::fetch_basic_logger("GW", false)));
+  }
+
   std::unique_ptr<srsran::radio> lte_radio = std::unique_ptr<srsran::radio>(new srsran::radio);
   if (!lte_radio) {
     srsran::console("Error creating radio multi instance.\n");
@@ -93,6 +122,9 @@ int ue::init(const all_args_t& args_)
   phy_args_nr.store_pdsch_ko       = args.phy.nr_store_pdsch_ko;
   phy_args_nr.srate_hz             = args.rf.srate_hz;
 
+  phy_args_nr.dl.pdsch.sch.decoder_early_stop       = args.phy.nr_pdsch_early_stop;
+  phy_args_nr.dl.pdsch.sch.decoder_early_abort_iter = args.phy.nr_pdsch_abort_its;
+
   // init layers
   if (args.phy.nof_lte_carriers == 0) {
     // SA mode
@@ -139,7 +171,11 @@ int ue::init(const all_args_t& args_)
       return SRSRAN_ERROR;
     }
     // from here onwards do not exit immediately if something goes wrong as sub-layers may already use interfaces
-    if (lte_phy->init(args.phy, lte_stack.get(), lte_radio.get())) {
+    std::vector<stack_interface_phy_lte*> phy_stacks = {lte_stack.get()};
+    for (std::unique_ptr<ue_stack_lte>& ue_stack : ue_stack_ptrs) {
+      phy_stacks.push_back(ue_stack.get());
+    }
+    if (lte_phy->init(args.phy, phy_stacks, lte_radio.get())) {
       srsran::console("Error initializing PHY.\n");
       ret = SRSRAN_ERROR;
     }
@@ -153,6 +189,18 @@ int ue::init(const all_args_t& args_)
       srsran::console("Error initializing stack.\n");
       ret = SRSRAN_ERROR;
     }
+    for (uint32_t ue_idx = 1; ue_idx < args.phy.nof_ue; ue_idx++) {
+      stack_args_t ue_stack_args                   = args.stack;
+      ue_stack_args.usim.imsi                      = get_ue_identity(args.stack.usim.imsi, ue_idx);
+      ue_stack_args.usim.imei                      = get_ue_identity(args.stack.usim.imei, ue_idx);
+      ue_stack_args.pkt_trace.mac_pcap.filename    = get_ue_name(args.stack.pkt_trace.mac_pcap.filename, ue_idx);
+      ue_stack_args.pkt_trace.mac_nr_pcap.filename = get_ue_name(args.stack.pkt_trace.mac_nr_pcap.filename, ue_idx);
+      ue_stack_args.pkt_trace.nas_pcap.filename    = get_ue_name(args.stack.pkt_trace.nas_pcap.filename, ue_idx);
+      if (ue_stack_ptrs[ue_idx - 1]->init(ue_stack_args, lte_phy->get_ue_phy(ue_idx), ue_gw_ptrs[ue_idx - 1].get())) {
+        srsran::console("Error initializing stack of UE %d.\n", ue_idx);
+        ret = SRSRAN_ERROR;
+      }
+    }
     phy = std::move(lte_phy);
   }
 
@@ -160,11 +208,23 @@ int ue::init(const all_args_t& args_)
     srsran::console("Error initializing GW.\n");
     ret = SRSRAN_ERROR;
   }
+  for (uint32_t ue_idx = 1; ue_idx < args.phy.nof_ue; ue_idx++) {
+    gw_args_t ue_gw_args    = args.gw;
+    ue_gw_args.tun_dev_name = get_ue_name(args.gw.tun_dev_name, ue_idx);
+    if (ue_gw_ptrs[ue_idx - 1]->init(ue_gw_args, ue_stack_ptrs[ue_idx - 1].get())) {
+      srsran::console("Error initializing GW of UE %d.\n", ue_idx);
+      ret = SRSRAN_ERROR;
+    }
+  }
 
   // move ownership
   stack   = std::move(lte_stack);
   gw_inst = std::move(gw_ptr);
   radio   = std::move(lte_radio);
+  for (uint32_t i = 0; i < ue_stack_ptrs.size(); i++) {
+    ue_stacks.emplace_back(std::move(ue_stack_ptrs[i]));
+    ue_gws.emplace_back(std::move(ue_gw_ptrs[i]));
+  }
 
   if (phy) {
     srsran::console("Waiting PHY to initialize ... ");
@@ -295,6 +355,32 @@ int ue::parse_args(const all_args_t& args_)
     args.stack.nas_5g.pdu_session_cfgs.push_back({args.stack.nas.apn_name});
   }
 
+  // The additional UEs share the PCell and the radio of the first one
+  if (args.phy.nof_ue == 0) {
+    srsran::console("Error: rat.eutra.nof_ue must be at least 1\n");
+    return SRSRAN_ERROR;
+  }
+  if (args.phy.nof_ue > 1) {
+    if (args.phy.nof_lte_carriers != 1 or args.phy.nof_nr_carriers != 0) {
+      srsran::console("Error: rat.eutra.nof_ue > 1 requires a single EUTRA carrier and no NR carrier\n");
+      return SRSRAN_ERROR;
+    }
+    if (args.stack.usim.mode != "soft") {
+      srsran::console("Error: rat.eutra.nof_ue > 1 requires the soft USIM\n");
+      return SRSRAN_ERROR;
+    }
+    if (args.stack.usim.imsi.empty() or args.stack.usim.imei.empty() or
+        args.stack.usim.imsi.find_first_not_of("0123456789") != std::string::npos or
+        args.stack.usim.imei.find_first_not_of("0123456789") != std::string::npos) {
+      srsran::console("Error: rat.eutra.nof_ue > 1 requires a decimal IMSI and IMEI\n");
+      return SRSRAN_ERROR;
+    }
+    if (args.stack.rrc.mbms_service_id > -1) {
+      srsran::console("Error: MBMS is not supported with rat.eutra.nof_ue > 1\n");
+      return SRSRAN_ERROR;
+    }
+  }
+
   // Validate the CFR args
   srsran_cfr_cfg_t cfr_test_cfg = {};
   cfr_test_cfg.cfr_enable       = args.phy.cfr_args.enable;
@@ -328,10 +414,16 @@ int ue::parse_args(const all_args_t& args_)
 void ue::stop()
 {
   // tear down UE in reverse order
+  for (std::unique_ptr<ue_stack_base>& ue_stack : ue_stacks) {
+    ue_stack->stop();
+  }
   if (stack) {
     stack->stop();
   }
 
+  for (std::unique_ptr<gw>& ue_gw : ue_gws) {
+    ue_gw->stop();
+  }
   if (gw_inst) {
     gw_inst->stop();
   }
@@ -347,16 +439,26 @@ void ue::stop()
 
 bool ue::switch_on()
 {
-  return stack->switch_on();
+  bool ret = stack->switch_on();
+  for (std::unique_ptr<ue_stack_base>& ue_stack : ue_stacks) {
+    ret &= ue_stack->switch_on();
+  }
+  return ret;
 }
 
 bool ue::switch_off()
 {
+  for (std::unique_ptr<gw>& ue_gw : ue_gws) {
+    ue_gw->stop();
+  }
   if (gw_inst) {
     gw_inst->stop();
   }
 
   // send switch off
+  for (std::unique_ptr<ue_stack_base>& ue_stack : ue_stacks) {
+    ue_stack->switch_off();
+  }
   stack->switch_off();
 
   // wait for max. 5s for it to be sent (according to TS 24.301 Sec 25.5.2.2)
@@ -74,6 +74,7 @@ public:
     uint32_t                            cqi_valid_count = 0;  ///< Valid CQI counter
     pucch_metrics_t                     pucch           = {};
     pucch_metrics_t                     pusch           = {};
+    uint32_t                            nof_ues         = 1;  ///< Number of scheduled UEs, including load UEs
   };
 
 private:
@@ -150,6 +151,8 @@ private:
     bool                valid = false;
     uint32_t            pid   = 0;
 
+    srsran::bounded_vector<srsran_sch_cfg_nr_t, mac_interface_phy_nr::MAX_GRANTS> load_pusch;
+
   public:
     pending_pusch_t() = default;
     void push(const uint32_t& pid_, const srsran_sch_cfg_nr_t& pusch_)
@@ -158,6 +161,21 @@ private:
       pusch = pusch_;
       pid   = pid_;
       valid = true;
+      load_pusch.clear();
+    }
+
+    void push_load(const srsran_sch_cfg_nr_t& pusch_)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      load_pusch.push_back(pusch_);
+    }
+
+    srsran::bounded_vector<srsran_sch_cfg_nr_t, mac_interface_phy_nr::MAX_GRANTS> pop_load()
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      srsran::bounded_vector<srsran_sch_cfg_nr_t, mac_interface_phy_nr::MAX_GRANTS> ret = load_pusch;
+      load_pusch.clear();
+      return ret;
     }
 
     bool pop(uint32_t& pid_, srsran_sch_cfg_nr_t& pusch_)
@@ -175,6 +193,17 @@ private:
   dummy_tx_harq_entity tx_harq_proc;
   dummy_rx_harq_entity rx_harq_proc;
 
+  // Load UEs, scheduled next to the UE under test only to load the gNb PHY
+  static const uint32_t LOAD_UE_NOF_HARQ = 4; ///< Enough for the gNb slots in flight
+  struct load_ue_t {
+    uint16_t                                                    rnti        = 0;
+    uint32_t                                                    dl_freq_res = 0;
+    uint32_t                                                    ul_freq_res = 0;
+    srsran::circular_array<dummy_tx_harq_proc, LOAD_UE_NOF_HARQ> tx_harq_proc;
+    srsran::circular_array<dummy_rx_harq_proc, LOAD_UE_NOF_HARQ> rx_harq_proc;
+  };
+  std::vector<std::unique_ptr<load_ue_t> > load_ues;
+
   bool schedule_pdsch(const srsran_slot_cfg_t& slot_cfg, dl_sched_t& dl_sched)
   {
     if (dl.slots.count(SRSRAN_SLOT_NR_MOD(srsran_subcarrier_spacing_15kHz, slot_cfg.idx)) == 0 or
@@ -238,6 +267,26 @@ private:
     dl_sched.pdcch_dl.push_back(pdcch);
     dl_sched.pdsch.push_back(pdsch);
 
+    // Schedule load UEs with the same DCI in the adjacent resource blocks, no PDCCH is transmitted for them
+    for (std::unique_ptr<load_ue_t>& ue : load_ues) {
+      srsran_dci_dl_nr_t load_dci    = dci;
+      load_dci.ctx.rnti              = ue->rnti;
+      load_dci.freq_domain_assigment = ue->dl_freq_res;
+
+      pdsch_t load_pdsch = {};
+      if (not phy_cfg.get_pdsch_cfg(slot_cfg, load_dci, load_pdsch.sch)) {
+        logger.error("Error converting load UE DCI to grant");
+        return false;
+      }
+
+      dummy_tx_harq_proc& proc                 = ue->tx_harq_proc[slot_cfg.idx];
+      load_pdsch.data[0]                       = proc.get_tb(load_pdsch.sch.grant.tb[0].tbs);
+      load_pdsch.data[1]                       = nullptr;
+      load_pdsch.sch.grant.tb[0].softbuffer.tx = &proc.get_softbuffer(dci.ndi);
+      srsran_softbuffer_tx_reset(load_pdsch.sch.grant.tb[0].softbuffer.tx);
+      dl_sched.pdsch.push_back(load_pdsch);
+    }
+
     // Generate PDSCH HARQ Feedback
     srsran_harq_ack_resource_t ack_resource = {};
     if (not phy_cfg.get_pdsch_ack_resource(dci, ack_resource)) {
@@ -297,6 +346,23 @@ private:
     // Set pending PUSCH
     pending_pusch[TTI_TX(slot_cfg.idx) % pending_pusch.size()].push(dci.pid, pusch_cfg);
 
+    // Set pending PUSCH for the load UEs, no PDCCH is transmitted for them
+    for (std::unique_ptr<load_ue_t>& ue : load_ues) {
+      srsran_dci_ul_nr_t load_dci    = dci;
+      load_dci.ctx.rnti              = ue->rnti;
+      load_dci.freq_domain_assigment = ue->ul_freq_res;
+
+      srsran_sch_cfg_nr_t load_pusch_cfg = {};
+      if (not phy_cfg.get_pusch_cfg(slot_cfg, load_dci, load_pusch_cfg)) {
+        logger.error("Error converting load UE DCI to grant");
+        return false;
+      }
+
+      load_pusch_cfg.grant.tb[0].softbuffer.rx =
+          &ue->rx_harq_proc[slot_cfg.idx].get_softbuffer(dci.ndi, load_pusch_cfg.grant.tb[0].tbs);
+      pending_pusch[TTI_TX(slot_cfg.idx) % pending_pusch.size()].push_load(load_pusch_cfg);
+    }
+
     return true;
   }
 
@@ -358,7 +424,8 @@ public:
       uint32_t    mcs       = 10; ///< Modulation code scheme
       std::string slots     = ""; ///< Slot list, empty string means no scheduling
     } pdsch, pusch;
-    std::string log_level = "warning";
+    uint32_t    nof_load_ues = 0; ///< Number of UEs scheduled next to the UE under test to load the gNb PHY (dummy MAC)
+    std::string log_level    = "warning";
   };
 
   gnb_dummy_stack(const args_t& args) :
@@ -445,6 +512,28 @@ public:
     // Select DL frequency domain resources
     ul.freq_res = srsran_ra_nr_type1_riv(args.phy_cfg.carrier.nof_prb, args.pusch.rb_start, args.pusch.rb_length);
 
+    // Create load UEs in the resource blocks following the UE under test, as many as fit in the carrier and grant lists
+    for (uint32_t i = 0; i < args.nof_load_ues and use_dummy_mac; i++) {
+      uint32_t dl_rb_start = args.pdsch.rb_start + (i + 1) * args.pdsch.rb_length;
+      uint32_t ul_rb_start = args.pusch.rb_start + (i + 1) * args.pusch.rb_length;
+      if (dl_rb_start + args.pdsch.rb_length > args.phy_cfg.carrier.nof_prb or
+          ul_rb_start + args.pusch.rb_length > args.phy_cfg.carrier.nof_prb or
+          i + 1 >= mac_interface_phy_nr::MAX_GRANTS) {
+        logger.warning("Only %d of %d load UEs fit in the carrier", i, args.nof_load_ues);
+        break;
+      }
+
+      std::unique_ptr<load_ue_t> ue(new load_ue_t);
+      ue->rnti        = (uint16_t)(rnti + i + 1);
+      ue->dl_freq_res = srsran_ra_nr_type1_riv(args.phy_cfg.carrier.nof_prb, dl_rb_start, args.pdsch.rb_length);
+      ue->ul_freq_res = srsran_ra_nr_type1_riv(args.phy_cfg.carrier.nof_prb, ul_rb_start, args.pusch.rb_length);
+      uint32_t pid    = 0;
+      for (dummy_tx_harq_proc& proc : ue->tx_harq_proc) {
+        proc.init(ue->rnti + pid++);
+      }
+      load_ues.push_back(std::move(ue));
+    }
+
     // Setup DL Data to ACK timing
     for (uint32_t i = 0; i < SRSRAN_NOF_SF_X_FRAME; i++) {
       if (args.phy_cfg.duplex.mode == SRSRAN_DUPLEX_MODE_TDD) {
@@ -616,6 +705,13 @@ public:
       }
 
       ul_sched.pusch.push_back(pusch);
+
+      // Append load UEs PUSCH, they do not carry UCI
+      for (const srsran_sch_cfg_nr_t& load_pusch : pending_pusch[slot_cfg.idx % pending_pusch.size()].pop_load()) {
+        ul_sched.pusch.emplace_back();
+        ul_sched.pusch.back().pid = pusch.pid;
+        ul_sched.pusch.back().sch = load_pusch;
+      }
     } else if ((uci_cfg.ack.count > 0 || uci_cfg.nof_csi > 0 || uci_cfg.o_sr > 0) and enable_user_sched) {
       // If any UCI information is triggered, schedule PUCCH
       ul_sched.pucch.emplace_back();
@@ -689,6 +785,11 @@ public:
 
   int pusch_info(const srsran_slot_cfg_t& slot_cfg, pusch_info_t& pusch_info) override
   {
+    // Load UEs transmissions are not accounted
+    if (use_dummy_mac and pusch_info.rnti != rnti) {
+      return SRSRAN_SUCCESS;
+    }
+
     if (not use_dummy_mac) {
       mac->pusch_info(slot_cfg, pusch_info);
     } else {
@@ -748,6 +849,7 @@ public:
       mac->get_metrics(mac_metrics);
       metrics.mac = mac_metrics.ues[0];
     }
+    metrics.nof_ues = 1 + (uint32_t)load_ues.size();
     return metrics;
   }
 
@@ -84,6 +84,7 @@ test_bench::args_t::args_t(int argc, char** argv)
         ("gnb.stack.pusch.length",            bpo::value<uint32_t>(&gnb_stack.pusch.rb_length)->default_value(gnb_stack.pusch.rb_length),                 "PUSCH scheduling frequency allocation length")
         ("gnb.stack.pusch.slots",             bpo::value<std::string>(&gnb_stack.pusch.slots)->default_value(gnb_stack.pusch.slots),                      "Slots enabled for PUSCH")
         ("gnb.stack.pusch.mcs",               bpo::value<uint32_t>(&gnb_stack.pusch.mcs)->default_value(gnb_stack.pusch.mcs),                             "PUSCH scheduling modulation code scheme")
+        ("gnb.stack.nof_load_ues",            bpo::value<uint32_t>(&gnb_stack.nof_load_ues)->default_value(gnb_stack.nof_load_ues),                       "Number of UEs scheduled next to the UE under test to load the gNb PHY")
         ("gnb.stack.log.level",               bpo::value<std::string>(&gnb_stack.log_level)->default_value(gnb_stack.log_level),                          "Stack log level")
         ("gnb.stack.use_dummy_mac",         bpo::value<std::string>(&gnb_stack.use_dummy_mac)->default_value("dummymac"),                                          "Use dummy or real NR scheduler (dummymac or realmac)")
         ;
@@ -94,6 +95,10 @@ test_bench::args_t::args_t(int argc, char** argv)
         ("gnb.phy.log.hex_limit",   bpo::value<int>(&gnb_phy.log.phy_hex_limit)->default_value(0),             "gNb PHY log hex limit")
         ("gnb.phy.log.id_preamble", bpo::value<std::string>(&gnb_phy.log.id_preamble)->default_value("GNB/"),  "gNb PHY log ID preamble")
         ("gnb.phy.pusch.max_iter",  bpo::value<uint32_t>(&gnb_phy.pusch_max_its)->default_value(10),      "PUSCH LDPC max number of iterations")
+        ("gnb.phy.pusch.min_snr",   bpo::value<float>(&gnb_phy.pusch_min_snr_dB)->default_value(gnb_phy.pusch_min_snr_dB), "PUSCH minimum DMRS SNR in dB for decoding")
+        ("gnb.phy.slot_threads",    bpo::value<uint32_t>(&gnb_phy.nof_slot_threads)->default_value(0),        "Number of threads for intra-slot PDSCH/PUSCH processing")
+        ("gnb.phy.pusch.early_stop", bpo::value<bool>(&gnb_phy.pusch_early_stop)->default_value(false),      "PUSCH LDPC syndrome check and early abort")
+        ("gnb.phy.pusch.abort_iter", bpo::value<uint32_t>(&gnb_phy.pusch_abort_its)->default_value(0),       "PUSCH LDPC iterations without progress before abort, 0 for default")
         ;
 
   options_ue_phy.add_options()
@@ -102,6 +107,8 @@ test_bench::args_t::args_t(int argc, char** argv)
         ("ue.phy.log.level",        bpo::value<std::string>(&ue_phy.log.phy_level)->default_value("warning"), "UE PHY log level")
         ("ue.phy.log.hex_limit",    bpo::value<int>(&ue_phy.log.phy_hex_limit)->default_value(0),             "UE PHY log hex limit")
         ("ue.phy.log.id_preamble",  bpo::value<std::string>(&ue_phy.log.id_preamble)->default_value(" UE/"),  "UE PHY log ID preamble")
+        ("ue.phy.pdsch.early_stop", bpo::value<bool>(&ue_phy.dl.pdsch.sch.decoder_early_stop)->default_value(false), "PDSCH LDPC syndrome check and early abort")
+        ("ue.phy.pdsch.abort_iter", bpo::value<uint32_t>(&ue_phy.dl.pdsch.sch.decoder_early_abort_iter)->default_value(0), "PDSCH LDPC iterations without progress before abort, 0 for default")
         ;
 
   options_ue_rf.add_options()
@@ -438,6 +445,22 @@ int main(int argc, char** argv)
   }
   srsran::console("   +------------+------------+------------+------------+------------+\n");
 
+  // Print gNb slot processing latency
+  if (metrics.gnb_phy.count > 0) {
+    srsran::console("gNb slot processing latency:\n");
+    srsran::console("   +------------+------------+------------+------------+------------+\n");
+    srsran::console(
+        "   | %10s | %10s | %10s | %10s | %10s |\n", "UEs", "Slots", "Avg (us)", "Min (us)", "Max (us)");
+    srsran::console("   +------------+------------+------------+------------+------------+\n");
+    srsran::console("   | %10d | %10d | %10.1f | %10.1f | %10.1f |\n",
+                    metrics.gnb_stack.nof_ues,
+                    metrics.gnb_phy.count,
+                    metrics.gnb_phy.avg_us,
+                    metrics.gnb_phy.min_us,
+                    metrics.gnb_phy.max_us);
+    srsran::console("   +------------+------------+------------+------------+------------+\n");
+  }
+
   // Assert metrics
   srsran_assert(metrics.gnb_stack.mac.tx_pkts == 0 or pdsch_bler <= assert_pdsch_bler_max,
                 "PDSCH BLER (%f) exceeds the assertion maximum (%f)",